@@ -17,20 +17,275 @@
  */
 
 #include "batch_mode.h"
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <sstream>
+#include <thread>
+
+#include <fmt/format.h>
+#include <fmt/ranges.h>
+
+#include "filesystem/filesystem.hpp"
 #include "vulkan_sample.h"
 
+#if defined(PLATFORM__WINDOWS)
+#	include <Windows.h>
+#	define BATCH_MODE_PROCESSES
+#elif defined(PLATFORM__LINUX) || defined(PLATFORM__MACOS)
+#	include <fcntl.h>
+#	include <sys/wait.h>
+#	include <unistd.h>
+#	if defined(PLATFORM__MACOS)
+#		include <TargetConditionals.h>
+#		include <mach-o/dyld.h>
+#	endif
+#	if !defined(PLATFORM__MACOS) || !TARGET_OS_IOS
+#		define BATCH_MODE_PROCESSES
+#	endif
+#endif
+
 namespace plugins
 {
+namespace
+{
+#ifdef BATCH_MODE_PROCESSES
+std::filesystem::path get_executable_path()
+{
+#	if defined(PLATFORM__WINDOWS)
+	std::wstring path(MAX_PATH, L'\0');
+	path.resize(GetModuleFileNameW(nullptr, path.data(), static_cast<DWORD>(path.size())));
+	return path;
+#	elif defined(PLATFORM__MACOS)
+	char     path[4096];
+	uint32_t size = sizeof(path);
+	if (_NSGetExecutablePath(path, &size) != 0)
+	{
+		throw std::runtime_error{"Failed to get the path of the executable"};
+	}
+	return std::filesystem::canonical(path);
+#	else
+	return std::filesystem::read_symlink("/proc/self/exe");
+#	endif
+}
+
+// The CPUs this process may run on
+std::vector<uint32_t> get_available_cpus()
+{
+	std::vector<uint32_t> cpus;
+#	if defined(PLATFORM__WINDOWS)
+	DWORD_PTR process_mask = 0;
+	DWORD_PTR system_mask  = 0;
+	if (GetProcessAffinityMask(GetCurrentProcess(), &process_mask, &system_mask))
+	{
+		for (uint32_t cpu = 0; cpu < sizeof(DWORD_PTR) * 8; ++cpu)
+		{
+			if (process_mask & (DWORD_PTR{1} << cpu))
+			{
+				cpus.push_back(cpu);
+			}
+		}
+	}
+#	elif defined(PLATFORM__LINUX)
+	cpu_set_t set;
+	CPU_ZERO(&set);
+	if (sched_getaffinity(0, sizeof(set), &set) == 0)
+	{
+		for (uint32_t cpu = 0; cpu < CPU_SETSIZE; ++cpu)
+		{
+			if (CPU_ISSET(cpu, &set))
+			{
+				cpus.push_back(cpu);
+			}
+		}
+	}
+#	endif
+	if (cpus.empty())
+	{
+		// The CPUs cannot be queried, macOS does not pin threads to CPUs at all
+		cpus.resize(std::max(1u, std::thread::hardware_concurrency()));
+		std::iota(cpus.begin(), cpus.end(), 0u);
+	}
+	return cpus;
+}
+
+/**
+ * @brief A child process running one sample
+ */
+struct ChildProcess
+{
+#	if defined(PLATFORM__WINDOWS)
+	HANDLE handle = nullptr;
+#	else
+	pid_t pid = -1;
+#	endif
+	size_t                slot = 0;        // The index of the CPU subset the process is pinned to
+	apps::AppInfo        *app  = nullptr;
+	std::filesystem::path report_path;
+	std::filesystem::path log_path;
+};
+
+// Starts the executable with the arguments, with its output redirected to the log file and pinned to the CPUs
+void spawn_process(ChildProcess                   &child,
+                   const std::filesystem::path    &executable,
+                   const std::vector<std::string> &arguments,
+                   const std::vector<uint32_t>    &cpus)
+{
+#	if defined(PLATFORM__WINDOWS)
+	std::string command_line = "\"" + executable.string() + "\"";
+	for (auto &argument : arguments)
+	{
+		command_line += " \"" + argument + "\"";
+	}
+
+	SECURITY_ATTRIBUTES security{sizeof(SECURITY_ATTRIBUTES), nullptr, TRUE};
+	HANDLE              log = CreateFileW(child.log_path.wstring().c_str(), GENERIC_WRITE, FILE_SHARE_READ, &security, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+
+	STARTUPINFOA startup{};
+	startup.cb         = sizeof(startup);
+	startup.dwFlags    = STARTF_USESTDHANDLES;
+	startup.hStdInput  = GetStdHandle(STD_INPUT_HANDLE);
+	startup.hStdOutput = log;
+	startup.hStdError  = log;
+
+	// Suspended until it is pinned, so that it never runs on other CPUs
+	PROCESS_INFORMATION process{};
+	BOOL                created = CreateProcessA(nullptr, command_line.data(), nullptr, nullptr, TRUE, CREATE_SUSPENDED, nullptr, nullptr, &startup, &process);
+	if (log != INVALID_HANDLE_VALUE)
+	{
+		CloseHandle(log);
+	}
+	if (!created)
+	{
+		throw std::runtime_error{fmt::format("Failed to start a process for {} (error {})", child.app->id, GetLastError())};
+	}
+
+	DWORD_PTR mask = 0;
+	for (auto cpu : cpus)
+	{
+		mask |= DWORD_PTR{1} << cpu;
+	}
+	if (!SetProcessAffinityMask(process.hProcess, mask))
+	{
+		LOGW("Failed to pin the process of {} to its CPUs", child.app->id);
+	}
+	ResumeThread(process.hThread);
+	CloseHandle(process.hThread);
+
+	child.handle = process.hProcess;
+#	else
+	// Everything the child process needs is prepared before forking, it only calls async-signal-safe functions
+	std::vector<char *> argv;
+	auto                executable_string = executable.string();
+	argv.push_back(executable_string.data());
+	for (auto &argument : arguments)
+	{
+		argv.push_back(const_cast<char *>(argument.c_str()));
+	}
+	argv.push_back(nullptr);
+
+	auto log_string = child.log_path.string();
+
+#		if defined(PLATFORM__LINUX)
+	cpu_set_t set;
+	CPU_ZERO(&set);
+	for (auto cpu : cpus)
+	{
+		CPU_SET(cpu, &set);
+	}
+#		endif
+
+	pid_t pid = fork();
+	if (pid < 0)
+	{
+		throw std::runtime_error{fmt::format("Failed to start a process for {} ({})", child.app->id, strerror(errno))};
+	}
+	if (pid == 0)
+	{
+#		if defined(PLATFORM__LINUX)
+		sched_setaffinity(0, sizeof(set), &set);
+#		endif
+		int log = open(log_string.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+		if (log >= 0)
+		{
+			dup2(log, STDOUT_FILENO);
+			dup2(log, STDERR_FILENO);
+			close(log);
+		}
+		execv(argv[0], argv.data());
+		_exit(127);
+	}
+
+	child.pid = pid;
+#	endif
+}
+
+// Waits for any of the child processes to exit, and returns its index
+size_t wait_for_any(const std::vector<ChildProcess> &children)
+{
+#	if defined(PLATFORM__WINDOWS)
+	std::vector<HANDLE> handles;
+	for (auto &child : children)
+	{
+		handles.push_back(child.handle);
+	}
+
+	// Only called with at most as many processes as jobs, which are limited to MAXIMUM_WAIT_OBJECTS
+	DWORD result = WaitForMultipleObjects(static_cast<DWORD>(handles.size()), handles.data(), FALSE, INFINITE);
+	if (result >= WAIT_OBJECT_0 + handles.size())
+	{
+		throw std::runtime_error{fmt::format("Failed to wait for the sample processes (error {})", GetLastError())};
+	}
+	CloseHandle(handles[result - WAIT_OBJECT_0]);
+	return result - WAIT_OBJECT_0;
+#	else
+	while (true)
+	{
+		int   status = 0;
+		pid_t pid    = waitpid(-1, &status, 0);
+		if (pid < 0)
+		{
+			if (errno == EINTR)
+			{
+				continue;
+			}
+			throw std::runtime_error{fmt::format("Failed to wait for the sample processes ({})", strerror(errno))};
+		}
+
+		auto it = std::ranges::find_if(children, [pid](auto &child) { return child.pid == pid; });
+		if (it != children.end())
+		{
+			return static_cast<size_t>(std::distance(children.begin(), it));
+		}
+	}
+#	endif
+}
+#endif
+
+// Nearest rank percentile of sorted values
+float percentile(const std::vector<float> &sorted, double fraction)
+{
+	auto rank = static_cast<size_t>(std::ceil(fraction * sorted.size()));
+	return sorted[std::clamp<size_t>(rank, 1, sorted.size()) - 1];
+}
+}        // namespace
+
 BatchMode::BatchMode() :
     BatchModeTags("Batch Mode",
                   "Run a collection of samples in sequence.",
                   {
                       vkb::Hook::OnUpdate,
+                      vkb::Hook::OnAppStart,
                       vkb::Hook::OnAppError,
+                      vkb::Hook::OnPlatformClose,
                   },
                   {{"batch", "Enable batch mode"}},
                   {{"category", "Filter samples by categories"},
                    {"duration", "The duration which a configuration should run for in seconds"},
+                   {"jobs", "Run the samples in this many headless processes at once, each pinned to its own CPUs"},
+                   {"report", "Write the load and frame times of the samples to a JSON file, or CSV if the path ends in .csv"},
+                   {"sample-id", "Run only the sample with this id"},
                    {"skip", "Skip a sample by id"},
                    {"tag", "Filter samples by tags"},
                    {"wrap-to-start", "Once all configurations have run wrap to the start"}})
@@ -86,6 +341,46 @@ bool BatchMode::handle_option(std::deque<std::string> &arguments)
 		arguments.pop_front();
 		return true;
 	}
+	else if (option == "jobs")
+	{
+		if (arguments.size() < 2)
+		{
+			LOGE("Option \"jobs\" is missing the number of processes!");
+			return false;
+		}
+		jobs = static_cast<uint32_t>(std::stoul(arguments[1]));
+
+		arguments.pop_front();
+		arguments.pop_front();
+		return true;
+	}
+	else if (option == "report")
+	{
+		if (arguments.size() < 2)
+		{
+			LOGE("Option \"report\" is missing the path of the report!");
+			return false;
+		}
+		// Absolute, as the report is written when the platform closes
+		report_path = std::filesystem::absolute(arguments[1]);
+
+		arguments.pop_front();
+		arguments.pop_front();
+		return true;
+	}
+	else if (option == "sample-id")
+	{
+		if (arguments.size() < 2)
+		{
+			LOGE("Option \"sample-id\" is missing the sample_id to run!");
+			return false;
+		}
+		sample_id = arguments[1];
+
+		arguments.pop_front();
+		arguments.pop_front();
+		return true;
+	}
 	else if (option == "skip")
 	{
 		if (arguments.size() < 2)
@@ -136,7 +431,18 @@ bool BatchMode::handle_option(std::deque<std::string> &arguments)
 
 void BatchMode::trigger_command()
 {
-	sample_list = apps::get_samples(categories, tags);
+	if (!sample_id.empty())
+	{
+		sample_list.clear();
+		if (auto *sample = apps::get_sample(sample_id))
+		{
+			sample_list.push_back(sample);
+		}
+	}
+	else
+	{
+		sample_list = apps::get_samples(categories, tags);
+	}
 
 	if (!skips.empty())
 	{
@@ -160,6 +466,17 @@ void BatchMode::trigger_command()
 
 	sample_iter = sample_list.begin();
 
+	if (jobs > 0)
+	{
+#ifdef BATCH_MODE_PROCESSES
+		run_processes();
+		platform->close();
+		return;
+#else
+		LOGW("Option \"jobs\" is not supported on this platform, running the samples in sequence");
+#endif
+	}
+
 	vkb::Window::OptionalProperties properties;
 	properties.resizable = false;
 	platform->set_window_properties(properties);
@@ -170,6 +487,13 @@ void BatchMode::trigger_command()
 
 void BatchMode::on_update(float delta_time)
 {
+	// The first frame of a sample also counts the time spent loading it, which the load time already reports
+	if (runs.back().first_frame_done)
+	{
+		runs.back().frame_times.push_back(delta_time * 1000.0f);
+	}
+	runs.back().first_frame_done = true;
+
 	elapsed_time += delta_time;
 
 	// When the runtime for the current configuration is reached, advance to the next config or next sample
@@ -194,18 +518,45 @@ void BatchMode::on_update(float delta_time)
 	}
 }
 
+void BatchMode::on_app_start(const std::string &app_id)
+{
+	// From the request, including the creation of the app and its preparation
+	runs.back().load_ms = load_timer.stop<vkb::Timer::Milliseconds>();
+}
+
 void BatchMode::on_app_error(const std::string &app_id)
 {
+	runs.back().failed = true;
+
 	// App failed, load next app
 	load_next_app();
 }
 
+void BatchMode::on_platform_close()
+{
+	if (report_path.empty() || runs.empty())
+	{
+		return;
+	}
+
+	std::vector<SampleReport> reports;
+	for (auto &run : runs)
+	{
+		reports.push_back(summarize(run));
+	}
+	write_report(reports);
+}
+
 void BatchMode::request_app()
 {
 	LOGI("===========================================");
 	LOGI("Running {}", (*sample_iter)->id);
 	LOGI("===========================================");
 
+	runs.push_back({(*sample_iter)->id});
+	load_timer.stop();
+	load_timer.start();
+
 	platform->request_application((*sample_iter));
 }
 
@@ -229,4 +580,250 @@ void BatchMode::load_next_app()
 	// App will be started before the next update loop
 	request_app();
 }
+
+#ifdef BATCH_MODE_PROCESSES
+void BatchMode::run_processes()
+{
+	if (wrap_to_start)
+	{
+		LOGW("Option \"wrap-to-start\" is ignored when running the samples in processes");
+	}
+
+	auto executable = get_executable_path();
+	auto temp_dir   = vkb::filesystem::get()->temp_directory();
+	auto run_id     = std::chrono::steady_clock::now().time_since_epoch().count();
+
+	// Each process gets a contiguous subset of the CPUs, so that processes do not compete for them
+	auto   cpus         = get_available_cpus();
+	size_t slot_count   = std::min<size_t>(jobs, sample_list.size());
+	size_t cpus_per_job = std::max<size_t>(1, cpus.size() / slot_count);
+#	if defined(PLATFORM__WINDOWS)
+	slot_count = std::min<size_t>(slot_count, MAXIMUM_WAIT_OBJECTS);
+#	endif
+
+	std::vector<std::vector<uint32_t>> slot_cpus(slot_count);
+	for (size_t slot = 0; slot < slot_count; ++slot)
+	{
+		for (size_t i = 0; i < cpus_per_job; ++i)
+		{
+			slot_cpus[slot].push_back(cpus[(slot * cpus_per_job + i) % cpus.size()]);
+		}
+	}
+
+	LOGI("Running {} samples in {} processes, {} CPUs each", sample_list.size(), slot_count, cpus_per_job);
+
+	vkb::Timer timer;
+	timer.start();
+
+	std::vector<SampleReport> reports;
+	std::vector<ChildProcess> children;
+	std::vector<size_t>       free_slots(slot_count);
+	std::iota(free_slots.rbegin(), free_slots.rend(), size_t{0});
+
+	auto next_sample = sample_list.begin();
+	while (next_sample != sample_list.end() || !children.empty())
+	{
+		// Keep every slot busy while there are samples left
+		while (next_sample != sample_list.end() && !free_slots.empty())
+		{
+			ChildProcess child;
+			child.slot        = free_slots.back();
+			child.app         = *next_sample++;
+			child.report_path = temp_dir / fmt::format("vkb_batch_{}_{}.csv", run_id, child.app->id);
+			child.log_path    = temp_dir / fmt::format("vkb_batch_{}_{}.log", run_id, child.app->id);
+
+			std::vector<std::string> arguments{"batch",
+			                                   "--sample-id",
+			                                   child.app->id,
+			                                   "--duration",
+			                                   std::to_string(duration.count()),
+			                                   "--report",
+			                                   child.report_path.string(),
+			                                   "--headless-surface"};
+			try
+			{
+				spawn_process(child, executable, arguments, slot_cpus[child.slot]);
+			}
+			catch (const std::exception &e)
+			{
+				LOGE("{}", e.what());
+				reports.push_back({child.app->id, "error"});
+				continue;
+			}
+
+			LOGI("Started {} on CPUs {}", child.app->id, fmt::join(slot_cpus[child.slot], ","));
+			free_slots.pop_back();
+			children.push_back(std::move(child));
+		}
+
+		// Every remaining sample failed to start
+		if (children.empty())
+		{
+			continue;
+		}
+
+		auto  index = wait_for_any(children);
+		auto &child = children[index];
+
+		// A process that did not write its report crashed before the platform closed
+		auto child_reports = read_reports(child.report_path);
+		if (child_reports.empty())
+		{
+			LOGE("{} exited without a report, see {}", child.app->id, child.log_path.string());
+			reports.push_back({child.app->id, "crashed"});
+		}
+		else
+		{
+			LOGI("Finished {}", child.app->id);
+			reports.insert(reports.end(), child_reports.begin(), child_reports.end());
+			std::filesystem::remove(child.report_path);
+			std::filesystem::remove(child.log_path);
+		}
+
+		free_slots.push_back(child.slot);
+		children.erase(children.begin() + index);
+	}
+
+	LOGI("Ran {} samples in {:.1f} s", sample_list.size(), timer.stop());
+
+	// In the order of the sample list, independent of which process finished first
+	std::ranges::sort(reports, {}, [this](const SampleReport &report) {
+		return std::ranges::find(sample_list, report.id, &apps::AppInfo::id) - sample_list.begin();
+	});
+
+	if (report_path.empty())
+	{
+		for (auto &report : reports)
+		{
+			LOGI("{}: {} | load {:.1f} ms | frame p50 {:.2f} ms, p99 {:.2f} ms", report.id, report.status, report.load_ms, report.p50_ms, report.p99_ms);
+		}
+	}
+	else
+	{
+		write_report(reports);
+	}
+}
+#else
+void BatchMode::run_processes()
+{
+}
+#endif
+
+BatchMode::SampleReport BatchMode::summarize(const SampleRun &run)
+{
+	SampleReport report{run.id, run.failed ? "error" : "ok", run.load_ms, run.frame_times.size()};
+	if (run.frame_times.empty())
+	{
+		return report;
+	}
+
+	auto sorted = run.frame_times;
+	std::ranges::sort(sorted);
+
+	report.mean_ms = std::accumulate(sorted.begin(), sorted.end(), 0.0) / sorted.size();
+	report.min_ms  = sorted.front();
+	report.p50_ms  = percentile(sorted, 0.50);
+	report.p90_ms  = percentile(sorted, 0.90);
+	report.p99_ms  = percentile(sorted, 0.99);
+	report.max_ms  = sorted.back();
+	return report;
+}
+
+void BatchMode::write_report(const std::vector<SampleReport> &reports) const
+{
+	std::string contents;
+	if (report_path.extension() == ".csv")
+	{
+		contents = "id,status,load_ms,frames,mean_ms,min_ms,p50_ms,p90_ms,p99_ms,max_ms\n";
+		for (auto &report : reports)
+		{
+			contents += fmt::format("{},{},{:.3f},{},{:.3f},{:.3f},{:.3f},{:.3f},{:.3f},{:.3f}\n",
+			                        report.id,
+			                        report.status,
+			                        report.load_ms,
+			                        report.frame_count,
+			                        report.mean_ms,
+			                        report.min_ms,
+			                        report.p50_ms,
+			                        report.p90_ms,
+			                        report.p99_ms,
+			                        report.max_ms);
+		}
+	}
+	else
+	{
+		contents = fmt::format("{{\n  \"duration_s\": {},\n  \"jobs\": {},\n  \"samples\": [", duration.count(), jobs);
+		for (size_t i = 0; i < reports.size(); ++i)
+		{
+			auto &report = reports[i];
+			contents += fmt::format(
+			    "{}\n    {{\"id\": \"{}\", \"status\": \"{}\", \"load_ms\": {:.3f}, \"frames\": {}, "
+			    "\"frame_ms\": {{\"mean\": {:.3f}, \"min\": {:.3f}, \"p50\": {:.3f}, \"p90\": {:.3f}, \"p99\": {:.3f}, \"max\": {:.3f}}}}}",
+			    i == 0 ? "" : ",",
+			    report.id,
+			    report.status,
+			    report.load_ms,
+			    report.frame_count,
+			    report.mean_ms,
+			    report.min_ms,
+			    report.p50_ms,
+			    report.p90_ms,
+			    report.p99_ms,
+			    report.max_ms);
+		}
+		contents += "\n  ]\n}\n";
+	}
+
+	try
+	{
+		vkb::filesystem::get()->write_file(report_path, contents);
+		LOGI("Wrote the report of {} samples to {}", reports.size(), report_path.string());
+	}
+	catch (const std::exception &e)
+	{
+		LOGE("Failed to write the report: {}", e.what());
+	}
+}
+
+std::vector<BatchMode::SampleReport> BatchMode::read_reports(const std::filesystem::path &path)
+{
+	std::vector<SampleReport> reports;
+
+	auto fs = vkb::filesystem::get();
+	if (!fs->is_file(path))
+	{
+		return reports;
+	}
+
+	std::istringstream contents{fs->read_file_string(path)};
+	std::string        line;
+
+	// Skip the header
+	std::getline(contents, line);
+	while (std::getline(contents, line))
+	{
+		std::vector<std::string> fields;
+		std::istringstream       line_stream{line};
+		for (std::string field; std::getline(line_stream, field, ',');)
+		{
+			fields.push_back(field);
+		}
+		if (fields.size() != 10)
+		{
+			continue;
+		}
+
+		reports.push_back({fields[0],
+		                   fields[1],
+		                   std::stod(fields[2]),
+		                   std::stoul(fields[3]),
+		                   std::stod(fields[4]),
+		                   std::stod(fields[5]),
+		                   std::stod(fields[6]),
+		                   std::stod(fields[7]),
+		                   std::stod(fields[8]),
+		                   std::stod(fields[9])});
+	}
+	return reports;
+}
 }        // namespace plugins
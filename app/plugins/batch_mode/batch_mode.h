@@ -19,6 +19,8 @@
 #pragma once
 
 #include <chrono>
+#include <filesystem>
+#include <string>
 #include <vector>
 
 #include "apps.h"
@@ -36,7 +38,14 @@ using BatchModeTags = vkb::PluginBase<vkb::tags::Entrypoint, vkb::tags::FullCont
  *
  * Run a subset of samples. The next sample in the set will start after the current sample being executed has finished. Using --wrap-to-start will start again from the first sample after the last sample is executed.
  *
+ * The load time and the frame times of every sample are measured. Using --report writes them to a JSON file, or a CSV file if the path ends in .csv,
+ * with the frame time distribution of each sample summarized in percentiles.
+ *
+ * Using --jobs runs the samples in that many processes at once instead, each one pinned to its own subset of the CPUs and rendering to a headless surface.
+ * The processes run this executable in batch mode with a single sample, the report merges the results of all of them.
+ *
  * Usage: vulkan_samples batch --duration 3 --category performance --tag arm
+ *        vulkan_samples batch --duration 3 --category performance --jobs 4 --report results.json
  *
  */
 class BatchMode : public BatchModeTags
@@ -47,20 +56,67 @@ class BatchMode : public BatchModeTags
 	virtual ~BatchMode() = default;
 
 	void on_update(float delta_time) override;
+	void on_app_start(const std::string &app_id) override;
 	void on_app_error(const std::string &app_id) override;
+	void on_platform_close() override;
 
 	bool handle_command(std::deque<std::string> &arguments) const override;
 	bool handle_option(std::deque<std::string> &arguments) override;
 	void trigger_command() override;
 
   private:
+	/**
+	 * @brief The measurements of a sample run in this process
+	 */
+	struct SampleRun
+	{
+		std::string        id;
+		bool               failed           = false;
+		bool               first_frame_done = false;
+		double             load_ms          = 0.0;
+		std::vector<float> frame_times;        // In milliseconds, without the first frame
+	};
+
+	/**
+	 * @brief The summary of a sample run, as written to the report
+	 */
+	struct SampleReport
+	{
+		std::string id;
+		std::string status;
+		double      load_ms     = 0.0;
+		size_t      frame_count = 0;
+		double      mean_ms     = 0.0;
+		double      min_ms      = 0.0;
+		double      p50_ms      = 0.0;
+		double      p90_ms      = 0.0;
+		double      p99_ms      = 0.0;
+		double      max_ms      = 0.0;
+	};
+
 	void request_app();
 	void load_next_app();
 
+	/**
+	 * @brief Runs every sample of the list in a child process, at most jobs at once, then writes the merged report
+	 */
+	void run_processes();
+
+	void write_report(const std::vector<SampleReport> &reports) const;
+
+	static SampleReport summarize(const SampleRun &run);
+
+	static std::vector<SampleReport> read_reports(const std::filesystem::path &path);
+
   private:
 	std::vector<std::string>                          categories;
 	std::chrono::duration<float, vkb::Timer::Seconds> duration     = 3s;
 	float                                             elapsed_time = 0.0f;
+	uint32_t                                          jobs         = 0;        // Run the samples in child processes if not 0
+	vkb::Timer                                        load_timer;
+	std::filesystem::path                             report_path;
+	std::vector<SampleRun>                            runs;
+	std::string                                       sample_id;        // Run only this sample, set in the child processes
 	std::set<std::string>                             skips;
 	std::vector<apps::AppInfo *>::const_iterator      sample_iter;        // An iterator to the current batch mode sample info object
 	std::vector<apps::AppInfo *>                      sample_list;        // The list of suitable samples to be run in conjunction with batch mode
@@ -0,0 +1,172 @@
+/* Copyright (c) 2025, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "counter_logger.h"
+
+#include <core/util/counters.hpp>
+#include <fmt/format.h>
+
+#include "filesystem/filesystem.hpp"
+
+namespace plugins
+{
+CounterLogger::CounterLogger() :
+    CounterLoggerTags("Counter Logger",
+                      "Log the registered counters to a CSV file",
+                      {vkb::Hook::OnUpdate, vkb::Hook::OnAppStart, vkb::Hook::OnAppClose, vkb::Hook::OnPlatformClose},
+                      {},
+                      {{"log-counters", "Write the registered counters to the given CSV file"},
+                       {"log-counters-interval", "Seconds between two samples of the counters, 1 by default"}})
+{
+}
+
+bool CounterLogger::handle_option(std::deque<std::string> &arguments)
+{
+	assert(!arguments.empty() && (arguments[0].substr(0, 2) == "--"));
+	std::string option = arguments[0].substr(2);
+	if (option == "log-counters")
+	{
+		if (arguments.size() < 2)
+		{
+			LOGE("Option \"log-counters\" is missing the file to write the counters to!");
+			return false;
+		}
+		output_path = arguments[1];
+
+		arguments.pop_front();
+		arguments.pop_front();
+		return true;
+	}
+	else if (option == "log-counters-interval")
+	{
+		if (arguments.size() < 2)
+		{
+			LOGE("Option \"log-counters-interval\" is missing the number of seconds between two samples!");
+			return false;
+		}
+		interval = std::stof(arguments[1]);
+
+		arguments.pop_front();
+		arguments.pop_front();
+		return true;
+	}
+	return false;
+}
+
+void CounterLogger::on_update(float delta_time)
+{
+	if (!file.is_open())
+	{
+		return;
+	}
+
+	elapsed_time += delta_time;
+	time_since_sample += delta_time;
+
+	if (time_since_sample >= interval)
+	{
+		sample_counters();
+		time_since_sample = 0.0f;
+	}
+}
+
+void CounterLogger::on_app_start(const std::string &app_id)
+{
+	elapsed_time      = 0.0f;
+	time_since_sample = 0.0f;
+	current_app_id    = app_id;
+
+	// The file is opened once, so that in batch mode the samples after the first one append to it
+	if (output_path.empty() || file.is_open())
+	{
+		return;
+	}
+
+	auto parent = output_path.parent_path();
+	if (!parent.empty() && !vkb::filesystem::get()->exists(parent))
+	{
+		vkb::filesystem::get()->create_directory(parent);
+	}
+
+	file.open(output_path, std::ios::trunc);
+	if (!file.is_open())
+	{
+		LOGE("Failed to open {} to write the counters to", output_path.string());
+		return;
+	}
+
+	file << "sample,time_s,counter,value\n";
+	file.flush();
+}
+
+void CounterLogger::on_app_close(const std::string &app_id)
+{
+	end_app();
+}
+
+void CounterLogger::on_platform_close()
+{
+	end_app();
+
+	if (file.is_open())
+	{
+		file.close();
+		LOGI("Wrote counters to {}", output_path.string());
+	}
+}
+
+void CounterLogger::sample_counters()
+{
+	std::vector<vkb::CounterValue> values;
+	vkb::CounterRegistry::get().snapshot(values);
+
+	for (auto &value : values)
+	{
+		file << fmt::format("{},{:.3f},{},{}\n", quote(current_app_id), elapsed_time, quote(value.name), value.value);
+	}
+
+	// Flushed every sample, so that the rows written so far survive a crash
+	file.flush();
+}
+
+void CounterLogger::end_app()
+{
+	if (!file.is_open() || current_app_id.empty())
+	{
+		return;
+	}
+
+	sample_counters();
+	current_app_id.clear();
+}
+
+std::string CounterLogger::quote(const std::string &field)
+{
+	// Fields may contain commas and quotes, so they are quoted and their quotes doubled
+	std::string quoted = "\"";
+	for (char c : field)
+	{
+		quoted += c;
+		if (c == '"')
+		{
+			quoted += '"';
+		}
+	}
+	quoted += '"';
+	return quoted;
+}
+}        // namespace plugins
@@ -0,0 +1,82 @@
+/* Copyright (c) 2025, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <filesystem>
+#include <fstream>
+
+#include "platform/plugins/plugin_base.h"
+
+namespace plugins
+{
+class CounterLogger;
+
+using CounterLoggerTags = vkb::PluginBase<CounterLogger, vkb::tags::Passive>;
+
+/**
+ * @brief Counter Logger
+ *
+ * Samples the counters of the vkb::CounterRegistry at an interval and appends them to a CSV file, one row per counter
+ * and sample, with the id of the sample and the time in seconds since it started. The rows are flushed after every
+ * sample, and in batch mode the samples all append to the same file. Counters that count events are written as totals,
+ * gauges as their current value.
+ *
+ * Usage: vulkan_samples sample descriptor_management --log-counters counters.csv --log-counters-interval 0.5
+ *
+ */
+class CounterLogger : public CounterLoggerTags
+{
+  public:
+	CounterLogger();
+
+	virtual ~CounterLogger() = default;
+
+	bool handle_option(std::deque<std::string> &arguments) override;
+
+	void on_update(float delta_time) override;
+
+	void on_app_start(const std::string &app_id) override;
+
+	void on_app_close(const std::string &app_id) override;
+
+	void on_platform_close() override;
+
+  private:
+	void sample_counters();
+
+	/**
+	 * @brief Writes the last sample of the counters of the running app
+	 */
+	void end_app();
+
+	static std::string quote(const std::string &field);
+
+	std::filesystem::path output_path;
+
+	std::ofstream file;
+
+	std::string current_app_id;
+
+	// Seconds between two samples of the counters
+	float interval = 1.0f;
+
+	float elapsed_time = 0.0f;
+
+	float time_since_sample = 0.0f;
+};
+}        // namespace plugins
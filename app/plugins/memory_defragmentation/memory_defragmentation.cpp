@@ -0,0 +1,90 @@
+/* Copyright (c) 2025, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "memory_defragmentation.h"
+
+#include "api_vulkan_sample.h"
+
+namespace plugins
+{
+MemoryDefragmentation::MemoryDefragmentation() :
+    MemoryDefragmentationTags("Memory Defragmentation",
+                              "Move the resources of the scene to free the device memory blocks left mostly unused",
+                              {vkb::Hook::OnAppStart},
+                              {},
+                              {{"defragment", "Defragment the device memory of the scene a few resources every frame"},
+                               {"defragment-bytes", "Bytes moved by a frame at most, 16 MiB by default"}})
+{
+}
+
+bool MemoryDefragmentation::handle_option(std::deque<std::string> &arguments)
+{
+	assert(!arguments.empty() && (arguments[0].substr(0, 2) == "--"));
+	std::string option = arguments[0].substr(2);
+	if (option == "defragment")
+	{
+		enabled = true;
+
+		arguments.pop_front();
+		return true;
+	}
+	else if (option == "defragment-bytes")
+	{
+		if (arguments.size() < 2)
+		{
+			LOGE("Option \"defragment-bytes\" is missing the number of bytes!");
+			return false;
+		}
+		settings.max_bytes_per_pass = std::stoull(arguments[1]);
+		if (settings.max_bytes_per_pass == 0)
+		{
+			LOGE("Option \"defragment-bytes\" must be a positive number of bytes!");
+			return false;
+		}
+
+		arguments.pop_front();
+		arguments.pop_front();
+		return true;
+	}
+	return false;
+}
+
+void MemoryDefragmentation::on_app_start(const std::string &app_id)
+{
+	if (!enabled)
+	{
+		return;
+	}
+
+	auto *vulkan_app = dynamic_cast<vkb::VulkanSampleC *>(&platform->get_app());
+	if (!vulkan_app || !vulkan_app->has_scene())
+	{
+		LOGW("[Memory Defragmentation] {} does not render a scene, its memory is not defragmented", app_id);
+		return;
+	}
+
+	// ApiVulkanSample records its command buffers once, holding on to the handles a pass would replace
+	if (dynamic_cast<ApiVulkanSample *>(vulkan_app))
+	{
+		LOGW("[Memory Defragmentation] {} records its command buffers once, its memory is not defragmented", app_id);
+		return;
+	}
+
+	auto &scene = vulkan_app->get_scene();
+	scene.add_component(std::make_unique<vkb::sg::MemoryDefragmenter>(vulkan_app->get_device(), scene, settings));
+}
+}        // namespace plugins
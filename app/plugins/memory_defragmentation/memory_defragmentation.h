@@ -0,0 +1,55 @@
+/* Copyright (c) 2025, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "platform/plugins/plugin_base.h"
+#include "scene_graph/memory_defragmenter.h"
+
+namespace plugins
+{
+class MemoryDefragmentation;
+
+using MemoryDefragmentationTags = vkb::PluginBase<MemoryDefragmentation, vkb::tags::Passive>;
+
+/**
+ * @brief Memory Defragmentation
+ *
+ * Adds a vkb::sg::MemoryDefragmenter to the scene of the sample, which moves the vertex buffers, index buffers and
+ * textures of the scene a few at a time to free the device memory blocks left mostly unused. Only samples loading a
+ * scene and recording their command buffers every frame are affected.
+ *
+ * Usage: vulkan_samples sample pipeline_cache --defragment --defragment-bytes 8388608
+ *
+ */
+class MemoryDefragmentation : public MemoryDefragmentationTags
+{
+  public:
+	MemoryDefragmentation();
+
+	virtual ~MemoryDefragmentation() = default;
+
+	bool handle_option(std::deque<std::string> &arguments) override;
+
+	void on_app_start(const std::string &app_id) override;
+
+  private:
+	bool enabled = false;
+
+	vkb::sg::MemoryDefragmenter::Settings settings;
+};
+}        // namespace plugins
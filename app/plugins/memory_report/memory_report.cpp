@@ -0,0 +1,192 @@
+/* Copyright (c) 2025, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "memory_report.h"
+
+#include <cmath>
+
+#include <core/util/counters.hpp>
+#include <fmt/format.h>
+
+#include "filesystem/filesystem.hpp"
+
+namespace plugins
+{
+namespace
+{
+using vkb::allocated::MemoryCategory;
+
+std::string format_bytes(double bytes)
+{
+	double magnitude = std::abs(bytes);
+	if (magnitude >= 1024.0 * 1024.0)
+	{
+		return fmt::format("{:.1f} MiB", bytes / (1024.0 * 1024.0));
+	}
+	if (magnitude >= 1024.0)
+	{
+		return fmt::format("{:.1f} KiB", bytes / 1024.0);
+	}
+	return fmt::format("{} B", bytes);
+}
+
+void set_counters(const vkb::allocated::MemoryStatistics &statistics)
+{
+	// The registry caches counters by the address of their name, so the names are static
+	static const vkb::Counter counters[] = {
+	    vkb::Counter{"Other memory bytes", PlotType::Memory},
+	    vkb::Counter{"Scene geometry memory bytes", PlotType::Memory},
+	    vkb::Counter{"Texture memory bytes", PlotType::Memory},
+	    vkb::Counter{"Render target memory bytes", PlotType::Memory},
+	    vkb::Counter{"Transient memory bytes", PlotType::Memory},
+	    vkb::Counter{"GUI memory bytes", PlotType::Memory},
+	    vkb::Counter{"Staging memory bytes", PlotType::Memory}};
+	static_assert(std::size(counters) == vkb::allocated::memory_category_count, "One counter per memory category");
+
+	for (size_t i = 0; i < statistics.size(); ++i)
+	{
+		counters[i].set(static_cast<double>(statistics[i].allocation_bytes));
+	}
+}
+}        // namespace
+
+MemoryReport::MemoryReport() :
+    MemoryReportTags("Memory Report",
+                     "Report the device memory allocations of each category",
+                     {vkb::Hook::OnUpdate, vkb::Hook::OnAppStart, vkb::Hook::OnAppClose},
+                     {},
+                     {{"memory-report", "Log the allocations of each memory category that change every frame, and a summary when the sample closes"},
+                      {"memory-map", "Write the detailed map of the memory allocator to the given JSON file when the sample closes"}})
+{
+}
+
+bool MemoryReport::handle_option(std::deque<std::string> &arguments)
+{
+	assert(!arguments.empty() && (arguments[0].substr(0, 2) == "--"));
+	std::string option = arguments[0].substr(2);
+	if (option == "memory-report")
+	{
+		enabled = true;
+
+		arguments.pop_front();
+		return true;
+	}
+	else if (option == "memory-map")
+	{
+		if (arguments.size() < 2)
+		{
+			LOGE("Option \"memory-map\" is missing the file to write the memory map to!");
+			return false;
+		}
+		map_path = arguments[1];
+
+		arguments.pop_front();
+		arguments.pop_front();
+		return true;
+	}
+	return false;
+}
+
+void MemoryReport::on_update(float delta_time)
+{
+	if (!enabled)
+	{
+		return;
+	}
+
+	++frame;
+
+	auto statistics = vkb::allocated::get_memory_statistics();
+	set_counters(statistics);
+
+	std::string changes;
+	for (size_t i = 0; i < statistics.size(); ++i)
+	{
+		auto count_delta = static_cast<int64_t>(statistics[i].allocation_count - previous_statistics[i].allocation_count);
+		auto bytes_delta = static_cast<int64_t>(statistics[i].allocation_bytes - previous_statistics[i].allocation_bytes);
+		if (count_delta != 0 || bytes_delta != 0)
+		{
+			changes += fmt::format("{}{} {:+} ({}{})",
+			                       changes.empty() ? "" : ", ",
+			                       vkb::allocated::to_string(static_cast<MemoryCategory>(i)),
+			                       count_delta,
+			                       bytes_delta > 0 ? "+" : "",
+			                       format_bytes(static_cast<double>(bytes_delta)));
+		}
+	}
+
+	if (!changes.empty())
+	{
+		LOGI("[Memory Report] Frame {}: {}", frame, changes);
+	}
+
+	previous_statistics = statistics;
+}
+
+void MemoryReport::on_app_start(const std::string &app_id)
+{
+	// Allocations made while loading are reported by the first frame
+	frame               = 0;
+	previous_statistics = {};
+}
+
+void MemoryReport::on_app_close(const std::string &app_id)
+{
+	if (enabled)
+	{
+		log_summary();
+	}
+
+	if (!map_path.empty())
+	{
+		// The sample still exists, so its allocations are in the map
+		auto memory_map = vkb::allocated::build_memory_map();
+		if (memory_map.empty())
+		{
+			LOGW("[Memory Report] There is no memory allocator to write the map of");
+			return;
+		}
+
+		vkb::filesystem::get()->write_file(map_path, memory_map);
+		LOGI("Wrote the memory map of {} to {}", app_id, map_path);
+	}
+}
+
+void MemoryReport::log_summary() const
+{
+	auto statistics = vkb::allocated::get_memory_statistics();
+
+	LOGI("[Memory Report] {:<16} {:>8} {:>12} {:>12} {:>12}", "Category", "Count", "Live", "Peak", "Average");
+	for (size_t i = 0; i < statistics.size(); ++i)
+	{
+		auto &category = statistics[i];
+		if (category.allocation_count == 0 && category.peak_bytes == 0)
+		{
+			continue;
+		}
+
+		// A small average over many allocations points at dedicated allocations that could share a buffer
+		double average = category.allocation_count > 0 ? static_cast<double>(category.allocation_bytes) / category.allocation_count : 0.0;
+		LOGI("[Memory Report] {:<16} {:>8} {:>12} {:>12} {:>12}",
+		     vkb::allocated::to_string(static_cast<MemoryCategory>(i)),
+		     category.allocation_count,
+		     format_bytes(static_cast<double>(category.allocation_bytes)),
+		     format_bytes(static_cast<double>(category.peak_bytes)),
+		     format_bytes(average));
+	}
+}
+}        // namespace plugins
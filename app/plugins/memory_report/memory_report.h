@@ -0,0 +1,66 @@
+/* Copyright (c) 2025, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "core/memory_category.h"
+#include "platform/plugins/plugin_base.h"
+
+namespace plugins
+{
+class MemoryReport;
+
+using MemoryReportTags = vkb::PluginBase<MemoryReport, vkb::tags::Passive>;
+
+/**
+ * @brief Memory Report
+ *
+ * Reports the VMA allocations of each vkb::allocated::MemoryCategory. Every frame that allocates or frees, the change of
+ * each category is logged, and the live bytes of each category are published as counters. When the sample closes, the
+ * live and peak allocations of each category are logged, and the detailed map of the allocator can be written as JSON,
+ * naming the category of each allocation.
+ *
+ * Usage: vulkan_samples sample instancing --memory-report --memory-map instancing_memory.json
+ *
+ */
+class MemoryReport : public MemoryReportTags
+{
+  public:
+	MemoryReport();
+
+	virtual ~MemoryReport() = default;
+
+	bool handle_option(std::deque<std::string> &arguments) override;
+
+	void on_update(float delta_time) override;
+
+	void on_app_start(const std::string &app_id) override;
+
+	void on_app_close(const std::string &app_id) override;
+
+  private:
+	void log_summary() const;
+
+	bool enabled = false;
+
+	std::string map_path;
+
+	uint64_t frame = 0;
+
+	vkb::allocated::MemoryStatistics previous_statistics;
+};
+}        // namespace plugins
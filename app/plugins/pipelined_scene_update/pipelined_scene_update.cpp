@@ -0,0 +1,65 @@
+/* Copyright (c) 2025, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "pipelined_scene_update.h"
+
+#include "api_vulkan_sample.h"
+
+namespace plugins
+{
+PipelinedSceneUpdate::PipelinedSceneUpdate() :
+    PipelinedSceneUpdateTags("Pipelined Scene Update",
+                             "Update the scene of the next frame on a worker thread while the current frame is recorded",
+                             {vkb::Hook::OnAppStart},
+                             {},
+                             {{"pipeline-scene-update", "Run the scripts and animations of the scene one frame ahead on a worker thread"}})
+{
+}
+
+bool PipelinedSceneUpdate::handle_option(std::deque<std::string> &arguments)
+{
+	assert(!arguments.empty() && (arguments[0].substr(0, 2) == "--"));
+	std::string option = arguments[0].substr(2);
+	if (option == "pipeline-scene-update")
+	{
+		enabled = true;
+
+		arguments.pop_front();
+		return true;
+	}
+	return false;
+}
+
+void PipelinedSceneUpdate::on_app_start(const std::string &app_id)
+{
+	if (!enabled)
+	{
+		return;
+	}
+
+	// ApiVulkanSample::update does not update the scene through VulkanSample::update
+	auto *vulkan_app = dynamic_cast<vkb::VulkanSampleC *>(&platform->get_app());
+	if (!vulkan_app || !vulkan_app->has_scene() || dynamic_cast<ApiVulkanSample *>(vulkan_app))
+	{
+		LOGW("[Pipelined Scene Update] {} does not update a scene every frame, its scene update is not pipelined", app_id);
+		return;
+	}
+
+	vulkan_app->set_pipelined_scene_update(true);
+}
+}        // namespace plugins
@@ -0,0 +1,53 @@
+/* Copyright (c) 2025, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#pragma once
+
+#include "platform/plugins/plugin_base.h"
+
+namespace plugins
+{
+class PipelinedSceneUpdate;
+
+using PipelinedSceneUpdateTags = vkb::PluginBase<PipelinedSceneUpdate, vkb::tags::Passive>;
+
+/**
+ * @brief Pipelined Scene Update
+ *
+ * Runs the scripts and animations of the next frame on a worker thread while the current frame is recorded, see
+ * vkb::VulkanSample::set_pipelined_scene_update. Only samples loading a scene and updating it through
+ * vkb::VulkanSample::update are affected.
+ *
+ * Usage: vulkan_samples sample render_passes --pipeline-scene-update
+ *
+ */
+class PipelinedSceneUpdate : public PipelinedSceneUpdateTags
+{
+  public:
+	PipelinedSceneUpdate();
+
+	virtual ~PipelinedSceneUpdate() = default;
+
+	bool handle_option(std::deque<std::string> &arguments) override;
+
+	void on_app_start(const std::string &app_id) override;
+
+  private:
+	bool enabled = false;
+};
+}        // namespace plugins
@@ -0,0 +1,92 @@
+/* Copyright (c) 2025, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "texture_budget.h"
+
+#include "scene_graph/texture_residency.h"
+#include "vulkan_sample.h"
+
+namespace plugins
+{
+TextureBudget::TextureBudget() :
+    TextureBudgetTags("Texture Budget",
+                      "Keep the textures of the scene under a fraction of the heap budget",
+                      {vkb::Hook::OnAppStart},
+                      {},
+                      {{"texture-budget", "Fraction of the device local heap budget the heap usage is kept under, such as 0.5"},
+                       {"texture-cold-frames", "Frames a texture must be out of view before it loses levels, 120 by default"}})
+{
+}
+
+bool TextureBudget::handle_option(std::deque<std::string> &arguments)
+{
+	assert(!arguments.empty() && (arguments[0].substr(0, 2) == "--"));
+	std::string option = arguments[0].substr(2);
+	if (option == "texture-budget")
+	{
+		if (arguments.size() < 2)
+		{
+			LOGE("Option \"texture-budget\" is missing the fraction of the heap budget!");
+			return false;
+		}
+		settings.budget_fraction = std::stof(arguments[1]);
+		if (settings.budget_fraction <= 0.0f || settings.budget_fraction > 1.0f)
+		{
+			LOGE("Option \"texture-budget\" must be a fraction in (0, 1]!");
+			return false;
+		}
+		enabled = true;
+
+		arguments.pop_front();
+		arguments.pop_front();
+		return true;
+	}
+	else if (option == "texture-cold-frames")
+	{
+		if (arguments.size() < 2)
+		{
+			LOGE("Option \"texture-cold-frames\" is missing the number of frames!");
+			return false;
+		}
+		settings.cold_frames = static_cast<uint32_t>(std::stoul(arguments[1]));
+
+		arguments.pop_front();
+		arguments.pop_front();
+		return true;
+	}
+	return false;
+}
+
+void TextureBudget::on_app_start(const std::string &app_id)
+{
+	if (!enabled)
+	{
+		return;
+	}
+
+	auto *vulkan_app = dynamic_cast<vkb::VulkanSampleC *>(&platform->get_app());
+	if (!vulkan_app || !vulkan_app->has_scene())
+	{
+		LOGW("[Texture Budget] {} does not render a scene, its textures are not managed", app_id);
+		return;
+	}
+
+	auto texture_residency = std::make_unique<vkb::sg::TextureResidency>(vulkan_app->get_device(), settings);
+	texture_residency->add_scene(vulkan_app->get_scene());
+	vulkan_app->get_scene().add_component(std::move(texture_residency));
+}
+}        // namespace plugins
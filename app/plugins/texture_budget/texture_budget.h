@@ -0,0 +1,54 @@
+/* Copyright (c) 2025, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "platform/plugins/plugin_base.h"
+#include "scene_graph/residency_policy.h"
+
+namespace plugins
+{
+class TextureBudget;
+
+using TextureBudgetTags = vkb::PluginBase<TextureBudget, vkb::tags::Passive>;
+
+/**
+ * @brief Texture Budget
+ *
+ * Adds a vkb::sg::TextureResidency to the scene of the sample, which keeps the device local heap usage under a fraction
+ * of its budget by dropping the top mip levels of the textures out of view. Only samples loading a scene are affected.
+ *
+ * Usage: vulkan_samples sample pipeline_cache --texture-budget 0.5 --texture-cold-frames 60
+ *
+ */
+class TextureBudget : public TextureBudgetTags
+{
+  public:
+	TextureBudget();
+
+	virtual ~TextureBudget() = default;
+
+	bool handle_option(std::deque<std::string> &arguments) override;
+
+	void on_app_start(const std::string &app_id) override;
+
+  private:
+	bool enabled = false;
+
+	vkb::sg::ResidencyPolicy::Settings settings;
+};
+}        // namespace plugins
@@ -0,0 +1,129 @@
+/* Copyright (c) 2025, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "trace_capture.h"
+
+#include <core/util/tracing.hpp>
+
+#include "filesystem/filesystem.hpp"
+#include "stats/gpu_profiler.h"
+
+namespace plugins
+{
+TraceCapture::TraceCapture() :
+    TraceCaptureTags("Trace Capture",
+                     "Capture a CPU and GPU trace for Perfetto or chrome://tracing",
+                     {vkb::Hook::OnUpdate, vkb::Hook::OnAppStart, vkb::Hook::OnAppClose, vkb::Hook::OnPlatformClose},
+                     {},
+                     {{"trace", "Write a trace to the given file, in the Chrome JSON format if it ends in .json, in the Perfetto format otherwise"},
+                      {"trace-frames", "Number of frames to trace after the sample starts, the sample is traced until it closes by default"}})
+{
+}
+
+bool TraceCapture::handle_option(std::deque<std::string> &arguments)
+{
+	assert(!arguments.empty() && (arguments[0].substr(0, 2) == "--"));
+	std::string option = arguments[0].substr(2);
+	if (option == "trace")
+	{
+		if (arguments.size() < 2)
+		{
+			LOGE("Option \"trace\" is missing the file to write the trace to!");
+			return false;
+		}
+		output_path = arguments[1];
+
+		// Trace from now on, so that loading the sample is traced too
+		vkb::tracing::set_thread_name("Main thread");
+		vkb::tracing::set_enabled(true);
+
+		arguments.pop_front();
+		arguments.pop_front();
+		return true;
+	}
+	else if (option == "trace-frames")
+	{
+		if (arguments.size() < 2)
+		{
+			LOGE("Option \"trace-frames\" is missing the number of frames to trace!");
+			return false;
+		}
+		frame_count = static_cast<uint32_t>(std::stoul(arguments[1]));
+
+		arguments.pop_front();
+		arguments.pop_front();
+		return true;
+	}
+	return false;
+}
+
+void TraceCapture::on_update(float delta_time)
+{
+	if (frame_count != 0 && ++current_frame == frame_count)
+	{
+		write_trace();
+	}
+}
+
+void TraceCapture::on_app_start(const std::string &app_id)
+{
+	current_frame = 0;
+}
+
+void TraceCapture::on_app_close(const std::string &app_id)
+{
+	// The sample still exists, so the GPU profiler can be read
+	write_trace();
+}
+
+void TraceCapture::on_platform_close()
+{
+	write_trace();
+}
+
+void TraceCapture::write_trace()
+{
+	if (written || output_path.empty())
+	{
+		return;
+	}
+	written = true;
+
+	vkb::tracing::set_enabled(false);
+
+	auto tracks = vkb::tracing::capture();
+	if (auto *profiler = vkb::GpuProfiler::get_active())
+	{
+		tracks.push_back(profiler->get_trace_track());
+	}
+
+	size_t event_count = 0;
+	for (auto &track : tracks)
+	{
+		event_count += track.slices.size();
+	}
+
+	bool json = output_path.size() >= 5 && output_path.compare(output_path.size() - 5, 5, ".json") == 0;
+	vkb::filesystem::get()->write_file(output_path, json ? vkb::tracing::to_chrome_json(tracks) : vkb::tracing::to_perfetto_protobuf(tracks));
+
+	LOGI("Wrote {} events of {} tracks to {}", event_count, tracks.size(), output_path);
+	if (auto dropped = vkb::tracing::get_dropped_event_count())
+	{
+		LOGW("{} events were dropped, as the buffers of their threads were full", dropped);
+	}
+}
+}        // namespace plugins
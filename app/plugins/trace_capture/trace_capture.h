@@ -0,0 +1,67 @@
+/* Copyright (c) 2025, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "platform/plugins/plugin_base.h"
+
+namespace plugins
+{
+class TraceCapture;
+
+using TraceCaptureTags = vkb::PluginBase<TraceCapture, vkb::tags::Passive>;
+
+/**
+ * @brief Trace Capture
+ *
+ * Records CPU events of the built-in tracer from startup, so that loading is included, and writes them with the GPU
+ * regions of the active GPU profiler when the sample closes, or after a number of frames. Files ending in .json are
+ * written in the Chrome trace event format, other files in the Perfetto protobuf format. Both open in ui.perfetto.dev.
+ *
+ * Usage: vulkan_samples sample subpasses --trace subpasses.pftrace --trace-frames 300
+ *
+ */
+class TraceCapture : public TraceCaptureTags
+{
+  public:
+	TraceCapture();
+
+	virtual ~TraceCapture() = default;
+
+	bool handle_option(std::deque<std::string> &arguments) override;
+
+	void on_update(float delta_time) override;
+
+	void on_app_start(const std::string &app_id) override;
+
+	void on_app_close(const std::string &app_id) override;
+
+	void on_platform_close() override;
+
+  private:
+	void write_trace();
+
+	std::string output_path;
+
+	// Frames to capture after the sample starts, 0 to capture until it closes
+	uint32_t frame_count = 0;
+
+	uint32_t current_frame = 0;
+
+	bool written = false;
+};
+}        // namespace plugins
@@ -0,0 +1,159 @@
+/* Copyright (c) 2025, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @brief Packs directory trees into an archive that vkb::filesystem::mount_archive serves files from
+ *
+ * Files are named with their path relative to the root directory, which defaults to the working directory.
+ * An archive named assets.vkbarc in the external storage directory is mounted over it when the samples start,
+ * so that packing the assets and shaders directories from there replaces reading thousands of loose files.
+ *
+ * The files are read directly from the disk, an archive already mounted is not read from.
+ *
+ * Usage: asset_packer <output.vkbarc> [<directory>...] [--root <directory>] [--alignment <bytes>] [--no-compression]
+ */
+
+#include <algorithm>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "core/util/logging.hpp"
+#include "filesystem/archive.hpp"
+#include "timer.h"
+
+namespace
+{
+std::vector<uint8_t> read_file(const std::filesystem::path &path)
+{
+	std::ifstream file{path, std::ios::binary | std::ios::ate};
+	if (!file.is_open())
+	{
+		throw std::runtime_error("Failed to open file for reading at path: " + path.string());
+	}
+
+	std::vector<uint8_t> contents(static_cast<size_t>(file.tellg()));
+	file.seekg(0);
+	file.read(reinterpret_cast<char *>(contents.data()), contents.size());
+	return contents;
+}
+}        // namespace
+
+int main(int argc, char *argv[])
+{
+	if (argc < 2)
+	{
+		LOGE("Usage: asset_packer <output.vkbarc> [<directory>...] [--root <directory>] [--alignment <bytes>] [--no-compression]");
+		return 1;
+	}
+
+	std::filesystem::path              output_file{argv[1]};
+	std::filesystem::path              root = std::filesystem::current_path();
+	std::vector<std::filesystem::path> directories;
+	uint32_t                           alignment   = 64;
+	auto                               compression = vkb::filesystem::ArchiveCompression::LZ4;
+
+	for (int i = 2; i < argc; ++i)
+	{
+		std::string argument{argv[i]};
+		if (argument == "--root" && i + 1 < argc)
+		{
+			root = argv[++i];
+		}
+		else if (argument == "--alignment" && i + 1 < argc)
+		{
+			alignment = static_cast<uint32_t>(std::stoul(argv[++i]));
+		}
+		else if (argument == "--no-compression")
+		{
+			compression = vkb::filesystem::ArchiveCompression::None;
+		}
+		else if (argument.rfind("--", 0) != 0)
+		{
+			directories.emplace_back(argument);
+		}
+		else
+		{
+			LOGE("Unknown argument {}", argument);
+			return 1;
+		}
+	}
+
+	if (directories.empty())
+	{
+		directories = {"assets", "shaders"};
+	}
+
+	// Sorted, so that files of a directory are next to each other in the archive
+	std::vector<std::filesystem::path> files;
+	for (auto &directory : directories)
+	{
+		auto path = root / directory;
+		if (!std::filesystem::is_directory(path))
+		{
+			LOGE("{} is not a directory", path.string());
+			return 1;
+		}
+
+		for (auto &entry : std::filesystem::recursive_directory_iterator(path))
+		{
+			if (entry.is_regular_file())
+			{
+				files.push_back(entry.path().lexically_relative(root));
+			}
+		}
+	}
+	std::sort(files.begin(), files.end());
+
+	vkb::Timer timer;
+	timer.start();
+
+	size_t total_size       = 0;
+	size_t stored_size      = 0;
+	size_t compressed_count = 0;
+	try
+	{
+		vkb::filesystem::ArchiveWriter writer{output_file, alignment};
+		for (auto &file : files)
+		{
+			auto contents = read_file(root / file);
+			auto stored   = writer.add(file.generic_string(), contents, compression);
+
+			total_size += contents.size();
+			stored_size += stored;
+			compressed_count += stored < contents.size() ? 1 : 0;
+		}
+		writer.finish();
+	}
+	catch (const std::exception &e)
+	{
+		LOGE("Failed to pack {}: {}", output_file.string(), e.what());
+		return 1;
+	}
+
+	double pack_ms = timer.stop<vkb::Timer::Milliseconds>();
+
+	LOGI("Packed {} files into {}: {:.2f} MiB stored as {:.2f} MiB, {} files compressed | {:.2f} ms",
+	     files.size(),
+	     output_file.string(),
+	     total_size / (1024.0 * 1024.0),
+	     stored_size / (1024.0 * 1024.0),
+	     compressed_count,
+	     pack_ms);
+
+	return 0;
+}
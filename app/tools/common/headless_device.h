@@ -0,0 +1,94 @@
+/* Copyright (c) 2025, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <memory>
+#include <string>
+
+#include "common/error.h"
+#include "core/hpp_debug.h"
+#include "core/hpp_device.h"
+#include "core/hpp_instance.h"
+
+namespace vkb
+{
+namespace tools
+{
+/**
+ * @brief Minimal Vulkan instance and device for command line tools and benchmarks
+ *
+ * Uses VK_EXT_headless_surface, so no window system is needed.
+ */
+class HeadlessDevice
+{
+  public:
+	HeadlessDevice(const std::string &application_name, std::unordered_map<const char *, bool> const &device_extensions = {})
+	{
+#if defined(_HPP_VULKAN_LIBRARY)
+		static vk::detail::DynamicLoader dl(_HPP_VULKAN_LIBRARY);
+#else
+		static vk::detail::DynamicLoader dl;
+#endif
+		VULKAN_HPP_DEFAULT_DISPATCHER.init(dl.getProcAddress<PFN_vkGetInstanceProcAddr>("vkGetInstanceProcAddr"));
+
+		VkResult result = volkInitialize();
+		if (result)
+		{
+			throw VulkanException(result, "Failed to initialize volk.");
+		}
+
+		instance = std::make_unique<vkb::core::HPPInstance>(
+		    application_name,
+		    std::unordered_map<const char *, bool>{{VK_KHR_SURFACE_EXTENSION_NAME, false}, {VK_EXT_HEADLESS_SURFACE_EXTENSION_NAME, false}});
+
+		surface = instance->get_handle().createHeadlessSurfaceEXT({});
+
+		auto &gpu = instance->get_suitable_gpu(surface, true);
+		device    = std::make_unique<vkb::core::HPPDevice>(gpu, surface, std::make_unique<vkb::core::HPPDummyDebugUtils>(), device_extensions);
+
+		VULKAN_HPP_DEFAULT_DISPATCHER.init(device->get_handle());
+	}
+
+	HeadlessDevice(const HeadlessDevice &)            = delete;
+	HeadlessDevice(HeadlessDevice &&)                 = delete;
+	HeadlessDevice &operator=(const HeadlessDevice &) = delete;
+	HeadlessDevice &operator=(HeadlessDevice &&)      = delete;
+
+	~HeadlessDevice()
+	{
+		device.reset();
+		if (surface)
+		{
+			instance->get_handle().destroySurfaceKHR(surface);
+		}
+	}
+
+	vkb::core::HPPDevice &get_device()
+	{
+		return *device;
+	}
+
+  private:
+	std::unique_ptr<vkb::core::HPPInstance> instance;
+
+	vk::SurfaceKHR surface;
+
+	std::unique_ptr<vkb::core::HPPDevice> device;
+};
+}        // namespace tools
+}        // namespace vkb
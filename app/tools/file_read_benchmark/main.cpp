@@ -0,0 +1,164 @@
+/* Copyright (c) 2025, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @brief Compares reading every file of a directory tree into vectors with mapping them into memory
+ *
+ * Each file is consumed by summing its contents, as a decoder would read it once. The tree is read once
+ * before measuring, so that both methods read from the page cache.
+ *
+ * Usage: file_read_benchmark [<directory>] [--iterations <count>]
+ */
+
+#include <algorithm>
+#include <cstring>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "core/util/logging.hpp"
+#include "filesystem/filesystem.hpp"
+#include "timer.h"
+
+namespace
+{
+uint64_t checksum(const uint8_t *data, size_t size)
+{
+	uint64_t sum = 0;
+	size_t   i   = 0;
+	for (; i + sizeof(uint64_t) <= size; i += sizeof(uint64_t))
+	{
+		uint64_t word;
+		std::memcpy(&word, data + i, sizeof(uint64_t));
+		sum += word;
+	}
+	for (; i < size; ++i)
+	{
+		sum += data[i];
+	}
+	return sum;
+}
+
+/**
+ * @brief Reads all the files iterations times
+ * @return Shortest time of an iteration in milliseconds
+ */
+double measure(const std::vector<vkb::filesystem::Path> &files, uint32_t iterations, uint64_t &sum, const std::function<uint64_t(const vkb::filesystem::Path &)> &read)
+{
+	double min_ms = 0.0;
+
+	for (uint32_t i = 0; i < iterations; ++i)
+	{
+		vkb::Timer timer;
+		timer.start();
+
+		sum = 0;
+		for (auto &file : files)
+		{
+			sum += read(file);
+		}
+
+		double elapsed_ms = timer.stop<vkb::Timer::Milliseconds>();
+		min_ms            = i == 0 ? elapsed_ms : std::min(min_ms, elapsed_ms);
+	}
+
+	return min_ms;
+}
+}        // namespace
+
+int main(int argc, char *argv[])
+{
+	std::string directory  = "assets";
+	uint32_t    iterations = 5;
+
+	for (int i = 1; i < argc; ++i)
+	{
+		std::string argument{argv[i]};
+		if (argument == "--iterations" && i + 1 < argc)
+		{
+			iterations = std::max(1u, static_cast<uint32_t>(std::stoul(argv[++i])));
+		}
+		else if (argument.rfind("--", 0) != 0)
+		{
+			directory = argument;
+		}
+		else
+		{
+			LOGE("Unknown argument {}", argument);
+			return 1;
+		}
+	}
+
+	vkb::filesystem::init();
+	auto fs = vkb::filesystem::get();
+
+	if (!fs->is_directory(directory))
+	{
+		LOGE("{} is not a directory", directory);
+		return 1;
+	}
+
+	std::vector<vkb::filesystem::Path> files;
+	size_t                             total_size = 0;
+	for (auto &entry : std::filesystem::recursive_directory_iterator(directory))
+	{
+		if (entry.is_regular_file())
+		{
+			files.push_back(entry.path());
+			total_size += entry.file_size();
+		}
+	}
+
+	if (files.empty())
+	{
+		LOGE("No files in {}", directory);
+		return 1;
+	}
+
+	// Warm up the page cache
+	for (auto &file : files)
+	{
+		fs->read_file_binary(file);
+	}
+
+	uint64_t read_sum = 0;
+	double   read_ms  = measure(files, iterations, read_sum, [&](const vkb::filesystem::Path &file) {
+		auto data = fs->read_file_binary(file);
+		return checksum(data.data(), data.size());
+	});
+
+	uint64_t map_sum = 0;
+	double   map_ms  = measure(files, iterations, map_sum, [&](const vkb::filesystem::Path &file) {
+		auto data = fs->map_file(file);
+		return checksum(data->data(), data->size());
+	});
+
+	if (read_sum != map_sum)
+	{
+		LOGE("The mapped files differ from the read files");
+		return 1;
+	}
+
+	double total_mib = total_size / (1024.0 * 1024.0);
+
+	LOGI("{} files, {:.2f} MiB in {}", files.size(), total_mib, directory);
+	LOGI("{:8} | {:9.2f} ms | {:9.2f} MiB/s", "read", read_ms, total_mib * 1000.0 / read_ms);
+	LOGI("{:8} | {:9.2f} ms | {:9.2f} MiB/s", "map", map_ms, total_mib * 1000.0 / map_ms);
+	LOGI("speedup  | {:8.2f}x", read_ms / map_ms);
+
+	return 0;
+}
@@ -0,0 +1,190 @@
+/* Copyright (c) 2025, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @brief Measures the throughput of vkb::InstanceGrid instance generation and per-cell frustum culling
+ *
+ * The instances are rocks distributed on the two rings of the instancing sample. Generating with one thread and with all
+ * threads is checked to give identical instances. Culling is measured over random views of the rings, and compared to
+ * culling every instance on its own to show how many instances the cells draw in excess.
+ *
+ * Usage: instance_grid_benchmark [--instances <count>] [--threads <count>] [--views <count>] [--instances-per-cell <count>]
+ * Without --instances, a sweep from 8192 to 4194304 instances is run.
+ */
+
+#include <algorithm>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "core/util/logging.hpp"
+#include "geometry/frustum.h"
+#include "geometry/instance_grid.h"
+#include "timer.h"
+
+namespace
+{
+// The instance layout of the instancing sample
+struct InstanceData
+{
+	glm::vec3 pos;
+	glm::vec3 rot;
+	float     scale;
+	uint32_t  texIndex;
+};
+
+glm::vec4 generate_rock(uint32_t index, vkb::CounterRandom &random, InstanceData &instance)
+{
+	glm::vec2 ring = index % 2 == 0 ? glm::vec2(7.0f, 11.0f) : glm::vec2(14.0f, 18.0f);
+
+	float rho         = std::sqrt((ring[1] * ring[1] - ring[0] * ring[0]) * random.next_float() + ring[0] * ring[0]);
+	float theta       = 2.0f * glm::pi<float>() * random.next_float();
+	instance.pos      = glm::vec3(rho * std::cos(theta), random.next_float() * 0.5f - 0.25f, rho * std::sin(theta));
+	instance.rot      = glm::vec3(glm::pi<float>() * random.next_float(), glm::pi<float>() * random.next_float(), glm::pi<float>() * random.next_float());
+	instance.scale    = 0.75f * (1.5f + random.next_float() - random.next_float());
+	instance.texIndex = random.next_uint(4);
+	return glm::vec4(instance.pos, instance.scale);
+}
+
+std::vector<InstanceData> generate(vkb::InstanceGrid &grid, uint32_t count, double &elapsed_ms)
+{
+	vkb::Timer timer;
+	timer.start();
+	auto instances = grid.generate<InstanceData>(count, 0, generate_rock);
+	elapsed_ms     = timer.stop<vkb::Timer::Milliseconds>();
+	return instances;
+}
+
+// Views from random points in and around the rings, looking in random directions close to the plane of the rings
+std::vector<vkb::Frustum> create_views(uint32_t count)
+{
+	glm::mat4 projection = glm::perspective(glm::radians(60.0f), 16.0f / 9.0f, 0.1f, 256.0f);
+
+	std::vector<vkb::Frustum> views(count);
+	for (uint32_t i = 0; i < count; ++i)
+	{
+		vkb::CounterRandom random{1, i};
+
+		float     angle     = 2.0f * glm::pi<float>() * random.next_float();
+		float     radius    = 5.0f + 20.0f * random.next_float();
+		float     direction = 2.0f * glm::pi<float>() * random.next_float();
+		glm::vec3 eye(radius * std::cos(angle), 4.0f * random.next_float() - 2.0f, radius * std::sin(angle));
+		glm::vec3 target = eye + glm::vec3(std::cos(direction), 0.4f * random.next_float() - 0.2f, std::sin(direction));
+
+		views[i].update(projection * glm::lookAt(eye, target, glm::vec3(0.0f, 1.0f, 0.0f)));
+	}
+	return views;
+}
+}        // namespace
+
+int main(int argc, char *argv[])
+{
+	std::vector<uint32_t> instance_counts{8192, 65536, 262144, 1048576, 4194304};
+	size_t                thread_count       = std::max(1u, std::thread::hardware_concurrency());
+	uint32_t              view_count         = 256;
+	uint32_t              instances_per_cell = 256;
+
+	for (int i = 1; i + 1 < argc; i += 2)
+	{
+		std::string argument{argv[i]};
+
+		if (argument == "--instances")
+		{
+			instance_counts = {static_cast<uint32_t>(std::stoul(argv[i + 1]))};
+		}
+		else if (argument == "--threads")
+		{
+			thread_count = std::max<size_t>(1, std::stoul(argv[i + 1]));
+		}
+		else if (argument == "--views")
+		{
+			view_count = std::max(1u, static_cast<uint32_t>(std::stoul(argv[i + 1])));
+		}
+		else if (argument == "--instances-per-cell")
+		{
+			instances_per_cell = std::max(1u, static_cast<uint32_t>(std::stoul(argv[i + 1])));
+		}
+		else
+		{
+			LOGE("Unknown argument {}", argument);
+			return 1;
+		}
+	}
+
+	vkb::InstanceGrid single_thread{1, instances_per_cell};
+	vkb::InstanceGrid multi_thread{thread_count, instances_per_cell};
+
+	auto views = create_views(view_count);
+
+	LOGI("{} threads | {} views | {} instances per cell", thread_count, view_count, instances_per_cell);
+
+	for (auto instance_count : instance_counts)
+	{
+		double single_thread_ms = 0.0;
+		double multi_thread_ms  = 0.0;
+		auto   reference        = generate(single_thread, instance_count, single_thread_ms);
+		auto   instances        = generate(multi_thread, instance_count, multi_thread_ms);
+		bool   deterministic    = std::memcmp(reference.data(), instances.data(), instance_count * sizeof(InstanceData)) == 0;
+
+		std::vector<VkDrawIndexedIndirectCommand> commands(multi_thread.get_max_draw_count());
+
+		uint64_t drawn_instances = 0;
+		uint64_t draw_count      = 0;
+
+		vkb::Timer timer;
+		timer.start();
+		for (auto &view : views)
+		{
+			auto result = multi_thread.cull(view, 0, commands.data());
+			drawn_instances += result.visible_instances;
+			draw_count += result.draw_count;
+		}
+		double cull_ms = timer.stop<vkb::Timer::Milliseconds>() / view_count;
+
+		// Instances visible on their own, the least any culling could draw
+		uint64_t visible_instances = 0;
+		for (auto &view : views)
+		{
+			visible_instances += std::count_if(instances.begin(), instances.end(), [&view](const InstanceData &instance) {
+				return view.check_sphere(instance.pos, instance.scale);
+			});
+		}
+
+		auto   resolution = multi_thread.get_resolution();
+		size_t cell_count = multi_thread.get_cells().size();
+
+		LOGI("instances {:8} | generate 1 thread {:8.2f} ms, {} threads {:8.2f} ms, {:6.1f} M instances/s | grid {}x{}x{}, {:6} cells | cull {:7.3f} ms, {:7.1f} M cells/s, {:5.1f} draws | drawn {:5.1f}%, visible {:5.1f}% | deterministic {}",
+		     instance_count,
+		     single_thread_ms,
+		     thread_count,
+		     multi_thread_ms,
+		     instance_count / (multi_thread_ms * 1e3),
+		     resolution.x,
+		     resolution.y,
+		     resolution.z,
+		     cell_count,
+		     cull_ms,
+		     cell_count / (cull_ms * 1e3),
+		     static_cast<double>(draw_count) / view_count,
+		     100.0 * drawn_instances / (static_cast<double>(instance_count) * view_count),
+		     100.0 * visible_instances / (static_cast<double>(instance_count) * view_count),
+		     deterministic ? "yes" : "no");
+	}
+
+	return 0;
+}
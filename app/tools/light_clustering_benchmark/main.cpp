@@ -0,0 +1,145 @@
+/* Copyright (c) 2025, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @brief Measures the CPU cost of vkb::rendering::LightClustering::build
+ *
+ * Usage: light_clustering_benchmark [--lights <count>] [--threads <count>] [--iterations <count>]
+ * Without --lights, a sweep from 256 to 16384 point lights is run.
+ */
+
+#include <algorithm>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <glm/gtc/matrix_transform.hpp>
+
+#include "core/util/logging.hpp"
+#include "rendering/light_clustering.h"
+#include "scene_graph/components/light.h"
+#include "timer.h"
+
+namespace
+{
+std::vector<vkb::rendering::Light> create_lights(uint32_t count)
+{
+	// Fixed seed so that runs are comparable
+	std::mt19937                          generator{1337};
+	std::uniform_real_distribution<float> position_x{-1000.0f, 1000.0f};
+	std::uniform_real_distribution<float> position_y{0.0f, 400.0f};
+	std::uniform_real_distribution<float> position_z{-2000.0f, 0.0f};
+	std::uniform_real_distribution<float> color{0.0f, 1.0f};
+
+	std::vector<vkb::rendering::Light> lights(count);
+	for (auto &light : lights)
+	{
+		light.position  = {position_x(generator), position_y(generator), position_z(generator), static_cast<float>(vkb::sg::LightType::Point)};
+		light.color     = {color(generator), color(generator), color(generator), 0.2f};
+		light.direction = {0.0f, 0.0f, -1.0f, 0.0f};
+		light.info      = {0.0f, 0.0f};
+	}
+	return lights;
+}
+}        // namespace
+
+int main(int argc, char *argv[])
+{
+	std::vector<uint32_t> light_counts{256, 1024, 4096, 16384};
+	size_t                thread_count = std::thread::hardware_concurrency();
+	uint32_t              iterations   = 100;
+
+	for (int i = 1; i + 1 < argc; i += 2)
+	{
+		std::string argument{argv[i]};
+		uint32_t    value = static_cast<uint32_t>(std::stoul(argv[i + 1]));
+
+		if (argument == "--lights")
+		{
+			light_counts = {value};
+		}
+		else if (argument == "--threads")
+		{
+			thread_count = value;
+		}
+		else if (argument == "--iterations")
+		{
+			iterations = std::max(1u, value);
+		}
+		else
+		{
+			LOGE("Unknown argument {}", argument);
+			return 1;
+		}
+	}
+
+	const float      near_plane = 0.1f;
+	const float      far_plane  = 4000.0f;
+	const VkExtent2D extent{1920, 1080};
+
+	glm::mat4 view = glm::lookAt(glm::vec3{0.0f, 150.0f, 100.0f}, glm::vec3{0.0f, 150.0f, -100.0f}, glm::vec3{0.0f, 1.0f, 0.0f});
+
+	// Same convention as sg::PerspectiveCamera, which uses a reversed depth buffer
+	glm::mat4 projection = vkb::rendering::vulkan_style_projection(
+	    glm::perspective(glm::radians(60.0f), static_cast<float>(extent.width) / extent.height, far_plane, near_plane));
+
+	for (size_t threads : {size_t{1}, thread_count})
+	{
+		vkb::rendering::LightClustering light_clustering{{16, 9, 24}, 128, threads};
+
+		for (auto light_count : light_counts)
+		{
+			auto lights = create_lights(light_count);
+
+			// Warm up, so that cluster bounds and scratch memory are allocated outside of the measurement
+			light_clustering.build(std::vector<vkb::rendering::Light>{lights}, 0, view, projection, near_plane, far_plane, extent);
+
+			double total_ms = 0.0;
+			for (uint32_t i = 0; i < iterations; ++i)
+			{
+				auto lights_copy = lights;
+
+				vkb::Timer timer;
+				timer.start();
+				light_clustering.build(std::move(lights_copy), 0, view, projection, near_plane, far_plane, extent);
+				total_ms += timer.stop<vkb::Timer::Milliseconds>();
+			}
+
+			const auto &ranges          = light_clustering.get_cluster_ranges();
+			uint32_t    max_cluster     = 0;
+			size_t      active_clusters = 0;
+			for (const auto &range : ranges)
+			{
+				max_cluster = std::max(max_cluster, range.count);
+				active_clusters += range.count > 0 ? 1 : 0;
+			}
+
+			LOGI("threads {:2} | lights {:6} | {:8.3f} ms/build | indices {:7} | active clusters {:5}/{} | max lights per cluster {:3} | overflow {}",
+			     threads,
+			     light_count,
+			     total_ms / iterations,
+			     light_clustering.get_light_indices().size(),
+			     active_clusters,
+			     ranges.size(),
+			     max_cluster,
+			     light_clustering.get_overflow_count());
+		}
+	}
+
+	return 0;
+}
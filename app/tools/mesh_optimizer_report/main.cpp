@@ -0,0 +1,166 @@
+/* Copyright (c) 2025, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @brief Reports the vertex cache efficiency of the primitives of a glTF file before and after vkb::optimize_mesh
+ *
+ * Runs on the CPU only, so the effect of the optimization can be measured without a GPU.
+ *
+ * Usage: mesh_optimizer_report <file.gltf|file.glb> [--threads <count>] [--no-weld] [--no-overdraw]
+ */
+
+#include <algorithm>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <ctpl_stl.h>
+
+#include "core/util/logging.hpp"
+#include "gltf_loader.h"
+#include "timer.h"
+
+int main(int argc, char *argv[])
+{
+	if (argc < 2)
+	{
+		LOGE("Usage: mesh_optimizer_report <file.gltf|file.glb> [--threads <count>] [--no-weld] [--no-overdraw]");
+		return 1;
+	}
+
+	std::string               file_name{argv[1]};
+	size_t                    thread_count = std::max(1u, std::thread::hardware_concurrency());
+	vkb::MeshOptimizerOptions options;
+
+	for (int i = 2; i < argc; ++i)
+	{
+		std::string argument{argv[i]};
+		if (argument == "--threads" && i + 1 < argc)
+		{
+			thread_count = std::max<size_t>(1, std::stoul(argv[++i]));
+		}
+		else if (argument == "--no-weld")
+		{
+			options.weld_vertices = false;
+		}
+		else if (argument == "--no-overdraw")
+		{
+			options.optimize_overdraw = false;
+		}
+		else
+		{
+			LOGE("Unknown argument {}", argument);
+			return 1;
+		}
+	}
+
+	tinygltf::Model    model;
+	tinygltf::TinyGLTF gltf_loader;
+	std::string        err;
+	std::string        warn;
+
+	bool binary = file_name.size() > 4 && file_name.compare(file_name.size() - 4, 4, ".glb") == 0;
+	bool result = binary ? gltf_loader.LoadBinaryFromFile(&model, &err, &warn, file_name) : gltf_loader.LoadASCIIFromFile(&model, &err, &warn, file_name);
+	if (!result || !err.empty())
+	{
+		LOGE("Failed to load gltf file {}: {}", file_name, err);
+		return 1;
+	}
+
+	struct Result
+	{
+		std::string              name;
+		size_t                   triangle_count = 0;
+		vkb::MeshOptimizerReport report;
+	};
+
+	vkb::Timer timer;
+	timer.start();
+
+	ctpl::thread_pool                thread_pool(static_cast<int>(thread_count));
+	std::vector<std::future<Result>> futures;
+	for (const auto &mesh : model.meshes)
+	{
+		for (size_t primitive_index = 0; primitive_index < mesh.primitives.size(); ++primitive_index)
+		{
+			futures.push_back(thread_pool.push([&, primitive_index](size_t) {
+				Result             primitive_result;
+				vkb::PrimitiveData data;
+				primitive_result.name = fmt::format("'{}' #{}", mesh.name, primitive_index);
+
+				if (vkb::read_primitive_data(model, mesh.primitives[primitive_index], data))
+				{
+					vkb::MeshOptimizerOptions primitive_options = options;
+					primitive_options.position_stream           = std::find(data.attribute_names.begin(), data.attribute_names.end(), "position") - data.attribute_names.begin();
+
+					primitive_result.triangle_count = data.indices.size() / 3;
+					primitive_result.report         = vkb::optimize_mesh(data.indices, data.streams, primitive_options);
+				}
+				return primitive_result;
+			}));
+		}
+	}
+
+	vkb::MeshOptimizerReport totals;
+	size_t                   triangle_count = 0;
+
+	for (auto &future : futures)
+	{
+		Result primitive_result = future.get();
+		if (primitive_result.triangle_count == 0)
+		{
+			LOGI("{:40} | skipped, not an indexed triangle list", primitive_result.name);
+			continue;
+		}
+
+		auto &report = primitive_result.report;
+		LOGI("{:40} | {:8} triangles | ACMR {:5.3f} -> {:5.3f} | ATVR {:5.3f} -> {:5.3f} | {:8} -> {:8} vertices",
+		     primitive_result.name,
+		     primitive_result.triangle_count,
+		     report.before.acmr,
+		     report.after.acmr,
+		     report.before.atvr,
+		     report.after.atvr,
+		     report.vertex_count_before,
+		     report.vertex_count_after);
+
+		totals.before.vertices_transformed += report.before.vertices_transformed;
+		totals.after.vertices_transformed += report.after.vertices_transformed;
+		totals.vertex_count_before += report.vertex_count_before;
+		totals.vertex_count_after += report.vertex_count_after;
+		triangle_count += primitive_result.triangle_count;
+	}
+
+	double elapsed_ms = timer.stop<vkb::Timer::Milliseconds>();
+
+	if (triangle_count > 0)
+	{
+		LOGI("{:40} | {:8} triangles | ACMR {:5.3f} -> {:5.3f} | ATVR {:5.3f} -> {:5.3f} | {:8} -> {:8} vertices | {:.2f} ms on {} threads",
+		     "total",
+		     triangle_count,
+		     static_cast<double>(totals.before.vertices_transformed) / triangle_count,
+		     static_cast<double>(totals.after.vertices_transformed) / triangle_count,
+		     static_cast<double>(totals.before.vertices_transformed) / totals.vertex_count_before,
+		     static_cast<double>(totals.after.vertices_transformed) / totals.vertex_count_after,
+		     totals.vertex_count_before,
+		     totals.vertex_count_after,
+		     elapsed_ms,
+		     thread_count);
+	}
+
+	return 0;
+}
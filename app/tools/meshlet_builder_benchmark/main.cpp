@@ -0,0 +1,258 @@
+/* Copyright (c) 2025, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @brief Measures the build time and fill efficiency of vkb::build_meshlets
+ *
+ * Builds the meshlets of several tessellated spheres, once with the triangles in generation order
+ * and once shuffled, and compares them against splitting the index buffer in submission order.
+ * Cones are only computed by the builder, so the submission order rows report no cullable cones.
+ *
+ * Usage: meshlet_builder_benchmark [--segments <count>] [--submeshes <count>] [--threads <count>] [--max-vertices <count>] [--max-triangles <count>]
+ */
+
+#include <algorithm>
+#include <numeric>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <glm/gtc/constants.hpp>
+
+#include "core/util/logging.hpp"
+#include "geometry/meshlet_builder.h"
+#include "timer.h"
+
+namespace
+{
+struct Mesh
+{
+	std::vector<glm::vec3> positions;
+	std::vector<uint32_t>  indices;
+};
+
+Mesh create_sphere(uint32_t segments)
+{
+	Mesh mesh;
+
+	const float pi = glm::pi<float>();
+	for (uint32_t ring = 0; ring <= segments; ++ring)
+	{
+		float theta = pi * ring / segments;
+		for (uint32_t segment = 0; segment <= segments * 2; ++segment)
+		{
+			float phi = pi * segment / segments;
+			mesh.positions.emplace_back(std::sin(theta) * std::cos(phi), std::cos(theta), std::sin(theta) * std::sin(phi));
+		}
+	}
+
+	const uint32_t row = segments * 2 + 1;
+	for (uint32_t ring = 0; ring < segments; ++ring)
+	{
+		for (uint32_t segment = 0; segment < segments * 2; ++segment)
+		{
+			uint32_t top_left = ring * row + segment;
+			mesh.indices.insert(mesh.indices.end(), {top_left, top_left + 1, top_left + row, top_left + 1, top_left + row + 1, top_left + row});
+		}
+	}
+
+	return mesh;
+}
+
+void shuffle_triangles(Mesh &mesh, uint32_t seed)
+{
+	std::vector<uint32_t> order(mesh.indices.size() / 3);
+	std::iota(order.begin(), order.end(), 0);
+	std::shuffle(order.begin(), order.end(), std::mt19937{seed});
+
+	std::vector<uint32_t> indices;
+	indices.reserve(mesh.indices.size());
+	for (auto triangle : order)
+	{
+		indices.insert(indices.end(), mesh.indices.begin() + triangle * 3, mesh.indices.begin() + triangle * 3 + 3);
+	}
+	mesh.indices = std::move(indices);
+}
+
+/**
+ * @brief Previous approach: split the index buffer in submission order once a limit is reached
+ */
+vkb::MeshletMesh build_sequential(const Mesh &mesh, const vkb::MeshletLimits &limits)
+{
+	vkb::MeshletMesh result;
+
+	std::vector<uint32_t> local_indices(mesh.positions.size(), ~0u);
+	vkb::MeshletRange     meshlet{};
+
+	auto finish_meshlet = [&]() {
+		for (uint32_t i = 0; i < meshlet.vertex_count; ++i)
+		{
+			local_indices[result.vertices[meshlet.vertex_offset + i]] = ~0u;
+		}
+		result.meshlets.push_back(meshlet);
+		meshlet                 = {};
+		meshlet.vertex_offset   = static_cast<uint32_t>(result.vertices.size());
+		meshlet.triangle_offset = static_cast<uint32_t>(result.triangles.size());
+	};
+
+	for (size_t i = 0; i < mesh.indices.size(); i += 3)
+	{
+		uint32_t new_count = 0;
+		for (size_t j = i; j < i + 3; ++j)
+		{
+			new_count += local_indices[mesh.indices[j]] == ~0u;
+		}
+		if (meshlet.vertex_count + new_count > limits.max_vertices || meshlet.triangle_count == limits.max_triangles)
+		{
+			finish_meshlet();
+		}
+
+		for (size_t j = i; j < i + 3; ++j)
+		{
+			if (local_indices[mesh.indices[j]] == ~0u)
+			{
+				local_indices[mesh.indices[j]] = meshlet.vertex_count++;
+				result.vertices.push_back(mesh.indices[j]);
+			}
+			result.triangles.push_back(static_cast<uint8_t>(local_indices[mesh.indices[j]]));
+		}
+		++meshlet.triangle_count;
+	}
+	finish_meshlet();
+
+	return result;
+}
+
+vkb::MeshletSource get_source(const Mesh &mesh)
+{
+	vkb::MeshletSource source;
+	source.indices       = mesh.indices.data();
+	source.index_count   = mesh.indices.size();
+	source.positions     = &mesh.positions[0].x;
+	source.vertex_count  = mesh.positions.size();
+	source.vertex_stride = sizeof(glm::vec3);
+	return source;
+}
+
+void report(const char *name, const std::vector<vkb::MeshletMesh> &meshes, const vkb::MeshletLimits &limits, double build_ms)
+{
+	size_t meshlet_count  = 0;
+	size_t vertex_count   = 0;
+	size_t triangle_count = 0;
+	size_t cone_count     = 0;
+
+	for (const auto &mesh : meshes)
+	{
+		meshlet_count += mesh.meshlets.size();
+		vertex_count += mesh.vertices.size();
+		for (const auto &meshlet : mesh.meshlets)
+		{
+			triangle_count += meshlet.triangle_count;
+		}
+		cone_count += std::count_if(mesh.bounds.begin(), mesh.bounds.end(), [](const vkb::MeshletBounds &bounds) { return bounds.cone_cutoff < 1.0f; });
+	}
+
+	// Fill is the fraction of the vertex and triangle limits used on average, lower vertices per triangle means less vertex shading
+	LOGI("{:20} | {:8.2f} ms | {:7} meshlets | vertex fill {:5.1f}% | triangle fill {:5.1f}% | {:4.2f} vertices per triangle | cullable cones {:5.1f}%",
+	     name,
+	     build_ms,
+	     meshlet_count,
+	     100.0 * vertex_count / (static_cast<double>(meshlet_count) * limits.max_vertices),
+	     100.0 * triangle_count / (static_cast<double>(meshlet_count) * limits.max_triangles),
+	     static_cast<double>(vertex_count) / triangle_count,
+	     100.0 * cone_count / meshlet_count);
+}
+}        // namespace
+
+int main(int argc, char *argv[])
+{
+	uint32_t           segments     = 256;
+	uint32_t           submeshes    = 8;
+	size_t             thread_count = std::thread::hardware_concurrency();
+	vkb::MeshletLimits limits;
+
+	for (int i = 1; i + 1 < argc; i += 2)
+	{
+		std::string argument{argv[i]};
+		uint32_t    value = static_cast<uint32_t>(std::stoul(argv[i + 1]));
+
+		if (argument == "--segments")
+		{
+			segments = std::max(2u, value);
+		}
+		else if (argument == "--submeshes")
+		{
+			submeshes = std::max(1u, value);
+		}
+		else if (argument == "--threads")
+		{
+			thread_count = std::max(1u, value);
+		}
+		else if (argument == "--max-vertices")
+		{
+			limits.max_vertices = value;
+		}
+		else if (argument == "--max-triangles")
+		{
+			limits.max_triangles = value;
+		}
+		else
+		{
+			LOGE("Unknown argument {}", argument);
+			return 1;
+		}
+	}
+
+	for (bool shuffled : {false, true})
+	{
+		std::vector<Mesh> meshes(submeshes, create_sphere(segments));
+		if (shuffled)
+		{
+			for (uint32_t i = 0; i < submeshes; ++i)
+			{
+				shuffle_triangles(meshes[i], i);
+			}
+		}
+
+		std::vector<vkb::MeshletSource> sources;
+		for (const auto &mesh : meshes)
+		{
+			sources.push_back(get_source(mesh));
+		}
+
+		LOGI("{} submeshes with {} triangles, {} order", submeshes, meshes[0].indices.size() / 3, shuffled ? "shuffled" : "generation");
+
+		vkb::Timer timer;
+		timer.start();
+		std::vector<vkb::MeshletMesh> sequential;
+		for (const auto &mesh : meshes)
+		{
+			sequential.push_back(build_sequential(mesh, limits));
+		}
+		report("submission order", sequential, limits, timer.stop<vkb::Timer::Milliseconds>());
+
+		for (size_t threads : {size_t{1}, thread_count})
+		{
+			timer.start();
+			auto built = vkb::build_meshlets(sources, limits, threads);
+			report(threads == 1 ? "builder, 1 thread" : "builder, all threads", built, limits, timer.stop<vkb::Timer::Milliseconds>());
+		}
+	}
+
+	return 0;
+}
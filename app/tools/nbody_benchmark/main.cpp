@@ -0,0 +1,158 @@
+/* Copyright (c) 2025, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @brief Measures the CPU cost of a vkb::NBodySimulation step, and the accuracy of the Barnes-Hut approximation
+ *
+ * The particles are created as in the compute_nbody sample. Every method is compared to brute force with the SIMD kernel,
+ * and stepping with one thread and with all threads is checked to give identical particles.
+ *
+ * Usage: nbody_benchmark [--particles-per-attractor <count>] [--threads <count>] [--steps <count>] [--theta <angle>]
+ * Without --particles-per-attractor, a sweep from 512 to 4096 particles per attractor is run.
+ */
+
+#include <algorithm>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "core/util/logging.hpp"
+#include "simulation/nbody_simulation.h"
+#include "timer.h"
+
+namespace
+{
+// The attractors of the compute_nbody sample
+const std::vector<glm::vec3> attractors = {
+    glm::vec3(5.0f, 0.0f, 0.0f),
+    glm::vec3(-5.0f, 0.0f, 0.0f),
+    glm::vec3(0.0f, 0.0f, 5.0f),
+    glm::vec3(0.0f, 0.0f, -5.0f),
+    glm::vec3(0.0f, 4.0f, 0.0f),
+    glm::vec3(0.0f, -8.0f, 0.0f),
+};
+
+const float delta_time = 1.0f / 60.0f;
+
+double measure_step(vkb::NBodySimulation &simulation, const std::vector<vkb::NBodyParticle> &initial, vkb::NBodyMethod method, uint32_t steps)
+{
+	auto particles = initial;
+
+	vkb::Timer timer;
+	timer.start();
+	for (uint32_t i = 0; i < steps; ++i)
+	{
+		simulation.step(particles, delta_time, method);
+	}
+	return timer.stop<vkb::Timer::Milliseconds>() / steps;
+}
+
+// Mean of the error of each acceleration, relative to its magnitude
+double mean_relative_error(const std::vector<glm::vec3> &accelerations, const std::vector<glm::vec3> &reference)
+{
+	double error = 0.0;
+	for (size_t i = 0; i < reference.size(); ++i)
+	{
+		error += glm::length(accelerations[i] - reference[i]) / std::max(glm::length(reference[i]), 1e-12f);
+	}
+	return error / reference.size();
+}
+}        // namespace
+
+int main(int argc, char *argv[])
+{
+	std::vector<uint32_t> particle_counts{512, 1024, 2048, 4096};
+	size_t                thread_count = std::max(1u, std::thread::hardware_concurrency());
+	uint32_t              steps        = 5;
+	vkb::NBodyParams      params;
+
+	for (int i = 1; i + 1 < argc; i += 2)
+	{
+		std::string argument{argv[i]};
+
+		if (argument == "--particles-per-attractor")
+		{
+			particle_counts = {static_cast<uint32_t>(std::stoul(argv[i + 1]))};
+		}
+		else if (argument == "--threads")
+		{
+			thread_count = std::max<size_t>(1, std::stoul(argv[i + 1]));
+		}
+		else if (argument == "--steps")
+		{
+			steps = std::max(1u, static_cast<uint32_t>(std::stoul(argv[i + 1])));
+		}
+		else if (argument == "--theta")
+		{
+			params.theta = std::stof(argv[i + 1]);
+		}
+		else
+		{
+			LOGE("Unknown argument {}", argument);
+			return 1;
+		}
+	}
+
+	vkb::NBodySimulation scalar{params, 1, false};
+	vkb::NBodySimulation single_thread{params, 1};
+	vkb::NBodySimulation multi_thread{params, thread_count};
+
+	LOGI("Kernel {} | {} threads | theta {:.2f} | {} steps", multi_thread.get_kernel_name(), thread_count, params.theta, steps);
+
+	for (auto particles_per_attractor : particle_counts)
+	{
+		// The seed the sample uses when the simulation speed is locked
+		auto   initial        = vkb::NBodySimulation::create_particles(attractors, particles_per_attractor, 0);
+		double particle_count = static_cast<double>(initial.size());
+
+		std::vector<glm::vec3> reference;
+		std::vector<glm::vec3> scalar_accelerations;
+		std::vector<glm::vec3> barnes_hut_accelerations;
+		multi_thread.compute_accelerations(initial, vkb::NBodyMethod::BruteForce, reference);
+		scalar.compute_accelerations(initial, vkb::NBodyMethod::BruteForce, scalar_accelerations);
+		multi_thread.compute_accelerations(initial, vkb::NBodyMethod::BarnesHut, barnes_hut_accelerations);
+
+		// A single scalar step is enough to compare the kernels, it is slow with many particles
+		double scalar_ms      = measure_step(scalar, initial, vkb::NBodyMethod::BruteForce, 1);
+		double brute_force_ms = measure_step(multi_thread, initial, vkb::NBodyMethod::BruteForce, steps);
+		double barnes_hut_ms  = measure_step(multi_thread, initial, vkb::NBodyMethod::BarnesHut, steps);
+
+		auto single_thread_particles = initial;
+		auto multi_thread_particles  = initial;
+		for (uint32_t i = 0; i < steps; ++i)
+		{
+			single_thread.step(single_thread_particles, delta_time, vkb::NBodyMethod::BarnesHut);
+			multi_thread.step(multi_thread_particles, delta_time, vkb::NBodyMethod::BarnesHut);
+		}
+		bool deterministic = std::memcmp(single_thread_particles.data(), multi_thread_particles.data(), initial.size() * sizeof(vkb::NBodyParticle)) == 0;
+
+		LOGI("particles {:6} | scalar {:9.2f} ms | {} {:8.2f} ms, {:6.2f} G interactions/s | Barnes-Hut {:7.2f} ms, {:5.1f}x, error {:.2e} | scalar error {:.2e} | deterministic {}",
+		     initial.size(),
+		     scalar_ms,
+		     multi_thread.get_kernel_name(),
+		     brute_force_ms,
+		     particle_count * particle_count / (brute_force_ms * 1e6),
+		     barnes_hut_ms,
+		     brute_force_ms / barnes_hut_ms,
+		     mean_relative_error(barnes_hut_accelerations, reference),
+		     mean_relative_error(scalar_accelerations, reference),
+		     deterministic ? "yes" : "no");
+	}
+
+	return 0;
+}
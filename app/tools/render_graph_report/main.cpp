@@ -0,0 +1,181 @@
+/* Copyright (c) 2025, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @brief Compiles the render graph of a deferred frame with bloom, and reports its barriers and transient memory
+ *
+ * The frame renders a G-buffer, lights it, downsamples and upsamples the bright parts into a bloom chain,
+ * tonemaps and draws the UI into the swapchain image. Runs on the CPU only, with memory requirements
+ * estimated from the image formats.
+ *
+ * Usage: render_graph_report [--width <pixels>] [--height <pixels>] [--bloom-levels <count>] [--verbose]
+ */
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include "core/util/logging.hpp"
+#include "rendering/render_graph.h"
+#include "timer.h"
+
+int main(int argc, char *argv[])
+{
+	uint32_t width        = 1920;
+	uint32_t height       = 1080;
+	uint32_t bloom_levels = 5;
+	bool     verbose      = false;
+
+	for (int i = 1; i < argc; ++i)
+	{
+		std::string argument{argv[i]};
+		if (argument == "--width" && i + 1 < argc)
+		{
+			width = std::stoul(argv[++i]);
+		}
+		else if (argument == "--height" && i + 1 < argc)
+		{
+			height = std::stoul(argv[++i]);
+		}
+		else if (argument == "--bloom-levels" && i + 1 < argc)
+		{
+			bloom_levels = static_cast<uint32_t>(std::clamp(std::stoul(argv[++i]), 1ul, 32ul));
+		}
+		else if (argument == "--verbose")
+		{
+			verbose = true;
+		}
+		else
+		{
+			LOGE("Unknown argument {}", argument);
+			return 1;
+		}
+	}
+
+	// Each level halves the extent, past the last one the smaller side would be shifted to zero
+	uint32_t max_bloom_levels = 1;
+	while ((std::max(std::min(width, height), 1u) >> (max_bloom_levels + 1)) > 0)
+	{
+		++max_bloom_levels;
+	}
+	if (bloom_levels > max_bloom_levels)
+	{
+		LOGW("Clamping {} bloom levels to {} for a {}x{} frame", bloom_levels, max_bloom_levels, width, height);
+		bloom_levels = max_bloom_levels;
+	}
+
+	using vkb::rendering::RenderGraphUsage;
+
+	auto desc = [](VkFormat format, uint32_t w, uint32_t h) {
+		vkb::rendering::RenderGraphImageDesc image_desc;
+		image_desc.format = format;
+		image_desc.extent = {std::max(w, 1u), std::max(h, 1u), 1};
+		return image_desc;
+	};
+
+	vkb::Timer timer;
+	timer.start();
+
+	vkb::rendering::RenderGraph graph;
+
+	// The swapchain image is acquired before the frame, its previous contents are discarded
+	vkb::rendering::RenderGraphAccess acquired{VK_IMAGE_LAYOUT_UNDEFINED, VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT, 0, 0, false};
+
+	auto swapchain = graph.import_image("swapchain", desc(VK_FORMAT_B8G8R8A8_SRGB, width, height), acquired, RenderGraphUsage::Present);
+	auto albedo    = graph.add_transient_image("albedo", desc(VK_FORMAT_R8G8B8A8_SRGB, width, height));
+	auto normal    = graph.add_transient_image("normal", desc(VK_FORMAT_A2B10G10R10_UNORM_PACK32, width, height));
+	auto depth     = graph.add_transient_image("depth", desc(VK_FORMAT_D32_SFLOAT, width, height));
+	auto hdr       = graph.add_transient_image("hdr", desc(VK_FORMAT_R16G16B16A16_SFLOAT, width, height));
+	auto ldr       = graph.add_transient_image("ldr", desc(VK_FORMAT_R8G8B8A8_UNORM, width, height));
+
+	graph.add_pass("G-buffer",
+	               {{albedo, RenderGraphUsage::ColorAttachment},
+	                {normal, RenderGraphUsage::ColorAttachment},
+	                {depth, RenderGraphUsage::DepthStencilAttachment}},
+	               {});
+
+	graph.add_pass("Lighting",
+	               {{albedo, RenderGraphUsage::InputAttachment},
+	                {normal, RenderGraphUsage::InputAttachment},
+	                {depth, RenderGraphUsage::InputAttachment},
+	                {hdr, RenderGraphUsage::ColorAttachment}},
+	               {});
+
+	// Downsample chain, the first level only keeps the bright parts of the lit image
+	std::vector<uint32_t> downsampled;
+	for (uint32_t level = 0; level < bloom_levels; ++level)
+	{
+		auto image = graph.add_transient_image("bloom down " + std::to_string(level),
+		                                       desc(VK_FORMAT_B10G11R11_UFLOAT_PACK32, width >> (level + 1), height >> (level + 1)));
+
+		graph.add_pass(level == 0 ? "Bloom threshold" : "Bloom downsample " + std::to_string(level),
+		               {{level == 0 ? hdr : downsampled.back(), RenderGraphUsage::FragmentSampled},
+		                {image, RenderGraphUsage::ColorAttachment}},
+		               {});
+		downsampled.push_back(image);
+	}
+
+	// Upsample chain, each level blurs the smaller one and adds the downsampled image of its size
+	uint32_t bloom = downsampled.back();
+	for (uint32_t level = bloom_levels - 1; level-- > 0;)
+	{
+		auto image = graph.add_transient_image("bloom up " + std::to_string(level),
+		                                       desc(VK_FORMAT_B10G11R11_UFLOAT_PACK32, width >> (level + 1), height >> (level + 1)));
+
+		graph.add_pass("Bloom upsample " + std::to_string(level),
+		               {{bloom, RenderGraphUsage::FragmentSampled},
+		                {downsampled[level], RenderGraphUsage::FragmentSampled},
+		                {image, RenderGraphUsage::ColorAttachment}},
+		               {});
+		bloom = image;
+	}
+
+	graph.add_pass("Tonemap",
+	               {{hdr, RenderGraphUsage::FragmentSampled},
+	                {bloom, RenderGraphUsage::FragmentSampled},
+	                {ldr, RenderGraphUsage::ColorAttachment}},
+	               {});
+
+	graph.add_pass("UI",
+	               {{ldr, RenderGraphUsage::FragmentSampled},
+	                {swapchain, RenderGraphUsage::ColorAttachment}},
+	               {});
+
+	auto &statistics = graph.compile();
+
+	double compile_ms = timer.stop<vkb::Timer::Milliseconds>();
+
+	if (verbose)
+	{
+		graph.log_summary();
+	}
+
+	double saved_percent = statistics.transient_memory_size == 0 ?
+	                           0.0 :
+	                           100.0 * (statistics.transient_memory_size - statistics.aliased_memory_size) / statistics.transient_memory_size;
+
+	LOGI("Frame of {}x{} with {} bloom levels, compiled in {:.3f} ms", width, height, bloom_levels, compile_ms);
+	LOGI("Image barriers:       {}", statistics.image_barrier_count);
+	LOGI("Pipeline barriers:    {} batched, {} unbatched", statistics.pipeline_barrier_count, statistics.unbatched_pipeline_barrier_count);
+	LOGI("Transient images:     {} in {} memory blocks", statistics.transient_image_count, statistics.memory_block_count);
+	LOGI("Transient memory:     {:.2f} MiB -> {:.2f} MiB aliased ({:.1f}% saved)",
+	     statistics.transient_memory_size / (1024.0 * 1024.0),
+	     statistics.aliased_memory_size / (1024.0 * 1024.0),
+	     saved_percent);
+
+	return 0;
+}
@@ -0,0 +1,231 @@
+/* Copyright (c) 2025, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @brief Drives vkb::sg::ResidencyPolicy with a simulated heap, and checks that it keeps the usage under its target
+ *
+ * Textures with full mip chains are laid out on a ring, and a view sweeps the ring, seeing a window of consecutive
+ * textures. Every frame the textures in view are marked used and the policy is updated with the simulated usage: other
+ * allocations plus the resident levels. Changes keep a texture pinned for a few frames, as the copies of the texture
+ * residency manager do.
+ *
+ * The run fails if a texture used in the last cold frames loses levels, or if the usage ends over the target while the
+ * textures in view would fit under it.
+ *
+ * Usage: residency_simulation [--textures <count>] [--frames <count>] [--budget-mib <size>] [--fraction <fraction>]
+ *                             [--cold-frames <count>] [--visible <count>] [--frames-per-step <count>]
+ */
+
+#include <algorithm>
+#include <deque>
+#include <string>
+#include <vector>
+
+#include "core/util/logging.hpp"
+#include "scene_graph/residency_policy.h"
+
+namespace
+{
+constexpr uint64_t mib = 1024 * 1024;
+
+// Frames a change keeps its texture pinned, like the frames in flight before its copies complete
+constexpr uint64_t change_latency = 3;
+
+std::vector<uint64_t> get_level_sizes(uint32_t extent)
+{
+	// RGBA8, with a level down to 1x1
+	std::vector<uint64_t> sizes;
+	for (uint32_t level_extent = extent; level_extent > 0; level_extent /= 2)
+	{
+		sizes.push_back(uint64_t{level_extent} * level_extent * 4);
+	}
+	return sizes;
+}
+}        // namespace
+
+int main(int argc, char *argv[])
+{
+	uint32_t texture_count   = 256;
+	uint64_t frame_count     = 20000;
+	uint64_t budget          = 1024 * mib;
+	uint32_t visible_count   = 24;
+	uint32_t frames_per_step = 10;
+
+	vkb::sg::ResidencyPolicy::Settings settings;
+
+	for (int i = 1; i + 1 < argc; i += 2)
+	{
+		std::string argument{argv[i]};
+
+		if (argument == "--textures")
+		{
+			texture_count = std::max(1u, static_cast<uint32_t>(std::stoul(argv[i + 1])));
+		}
+		else if (argument == "--frames")
+		{
+			frame_count = std::stoull(argv[i + 1]);
+		}
+		else if (argument == "--budget-mib")
+		{
+			budget = std::stoull(argv[i + 1]) * mib;
+		}
+		else if (argument == "--fraction")
+		{
+			settings.budget_fraction = std::stof(argv[i + 1]);
+		}
+		else if (argument == "--cold-frames")
+		{
+			settings.cold_frames = static_cast<uint32_t>(std::stoul(argv[i + 1]));
+		}
+		else if (argument == "--visible")
+		{
+			visible_count = std::max(1u, static_cast<uint32_t>(std::stoul(argv[i + 1])));
+		}
+		else if (argument == "--frames-per-step")
+		{
+			frames_per_step = std::max(1u, static_cast<uint32_t>(std::stoul(argv[i + 1])));
+		}
+		else
+		{
+			LOGE("Unknown argument {}", argument);
+			return 1;
+		}
+	}
+
+	vkb::sg::ResidencyPolicy policy{settings};
+
+	// Render targets and buffers take a tenth of the budget
+	uint64_t other_usage = budget / 10;
+	uint64_t target      = static_cast<uint64_t>(static_cast<double>(budget) * settings.budget_fraction);
+
+	static const uint32_t extents[] = {512, 1024, 2048, 4096};
+
+	uint64_t total_size = 0;
+	for (uint32_t index = 0; index < texture_count; ++index)
+	{
+		auto sizes = get_level_sizes(extents[(index * 7) % 4]);
+		for (auto size : sizes)
+		{
+			total_size += size;
+		}
+		policy.add_texture(std::move(sizes));
+	}
+
+	LOGI("{} textures, {} MiB | budget {} MiB, target {} MiB, other allocations {} MiB | {} in view, moving every {} frames",
+	     texture_count, total_size / mib, budget / mib, target / mib, other_usage / mib, visible_count, frames_per_step);
+
+	struct PendingChange
+	{
+		uint32_t texture;
+		uint64_t complete_frame;
+	};
+	std::deque<PendingChange> pending;
+
+	uint64_t changes          = 0;
+	uint64_t dropped_levels   = 0;
+	uint64_t restored_levels  = 0;
+	uint64_t over_frames      = 0;
+	uint64_t max_excess       = 0;
+	uint64_t blurred_frames   = 0;
+	uint64_t hot_evictions    = 0;
+	uint64_t visible_size     = 0;
+	uint64_t last_usage       = 0;
+	uint64_t warm_up_frames   = settings.cold_frames + texture_count;
+	uint64_t in_view_resident = 0;
+
+	for (uint64_t frame = 1; frame <= frame_count; ++frame)
+	{
+		while (!pending.empty() && pending.front().complete_frame <= frame)
+		{
+			policy.set_pinned(pending.front().texture, false);
+			pending.pop_front();
+		}
+
+		uint64_t usage = other_usage + policy.get_resident_size();
+
+		auto frame_changes = policy.update(frame, {budget, usage});
+		for (auto &change : frame_changes)
+		{
+			if (change.first_level > change.previous_first_level)
+			{
+				dropped_levels += change.first_level - change.previous_first_level;
+				if (policy.get_last_used_frame(change.texture) + settings.cold_frames > frame)
+				{
+					++hot_evictions;
+				}
+			}
+			else
+			{
+				restored_levels += change.previous_first_level - change.first_level;
+			}
+
+			policy.set_pinned(change.texture, true);
+			pending.push_back({change.texture, frame + change_latency});
+		}
+		changes += frame_changes.size();
+
+		last_usage = other_usage + policy.get_resident_size();
+		if (frame > warm_up_frames && last_usage > target)
+		{
+			++over_frames;
+			max_excess = std::max(max_excess, last_usage - target);
+		}
+
+		// The view draws the textures after the update, as a frame is recorded after the texture residency update
+		uint32_t first_visible = static_cast<uint32_t>(frame / frames_per_step) % texture_count;
+
+		visible_size     = 0;
+		in_view_resident = 0;
+		bool blurred     = false;
+		for (uint32_t offset = 0; offset < visible_count; ++offset)
+		{
+			uint32_t texture = (first_visible + offset) % texture_count;
+			policy.mark_used(texture, frame);
+
+			visible_size += policy.get_resident_size(texture);
+			for (uint32_t level = 0; level < policy.get_first_level(texture); ++level)
+			{
+				visible_size += get_level_sizes(extents[(texture * 7) % 4])[level];
+			}
+			in_view_resident += policy.get_resident_size(texture);
+			blurred |= policy.get_first_level(texture) > 0;
+		}
+		if (blurred)
+		{
+			++blurred_frames;
+		}
+	}
+
+	LOGI("{} frames | {} changes, {} levels dropped, {} levels brought back", frame_count, changes, dropped_levels, restored_levels);
+	LOGI("usage {} MiB at the end | {} frames over the target after warm up, by {} MiB at most", last_usage / mib, over_frames, max_excess / mib);
+	LOGI("{:.1f}% of the frames had a texture in view missing levels | resident in view {} of {} MiB",
+	     100.0 * blurred_frames / frame_count, in_view_resident / mib, visible_size / mib);
+
+	bool failed = false;
+	if (hot_evictions > 0)
+	{
+		LOGE("{} changes dropped levels of textures used in the last {} frames", hot_evictions, settings.cold_frames);
+		failed = true;
+	}
+	if (last_usage > target && other_usage + visible_size <= target)
+	{
+		LOGE("The usage ended over the target although the textures in view fit under it");
+		failed = true;
+	}
+
+	return failed ? 1 : 0;
+}
@@ -0,0 +1,125 @@
+/* Copyright (c) 2025, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @brief Bakes a glTF scene into a scene package that vkb::ScenePackageLoader loads without any conversion
+ *
+ * Both paths are relative to the assets directory, like the paths given to vkb::GLTFLoader.
+ * Runs on the CPU only.
+ *
+ * Usage: scene_baker <input.gltf|input.glb> <output.vkbpkg> [--scene <index>] [--threads <count>] [--optimize] [--no-mipmaps]
+ */
+
+#include <string>
+
+#include "core/util/logging.hpp"
+#include "filesystem/filesystem.hpp"
+#include "filesystem/legacy.h"
+#include "scene_package_baker.h"
+#include "timer.h"
+
+int main(int argc, char *argv[])
+{
+	if (argc < 3)
+	{
+		LOGE("Usage: scene_baker <input.gltf|input.glb> <output.vkbpkg> [--scene <index>] [--threads <count>] [--optimize] [--no-mipmaps]");
+		return 1;
+	}
+
+	std::string                  input_file{argv[1]};
+	std::string                  output_file{argv[2]};
+	int                          scene_index = -1;
+	vkb::ScenePackageBakeOptions options;
+
+	for (int i = 3; i < argc; ++i)
+	{
+		std::string argument{argv[i]};
+		if (argument == "--scene" && i + 1 < argc)
+		{
+			scene_index = std::stoi(argv[++i]);
+		}
+		else if (argument == "--threads" && i + 1 < argc)
+		{
+			options.thread_count = std::stoul(argv[++i]);
+		}
+		else if (argument == "--optimize")
+		{
+			options.optimize_meshes = true;
+		}
+		else if (argument == "--no-mipmaps")
+		{
+			options.generate_mipmaps = false;
+		}
+		else
+		{
+			LOGE("Unknown argument {}", argument);
+			return 1;
+		}
+	}
+
+	vkb::filesystem::init();
+
+	vkb::Timer timer;
+	timer.start();
+
+	tinygltf::Model    model;
+	tinygltf::TinyGLTF gltf_loader;
+	std::string        err;
+	std::string        warn;
+
+	std::string gltf_file = vkb::fs::path::get(vkb::fs::path::Type::Assets) + input_file;
+
+	bool binary = input_file.size() > 4 && input_file.compare(input_file.size() - 4, 4, ".glb") == 0;
+	bool result = binary ? gltf_loader.LoadBinaryFromFile(&model, &err, &warn, gltf_file) : gltf_loader.LoadASCIIFromFile(&model, &err, &warn, gltf_file);
+	if (!result || !err.empty())
+	{
+		LOGE("Failed to load gltf file {}: {}", gltf_file, err);
+		return 1;
+	}
+
+	double load_ms = timer.stop<vkb::Timer::Milliseconds>();
+	timer.start();
+
+	size_t      pos        = input_file.find_last_of('/');
+	std::string model_path = pos == std::string::npos ? std::string{} : input_file.substr(0, pos);
+
+	std::vector<uint8_t> package;
+	try
+	{
+		package = vkb::bake_scene_package(model, model_path, scene_index, options);
+	}
+	catch (const std::exception &e)
+	{
+		LOGE("Failed to bake {}: {}", input_file, e.what());
+		return 1;
+	}
+
+	double bake_ms = timer.stop<vkb::Timer::Milliseconds>();
+
+	vkb::filesystem::get()->write_file(vkb::fs::path::get(vkb::fs::path::Type::Assets) + output_file, package);
+
+	LOGI("Baked {} into {}: {} meshes, {} images, {} KiB | glTF parsing {:.2f} ms | baking {:.2f} ms",
+	     input_file,
+	     output_file,
+	     model.meshes.size(),
+	     model.images.size(),
+	     package.size() / 1024,
+	     load_ms,
+	     bake_ms);
+
+	return 0;
+}
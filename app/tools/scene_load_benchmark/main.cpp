@@ -0,0 +1,131 @@
+/* Copyright (c) 2025, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @brief Compares the time to load a scene from its glTF file and from the package baked by scene_baker
+ *
+ * The first load of each file is reported separately, as it is the only one that may read from disk
+ * instead of the page cache. For a truly cold first load, drop the page cache before running.
+ *
+ * Usage: scene_load_benchmark <scene.gltf> <scene.vkbpkg> [--iterations <count>]
+ */
+
+#include <algorithm>
+#include <functional>
+#include <string>
+
+#include "core/util/logging.hpp"
+#include "filesystem/filesystem.hpp"
+#include "headless_device.h"
+#include "hpp_gltf_loader.h"
+#include "hpp_scene_package_loader.h"
+#include "timer.h"
+
+namespace
+{
+struct LoadTimes
+{
+	double first_ms = 0.0;
+
+	double average_ms = 0.0;
+
+	double min_ms = 0.0;
+};
+
+/**
+ * @brief Loads the scene iterations times, each scene is destroyed before the next load
+ */
+LoadTimes measure(vkb::core::HPPDevice &device, uint32_t iterations, const std::function<std::unique_ptr<vkb::scene_graph::HPPScene>()> &load)
+{
+	LoadTimes times;
+	double    total_ms = 0.0;
+
+	for (uint32_t i = 0; i < iterations; ++i)
+	{
+		vkb::Timer timer;
+		timer.start();
+
+		auto scene = load();
+		device.get_handle().waitIdle();
+
+		double elapsed_ms = timer.stop<vkb::Timer::Milliseconds>();
+		if (!scene)
+		{
+			throw std::runtime_error("Failed to load the scene");
+		}
+
+		times.first_ms = i == 0 ? elapsed_ms : times.first_ms;
+		times.min_ms   = i == 0 ? elapsed_ms : std::min(times.min_ms, elapsed_ms);
+		total_ms += elapsed_ms;
+	}
+
+	times.average_ms = total_ms / iterations;
+	return times;
+}
+}        // namespace
+
+int main(int argc, char *argv[])
+{
+	if (argc < 3)
+	{
+		LOGE("Usage: scene_load_benchmark <scene.gltf> <scene.vkbpkg> [--iterations <count>]");
+		return 1;
+	}
+
+	std::string gltf_file{argv[1]};
+	std::string package_file{argv[2]};
+	uint32_t    iterations = 5;
+
+	for (int i = 3; i < argc; ++i)
+	{
+		std::string argument{argv[i]};
+		if (argument == "--iterations" && i + 1 < argc)
+		{
+			iterations = std::max(1u, static_cast<uint32_t>(std::stoul(argv[++i])));
+		}
+		else
+		{
+			LOGE("Unknown argument {}", argument);
+			return 1;
+		}
+	}
+
+	vkb::filesystem::init();
+
+	vkb::tools::HeadlessDevice headless_device{"scene_load_benchmark"};
+	auto                      &device = headless_device.get_device();
+
+	// The package is loaded first, so that it does not benefit from the glTF file warming up the page cache
+	LoadTimes package_times = measure(device, iterations, [&]() {
+		vkb::HPPScenePackageLoader loader{device};
+		return loader.read_scene_from_file(package_file);
+	});
+
+	LoadTimes gltf_times = measure(device, iterations, [&]() {
+		vkb::HPPGLTFLoader loader{device};
+		return loader.read_scene_from_file(gltf_file);
+	});
+
+	LOGI("{:8} | first {:9.2f} ms | average {:9.2f} ms | min {:9.2f} ms", "glTF", gltf_times.first_ms, gltf_times.average_ms, gltf_times.min_ms);
+	LOGI("{:8} | first {:9.2f} ms | average {:9.2f} ms | min {:9.2f} ms", "package", package_times.first_ms, package_times.average_ms, package_times.min_ms);
+	LOGI("speedup  | first {:8.2f}x    | average {:8.2f}x    | min {:8.2f}x",
+	     gltf_times.first_ms / package_times.first_ms,
+	     gltf_times.average_ms / package_times.average_ms,
+	     gltf_times.min_ms / package_times.min_ms);
+
+	return 0;
+}
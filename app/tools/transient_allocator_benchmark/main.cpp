@@ -0,0 +1,175 @@
+/* Copyright (c) 2025, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @brief Measures the throughput of transient uniform buffer allocations from many recording threads
+ *
+ * Compares the per thread rings of vkb::rendering::RenderFrame against the previous allocation
+ * path, which looked up a map of buffer pools and searched for a free buffer block.
+ *
+ * Usage: transient_allocator_benchmark [--threads <count>] [--allocations <per thread and frame>] [--frames <count>] [--size <bytes>]
+ */
+
+#include <algorithm>
+#include <map>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "buffer_pool.h"
+#include "core/util/logging.hpp"
+#include "headless_device.h"
+#include "rendering/hpp_render_target.h"
+#include "rendering/render_frame.h"
+#include "timer.h"
+
+namespace
+{
+struct Options
+{
+	size_t   thread_count = std::thread::hardware_concurrency();
+	uint32_t allocations  = 20000;
+	uint32_t frames       = 50;
+	uint32_t size         = 256;
+};
+
+/**
+ * @brief Runs the allocations of every frame on thread_count threads, returns the allocations per second
+ */
+template <typename AllocateFunc, typename ResetFunc>
+double run(const Options &options, size_t thread_count, AllocateFunc &&allocate, ResetFunc &&reset)
+{
+	double total_ms = 0.0;
+
+	for (uint32_t frame = 0; frame < options.frames; ++frame)
+	{
+		vkb::Timer timer;
+		timer.start();
+
+		std::vector<std::thread> threads;
+		for (size_t thread_index = 0; thread_index < thread_count; ++thread_index)
+		{
+			threads.emplace_back([&, thread_index]() {
+				for (uint32_t i = 0; i < options.allocations; ++i)
+				{
+					auto allocation = allocate(thread_index);
+					if (allocation.empty())
+					{
+						LOGE("Allocation failed");
+						return;
+					}
+				}
+			});
+		}
+		for (auto &thread : threads)
+		{
+			thread.join();
+		}
+
+		total_ms += timer.stop<vkb::Timer::Milliseconds>();
+		reset();
+	}
+
+	return static_cast<double>(thread_count) * options.allocations * options.frames / (total_ms / 1000.0);
+}
+}        // namespace
+
+int main(int argc, char *argv[])
+{
+	Options options;
+
+	for (int i = 1; i + 1 < argc; i += 2)
+	{
+		std::string argument{argv[i]};
+		uint32_t    value = static_cast<uint32_t>(std::stoul(argv[i + 1]));
+
+		if (argument == "--threads")
+		{
+			options.thread_count = std::max(1u, value);
+		}
+		else if (argument == "--allocations")
+		{
+			options.allocations = std::max(1u, value);
+		}
+		else if (argument == "--frames")
+		{
+			options.frames = std::max(1u, value);
+		}
+		else if (argument == "--size")
+		{
+			options.size = std::max(1u, value);
+		}
+		else
+		{
+			LOGE("Unknown argument {}", argument);
+			return 1;
+		}
+	}
+
+	vkb::tools::HeadlessDevice headless_device{"transient_allocator_benchmark"};
+	auto                      &device = headless_device.get_device();
+
+	const vk::BufferUsageFlags usage      = vk::BufferUsageFlagBits::eUniformBuffer;
+	const vk::DeviceSize       block_size = 256 * 1024;
+
+	for (size_t thread_count : {size_t{1}, options.thread_count})
+	{
+		// Previous path: a map lookup per allocation and a linear search for a block with enough space
+		std::map<vk::BufferUsageFlags, std::vector<std::pair<vkb::BufferPoolCpp, vkb::BufferBlockCpp *>>> buffer_pools;
+		auto &pools = buffer_pools[usage];
+		for (size_t i = 0; i < thread_count; ++i)
+		{
+			pools.emplace_back(vkb::BufferPoolCpp{device, block_size, usage}, nullptr);
+		}
+
+		double pool_rate = run(
+		    options,
+		    thread_count,
+		    [&](size_t thread_index) {
+			    auto &[buffer_pool, buffer_block] = buffer_pools.find(usage)->second[thread_index];
+			    if (!buffer_block || !buffer_block->can_allocate(options.size))
+			    {
+				    buffer_block = &buffer_pool.request_buffer_block(options.size);
+			    }
+			    return buffer_block->allocate(options.size);
+		    },
+		    [&]() {
+			    for (auto &[buffer_pool, buffer_block] : buffer_pools.find(usage)->second)
+			    {
+				    buffer_pool.reset();
+				    buffer_block = nullptr;
+			    }
+		    });
+
+		vkb::rendering::RenderFrameCpp render_frame{device, nullptr, thread_count};
+
+		double ring_rate = run(
+		    options,
+		    thread_count,
+		    [&](size_t thread_index) { return render_frame.allocate_buffer(usage, options.size, thread_index); },
+		    [&]() { render_frame.reset(); });
+
+		LOGI("threads {:2} | {:6} B | buffer pools {:8.2f} M allocations/s | transient rings {:8.2f} M allocations/s | {:5.2f}x",
+		     thread_count,
+		     options.size,
+		     pool_rate / 1e6,
+		     ring_rate / 1e6,
+		     ring_rate / pool_rate);
+	}
+
+	return 0;
+}
@@ -0,0 +1,168 @@
+/* Copyright (c) 2025, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// The type of plot to use
+enum class PlotType
+{
+	Number,
+	Percentage,
+	Memory,
+};
+
+namespace vkb
+{
+/**
+ * @brief The value of a registered counter at the time of a snapshot
+ */
+struct CounterValue
+{
+	const char *name;
+	PlotType    type;
+
+	/// Whether the counter was last set rather than added to, a gauge is not a count of events
+	bool is_gauge;
+
+	double value;
+};
+
+/**
+ * @brief Named counters that any thread can update without locks
+ *
+ * A counter is registered once, by name, into a dense index. Its value is spread over shards, each thread adding to
+ * the shard picked by its thread index, so that threads incrementing the same counter do not contend for a cache line.
+ * A snapshot sums the shards of each counter, which reads a fixed amount of memory regardless of the update rate.
+ *
+ * Counters that are added to count events, counters that are set are gauges, such as a memory usage.
+ */
+class CounterRegistry
+{
+  public:
+	static constexpr uint32_t max_counters = 512;
+
+	static constexpr uint32_t shard_count = 8;
+
+	static CounterRegistry &get();
+
+	/**
+	 * @brief Registers a counter, or finds the counter registered with the same name
+	 * @param name Name of the counter, copied on the first registration
+	 * @param type How the value of the counter is plotted
+	 * @return Index of the counter, or ~0u if the registry is full
+	 */
+	uint32_t register_counter(const char *name, PlotType type = PlotType::Number);
+
+	void add(uint32_t index, double amount);
+
+	/**
+	 * @brief Sets the value of a counter, concurrent additions to it may be lost
+	 */
+	void set(uint32_t index, double value);
+
+	double get_value(uint32_t index) const;
+
+	uint32_t get_counter_count() const;
+
+	/**
+	 * @brief Reads the values of all registered counters
+	 * @param values Receives one value per counter, in registration order
+	 */
+	void snapshot(std::vector<CounterValue> &values) const;
+
+	/**
+	 * @brief Sends the values of all counters to Tracy, does nothing in builds without Tracy
+	 */
+	void plot_to_tracy() const;
+
+  private:
+	CounterRegistry() = default;
+
+	struct CounterInfo
+	{
+		std::unique_ptr<char[]> name;
+		PlotType                type;
+		std::atomic<bool>       is_gauge{false};
+	};
+
+	struct alignas(64) Shard
+	{
+		std::array<std::atomic<double>, max_counters> values{};
+	};
+
+	// Lock-free lookup from the address of a name to its counter, names are usually string literals
+	static constexpr uint32_t lookup_size = 2 * max_counters;
+
+	uint32_t find_by_address(const char *name) const;
+
+	void insert_address(const char *name, uint32_t index);
+
+	std::mutex mutex;
+
+	std::array<CounterInfo, max_counters> infos;
+
+	// Counters whose info is complete, published with release ordering
+	std::atomic<uint32_t> counter_count{0};
+
+	std::array<Shard, shard_count> shards;
+
+	std::array<std::atomic<const char *>, lookup_size> lookup_names{};
+	std::array<std::atomic<uint32_t>, lookup_size>     lookup_indices{};
+};
+
+/**
+ * @brief A handle to a registered counter, typically a function-local static at the code it instruments
+ *
+ * Usage:
+ *     static const vkb::Counter requests{"Descriptor set requests"};
+ *     requests.add();
+ */
+class Counter
+{
+  public:
+	explicit Counter(const char *name, PlotType type = PlotType::Number) :
+	    index{CounterRegistry::get().register_counter(name, type)}
+	{
+	}
+
+	void add(double amount = 1.0) const
+	{
+		CounterRegistry::get().add(index, amount);
+	}
+
+	void set(double value) const
+	{
+		CounterRegistry::get().set(index, value);
+	}
+
+	double get() const
+	{
+		return CounterRegistry::get().get_value(index);
+	}
+
+  private:
+	uint32_t index;
+};
+}        // namespace vkb
@@ -19,10 +19,11 @@
 
 #include <cstdint>
 #include <cstdio>
+#include <type_traits>
 
-#include <unordered_map>
-
+#include "core/util/counters.hpp"
 #include "core/util/error.hpp"
+#include "core/util/tracing.hpp"
 
 #ifdef TRACY_ENABLE
 #	include <tracy/Tracy.hpp>
@@ -33,98 +34,54 @@
 void *operator new(size_t count);
 void  operator delete(void *ptr) noexcept;
 
-// Tracy a scope
-#	define PROFILE_SCOPE(name) ZoneScopedN(name)
-
-// Trace a function
-#	define PROFILE_FUNCTION() ZoneScoped
-#else
-#	define PROFILE_SCOPE(name)
-#	define PROFILE_FUNCTION()
-#endif
-
-// The type of plot to use
-enum class PlotType
-{
-	Number,
-	Percentage,
-	Memory,
-};
+// Trace a scope, with Tracy and the built-in tracer
+#	define PROFILE_SCOPE(name) \
+		ZoneScopedN(name);      \
+		TRACE_SCOPE(name)
 
-// tracy::PlotFormatType is not defined if TRACY_ENABLE is not defined
-// so we need to define a function to convert our enum to the tracy enum
-#ifdef TRACY_ENABLE
-namespace
-{
-inline tracy::PlotFormatType to_tracy_plot_format(PlotType type)
-{
-	switch (type)
-	{
-		case PlotType::Number:
-			return tracy::PlotFormatType::Number;
-		case PlotType::Percentage:
-			return tracy::PlotFormatType::Percentage;
-		case PlotType::Memory:
-			return tracy::PlotFormatType::Memory;
-		default:
-			return tracy::PlotFormatType::Number;
-	}
-}
-}        // namespace
+// Trace a scope with a detail shown by the built-in tracer
+#	define PROFILE_SCOPE_DETAIL(name, detail) \
+		ZoneScopedN(name);                     \
+		TRACE_SCOPE_DETAIL(name, detail)
 
-#	define TO_TRACY_PLOT_FORMAT(name) to_tracy_plot_format(name)
+// Trace a function
+#	define PROFILE_FUNCTION() \
+		ZoneScoped;            \
+		TRACE_SCOPE(__func__)
 #else
-#	define TO_TRACY_PLOT_FORMAT(name)
+#	define PROFILE_SCOPE(name) TRACE_SCOPE(name)
+#	define PROFILE_SCOPE_DETAIL(name, detail) TRACE_SCOPE_DETAIL(name, detail)
+#	define PROFILE_FUNCTION() TRACE_SCOPE(__func__)
 #endif
 
-// Create plots
+// Create plots, as counters of the vkb::CounterRegistry which any thread can update
 template <typename T, PlotType PT = PlotType::Number>
 class Plot
 {
+	static_assert((std::is_same<T, int64_t>::value || std::is_same<T, double>::value || std::is_same<T, float>::value), "PlotStore only supports int64_t, double and float");
+
   public:
 	static void plot(const char *name, T value)
 	{
-		auto *p        = get_instance();
-		p->plots[name] = value;
-		update_tracy_plot(name, value);
+		auto &registry = vkb::CounterRegistry::get();
+		registry.set(registry.register_counter(name, PT), static_cast<double>(value));
 	}
 
 	static void increment(const char *name, T amount)
 	{
-		auto *p = get_instance();
-		p->plots[name] += amount;
-		update_tracy_plot(name, p->plots[name]);
+		auto &registry = vkb::CounterRegistry::get();
+		registry.add(registry.register_counter(name, PT), static_cast<double>(amount));
 	}
 
 	static void decrement(const char *name, T amount)
 	{
-		auto *p = get_instance();
-		p->plots[name] -= amount;
-		update_tracy_plot(name, p->plots[name]);
+		auto &registry = vkb::CounterRegistry::get();
+		registry.add(registry.register_counter(name, PT), -static_cast<double>(amount));
 	}
 
 	static void reset(const char *name)
 	{
-		auto *p        = get_instance();
-		p->plots[name] = T{};
-		update_tracy_plot(name, p->plots[name]);
-	}
-
-  private:
-	static void update_tracy_plot(const char *name, T value)
-	{
-#ifdef TRACY_ENABLE
-		TracyPlot(name, value);
-		TracyPlotConfig(name, TO_TRACY_PLOT_FORMAT(PT), true, true, 0);
-#endif
-	}
-
-	static Plot *get_instance()
-	{
-		static_assert((std::is_same<T, int64_t>::value || std::is_same<T, double>::value || std::is_same<T, float>::value), "PlotStore only supports int64_t, double and float");
-		static Plot instance;
-		return &instance;
+		auto &registry = vkb::CounterRegistry::get();
+		registry.set(registry.register_counter(name, PT), 0.0);
 	}
-
-	std::unordered_map<const char *, T> plots;
 };
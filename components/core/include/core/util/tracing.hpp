@@ -0,0 +1,168 @@
+/* Copyright (c) 2025, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#if defined(__x86_64__) || defined(__i386__)
+#	include <x86intrin.h>
+#	define VKB_TRACING_TSC
+#elif defined(_M_X64) || defined(_M_IX86)
+#	include <intrin.h>
+#	define VKB_TRACING_TSC
+#endif
+
+/**
+ * @brief A CPU tracer that is always built in
+ *
+ * Each thread appends its events to its own buffer without locks, and the buffers are only read when a capture is
+ * exported. While tracing is disabled a scope costs one relaxed atomic load.
+ *
+ * Timestamps come from the TSC when the CPU has an invariant one, and from std::chrono::steady_clock otherwise. Captures
+ * are converted to the steady_clock timeline, so that they can be merged with GPU timestamps calibrated to it.
+ */
+namespace vkb::tracing
+{
+namespace detail
+{
+extern std::atomic<bool> enabled;
+
+extern const bool use_tsc;
+}        // namespace detail
+
+inline bool is_enabled()
+{
+	return detail::enabled.load(std::memory_order_relaxed);
+}
+
+/**
+ * @return The current time in ticks, TSC cycles or steady_clock nanoseconds
+ */
+inline uint64_t now()
+{
+#ifdef VKB_TRACING_TSC
+	if (detail::use_tsc)
+	{
+		return __rdtsc();
+	}
+#endif
+	return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+void set_enabled(bool enabled);
+
+/**
+ * @brief Names the calling thread in captures
+ */
+void set_thread_name(const std::string &name);
+
+/**
+ * @brief Appends an event to the buffer of the calling thread
+ * @param name Name of the event, must outlive the capture, such as a string literal
+ * @param detail Optional detail shown with the event, with the same lifetime requirement as the name
+ */
+void record(const char *name, const char *detail, uint64_t begin, uint64_t end);
+
+/**
+ * @brief Records an event spanning its lifetime, if tracing is enabled when it begins
+ */
+class Scope
+{
+  public:
+	explicit Scope(const char *name, const char *detail = nullptr) :
+	    name{is_enabled() ? name : nullptr},
+	    detail{detail},
+	    begin{this->name ? now() : 0}
+	{
+	}
+
+	~Scope()
+	{
+		if (name)
+		{
+			record(name, detail, begin, now());
+		}
+	}
+
+	Scope(const Scope &)            = delete;
+	Scope &operator=(const Scope &) = delete;
+
+  private:
+	const char *name;
+	const char *detail;
+	uint64_t    begin;
+};
+
+/**
+ * @brief An event of a captured track, on the steady_clock timeline
+ */
+struct TraceSlice
+{
+	std::string name;
+	std::string detail;
+	double      begin_us;
+	double      duration_us;
+};
+
+/**
+ * @brief The events of a thread, or of a GPU queue, in a capture
+ */
+struct TraceTrack
+{
+	std::string process_name;
+	std::string thread_name;
+	std::string category;
+	uint32_t    pid;
+	uint32_t    tid;
+
+	std::vector<TraceSlice> slices;
+};
+
+/**
+ * @return The events recorded so far, one track per thread that recorded events
+ */
+std::vector<TraceTrack> capture();
+
+/**
+ * @return The number of events not recorded because the buffer of their thread was full
+ */
+uint64_t get_dropped_event_count();
+
+/**
+ * @brief Serializes tracks to the Chrome trace event JSON format, which chrome://tracing and Perfetto open
+ */
+std::string to_chrome_json(const std::vector<TraceTrack> &tracks);
+
+/**
+ * @brief Serializes tracks to the Perfetto protobuf trace format, as track events
+ */
+std::string to_perfetto_protobuf(const std::vector<TraceTrack> &tracks);
+}        // namespace vkb::tracing
+
+#define VKB_TRACING_CONCAT_IMPL(a, b) a##b
+#define VKB_TRACING_CONCAT(a, b) VKB_TRACING_CONCAT_IMPL(a, b)
+
+// Trace a scope
+#define TRACE_SCOPE(name) vkb::tracing::Scope VKB_TRACING_CONCAT(trace_scope_, __LINE__)(name)
+
+// Trace a scope with a detail such as the type of a resource, both must be string literals or outlive the capture
+#define TRACE_SCOPE_DETAIL(name, detail) vkb::tracing::Scope VKB_TRACING_CONCAT(trace_scope_, __LINE__)(name, detail)
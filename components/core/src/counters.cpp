@@ -0,0 +1,223 @@
+/* Copyright (c) 2025, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "core/util/counters.hpp"
+
+#include <cstring>
+#include <functional>
+
+#ifdef TRACY_ENABLE
+#	include <tracy/Tracy.hpp>
+#endif
+
+namespace vkb
+{
+namespace
+{
+uint32_t get_thread_shard()
+{
+	static std::atomic<uint32_t> next_thread{0};
+	thread_local uint32_t        shard = next_thread.fetch_add(1, std::memory_order_relaxed) % CounterRegistry::shard_count;
+	return shard;
+}
+
+#ifdef TRACY_ENABLE
+tracy::PlotFormatType to_tracy_plot_format(PlotType type)
+{
+	switch (type)
+	{
+		case PlotType::Number:
+			return tracy::PlotFormatType::Number;
+		case PlotType::Percentage:
+			return tracy::PlotFormatType::Percentage;
+		case PlotType::Memory:
+			return tracy::PlotFormatType::Memory;
+		default:
+			return tracy::PlotFormatType::Number;
+	}
+}
+#endif
+}        // namespace
+
+CounterRegistry &CounterRegistry::get()
+{
+	// Never destroyed, counters may still be updated while static objects are destroyed
+	static CounterRegistry *registry = new CounterRegistry;
+	return *registry;
+}
+
+uint32_t CounterRegistry::register_counter(const char *name, PlotType type)
+{
+	uint32_t index = find_by_address(name);
+	if (index != ~0u)
+	{
+		return index;
+	}
+
+	std::lock_guard<std::mutex> lock{mutex};
+
+	uint32_t count = counter_count.load(std::memory_order_relaxed);
+	for (index = 0; index < count; ++index)
+	{
+		if (std::strcmp(infos[index].name.get(), name) == 0)
+		{
+			break;
+		}
+	}
+
+	if (index == count)
+	{
+		if (count == max_counters)
+		{
+			return ~0u;
+		}
+
+		size_t length = std::strlen(name);
+
+		infos[index].name = std::make_unique<char[]>(length + 1);
+		std::memcpy(infos[index].name.get(), name, length + 1);
+		infos[index].type = type;
+
+		counter_count.store(count + 1, std::memory_order_release);
+	}
+
+	insert_address(name, index);
+	return index;
+}
+
+void CounterRegistry::add(uint32_t index, double amount)
+{
+	if (index < max_counters)
+	{
+		shards[get_thread_shard()].values[index].fetch_add(amount, std::memory_order_relaxed);
+	}
+}
+
+void CounterRegistry::set(uint32_t index, double value)
+{
+	if (index < max_counters)
+	{
+		infos[index].is_gauge.store(true, std::memory_order_relaxed);
+		shards[0].values[index].store(value, std::memory_order_relaxed);
+		for (uint32_t shard = 1; shard < shard_count; ++shard)
+		{
+			shards[shard].values[index].store(0.0, std::memory_order_relaxed);
+		}
+	}
+}
+
+double CounterRegistry::get_value(uint32_t index) const
+{
+	double value = 0.0;
+	if (index < max_counters)
+	{
+		for (auto &shard : shards)
+		{
+			value += shard.values[index].load(std::memory_order_relaxed);
+		}
+	}
+	return value;
+}
+
+uint32_t CounterRegistry::get_counter_count() const
+{
+	return counter_count.load(std::memory_order_acquire);
+}
+
+void CounterRegistry::snapshot(std::vector<CounterValue> &values) const
+{
+	uint32_t count = get_counter_count();
+
+	values.resize(count);
+	for (uint32_t index = 0; index < count; ++index)
+	{
+		values[index] = {infos[index].name.get(), infos[index].type, infos[index].is_gauge.load(std::memory_order_relaxed), 0.0};
+	}
+
+	// Shard by shard, so that each shard is read in order
+	for (auto &shard : shards)
+	{
+		for (uint32_t index = 0; index < count; ++index)
+		{
+			values[index].value += shard.values[index].load(std::memory_order_relaxed);
+		}
+	}
+}
+
+void CounterRegistry::plot_to_tracy() const
+{
+#ifdef TRACY_ENABLE
+	std::vector<CounterValue> values;
+	snapshot(values);
+
+	for (auto &value : values)
+	{
+		// The names are owned by the registry, so Tracy can identify plots by their address
+		TracyPlot(value.name, value.value);
+		TracyPlotConfig(value.name, to_tracy_plot_format(value.type), !value.is_gauge, true, 0);
+	}
+#endif
+}
+
+uint32_t CounterRegistry::find_by_address(const char *name) const
+{
+	uint32_t slot = static_cast<uint32_t>(std::hash<const char *>{}(name)) % lookup_size;
+	for (uint32_t probe = 0; probe < lookup_size; ++probe, slot = (slot + 1) % lookup_size)
+	{
+		const char *key = lookup_names[slot].load(std::memory_order_acquire);
+		if (key == name)
+		{
+			// The index is stored after the name, 0 means the insertion is not complete. The name is compared too, as a
+			// string built at runtime may reuse the address of a string that no longer exists.
+			uint32_t index = lookup_indices[slot].load(std::memory_order_acquire);
+			if (index == 0 || std::strcmp(infos[index - 1].name.get(), name) != 0)
+			{
+				return ~0u;
+			}
+			return index - 1;
+		}
+		if (key == nullptr)
+		{
+			break;
+		}
+	}
+	return ~0u;
+}
+
+void CounterRegistry::insert_address(const char *name, uint32_t index)
+{
+	// Called with the mutex held, so only lookups run concurrently
+	uint32_t slot = static_cast<uint32_t>(std::hash<const char *>{}(name)) % lookup_size;
+	for (uint32_t probe = 0; probe < lookup_size; ++probe, slot = (slot + 1) % lookup_size)
+	{
+		const char *key = lookup_names[slot].load(std::memory_order_relaxed);
+		if (key == name)
+		{
+			lookup_indices[slot].store(index + 1, std::memory_order_release);
+			return;
+		}
+		if (key == nullptr)
+		{
+			lookup_names[slot].store(name, std::memory_order_release);
+			lookup_indices[slot].store(index + 1, std::memory_order_release);
+			return;
+		}
+	}
+
+	// The table is full of names built at runtime, lookups fall back to comparing names
+}
+}        // namespace vkb
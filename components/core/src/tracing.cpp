@@ -0,0 +1,472 @@
+/* Copyright (c) 2025, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "core/util/tracing.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <memory>
+#include <mutex>
+
+#include <fmt/format.h>
+
+#if defined(VKB_TRACING_TSC) && !defined(_MSC_VER)
+#	include <cpuid.h>
+#endif
+
+namespace vkb::tracing
+{
+namespace
+{
+constexpr size_t events_per_chunk = 4096;
+
+// Events kept per thread, 32 MiB of events, later events are dropped
+constexpr size_t max_chunks_per_thread = 256;
+
+struct Event
+{
+	const char *name;
+	const char *detail;
+	uint64_t    begin;
+	uint64_t    end;
+};
+
+/**
+ * @brief A block of events, written by its thread and read by captures
+ * The count is published with release ordering after the event is written, so readers only see complete events.
+ */
+struct Chunk
+{
+	std::array<Event, events_per_chunk> events;
+	std::atomic<size_t>                 count{0};
+	std::atomic<Chunk *>                next{nullptr};
+};
+
+struct ThreadBuffer
+{
+	uint32_t tid;
+
+	// Guarded by the registry mutex
+	std::string name;
+
+	Chunk  head;
+	Chunk *tail        = &head;
+	size_t chunk_count = 1;
+
+	std::atomic<uint64_t> dropped{0};
+};
+
+/**
+ * @brief The buffers of all threads that recorded events, which outlive their threads so that their events can be captured
+ */
+struct Registry
+{
+	std::mutex mutex;
+
+	std::vector<std::unique_ptr<ThreadBuffer>> threads;
+
+	// A tick and the steady_clock time at which it was taken, to convert ticks to time
+	uint64_t calibration_tick = now();
+	int64_t  calibration_ns   = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+};
+
+Registry &get_registry()
+{
+	// Never destroyed, threads may still record events while static objects are destroyed
+	static Registry *registry = new Registry;
+	return *registry;
+}
+
+thread_local ThreadBuffer *thread_buffer = nullptr;
+
+ThreadBuffer &get_thread_buffer()
+{
+	if (!thread_buffer)
+	{
+		auto &registry = get_registry();
+
+		std::lock_guard<std::mutex> lock{registry.mutex};
+
+		auto buffer  = std::make_unique<ThreadBuffer>();
+		buffer->tid  = static_cast<uint32_t>(registry.threads.size());
+		buffer->name = fmt::format("Thread {}", buffer->tid);
+
+		thread_buffer = buffer.get();
+		registry.threads.push_back(std::move(buffer));
+	}
+	return *thread_buffer;
+}
+
+bool has_invariant_tsc()
+{
+#if defined(VKB_TRACING_TSC) && defined(_MSC_VER)
+	int registers[4];
+	__cpuid(registers, 0x80000000);
+	if (static_cast<unsigned int>(registers[0]) < 0x80000007)
+	{
+		return false;
+	}
+	__cpuid(registers, 0x80000007);
+	return (registers[3] & (1 << 8)) != 0;
+#elif defined(VKB_TRACING_TSC)
+	unsigned int eax, ebx, ecx, edx;
+	if (!__get_cpuid(0x80000007, &eax, &ebx, &ecx, &edx))
+	{
+		return false;
+	}
+	return (edx & (1u << 8)) != 0;
+#else
+	return false;
+#endif
+}
+
+std::string escape_json(const std::string &text)
+{
+	std::string escaped;
+	escaped.reserve(text.size());
+	for (char c : text)
+	{
+		if (c == '"' || c == '\\')
+		{
+			escaped += '\\';
+			escaped += c;
+		}
+		else if (static_cast<unsigned char>(c) < 0x20)
+		{
+			escaped += fmt::format("\\u{:04x}", static_cast<int>(c));
+		}
+		else
+		{
+			escaped += c;
+		}
+	}
+	return escaped;
+}
+
+// Minimal protobuf encoding, for the few messages of the Perfetto trace format used here
+void write_varint(std::string &out, uint64_t value)
+{
+	while (value >= 0x80)
+	{
+		out += static_cast<char>((value & 0x7f) | 0x80);
+		value >>= 7;
+	}
+	out += static_cast<char>(value);
+}
+
+void write_uint(std::string &out, uint32_t field, uint64_t value)
+{
+	write_varint(out, static_cast<uint64_t>(field) << 3);
+	write_varint(out, value);
+}
+
+void write_bytes(std::string &out, uint32_t field, const std::string &bytes)
+{
+	write_varint(out, (static_cast<uint64_t>(field) << 3) | 2);
+	write_varint(out, bytes.size());
+	out += bytes;
+}
+
+// Field numbers of perfetto/trace/trace_packet.proto and the messages it contains
+namespace perfetto
+{
+constexpr uint32_t trace_packet                  = 1;
+constexpr uint32_t packet_timestamp              = 8;
+constexpr uint32_t packet_sequence_id            = 10;
+constexpr uint32_t packet_track_event            = 11;
+constexpr uint32_t packet_sequence_flags         = 13;
+constexpr uint32_t packet_track_descriptor       = 60;
+constexpr uint32_t track_descriptor_uuid         = 1;
+constexpr uint32_t track_descriptor_process      = 3;
+constexpr uint32_t track_descriptor_thread       = 4;
+constexpr uint32_t process_descriptor_pid        = 1;
+constexpr uint32_t process_descriptor_name       = 6;
+constexpr uint32_t thread_descriptor_pid         = 1;
+constexpr uint32_t thread_descriptor_tid         = 2;
+constexpr uint32_t thread_descriptor_name        = 5;
+constexpr uint32_t track_event_debug_annotations = 4;
+constexpr uint32_t track_event_type              = 9;
+constexpr uint32_t track_event_track_uuid        = 11;
+constexpr uint32_t track_event_categories        = 22;
+constexpr uint32_t track_event_name              = 23;
+constexpr uint32_t debug_annotation_string_value = 6;
+constexpr uint32_t debug_annotation_name         = 10;
+
+constexpr uint64_t slice_begin = 1;
+constexpr uint64_t slice_end   = 2;
+
+constexpr uint64_t incremental_state_cleared = 1;
+constexpr uint64_t needs_incremental_state   = 2;
+
+constexpr uint32_t sequence_id = 1;
+}        // namespace perfetto
+
+void write_packet(std::string &out, std::string &packet, bool first)
+{
+	write_uint(packet, perfetto::packet_sequence_id, perfetto::sequence_id);
+	write_uint(packet, perfetto::packet_sequence_flags, first ? perfetto::incremental_state_cleared : perfetto::needs_incremental_state);
+	write_bytes(out, perfetto::trace_packet, packet);
+	packet.clear();
+}
+}        // namespace
+
+namespace detail
+{
+std::atomic<bool> enabled{false};
+
+const bool use_tsc = has_invariant_tsc();
+}        // namespace detail
+
+void set_enabled(bool enabled)
+{
+	// Creates the registry, so that its calibration point is taken before any event
+	get_registry();
+	detail::enabled.store(enabled, std::memory_order_relaxed);
+}
+
+void set_thread_name(const std::string &name)
+{
+	auto &buffer = get_thread_buffer();
+
+	std::lock_guard<std::mutex> lock{get_registry().mutex};
+	buffer.name = name;
+}
+
+void record(const char *name, const char *detail, uint64_t begin, uint64_t end)
+{
+	auto &buffer = get_thread_buffer();
+
+	size_t count = buffer.tail->count.load(std::memory_order_relaxed);
+	if (count == events_per_chunk)
+	{
+		if (buffer.chunk_count == max_chunks_per_thread)
+		{
+			buffer.dropped.fetch_add(1, std::memory_order_relaxed);
+			return;
+		}
+
+		auto *chunk = new Chunk;
+		buffer.tail->next.store(chunk, std::memory_order_release);
+		buffer.tail = chunk;
+		++buffer.chunk_count;
+		count = 0;
+	}
+
+	buffer.tail->events[count] = {name, detail, begin, end};
+	buffer.tail->count.store(count + 1, std::memory_order_release);
+}
+
+std::vector<TraceTrack> capture()
+{
+	auto &registry = get_registry();
+
+	std::lock_guard<std::mutex> lock{registry.mutex};
+
+	// Measure the tick rate over the time since the calibration point, steady_clock ticks are nanoseconds already
+	uint64_t tick        = now();
+	int64_t  ns          = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+	double   ns_per_tick = 1.0;
+	if (detail::use_tsc && tick > registry.calibration_tick)
+	{
+		ns_per_tick = static_cast<double>(ns - registry.calibration_ns) / static_cast<double>(tick - registry.calibration_tick);
+	}
+
+	auto to_us = [&](uint64_t t) {
+		return (static_cast<double>(registry.calibration_ns) + static_cast<double>(static_cast<int64_t>(t - registry.calibration_tick)) * ns_per_tick) * 1e-3;
+	};
+
+	std::vector<TraceTrack> tracks;
+	for (auto &thread : registry.threads)
+	{
+		TraceTrack track{"CPU", thread->name, "cpu", 1, thread->tid};
+
+		for (const Chunk *chunk = &thread->head; chunk; chunk = chunk->next.load(std::memory_order_acquire))
+		{
+			size_t count = chunk->count.load(std::memory_order_acquire);
+			for (size_t i = 0; i < count; ++i)
+			{
+				auto &event = chunk->events[i];
+				track.slices.push_back({event.name, event.detail ? event.detail : "", to_us(event.begin), (event.end - event.begin) * ns_per_tick * 1e-3});
+			}
+		}
+
+		if (!track.slices.empty())
+		{
+			tracks.push_back(std::move(track));
+		}
+	}
+	return tracks;
+}
+
+uint64_t get_dropped_event_count()
+{
+	auto &registry = get_registry();
+
+	std::lock_guard<std::mutex> lock{registry.mutex};
+
+	uint64_t dropped = 0;
+	for (auto &thread : registry.threads)
+	{
+		dropped += thread->dropped.load(std::memory_order_relaxed);
+	}
+	return dropped;
+}
+
+std::string to_chrome_json(const std::vector<TraceTrack> &tracks)
+{
+	std::vector<std::string> events;
+
+	std::vector<uint32_t> named_processes;
+	for (auto &track : tracks)
+	{
+		if (std::ranges::find(named_processes, track.pid) == named_processes.end())
+		{
+			events.push_back(fmt::format(R"({{"name":"process_name","ph":"M","pid":{},"args":{{"name":"{}"}}}})", track.pid, escape_json(track.process_name)));
+			named_processes.push_back(track.pid);
+		}
+		events.push_back(fmt::format(R"({{"name":"thread_name","ph":"M","pid":{},"tid":{},"args":{{"name":"{}"}}}})", track.pid, track.tid, escape_json(track.thread_name)));
+
+		for (auto &slice : track.slices)
+		{
+			std::string args = slice.detail.empty() ? "" : fmt::format(R"(,"args":{{"detail":"{}"}})", escape_json(slice.detail));
+			events.push_back(fmt::format(R"({{"name":"{}","cat":"{}","ph":"X","pid":{},"tid":{},"ts":{:.3f},"dur":{:.3f}{}}})",
+			                             escape_json(slice.name), track.category, track.pid, track.tid, slice.begin_us, slice.duration_us, args));
+		}
+	}
+
+	std::string json = R"({"displayTimeUnit":"ms","traceEvents":[)";
+	for (size_t i = 0; i < events.size(); ++i)
+	{
+		json += i == 0 ? "\n" : ",\n";
+		json += events[i];
+	}
+	json += "\n]}\n";
+	return json;
+}
+
+std::string to_perfetto_protobuf(const std::vector<TraceTrack> &tracks)
+{
+	std::string trace;
+	std::string packet;
+	std::string message;
+	std::string annotation;
+	bool        first = true;
+
+	std::vector<uint32_t> described_processes;
+	for (auto &track : tracks)
+	{
+		if (std::ranges::find(described_processes, track.pid) == described_processes.end())
+		{
+			write_uint(message, perfetto::process_descriptor_pid, track.pid);
+			write_bytes(message, perfetto::process_descriptor_name, track.process_name);
+
+			std::string descriptor;
+			write_uint(descriptor, perfetto::track_descriptor_uuid, static_cast<uint64_t>(track.pid) << 32 | 0xffffffff);
+			write_bytes(descriptor, perfetto::track_descriptor_process, message);
+			message.clear();
+
+			write_bytes(packet, perfetto::packet_track_descriptor, descriptor);
+			write_packet(trace, packet, first);
+			first = false;
+			described_processes.push_back(track.pid);
+		}
+
+		uint64_t uuid = static_cast<uint64_t>(track.pid) << 32 | track.tid;
+
+		write_uint(message, perfetto::thread_descriptor_pid, track.pid);
+		write_uint(message, perfetto::thread_descriptor_tid, track.tid);
+		write_bytes(message, perfetto::thread_descriptor_name, track.thread_name);
+
+		std::string descriptor;
+		write_uint(descriptor, perfetto::track_descriptor_uuid, uuid);
+		write_bytes(descriptor, perfetto::track_descriptor_thread, message);
+		message.clear();
+
+		write_bytes(packet, perfetto::packet_track_descriptor, descriptor);
+		write_packet(trace, packet, first);
+
+		// Track events are begin and end pairs, which must be nested, so slices are ordered by start then by length
+		std::vector<const TraceSlice *> slices;
+		slices.reserve(track.slices.size());
+		for (auto &slice : track.slices)
+		{
+			slices.push_back(&slice);
+		}
+		std::ranges::sort(slices, [](const TraceSlice *a, const TraceSlice *b) {
+			return a->begin_us != b->begin_us ? a->begin_us < b->begin_us : a->duration_us > b->duration_us;
+		});
+
+		auto to_ns = [](double us) { return static_cast<uint64_t>(std::llround(us * 1e3)); };
+
+		auto write_end = [&](uint64_t timestamp) {
+			write_uint(message, perfetto::track_event_type, perfetto::slice_end);
+			write_uint(message, perfetto::track_event_track_uuid, uuid);
+
+			write_uint(packet, perfetto::packet_timestamp, timestamp);
+			write_bytes(packet, perfetto::packet_track_event, message);
+			write_packet(trace, packet, false);
+			message.clear();
+		};
+
+		// End times of the open slices
+		std::vector<uint64_t> open;
+		for (auto *slice : slices)
+		{
+			uint64_t begin = to_ns(slice->begin_us);
+			uint64_t end   = std::max(begin, to_ns(slice->begin_us + slice->duration_us));
+			while (!open.empty() && open.back() <= begin)
+			{
+				write_end(open.back());
+				open.pop_back();
+			}
+
+			// A slice overlapping the end of its parent is cut to stay nested
+			if (!open.empty())
+			{
+				end = std::min(end, open.back());
+			}
+
+			write_uint(message, perfetto::track_event_type, perfetto::slice_begin);
+			write_uint(message, perfetto::track_event_track_uuid, uuid);
+			write_bytes(message, perfetto::track_event_categories, track.category);
+			write_bytes(message, perfetto::track_event_name, slice->name);
+			if (!slice->detail.empty())
+			{
+				write_bytes(annotation, perfetto::debug_annotation_name, "detail");
+				write_bytes(annotation, perfetto::debug_annotation_string_value, slice->detail);
+				write_bytes(message, perfetto::track_event_debug_annotations, annotation);
+				annotation.clear();
+			}
+
+			write_uint(packet, perfetto::packet_timestamp, begin);
+			write_bytes(packet, perfetto::packet_track_event, message);
+			write_packet(trace, packet, false);
+			message.clear();
+
+			open.push_back(end);
+		}
+
+		while (!open.empty())
+		{
+			write_end(open.back());
+			open.pop_back();
+		}
+	}
+	return trace;
+}
+}        // namespace vkb::tracing
@@ -0,0 +1,111 @@
+/* Copyright (c) 2025, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <fstream>
+#include <span>
+#include <string>
+#include <vector>
+
+#include "filesystem/filesystem.hpp"
+
+namespace vkb
+{
+namespace filesystem
+{
+/*
+ * A read-only archive of files, mounted over a directory with mount_archive
+ *
+ * Layout, all values little-endian:
+ *   ArchiveHeader
+ *   The contents of each file, each starting at a multiple of the alignment
+ *   ArchiveEntry for each file, sorted by name
+ *   The names of the files, relative to the mount point with '/' separators and without terminators
+ */
+constexpr char ArchiveMagic[8] = {'V', 'K', 'B', 'A', 'R', 'C', 'H', '\0'};
+
+constexpr uint32_t ArchiveVersion = 1;
+
+// The file that init mounts over the external storage directory when it exists
+constexpr const char *DefaultArchiveName = "assets.vkbarc";
+
+enum class ArchiveCompression : uint32_t
+{
+	None,
+	LZ4
+};
+
+struct ArchiveHeader
+{
+	char     magic[8];
+	uint32_t version;
+	uint32_t entry_count;
+	uint64_t toc_offset;
+	uint64_t names_size;
+};
+
+struct ArchiveEntry
+{
+	uint64_t           offset;
+	uint64_t           stored_size;
+	uint64_t           size;
+	uint32_t           name_offset;
+	uint32_t           name_size;
+	ArchiveCompression compression;
+	uint32_t           reserved;
+};
+
+static_assert(sizeof(ArchiveHeader) == 32 && sizeof(ArchiveEntry) == 40, "The archive layout must not depend on the compiler");
+
+// Writes an archive, streaming the contents of the files as they are added
+class ArchiveWriter
+{
+  public:
+	// Contents start at a multiple of alignment, which must be a power of two
+	explicit ArchiveWriter(const Path &path, uint32_t alignment = 64);
+
+	ArchiveWriter(const ArchiveWriter &)            = delete;
+	ArchiveWriter &operator=(const ArchiveWriter &) = delete;
+
+	// Add a file, named with its path relative to the mount point
+	// Compressed contents are only kept if they save at least an eighth of the size, compressed formats such as
+	// PNG or KTX2 with supercompression are stored as they are, and read without any copy
+	// Returns the size stored in the archive
+	size_t add(const std::string &name, std::span<const uint8_t> contents, ArchiveCompression compression);
+
+	// Write the table of contents, throws if two files have the same name
+	void finish();
+
+  private:
+	void write(const void *data, size_t size);
+
+	void pad_to(size_t alignment);
+
+	std::ofstream _file;
+
+	uint32_t _alignment;
+
+	uint64_t _position = 0;
+
+	std::vector<ArchiveEntry> _entries;
+
+	std::string _names;
+};
+}        // namespace filesystem
+}        // namespace vkb
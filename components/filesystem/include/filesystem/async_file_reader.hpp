@@ -0,0 +1,77 @@
+/* Copyright (c) 2025, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <exception>
+#include <functional>
+#include <future>
+#include <memory>
+
+#include "filesystem/filesystem.hpp"
+
+namespace vkb
+{
+namespace filesystem
+{
+// Reads files in the background, with a bounded number of reads in flight
+// Reads submitted while the reader is busy are queued, and issued together as soon as reads complete
+class AsyncFileReader
+{
+  public:
+	// Called on a reader thread with the data read, or with the exception that made the read fail
+	using ReadCallback = std::function<void(MappedFilePtr data, std::exception_ptr error)>;
+
+	AsyncFileReader()          = default;
+	virtual ~AsyncFileReader() = default;
+
+	AsyncFileReader(const AsyncFileReader &)            = delete;
+	AsyncFileReader &operator=(const AsyncFileReader &) = delete;
+
+	// Read size bytes from offset, or the rest of the file if size is 0
+	void submit_read(const Path &path, size_t offset, size_t size, ReadCallback &&callback);
+
+	// Read size bytes from offset, or the rest of the file if size is 0
+	// The future throws if the read failed
+	std::future<MappedFilePtr> submit_read(const Path &path, size_t offset = 0, size_t size = 0);
+
+	// Block until all the submitted reads completed and their callbacks returned
+	virtual void wait_idle() = 0;
+
+	virtual const char *get_backend_name() const = 0;
+
+  protected:
+	struct Request
+	{
+		Path path;
+
+		size_t offset;
+
+		size_t size;
+
+		ReadCallback callback;
+	};
+
+	virtual void enqueue(Request &&request) = 0;
+};
+
+using AsyncFileReaderPtr = std::unique_ptr<AsyncFileReader>;
+
+// Create an io_uring reader on Linux when the kernel allows it, a thread pool reader otherwise
+AsyncFileReaderPtr create_async_file_reader(uint32_t max_in_flight = 32);
+}        // namespace filesystem
+}        // namespace vkb
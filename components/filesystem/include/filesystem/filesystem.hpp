@@ -19,6 +19,7 @@
 
 #include <filesystem>
 #include <memory>
+#include <span>
 #include <string>
 #include <vector>
 
@@ -38,6 +39,49 @@ struct FileStat
 
 using Path = std::filesystem::path;
 
+// Read-only contents of a file, valid for as long as the object is alive
+// Backed by a memory mapping where the filesystem supports it, so reading it does not copy the file
+class MappedFile
+{
+  public:
+	virtual ~MappedFile() = default;
+
+	const uint8_t *data() const
+	{
+		return _data;
+	}
+
+	size_t size() const
+	{
+		return _size;
+	}
+
+	bool empty() const
+	{
+		return _size == 0;
+	}
+
+	std::span<const uint8_t> span() const
+	{
+		return {_data, _size};
+	}
+
+  protected:
+	MappedFile(const uint8_t *data, size_t size) :
+	    _data(data),
+	    _size(size)
+	{}
+
+  private:
+	const uint8_t *_data;
+	size_t         _size;
+};
+
+using MappedFilePtr = std::shared_ptr<const MappedFile>;
+
+// Wrap contents that were read into memory, for when a file cannot be mapped
+MappedFilePtr make_mapped_file(std::vector<uint8_t> &&contents);
+
 // A thin filesystem wrapper
 class FileSystem
 {
@@ -65,6 +109,12 @@ class FileSystem
 
 	// Read the entire file into a vector of bytes
 	std::vector<uint8_t> read_file_binary(const Path &path);
+
+	// Map the entire file into memory, reading it into memory where mapping is not supported
+	virtual MappedFilePtr map_file(const Path &path);
+
+	// Whether the file is served from a mounted archive, in which case a file on disk at that path is not the one read
+	virtual bool is_archived(const Path &path);
 };
 
 using FileSystemPtr = std::shared_ptr<FileSystem>;
@@ -77,6 +127,10 @@ void init_with_context(const PlatformContext &context);
 // Get the filesystem instance
 FileSystemPtr get();
 
+// Mount an archive written with ArchiveWriter over a directory, replacing the filesystem instance
+// Files of the archive are read from the mapped archive, all other paths from the previous filesystem
+void mount_archive(const Path &archive_path, const Path &mount_point);
+
 namespace helpers
 {
 std::string filename(const std::string &path);
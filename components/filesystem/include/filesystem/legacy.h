@@ -21,6 +21,7 @@
 #include <cstdint>
 #include <cstdlib>
 #include <fstream>
+#include <memory>
 #include <string>
 #include <sys/stat.h>
 #include <unordered_map>
@@ -28,6 +29,11 @@
 
 namespace vkb
 {
+namespace filesystem
+{
+class MappedFile;
+}        // namespace filesystem
+
 namespace fs
 {
 namespace path
@@ -95,6 +101,32 @@ void create_path(const std::string &root, const std::string &path);
  */
 std::vector<uint8_t> read_asset(const std::string &filename);
 
+/**
+ * @brief Helper to map an asset file into memory, without copying it
+ *
+ * @param filename The path to the file (relative to the assets directory)
+ * @return The contents of the file, valid while the returned pointer is held
+ */
+std::shared_ptr<const filesystem::MappedFile> map_asset(const std::string &filename);
+
+/**
+ * @brief Starts reading asset files in the background, with batched asynchronous reads
+ *
+ * The next map_asset of each file waits for its read to complete instead of reading the file again.
+ * Loaders call this with all the files they reference before decoding them, so that the reads overlap, and
+ * drop_prefetched_assets with the same files once they are loaded. At most 256 files are prefetched at once.
+ *
+ * @param filenames The paths to the files (relative to the assets directory)
+ */
+void prefetch_assets(const std::vector<std::string> &filenames);
+
+/**
+ * @brief Drops the prefetched files that were not mapped, such as files a loader ended up not using
+ *
+ * @param filenames The paths to the files (relative to the assets directory)
+ */
+void drop_prefetched_assets(const std::vector<std::string> &filenames);
+
 /**
  * @brief Helper to read a text file into a single string
  *
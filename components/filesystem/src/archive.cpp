@@ -0,0 +1,133 @@
+/* Copyright (c) 2025, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "filesystem/archive.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <string_view>
+
+#include "lz4.hpp"
+
+namespace vkb
+{
+namespace filesystem
+{
+ArchiveWriter::ArchiveWriter(const Path &path, uint32_t alignment) :
+    _file(path, std::ios::binary | std::ios::trunc),
+    _alignment(alignment)
+{
+	if (!_file.is_open())
+	{
+		throw std::runtime_error("Failed to open file for writing at path: " + path.string());
+	}
+
+	if (alignment == 0 || (alignment & (alignment - 1)) != 0)
+	{
+		throw std::runtime_error("Archive alignment must be a power of two");
+	}
+
+	// The header is written by finish, once the table of contents is known
+	ArchiveHeader header{};
+	write(&header, sizeof(header));
+}
+
+size_t ArchiveWriter::add(const std::string &name, std::span<const uint8_t> contents, ArchiveCompression compression)
+{
+	std::vector<uint8_t> compressed;
+	if (compression == ArchiveCompression::LZ4)
+	{
+		compressed = lz4_compress(contents);
+		if (compressed.size() > contents.size() - contents.size() / 8)
+		{
+			compression = ArchiveCompression::None;
+		}
+	}
+
+	auto stored = compression == ArchiveCompression::None ? contents : std::span<const uint8_t>(compressed);
+
+	pad_to(_alignment);
+
+	ArchiveEntry entry{};
+	entry.offset      = _position;
+	entry.stored_size = stored.size();
+	entry.size        = contents.size();
+	entry.name_offset = static_cast<uint32_t>(_names.size());
+	entry.name_size   = static_cast<uint32_t>(name.size());
+	entry.compression = compression;
+	_entries.push_back(entry);
+	_names += name;
+
+	write(stored.data(), stored.size());
+
+	return stored.size();
+}
+
+void ArchiveWriter::finish()
+{
+	auto name_of = [this](const ArchiveEntry &entry) {
+		return std::string_view(_names).substr(entry.name_offset, entry.name_size);
+	};
+
+	std::sort(_entries.begin(), _entries.end(), [&](const ArchiveEntry &a, const ArchiveEntry &b) { return name_of(a) < name_of(b); });
+
+	auto duplicate = std::adjacent_find(_entries.begin(), _entries.end(), [&](const ArchiveEntry &a, const ArchiveEntry &b) { return name_of(a) == name_of(b); });
+	if (duplicate != _entries.end())
+	{
+		throw std::runtime_error("File added twice to the archive: " + std::string(name_of(*duplicate)));
+	}
+
+	pad_to(alignof(ArchiveEntry));
+
+	ArchiveHeader header{};
+	std::memcpy(header.magic, ArchiveMagic, sizeof(ArchiveMagic));
+	header.version     = ArchiveVersion;
+	header.entry_count = static_cast<uint32_t>(_entries.size());
+	header.toc_offset  = _position;
+	header.names_size  = _names.size();
+
+	write(_entries.data(), _entries.size() * sizeof(ArchiveEntry));
+	write(_names.data(), _names.size());
+
+	_file.seekp(0);
+	_file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+	_file.close();
+
+	if (_file.fail())
+	{
+		throw std::runtime_error("Failed to write the archive");
+	}
+}
+
+void ArchiveWriter::write(const void *data, size_t size)
+{
+	_file.write(static_cast<const char *>(data), size);
+	_position += size;
+}
+
+void ArchiveWriter::pad_to(size_t alignment)
+{
+	static const char zeros[256] = {};
+
+	auto padding = static_cast<size_t>((alignment - _position % alignment) % alignment);
+	for (; padding > 0; padding -= std::min(padding, sizeof(zeros)))
+	{
+		write(zeros, std::min(padding, sizeof(zeros)));
+	}
+}
+}        // namespace filesystem
+}        // namespace vkb
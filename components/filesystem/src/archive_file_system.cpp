@@ -0,0 +1,288 @@
+/* Copyright (c) 2025, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "archive_file_system.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+#include "lz4.hpp"
+
+namespace vkb
+{
+namespace filesystem
+{
+namespace
+{
+// Contents of an uncompressed file, pointing into the mapped archive which it keeps alive
+class ArchiveMappedFile final : public MappedFile
+{
+  public:
+	ArchiveMappedFile(MappedFilePtr archive, std::span<const uint8_t> contents) :
+	    MappedFile(contents.data(), contents.size()),
+	    _archive(std::move(archive))
+	{}
+
+  private:
+	MappedFilePtr _archive;
+};
+}        // namespace
+
+ArchiveFileSystem::ArchiveFileSystem(FileSystemPtr base, const Path &archive_path, const Path &mount_point) :
+    _base(std::move(base)),
+    _archive(_base->map_file(archive_path)),
+    _mount_point(mount_point.lexically_normal())
+{
+	auto malformed = [&archive_path](const std::string &reason) {
+		return std::runtime_error("Malformed archive at path: " + archive_path.string() + " (" + reason + ")");
+	};
+
+	auto archive = _archive->span();
+
+	ArchiveHeader header;
+	if (archive.size() < sizeof(header))
+	{
+		throw malformed("too small");
+	}
+	std::memcpy(&header, archive.data(), sizeof(header));
+
+	if (std::memcmp(header.magic, ArchiveMagic, sizeof(ArchiveMagic)) != 0)
+	{
+		throw malformed("not an archive");
+	}
+	if (header.version != ArchiveVersion)
+	{
+		throw malformed("unsupported version " + std::to_string(header.version));
+	}
+
+	uint64_t toc_size = uint64_t{header.entry_count} * sizeof(ArchiveEntry);
+	if (header.toc_offset > archive.size() || toc_size > archive.size() - header.toc_offset ||
+	    header.names_size > archive.size() - header.toc_offset - toc_size)
+	{
+		throw malformed("table of contents out of bounds");
+	}
+
+	auto names = std::string_view(reinterpret_cast<const char *>(archive.data() + header.toc_offset + toc_size), header.names_size);
+
+	// Everything is validated once here, so that lookups and reads can trust the table of contents
+	_entries.resize(header.entry_count);
+	for (uint32_t i = 0; i < header.entry_count; ++i)
+	{
+		auto &entry = _entries[i];
+		std::memcpy(&entry.info, archive.data() + header.toc_offset + i * sizeof(ArchiveEntry), sizeof(ArchiveEntry));
+
+		auto &info = entry.info;
+		if (info.offset > header.toc_offset || info.stored_size > header.toc_offset - info.offset ||
+		    uint64_t{info.name_offset} + info.name_size > names.size())
+		{
+			throw malformed("entry " + std::to_string(i) + " out of bounds");
+		}
+		if (info.compression != ArchiveCompression::None && info.compression != ArchiveCompression::LZ4)
+		{
+			throw malformed("entry " + std::to_string(i) + " has an unknown compression");
+		}
+		if (info.compression == ArchiveCompression::None && info.stored_size != info.size)
+		{
+			throw malformed("entry " + std::to_string(i) + " has an inconsistent size");
+		}
+
+		entry.name = names.substr(info.name_offset, info.name_size);
+		if (i > 0 && !(_entries[i - 1].name < entry.name))
+		{
+			throw malformed("entries are not sorted");
+		}
+
+		for (auto separator = entry.name.find('/'); separator != std::string_view::npos; separator = entry.name.find('/', separator + 1))
+		{
+			_directories.emplace_back(entry.name.substr(0, separator));
+		}
+	}
+
+	// The mount point itself is the root directory of the archive
+	_directories.emplace_back();
+	std::sort(_directories.begin(), _directories.end());
+	_directories.erase(std::unique(_directories.begin(), _directories.end()), _directories.end());
+}
+
+FileStat ArchiveFileSystem::stat_file(const Path &path)
+{
+	if (auto entry = find_file(path))
+	{
+		return FileStat{true, false, static_cast<size_t>(entry->info.size)};
+	}
+	if (find_directory(path))
+	{
+		return FileStat{false, true, 0};
+	}
+	return _base->stat_file(path);
+}
+
+bool ArchiveFileSystem::is_file(const Path &path)
+{
+	return find_file(path) || _base->is_file(path);
+}
+
+bool ArchiveFileSystem::is_directory(const Path &path)
+{
+	return find_directory(path) || _base->is_directory(path);
+}
+
+bool ArchiveFileSystem::exists(const Path &path)
+{
+	return find_file(path) || find_directory(path) || _base->exists(path);
+}
+
+bool ArchiveFileSystem::create_directory(const Path &path)
+{
+	return find_directory(path) || _base->create_directory(path);
+}
+
+std::vector<uint8_t> ArchiveFileSystem::read_chunk(const Path &path, size_t offset, size_t count)
+{
+	auto entry = find_file(path);
+	if (!entry)
+	{
+		return _base->read_chunk(path, offset, count);
+	}
+
+	if (offset + count > entry->info.size)
+	{
+		return {};
+	}
+
+	if (entry->info.compression == ArchiveCompression::None)
+	{
+		auto contents = stored_contents(*entry).subspan(offset, count);
+		return {contents.begin(), contents.end()};
+	}
+
+	auto contents = decompress(*entry);
+	if (offset == 0 && count == contents.size())
+	{
+		return contents;
+	}
+	return {contents.begin() + offset, contents.begin() + offset + count};
+}
+
+MappedFilePtr ArchiveFileSystem::map_file(const Path &path)
+{
+	auto entry = find_file(path);
+	if (!entry)
+	{
+		return _base->map_file(path);
+	}
+
+	if (entry->info.compression == ArchiveCompression::None)
+	{
+		return std::make_shared<ArchiveMappedFile>(_archive, stored_contents(*entry));
+	}
+
+	return make_mapped_file(decompress(*entry));
+}
+
+bool ArchiveFileSystem::is_archived(const Path &path)
+{
+	return find_file(path) || _base->is_archived(path);
+}
+
+void ArchiveFileSystem::write_file(const Path &path, const std::vector<uint8_t> &data)
+{
+	// Files of the archive hide files written at the same path
+	_base->write_file(path, data);
+}
+
+void ArchiveFileSystem::remove(const Path &path)
+{
+	_base->remove(path);
+}
+
+void ArchiveFileSystem::set_external_storage_directory(const std::string &dir)
+{
+	_base->set_external_storage_directory(dir);
+}
+
+const Path &ArchiveFileSystem::external_storage_directory() const
+{
+	return _base->external_storage_directory();
+}
+
+const Path &ArchiveFileSystem::temp_directory() const
+{
+	return _base->temp_directory();
+}
+
+std::optional<std::string> ArchiveFileSystem::archive_name(const Path &path) const
+{
+	auto relative = path.lexically_normal().lexically_relative(_mount_point);
+	if (relative.empty())
+	{
+		return std::nullopt;
+	}
+
+	auto name = relative.generic_string();
+	if (name == "." || name == "./")
+	{
+		return std::string{};
+	}
+	if (name == ".." || name.starts_with("../"))
+	{
+		return std::nullopt;
+	}
+
+	// Directories given with a trailing separator
+	if (name.back() == '/')
+	{
+		name.pop_back();
+	}
+	return name;
+}
+
+const ArchiveFileSystem::Entry *ArchiveFileSystem::find_file(const Path &path) const
+{
+	auto name = archive_name(path);
+	if (!name)
+	{
+		return nullptr;
+	}
+
+	auto it = std::lower_bound(_entries.begin(), _entries.end(), *name, [](const Entry &entry, const std::string &name) { return entry.name < name; });
+	if (it == _entries.end() || it->name != *name)
+	{
+		return nullptr;
+	}
+	return &*it;
+}
+
+bool ArchiveFileSystem::find_directory(const Path &path) const
+{
+	auto name = archive_name(path);
+	return name && std::binary_search(_directories.begin(), _directories.end(), *name);
+}
+
+std::span<const uint8_t> ArchiveFileSystem::stored_contents(const Entry &entry) const
+{
+	return _archive->span().subspan(entry.info.offset, entry.info.stored_size);
+}
+
+std::vector<uint8_t> ArchiveFileSystem::decompress(const Entry &entry) const
+{
+	std::vector<uint8_t> contents(entry.info.size);
+	lz4_decompress(stored_contents(entry), contents);
+	return contents;
+}
+}        // namespace filesystem
+}        // namespace vkb
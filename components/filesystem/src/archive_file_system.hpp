@@ -0,0 +1,101 @@
+/* Copyright (c) 2025, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "filesystem/archive.hpp"
+#include "filesystem/filesystem.hpp"
+
+namespace vkb
+{
+namespace filesystem
+{
+// Serves the files of an archive mapped in memory, as if they were in the mount point directory
+// Lookups are binary searches in the table of contents, they never touch the disk
+// Paths outside of the archive, and all writes, go to the underlying filesystem
+class ArchiveFileSystem final : public FileSystem
+{
+  public:
+	// Throws if the archive cannot be read or is malformed
+	ArchiveFileSystem(FileSystemPtr base, const Path &archive_path, const Path &mount_point);
+
+	~ArchiveFileSystem() override = default;
+
+	FileStat stat_file(const Path &path) override;
+
+	bool is_file(const Path &path) override;
+
+	bool is_directory(const Path &path) override;
+
+	bool exists(const Path &path) override;
+
+	bool create_directory(const Path &path) override;
+
+	std::vector<uint8_t> read_chunk(const Path &path, size_t offset, size_t count) override;
+
+	MappedFilePtr map_file(const Path &path) override;
+
+	bool is_archived(const Path &path) override;
+
+	void write_file(const Path &path, const std::vector<uint8_t> &data) override;
+
+	void remove(const Path &path) override;
+
+	void set_external_storage_directory(const std::string &dir) override;
+
+	const Path &external_storage_directory() const override;
+
+	const Path &temp_directory() const override;
+
+  private:
+	struct Entry
+	{
+		std::string_view name;
+
+		ArchiveEntry info;
+	};
+
+	// The name of a path relative to the mount point, or nothing if the path is outside of it
+	std::optional<std::string> archive_name(const Path &path) const;
+
+	const Entry *find_file(const Path &path) const;
+
+	bool find_directory(const Path &path) const;
+
+	std::span<const uint8_t> stored_contents(const Entry &entry) const;
+
+	std::vector<uint8_t> decompress(const Entry &entry) const;
+
+	FileSystemPtr _base;
+
+	MappedFilePtr _archive;
+
+	Path _mount_point;
+
+	// Sorted by name, the names point into the archive
+	std::vector<Entry> _entries;
+
+	// Every directory that contains a file, sorted
+	std::vector<std::string> _directories;
+};
+}        // namespace filesystem
+}        // namespace vkb
@@ -0,0 +1,75 @@
+/* Copyright (c) 2025, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "filesystem/async_file_reader.hpp"
+
+#include <algorithm>
+#include <thread>
+
+#include <core/util/logging.hpp>
+
+#include "io_uring_file_reader.hpp"
+#include "thread_pool_file_reader.hpp"
+
+namespace vkb
+{
+namespace filesystem
+{
+void AsyncFileReader::submit_read(const Path &path, size_t offset, size_t size, ReadCallback &&callback)
+{
+	enqueue({path, offset, size, std::move(callback)});
+}
+
+std::future<MappedFilePtr> AsyncFileReader::submit_read(const Path &path, size_t offset, size_t size)
+{
+	auto promise = std::make_shared<std::promise<MappedFilePtr>>();
+	auto future  = promise->get_future();
+
+	submit_read(path, offset, size, [promise](MappedFilePtr data, std::exception_ptr error) {
+		if (error)
+		{
+			promise->set_exception(error);
+		}
+		else
+		{
+			promise->set_value(std::move(data));
+		}
+	});
+
+	return future;
+}
+
+AsyncFileReaderPtr create_async_file_reader(uint32_t max_in_flight)
+{
+#ifdef VKB_HAS_IO_URING
+	try
+	{
+		return std::make_unique<IoUringFileReader>(max_in_flight);
+	}
+	catch (const std::exception &e)
+	{
+		// Containers and hardened kernels often disable io_uring
+		LOGW("{}, reading files with a thread pool instead", e.what());
+	}
+#endif
+
+	// Blocking reads need a thread each to be in flight, but more threads than that only add contention
+	uint32_t thread_count = std::min(max_in_flight, std::max(std::thread::hardware_concurrency(), 4u));
+	return std::make_unique<ThreadPoolFileReader>(thread_count);
+}
+}        // namespace filesystem
+}        // namespace vkb
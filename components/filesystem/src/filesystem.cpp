@@ -20,6 +20,7 @@
 #include "core/platform/context.hpp"
 #include "core/util/error.hpp"
 
+#include "archive_file_system.hpp"
 #include "std_filesystem.hpp"
 
 namespace vkb
@@ -28,9 +29,46 @@ namespace filesystem
 {
 static FileSystemPtr fs = nullptr;
 
+namespace
+{
+// Fallback for filesystems that cannot map files, owns a copy of the file
+class ReadMappedFile final : public MappedFile
+{
+  public:
+	explicit ReadMappedFile(std::vector<uint8_t> &&contents) :
+	    MappedFile(contents.data(), contents.size()),
+	    _contents(std::move(contents))
+	{}
+
+  private:
+	std::vector<uint8_t> _contents;
+};
+
+// Assets packed with the asset_packer tool are read from their archive instead of from loose files
+void mount_default_archive()
+{
+	auto archive_path = fs->external_storage_directory() / DefaultArchiveName;
+	if (!fs->is_file(archive_path))
+	{
+		return;
+	}
+
+	try
+	{
+		mount_archive(archive_path, fs->external_storage_directory());
+		LOGI("Mounted archive {}", archive_path.string());
+	}
+	catch (const std::exception &e)
+	{
+		LOGE("{}, reading loose files instead", e.what());
+	}
+}
+}        // namespace
+
 void init()
 {
 	fs = std::make_shared<StdFileSystem>();
+	mount_default_archive();
 }
 
 void init_with_context(const PlatformContext &context)
@@ -38,6 +76,7 @@ void init_with_context(const PlatformContext &context)
 	fs = std::make_shared<StdFileSystem>(
 	    context.external_storage_directory(),
 	    context.temp_directory());
+	mount_default_archive();
 }
 
 FileSystemPtr get()
@@ -46,6 +85,11 @@ FileSystemPtr get()
 	return fs;
 }
 
+void mount_archive(const Path &archive_path, const Path &mount_point)
+{
+	fs = std::make_shared<ArchiveFileSystem>(get(), archive_path, mount_point);
+}
+
 void FileSystem::write_file(const Path &path, const std::string &data)
 {
 	write_file(path, std::vector<uint8_t>(data.begin(), data.end()));
@@ -63,5 +107,20 @@ std::vector<uint8_t> FileSystem::read_file_binary(const Path &path)
 	return read_chunk(path, 0, stat.size);
 }
 
+MappedFilePtr make_mapped_file(std::vector<uint8_t> &&contents)
+{
+	return std::make_shared<ReadMappedFile>(std::move(contents));
+}
+
+MappedFilePtr FileSystem::map_file(const Path &path)
+{
+	return make_mapped_file(read_file_binary(path));
+}
+
+bool FileSystem::is_archived(const Path &)
+{
+	return false;
+}
+
 }        // namespace filesystem
 }        // namespace vkb
\ No newline at end of file
@@ -0,0 +1,533 @@
+/* Copyright (c) 2025, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "io_uring_file_reader.hpp"
+
+#ifdef VKB_HAS_IO_URING
+
+#	include <algorithm>
+#	include <cerrno>
+#	include <cstring>
+
+#	include <fcntl.h>
+#	include <linux/io_uring.h>
+#	include <sys/mman.h>
+#	include <sys/stat.h>
+#	include <sys/syscall.h>
+#	include <unistd.h>
+
+#	include <core/util/logging.hpp>
+
+#	include "thread_pool_file_reader.hpp"
+
+namespace vkb
+{
+namespace filesystem
+{
+namespace
+{
+// User data of the completions of cancel operations, which do not belong to a slot
+constexpr uint64_t cancel_user_data = ~0ull;
+
+std::exception_ptr make_error(const std::string &message, const Path &path, int error_code)
+{
+	return std::make_exception_ptr(std::runtime_error(message + " at path: " + path.string() + " (" + std::strerror(error_code) + ")"));
+}
+}        // namespace
+
+IoUringFileReader::IoUringFileReader(uint32_t max_in_flight)
+{
+	uint32_t slot_count = std::max(max_in_flight, 1u);
+
+	io_uring_params params{};
+	_ring_fd = static_cast<int>(syscall(__NR_io_uring_setup, slot_count, &params));
+	if (_ring_fd < 0)
+	{
+		throw std::runtime_error(std::string("io_uring_setup failed: ") + std::strerror(errno));
+	}
+
+	// Mapping both rings at once needs Linux 5.4, which also has all the operations used here
+	if (!(params.features & IORING_FEAT_SINGLE_MMAP))
+	{
+		close(_ring_fd);
+		throw std::runtime_error("io_uring is too old, IORING_FEAT_SINGLE_MMAP is not supported");
+	}
+
+	_ring_size = std::max(params.sq_off.array + params.sq_entries * sizeof(unsigned),
+	                      params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe));
+	_ring      = mmap(nullptr, _ring_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, _ring_fd, IORING_OFF_SQ_RING);
+
+	_sqe_size   = params.sq_entries * sizeof(io_uring_sqe);
+	_sqe_memory = mmap(nullptr, _sqe_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, _ring_fd, IORING_OFF_SQES);
+
+	if (_ring == MAP_FAILED || _sqe_memory == MAP_FAILED)
+	{
+		int error_code = errno;
+		if (_ring != MAP_FAILED)
+		{
+			munmap(_ring, _ring_size);
+		}
+		if (_sqe_memory != MAP_FAILED)
+		{
+			munmap(_sqe_memory, _sqe_size);
+		}
+		close(_ring_fd);
+		throw std::runtime_error(std::string("Failed to map the io_uring rings: ") + std::strerror(error_code));
+	}
+
+	auto ring = static_cast<uint8_t *>(_ring);
+	_sq_head  = reinterpret_cast<unsigned *>(ring + params.sq_off.head);
+	_sq_tail  = reinterpret_cast<unsigned *>(ring + params.sq_off.tail);
+	_sq_mask  = reinterpret_cast<unsigned *>(ring + params.sq_off.ring_mask);
+	_sq_array = reinterpret_cast<unsigned *>(ring + params.sq_off.array);
+	_cq_head  = reinterpret_cast<unsigned *>(ring + params.cq_off.head);
+	_cq_tail  = reinterpret_cast<unsigned *>(ring + params.cq_off.tail);
+	_cq_mask  = reinterpret_cast<unsigned *>(ring + params.cq_off.ring_mask);
+	_cqes     = reinterpret_cast<io_uring_cqe *>(ring + params.cq_off.cqes);
+	_sqes     = static_cast<io_uring_sqe *>(_sqe_memory);
+
+	// A slot has at most one read in the submission ring, so the rings never overflow
+	_reads.resize(std::min(slot_count, params.sq_entries));
+	for (uint32_t slot = static_cast<uint32_t>(_reads.size()); slot-- > 0;)
+	{
+		_free_slots.push_back(slot);
+	}
+
+	_thread = std::thread(&IoUringFileReader::run, this);
+}
+
+IoUringFileReader::~IoUringFileReader()
+{
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		_stop = true;
+	}
+	_request_condition.notify_all();
+
+	// The thread finishes the queued requests before it stops
+	_thread.join();
+
+	// Closing the ring does not wait for the reads that could not be cancelled, their buffers are never freed
+	for (auto &read : _reads)
+	{
+		if (read.abandoned)
+		{
+			new std::vector<uint8_t>(std::move(read.data));
+		}
+	}
+
+	munmap(_sqe_memory, _sqe_size);
+	munmap(_ring, _ring_size);
+	close(_ring_fd);
+}
+
+void IoUringFileReader::wait_idle()
+{
+	std::unique_lock<std::mutex> lock(_mutex);
+	_idle_condition.wait(lock, [this]() { return _requests.empty() && _in_flight == 0; });
+}
+
+const char *IoUringFileReader::get_backend_name() const
+{
+	return "io_uring";
+}
+
+void IoUringFileReader::enqueue(Request &&request)
+{
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		_requests.push_back(std::move(request));
+	}
+	_request_condition.notify_one();
+}
+
+void IoUringFileReader::run()
+{
+	std::vector<uint32_t> started_slots;
+	std::vector<uint32_t> partial_reads;
+	std::deque<Request>   slotless_requests;
+
+	while (true)
+	{
+		{
+			// Sleeps until there is work this thread can do, requests that find no free slot wait for a completion
+			std::unique_lock<std::mutex> lock(_mutex);
+			_request_condition.wait(lock, [this, &partial_reads]() {
+				return _stop || _pending_completions > 0 || !partial_reads.empty() ||
+				       (!_requests.empty() && (!_free_slots.empty() || _broken));
+			});
+			if (_stop && _requests.empty() && _in_flight == 0)
+			{
+				return;
+			}
+
+			// Take as many requests as there are free slots, they are submitted together
+			while (!_requests.empty() && !_free_slots.empty())
+			{
+				uint32_t slot = _free_slots.back();
+				_free_slots.pop_back();
+				_reads[slot].request = std::move(_requests.front());
+				_requests.pop_front();
+				_in_flight++;
+				started_slots.push_back(slot);
+			}
+
+			// Reads of a broken ring finish before the next requests are taken, so no free slot means that every
+			// slot was abandoned, and would never be freed
+			if (_broken && _free_slots.empty())
+			{
+				_in_flight += static_cast<uint32_t>(_requests.size());
+				slotless_requests.swap(_requests);
+			}
+		}
+
+		for (auto slot : started_slots)
+		{
+			start_read(slot);
+		}
+		started_slots.clear();
+
+		for (auto &request : slotless_requests)
+		{
+			read_without_slot(std::move(request));
+		}
+		slotless_requests.clear();
+
+		for (auto slot : partial_reads)
+		{
+			queue_read(slot);
+		}
+		partial_reads.clear();
+
+		if (_pending_completions == 0)
+		{
+			continue;
+		}
+
+		// Submit the queued reads and wait for at least one of the reads in flight to complete
+		int result = static_cast<int>(syscall(__NR_io_uring_enter, _ring_fd, _to_submit, 1, IORING_ENTER_GETEVENTS, nullptr, 0));
+		if (result >= 0)
+		{
+			_to_submit -= std::min(static_cast<unsigned>(result), _to_submit);
+		}
+		else if (errno != EINTR && errno != EAGAIN && errno != EBUSY)
+		{
+			fail_in_flight_reads(errno);
+			continue;
+		}
+
+		reap_completions(partial_reads);
+	}
+}
+
+void IoUringFileReader::start_read(uint32_t slot)
+{
+	auto &read = _reads[slot];
+
+	if (_broken)
+	{
+		// The ring failed, the remaining reads block the reader thread instead
+		read_with_filesystem(slot);
+		return;
+	}
+
+	// Mounted archives hide the files on disk at the same path, so only paths they do not serve are opened directly
+	if (get()->is_archived(read.request.path))
+	{
+		read_with_filesystem(slot);
+		return;
+	}
+
+	read.fd = open(read.request.path.c_str(), O_RDONLY | O_CLOEXEC);
+	if (read.fd < 0 && errno == ENOENT)
+	{
+		// Files that are not on disk may still be served by the filesystem
+		read_with_filesystem(slot);
+		return;
+	}
+	if (read.fd < 0)
+	{
+		finish_read(slot, nullptr, make_error("Failed to open file for reading", read.request.path, errno));
+		return;
+	}
+
+	struct stat file_stat;
+	if (fstat(read.fd, &file_stat) != 0)
+	{
+		finish_read(slot, nullptr, make_error("Failed to get the size of the file", read.request.path, errno));
+		return;
+	}
+
+	auto file_size = static_cast<size_t>(file_stat.st_size);
+	auto size      = read.request.size;
+	if (size == 0)
+	{
+		size = read.request.offset < file_size ? file_size - read.request.offset : 0;
+	}
+	if (read.request.offset + size > file_size)
+	{
+		finish_read(slot, nullptr, std::make_exception_ptr(std::runtime_error("Read past the end of the file at path: " + read.request.path.string())));
+		return;
+	}
+
+	read.data.resize(size);
+	read.done = 0;
+
+	if (size == 0)
+	{
+		finish_read(slot, make_mapped_file(std::move(read.data)), nullptr);
+		return;
+	}
+
+	queue_read(slot);
+}
+
+void IoUringFileReader::read_with_filesystem(uint32_t slot)
+{
+	auto &read = _reads[slot];
+
+	MappedFilePtr      data;
+	std::exception_ptr error;
+	try
+	{
+		data = read_blocking(read.request.path, read.request.offset, read.request.size);
+	}
+	catch (...)
+	{
+		error = std::current_exception();
+	}
+	finish_read(slot, std::move(data), error);
+}
+
+void IoUringFileReader::read_without_slot(Request &&request)
+{
+	MappedFilePtr      data;
+	std::exception_ptr error;
+	try
+	{
+		data = read_blocking(request.path, request.offset, request.size);
+	}
+	catch (...)
+	{
+		error = std::current_exception();
+	}
+	request.callback(std::move(data), error);
+
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		_in_flight--;
+	}
+	_idle_condition.notify_all();
+}
+
+void IoUringFileReader::queue_read(uint32_t slot)
+{
+	auto &read = _reads[slot];
+
+	read.buffer.iov_base = read.data.data() + read.done;
+	read.buffer.iov_len  = read.data.size() - read.done;
+
+	// Only this thread writes the tail, the kernel reads it once it is released
+	unsigned tail  = *_sq_tail;
+	unsigned index = tail & *_sq_mask;
+
+	auto &sqe = _sqes[index];
+	std::memset(&sqe, 0, sizeof(sqe));
+	sqe.opcode    = IORING_OP_READV;
+	sqe.fd        = read.fd;
+	sqe.addr      = reinterpret_cast<uint64_t>(&read.buffer);
+	sqe.len       = 1;
+	sqe.off       = read.request.offset + read.done;
+	sqe.user_data = slot;
+
+	_sq_array[index] = index;
+	__atomic_store_n(_sq_tail, tail + 1, __ATOMIC_RELEASE);
+
+	_to_submit++;
+	_pending_completions++;
+}
+
+void IoUringFileReader::reap_completions(std::vector<uint32_t> &partial_reads)
+{
+	unsigned head = *_cq_head;
+	unsigned tail = __atomic_load_n(_cq_tail, __ATOMIC_ACQUIRE);
+
+	for (; head != tail; ++head)
+	{
+		auto &cqe = _cqes[head & *_cq_mask];
+
+		_pending_completions--;
+
+		if (cqe.user_data == cancel_user_data)
+		{
+			continue;
+		}
+
+		auto  slot = static_cast<uint32_t>(cqe.user_data);
+		auto  res  = cqe.res;
+		auto &read = _reads[slot];
+
+		if (res < 0)
+		{
+			finish_read(slot, nullptr, make_error("Failed to read file", read.request.path, -res));
+		}
+		else if (res == 0)
+		{
+			finish_read(slot, nullptr, std::make_exception_ptr(std::runtime_error("File shrank while reading at path: " + read.request.path.string())));
+		}
+		else
+		{
+			read.done += static_cast<size_t>(res);
+			if (read.done < read.data.size())
+			{
+				// Short reads are continued where they stopped
+				partial_reads.push_back(slot);
+			}
+			else
+			{
+				finish_read(slot, make_mapped_file(std::move(read.data)), nullptr);
+			}
+		}
+	}
+
+	__atomic_store_n(_cq_head, head, __ATOMIC_RELEASE);
+}
+
+void IoUringFileReader::fail_in_flight_reads(int error_code)
+{
+	LOGE("io_uring_enter failed ({}), reading files with blocking reads from now on", std::strerror(error_code));
+
+	_broken = true;
+
+	// The kernel has not consumed the entries past the head of the submission ring, their reads are taken back
+	unsigned head = __atomic_load_n(_sq_head, __ATOMIC_ACQUIRE);
+	unsigned tail = *_sq_tail;
+	while (tail != head)
+	{
+		auto slot = static_cast<uint32_t>(_sqes[--tail & *_sq_mask].user_data);
+		_pending_completions--;
+		finish_read(slot, nullptr, make_error("Failed to submit read", _reads[slot].request.path, error_code));
+	}
+	__atomic_store_n(_sq_tail, tail, __ATOMIC_RELEASE);
+	_to_submit = 0;
+
+	// The kernel may still write to the buffers of the submitted reads, they must complete before they are freed
+	for (uint32_t slot = 0; slot < _reads.size(); ++slot)
+	{
+		if (_reads[slot].fd < 0)
+		{
+			continue;
+		}
+
+		tail           = *_sq_tail;
+		unsigned index = tail & *_sq_mask;
+
+		auto &sqe = _sqes[index];
+		std::memset(&sqe, 0, sizeof(sqe));
+		sqe.opcode    = IORING_OP_ASYNC_CANCEL;
+		sqe.fd        = -1;
+		sqe.addr      = slot;
+		sqe.user_data = cancel_user_data;
+
+		_sq_array[index] = index;
+		__atomic_store_n(_sq_tail, tail + 1, __ATOMIC_RELEASE);
+
+		_to_submit++;
+		_pending_completions++;
+	}
+
+	std::vector<uint32_t> partial_reads;
+	while (_pending_completions > 0)
+	{
+		int result = static_cast<int>(syscall(__NR_io_uring_enter, _ring_fd, _to_submit, 1, IORING_ENTER_GETEVENTS, nullptr, 0));
+		if (result >= 0)
+		{
+			_to_submit -= std::min(static_cast<unsigned>(result), _to_submit);
+		}
+		else if (errno != EINTR && errno != EAGAIN && errno != EBUSY)
+		{
+			break;
+		}
+
+		reap_completions(partial_reads);
+
+		// Reads that stopped short are finished with blocking reads, as the ring is no longer used
+		for (auto slot : partial_reads)
+		{
+			read_with_filesystem(slot);
+		}
+		partial_reads.clear();
+	}
+
+	if (_pending_completions == 0)
+	{
+		return;
+	}
+
+	// The reads could not be waited for, their slots and buffers stay reserved so that the kernel never writes to
+	// memory that was reused
+	LOGE("Failed to cancel the reads submitted to io_uring, {} read buffers are leaked", _pending_completions);
+	for (uint32_t slot = 0; slot < _reads.size(); ++slot)
+	{
+		auto &read = _reads[slot];
+		if (read.fd < 0)
+		{
+			continue;
+		}
+
+		close(read.fd);
+		read.fd        = -1;
+		read.abandoned = true;
+
+		auto request = std::move(read.request);
+		request.callback(nullptr, make_error("Failed to submit read", request.path, error_code));
+
+		{
+			std::lock_guard<std::mutex> lock(_mutex);
+			_in_flight--;
+		}
+		_idle_condition.notify_all();
+	}
+	_to_submit           = 0;
+	_pending_completions = 0;
+}
+
+void IoUringFileReader::finish_read(uint32_t slot, MappedFilePtr &&data, std::exception_ptr error)
+{
+	auto &read = _reads[slot];
+
+	if (read.fd >= 0)
+	{
+		close(read.fd);
+		read.fd = -1;
+	}
+
+	auto request = std::move(read.request);
+	read.data    = {};
+	request.callback(std::move(data), error);
+
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		_free_slots.push_back(slot);
+		_in_flight--;
+	}
+	_idle_condition.notify_all();
+}
+}        // namespace filesystem
+}        // namespace vkb
+
+#endif
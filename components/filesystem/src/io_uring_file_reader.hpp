@@ -0,0 +1,146 @@
+/* Copyright (c) 2025, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#if defined(__linux__) && !defined(__ANDROID__) && __has_include(<linux/io_uring.h>)
+#	define VKB_HAS_IO_URING
+#endif
+
+#ifdef VKB_HAS_IO_URING
+
+#	include "filesystem/async_file_reader.hpp"
+
+#	include <condition_variable>
+#	include <deque>
+#	include <mutex>
+#	include <thread>
+#	include <vector>
+
+#	include <sys/uio.h>
+
+struct io_uring_sqe;
+struct io_uring_cqe;
+
+namespace vkb
+{
+namespace filesystem
+{
+// Reads files with io_uring, all the reads that can be in flight are submitted with a single system call
+// Uses the io_uring system calls directly, so that it does not depend on liburing
+class IoUringFileReader final : public AsyncFileReader
+{
+  public:
+	// Throws if the kernel does not support io_uring or does not allow it
+	explicit IoUringFileReader(uint32_t max_in_flight);
+
+	~IoUringFileReader() override;
+
+	void wait_idle() override;
+
+	const char *get_backend_name() const override;
+
+  protected:
+	void enqueue(Request &&request) override;
+
+  private:
+	struct Read
+	{
+		Request request;
+
+		int fd = -1;
+
+		std::vector<uint8_t> data;
+
+		size_t done = 0;
+
+		// Kept alive until the read completes
+		iovec buffer{};
+
+		// Set when the read could not be cancelled, the kernel may still write to its buffer
+		bool abandoned = false;
+	};
+
+	void run();
+
+	// Opens the file of a request, and queues its read in the submission ring
+	void start_read(uint32_t slot);
+
+	// Read with a blocking read of the filesystem instead of the ring
+	void read_with_filesystem(uint32_t slot);
+
+	// Reads a request of a broken ring with a blocking read, once no slot is left to hold it
+	void read_without_slot(Request &&request);
+
+	void queue_read(uint32_t slot);
+
+	// Processes the completion ring, partial_reads receives the slots whose read must be continued
+	void reap_completions(std::vector<uint32_t> &partial_reads);
+
+	// Takes back the reads not submitted yet, then cancels the submitted ones and waits for them
+	void fail_in_flight_reads(int error_code);
+
+	void finish_read(uint32_t slot, MappedFilePtr &&data, std::exception_ptr error);
+
+	int _ring_fd = -1;
+
+	// Rings shared with the kernel
+	void         *_ring       = nullptr;
+	size_t        _ring_size  = 0;
+	void         *_sqe_memory = nullptr;
+	size_t        _sqe_size   = 0;
+	unsigned     *_sq_head    = nullptr;
+	unsigned     *_sq_tail    = nullptr;
+	unsigned     *_sq_mask    = nullptr;
+	unsigned     *_sq_array   = nullptr;
+	io_uring_sqe *_sqes       = nullptr;
+	unsigned     *_cq_head    = nullptr;
+	unsigned     *_cq_tail    = nullptr;
+	unsigned     *_cq_mask    = nullptr;
+	io_uring_cqe *_cqes       = nullptr;
+
+	// Reads queued in the submission ring but not submitted yet
+	unsigned _to_submit = 0;
+
+	// Reads submitted or queued whose completion was not reaped yet
+	unsigned _pending_completions = 0;
+
+	// Set when the ring failed, reads are then done with blocking reads
+	bool _broken = false;
+
+	std::vector<Read> _reads;
+
+	std::vector<uint32_t> _free_slots;
+
+	std::thread _thread;
+
+	std::mutex _mutex;
+
+	std::condition_variable _request_condition;
+
+	std::condition_variable _idle_condition;
+
+	std::deque<Request> _requests;
+
+	uint32_t _in_flight = 0;
+
+	bool _stop = false;
+};
+}        // namespace filesystem
+}        // namespace vkb
+
+#endif
@@ -24,12 +24,30 @@ VKBP_DISABLE_WARNINGS()
 #include <stb_image_write.h>
 VKBP_ENABLE_WARNINGS()
 
+#include "filesystem/async_file_reader.hpp"
 #include "filesystem/filesystem.hpp"
 
+#include <cstring>
+#include <future>
+#include <mutex>
+
 namespace vkb
 {
 namespace fs
 {
+namespace
+{
+std::mutex prefetch_mutex;
+
+std::unique_ptr<filesystem::AsyncFileReader> prefetch_reader;
+
+// Prefetched files by full path, removed when they are mapped or dropped
+std::unordered_map<std::string, std::future<filesystem::MappedFilePtr>> prefetched_assets;
+
+// Files prefetched at most at once, further files are read when they are mapped
+constexpr size_t max_prefetched_assets = 256;
+}        // namespace
+
 namespace path
 {
 const std::unordered_map<Type, std::string> relative_paths = {
@@ -109,6 +127,65 @@ std::vector<uint8_t> read_asset(const std::string &filename)
 	return vkb::filesystem::get()->read_file_binary(path::get(path::Type::Assets) + filename);
 }
 
+std::shared_ptr<const filesystem::MappedFile> map_asset(const std::string &filename)
+{
+	auto path = path::get(path::Type::Assets) + filename;
+
+	std::future<filesystem::MappedFilePtr> prefetched;
+	{
+		std::lock_guard<std::mutex> lock(prefetch_mutex);
+
+		auto it = prefetched_assets.find(path);
+		if (it != prefetched_assets.end())
+		{
+			prefetched = std::move(it->second);
+			prefetched_assets.erase(it);
+		}
+	}
+
+	// A failed prefetch throws here, as the read would have
+	if (prefetched.valid())
+	{
+		return prefetched.get();
+	}
+
+	return vkb::filesystem::get()->map_file(path);
+}
+
+void prefetch_assets(const std::vector<std::string> &filenames)
+{
+	std::lock_guard<std::mutex> lock(prefetch_mutex);
+
+	if (!prefetch_reader)
+	{
+		prefetch_reader = filesystem::create_async_file_reader();
+	}
+
+	for (auto &filename : filenames)
+	{
+		if (prefetched_assets.size() >= max_prefetched_assets)
+		{
+			break;
+		}
+
+		auto path = path::get(path::Type::Assets) + filename;
+		if (prefetched_assets.find(path) == prefetched_assets.end())
+		{
+			prefetched_assets.emplace(path, prefetch_reader->submit_read(path));
+		}
+	}
+}
+
+void drop_prefetched_assets(const std::vector<std::string> &filenames)
+{
+	std::lock_guard<std::mutex> lock(prefetch_mutex);
+
+	for (auto &filename : filenames)
+	{
+		prefetched_assets.erase(path::get(path::Type::Assets) + filename);
+	}
+}
+
 std::string read_text_file(const std::string &filename)
 {
 	return vkb::filesystem::get()->read_file_string(path::get(path::Type::Shaders) + filename);
@@ -116,9 +193,11 @@ std::string read_text_file(const std::string &filename)
 
 std::vector<uint32_t> read_shader_binary_u32(const std::string &filename)
 {
-	auto buffer = vkb::filesystem::get()->read_file_binary(path::get(path::Type::Shaders) + filename);
-	assert(buffer.size() % sizeof(uint32_t) == 0);
-	auto spirv = std::vector<uint32_t>(reinterpret_cast<uint32_t *>(buffer.data()), reinterpret_cast<uint32_t *>(buffer.data()) + buffer.size() / sizeof(uint32_t));
+	// The words are copied once, straight from the mapped file
+	auto file = vkb::filesystem::get()->map_file(path::get(path::Type::Shaders) + filename);
+	assert(file->size() % sizeof(uint32_t) == 0);
+	auto spirv = std::vector<uint32_t>(file->size() / sizeof(uint32_t));
+	std::memcpy(spirv.data(), file->data(), spirv.size() * sizeof(uint32_t));
 	return spirv;
 }
 
@@ -0,0 +1,249 @@
+/* Copyright (c) 2025, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "lz4.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+namespace vkb
+{
+namespace filesystem
+{
+namespace
+{
+// Limits of the LZ4 block format
+constexpr size_t min_match        = 4;
+constexpr size_t last_literals    = 5;
+constexpr size_t match_find_limit = 12;
+constexpr size_t max_offset       = 65535;
+
+constexpr uint32_t hash_bits = 16;
+
+uint32_t read_u32(const uint8_t *data)
+{
+	uint32_t value;
+	std::memcpy(&value, data, sizeof(value));
+	return value;
+}
+
+uint32_t hash(uint32_t sequence)
+{
+	return (sequence * 2654435761u) >> (32 - hash_bits);
+}
+
+void write_length(std::vector<uint8_t> &output, size_t length)
+{
+	for (; length >= 255; length -= 255)
+	{
+		output.push_back(255);
+	}
+	output.push_back(static_cast<uint8_t>(length));
+}
+
+void write_sequence(std::vector<uint8_t> &output, const uint8_t *literals, size_t literal_count, size_t offset, size_t match_length)
+{
+	size_t match_code = match_length >= min_match ? match_length - min_match : 0;
+
+	output.push_back(static_cast<uint8_t>((std::min<size_t>(literal_count, 15) << 4) | std::min<size_t>(match_code, 15)));
+	if (literal_count >= 15)
+	{
+		write_length(output, literal_count - 15);
+	}
+	output.insert(output.end(), literals, literals + literal_count);
+
+	// The last sequence only has literals
+	if (match_length == 0)
+	{
+		return;
+	}
+
+	output.push_back(static_cast<uint8_t>(offset));
+	output.push_back(static_cast<uint8_t>(offset >> 8));
+	if (match_code >= 15)
+	{
+		write_length(output, match_code - 15);
+	}
+}
+
+// Copy in chunks of 16 bytes, writing up to 15 bytes past the end of the copy, which is much faster for short copies
+void wild_copy(uint8_t *destination, const uint8_t *source, size_t size)
+{
+	for (size_t i = 0; i < size; i += 16)
+	{
+		std::memcpy(destination + i, source + i, 16);
+	}
+}
+
+size_t read_length(std::span<const uint8_t> input, size_t &position)
+{
+	size_t  length = 0;
+	uint8_t byte;
+	do
+	{
+		if (position >= input.size())
+		{
+			throw std::runtime_error("Malformed LZ4 block: truncated length");
+		}
+		byte = input[position++];
+		length += byte;
+	} while (byte == 255);
+	return length;
+}
+}        // namespace
+
+std::vector<uint8_t> lz4_compress(std::span<const uint8_t> input)
+{
+	std::vector<uint8_t> output;
+	output.reserve(input.size() + input.size() / 255 + 16);
+
+	const uint8_t *data   = input.data();
+	size_t         size   = input.size();
+	size_t         anchor = 0;
+
+	if (size > match_find_limit)
+	{
+		std::vector<uint32_t> table(size_t{1} << hash_bits, 0);
+
+		size_t position = 1;
+		size_t misses   = 0;
+		while (position < size - match_find_limit)
+		{
+			uint32_t  sequence  = read_u32(data + position);
+			uint32_t &slot      = table[hash(sequence)];
+			size_t    candidate = slot;
+			slot                = static_cast<uint32_t>(position);
+
+			if (candidate >= position || position - candidate > max_offset || read_u32(data + candidate) != sequence)
+			{
+				// Skip faster through data that does not compress
+				position += 1 + (misses++ >> 6);
+				continue;
+			}
+			misses = 0;
+
+			// Extend the match backwards into the pending literals, then forwards
+			while (position > anchor && candidate > 0 && data[position - 1] == data[candidate - 1])
+			{
+				position--;
+				candidate--;
+			}
+
+			size_t length = min_match;
+			while (position + length < size - last_literals && data[candidate + length] == data[position + length])
+			{
+				length++;
+			}
+
+			write_sequence(output, data + anchor, position - anchor, position - candidate, length);
+
+			position += length;
+			anchor = position;
+		}
+	}
+
+	write_sequence(output, data + anchor, size - anchor, 0, 0);
+
+	return output;
+}
+
+void lz4_decompress(std::span<const uint8_t> input, std::span<uint8_t> output)
+{
+	size_t in  = 0;
+	size_t out = 0;
+
+	while (in < input.size())
+	{
+		uint8_t token = input[in++];
+
+		size_t literal_count = token >> 4;
+		if (literal_count == 15)
+		{
+			literal_count += read_length(input, in);
+		}
+		if (literal_count > input.size() - in || literal_count > output.size() - out)
+		{
+			throw std::runtime_error("Malformed LZ4 block: literals out of bounds");
+		}
+		if (literal_count + 16 <= input.size() - in && literal_count + 16 <= output.size() - out)
+		{
+			wild_copy(output.data() + out, input.data() + in, literal_count);
+		}
+		else
+		{
+			std::memcpy(output.data() + out, input.data() + in, literal_count);
+		}
+		in += literal_count;
+		out += literal_count;
+
+		if (in == input.size())
+		{
+			break;
+		}
+
+		if (input.size() - in < 2)
+		{
+			throw std::runtime_error("Malformed LZ4 block: truncated offset");
+		}
+		size_t offset = input[in] | (input[in + 1] << 8);
+		in += 2;
+		if (offset == 0 || offset > out)
+		{
+			throw std::runtime_error("Malformed LZ4 block: match offset out of bounds");
+		}
+
+		size_t match_length = token & 15;
+		if (match_length == 15)
+		{
+			match_length += read_length(input, in);
+		}
+		match_length += min_match;
+		if (match_length > output.size() - out)
+		{
+			throw std::runtime_error("Malformed LZ4 block: match out of bounds");
+		}
+
+		// Matches may overlap the bytes they produce, which repeats them
+		uint8_t       *destination = output.data() + out;
+		const uint8_t *source      = destination - offset;
+		if (offset >= 16 && match_length + 16 <= output.size() - out)
+		{
+			// Each chunk only reads bytes written by the previous chunks
+			wild_copy(destination, source, match_length);
+		}
+		else if (offset >= match_length)
+		{
+			std::memcpy(destination, source, match_length);
+		}
+		else
+		{
+			for (size_t i = 0; i < match_length; ++i)
+			{
+				destination[i] = source[i];
+			}
+		}
+		out += match_length;
+	}
+
+	if (out != output.size())
+	{
+		throw std::runtime_error("Malformed LZ4 block: unexpected uncompressed size");
+	}
+}
+}        // namespace filesystem
+}        // namespace vkb
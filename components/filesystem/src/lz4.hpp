@@ -0,0 +1,35 @@
+/* Copyright (c) 2025, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace vkb
+{
+namespace filesystem
+{
+// Compress to the LZ4 block format, which trades compression ratio for very fast decompression
+std::vector<uint8_t> lz4_compress(std::span<const uint8_t> input);
+
+// Decompress an LZ4 block, output must have the exact size of the uncompressed data
+// Throws if the block is malformed, without ever reading or writing out of bounds
+void lz4_decompress(std::span<const uint8_t> input, std::span<uint8_t> output);
+}        // namespace filesystem
+}        // namespace vkb
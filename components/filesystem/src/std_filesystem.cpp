@@ -22,10 +22,136 @@
 #include <filesystem>
 #include <fstream>
 
+#if defined(_WIN32)
+#	ifndef NOMINMAX
+#		define NOMINMAX
+#	endif
+#	ifndef WIN32_LEAN_AND_MEAN
+#		define WIN32_LEAN_AND_MEAN
+#	endif
+#	include <windows.h>
+#elif defined(__unix__) || defined(__APPLE__)
+#	include <fcntl.h>
+#	include <sys/mman.h>
+#	include <sys/stat.h>
+#	include <unistd.h>
+#	define VKB_POSIX_MMAP
+#endif
+
 namespace vkb
 {
 namespace filesystem
 {
+namespace
+{
+#if defined(_WIN32)
+class OsMappedFile final : public MappedFile
+{
+  public:
+	OsMappedFile(HANDLE mapping, const void *view, size_t size) :
+	    MappedFile(static_cast<const uint8_t *>(view), size),
+	    _mapping(mapping),
+	    _view(view)
+	{}
+
+	~OsMappedFile() override
+	{
+		UnmapViewOfFile(_view);
+		CloseHandle(_mapping);
+	}
+
+  private:
+	HANDLE      _mapping;
+	const void *_view;
+};
+
+MappedFilePtr map_os_file(const Path &path)
+{
+	HANDLE file = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+	if (file == INVALID_HANDLE_VALUE)
+	{
+		throw std::runtime_error("Failed to open file for mapping at path: " + path.string());
+	}
+
+	LARGE_INTEGER size{};
+	if (!GetFileSizeEx(file, &size) || size.QuadPart == 0)
+	{
+		CloseHandle(file);
+		return nullptr;
+	}
+
+	// The mapping keeps the file open, the file handle is not needed anymore
+	HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	CloseHandle(file);
+	if (!mapping)
+	{
+		return nullptr;
+	}
+
+	const void *view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+	if (!view)
+	{
+		CloseHandle(mapping);
+		return nullptr;
+	}
+
+	return std::make_shared<OsMappedFile>(mapping, view, static_cast<size_t>(size.QuadPart));
+}
+#elif defined(VKB_POSIX_MMAP)
+class OsMappedFile final : public MappedFile
+{
+  public:
+	OsMappedFile(void *address, size_t size) :
+	    MappedFile(static_cast<const uint8_t *>(address), size),
+	    _address(address)
+	{}
+
+	~OsMappedFile() override
+	{
+		munmap(_address, size());
+	}
+
+  private:
+	void *_address;
+};
+
+MappedFilePtr map_os_file(const Path &path)
+{
+	int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+	if (fd < 0)
+	{
+		throw std::runtime_error("Failed to open file for mapping at path: " + path.string());
+	}
+
+	struct stat file_stat;
+	if (fstat(fd, &file_stat) != 0 || !S_ISREG(file_stat.st_mode) || file_stat.st_size == 0)
+	{
+		close(fd);
+		return nullptr;
+	}
+
+	// The mapping keeps the file referenced, the descriptor is not needed anymore
+	auto  size    = static_cast<size_t>(file_stat.st_size);
+	void *address = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+	close(fd);
+	if (address == MAP_FAILED)
+	{
+		return nullptr;
+	}
+
+	// Assets are usually read from start to end, once
+	madvise(address, size, MADV_SEQUENTIAL);
+
+	return std::make_shared<OsMappedFile>(address, size);
+}
+#else
+MappedFilePtr map_os_file(const Path &)
+{
+	return nullptr;
+}
+#endif
+}        // namespace
+
 FileStat StdFileSystem::stat_file(const Path &path)
 {
 	std::error_code ec;
@@ -94,7 +220,8 @@ std::vector<uint8_t> StdFileSystem::read_chunk(const Path &path, size_t offset,
 		throw std::runtime_error("Failed to open file for reading at path: " + path.string());
 	}
 
-	auto size = stat_file(path).size;
+	// The file is opened at its end, its size is the read position
+	auto size = static_cast<size_t>(file.tellg());
 
 	if (offset + count > size)
 	{
@@ -109,6 +236,17 @@ std::vector<uint8_t> StdFileSystem::read_chunk(const Path &path, size_t offset,
 	return data;
 }
 
+MappedFilePtr StdFileSystem::map_file(const Path &path)
+{
+	// Empty files, and files the platform cannot map, are read instead
+	if (auto mapped_file = map_os_file(path))
+	{
+		return mapped_file;
+	}
+
+	return FileSystem::map_file(path);
+}
+
 void StdFileSystem::write_file(const Path &path, const std::vector<uint8_t> &data)
 {
 	// create directory if it doesn't exist
@@ -0,0 +1,127 @@
+/* Copyright (c) 2025, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "thread_pool_file_reader.hpp"
+
+namespace vkb
+{
+namespace filesystem
+{
+ThreadPoolFileReader::ThreadPoolFileReader(uint32_t thread_count)
+{
+	for (uint32_t i = 0; i < std::max(thread_count, 1u); ++i)
+	{
+		_threads.emplace_back(&ThreadPoolFileReader::run, this);
+	}
+}
+
+ThreadPoolFileReader::~ThreadPoolFileReader()
+{
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		_stop = true;
+	}
+	_request_condition.notify_all();
+
+	// Workers finish the queued requests before they stop
+	for (auto &thread : _threads)
+	{
+		thread.join();
+	}
+}
+
+void ThreadPoolFileReader::wait_idle()
+{
+	std::unique_lock<std::mutex> lock(_mutex);
+	_idle_condition.wait(lock, [this]() { return _requests.empty() && _active_count == 0; });
+}
+
+const char *ThreadPoolFileReader::get_backend_name() const
+{
+	return "thread pool";
+}
+
+void ThreadPoolFileReader::enqueue(Request &&request)
+{
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		_requests.push_back(std::move(request));
+	}
+	_request_condition.notify_one();
+}
+
+void ThreadPoolFileReader::run()
+{
+	while (true)
+	{
+		Request request;
+		{
+			std::unique_lock<std::mutex> lock(_mutex);
+			_request_condition.wait(lock, [this]() { return _stop || !_requests.empty(); });
+			if (_requests.empty())
+			{
+				return;
+			}
+
+			request = std::move(_requests.front());
+			_requests.pop_front();
+			_active_count++;
+		}
+
+		MappedFilePtr      data;
+		std::exception_ptr error;
+		try
+		{
+			data = read_blocking(request.path, request.offset, request.size);
+		}
+		catch (...)
+		{
+			error = std::current_exception();
+		}
+		request.callback(std::move(data), error);
+
+		{
+			std::lock_guard<std::mutex> lock(_mutex);
+			_active_count--;
+		}
+		_idle_condition.notify_all();
+	}
+}
+
+MappedFilePtr read_blocking(const Path &path, size_t offset, size_t size)
+{
+	auto fs = get();
+
+	if (offset == 0 && size == 0)
+	{
+		return make_mapped_file(fs->read_file_binary(path));
+	}
+
+	auto file_size = fs->stat_file(path).size;
+	if (size == 0)
+	{
+		size = offset < file_size ? file_size - offset : 0;
+	}
+	if (offset + size > file_size)
+	{
+		throw std::runtime_error("Read past the end of the file at path: " + path.string());
+	}
+
+	return make_mapped_file(fs->read_chunk(path, offset, size));
+}
+}        // namespace filesystem
+}        // namespace vkb
@@ -0,0 +1,68 @@
+/* Copyright (c) 2025, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "filesystem/async_file_reader.hpp"
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace vkb
+{
+namespace filesystem
+{
+// Reads files with blocking reads of the filesystem, one per worker thread
+class ThreadPoolFileReader final : public AsyncFileReader
+{
+  public:
+	explicit ThreadPoolFileReader(uint32_t thread_count);
+
+	~ThreadPoolFileReader() override;
+
+	void wait_idle() override;
+
+	const char *get_backend_name() const override;
+
+  protected:
+	void enqueue(Request &&request) override;
+
+  private:
+	void run();
+
+	std::vector<std::thread> _threads;
+
+	std::mutex _mutex;
+
+	std::condition_variable _request_condition;
+
+	std::condition_variable _idle_condition;
+
+	std::deque<Request> _requests;
+
+	uint32_t _active_count = 0;
+
+	bool _stop = false;
+};
+
+// Read a request with blocking reads of the filesystem
+MappedFilePtr read_blocking(const Path &path, size_t offset, size_t size);
+}        // namespace filesystem
+}        // namespace vkb
@@ -25,6 +25,7 @@
 #include "scene_graph/components/sampler.h"
 #include "scene_graph/components/sub_mesh.h"
 #include "scene_graph/components/texture.h"
+#include "upload_service.h"
 
 bool ApiVulkanSample::prepare(const vkb::ApplicationOptions &options)
 {
@@ -1009,12 +1010,6 @@ Texture ApiVulkanSample::load_texture(const std::string &file, vkb::sg::Image::C
 	texture.image = vkb::sg::Image::load(file, file, content_type);
 	texture.image->create_vk_image(get_device());
 
-	const auto &queue = get_device().get_queue_by_flags(VK_QUEUE_GRAPHICS_BIT, 0);
-
-	VkCommandBuffer command_buffer = get_device().create_command_buffer(VK_COMMAND_BUFFER_LEVEL_PRIMARY, true);
-
-	vkb::core::BufferC stage_buffer = vkb::core::BufferC::create_staging_buffer(get_device(), texture.image->get_data());
-
 	// Setup buffer copy regions for each mip level
 	std::vector<VkBufferImageCopy> bufferCopyRegions;
 
@@ -1041,31 +1036,16 @@ Texture ApiVulkanSample::load_texture(const std::string &file, vkb::sg::Image::C
 	subresource_range.levelCount              = vkb::to_u32(mipmaps.size());
 	subresource_range.layerCount              = 1;
 
-	// Image barrier for optimal image (target)
-	// Optimal image will be used as destination for the copy
-	vkb::image_layout_transition(command_buffer,
-	                             texture.image->get_vk_image().get_handle(),
-	                             VK_IMAGE_LAYOUT_UNDEFINED,
-	                             VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
-	                             subresource_range);
-
-	// Copy mip levels from staging buffer
-	vkCmdCopyBufferToImage(
-	    command_buffer,
-	    stage_buffer.get_handle(),
-	    texture.image->get_vk_image().get_handle(),
-	    VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
-	    static_cast<uint32_t>(bufferCopyRegions.size()),
-	    bufferCopyRegions.data());
-
-	// Change texture image layout to shader read after all mip levels have been copied
-	vkb::image_layout_transition(command_buffer,
-	                             texture.image->get_vk_image().get_handle(),
-	                             VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
-	                             VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
-	                             subresource_range);
-
-	get_device().flush_command_buffer(command_buffer, queue.get_handle());
+	// Copy mip levels through the staging ring and transition them to shader read, the copies are submitted without
+	// waiting for them, work submitted to the graphics queue afterwards sees the texture
+	auto &upload_service = get_device().get_upload_service();
+	upload_service.upload_image(texture.image->get_vk_image().get_handle(),
+	                            texture.image->get_format(),
+	                            subresource_range,
+	                            texture.image->get_data().data(),
+	                            texture.image->get_data().size(),
+	                            bufferCopyRegions);
+	upload_service.flush();
 
 	// Calculate valid filter and mipmap modes
 	VkFilter            filter      = VK_FILTER_LINEAR;
@@ -1105,12 +1085,6 @@ Texture ApiVulkanSample::load_texture_array(const std::string &file, vkb::sg::Im
 	texture.image = vkb::sg::Image::load(file, file, content_type);
 	texture.image->create_vk_image(get_device(), VK_IMAGE_VIEW_TYPE_2D_ARRAY);
 
-	const auto &queue = get_device().get_queue_by_flags(VK_QUEUE_GRAPHICS_BIT, 0);
-
-	VkCommandBuffer command_buffer = get_device().create_command_buffer(VK_COMMAND_BUFFER_LEVEL_PRIMARY, true);
-
-	vkb::core::BufferC stage_buffer = vkb::core::BufferC::create_staging_buffer(get_device(), texture.image->get_data());
-
 	// Setup buffer copy regions for each mip level
 	std::vector<VkBufferImageCopy> buffer_copy_regions;
 
@@ -1143,31 +1117,16 @@ Texture ApiVulkanSample::load_texture_array(const std::string &file, vkb::sg::Im
 	subresource_range.levelCount              = vkb::to_u32(mipmaps.size());
 	subresource_range.layerCount              = layers;
 
-	// Image barrier for optimal image (target)
-	// Optimal image will be used as destination for the copy
-	vkb::image_layout_transition(command_buffer,
-	                             texture.image->get_vk_image().get_handle(),
-	                             VK_IMAGE_LAYOUT_UNDEFINED,
-	                             VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
-	                             subresource_range);
-
-	// Copy mip levels from staging buffer
-	vkCmdCopyBufferToImage(
-	    command_buffer,
-	    stage_buffer.get_handle(),
-	    texture.image->get_vk_image().get_handle(),
-	    VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
-	    static_cast<uint32_t>(buffer_copy_regions.size()),
-	    buffer_copy_regions.data());
-
-	// Change texture image layout to shader read after all mip levels have been copied
-	vkb::image_layout_transition(command_buffer,
-	                             texture.image->get_vk_image().get_handle(),
-	                             VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
-	                             VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
-	                             subresource_range);
-
-	get_device().flush_command_buffer(command_buffer, queue.get_handle());
+	// Copy mip levels through the staging ring and transition them to shader read, the copies are submitted without
+	// waiting for them, work submitted to the graphics queue afterwards sees the texture
+	auto &upload_service = get_device().get_upload_service();
+	upload_service.upload_image(texture.image->get_vk_image().get_handle(),
+	                            texture.image->get_format(),
+	                            subresource_range,
+	                            texture.image->get_data().data(),
+	                            texture.image->get_data().size(),
+	                            buffer_copy_regions);
+	upload_service.flush();
 
 	// Calculate valid filter and mipmap modes
 	VkFilter            filter      = VK_FILTER_LINEAR;
@@ -1204,12 +1163,6 @@ Texture ApiVulkanSample::load_texture_cubemap(const std::string &file, vkb::sg::
 	texture.image = vkb::sg::Image::load(file, file, content_type);
 	texture.image->create_vk_image(get_device(), VK_IMAGE_VIEW_TYPE_CUBE, VK_IMAGE_CREATE_CUBE_COMPATIBLE_BIT);
 
-	const auto &queue = get_device().get_queue_by_flags(VK_QUEUE_GRAPHICS_BIT, 0);
-
-	VkCommandBuffer command_buffer = get_device().create_command_buffer(VK_COMMAND_BUFFER_LEVEL_PRIMARY, true);
-
-	vkb::core::BufferC stage_buffer = vkb::core::BufferC::create_staging_buffer(get_device(), texture.image->get_data());
-
 	// Setup buffer copy regions for each mip level
 	std::vector<VkBufferImageCopy> buffer_copy_regions;
 
@@ -1242,31 +1195,16 @@ Texture ApiVulkanSample::load_texture_cubemap(const std::string &file, vkb::sg::
 	subresource_range.levelCount              = vkb::to_u32(mipmaps.size());
 	subresource_range.layerCount              = layers;
 
-	// Image barrier for optimal image (target)
-	// Optimal image will be used as destination for the copy
-	vkb::image_layout_transition(command_buffer,
-	                             texture.image->get_vk_image().get_handle(),
-	                             VK_IMAGE_LAYOUT_UNDEFINED,
-	                             VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
-	                             subresource_range);
-
-	// Copy mip levels from staging buffer
-	vkCmdCopyBufferToImage(
-	    command_buffer,
-	    stage_buffer.get_handle(),
-	    texture.image->get_vk_image().get_handle(),
-	    VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
-	    static_cast<uint32_t>(buffer_copy_regions.size()),
-	    buffer_copy_regions.data());
-
-	// Change texture image layout to shader read after all mip levels have been copied
-	vkb::image_layout_transition(command_buffer,
-	                             texture.image->get_vk_image().get_handle(),
-	                             VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
-	                             VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
-	                             subresource_range);
-
-	get_device().flush_command_buffer(command_buffer, queue.get_handle());
+	// Copy mip levels through the staging ring and transition them to shader read, the copies are submitted without
+	// waiting for them, work submitted to the graphics queue afterwards sees the texture
+	auto &upload_service = get_device().get_upload_service();
+	upload_service.upload_image(texture.image->get_vk_image().get_handle(),
+	                            texture.image->get_format(),
+	                            subresource_range,
+	                            texture.image->get_data().data(),
+	                            texture.image->get_data().size(),
+	                            buffer_copy_regions);
+	upload_service.flush();
 
 	// Calculate valid filter and mipmap modes
 	VkFilter            filter      = VK_FILTER_LINEAR;
@@ -210,6 +210,7 @@ class ApiVulkanSample : public vkb::VulkanSampleC
 
 	/**
 	 * @brief Loads in a ktx 2D texture
+	 *        Samples loading several textures can read them all in the background first, with vkb::fs::prefetch_assets
 	 * @param file The filename of the texture to load
 	 * @param content_type The type of content in the image file
 	 */
@@ -142,6 +142,36 @@ void BufferAllocation<bindingType>::update(const T &value, uint32_t offset)
 	update(to_bytes(value), offset);
 }
 
+/**
+ * @brief Determines the alignment of sub-allocations from a buffer with the given usage
+ * @throws std::runtime_error if the usage is not supported
+ */
+inline vk::DeviceSize determine_buffer_alignment(vk::BufferUsageFlags usage, vk::PhysicalDeviceLimits const &limits)
+{
+	if (usage == vk::BufferUsageFlagBits::eUniformBuffer)
+	{
+		return limits.minUniformBufferOffsetAlignment;
+	}
+	else if (usage == vk::BufferUsageFlagBits::eStorageBuffer)
+	{
+		return limits.minStorageBufferOffsetAlignment;
+	}
+	else if (usage == vk::BufferUsageFlagBits::eUniformTexelBuffer)
+	{
+		return limits.minTexelBufferOffsetAlignment;
+	}
+	else if (usage == vk::BufferUsageFlagBits::eIndexBuffer || usage == vk::BufferUsageFlagBits::eVertexBuffer ||
+	         usage == vk::BufferUsageFlagBits::eIndirectBuffer)
+	{
+		// Used to calculate the offset, required when allocating memory (its value should be power of 2)
+		return 16;
+	}
+	else
+	{
+		throw std::runtime_error("Usage not recognised");
+	}
+}
+
 /**
  * @brief Helper class which handles multiple allocation from the same underlying Vulkan buffer.
  */
@@ -197,7 +227,12 @@ using BufferBlockCpp = BufferBlock<vkb::BindingType::Cpp>;
 
 template <vkb::BindingType bindingType>
 BufferBlock<bindingType>::BufferBlock(DeviceType &device, DeviceSizeType size, BufferUsageFlagsType usage, VmaMemoryUsage memory_usage) :
-    buffer{device, size, usage, memory_usage}
+    buffer{device,
+           vkb::core::BufferBuilderCpp(size)
+               .with_usage(usage)
+               .with_vma_usage(memory_usage)
+               .with_vma_flags(VMA_ALLOCATION_CREATE_MAPPED_BIT | VMA_ALLOCATION_CREATE_HOST_ACCESS_RANDOM_BIT)
+               .with_memory_category(vkb::allocated::MemoryCategory::Transient)}
 {
 	if constexpr (bindingType == BindingType::Cpp)
 	{
@@ -260,28 +295,7 @@ vk::DeviceSize BufferBlock<bindingType>::aligned_offset() const
 template <vkb::BindingType bindingType>
 vk::DeviceSize BufferBlock<bindingType>::determine_alignment(vk::BufferUsageFlags usage, vk::PhysicalDeviceLimits const &limits) const
 {
-	if (usage == vk::BufferUsageFlagBits::eUniformBuffer)
-	{
-		return limits.minUniformBufferOffsetAlignment;
-	}
-	else if (usage == vk::BufferUsageFlagBits::eStorageBuffer)
-	{
-		return limits.minStorageBufferOffsetAlignment;
-	}
-	else if (usage == vk::BufferUsageFlagBits::eUniformTexelBuffer)
-	{
-		return limits.minTexelBufferOffsetAlignment;
-	}
-	else if (usage == vk::BufferUsageFlagBits::eIndexBuffer || usage == vk::BufferUsageFlagBits::eVertexBuffer ||
-	         usage == vk::BufferUsageFlagBits::eIndirectBuffer)
-	{
-		// Used to calculate the offset, required when allocating memory (its value should be power of 2)
-		return 16;
-	}
-	else
-	{
-		throw std::runtime_error("Usage not recognised");
-	}
+	return determine_buffer_alignment(usage, limits);
 }
 
 /**
@@ -374,4 +388,174 @@ void BufferPool<bindingType>::reset()
 	}
 }
 
+/**
+ * @brief A linear allocator over a single persistently mapped buffer, recycled once per frame.
+ *
+ * Every recording thread owns its own ring per buffer usage, so an allocation is a bump of the head
+ * offset without lookups or locking. The ring is reset from RenderFrame::reset, after the fences
+ * of the frame have been waited on, so the GPU no longer reads any of its previous allocations.
+ *
+ * Despite its name it does not wrap around: the whole buffer is reclaimed at once on reset.
+ *
+ * Allocations that do not fit spill into overflow buffers for the rest of the frame. On the next
+ * reset the ring grows to the peak usage of that frame, so steady state frames use a single buffer.
+ * Growing destroys the previous buffers, whose handles the descriptor sets cached by the frame
+ * may refer to, so reset tells the caller when that happens.
+ */
+template <vkb::BindingType bindingType>
+class TransientBufferRing
+{
+  public:
+	using BufferUsageFlagsType = typename std::conditional<bindingType == vkb::BindingType::Cpp, vk::BufferUsageFlags, VkBufferUsageFlags>::type;
+	using DeviceSizeType       = typename std::conditional<bindingType == vkb::BindingType::Cpp, vk::DeviceSize, VkDeviceSize>::type;
+
+	using DeviceType = typename std::conditional<bindingType == vkb::BindingType::Cpp, vkb::core::HPPDevice, vkb::Device>::type;
+
+  public:
+	TransientBufferRing(DeviceType &device, DeviceSizeType initial_size, BufferUsageFlagsType usage, VmaMemoryUsage memory_usage = VMA_MEMORY_USAGE_CPU_TO_GPU);
+
+	TransientBufferRing(TransientBufferRing const &)            = delete;
+	TransientBufferRing(TransientBufferRing &&)                 = default;
+	TransientBufferRing &operator=(TransientBufferRing const &) = delete;
+	TransientBufferRing &operator=(TransientBufferRing &&)      = delete;
+
+	/**
+	 * @return An usable view on a portion of the ring, valid until the next reset
+	 */
+	BufferAllocation<bindingType> allocate(DeviceSizeType size);
+
+	/**
+	 * @return The size of the ring buffer
+	 */
+	DeviceSizeType get_capacity() const;
+
+	/**
+	 * @return The largest number of bytes allocated within a single frame
+	 */
+	DeviceSizeType get_peak_usage() const;
+
+	/**
+	 * @brief Reclaims all allocations, must only be called once the GPU finished using them
+	 * @return Whether buffers were destroyed to grow the ring, so that descriptor sets referring to them must be dropped
+	 */
+	bool reset();
+
+  private:
+	vkb::BufferAllocationCpp allocate_impl(vk::DeviceSize size);
+	vkb::BufferAllocationCpp allocate_overflow(vk::DeviceSize size);
+
+  private:
+	vkb::core::HPPDevice                              &device;
+	vk::BufferUsageFlags                               usage;
+	VmaMemoryUsage                                     memory_usage{};
+	vk::DeviceSize                                     alignment = 0;
+	vk::DeviceSize                                     capacity  = 0;        /// Size of the ring, the buffer is only created on the first allocation
+	std::unique_ptr<vkb::core::BufferCpp>              buffer;
+	vk::DeviceSize                                     head = 0;        /// Offset of the next allocation within the ring
+	std::vector<std::unique_ptr<vkb::core::BufferCpp>> overflow_buffers;
+	vk::DeviceSize                                     overflow_head  = 0;        /// Offset of the next allocation within the last overflow buffer
+	vk::DeviceSize                                     overflow_usage = 0;        /// Bytes allocated from the overflow buffers in the current frame
+	vk::DeviceSize                                     peak_usage     = 0;
+};
+
+using TransientBufferRingC   = TransientBufferRing<vkb::BindingType::C>;
+using TransientBufferRingCpp = TransientBufferRing<vkb::BindingType::Cpp>;
+
+template <vkb::BindingType bindingType>
+TransientBufferRing<bindingType>::TransientBufferRing(DeviceType &device, DeviceSizeType initial_size, BufferUsageFlagsType usage, VmaMemoryUsage memory_usage) :
+    device{reinterpret_cast<vkb::core::HPPDevice &>(device)}, usage{usage}, memory_usage{memory_usage}, capacity{initial_size}
+{
+	alignment = determine_buffer_alignment(this->usage, this->device.get_gpu().get_properties().limits);
+}
+
+template <vkb::BindingType bindingType>
+BufferAllocation<bindingType> TransientBufferRing<bindingType>::allocate(DeviceSizeType size)
+{
+	if constexpr (bindingType == vkb::BindingType::Cpp)
+	{
+		return allocate_impl(size);
+	}
+	else
+	{
+		vkb::BufferAllocationCpp buffer_allocation = allocate_impl(static_cast<vk::DeviceSize>(size));
+		return *reinterpret_cast<vkb::BufferAllocationC *>(&buffer_allocation);
+	}
+}
+
+template <vkb::BindingType bindingType>
+vkb::BufferAllocationCpp TransientBufferRing<bindingType>::allocate_impl(vk::DeviceSize size)
+{
+	assert(size > 0 && "Allocation size must be greater than zero");
+
+	vk::DeviceSize aligned = (head + alignment - 1) & ~(alignment - 1);
+	if (buffer && aligned + size <= capacity)
+	{
+		head = aligned + size;
+		return vkb::BufferAllocationCpp{*buffer, size, aligned};
+	}
+
+	if (!buffer && size <= capacity)
+	{
+		vkb::allocated::MemoryCategoryScope memory_category{vkb::allocated::MemoryCategory::Transient};
+		buffer = std::make_unique<vkb::core::BufferCpp>(device, capacity, usage, memory_usage);
+		head   = size;
+		return vkb::BufferAllocationCpp{*buffer, size, 0};
+	}
+
+	return allocate_overflow(size);
+}
+
+template <vkb::BindingType bindingType>
+vkb::BufferAllocationCpp TransientBufferRing<bindingType>::allocate_overflow(vk::DeviceSize size)
+{
+	vk::DeviceSize aligned = (overflow_head + alignment - 1) & ~(alignment - 1);
+	if (overflow_buffers.empty() || aligned + size > overflow_buffers.back()->get_size())
+	{
+		LOGD("Transient {} ring of {} bytes overflowed, spilling into a new buffer", vk::to_string(usage), capacity);
+
+		vkb::allocated::MemoryCategoryScope memory_category{vkb::allocated::MemoryCategory::Transient};
+
+		overflow_buffers.push_back(std::make_unique<vkb::core::BufferCpp>(device, std::max(capacity, size), usage, memory_usage));
+		aligned = 0;
+	}
+
+	overflow_head = aligned + size;
+	overflow_usage += size + alignment;
+	return vkb::BufferAllocationCpp{*overflow_buffers.back(), size, aligned};
+}
+
+template <vkb::BindingType bindingType>
+typename TransientBufferRing<bindingType>::DeviceSizeType TransientBufferRing<bindingType>::get_capacity() const
+{
+	return capacity;
+}
+
+template <vkb::BindingType bindingType>
+typename TransientBufferRing<bindingType>::DeviceSizeType TransientBufferRing<bindingType>::get_peak_usage() const
+{
+	return peak_usage;
+}
+
+template <vkb::BindingType bindingType>
+bool TransientBufferRing<bindingType>::reset()
+{
+	vk::DeviceSize frame_usage = head + overflow_usage;
+	peak_usage                 = std::max(peak_usage, frame_usage);
+
+	bool grown = !overflow_buffers.empty();
+	if (grown)
+	{
+		// Grow with some headroom, the new buffer gets created on the next allocation
+		capacity = (frame_usage + frame_usage / 2 + alignment - 1) & ~(alignment - 1);
+		buffer.reset();
+		overflow_buffers.clear();
+	}
+
+	head           = 0;
+	overflow_head  = 0;
+	overflow_usage = 0;
+
+	return grown;
+}
+
 }        // namespace vkb
@@ -19,6 +19,7 @@
 #pragma once
 
 #include "common/vk_common.h"
+#include "core/memory_category.h"
 #include "vulkan_type_mapping.h"
 #include <vulkan/vulkan.hpp>
 
@@ -85,6 +86,7 @@ class BuilderBase
 	std::string const             &get_debug_name() const;
 	BuilderType                   &with_debug_name(const std::string &name);
 	BuilderType                   &with_implicit_sharing_mode();
+	BuilderType                   &with_memory_category(MemoryCategory category);
 	BuilderType                   &with_memory_type_bits(uint32_t type_bits);
 	BuilderType                   &with_queue_families(uint32_t count, const uint32_t *family_indices);
 	BuilderType                   &with_queue_families(std::vector<uint32_t> const &queue_families);
@@ -175,6 +177,13 @@ inline BuilderType &BuilderBase<bindingType, BuilderType, CreateInfoType>::with_
 	return *static_cast<BuilderType *>(this);
 }
 
+template <vkb::BindingType bindingType, typename BuilderType, typename CreateInfoType>
+inline BuilderType &BuilderBase<bindingType, BuilderType, CreateInfoType>::with_memory_category(MemoryCategory category)
+{
+	set_memory_category(alloc_create_info, category);
+	return *static_cast<BuilderType *>(this);
+}
+
 template <vkb::BindingType bindingType, typename BuilderType, typename CreateInfoType>
 inline BuilderType &BuilderBase<bindingType, BuilderType, CreateInfoType>::with_memory_type_bits(uint32_t type_bits)
 {
@@ -376,6 +376,11 @@ T &request_resource(vkb::core::HPPDevice &device, vkb::HPPResourceRecord *record
 	const char *res_type = typeid(T).name();
 	size_t      res_id   = resources.size();
 
+	PROFILE_SCOPE_DETAIL("Resource cache miss", res_type);
+
+	static const vkb::Counter cache_misses{"Resource cache misses"};
+	cache_misses.add();
+
 	LOGD("Building #{} cache object ({})", res_id, res_type);
 
 // Only error handle in release
@@ -0,0 +1,97 @@
+/* Copyright (c) 2025, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "common/parallel.h"
+
+#include <algorithm>
+#include <exception>
+#include <future>
+#include <thread>
+#include <vector>
+
+#include <ctpl_stl.h>
+
+namespace vkb
+{
+namespace
+{
+// Set on the threads of the shared pool, whose jobs must not wait for other jobs of the pool
+thread_local bool is_worker_thread = false;
+}        // namespace
+
+ctpl::thread_pool &get_thread_pool()
+{
+	static ctpl::thread_pool thread_pool{static_cast<int>(std::max(1u, std::thread::hardware_concurrency()))};
+	return thread_pool;
+}
+
+void parallel_for(size_t count, size_t thread_count, size_t min_per_job, const std::function<void(size_t begin, size_t end)> &function)
+{
+	if (count == 0)
+	{
+		return;
+	}
+
+	size_t job_count = 0;
+	if (thread_count > 1 && !is_worker_thread)
+	{
+		auto &thread_pool = get_thread_pool();
+		job_count         = std::min(std::min(thread_count, static_cast<size_t>(thread_pool.size())) * 4, count / std::max<size_t>(min_per_job, 1));
+	}
+	if (job_count <= 1)
+	{
+		function(size_t{0}, count);
+		return;
+	}
+
+	std::vector<std::future<void>> futures;
+	futures.reserve(job_count);
+
+	size_t per_job = (count + job_count - 1) / job_count;
+	for (size_t begin = 0; begin < count; begin += per_job)
+	{
+		size_t end = std::min(count, begin + per_job);
+		futures.push_back(get_thread_pool().push([&function, begin, end](size_t) {
+			is_worker_thread = true;
+			function(begin, end);
+		}));
+	}
+
+	// Every job refers to the function, so all of them must finish before an exception leaves this frame
+	std::exception_ptr exception;
+	for (auto &future : futures)
+	{
+		try
+		{
+			future.get();
+		}
+		catch (...)
+		{
+			if (!exception)
+			{
+				exception = std::current_exception();
+			}
+		}
+	}
+
+	if (exception)
+	{
+		std::rethrow_exception(exception);
+	}
+}
+}        // namespace vkb
@@ -0,0 +1,47 @@
+/* Copyright (c) 2025, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#pragma once
+
+#include <cstddef>
+#include <functional>
+
+namespace ctpl
+{
+class thread_pool;
+}
+
+namespace vkb
+{
+/**
+ * @brief The worker threads shared by the CPU work of the framework, one per hardware thread, created on first use
+ */
+ctpl::thread_pool &get_thread_pool();
+
+/**
+ * @brief Runs the function over ranges of [0, count) on the shared worker threads, and waits for all of them
+ *
+ * A few ranges are made per thread, so that threads finishing early pick up the remaining work. With a single
+ * thread, or when called from a worker thread, the function runs over the whole range on the calling thread.
+ * If any range throws, the first exception is rethrown once all ranges have finished.
+ *
+ * @param thread_count Threads to spread the ranges over, bounded by the size of the shared pool
+ * @param min_per_job Ranges are not split below this many indices
+ */
+void parallel_for(size_t count, size_t thread_count, size_t min_per_job, const std::function<void(size_t begin, size_t end)> &function);
+}        // namespace vkb
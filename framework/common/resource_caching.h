@@ -27,6 +27,7 @@
 #include "resource_record.h"
 
 #include "common/helpers.h"
+#include <core/util/profiling.hpp>
 
 namespace std
 {
@@ -743,6 +744,11 @@ T &request_resource(Device &device, ResourceRecord *recorder, std::unordered_map
 	const char *res_type = typeid(T).name();
 	size_t      res_id   = resources.size();
 
+	PROFILE_SCOPE_DETAIL("Resource cache miss", res_type);
+
+	static const vkb::Counter cache_misses{"Resource cache misses"};
+	cache_misses.add();
+
 	LOGD("Building #{} cache object ({})", res_id, res_type);
 
 // Only error handle in release
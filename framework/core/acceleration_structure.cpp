@@ -17,6 +17,8 @@
 
 #include "acceleration_structure.h"
 
+#include <algorithm>
+
 #include "device.h"
 
 namespace vkb
@@ -32,6 +34,11 @@ AccelerationStructure::AccelerationStructure(Device                        &devi
 
 AccelerationStructure::~AccelerationStructure()
 {
+	for (auto &retired : retired_handles)
+	{
+		vkDestroyAccelerationStructureKHR(device.get_handle(), retired.handle, nullptr);
+	}
+
 	if (handle != VK_NULL_HANDLE)
 	{
 		vkDestroyAccelerationStructureKHR(device.get_handle(), handle, nullptr);
@@ -66,7 +73,7 @@ uint64_t AccelerationStructure::add_triangle_geometry(vkb::core::BufferC &vertex
 	geometry.geometry.triangles.transformData.deviceAddress = transform_buffer_data_address == 0 ? transform_buffer.get_device_address() : transform_buffer_data_address;
 
 	uint64_t index = geometries.size();
-	geometries.insert({index, {geometry, triangle_count, transform_offset}});
+	geometries.push_back({geometry, triangle_count, transform_offset});
 	return index;
 }
 
@@ -81,6 +88,8 @@ void AccelerationStructure::update_triangle_geometry(uint64_t
                                                      uint64_t index_buffer_data_address,
                                                      uint64_t transform_buffer_data_address)
 {
+	assert(triangleUUID < geometries.size());
+
 	VkAccelerationStructureGeometryKHR *geometry             = &geometries[triangleUUID].geometry;
 	geometry->sType                                          = VK_STRUCTURE_TYPE_ACCELERATION_STRUCTURE_GEOMETRY_KHR;
 	geometry->geometryType                                   = VK_GEOMETRY_TYPE_TRIANGLES_KHR;
@@ -109,7 +118,7 @@ uint64_t AccelerationStructure::add_instance_geometry(std::unique_ptr<vkb::core:
 	geometry.geometry.instances.data.deviceAddress = instance_buffer->get_device_address();
 
 	uint64_t index = geometries.size();
-	geometries.insert({index, {geometry, instance_count, transform_offset}});
+	geometries.push_back({geometry, instance_count, transform_offset});
 	return index;
 }
 
@@ -118,6 +127,8 @@ void AccelerationStructure::update_instance_geometry(uint64_t
                                                      uint32_t instance_count, uint32_t transform_offset,
                                                      VkGeometryFlagsKHR flags)
 {
+	assert(instance_UID < geometries.size());
+
 	VkAccelerationStructureGeometryKHR *geometry    = &geometries[instance_UID].geometry;
 	geometry->sType                                 = VK_STRUCTURE_TYPE_ACCELERATION_STRUCTURE_GEOMETRY_KHR;
 	geometry->geometryType                          = VK_GEOMETRY_TYPE_INSTANCES_KHR;
@@ -131,31 +142,58 @@ void AccelerationStructure::update_instance_geometry(uint64_t
 }
 
 void AccelerationStructure::build(VkQueue queue, VkBuildAccelerationStructureFlagsKHR flags, VkBuildAccelerationStructureModeKHR mode)
+{
+	VkDeviceSize scratch_size = prepare_build(flags, mode);
+
+	// Create a scratch buffer as a temporary storage for the acceleration structure build
+	if (!scratch_buffer || scratch_buffer->get_size() < scratch_size)
+	{
+		scratch_buffer = std::make_unique<vkb::core::BufferC>(
+		    device,
+		    scratch_size,
+		    VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT,
+		    VMA_MEMORY_USAGE_GPU_ONLY);
+	}
+
+	// Build the acceleration structure on the device via a one-time command buffer submission
+	VkCommandBuffer command_buffer = device.create_command_buffer(VK_COMMAND_BUFFER_LEVEL_PRIMARY, true);
+	record_build(command_buffer, scratch_buffer->get_device_address());
+	device.flush_command_buffer(command_buffer, queue);
+	destroy_retired_handles();
+
+	// Structures that can be updated keep their scratch buffer, as they are usually updated every frame
+	if (!(flags & VK_BUILD_ACCELERATION_STRUCTURE_ALLOW_UPDATE_BIT_KHR))
+	{
+		scratch_buffer.reset();
+	}
+}
+
+VkDeviceSize AccelerationStructure::prepare_build(VkBuildAccelerationStructureFlagsKHR flags, VkBuildAccelerationStructureModeKHR mode)
 {
 	assert(!geometries.empty());
 
-	std::vector<VkAccelerationStructureGeometryKHR>       acceleration_structure_geometries;
-	std::vector<VkAccelerationStructureBuildRangeInfoKHR> acceleration_structure_build_range_infos;
-	std::vector<uint32_t>                                 primitive_counts;
+	build_geometries.clear();
+	build_range_infos.clear();
+	std::vector<uint32_t> primitive_counts;
 	for (auto &geometry : geometries)
 	{
-		if (mode == VK_BUILD_ACCELERATION_STRUCTURE_MODE_UPDATE_KHR && !geometry.second.updated)
+		if (mode == VK_BUILD_ACCELERATION_STRUCTURE_MODE_UPDATE_KHR && !geometry.updated)
 		{
 			continue;
 		}
-		acceleration_structure_geometries.push_back(geometry.second.geometry);
+		build_geometries.push_back(geometry.geometry);
 		// Infer build range info from geometry
 		VkAccelerationStructureBuildRangeInfoKHR build_range_info;
-		build_range_info.primitiveCount  = geometry.second.primitive_count;
+		build_range_info.primitiveCount  = geometry.primitive_count;
 		build_range_info.primitiveOffset = 0;
 		build_range_info.firstVertex     = 0;
-		build_range_info.transformOffset = geometry.second.transform_offset;
-		acceleration_structure_build_range_infos.push_back(build_range_info);
-		primitive_counts.push_back(geometry.second.primitive_count);
-		geometry.second.updated = false;
+		build_range_info.transformOffset = geometry.transform_offset;
+		build_range_infos.push_back(build_range_info);
+		primitive_counts.push_back(geometry.primitive_count);
+		geometry.updated = false;
 	}
 
-	VkAccelerationStructureBuildGeometryInfoKHR build_geometry_info{};
+	build_geometry_info       = {};
 	build_geometry_info.sType = VK_STRUCTURE_TYPE_ACCELERATION_STRUCTURE_BUILD_GEOMETRY_INFO_KHR;
 	build_geometry_info.type  = type;
 	build_geometry_info.flags = flags;
@@ -163,10 +201,9 @@ void AccelerationStructure::build(VkQueue queue, VkBuildAccelerationStructureFla
 	if (mode == VK_BUILD_ACCELERATION_STRUCTURE_MODE_UPDATE_KHR && handle != VK_NULL_HANDLE)
 	{
 		build_geometry_info.srcAccelerationStructure = handle;
-		build_geometry_info.dstAccelerationStructure = handle;
 	}
-	build_geometry_info.geometryCount = static_cast<uint32_t>(acceleration_structure_geometries.size());
-	build_geometry_info.pGeometries   = acceleration_structure_geometries.data();
+	build_geometry_info.geometryCount = static_cast<uint32_t>(build_geometries.size());
+	build_geometry_info.pGeometries   = build_geometries.data();
 
 	// Get required build sizes
 	build_sizes_info.sType = VK_STRUCTURE_TYPE_ACCELERATION_STRUCTURE_BUILD_SIZES_INFO_KHR;
@@ -177,54 +214,77 @@ void AccelerationStructure::build(VkQueue queue, VkBuildAccelerationStructureFla
 	    primitive_counts.data(),
 	    &build_sizes_info);
 
-	// Create a buffer for the acceleration structure
-	if (!buffer || buffer->get_size() != build_sizes_info.accelerationStructureSize)
+	// A build needs a structure of the exact size, as a compacted structure is too small to be rebuilt.
+	// An update is done in place.
+	bool is_update = build_geometry_info.srcAccelerationStructure != VK_NULL_HANDLE;
+	if (!buffer || (!is_update && buffer->get_size() != build_sizes_info.accelerationStructureSize))
 	{
-		buffer = std::make_unique<vkb::core::BufferC>(
-		    device,
-		    build_sizes_info.accelerationStructureSize,
-		    VK_BUFFER_USAGE_ACCELERATION_STRUCTURE_STORAGE_BIT_KHR | VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT,
-		    VMA_MEMORY_USAGE_GPU_ONLY);
-
-		VkAccelerationStructureCreateInfoKHR acceleration_structure_create_info{};
-		acceleration_structure_create_info.sType  = VK_STRUCTURE_TYPE_ACCELERATION_STRUCTURE_CREATE_INFO_KHR;
-		acceleration_structure_create_info.buffer = buffer->get_handle();
-		acceleration_structure_create_info.size   = build_sizes_info.accelerationStructureSize;
-		acceleration_structure_create_info.type   = type;
-		VkResult result                           = vkCreateAccelerationStructureKHR(device.get_handle(), &acceleration_structure_create_info, nullptr, &handle);
-
-		if (result != VK_SUCCESS)
-		{
-			throw VulkanException{result, "Could not create acceleration structure"};
-		}
+		create_handle(build_sizes_info.accelerationStructureSize);
 	}
 
-	// Get the acceleration structure's handle
-	VkAccelerationStructureDeviceAddressInfoKHR acceleration_device_address_info{};
-	acceleration_device_address_info.sType                 = VK_STRUCTURE_TYPE_ACCELERATION_STRUCTURE_DEVICE_ADDRESS_INFO_KHR;
-	acceleration_device_address_info.accelerationStructure = handle;
-	device_address                                         = vkGetAccelerationStructureDeviceAddressKHR(device.get_handle(), &acceleration_device_address_info);
+	build_geometry_info.dstAccelerationStructure = handle;
+	build_flags                                  = flags;
 
-	// Create a scratch buffer as a temporary storage for the acceleration structure build
-	scratch_buffer = std::make_unique<vkb::core::BufferC>(
-	    device,
-	    build_sizes_info.buildScratchSize,
-	    VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT,
-	    VMA_MEMORY_USAGE_GPU_ONLY);
+	return is_update ? build_sizes_info.updateScratchSize : build_sizes_info.buildScratchSize;
+}
 
-	build_geometry_info.scratchData.deviceAddress = scratch_buffer->get_device_address();
-	build_geometry_info.dstAccelerationStructure  = handle;
+void AccelerationStructure::record_build(VkCommandBuffer command_buffer, VkDeviceAddress scratch_address)
+{
+	build_geometry_info.scratchData.deviceAddress = scratch_address;
 
-	// Build the acceleration structure on the device via a one-time command buffer submission
-	VkCommandBuffer command_buffer       = device.create_command_buffer(VK_COMMAND_BUFFER_LEVEL_PRIMARY, true);
-	auto            as_build_range_infos = &*acceleration_structure_build_range_infos.data();
+	auto as_build_range_infos = build_range_infos.data();
 	vkCmdBuildAccelerationStructuresKHR(
 	    command_buffer,
 	    1,
 	    &build_geometry_info,
 	    &as_build_range_infos);
-	device.flush_command_buffer(command_buffer, queue);
-	scratch_buffer.reset();
+}
+
+void AccelerationStructure::create_handle(VkDeviceSize size)
+{
+	// Frames in flight and the build or copy about to be recorded may still read the previous structure
+	if (handle != VK_NULL_HANDLE)
+	{
+		retired_handles.push_back({handle, std::move(buffer), frames_in_flight});
+		handle = VK_NULL_HANDLE;
+	}
+
+	// Create a buffer for the acceleration structure
+	buffer = std::make_unique<vkb::core::BufferC>(
+	    device,
+	    size,
+	    VK_BUFFER_USAGE_ACCELERATION_STRUCTURE_STORAGE_BIT_KHR | VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT,
+	    VMA_MEMORY_USAGE_GPU_ONLY);
+
+	VkAccelerationStructureCreateInfoKHR acceleration_structure_create_info{};
+	acceleration_structure_create_info.sType  = VK_STRUCTURE_TYPE_ACCELERATION_STRUCTURE_CREATE_INFO_KHR;
+	acceleration_structure_create_info.buffer = buffer->get_handle();
+	acceleration_structure_create_info.size   = size;
+	acceleration_structure_create_info.type   = type;
+	VkResult result                           = vkCreateAccelerationStructureKHR(device.get_handle(), &acceleration_structure_create_info, nullptr, &handle);
+
+	if (result != VK_SUCCESS)
+	{
+		throw VulkanException{result, "Could not create acceleration structure"};
+	}
+
+	// Get the acceleration structure's handle
+	VkAccelerationStructureDeviceAddressInfoKHR acceleration_device_address_info{};
+	acceleration_device_address_info.sType                 = VK_STRUCTURE_TYPE_ACCELERATION_STRUCTURE_DEVICE_ADDRESS_INFO_KHR;
+	acceleration_device_address_info.accelerationStructure = handle;
+	device_address                                         = vkGetAccelerationStructureDeviceAddressKHR(device.get_handle(), &acceleration_device_address_info);
+}
+
+void AccelerationStructure::destroy_retired_handles()
+{
+	std::erase_if(retired_handles, [this](RetiredHandle &retired) {
+		if (retired.frames_left > 0)
+		{
+			return false;
+		}
+		vkDestroyAccelerationStructureKHR(device.get_handle(), retired.handle, nullptr);
+		return true;
+	});
 }
 
 VkAccelerationStructureKHR AccelerationStructure::get_handle() const
@@ -242,5 +302,25 @@ uint64_t AccelerationStructure::get_device_address() const
 	return device_address;
 }
 
+VkBuildAccelerationStructureFlagsKHR AccelerationStructure::get_build_flags() const
+{
+	return build_flags;
+}
+
+void AccelerationStructure::set_frames_in_flight(uint32_t count)
+{
+	frames_in_flight = count;
+}
+
+void AccelerationStructure::end_frame()
+{
+	for (auto &retired : retired_handles)
+	{
+		retired.frames_left -= std::min(retired.frames_left, 1u);
+	}
+
+	destroy_retired_handles();
+}
+
 }        // namespace core
 }        // namespace vkb
\ No newline at end of file
@@ -27,6 +27,8 @@ class Device;
 
 namespace core
 {
+class AccelerationStructureBuilder;
+
 /**
  * @brief Wraps setup and access for a ray tracing top- or bottom-level acceleration structure
  */
@@ -107,6 +109,8 @@ class AccelerationStructure
 
 	/**
 	 * @brief Builds the acceleration structure on the device (requires at least one geometry to be added)
+	 *        Structures built with VK_BUILD_ACCELERATION_STRUCTURE_ALLOW_UPDATE_BIT_KHR keep their scratch buffer for the next update.
+	 *        To build many structures at once, with a shared scratch buffer and compaction, use an AccelerationStructureBuilder.
 	 * @param queue Queue to use for the build process
 	 * @param flags Build flags
 	 * @param mode Build mode (build or update)
@@ -121,6 +125,19 @@ class AccelerationStructure
 
 	uint64_t get_device_address() const;
 
+	VkBuildAccelerationStructureFlagsKHR get_build_flags() const;
+
+	/**
+	 * @brief Sets how many calls to end_frame() a structure replaced by a rebuild or a compaction outlives,
+	 *        as frames in flight may still trace against it. With 0, it is destroyed once the build is done.
+	 */
+	void set_frames_in_flight(uint32_t count);
+
+	/**
+	 * @brief Destroys the replaced structures that no frame in flight can use anymore, called once per frame
+	 */
+	void end_frame();
+
 	vkb::core::BufferC *get_buffer() const
 	{
 		return buffer.get();
@@ -132,6 +149,30 @@ class AccelerationStructure
 	}
 
   private:
+	friend class AccelerationStructureBuilder;
+
+	/**
+	 * @brief Fills the build info of the geometries, and creates the acceleration structure if a build needs a new one
+	 * @returns The scratch size needed by the build
+	 */
+	VkDeviceSize prepare_build(VkBuildAccelerationStructureFlagsKHR flags, VkBuildAccelerationStructureModeKHR mode);
+
+	/**
+	 * @brief Records the build prepared by prepare_build
+	 * @param scratch_address Device address of scratch memory of at least the size returned by prepare_build
+	 */
+	void record_build(VkCommandBuffer command_buffer, VkDeviceAddress scratch_address);
+
+	/**
+	 * @brief Replaces the acceleration structure and its buffer with new ones of the given size, retiring the old ones
+	 */
+	void create_handle(VkDeviceSize size);
+
+	/**
+	 * @brief Destroys the retired structures that outlived the frames in flight
+	 */
+	void destroy_retired_handles();
+
 	Device &device;
 
 	VkAccelerationStructureKHR handle{VK_NULL_HANDLE};
@@ -142,6 +183,8 @@ class AccelerationStructure
 
 	VkAccelerationStructureBuildSizesInfoKHR build_sizes_info{};
 
+	VkBuildAccelerationStructureFlagsKHR build_flags{0};
+
 	struct Geometry
 	{
 		VkAccelerationStructureGeometryKHR geometry{};
@@ -152,9 +195,33 @@ class AccelerationStructure
 
 	std::unique_ptr<vkb::core::BufferC> scratch_buffer;
 
-	std::map<uint64_t, Geometry> geometries{};
+	/// Geometries indexed by the UUID returned when adding them
+	std::vector<Geometry> geometries{};
+
+	/// State of the build between prepare_build and record_build
+	VkAccelerationStructureBuildGeometryInfoKHR build_geometry_info{};
+
+	std::vector<VkAccelerationStructureGeometryKHR> build_geometries;
+
+	std::vector<VkAccelerationStructureBuildRangeInfoKHR> build_range_infos;
 
 	std::unique_ptr<vkb::core::BufferC> buffer{nullptr};
+
+	/**
+	 * @brief A structure replaced by a rebuild or a compaction, kept while frames in flight may use it
+	 */
+	struct RetiredHandle
+	{
+		VkAccelerationStructureKHR handle;
+
+		std::unique_ptr<vkb::core::BufferC> buffer;
+
+		uint32_t frames_left;
+	};
+
+	std::vector<RetiredHandle> retired_handles;
+
+	uint32_t frames_in_flight{0};
 };
 }        // namespace core
 }        // namespace vkb
\ No newline at end of file
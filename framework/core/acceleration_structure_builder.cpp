@@ -0,0 +1,281 @@
+/* Copyright (c) 2025, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "acceleration_structure_builder.h"
+
+#include <algorithm>
+
+#include "acceleration_structure.h"
+#include "core/util/logging.hpp"
+#include "device.h"
+
+namespace vkb
+{
+namespace core
+{
+namespace
+{
+VkDeviceSize align_up(VkDeviceSize value, VkDeviceSize alignment)
+{
+	return (value + alignment - 1) / alignment * alignment;
+}
+
+/**
+ * @brief Makes the writes of previous builds visible to the next builds and queries, as they share scratch memory
+ */
+void record_build_barrier(VkCommandBuffer command_buffer)
+{
+	VkMemoryBarrier barrier{VK_STRUCTURE_TYPE_MEMORY_BARRIER};
+	barrier.srcAccessMask = VK_ACCESS_ACCELERATION_STRUCTURE_WRITE_BIT_KHR;
+	barrier.dstAccessMask = VK_ACCESS_ACCELERATION_STRUCTURE_READ_BIT_KHR | VK_ACCESS_ACCELERATION_STRUCTURE_WRITE_BIT_KHR;
+	vkCmdPipelineBarrier(command_buffer,
+	                     VK_PIPELINE_STAGE_ACCELERATION_STRUCTURE_BUILD_BIT_KHR,
+	                     VK_PIPELINE_STAGE_ACCELERATION_STRUCTURE_BUILD_BIT_KHR,
+	                     0, 1, &barrier, 0, nullptr, 0, nullptr);
+}
+}        // namespace
+
+AccelerationStructureBuilder::AccelerationStructureBuilder(Device &device, VkDeviceSize scratch_budget) :
+    device{device},
+    scratch_budget{scratch_budget}
+{
+	VkPhysicalDeviceAccelerationStructurePropertiesKHR acceleration_structure_properties{VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_ACCELERATION_STRUCTURE_PROPERTIES_KHR};
+	VkPhysicalDeviceProperties2                        device_properties{VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2};
+	device_properties.pNext = &acceleration_structure_properties;
+	vkGetPhysicalDeviceProperties2(device.get_gpu().get_handle(), &device_properties);
+
+	scratch_alignment = std::max<VkDeviceSize>(acceleration_structure_properties.minAccelerationStructureScratchOffsetAlignment, 1);
+}
+
+void AccelerationStructureBuilder::add_build(AccelerationStructure &acceleration_structure, VkBuildAccelerationStructureFlagsKHR flags)
+{
+	pending_builds.push_back({&acceleration_structure, flags, VK_BUILD_ACCELERATION_STRUCTURE_MODE_BUILD_KHR});
+}
+
+void AccelerationStructureBuilder::add_refit(AccelerationStructure &acceleration_structure)
+{
+	if (acceleration_structure.get_handle() == VK_NULL_HANDLE ||
+	    !(acceleration_structure.get_build_flags() & VK_BUILD_ACCELERATION_STRUCTURE_ALLOW_UPDATE_BIT_KHR))
+	{
+		throw std::runtime_error("Only acceleration structures built with VK_BUILD_ACCELERATION_STRUCTURE_ALLOW_UPDATE_BIT_KHR can be refit");
+	}
+
+	// An update must use the flags of the build that created the structure
+	pending_builds.push_back({&acceleration_structure, acceleration_structure.get_build_flags(), VK_BUILD_ACCELERATION_STRUCTURE_MODE_UPDATE_KHR});
+}
+
+const AccelerationStructureBuildStatistics &AccelerationStructureBuilder::build(VkQueue queue)
+{
+	statistics = {};
+
+	if (pending_builds.empty())
+	{
+		return statistics;
+	}
+
+	// Bottom-level structures are built first, top-level builds read them through their instances
+	std::stable_partition(pending_builds.begin(), pending_builds.end(), [](const PendingBuild &pending_build) {
+		return pending_build.acceleration_structure->type == VK_ACCELERATION_STRUCTURE_TYPE_BOTTOM_LEVEL_KHR;
+	});
+
+	// Prepare all the builds first, as preparing a build may create the structure it writes to
+	std::vector<VkDeviceSize>            scratch_sizes;
+	std::vector<AccelerationStructure *> compacted;
+	VkDeviceSize                         total_scratch_size   = 0;
+	VkDeviceSize                         largest_scratch_size = 0;
+	for (auto &pending_build : pending_builds)
+	{
+		VkDeviceSize scratch_size = align_up(pending_build.acceleration_structure->prepare_build(pending_build.flags, pending_build.mode), scratch_alignment);
+		scratch_sizes.push_back(scratch_size);
+		total_scratch_size += scratch_size;
+		largest_scratch_size = std::max(largest_scratch_size, scratch_size);
+
+		if (pending_build.mode == VK_BUILD_ACCELERATION_STRUCTURE_MODE_BUILD_KHR)
+		{
+			statistics.build_count++;
+			if (pending_build.flags & VK_BUILD_ACCELERATION_STRUCTURE_ALLOW_COMPACTION_BIT_KHR)
+			{
+				compacted.push_back(pending_build.acceleration_structure);
+			}
+		}
+		else
+		{
+			statistics.refit_count++;
+		}
+	}
+
+	// The arena is over-allocated by one alignment, as the buffer address may not be aligned for scratch memory
+	VkDeviceSize arena_size = std::max(largest_scratch_size, std::min(total_scratch_size, scratch_budget));
+	if (!scratch_buffer || scratch_buffer->get_size() < arena_size + scratch_alignment)
+	{
+		scratch_buffer = std::make_unique<vkb::core::BufferC>(
+		    device,
+		    arena_size + scratch_alignment,
+		    VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT,
+		    VMA_MEMORY_USAGE_GPU_ONLY);
+	}
+	VkDeviceAddress scratch_address = align_up(scratch_buffer->get_device_address(), scratch_alignment);
+	arena_size                      = scratch_buffer->get_size() - scratch_alignment;
+	statistics.scratch_size         = scratch_buffer->get_size();
+
+	VkCommandBuffer command_buffer = device.create_command_buffer(VK_COMMAND_BUFFER_LEVEL_PRIMARY, true);
+
+	std::vector<VkAccelerationStructureBuildGeometryInfoKHR>     build_geometry_infos;
+	std::vector<const VkAccelerationStructureBuildRangeInfoKHR *> build_range_infos;
+	VkDeviceSize                                                 scratch_offset = 0;
+
+	auto record_batch = [&]() {
+		vkCmdBuildAccelerationStructuresKHR(command_buffer,
+		                                    static_cast<uint32_t>(build_geometry_infos.size()),
+		                                    build_geometry_infos.data(),
+		                                    build_range_infos.data());
+		statistics.batch_count++;
+		build_geometry_infos.clear();
+		build_range_infos.clear();
+		scratch_offset = 0;
+	};
+
+	for (size_t i = 0; i < pending_builds.size(); ++i)
+	{
+		// The next batch reuses the scratch memory of the previous one once its builds are done.
+		// The first top-level build starts a batch of its own, so that the bottom-level builds are done before it.
+		bool first_top_level = i > 0 &&
+		                       pending_builds[i].acceleration_structure->type != VK_ACCELERATION_STRUCTURE_TYPE_BOTTOM_LEVEL_KHR &&
+		                       pending_builds[i - 1].acceleration_structure->type == VK_ACCELERATION_STRUCTURE_TYPE_BOTTOM_LEVEL_KHR;
+		if (first_top_level || scratch_offset + scratch_sizes[i] > arena_size)
+		{
+			record_batch();
+			record_build_barrier(command_buffer);
+		}
+
+		auto &acceleration_structure = *pending_builds[i].acceleration_structure;
+
+		acceleration_structure.build_geometry_info.scratchData.deviceAddress = scratch_address + scratch_offset;
+		build_geometry_infos.push_back(acceleration_structure.build_geometry_info);
+		build_range_infos.push_back(acceleration_structure.build_range_infos.data());
+		scratch_offset += scratch_sizes[i];
+	}
+	record_batch();
+
+	// Query the compacted sizes in the same submission, once all the builds are done
+	if (!compacted.empty())
+	{
+		if (query_count < compacted.size())
+		{
+			VkQueryPoolCreateInfo query_pool_create_info{VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO};
+			query_pool_create_info.queryType  = VK_QUERY_TYPE_ACCELERATION_STRUCTURE_COMPACTED_SIZE_KHR;
+			query_pool_create_info.queryCount = static_cast<uint32_t>(compacted.size());
+
+			query_pool  = std::make_unique<vkb::QueryPool>(device, query_pool_create_info);
+			query_count = query_pool_create_info.queryCount;
+		}
+
+		std::vector<VkAccelerationStructureKHR> handles;
+		for (auto acceleration_structure : compacted)
+		{
+			handles.push_back(acceleration_structure->get_handle());
+		}
+
+		record_build_barrier(command_buffer);
+		vkCmdResetQueryPool(command_buffer, query_pool->get_handle(), 0, static_cast<uint32_t>(handles.size()));
+		vkCmdWriteAccelerationStructuresPropertiesKHR(command_buffer,
+		                                              static_cast<uint32_t>(handles.size()),
+		                                              handles.data(),
+		                                              VK_QUERY_TYPE_ACCELERATION_STRUCTURE_COMPACTED_SIZE_KHR,
+		                                              query_pool->get_handle(),
+		                                              0);
+	}
+
+	device.flush_command_buffer(command_buffer, queue);
+
+	// Structures recreated by a rebuild are no longer read by the builds
+	for (auto &pending_build : pending_builds)
+	{
+		pending_build.acceleration_structure->destroy_retired_handles();
+	}
+	pending_builds.clear();
+
+	if (!compacted.empty())
+	{
+		compact(queue, compacted);
+	}
+
+	return statistics;
+}
+
+void AccelerationStructureBuilder::compact(VkQueue queue, const std::vector<AccelerationStructure *> &compacted)
+{
+	std::vector<VkDeviceSize> compacted_sizes(compacted.size());
+	VK_CHECK(query_pool->get_results(0,
+	                                 static_cast<uint32_t>(compacted.size()),
+	                                 compacted_sizes.size() * sizeof(VkDeviceSize),
+	                                 compacted_sizes.data(),
+	                                 sizeof(VkDeviceSize),
+	                                 VK_QUERY_RESULT_64_BIT | VK_QUERY_RESULT_WAIT_BIT));
+
+	VkCommandBuffer command_buffer = device.create_command_buffer(VK_COMMAND_BUFFER_LEVEL_PRIMARY, true);
+
+	for (size_t i = 0; i < compacted.size(); ++i)
+	{
+		auto        &acceleration_structure = *compacted[i];
+		VkDeviceSize size                   = acceleration_structure.buffer->get_size();
+
+		statistics.memory_before_compaction += size;
+		if (compacted_sizes[i] == 0 || compacted_sizes[i] >= size)
+		{
+			statistics.memory_after_compaction += size;
+			continue;
+		}
+
+		// The uncompacted structure is retired, and destroyed once the copy and the frames in flight are done
+		VkAccelerationStructureKHR uncompacted = acceleration_structure.handle;
+		acceleration_structure.create_handle(compacted_sizes[i]);
+
+		VkCopyAccelerationStructureInfoKHR copy_info{VK_STRUCTURE_TYPE_COPY_ACCELERATION_STRUCTURE_INFO_KHR};
+		copy_info.src  = uncompacted;
+		copy_info.dst  = acceleration_structure.handle;
+		copy_info.mode = VK_COPY_ACCELERATION_STRUCTURE_MODE_COMPACT_KHR;
+		vkCmdCopyAccelerationStructureKHR(command_buffer, &copy_info);
+
+		statistics.memory_after_compaction += compacted_sizes[i];
+		statistics.compacted_count++;
+	}
+
+	device.flush_command_buffer(command_buffer, queue);
+
+	for (auto acceleration_structure : compacted)
+	{
+		acceleration_structure->destroy_retired_handles();
+	}
+
+	LOGI("Compacted {} acceleration structures from {} KiB to {} KiB",
+	     statistics.compacted_count,
+	     statistics.memory_before_compaction / 1024,
+	     statistics.memory_after_compaction / 1024);
+}
+
+void AccelerationStructureBuilder::release_scratch()
+{
+	scratch_buffer.reset();
+}
+
+const AccelerationStructureBuildStatistics &AccelerationStructureBuilder::get_statistics() const
+{
+	return statistics;
+}
+}        // namespace core
+}        // namespace vkb
@@ -0,0 +1,133 @@
+/* Copyright (c) 2025, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "common/vk_common.h"
+#include "core/buffer.h"
+#include "core/query_pool.h"
+
+namespace vkb
+{
+class Device;
+
+namespace core
+{
+class AccelerationStructure;
+
+struct AccelerationStructureBuildStatistics
+{
+	size_t build_count = 0;
+
+	size_t refit_count = 0;
+
+	/// vkCmdBuildAccelerationStructuresKHR calls, the builds are split when their scratch memory does not fit the arena
+	size_t batch_count = 0;
+
+	/// Size of the scratch arena shared by the builds
+	VkDeviceSize scratch_size = 0;
+
+	size_t compacted_count = 0;
+
+	/// Memory of the compacted structures before and after compaction
+	VkDeviceSize memory_before_compaction = 0;
+
+	VkDeviceSize memory_after_compaction = 0;
+};
+
+/**
+ * @brief Builds and refits many acceleration structures at once, and compacts them
+ *
+ * All the queued builds are recorded in one command buffer, grouped into as few vkCmdBuildAccelerationStructuresKHR
+ * calls as the scratch arena allows. The arena is kept between builds, and only grows when a batch needs more.
+ * Bottom-level builds are recorded first, and top-level builds follow in calls of their own, after a barrier.
+ *
+ * Structures built with VK_BUILD_ACCELERATION_STRUCTURE_ALLOW_COMPACTION_BIT_KHR have their compacted size queried
+ * after the build, and are copied into structures of that size. Their handle and device address change, so
+ * instances referencing them must be written after build() returns: top-level structures referring to compacted
+ * bottom-level ones are built by a later call to build(). Structures replaced by a rebuild or a compaction are
+ * destroyed as set by AccelerationStructure::set_frames_in_flight.
+ */
+class AccelerationStructureBuilder
+{
+  public:
+	/**
+	 * @param device A valid Vulkan device
+	 * @param scratch_budget Largest scratch arena, a single build needing more gets an arena of its own size
+	 */
+	AccelerationStructureBuilder(Device &device, VkDeviceSize scratch_budget = 64 * 1024 * 1024);
+
+	/**
+	 * @brief Queues a full build of an acceleration structure, with the geometries added to it
+	 * @param flags Build flags, compaction is done for structures allowing it
+	 */
+	void add_build(AccelerationStructure &acceleration_structure,
+	               VkBuildAccelerationStructureFlagsKHR flags = VK_BUILD_ACCELERATION_STRUCTURE_PREFER_FAST_TRACE_BIT_KHR |
+	                                                            VK_BUILD_ACCELERATION_STRUCTURE_ALLOW_COMPACTION_BIT_KHR);
+
+	/**
+	 * @brief Queues an update of an acceleration structure in place, for geometries that only moved
+	 * @throws std::runtime_error if the structure was not built with VK_BUILD_ACCELERATION_STRUCTURE_ALLOW_UPDATE_BIT_KHR
+	 */
+	void add_refit(AccelerationStructure &acceleration_structure);
+
+	/**
+	 * @brief Records and submits the queued builds and refits, then compacts the structures that allow it
+	 * @param queue Queue to use for the build process, waited for before returning
+	 */
+	const AccelerationStructureBuildStatistics &build(VkQueue queue);
+
+	/**
+	 * @brief Frees the scratch arena, for when no more builds are expected
+	 */
+	void release_scratch();
+
+	const AccelerationStructureBuildStatistics &get_statistics() const;
+
+  private:
+	struct PendingBuild
+	{
+		AccelerationStructure *acceleration_structure;
+
+		VkBuildAccelerationStructureFlagsKHR flags;
+
+		VkBuildAccelerationStructureModeKHR mode;
+	};
+
+	void compact(VkQueue queue, const std::vector<AccelerationStructure *> &compacted);
+
+	Device &device;
+
+	VkDeviceSize scratch_budget;
+
+	VkDeviceSize scratch_alignment;
+
+	std::unique_ptr<vkb::core::BufferC> scratch_buffer;
+
+	std::unique_ptr<vkb::QueryPool> query_pool;
+
+	uint32_t query_count = 0;
+
+	std::vector<PendingBuild> pending_builds;
+
+	AccelerationStructureBuildStatistics statistics;
+};
+}        // namespace core
+}        // namespace vkb
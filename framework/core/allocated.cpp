@@ -52,6 +52,16 @@ void shutdown()
 		VmaTotalStatistics stats;
 		vmaCalculateStatistics(allocator, &stats);
 		LOGI("Total device memory leaked: {} bytes.", stats.total.statistics.allocationBytes);
+
+		auto memory_statistics = get_memory_statistics();
+		for (size_t i = 0; i < memory_category_count; ++i)
+		{
+			if (memory_statistics[i].allocation_count > 0)
+			{
+				LOGW("{} allocations of {} leaked, {} bytes.",
+				     memory_statistics[i].allocation_count, to_string(static_cast<MemoryCategory>(i)), memory_statistics[i].allocation_bytes);
+			}
+		}
 		vmaDestroyAllocator(allocator);
 		allocator = VK_NULL_HANDLE;
 	}
@@ -19,6 +19,7 @@
 #pragma once
 
 #include "common/error.h"
+#include "core/memory_category.h"
 #include "core/vulkan_resource.h"
 
 namespace vkb
@@ -168,6 +169,15 @@ class Allocated : public vkb::core::VulkanResource<bindingType, HandleType>
 	 */
 	void flush(DeviceSizeType offset = 0, DeviceSizeType size = VK_WHOLE_SIZE);
 
+	/**
+	 * @brief Invalidates memory if it is NOT `HOST_COHERENT`, so that the host sees the writes of the device.
+	 * This is a no-op for `HOST_COHERENT` memory.
+	 *
+	 * @param offset The offset into the memory to invalidate.  Defaults to 0.
+	 * @param size The size of the memory to invalidate.  Defaults to the entire block of memory.
+	 */
+	void invalidate(DeviceSizeType offset = 0, DeviceSizeType size = VK_WHOLE_SIZE);
+
 	/**
 	 * @brief Retrieves a pointer to the host visible memory as an unsigned byte array.
 	 * @return The pointer to the host visible memory.
@@ -180,6 +190,25 @@ class Allocated : public vkb::core::VulkanResource<bindingType, HandleType>
 	 */
 	DeviceMemoryType get_memory() const;
 
+	/**
+	 * @brief Retrieves the VMA allocation, which is null when the object wraps a handle it did not allocate.
+	 * @return The VMA allocation.
+	 */
+	VmaAllocation get_allocation() const;
+
+	/**
+	 * @brief Returns true if defragmentation can move the memory of this object to another place: the object owns its
+	 * allocation, and the allocation is either unmapped or persistently mapped, so no mapping is held across the move.
+	 * @return Whether the allocation can be moved.
+	 */
+	bool is_movable() const;
+
+	/**
+	 * @brief Fetches the pointer to persistently mapped memory again, after defragmentation moved the allocation.
+	 * The handle bound to the new place must be set with `set_handle`.
+	 */
+	void update_mapped_data();
+
 	/**
 	 * @brief Maps Vulkan memory if it isn't already mapped to a host visible address. Does nothing if the
 	 * allocation is already mapped (including persistently mapped allocations).
@@ -420,6 +449,8 @@ inline vk::Buffer Allocated<bindingType, HandleType>::create_buffer_impl(vk::Buf
 	vk::Buffer        buffer = VK_NULL_HANDLE;
 	VmaAllocationInfo allocation_info{};
 
+	set_memory_category(allocation_create_info, get_memory_category(allocation_create_info));
+
 	auto result = vmaCreateBuffer(
 	    get_memory_allocator(),
 	    reinterpret_cast<VkBufferCreateInfo const *>(&create_info),
@@ -432,6 +463,7 @@ inline vk::Buffer Allocated<bindingType, HandleType>::create_buffer_impl(vk::Buf
 	{
 		throw VulkanException{result, "Cannot create Buffer"};
 	}
+	track_allocation(allocation, allocation_info);
 	post_create(allocation_info);
 	return buffer;
 }
@@ -473,6 +505,16 @@ inline vk::Image Allocated<bindingType, HandleType>::create_image_impl(vk::Image
 	}
 #endif
 
+	// Attachments created without a category are the render targets
+	constexpr vk::ImageUsageFlags attachment_flags = vk::ImageUsageFlagBits::eColorAttachment | vk::ImageUsageFlagBits::eDepthStencilAttachment | vk::ImageUsageFlagBits::eTransientAttachment;
+
+	MemoryCategory category = get_memory_category(allocation_create_info);
+	if (category == MemoryCategory::Other && (create_info.usage & attachment_flags))
+	{
+		category = MemoryCategory::RenderTargets;
+	}
+	set_memory_category(allocation_create_info, category);
+
 	VkResult result = vmaCreateImage(get_memory_allocator(),
 	                                 reinterpret_cast<VkImageCreateInfo const *>(&create_info),
 	                                 &allocation_create_info,
@@ -485,6 +527,7 @@ inline vk::Image Allocated<bindingType, HandleType>::create_image_impl(vk::Image
 		throw VulkanException{result, "Cannot create Image"};
 	}
 
+	track_allocation(allocation, allocation_info);
 	post_create(allocation_info);
 	return image;
 }
@@ -495,6 +538,7 @@ inline void Allocated<bindingType, HandleType>::destroy_buffer(BufferType handle
 	if (handle != VK_NULL_HANDLE && allocation != VK_NULL_HANDLE)
 	{
 		unmap();
+		untrack_allocation(allocation);
 		if constexpr (bindingType == vkb::BindingType::Cpp)
 		{
 			vmaDestroyBuffer(get_memory_allocator(), static_cast<VkBuffer>(handle), allocation);
@@ -513,6 +557,7 @@ inline void Allocated<bindingType, HandleType>::destroy_image(ImageType image)
 	if (image != VK_NULL_HANDLE && allocation != VK_NULL_HANDLE)
 	{
 		unmap();
+		untrack_allocation(allocation);
 		if constexpr (bindingType == vkb::BindingType::Cpp)
 		{
 			vmaDestroyImage(get_memory_allocator(), static_cast<VkImage>(image), allocation);
@@ -541,6 +586,22 @@ inline void Allocated<bindingType, HandleType>::flush(DeviceSizeType offset, Dev
 	}
 }
 
+template <vkb::BindingType bindingType, typename HandleType>
+inline void Allocated<bindingType, HandleType>::invalidate(DeviceSizeType offset, DeviceSizeType size)
+{
+	if (!coherent)
+	{
+		if constexpr (bindingType == vkb::BindingType::Cpp)
+		{
+			vmaInvalidateAllocation(get_memory_allocator(), allocation, static_cast<VkDeviceSize>(offset), static_cast<VkDeviceSize>(size));
+		}
+		else
+		{
+			vmaInvalidateAllocation(get_memory_allocator(), allocation, offset, size);
+		}
+	}
+}
+
 template <vkb::BindingType bindingType, typename HandleType>
 inline const uint8_t *Allocated<bindingType, HandleType>::get_data() const
 {
@@ -562,6 +623,29 @@ inline typename Allocated<bindingType, HandleType>::DeviceMemoryType Allocated<b
 	}
 }
 
+template <vkb::BindingType bindingType, typename HandleType>
+inline VmaAllocation Allocated<bindingType, HandleType>::get_allocation() const
+{
+	return allocation;
+}
+
+template <vkb::BindingType bindingType, typename HandleType>
+inline bool Allocated<bindingType, HandleType>::is_movable() const
+{
+	return allocation != VK_NULL_HANDLE && (persistent || !mapped());
+}
+
+template <vkb::BindingType bindingType, typename HandleType>
+inline void Allocated<bindingType, HandleType>::update_mapped_data()
+{
+	if (persistent)
+	{
+		VmaAllocationInfo allocation_info;
+		vmaGetAllocationInfo(get_memory_allocator(), allocation, &allocation_info);
+		mapped_data = static_cast<uint8_t *>(allocation_info.pMappedData);
+	}
+}
+
 template <vkb::BindingType bindingType, typename HandleType>
 inline uint8_t *Allocated<bindingType, HandleType>::map()
 {
@@ -160,11 +160,17 @@ class Buffer
 	 */
 	DeviceSizeType get_size() const;
 
+	/**
+	 * @return The usage flags the buffer was created with
+	 */
+	BufferUsageFlagsType get_usage() const;
+
   private:
 	static Buffer<vkb::BindingType::Cpp> create_staging_buffer_impl(vkb::core::HPPDevice &device, vk::DeviceSize size, const void *data);
 
   private:
-	vk::DeviceSize size = 0;
+	vk::DeviceSize       size = 0;
+	vk::BufferUsageFlags usage;
 };
 
 using BufferC   = Buffer<vkb::BindingType::C>;
@@ -196,7 +202,8 @@ inline BufferCpp Buffer<bindingType>::create_staging_buffer_impl(vkb::core::HPPD
 {
 	BufferBuilderCpp builder(size);
 	builder.with_vma_flags(VMA_ALLOCATION_CREATE_MAPPED_BIT | VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT)
-	    .with_usage(vk::BufferUsageFlagBits::eTransferSrc);
+	    .with_usage(vk::BufferUsageFlagBits::eTransferSrc)
+	    .with_memory_category(vkb::allocated::MemoryCategory::Staging);
 	BufferCpp result(device, builder);
 	if (data != nullptr)
 	{
@@ -230,7 +237,7 @@ inline Buffer<bindingType>::Buffer(DeviceType                  &device,
 
 template <vkb::BindingType bindingType>
 inline Buffer<bindingType>::Buffer(DeviceType &device, const BufferBuilder<bindingType> &builder) :
-    ParentType(builder.get_allocation_create_info(), nullptr, &device), size(builder.get_create_info().size)
+    ParentType(builder.get_allocation_create_info(), nullptr, &device), size(builder.get_create_info().size), usage(builder.get_create_info().usage)
 {
 	this->set_handle(this->create_buffer(builder.get_create_info()));
 	if (!builder.get_debug_name().empty())
@@ -271,5 +278,18 @@ inline typename Buffer<bindingType>::DeviceSizeType Buffer<bindingType>::get_siz
 	}
 }
 
+template <vkb::BindingType bindingType>
+inline typename Buffer<bindingType>::BufferUsageFlagsType Buffer<bindingType>::get_usage() const
+{
+	if constexpr (bindingType == vkb::BindingType::Cpp)
+	{
+		return usage;
+	}
+	else
+	{
+		return static_cast<VkBufferUsageFlags>(usage);
+	}
+}
+
 }        // namespace core
 }        // namespace vkb
@@ -19,6 +19,7 @@
 
 #include "core/command_buffer.h"
 #include "core/device.h"
+#include "stats/gpu_profiler.h"
 
 #include <glm/gtc/type_ptr.hpp>
 #include <unordered_map>
@@ -188,6 +189,12 @@ ScopedDebugLabel::ScopedDebugLabel(const DebugUtils &debug_utils, VkCommandBuffe
 		this->command_buffer = command_buffer;
 
 		debug_utils.cmd_begin_label(command_buffer, name, color);
+
+		profiler = GpuProfiler::get_active();
+		if (profiler)
+		{
+			region = profiler->begin_region(command_buffer, name);
+		}
 	}
 }
 
@@ -200,6 +207,11 @@ ScopedDebugLabel::~ScopedDebugLabel()
 {
 	if (command_buffer != VK_NULL_HANDLE)
 	{
+		if (profiler)
+		{
+			profiler->end_region(command_buffer, region);
+		}
+
 		debug_utils->cmd_end_label(command_buffer);
 	}
 }
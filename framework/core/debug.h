@@ -30,6 +30,8 @@ class CommandBuffer;
 using CommandBufferC = CommandBuffer<vkb::BindingType::C>;
 }        // namespace core
 
+class GpuProfiler;
+
 /**
  * @brief An interface over platform-specific debug extensions.
  */
@@ -160,6 +162,10 @@ class ScopedDebugLabel final
   private:
 	const DebugUtils *debug_utils;
 	VkCommandBuffer   command_buffer;
+
+	// The GPU profiler timing the region, if one was active when the label began
+	GpuProfiler *profiler = nullptr;
+	uint32_t     region   = ~0u;
 };
 
 }        // namespace vkb
\ No newline at end of file
@@ -1,4 +1,4 @@
-/* Copyright (c) 2019-2022, Arm Limited and Contributors
+/* Copyright (c) 2019-2025, Arm Limited and Contributors
  *
  * SPDX-License-Identifier: Apache-2.0
  *
@@ -17,6 +17,10 @@
 
 #include "descriptor_pool.h"
 
+#include <algorithm>
+
+#include "common/strings.h"
+#include "core/util/logging.hpp"
 #include "descriptor_set_layout.h"
 #include "device.h"
 
@@ -38,19 +42,11 @@ DescriptorPool::DescriptorPool(Device &                   device,
 		descriptor_type_counts[binding.descriptorType] += binding.descriptorCount;
 	}
 
-	// Allocate pool sizes array
-	pool_sizes.resize(descriptor_type_counts.size());
-
-	auto pool_size_it = pool_sizes.begin();
-
-	// Fill pool size for each descriptor type count multiplied by the pool size
+	// Store the descriptor count of each type for a single set, pools multiply it by their size
+	set_sizes.reserve(descriptor_type_counts.size());
 	for (auto &it : descriptor_type_counts)
 	{
-		pool_size_it->type = it.first;
-
-		pool_size_it->descriptorCount = it.second * pool_size;
-
-		++pool_size_it;
+		set_sizes.push_back({it.first, it.second});
 	}
 
 	pool_max_sets = pool_size;
@@ -67,15 +63,14 @@ DescriptorPool::~DescriptorPool()
 
 void DescriptorPool::reset()
 {
-	// Reset all descriptor pools
+	// Reset all descriptor pools, which releases all of their sets at once
 	for (auto pool : pools)
 	{
 		vkResetDescriptorPool(device.get_handle(), pool, 0);
 	}
 
-	// Clear internal tracking of descriptor set allocations
-	std::fill(pool_sets_count.begin(), pool_sets_count.end(), 0);
-	set_pool_mapping.clear();
+	free_sets.clear();
+	sets_in_use = 0;
 
 	// Reset the pool index from which descriptor sets are allocated
 	pool_index = 0;
@@ -94,112 +89,115 @@ void DescriptorPool::set_descriptor_set_layout(const DescriptorSetLayout &set_la
 
 VkDescriptorSet DescriptorPool::allocate()
 {
-	pool_index = find_available_pool(pool_index);
-
-	// Increment allocated set count for the current pool
-	++pool_sets_count[pool_index];
-
-	VkDescriptorSetLayout set_layout = get_descriptor_set_layout().get_handle();
-
-	VkDescriptorSetAllocateInfo alloc_info{VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO};
-	alloc_info.descriptorPool     = pools[pool_index];
-	alloc_info.descriptorSetCount = 1;
-	alloc_info.pSetLayouts        = &set_layout;
-
-	VkDescriptorSet handle = VK_NULL_HANDLE;
-
-	// Allocate a new descriptor set from the current pool
-	auto result = vkAllocateDescriptorSets(device.get_handle(), &alloc_info, &handle);
-
-	if (result != VK_SUCCESS)
+	if (free_sets.empty() && !allocate_batch())
 	{
-		// Decrement allocated set count for the current pool
-		--pool_sets_count[pool_index];
-
 		return VK_NULL_HANDLE;
 	}
 
-	// Store mapping between the descriptor set and the pool
-	set_pool_mapping.emplace(handle, pool_index);
+	VkDescriptorSet handle = free_sets.back();
+	free_sets.pop_back();
+
+	peak_sets_in_use = std::max(peak_sets_in_use, ++sets_in_use);
 
 	return handle;
 }
 
 VkResult DescriptorPool::free(VkDescriptorSet descriptor_set)
 {
-	// Get the pool index of the descriptor set
-	auto it = set_pool_mapping.find(descriptor_set);
-
-	if (it == set_pool_mapping.end())
+	if (descriptor_set == VK_NULL_HANDLE)
 	{
 		return VK_INCOMPLETE;
 	}
 
-	auto desc_pool_index = it->second;
+	// The set stays allocated from its Vulkan pool until the next reset, so it can simply be reused
+	free_sets.push_back(descriptor_set);
+	sets_in_use -= std::min(sets_in_use, 1u);
+
+	return VK_SUCCESS;
+}
+
+bool DescriptorPool::allocate_batch()
+{
+	if (pools.size() <= pool_index)
+	{
+		// All pools are in use, so the new one matches the measured peak, which at most doubles the capacity
+		uint32_t max_sets = std::max(pool_max_sets, peak_sets_in_use);
+
+		VkDescriptorPool pool = create_pool(max_sets);
+		if (pool == VK_NULL_HANDLE)
+		{
+			return false;
+		}
+
+		pools.push_back(pool);
+		pool_capacities.push_back(max_sets);
+	}
+
+	uint32_t batch_size = pool_capacities[pool_index];
+
+	std::vector<VkDescriptorSetLayout> set_layouts(batch_size, get_descriptor_set_layout().get_handle());
 
-	// Free descriptor set from the pool
-	vkFreeDescriptorSets(device.get_handle(), pools[desc_pool_index], 1, &descriptor_set);
+	VkDescriptorSetAllocateInfo alloc_info{VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO};
+	alloc_info.descriptorPool     = pools[pool_index];
+	alloc_info.descriptorSetCount = batch_size;
+	alloc_info.pSetLayouts        = set_layouts.data();
 
-	// Remove descriptor set mapping to the pool
-	set_pool_mapping.erase(it);
+	// Allocate every set of the pool with a single call
+	size_t first = free_sets.size();
+	free_sets.resize(first + batch_size, VK_NULL_HANDLE);
 
-	// Decrement allocated set count for the pool
-	--pool_sets_count[desc_pool_index];
+	auto result = vkAllocateDescriptorSets(device.get_handle(), &alloc_info, free_sets.data() + first);
 
-	// Change the current pool index to use the available pool
-	pool_index = desc_pool_index;
+	if (result != VK_SUCCESS)
+	{
+		LOGE("Failed to allocate {} descriptor sets: {}", batch_size, to_string(result));
+		free_sets.resize(first);
+		return false;
+	}
 
-	return VK_SUCCESS;
+	++pool_index;
+
+	return true;
 }
 
-std::uint32_t DescriptorPool::find_available_pool(std::uint32_t search_index)
+VkDescriptorPool DescriptorPool::create_pool(uint32_t max_sets)
 {
-	// Create a new pool
-	if (pools.size() <= search_index)
+	std::vector<VkDescriptorPoolSize> pool_sizes = set_sizes;
+	for (auto &pool_size : pool_sizes)
 	{
-		VkDescriptorPoolCreateInfo create_info{VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO};
-
-		create_info.poolSizeCount = to_u32(pool_sizes.size());
-		create_info.pPoolSizes    = pool_sizes.data();
-		create_info.maxSets       = pool_max_sets;
-
-		// We do not set FREE_DESCRIPTOR_SET_BIT as we do not need to free individual descriptor sets
-		create_info.flags = 0;
+		pool_size.descriptorCount *= max_sets;
+	}
 
-		// Check descriptor set layout and enable the required flags
-		auto &binding_flags = descriptor_set_layout->get_binding_flags();
-		for (auto binding_flag : binding_flags)
-		{
-			if (binding_flag & VK_DESCRIPTOR_BINDING_UPDATE_AFTER_BIND_BIT_EXT)
-			{
-				create_info.flags |= VK_DESCRIPTOR_POOL_CREATE_UPDATE_AFTER_BIND_BIT_EXT;
-			}
-		}
+	VkDescriptorPoolCreateInfo create_info{VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO};
 
-		VkDescriptorPool handle = VK_NULL_HANDLE;
+	create_info.poolSizeCount = to_u32(pool_sizes.size());
+	create_info.pPoolSizes    = pool_sizes.data();
+	create_info.maxSets       = max_sets;
 
-		// Create the Vulkan descriptor pool
-		auto result = vkCreateDescriptorPool(device.get_handle(), &create_info, nullptr, &handle);
+	// We do not set FREE_DESCRIPTOR_SET_BIT as sets are recycled through the free list and pool resets
+	create_info.flags = 0;
 
-		if (result != VK_SUCCESS)
+	// Check descriptor set layout and enable the required flags
+	auto &binding_flags = descriptor_set_layout->get_binding_flags();
+	for (auto binding_flag : binding_flags)
+	{
+		if (binding_flag & VK_DESCRIPTOR_BINDING_UPDATE_AFTER_BIND_BIT_EXT)
 		{
-			return 0;
+			create_info.flags |= VK_DESCRIPTOR_POOL_CREATE_UPDATE_AFTER_BIND_BIT_EXT;
 		}
+	}
 
-		// Store internally the Vulkan handle
-		pools.push_back(handle);
+	VkDescriptorPool handle = VK_NULL_HANDLE;
 
-		// Add set count for the descriptor pool
-		pool_sets_count.push_back(0);
+	// Create the Vulkan descriptor pool
+	auto result = vkCreateDescriptorPool(device.get_handle(), &create_info, nullptr, &handle);
 
-		return search_index;
-	}
-	else if (pool_sets_count[search_index] < pool_max_sets)
+	if (result != VK_SUCCESS)
 	{
-		return search_index;
+		LOGE("Failed to create descriptor pool: {}", to_string(result));
+		return VK_NULL_HANDLE;
 	}
 
-	// Increment pool index
-	return find_available_pool(++search_index);
+	return handle;
 }
 }        // namespace vkb
@@ -28,7 +28,12 @@ class Device;
 class DescriptorSetLayout;
 
 /**
- * @brief Manages an array of fixed size VkDescriptorPool and is able to allocate descriptor sets
+ * @brief Manages an array of VkDescriptorPool and is able to allocate descriptor sets
+ *
+ * All descriptor sets of a pool share the same layout. Sets are allocated from Vulkan in batches,
+ * a whole pool at a time, and handed out from a free list. A new pool holds as many sets as were
+ * ever in use at once, so descriptor heavy scenes quickly reach a steady state without allocating
+ * much more than their peak. Pools are recycled as a whole through reset.
  */
 class DescriptorPool
 {
@@ -49,6 +54,9 @@ class DescriptorPool
 
 	DescriptorPool &operator=(DescriptorPool &&) = delete;
 
+	/**
+	 * @brief Resets all Vulkan pools, invalidating every descriptor set allocated so far
+	 */
 	void reset();
 
 	const DescriptorSetLayout &get_descriptor_set_layout() const;
@@ -57,6 +65,9 @@ class DescriptorPool
 
 	VkDescriptorSet allocate();
 
+	/**
+	 * @brief Returns a descriptor set to the free list, so that allocate can hand it out again
+	 */
 	VkResult free(VkDescriptorSet descriptor_set);
 
   private:
@@ -64,25 +75,32 @@ class DescriptorPool
 
 	const DescriptorSetLayout *descriptor_set_layout{nullptr};
 
-	// Descriptor pool size
-	std::vector<VkDescriptorPoolSize> pool_sizes;
+	// Descriptor count of each type needed by a single set
+	std::vector<VkDescriptorPoolSize> set_sizes;
 
-	// Number of sets to allocate for each pool
+	// Number of sets to allocate for a pool at least
 	uint32_t pool_max_sets{0};
 
+	// Number of sets handed out since the last reset, and the largest it has been
+	uint32_t sets_in_use{0};
+
+	uint32_t peak_sets_in_use{0};
+
 	// Total descriptor pools created
 	std::vector<VkDescriptorPool> pools;
 
-	// Count sets for each pool
-	std::vector<uint32_t> pool_sets_count;
+	// Number of sets each pool was created for
+	std::vector<uint32_t> pool_capacities;
 
-	// Current pool index to allocate descriptor set
+	// Index of the next pool to allocate a batch of descriptor sets from
 	uint32_t pool_index{0};
 
-	// Map between descriptor set and pool index
-	std::unordered_map<VkDescriptorSet, uint32_t> set_pool_mapping;
+	// Descriptor sets allocated from Vulkan that are not in use
+	std::vector<VkDescriptorSet> free_sets;
+
+	// Allocates all the descriptor sets of the next pool into free_sets, creating the pool if needed
+	bool allocate_batch();
 
-	// Find next pool index or create new pool
-	uint32_t find_available_pool(uint32_t pool_index);
+	VkDescriptorPool create_pool(uint32_t max_sets);
 };
 }        // namespace vkb
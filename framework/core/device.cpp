@@ -22,6 +22,7 @@
 #include "core/physical_device.h"
 #include "core/queue.h"
 #include "fence_pool.h"
+#include "upload_service.h"
 
 #define VMA_IMPLEMENTATION
 #include <vk_mem_alloc.h>
@@ -193,8 +194,9 @@ Device::Device(PhysicalDevice                        &gpu,
 
 	prepare_memory_allocator();
 
-	command_pool = std::make_unique<vkb::core::CommandPoolC>(*this, get_queue_by_flags(VK_QUEUE_GRAPHICS_BIT | VK_QUEUE_COMPUTE_BIT, 0).get_family_index());
-	fence_pool   = std::make_unique<FencePool>(*this);
+	command_pool   = std::make_unique<vkb::core::CommandPoolC>(*this, get_queue_by_flags(VK_QUEUE_GRAPHICS_BIT | VK_QUEUE_COMPUTE_BIT, 0).get_family_index());
+	fence_pool     = std::make_unique<FencePool>(*this);
+	upload_service = std::make_unique<UploadService>(*this);
 }
 
 Device::Device(PhysicalDevice &gpu, VkDevice &vulkan_device, VkSurfaceKHR surface) :
@@ -207,6 +209,8 @@ Device::Device(PhysicalDevice &gpu, VkDevice &vulkan_device, VkSurfaceKHR surfac
 
 Device::~Device()
 {
+	upload_service.reset();
+
 	resource_cache.clear();
 
 	command_pool.reset();
@@ -535,6 +539,11 @@ void Device::create_internal_command_pool()
 	command_pool = std::make_unique<vkb::core::CommandPoolC>(*this, get_queue_by_flags(VK_QUEUE_GRAPHICS_BIT | VK_QUEUE_COMPUTE_BIT, 0).get_family_index());
 }
 
+void Device::create_internal_upload_service()
+{
+	upload_service = std::make_unique<UploadService>(*this);
+}
+
 void Device::prepare_memory_allocator()
 {
 	vkb::allocated::init(*this);
@@ -559,4 +568,13 @@ ResourceCache &Device::get_resource_cache()
 {
 	return resource_cache;
 }
+
+UploadService &Device::get_upload_service()
+{
+	if (!upload_service)
+	{
+		create_internal_upload_service();
+	}
+	return *upload_service;
+}
 }        // namespace vkb
@@ -44,6 +44,8 @@
 
 namespace vkb
 {
+class UploadService;
+
 struct DriverVersion
 {
 	uint16_t major;
@@ -198,6 +200,11 @@ class Device : public vkb::core::VulkanResourceC<VkDevice>
 	 */
 	void create_internal_command_pool();
 
+	/**
+	 * @brief Creates the upload service used by this device, once its queues and memory allocator are set up
+	 */
+	void create_internal_upload_service();
+
 	/**
 	 * @brief Creates and sets up the Vulkan memory allocator
 	 */
@@ -213,6 +220,12 @@ class Device : public vkb::core::VulkanResourceC<VkDevice>
 
 	ResourceCache &get_resource_cache();
 
+	/**
+	 * @brief Returns the service that uploads data to buffers and images through a staging ring
+	 *        Devices created from an existing VkDevice get it on first use, if it was not created before
+	 */
+	UploadService &get_upload_service();
+
   private:
 	const PhysicalDevice &gpu;
 
@@ -231,5 +244,7 @@ class Device : public vkb::core::VulkanResourceC<VkDevice>
 	std::unique_ptr<FencePool> fence_pool;
 
 	ResourceCache resource_cache;
+
+	std::unique_ptr<UploadService> upload_service;
 };
 }        // namespace vkb
@@ -20,6 +20,7 @@
 #include "core/command_pool.h"
 #include "core/hpp_physical_device.h"
 #include "core/hpp_queue.h"
+#include "upload_service.h"
 
 namespace vkb
 {
@@ -179,10 +180,15 @@ HPPDevice::HPPDevice(vkb::core::HPPPhysicalDevice               &gpu,
 	command_pool = std::make_unique<vkb::core::CommandPoolCpp>(
 	    *this, get_queue_by_flags(vk::QueueFlagBits::eGraphics | vk::QueueFlagBits::eCompute, 0).get_family_index());
 	fence_pool = std::make_unique<vkb::HPPFencePool>(*this);
+
+	// The upload service is written against vkb::Device, which has the same layout
+	upload_service = std::make_unique<vkb::UploadService>(reinterpret_cast<vkb::Device &>(*this));
 }
 
 HPPDevice::~HPPDevice()
 {
+	upload_service.reset();
+
 	resource_cache.clear();
 
 	command_pool.reset();
@@ -434,5 +440,10 @@ vkb::HPPResourceCache &HPPDevice::get_resource_cache()
 {
 	return resource_cache;
 }
+
+vkb::UploadService &HPPDevice::get_upload_service()
+{
+	return *upload_service;
+}
 }        // namespace core
 }        // namespace vkb
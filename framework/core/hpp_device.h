@@ -23,6 +23,8 @@
 
 namespace vkb
 {
+class UploadService;
+
 namespace core
 {
 template <vkb::BindingType bindingType>
@@ -129,6 +131,11 @@ class HPPDevice : public vkb::core::VulkanResourceCpp<vk::Device>
 
 	vkb::HPPResourceCache &get_resource_cache();
 
+	/**
+	 * @brief Returns the service that uploads data to buffers and images through a staging ring
+	 */
+	vkb::UploadService &get_upload_service();
+
   private:
 	vkb::core::HPPPhysicalDevice const &gpu;
 
@@ -147,6 +154,8 @@ class HPPDevice : public vkb::core::VulkanResourceCpp<vk::Device>
 	std::unique_ptr<vkb::HPPFencePool> fence_pool;
 
 	vkb::HPPResourceCache resource_cache;
+
+	std::unique_ptr<vkb::UploadService> upload_service;
 };
 }        // namespace core
 }        // namespace vkb
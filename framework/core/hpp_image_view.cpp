@@ -19,12 +19,16 @@
 
 #include "common/hpp_vk_common.h"
 #include "core/hpp_device.h"
+#include "core/image_view.h"
 #include <vulkan/vulkan_format_traits.hpp>
 
 namespace vkb
 {
 namespace core
 {
+// Views are reinterpreted as each other when binding them, so their members must line up
+static_assert(sizeof(HPPImageView) == sizeof(ImageView));
+
 HPPImageView::HPPImageView(vkb::core::HPPImage &img,
                            vk::ImageViewType    view_type,
                            vk::Format           format,
@@ -32,7 +36,7 @@ HPPImageView::HPPImageView(vkb::core::HPPImage &img,
                            uint32_t             array_layer,
                            uint32_t             n_mip_levels,
                            uint32_t             n_array_layers) :
-    VulkanResource{nullptr, &img.get_device()}, image{&img}, format{format}
+    VulkanResource{nullptr, &img.get_device()}, image{&img}, format{format}, view_type{view_type}
 {
 	if (format == vk::Format::eUndefined)
 	{
@@ -56,7 +60,7 @@ HPPImageView::HPPImageView(vkb::core::HPPImage &img,
 }
 
 HPPImageView::HPPImageView(HPPImageView &&other) :
-    VulkanResource{std::move(other)}, image{other.image}, format{other.format}, subresource_range{other.subresource_range}
+    VulkanResource{std::move(other)}, image{other.image}, format{other.format}, subresource_range{other.subresource_range}, view_type{other.view_type}
 {
 	// Remove old view from image set and add this new one
 	auto &views = image->get_views();
@@ -79,6 +83,11 @@ vk::Format HPPImageView::get_format() const
 	return format;
 }
 
+vk::ImageViewType HPPImageView::get_view_type() const
+{
+	return view_type;
+}
+
 const vkb::core::HPPImage &HPPImageView::get_image() const
 {
 	assert(image && "vkb::core::HPPImage view is referring an invalid image");
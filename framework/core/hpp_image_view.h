@@ -44,6 +44,7 @@ class HPPImageView : public vkb::core::VulkanResourceCpp<vk::ImageView>
 	HPPImageView &operator=(HPPImageView &&)      = delete;
 
 	vk::Format                 get_format() const;
+	vk::ImageViewType          get_view_type() const;
 	vkb::core::HPPImage const &get_image() const;
 	void                       set_image(vkb::core::HPPImage &image);
 	vk::ImageSubresourceLayers get_subresource_layers() const;
@@ -53,6 +54,7 @@ class HPPImageView : public vkb::core::VulkanResourceCpp<vk::ImageView>
 	vkb::core::HPPImage      *image = nullptr;
 	vk::Format                format;
 	vk::ImageSubresourceRange subresource_range;
+	vk::ImageViewType         view_type;        // last, at the same offset as in ImageView
 };
 }        // namespace core
 }        // namespace vkb
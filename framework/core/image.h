@@ -170,6 +170,11 @@ class Image : public vkb::allocated::AllocatedC<VkImage>
 
 	VkImageTiling get_tiling() const;
 
+	/**
+	 * @return The create info of the image, whose queue family indices may no longer be valid
+	 */
+	const VkImageCreateInfo &get_create_info() const;
+
 	const VkImageSubresource &get_subresource() const;
 
 	uint32_t get_array_layer_count() const;
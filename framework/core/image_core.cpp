@@ -177,6 +177,11 @@ VkImageTiling Image::get_tiling() const
 	return create_info.tiling;
 }
 
+const VkImageCreateInfo &Image::get_create_info() const
+{
+	return create_info;
+}
+
 const VkImageSubresource &Image::get_subresource() const
 {
 	return subresource;
@@ -29,7 +29,8 @@ ImageView::ImageView(Image &img, VkImageViewType view_type, VkFormat format,
                      uint32_t n_mip_levels, uint32_t n_array_layers) :
     VulkanResource{VK_NULL_HANDLE, &img.get_device()},
     image{&img},
-    format{format}
+    format{format},
+    view_type{view_type}
 {
 	if (format == VK_FORMAT_UNDEFINED)
 	{
@@ -72,7 +73,8 @@ ImageView::ImageView(ImageView &&other) :
     VulkanResource{std::move(other)},
     image{other.image},
     format{other.format},
-    subresource_range{other.subresource_range}
+    subresource_range{other.subresource_range},
+    view_type{other.view_type}
 {
 	// Remove old view from image set and add this new one
 	auto &views = image->get_views();
@@ -104,6 +106,11 @@ VkFormat ImageView::get_format() const
 	return format;
 }
 
+VkImageViewType ImageView::get_view_type() const
+{
+	return view_type;
+}
+
 VkImageSubresourceRange ImageView::get_subresource_range() const
 {
 	return subresource_range;
@@ -53,6 +53,8 @@ class ImageView : public vkb::core::VulkanResourceC<VkImageView>
 
 	VkFormat get_format() const;
 
+	VkImageViewType get_view_type() const;
+
 	VkImageSubresourceRange get_subresource_range() const;
 
 	VkImageSubresourceLayers get_subresource_layers() const;
@@ -63,6 +65,9 @@ class ImageView : public vkb::core::VulkanResourceC<VkImageView>
 	VkFormat format{};
 
 	VkImageSubresourceRange subresource_range{};
+
+	// Last, at the same offset as in HPPImageView
+	VkImageViewType view_type{};
 };
 }        // namespace core
 }        // namespace vkb
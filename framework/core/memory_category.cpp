@@ -0,0 +1,160 @@
+/* Copyright (c) 2025, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "core/memory_category.h"
+
+#include <atomic>
+
+#include "core/allocated.h"
+
+namespace vkb
+{
+namespace allocated
+{
+namespace
+{
+struct CategoryCounters
+{
+	std::atomic<uint64_t> allocation_count{0};
+	std::atomic<uint64_t> allocation_bytes{0};
+	std::atomic<uint64_t> peak_bytes{0};
+};
+
+std::array<CategoryCounters, memory_category_count> &get_counters()
+{
+	static std::array<CategoryCounters, memory_category_count> counters;
+	return counters;
+}
+
+thread_local MemoryCategory scope_category = MemoryCategory::Other;
+
+// The category is stored off by one, so that a null pUserData means that no category was set
+void *to_user_data(MemoryCategory category)
+{
+	return reinterpret_cast<void *>(static_cast<uintptr_t>(category) + 1);
+}
+
+MemoryCategory from_user_data(void *user_data)
+{
+	auto value = reinterpret_cast<uintptr_t>(user_data);
+	if (value == 0 || value > memory_category_count)
+	{
+		return MemoryCategory::Other;
+	}
+	return static_cast<MemoryCategory>(value - 1);
+}
+}        // namespace
+
+const char *to_string(MemoryCategory category)
+{
+	switch (category)
+	{
+		case MemoryCategory::SceneGeometry:
+			return "Scene geometry";
+		case MemoryCategory::Textures:
+			return "Textures";
+		case MemoryCategory::RenderTargets:
+			return "Render targets";
+		case MemoryCategory::Transient:
+			return "Transient";
+		case MemoryCategory::Gui:
+			return "GUI";
+		case MemoryCategory::Staging:
+			return "Staging";
+		default:
+			return "Other";
+	}
+}
+
+void set_memory_category(VmaAllocationCreateInfo &allocation_create_info, MemoryCategory category)
+{
+	allocation_create_info.pUserData = to_user_data(category);
+}
+
+MemoryCategory get_memory_category(const VmaAllocationCreateInfo &allocation_create_info)
+{
+	return allocation_create_info.pUserData ? from_user_data(allocation_create_info.pUserData) : scope_category;
+}
+
+MemoryCategoryScope::MemoryCategoryScope(MemoryCategory category) :
+    previous_category{scope_category}
+{
+	scope_category = category;
+}
+
+MemoryCategoryScope::~MemoryCategoryScope()
+{
+	scope_category = previous_category;
+}
+
+void track_allocation(VmaAllocation allocation, const VmaAllocationInfo &allocation_info)
+{
+	MemoryCategory category = from_user_data(allocation_info.pUserData);
+
+	// Names show up in the detailed map, which tells apart the categories of the allocations sharing a block
+	vmaSetAllocationName(get_memory_allocator(), allocation, to_string(category));
+
+	auto    &counters = get_counters()[static_cast<size_t>(category)];
+	uint64_t bytes    = counters.allocation_bytes.fetch_add(allocation_info.size, std::memory_order_relaxed) + allocation_info.size;
+	counters.allocation_count.fetch_add(1, std::memory_order_relaxed);
+
+	uint64_t peak = counters.peak_bytes.load(std::memory_order_relaxed);
+	while (bytes > peak && !counters.peak_bytes.compare_exchange_weak(peak, bytes, std::memory_order_relaxed))
+	{
+	}
+}
+
+void untrack_allocation(VmaAllocation allocation)
+{
+	VmaAllocationInfo allocation_info;
+	vmaGetAllocationInfo(get_memory_allocator(), allocation, &allocation_info);
+
+	auto &counters = get_counters()[static_cast<size_t>(from_user_data(allocation_info.pUserData))];
+	counters.allocation_bytes.fetch_sub(allocation_info.size, std::memory_order_relaxed);
+	counters.allocation_count.fetch_sub(1, std::memory_order_relaxed);
+}
+
+MemoryStatistics get_memory_statistics()
+{
+	MemoryStatistics statistics;
+	auto            &counters = get_counters();
+	for (size_t i = 0; i < memory_category_count; ++i)
+	{
+		statistics[i].allocation_count = counters[i].allocation_count.load(std::memory_order_relaxed);
+		statistics[i].allocation_bytes = counters[i].allocation_bytes.load(std::memory_order_relaxed);
+		statistics[i].peak_bytes       = counters[i].peak_bytes.load(std::memory_order_relaxed);
+	}
+	return statistics;
+}
+
+std::string build_memory_map()
+{
+	auto &allocator = get_memory_allocator();
+	if (allocator == VK_NULL_HANDLE)
+	{
+		return {};
+	}
+
+	char *stats_string = nullptr;
+	vmaBuildStatsString(allocator, &stats_string, VK_TRUE);
+	std::string memory_map{stats_string};
+	vmaFreeStatsString(allocator, stats_string);
+
+	return memory_map;
+}
+}        // namespace allocated
+}        // namespace vkb
@@ -0,0 +1,116 @@
+/* Copyright (c) 2025, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <string>
+
+#include <vk_mem_alloc.h>
+
+namespace vkb
+{
+namespace allocated
+{
+/**
+ * @brief The subsystem a VMA allocation belongs to, tracked to see which one owns the device memory
+ */
+enum class MemoryCategory : uint32_t
+{
+	Other,
+	SceneGeometry,
+	Textures,
+	RenderTargets,
+	Transient,
+	Gui,
+	Staging,
+	Count
+};
+
+constexpr size_t memory_category_count = static_cast<size_t>(MemoryCategory::Count);
+
+const char *to_string(MemoryCategory category);
+
+/**
+ * @brief The live allocations of a category
+ */
+struct MemoryCategoryStatistics
+{
+	uint64_t allocation_count{0};
+
+	uint64_t allocation_bytes{0};
+
+	/// Largest allocation_bytes seen since the start
+	uint64_t peak_bytes{0};
+};
+
+using MemoryStatistics = std::array<MemoryCategoryStatistics, memory_category_count>;
+
+/**
+ * @brief Sets the category of an allocation before it is created
+ *
+ * The category is stored in the pUserData of the create info, which VMA keeps with the allocation.
+ */
+void set_memory_category(VmaAllocationCreateInfo &allocation_create_info, MemoryCategory category);
+
+/**
+ * @return The category set with set_memory_category, or the category of the innermost MemoryCategoryScope of the
+ * calling thread if there is none
+ */
+MemoryCategory get_memory_category(const VmaAllocationCreateInfo &allocation_create_info);
+
+/**
+ * @brief Sets the category of the allocations the calling thread creates without one, until the scope ends
+ *
+ * Lets loaders tag the resources they create through constructors that do not take a category.
+ */
+class MemoryCategoryScope
+{
+  public:
+	explicit MemoryCategoryScope(MemoryCategory category);
+
+	~MemoryCategoryScope();
+
+	MemoryCategoryScope(const MemoryCategoryScope &)            = delete;
+	MemoryCategoryScope &operator=(const MemoryCategoryScope &) = delete;
+
+  private:
+	MemoryCategory previous_category;
+};
+
+/**
+ * @brief Counts a new allocation in its category and names it after the category
+ */
+void track_allocation(VmaAllocation allocation, const VmaAllocationInfo &allocation_info);
+
+/**
+ * @brief Removes an allocation from its category, before it is freed
+ */
+void untrack_allocation(VmaAllocation allocation);
+
+/**
+ * @return The live allocations of each category, indexed by MemoryCategory
+ */
+MemoryStatistics get_memory_statistics();
+
+/**
+ * @return The detailed map of the VMA allocator as JSON, listing each block and allocation with its category
+ */
+std::string build_memory_map();
+}        // namespace allocated
+}        // namespace vkb
@@ -0,0 +1,364 @@
+/* Copyright (c) 2025, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "geometry/instance_grid.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <thread>
+
+#include "geometry/frustum.h"
+
+namespace vkb
+{
+namespace
+{
+// Cells along one axis are limited so that a Morton code fits 10 bits per axis
+constexpr uint32_t max_cells_per_axis = 1024;
+
+constexpr uint32_t max_cell_count = 65536;
+
+// The counting sort keeps a histogram per job, so it is split into fewer jobs than the other passes
+constexpr size_t max_sort_jobs = 16;
+
+uint64_t splitmix64(uint64_t x)
+{
+	x += 0x9e3779b97f4a7c15ull;
+	x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ull;
+	x = (x ^ (x >> 27)) * 0x94d049bb133111ebull;
+	return x ^ (x >> 31);
+}
+
+// Spreads the lower 10 bits of v so that there are two zero bits between each of them
+uint32_t spread_bits(uint32_t v)
+{
+	v = (v | (v << 16)) & 0x030000ff;
+	v = (v | (v << 8)) & 0x0300f00f;
+	v = (v | (v << 4)) & 0x030c30c3;
+	v = (v | (v << 2)) & 0x09249249;
+	return v;
+}
+
+uint32_t morton_code(uint32_t x, uint32_t y, uint32_t z)
+{
+	return spread_bits(x) | (spread_bits(y) << 1) | (spread_bits(z) << 2);
+}
+
+/**
+ * @brief Chooses the number of cells along each axis, for cells as close to cubes as possible
+ * Axes much thinner than a cell, like the height of a flat ring of instances, get a single cell.
+ */
+glm::uvec3 choose_resolution(glm::vec3 extent, uint32_t target_cells)
+{
+	float max_extent = std::max(extent.x, std::max(extent.y, extent.z));
+	if (!(max_extent > 0.0f))
+	{
+		return glm::uvec3(1);
+	}
+
+	bool  active[3] = {true, true, true};
+	float cell_size = max_extent;
+	for (int iteration = 0; iteration < 3; ++iteration)
+	{
+		float volume = 1.0f;
+		int   axes   = 0;
+		for (int a = 0; a < 3; ++a)
+		{
+			if (active[a])
+			{
+				volume *= extent[a];
+				++axes;
+			}
+		}
+		cell_size = std::pow(volume / static_cast<float>(target_cells), 1.0f / static_cast<float>(axes));
+
+		bool changed = false;
+		for (int a = 0; a < 3; ++a)
+		{
+			if (active[a] && extent[a] < cell_size)
+			{
+				active[a] = false;
+				changed   = true;
+			}
+		}
+		if (!changed)
+		{
+			break;
+		}
+	}
+
+	glm::uvec3 resolution(1);
+	for (int a = 0; a < 3; ++a)
+	{
+		if (active[a])
+		{
+			resolution[a] = std::clamp(static_cast<uint32_t>(std::lround(extent[a] / cell_size)), 1u, max_cells_per_axis);
+		}
+	}
+	return resolution;
+}
+
+bool intersects(const std::array<glm::vec4, 6> &planes, const InstanceCell &cell)
+{
+	for (auto &plane : planes)
+	{
+		// The corner of the box furthest along the plane normal
+		glm::vec3 corner(plane.x >= 0.0f ? cell.max.x : cell.min.x,
+		                 plane.y >= 0.0f ? cell.max.y : cell.min.y,
+		                 plane.z >= 0.0f ? cell.max.z : cell.min.z);
+		if (glm::dot(glm::vec3(plane), corner) + plane.w < 0.0f)
+		{
+			return false;
+		}
+	}
+	return true;
+}
+}        // namespace
+
+CounterRandom::CounterRandom(uint32_t seed, uint32_t index) :
+    key{splitmix64(seed) | 1},
+    counter{static_cast<uint64_t>(index) << 32}
+{
+}
+
+uint32_t CounterRandom::next_uint()
+{
+	uint64_t x = counter++ * key;
+	uint64_t y = x;
+	uint64_t z = y + key;
+	x          = x * x + y;
+	x          = (x >> 32) | (x << 32);
+	x          = x * x + z;
+	x          = (x >> 32) | (x << 32);
+	x          = x * x + y;
+	x          = (x >> 32) | (x << 32);
+	return static_cast<uint32_t>((x * x + z) >> 32);
+}
+
+uint32_t CounterRandom::next_uint(uint32_t bound)
+{
+	return static_cast<uint32_t>((static_cast<uint64_t>(next_uint()) * bound) >> 32);
+}
+
+float CounterRandom::next_float()
+{
+	return static_cast<float>(next_uint() >> 8) * (1.0f / 16777216.0f);
+}
+
+InstanceGrid::InstanceGrid(size_t thread_count, uint32_t instances_per_cell) :
+    thread_count{thread_count == 0 ? std::max(1u, std::thread::hardware_concurrency()) : thread_count},
+    instances_per_cell{std::max(1u, instances_per_cell)}
+{
+}
+
+const std::vector<uint32_t> &InstanceGrid::build(std::span<const glm::vec4> bounds)
+{
+	size_t count = bounds.size();
+
+	cells.clear();
+	order.resize(count);
+	instance_cells.resize(count);
+	if (count == 0)
+	{
+		resolution = glm::uvec3(0);
+		return order;
+	}
+
+	// Bounds of the instance centers, reduced per job
+	size_t job_count = std::min(thread_count, max_sort_jobs);
+	size_t per_job   = (count + job_count - 1) / job_count;
+	job_count        = (count + per_job - 1) / per_job;
+
+	std::vector<glm::vec3> job_min(job_count, glm::vec3(std::numeric_limits<float>::max()));
+	std::vector<glm::vec3> job_max(job_count, glm::vec3(std::numeric_limits<float>::lowest()));
+	parallel_for(job_count, thread_count, 1, [&](size_t begin, size_t end) {
+		for (size_t job = begin; job < end; ++job)
+		{
+			for (size_t i = job * per_job; i < std::min(count, (job + 1) * per_job); ++i)
+			{
+				glm::vec3 center(bounds[i]);
+				job_min[job] = glm::min(job_min[job], center);
+				job_max[job] = glm::max(job_max[job], center);
+			}
+		}
+	});
+
+	glm::vec3 lower = job_min[0];
+	glm::vec3 upper = job_max[0];
+	for (size_t job = 1; job < job_count; ++job)
+	{
+		lower = glm::min(lower, job_min[job]);
+		upper = glm::max(upper, job_max[job]);
+	}
+
+	uint32_t target_cells = static_cast<uint32_t>(std::clamp<size_t>(count / instances_per_cell, 1, max_cell_count));
+	resolution            = choose_resolution(upper - lower, target_cells);
+	uint32_t cell_count   = resolution.x * resolution.y * resolution.z;
+
+	glm::vec3 extent = upper - lower;
+	glm::vec3 to_cell(0.0f);
+	for (int a = 0; a < 3; ++a)
+	{
+		if (extent[a] > 0.0f)
+		{
+			to_cell[a] = static_cast<float>(resolution[a]) / extent[a];
+		}
+	}
+
+	// Rank of each cell along the Morton curve, which becomes its position in the instance buffer
+	std::vector<uint32_t> codes(cell_count);
+	std::vector<uint32_t> rank(cell_count);
+	for (uint32_t z = 0, cell = 0; z < resolution.z; ++z)
+	{
+		for (uint32_t y = 0; y < resolution.y; ++y)
+		{
+			for (uint32_t x = 0; x < resolution.x; ++x, ++cell)
+			{
+				codes[cell] = morton_code(x, y, z);
+			}
+		}
+	}
+	std::vector<uint32_t> by_code(cell_count);
+	std::iota(by_code.begin(), by_code.end(), 0);
+	std::sort(by_code.begin(), by_code.end(), [&](uint32_t a, uint32_t b) { return codes[a] < codes[b]; });
+	for (uint32_t r = 0; r < cell_count; ++r)
+	{
+		rank[by_code[r]] = r;
+	}
+
+	// Stable counting sort by cell rank, with a histogram per job
+	std::vector<uint32_t> histograms(job_count * cell_count, 0);
+	parallel_for(job_count, thread_count, 1, [&](size_t begin, size_t end) {
+		for (size_t job = begin; job < end; ++job)
+		{
+			uint32_t *histogram = histograms.data() + job * cell_count;
+			for (size_t i = job * per_job; i < std::min(count, (job + 1) * per_job); ++i)
+			{
+				glm::uvec3 c    = glm::min(glm::uvec3((glm::vec3(bounds[i]) - lower) * to_cell), resolution - 1u);
+				uint32_t   cell = rank[c.x + resolution.x * (c.y + resolution.y * c.z)];
+
+				instance_cells[i] = cell;
+				++histogram[cell];
+			}
+		}
+	});
+
+	// Turn the histograms into the offset of each job within each cell, and collect the non-empty cells
+	uint32_t offset = 0;
+	for (uint32_t cell = 0; cell < cell_count; ++cell)
+	{
+		uint32_t first = offset;
+		for (size_t job = 0; job < job_count; ++job)
+		{
+			uint32_t job_cell_count             = histograms[job * cell_count + cell];
+			histograms[job * cell_count + cell] = offset;
+			offset += job_cell_count;
+		}
+		if (offset > first)
+		{
+			cells.push_back({glm::vec3(0.0f), first, glm::vec3(0.0f), offset - first});
+		}
+	}
+
+	parallel_for(job_count, thread_count, 1, [&](size_t begin, size_t end) {
+		for (size_t job = begin; job < end; ++job)
+		{
+			uint32_t *offsets = histograms.data() + job * cell_count;
+			for (size_t i = job * per_job; i < std::min(count, (job + 1) * per_job); ++i)
+			{
+				order[offsets[instance_cells[i]]++] = static_cast<uint32_t>(i);
+			}
+		}
+	});
+
+	// Cell bounds enclose the bounding spheres of their instances, which may extend past the grid cell
+	parallel_for(cells.size(), thread_count, 64, [&](size_t begin, size_t end) {
+		for (size_t c = begin; c < end; ++c)
+		{
+			auto &cell = cells[c];
+			cell.min   = glm::vec3(std::numeric_limits<float>::max());
+			cell.max   = glm::vec3(std::numeric_limits<float>::lowest());
+			for (uint32_t i = cell.first_instance; i < cell.first_instance + cell.instance_count; ++i)
+			{
+				const glm::vec4 &sphere = bounds[order[i]];
+				cell.min                = glm::min(cell.min, glm::vec3(sphere) - sphere.w);
+				cell.max                = glm::max(cell.max, glm::vec3(sphere) + sphere.w);
+			}
+		}
+	});
+
+	return order;
+}
+
+InstanceCullResult InstanceGrid::cull(const Frustum &frustum, uint32_t index_count, VkDrawIndexedIndirectCommand *commands)
+{
+	auto &planes = frustum.get_planes();
+
+	cell_visible.resize(cells.size());
+	parallel_for(cells.size(), thread_count, 1024, [&](size_t begin, size_t end) {
+		for (size_t c = begin; c < end; ++c)
+		{
+			cell_visible[c] = intersects(planes, cells[c]);
+		}
+	});
+
+	// Consecutive visible cells have consecutive instances, so they are merged into one draw
+	InstanceCullResult result;
+	for (size_t c = 0; c < cells.size(); ++c)
+	{
+		if (!cell_visible[c])
+		{
+			continue;
+		}
+
+		auto &cell = cells[c];
+		if (c > 0 && cell_visible[c - 1])
+		{
+			commands[result.draw_count - 1].instanceCount += cell.instance_count;
+		}
+		else
+		{
+			commands[result.draw_count++] = {index_count, cell.instance_count, 0, 0, cell.first_instance};
+		}
+		++result.visible_cells;
+		result.visible_instances += cell.instance_count;
+	}
+	return result;
+}
+
+uint32_t InstanceGrid::get_max_draw_count() const
+{
+	return static_cast<uint32_t>((cells.size() + 1) / 2);
+}
+
+const std::vector<InstanceCell> &InstanceGrid::get_cells() const
+{
+	return cells;
+}
+
+glm::uvec3 InstanceGrid::get_resolution() const
+{
+	return resolution;
+}
+
+size_t InstanceGrid::get_thread_count() const
+{
+	return thread_count;
+}
+}        // namespace vkb
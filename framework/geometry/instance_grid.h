@@ -0,0 +1,182 @@
+/* Copyright (c) 2025, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <span>
+#include <vector>
+
+#include "common/glm_common.h"
+#include "common/parallel.h"
+#include "common/vk_common.h"
+
+namespace vkb
+{
+class Frustum;
+
+/**
+ * @brief Counter-based random numbers, the numbers drawn for an index only depend on the seed and the index
+ *
+ * Each instance draws from its own sequence, so instances can be generated in any order and on any thread
+ * and still be identical for the same seed. Uses the Squares generator of Widynski, which turns a counter
+ * into a random number with four rounds of squaring.
+ */
+class CounterRandom
+{
+  public:
+	CounterRandom(uint32_t seed, uint32_t index);
+
+	uint32_t next_uint();
+
+	/**
+	 * @return A number in [0, bound)
+	 */
+	uint32_t next_uint(uint32_t bound);
+
+	/**
+	 * @return A number in [0, 1)
+	 */
+	float next_float();
+
+  private:
+	uint64_t key;
+
+	uint64_t counter;
+};
+
+/**
+ * @brief A contiguous range of instances in a grid, with the bounds of their bounding spheres
+ */
+struct InstanceCell
+{
+	glm::vec3 min;
+	uint32_t  first_instance;
+	glm::vec3 max;
+	uint32_t  instance_count;
+};
+
+/**
+ * @brief Result of culling the cells of an InstanceGrid
+ */
+struct InstanceCullResult
+{
+	uint32_t draw_count        = 0;
+	uint32_t visible_cells     = 0;
+	uint32_t visible_instances = 0;
+};
+
+/**
+ * @brief Generates instances on worker threads and bins them into a uniform grid, so that they can be frustum culled per cell
+ *
+ * Instances are sorted by cell with a stable counting sort, and cells are ordered along a Morton curve, so the instances
+ * of each cell are consecutive and neighboring cells tend to be neighbors in the instance buffer too. Culling writes one
+ * indexed indirect draw per run of consecutive visible cells.
+ */
+class InstanceGrid
+{
+  public:
+	/**
+	 * @param thread_count Threads of the shared worker pool to use at most, 0 uses all of them
+	 * @param instances_per_cell The number of instances per cell the grid resolution is chosen for
+	 */
+	explicit InstanceGrid(size_t thread_count = 0, uint32_t instances_per_cell = 256);
+
+	InstanceGrid(const InstanceGrid &)            = delete;
+	InstanceGrid &operator=(const InstanceGrid &) = delete;
+
+	/**
+	 * @brief Generates instances in parallel and sorts them into the cells of the grid
+	 * @param count Number of instances
+	 * @param seed Seed of the random numbers, the same seed always gives the same instances
+	 * @param generate_instance Called as generate_instance(index, random, instance) once per instance, with the random numbers of the index,
+	 *                          returns the bounding sphere of the instance (xyz = center, w = radius). Called from several threads.
+	 * @return The instances, ordered by cell
+	 */
+	template <typename Instance, typename Generate>
+	std::vector<Instance> generate(uint32_t count, uint32_t seed, Generate generate_instance);
+
+	/**
+	 * @brief Sorts instances into the cells of the grid, replacing the previous cells
+	 * @param bounds The bounding sphere of each instance (xyz = center, w = radius)
+	 * @return The instance indices in cell order
+	 */
+	const std::vector<uint32_t> &build(std::span<const glm::vec4> bounds);
+
+	/**
+	 * @brief Writes one draw per run of consecutive cells intersecting the frustum
+	 * @param frustum Frustum in the space of the instance bounds
+	 * @param index_count Index count of the drawn mesh
+	 * @param commands Receives the draws, must hold get_max_draw_count() commands
+	 */
+	InstanceCullResult cull(const Frustum &frustum, uint32_t index_count, VkDrawIndexedIndirectCommand *commands);
+
+	/**
+	 * @return The largest number of draws cull writes, when every other cell is visible
+	 */
+	uint32_t get_max_draw_count() const;
+
+	const std::vector<InstanceCell> &get_cells() const;
+
+	/**
+	 * @return The number of cells along each axis, including empty cells
+	 */
+	glm::uvec3 get_resolution() const;
+
+	size_t get_thread_count() const;
+
+  private:
+	size_t thread_count;
+
+	uint32_t instances_per_cell;
+
+	glm::uvec3 resolution{0};
+
+	std::vector<InstanceCell> cells;
+
+	std::vector<uint32_t> order;
+
+	// Cell of each instance, and whether each cell is visible, reused between calls
+	std::vector<uint32_t> instance_cells;
+	std::vector<uint8_t>  cell_visible;
+};
+
+template <typename Instance, typename Generate>
+std::vector<Instance> InstanceGrid::generate(uint32_t count, uint32_t seed, Generate generate_instance)
+{
+	std::vector<Instance>  instances(count);
+	std::vector<glm::vec4> bounds(count);
+
+	parallel_for(count, thread_count, 1024, [&](size_t begin, size_t end) {
+		for (size_t i = begin; i < end; ++i)
+		{
+			CounterRandom random{seed, static_cast<uint32_t>(i)};
+			bounds[i] = generate_instance(static_cast<uint32_t>(i), random, instances[i]);
+		}
+	});
+
+	build(bounds);
+
+	std::vector<Instance> sorted(count);
+	parallel_for(count, thread_count, 1024, [&](size_t begin, size_t end) {
+		for (size_t i = begin; i < end; ++i)
+		{
+			sorted[i] = instances[order[i]];
+		}
+	});
+	return sorted;
+}
+}        // namespace vkb
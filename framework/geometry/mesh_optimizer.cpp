@@ -0,0 +1,525 @@
+/* Copyright (c) 2025, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "geometry/mesh_optimizer.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <numeric>
+#include <string>
+
+#include "common/error.h"
+#include "common/glm_common.h"
+
+namespace vkb
+{
+namespace
+{
+constexpr uint32_t INVALID_INDEX = std::numeric_limits<uint32_t>::max();
+
+/// Size of the LRU cache modelled while reordering, larger than real caches so that the order works well on most GPUs
+constexpr size_t FORSYTH_CACHE_SIZE = 32;
+
+float get_vertex_score(int32_t cache_position, uint32_t live_triangles)
+{
+	if (live_triangles == 0)
+	{
+		return -1.0f;
+	}
+
+	float score = 0.0f;
+	if (cache_position >= 0)
+	{
+		// The vertices of the last triangle get a fixed score, so that the order in which they were added does not matter
+		score = cache_position < 3 ? 0.75f : std::pow(1.0f - static_cast<float>(cache_position - 3) / (FORSYTH_CACHE_SIZE - 3), 1.5f);
+	}
+
+	// Prefer vertices with few triangles left, so that they are finished and leave the cache for good
+	return score + 2.0f / std::sqrt(static_cast<float>(live_triangles));
+}
+
+/**
+ * @brief Lists the triangles using every vertex
+ */
+void build_adjacency(const std::vector<uint32_t> &indices, size_t vertex_count, std::vector<uint32_t> &counts, std::vector<uint32_t> &offsets, std::vector<uint32_t> &triangles)
+{
+	counts.assign(vertex_count, 0);
+	for (auto index : indices)
+	{
+		if (index >= vertex_count)
+		{
+			throw std::runtime_error("Index " + std::to_string(index) + " is out of range");
+		}
+		++counts[index];
+	}
+
+	offsets.assign(vertex_count + 1, 0);
+	std::partial_sum(counts.begin(), counts.end(), offsets.begin() + 1);
+
+	triangles.resize(indices.size());
+	std::vector<uint32_t> fill(offsets.begin(), offsets.end() - 1);
+	for (size_t i = 0; i < indices.size(); ++i)
+	{
+		triangles[fill[indices[i]]++] = static_cast<uint32_t>(i / 3);
+	}
+}
+
+uint64_t hash_vertex(const std::vector<VertexStream> &streams, size_t vertex)
+{
+	// FNV-1a over the bytes of the vertex in all streams
+	uint64_t hash = 14695981039346656037ull;
+	for (const auto &stream : streams)
+	{
+		const uint8_t *data = stream.data.data() + vertex * stream.stride;
+		for (size_t i = 0; i < stream.stride; ++i)
+		{
+			hash = (hash ^ data[i]) * 1099511628211ull;
+		}
+	}
+	return hash;
+}
+
+bool vertices_equal(const std::vector<VertexStream> &streams, size_t a, size_t b)
+{
+	for (const auto &stream : streams)
+	{
+		if (std::memcmp(stream.data.data() + a * stream.stride, stream.data.data() + b * stream.stride, stream.stride) != 0)
+		{
+			return false;
+		}
+	}
+	return true;
+}
+}        // namespace
+
+VertexCacheStatistics analyze_vertex_cache(const std::vector<uint32_t> &indices, size_t vertex_count, uint32_t cache_size)
+{
+	VertexCacheStatistics statistics;
+
+	// A vertex is in the FIFO as long as fewer than cache_size misses happened since it was added
+	std::vector<uint32_t> cache_timestamps(vertex_count, 0);
+	std::vector<uint8_t>  referenced(vertex_count, 0);
+	uint32_t              timestamp = cache_size + 1;
+
+	for (auto index : indices)
+	{
+		if (timestamp - cache_timestamps[index] > cache_size)
+		{
+			cache_timestamps[index] = timestamp++;
+			++statistics.vertices_transformed;
+		}
+		referenced[index] = 1;
+	}
+
+	size_t triangle_count   = indices.size() / 3;
+	size_t referenced_count = std::count(referenced.begin(), referenced.end(), uint8_t{1});
+
+	statistics.acmr = triangle_count > 0 ? static_cast<float>(statistics.vertices_transformed) / triangle_count : 0.0f;
+	statistics.atvr = referenced_count > 0 ? static_cast<float>(statistics.vertices_transformed) / referenced_count : 0.0f;
+
+	return statistics;
+}
+
+std::vector<uint32_t> weld_vertices(const std::vector<VertexStream> &streams, size_t vertex_count, size_t &unique_count)
+{
+	std::vector<uint32_t> remap(vertex_count, INVALID_INDEX);
+	unique_count = 0;
+
+	// Open addressing table of the first vertex of every unique value
+	size_t table_size = 1;
+	while (table_size < vertex_count * 2)
+	{
+		table_size *= 2;
+	}
+	std::vector<uint32_t> table(table_size, INVALID_INDEX);
+
+	for (size_t vertex = 0; vertex < vertex_count; ++vertex)
+	{
+		size_t slot = hash_vertex(streams, vertex) & (table_size - 1);
+		while (table[slot] != INVALID_INDEX && !vertices_equal(streams, table[slot], vertex))
+		{
+			slot = (slot + 1) & (table_size - 1);
+		}
+
+		if (table[slot] == INVALID_INDEX)
+		{
+			table[slot]   = static_cast<uint32_t>(vertex);
+			remap[vertex] = static_cast<uint32_t>(unique_count++);
+		}
+		else
+		{
+			remap[vertex] = remap[table[slot]];
+		}
+	}
+
+	return remap;
+}
+
+void optimize_vertex_cache(std::vector<uint32_t> &indices, size_t vertex_count)
+{
+	const size_t triangle_count = indices.size() / 3;
+	if (triangle_count == 0)
+	{
+		return;
+	}
+
+	std::vector<uint32_t> live_counts;
+	std::vector<uint32_t> adjacency_offsets;
+	std::vector<uint32_t> adjacency;
+	build_adjacency(indices, vertex_count, live_counts, adjacency_offsets, adjacency);
+
+	std::vector<int32_t> cache_positions(vertex_count, -1);
+	std::vector<float>   vertex_scores(vertex_count);
+	for (size_t vertex = 0; vertex < vertex_count; ++vertex)
+	{
+		vertex_scores[vertex] = get_vertex_score(-1, live_counts[vertex]);
+	}
+
+	std::vector<float> triangle_scores(triangle_count);
+	for (size_t triangle = 0; triangle < triangle_count; ++triangle)
+	{
+		triangle_scores[triangle] = vertex_scores[indices[triangle * 3]] + vertex_scores[indices[triangle * 3 + 1]] + vertex_scores[indices[triangle * 3 + 2]];
+	}
+
+	std::vector<uint8_t>  emitted(triangle_count, 0);
+	std::vector<uint32_t> result;
+	result.reserve(indices.size());
+
+	std::vector<uint32_t> cache;
+	std::vector<uint32_t> new_cache;
+	cache.reserve(FORSYTH_CACHE_SIZE + 3);
+	new_cache.reserve(FORSYTH_CACHE_SIZE + 3);
+
+	auto update_vertex_score = [&](uint32_t vertex, int32_t cache_position) {
+		cache_positions[vertex] = cache_position;
+
+		float score = get_vertex_score(cache_position, live_counts[vertex]);
+		float delta = score - vertex_scores[vertex];
+
+		vertex_scores[vertex] = score;
+		for (uint32_t i = adjacency_offsets[vertex]; i < adjacency_offsets[vertex] + live_counts[vertex]; ++i)
+		{
+			triangle_scores[adjacency[i]] += delta;
+		}
+	};
+
+	uint32_t best_triangle = 0;
+	size_t   scan_position = 0;
+
+	for (size_t emitted_count = 0; emitted_count < triangle_count; ++emitted_count)
+	{
+		if (best_triangle == INVALID_INDEX)
+		{
+			// Nothing left around the cache, continue with the next triangle in the original order
+			while (emitted[scan_position])
+			{
+				++scan_position;
+			}
+			best_triangle = static_cast<uint32_t>(scan_position);
+		}
+
+		const uint32_t *triangle = indices.data() + best_triangle * 3;
+		result.insert(result.end(), triangle, triangle + 3);
+		emitted[best_triangle] = 1;
+
+		// The emitted triangle moves to the end of the live part of each adjacency list
+		new_cache.clear();
+		for (uint32_t i = 0; i < 3; ++i)
+		{
+			uint32_t  vertex    = triangle[i];
+			uint32_t *triangles = adjacency.data() + adjacency_offsets[vertex];
+			uint32_t  last      = --live_counts[vertex];
+			std::swap(*std::find(triangles, triangles + last, best_triangle), triangles[last]);
+
+			if (std::find(new_cache.begin(), new_cache.end(), vertex) == new_cache.end())
+			{
+				new_cache.push_back(vertex);
+			}
+		}
+
+		for (auto vertex : cache)
+		{
+			if (vertex != triangle[0] && vertex != triangle[1] && vertex != triangle[2])
+			{
+				new_cache.push_back(vertex);
+			}
+		}
+
+		for (size_t i = FORSYTH_CACHE_SIZE; i < new_cache.size(); ++i)
+		{
+			update_vertex_score(new_cache[i], -1);
+		}
+		new_cache.resize(std::min(new_cache.size(), FORSYTH_CACHE_SIZE));
+		std::swap(cache, new_cache);
+
+		for (size_t i = 0; i < cache.size(); ++i)
+		{
+			update_vertex_score(cache[i], static_cast<int32_t>(i));
+		}
+
+		// Only triangles around the cache changed their score, so the next triangle is picked among them
+		best_triangle    = INVALID_INDEX;
+		float best_score = std::numeric_limits<float>::lowest();
+		for (auto vertex : cache)
+		{
+			for (uint32_t i = adjacency_offsets[vertex]; i < adjacency_offsets[vertex] + live_counts[vertex]; ++i)
+			{
+				uint32_t candidate = adjacency[i];
+				if (triangle_scores[candidate] > best_score)
+				{
+					best_triangle = candidate;
+					best_score    = triangle_scores[candidate];
+				}
+			}
+		}
+	}
+
+	indices = std::move(result);
+}
+
+void optimize_overdraw(std::vector<uint32_t> &indices, const VertexStream &positions, float threshold)
+{
+	const size_t triangle_count = indices.size() / 3;
+	if (triangle_count == 0)
+	{
+		return;
+	}
+	if (positions.stride < sizeof(float) * 3)
+	{
+		throw std::runtime_error("Overdraw optimization needs three float positions");
+	}
+
+	auto get_position = [&](uint32_t vertex) {
+		glm::vec3 position;
+		std::memcpy(&position, positions.data.data() + vertex * positions.stride, sizeof(position));
+		return position;
+	};
+
+	// Cache misses of every triangle with the same FIFO model as analyze_vertex_cache
+	const uint32_t        cache_size   = 16;
+	const size_t          vertex_count = positions.data.size() / positions.stride;
+	std::vector<uint32_t> cache_timestamps(vertex_count, 0);
+	std::vector<uint8_t>  misses(triangle_count, 0);
+	uint32_t              timestamp = cache_size + 1;
+
+	for (size_t i = 0; i < indices.size(); ++i)
+	{
+		if (timestamp - cache_timestamps[indices[i]] > cache_size)
+		{
+			cache_timestamps[indices[i]] = timestamp++;
+			++misses[i / 3];
+		}
+	}
+
+	// Hard boundaries where the cache restarts, then soft boundaries where a cluster drawn with an empty
+	// cache still has an ACMR close to the one of the hard cluster
+	std::vector<uint32_t> cluster_starts;
+	std::fill(cache_timestamps.begin(), cache_timestamps.end(), 0);
+	timestamp = cache_size + 1;
+
+	for (size_t start = 0; start < triangle_count;)
+	{
+		size_t end            = start + 1;
+		size_t cluster_misses = misses[start];
+		while (end < triangle_count && misses[end] < 3)
+		{
+			cluster_misses += misses[end++];
+		}
+
+		float cluster_acmr = static_cast<float>(cluster_misses) / (end - start);
+
+		cluster_starts.push_back(static_cast<uint32_t>(start));
+		timestamp += cache_size + 1;
+
+		size_t split_misses = 0;
+		for (size_t triangle = start; triangle < end; ++triangle)
+		{
+			for (size_t i = triangle * 3; i < triangle * 3 + 3; ++i)
+			{
+				if (timestamp - cache_timestamps[indices[i]] > cache_size)
+				{
+					cache_timestamps[indices[i]] = timestamp++;
+					++split_misses;
+				}
+			}
+
+			size_t split_count = triangle + 1 - cluster_starts.back();
+			if (triangle + 1 < end && split_count >= 8 && static_cast<float>(split_misses) / split_count <= cluster_acmr * threshold)
+			{
+				cluster_starts.push_back(static_cast<uint32_t>(triangle + 1));
+				timestamp += cache_size + 1;
+				split_misses = 0;
+			}
+		}
+
+		start = end;
+	}
+	cluster_starts.push_back(static_cast<uint32_t>(triangle_count));
+
+	// Sort the clusters by how much they face away from the mesh center, those are likely to occlude the others
+	glm::vec3 mesh_center(0.0f);
+	float     mesh_area = 0.0f;
+
+	const size_t           cluster_count = cluster_starts.size() - 1;
+	std::vector<glm::vec3> cluster_centers(cluster_count, glm::vec3(0.0f));
+	std::vector<glm::vec3> cluster_normals(cluster_count, glm::vec3(0.0f));
+	std::vector<float>     cluster_areas(cluster_count, 0.0f);
+
+	for (size_t cluster = 0; cluster < cluster_count; ++cluster)
+	{
+		for (size_t triangle = cluster_starts[cluster]; triangle < cluster_starts[cluster + 1]; ++triangle)
+		{
+			glm::vec3 p0 = get_position(indices[triangle * 3]);
+			glm::vec3 p1 = get_position(indices[triangle * 3 + 1]);
+			glm::vec3 p2 = get_position(indices[triangle * 3 + 2]);
+
+			glm::vec3 normal = glm::cross(p1 - p0, p2 - p0);
+			float     area   = glm::length(normal);
+
+			cluster_centers[cluster] += (p0 + p1 + p2) * (area / 3.0f);
+			cluster_normals[cluster] += normal;
+			cluster_areas[cluster] += area;
+		}
+
+		mesh_center += cluster_centers[cluster];
+		mesh_area += cluster_areas[cluster];
+	}
+
+	mesh_center = mesh_area > 0.0f ? mesh_center / mesh_area : glm::vec3(0.0f);
+
+	std::vector<float> sort_keys(cluster_count, 0.0f);
+	for (size_t cluster = 0; cluster < cluster_count; ++cluster)
+	{
+		float normal_length = glm::length(cluster_normals[cluster]);
+		if (cluster_areas[cluster] > 0.0f && normal_length > 0.0f)
+		{
+			glm::vec3 center   = cluster_centers[cluster] / cluster_areas[cluster];
+			sort_keys[cluster] = glm::dot(center - mesh_center, cluster_normals[cluster] / normal_length);
+		}
+	}
+
+	std::vector<uint32_t> order(cluster_count);
+	std::iota(order.begin(), order.end(), 0);
+	std::stable_sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b) { return sort_keys[a] > sort_keys[b]; });
+
+	std::vector<uint32_t> result;
+	result.reserve(indices.size());
+	for (auto cluster : order)
+	{
+		result.insert(result.end(), indices.begin() + cluster_starts[cluster] * 3, indices.begin() + cluster_starts[cluster + 1] * 3);
+	}
+
+	indices = std::move(result);
+}
+
+std::vector<uint32_t> optimize_vertex_fetch(const std::vector<uint32_t> &indices, size_t vertex_count, size_t &used_count)
+{
+	std::vector<uint32_t> remap(vertex_count, INVALID_INDEX);
+	used_count = 0;
+
+	for (auto index : indices)
+	{
+		if (remap[index] == INVALID_INDEX)
+		{
+			remap[index] = static_cast<uint32_t>(used_count++);
+		}
+	}
+
+	return remap;
+}
+
+void remap_vertices(std::vector<uint32_t> &indices, std::vector<VertexStream> &streams, const std::vector<uint32_t> &remap, size_t new_vertex_count)
+{
+	for (auto &index : indices)
+	{
+		index = remap[index];
+	}
+
+	for (auto &stream : streams)
+	{
+		std::vector<uint8_t> data(new_vertex_count * stream.stride);
+		for (size_t vertex = 0; vertex < remap.size(); ++vertex)
+		{
+			if (remap[vertex] != INVALID_INDEX)
+			{
+				std::memcpy(data.data() + remap[vertex] * stream.stride, stream.data.data() + vertex * stream.stride, stream.stride);
+			}
+		}
+		stream.data = std::move(data);
+	}
+}
+
+MeshOptimizerReport optimize_mesh(std::vector<uint32_t> &indices, std::vector<VertexStream> &streams, const MeshOptimizerOptions &options)
+{
+	if (streams.empty() || streams[0].stride == 0 || indices.size() % 3 != 0)
+	{
+		throw std::runtime_error("Mesh optimization needs vertex streams and a triangle list");
+	}
+
+	MeshOptimizerReport report;
+
+	size_t vertex_count = streams[0].data.size() / streams[0].stride;
+	for (auto index : indices)
+	{
+		if (index >= vertex_count)
+		{
+			throw std::runtime_error("Index " + std::to_string(index) + " is out of range");
+		}
+	}
+
+	report.vertex_count_before = vertex_count;
+	report.before              = analyze_vertex_cache(indices, vertex_count);
+
+	if (options.weld_vertices)
+	{
+		size_t unique_count = 0;
+		auto   remap        = weld_vertices(streams, vertex_count, unique_count);
+		if (unique_count < vertex_count)
+		{
+			remap_vertices(indices, streams, remap, unique_count);
+			vertex_count = unique_count;
+		}
+	}
+
+	if (options.optimize_vertex_cache)
+	{
+		optimize_vertex_cache(indices, vertex_count);
+	}
+
+	if (options.optimize_overdraw)
+	{
+		assert(options.position_stream < streams.size());
+		optimize_overdraw(indices, streams[options.position_stream], options.overdraw_threshold);
+	}
+
+	if (options.optimize_vertex_fetch)
+	{
+		size_t used_count = 0;
+		auto   remap      = optimize_vertex_fetch(indices, vertex_count, used_count);
+		remap_vertices(indices, streams, remap, used_count);
+		vertex_count = used_count;
+	}
+
+	report.vertex_count_after = vertex_count;
+	report.after              = analyze_vertex_cache(indices, vertex_count);
+
+	return report;
+}
+}        // namespace vkb
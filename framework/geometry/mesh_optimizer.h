@@ -0,0 +1,118 @@
+/* Copyright (c) 2025, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace vkb
+{
+/**
+ * @brief One non-interleaved vertex attribute, vertex i starts at byte i * stride
+ */
+struct VertexStream
+{
+	std::vector<uint8_t> data;
+
+	size_t stride = 0;
+};
+
+/**
+ * @brief Post-transform vertex cache efficiency of an index list, simulated with a FIFO cache
+ */
+struct VertexCacheStatistics
+{
+	uint32_t vertices_transformed = 0;
+
+	/// Average cache miss ratio, transformed vertices per triangle. 0.5 is the ideal for large regular grids, 3 the worst case
+	float acmr = 0.0f;
+
+	/// Average transformed to vertex ratio, 1 is the ideal
+	float atvr = 0.0f;
+};
+
+struct MeshOptimizerOptions
+{
+	bool weld_vertices = true;
+
+	bool optimize_vertex_cache = true;
+
+	bool optimize_overdraw = true;
+
+	bool optimize_vertex_fetch = true;
+
+	/// How much the ACMR may degrade to let the overdraw optimization reorder more triangle clusters
+	float overdraw_threshold = 1.05f;
+
+	/// Stream holding the vertex positions as three floats, needed by the overdraw optimization
+	size_t position_stream = 0;
+};
+
+struct MeshOptimizerReport
+{
+	VertexCacheStatistics before;
+
+	VertexCacheStatistics after;
+
+	size_t vertex_count_before = 0;
+
+	size_t vertex_count_after = 0;
+};
+
+/**
+ * @brief Simulates a FIFO post-transform cache over a triangle list
+ */
+VertexCacheStatistics analyze_vertex_cache(const std::vector<uint32_t> &indices, size_t vertex_count, uint32_t cache_size = 16);
+
+/**
+ * @brief Finds vertices whose attributes are bitwise identical in all streams
+ * @return Remap table from old to new vertex index, new indices are assigned in order of the first occurrence
+ */
+std::vector<uint32_t> weld_vertices(const std::vector<VertexStream> &streams, size_t vertex_count, size_t &unique_count);
+
+/**
+ * @brief Reorders triangles for a good post-transform cache hit rate (Tom Forsyth, Linear-Speed Vertex Cache Optimisation)
+ */
+void optimize_vertex_cache(std::vector<uint32_t> &indices, size_t vertex_count);
+
+/**
+ * @brief Reorders the clusters of a cache optimized triangle list so that outward facing clusters are drawn first
+ *
+ * Based on Sander et al., Fast Triangle Reordering for Vertex Locality and Reduced Overdraw. Clusters end
+ * where the vertex cache restarts, and are split further as long as their ACMR stays within threshold
+ * times the ACMR of the cluster they were split from.
+ */
+void optimize_overdraw(std::vector<uint32_t> &indices, const VertexStream &positions, float threshold = 1.05f);
+
+/**
+ * @brief Orders vertices by their first use in the index list, unreferenced vertices are dropped
+ * @return Remap table from old to new vertex index, unreferenced vertices map to UINT32_MAX
+ */
+std::vector<uint32_t> optimize_vertex_fetch(const std::vector<uint32_t> &indices, size_t vertex_count, size_t &used_count);
+
+/**
+ * @brief Applies a remap table to the indices and vertex streams
+ */
+void remap_vertices(std::vector<uint32_t> &indices, std::vector<VertexStream> &streams, const std::vector<uint32_t> &remap, size_t new_vertex_count);
+
+/**
+ * @brief Runs the enabled optimizations in the order weld, vertex cache, overdraw, vertex fetch
+ */
+MeshOptimizerReport optimize_mesh(std::vector<uint32_t> &indices, std::vector<VertexStream> &streams, const MeshOptimizerOptions &options = {});
+}        // namespace vkb
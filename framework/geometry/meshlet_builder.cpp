@@ -0,0 +1,549 @@
+/* Copyright (c) 2025, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "geometry/meshlet_builder.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <string>
+
+#include <ctpl_stl.h>
+#include <glm/gtx/norm.hpp>
+
+#include "common/error.h"
+
+namespace vkb
+{
+namespace
+{
+constexpr uint32_t INVALID_INDEX = std::numeric_limits<uint32_t>::max();
+
+glm::vec3 get_position(const MeshletSource &source, uint32_t vertex)
+{
+	const float *position = reinterpret_cast<const float *>(reinterpret_cast<const uint8_t *>(source.positions) + vertex * source.vertex_stride);
+	return {position[0], position[1], position[2]};
+}
+
+/**
+ * @brief Uniform grid over the triangle centroids, used to seed new meshlets close to the previous one
+ */
+class TriangleGrid
+{
+  public:
+	explicit TriangleGrid(const std::vector<glm::vec3> &centroids) :
+	    centroids{centroids}
+	{
+		min_corner = glm::vec3(std::numeric_limits<float>::max());
+		glm::vec3 max_corner(std::numeric_limits<float>::lowest());
+		for (const auto &centroid : centroids)
+		{
+			min_corner = glm::min(min_corner, centroid);
+			max_corner = glm::max(max_corner, centroid);
+		}
+
+		// Around four triangles per cell
+		resolution = std::clamp(static_cast<int32_t>(std::cbrt(centroids.size() / 4.0)), 1, 128);
+
+		glm::vec3 extent = glm::max(max_corner - min_corner, glm::vec3(1e-6f));
+		scale            = glm::vec3(static_cast<float>(resolution)) / extent;
+
+		size_t cell_count = static_cast<size_t>(resolution) * resolution * resolution;
+		cell_offsets.assign(cell_count + 1, 0);
+		live_counts.assign(cell_count, 0);
+		triangle_cells.resize(centroids.size());
+
+		for (size_t triangle = 0; triangle < centroids.size(); ++triangle)
+		{
+			triangle_cells[triangle] = get_cell_index(get_cell(centroids[triangle]));
+			++live_counts[triangle_cells[triangle]];
+		}
+
+		for (size_t cell = 0; cell < cell_count; ++cell)
+		{
+			cell_offsets[cell + 1] = cell_offsets[cell] + live_counts[cell];
+		}
+
+		std::vector<uint32_t> fill(cell_offsets.begin(), cell_offsets.end() - 1);
+		cell_triangles.resize(centroids.size());
+		for (uint32_t triangle = 0; triangle < centroids.size(); ++triangle)
+		{
+			cell_triangles[fill[triangle_cells[triangle]]++] = triangle;
+		}
+	}
+
+	void remove(uint32_t triangle)
+	{
+		--live_counts[triangle_cells[triangle]];
+	}
+
+	/**
+	 * @brief Finds the closest triangle that was not emitted yet, searching at most max_rings cells away
+	 * @return The triangle, or INVALID_INDEX if there is none nearby
+	 */
+	uint32_t find_nearest(const glm::vec3 &position, const std::vector<uint8_t> &emitted, int32_t max_rings) const
+	{
+		glm::ivec3 center_cell = get_cell(position);
+
+		uint32_t best          = INVALID_INDEX;
+		float    best_distance = std::numeric_limits<float>::max();
+		int32_t  last_ring     = max_rings;
+
+		for (int32_t ring = 0; ring <= last_ring; ++ring)
+		{
+			glm::ivec3 min_cell = glm::max(center_cell - ring, glm::ivec3(0));
+			glm::ivec3 max_cell = glm::min(center_cell + ring, glm::ivec3(resolution - 1));
+
+			for (int32_t z = min_cell.z; z <= max_cell.z; ++z)
+			{
+				for (int32_t y = min_cell.y; y <= max_cell.y; ++y)
+				{
+					for (int32_t x = min_cell.x; x <= max_cell.x; ++x)
+					{
+						glm::ivec3 offset = glm::abs(glm::ivec3(x, y, z) - center_cell);
+						if (std::max({offset.x, offset.y, offset.z}) != ring)
+						{
+							continue;
+						}
+
+						uint32_t cell = get_cell_index({x, y, z});
+						if (live_counts[cell] == 0)
+						{
+							continue;
+						}
+
+						for (uint32_t i = cell_offsets[cell]; i < cell_offsets[cell + 1]; ++i)
+						{
+							uint32_t triangle = cell_triangles[i];
+							if (emitted[triangle])
+							{
+								continue;
+							}
+
+							float distance = glm::distance2(centroids[triangle], position);
+							if (distance < best_distance)
+							{
+								best          = triangle;
+								best_distance = distance;
+							}
+						}
+					}
+				}
+			}
+
+			// A triangle in the next ring may still be closer than the one found in this ring
+			if (best != INVALID_INDEX && last_ring > ring + 1)
+			{
+				last_ring = ring + 1;
+			}
+		}
+
+		return best;
+	}
+
+  private:
+	glm::ivec3 get_cell(const glm::vec3 &position) const
+	{
+		return glm::clamp(glm::ivec3((position - min_corner) * scale), glm::ivec3(0), glm::ivec3(resolution - 1));
+	}
+
+	uint32_t get_cell_index(const glm::ivec3 &cell) const
+	{
+		return static_cast<uint32_t>(cell.x + (cell.y + cell.z * resolution) * resolution);
+	}
+
+	const std::vector<glm::vec3> &centroids;
+
+	glm::vec3 min_corner;
+
+	glm::vec3 scale;
+
+	int32_t resolution;
+
+	std::vector<uint32_t> cell_offsets;
+
+	std::vector<uint32_t> cell_triangles;
+
+	std::vector<uint32_t> live_counts;
+
+	std::vector<uint32_t> triangle_cells;
+};
+
+MeshletBounds compute_bounds(const MeshletSource &source, const MeshletMesh &mesh, const MeshletRange &meshlet)
+{
+	MeshletBounds bounds{};
+
+	std::vector<glm::vec3> positions(meshlet.vertex_count);
+	for (uint32_t i = 0; i < meshlet.vertex_count; ++i)
+	{
+		positions[i] = get_position(source, mesh.vertices[meshlet.vertex_offset + i]);
+	}
+
+	// Ritter's bounding sphere: start from two distant points, then grow to include the outliers
+	auto farthest_from = [&](const glm::vec3 &point) {
+		return *std::max_element(positions.begin(), positions.end(), [&](const glm::vec3 &a, const glm::vec3 &b) {
+			return glm::distance2(a, point) < glm::distance2(b, point);
+		});
+	};
+
+	glm::vec3 a      = farthest_from(positions[0]);
+	glm::vec3 b      = farthest_from(a);
+	glm::vec3 center = (a + b) * 0.5f;
+	float     radius = glm::distance(a, b) * 0.5f;
+
+	for (const auto &position : positions)
+	{
+		float distance = glm::distance(position, center);
+		if (distance > radius)
+		{
+			float new_radius = (radius + distance) * 0.5f;
+			center += (position - center) * ((new_radius - radius) / distance);
+			radius = new_radius;
+		}
+	}
+
+	bounds.center      = center;
+	bounds.radius      = radius;
+	bounds.cone_axis   = glm::vec3(0.0f, 0.0f, 1.0f);
+	bounds.cone_cutoff = 1.0f;
+	bounds.cone_apex   = center;
+
+	// Normal cone of the triangles, degenerate triangles do not constrain it
+	std::vector<glm::vec3> normals;
+	std::vector<glm::vec3> corners;
+	normals.reserve(meshlet.triangle_count);
+	corners.reserve(meshlet.triangle_count);
+
+	glm::vec3 normal_sum(0.0f);
+	for (uint32_t triangle = 0; triangle < meshlet.triangle_count; ++triangle)
+	{
+		const uint8_t *local = mesh.triangles.data() + meshlet.triangle_offset + triangle * 3;
+
+		glm::vec3 p0     = positions[local[0]];
+		glm::vec3 normal = glm::cross(positions[local[1]] - p0, positions[local[2]] - p0);
+		float     length = glm::length(normal);
+		if (length > 0.0f)
+		{
+			normals.push_back(normal / length);
+			corners.push_back(p0);
+			normal_sum += normals.back();
+		}
+	}
+
+	float axis_length = glm::length(normal_sum);
+	if (normals.empty() || axis_length < 1e-6f)
+	{
+		return bounds;
+	}
+
+	glm::vec3 axis = normal_sum / axis_length;
+
+	float min_dot = 1.0f;
+	for (const auto &normal : normals)
+	{
+		min_dot = std::min(min_dot, glm::dot(axis, normal));
+	}
+
+	// Cones wider than about 84 degrees cull too rarely to be worth testing
+	if (min_dot <= 0.1f)
+	{
+		return bounds;
+	}
+
+	// Move the apex back along the axis until it lies behind the planes of all triangles
+	float max_t = 0.0f;
+	for (size_t i = 0; i < normals.size(); ++i)
+	{
+		float t = glm::dot(center - corners[i], normals[i]) / glm::dot(axis, normals[i]);
+		max_t   = std::max(max_t, t);
+	}
+
+	bounds.cone_axis   = axis;
+	bounds.cone_cutoff = std::sqrt(1.0f - min_dot * min_dot);
+	bounds.cone_apex   = center - axis * max_t;
+
+	return bounds;
+}
+}        // namespace
+
+float MeshletMesh::get_vertex_fill(const MeshletLimits &limits) const
+{
+	if (meshlets.empty())
+	{
+		return 0.0f;
+	}
+
+	size_t vertex_count = 0;
+	for (const auto &meshlet : meshlets)
+	{
+		vertex_count += meshlet.vertex_count;
+	}
+	return static_cast<float>(vertex_count) / (static_cast<float>(meshlets.size()) * limits.max_vertices);
+}
+
+float MeshletMesh::get_triangle_fill(const MeshletLimits &limits) const
+{
+	if (meshlets.empty())
+	{
+		return 0.0f;
+	}
+
+	size_t triangle_count = 0;
+	for (const auto &meshlet : meshlets)
+	{
+		triangle_count += meshlet.triangle_count;
+	}
+	return static_cast<float>(triangle_count) / (static_cast<float>(meshlets.size()) * limits.max_triangles);
+}
+
+MeshletMesh build_meshlets(const MeshletSource &source, const MeshletLimits &limits)
+{
+	if (limits.max_vertices < 3 || limits.max_vertices > 256 || limits.max_triangles == 0)
+	{
+		throw std::runtime_error("Meshlets need between 3 and 256 vertices and at least one triangle");
+	}
+	if (source.index_count % 3 != 0)
+	{
+		throw std::runtime_error("Meshlet source is not a triangle list");
+	}
+
+	MeshletMesh mesh;
+
+	const uint32_t triangle_count = static_cast<uint32_t>(source.index_count / 3);
+	if (triangle_count == 0)
+	{
+		return mesh;
+	}
+
+	// Triangle centroids and normals
+	std::vector<glm::vec3> centroids(triangle_count);
+	std::vector<glm::vec3> normals(triangle_count);
+	std::vector<uint32_t>  live_counts(source.vertex_count, 0);
+
+	for (uint32_t triangle = 0; triangle < triangle_count; ++triangle)
+	{
+		const uint32_t *indices = source.indices + triangle * 3;
+		for (uint32_t i = 0; i < 3; ++i)
+		{
+			if (indices[i] >= source.vertex_count)
+			{
+				throw std::runtime_error("Meshlet source index " + std::to_string(indices[i]) + " is out of range");
+			}
+			++live_counts[indices[i]];
+		}
+
+		glm::vec3 p0 = get_position(source, indices[0]);
+		glm::vec3 p1 = get_position(source, indices[1]);
+		glm::vec3 p2 = get_position(source, indices[2]);
+
+		glm::vec3 normal = glm::cross(p1 - p0, p2 - p0);
+		float     length = glm::length(normal);
+
+		centroids[triangle] = (p0 + p1 + p2) / 3.0f;
+		normals[triangle]   = length > 0.0f ? normal / length : glm::vec3(0.0f);
+	}
+
+	// Triangles adjacent to every vertex
+	std::vector<uint32_t> adjacency_offsets(source.vertex_count + 1, 0);
+	for (size_t vertex = 0; vertex < source.vertex_count; ++vertex)
+	{
+		adjacency_offsets[vertex + 1] = adjacency_offsets[vertex] + live_counts[vertex];
+	}
+
+	std::vector<uint32_t> adjacency(source.index_count);
+	std::vector<uint32_t> fill(adjacency_offsets.begin(), adjacency_offsets.end() - 1);
+	for (uint32_t i = 0; i < source.index_count; ++i)
+	{
+		adjacency[fill[source.indices[i]]++] = i / 3;
+	}
+
+	TriangleGrid grid{centroids};
+
+	std::vector<uint32_t> local_indices(source.vertex_count, INVALID_INDEX);
+	std::vector<uint8_t>  emitted(triangle_count, 0);
+
+	mesh.meshlets.reserve(triangle_count / limits.max_triangles + 1);
+	mesh.vertices.reserve(source.index_count / 2);
+	mesh.triangles.reserve(source.index_count + source.index_count / 3);
+
+	MeshletRange meshlet{};
+	glm::vec3    centroid_sum(0.0f);
+	glm::vec3    normal_sum(0.0f);
+	glm::vec3    previous_center = centroids[0];
+	uint32_t     scan_position   = 0;
+
+	auto count_new_vertices = [&](uint32_t triangle) {
+		const uint32_t *indices = source.indices + triangle * 3;
+		return static_cast<uint32_t>(local_indices[indices[0]] == INVALID_INDEX) +
+		       static_cast<uint32_t>(local_indices[indices[1]] == INVALID_INDEX) +
+		       static_cast<uint32_t>(local_indices[indices[2]] == INVALID_INDEX);
+	};
+
+	auto emit_triangle = [&](uint32_t triangle) {
+		for (uint32_t i = 0; i < 3; ++i)
+		{
+			uint32_t vertex = source.indices[triangle * 3 + i];
+			if (local_indices[vertex] == INVALID_INDEX)
+			{
+				local_indices[vertex] = meshlet.vertex_count++;
+				mesh.vertices.push_back(vertex);
+			}
+			mesh.triangles.push_back(static_cast<uint8_t>(local_indices[vertex]));
+
+			// Keep only the triangles that were not emitted yet at the front of the adjacency list
+			uint32_t *triangles = adjacency.data() + adjacency_offsets[vertex];
+			uint32_t  last      = --live_counts[vertex];
+			std::swap(*std::find(triangles, triangles + last, triangle), triangles[last]);
+		}
+
+		emitted[triangle] = 1;
+		grid.remove(triangle);
+
+		centroid_sum += centroids[triangle];
+		normal_sum += normals[triangle];
+		++meshlet.triangle_count;
+	};
+
+	auto finish_meshlet = [&]() {
+		mesh.bounds.push_back(compute_bounds(source, mesh, meshlet));
+		mesh.meshlets.push_back(meshlet);
+
+		for (uint32_t i = 0; i < meshlet.vertex_count; ++i)
+		{
+			local_indices[mesh.vertices[meshlet.vertex_offset + i]] = INVALID_INDEX;
+		}
+
+		mesh.triangles.resize((mesh.triangles.size() + 3) & ~size_t{3}, 0);
+
+		previous_center = centroid_sum / static_cast<float>(meshlet.triangle_count);
+
+		meshlet                 = {};
+		meshlet.vertex_offset   = static_cast<uint32_t>(mesh.vertices.size());
+		meshlet.triangle_offset = static_cast<uint32_t>(mesh.triangles.size());
+		centroid_sum            = glm::vec3(0.0f);
+		normal_sum              = glm::vec3(0.0f);
+	};
+
+	// Best triangle sharing a vertex with the meshlet: fewest new vertices first, then closest and best aligned
+	auto find_adjacent_triangle = [&]() {
+		glm::vec3 center = centroid_sum / static_cast<float>(meshlet.triangle_count);
+		float     length = glm::length(normal_sum);
+		glm::vec3 axis   = length > 0.0f ? normal_sum / length : glm::vec3(0.0f);
+
+		uint32_t best           = INVALID_INDEX;
+		uint32_t best_new_count = 3;
+		float    best_score     = std::numeric_limits<float>::max();
+
+		for (uint32_t i = 0; i < meshlet.vertex_count; ++i)
+		{
+			uint32_t vertex = mesh.vertices[meshlet.vertex_offset + i];
+
+			for (uint32_t j = adjacency_offsets[vertex]; j < adjacency_offsets[vertex] + live_counts[vertex]; ++j)
+			{
+				uint32_t triangle = adjacency[j];
+
+				uint32_t new_count = count_new_vertices(triangle);
+				if (meshlet.vertex_count + new_count > limits.max_vertices || new_count > best_new_count)
+				{
+					continue;
+				}
+
+				// Squared distance and alignment, which keeps the order of distance * alignment without a square root
+				float alignment = 1.0f + limits.cone_weight * (1.0f - glm::dot(normals[triangle], axis));
+				float score     = glm::distance2(centroids[triangle], center) * alignment * alignment;
+
+				if (new_count < best_new_count || score < best_score)
+				{
+					best           = triangle;
+					best_new_count = new_count;
+					best_score     = score;
+				}
+			}
+		}
+
+		return best;
+	};
+
+	for (uint32_t remaining = triangle_count; remaining > 0; --remaining)
+	{
+		if (meshlet.triangle_count == limits.max_triangles)
+		{
+			finish_meshlet();
+		}
+
+		uint32_t next = meshlet.triangle_count > 0 ? find_adjacent_triangle() : INVALID_INDEX;
+
+		if (next == INVALID_INDEX)
+		{
+			// No connected triangle fits, continue with the closest one or fall back to submission order
+			glm::vec3 from = meshlet.triangle_count > 0 ? centroid_sum / static_cast<float>(meshlet.triangle_count) : previous_center;
+
+			next = grid.find_nearest(from, emitted, 2);
+			if (next == INVALID_INDEX)
+			{
+				while (emitted[scan_position])
+				{
+					++scan_position;
+				}
+				next = scan_position;
+			}
+
+			if (meshlet.triangle_count > 0 && meshlet.vertex_count + count_new_vertices(next) > limits.max_vertices)
+			{
+				finish_meshlet();
+			}
+		}
+
+		emit_triangle(next);
+	}
+
+	finish_meshlet();
+
+	return mesh;
+}
+
+std::vector<MeshletMesh> build_meshlets(const std::vector<MeshletSource> &sources, const MeshletLimits &limits, size_t thread_count)
+{
+	std::vector<MeshletMesh> meshes(sources.size());
+
+	thread_count = std::min(thread_count, sources.size());
+	if (thread_count <= 1)
+	{
+		for (size_t i = 0; i < sources.size(); ++i)
+		{
+			meshes[i] = build_meshlets(sources[i], limits);
+		}
+		return meshes;
+	}
+
+	ctpl::thread_pool thread_pool(static_cast<int>(thread_count));
+
+	std::vector<std::future<void>> futures;
+	futures.reserve(sources.size());
+	for (size_t i = 0; i < sources.size(); ++i)
+	{
+		futures.push_back(thread_pool.push([&, i](size_t) { meshes[i] = build_meshlets(sources[i], limits); }));
+	}
+
+	for (auto &future : futures)
+	{
+		future.get();
+	}
+
+	return meshes;
+}
+}        // namespace vkb
@@ -0,0 +1,135 @@
+/* Copyright (c) 2025, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <vector>
+
+#include "common/glm_common.h"
+
+namespace vkb
+{
+/**
+ * @brief Upper bounds of a single meshlet
+ */
+struct MeshletLimits
+{
+	/// At most 256, so that primitives can use 8-bit local indices
+	uint32_t max_vertices = 64;
+
+	uint32_t max_triangles = 124;
+
+	/// How much the normal of a triangle influences its selection, 0 only considers the distance to the meshlet
+	float cone_weight = 0.25f;
+};
+
+/**
+ * @brief Range of a meshlet within MeshletMesh::vertices and MeshletMesh::triangles
+ */
+struct MeshletRange
+{
+	uint32_t vertex_offset;
+
+	/// Offset in bytes, aligned to 4 so that the local indices can be read as 32-bit words
+	uint32_t triangle_offset;
+
+	uint32_t vertex_count;
+
+	uint32_t triangle_count;
+};
+
+/**
+ * @brief Culling data of a meshlet, laid out to match a std430 array of vec4 pairs
+ *
+ * The meshlet is backfacing and can be skipped if
+ * dot(normalize(cone_apex - camera_position), cone_axis) >= cone_cutoff.
+ * A cone_cutoff of 1 disables the test.
+ */
+struct MeshletBounds
+{
+	glm::vec3 center;
+
+	float radius;
+
+	glm::vec3 cone_axis;
+
+	float cone_cutoff;
+
+	glm::vec3 cone_apex;
+
+	float padding;
+};
+
+/**
+ * @brief Meshlets of a single triangle list
+ */
+struct MeshletMesh
+{
+	std::vector<MeshletRange> meshlets;
+
+	std::vector<MeshletBounds> bounds;
+
+	/// Indices into the source vertex buffer, referenced by the meshlets
+	std::vector<uint32_t> vertices;
+
+	/// Three local vertex indices per triangle
+	std::vector<uint8_t> triangles;
+
+	/**
+	 * @return Average fraction of MeshletLimits::max_vertices used by the meshlets
+	 */
+	float get_vertex_fill(const MeshletLimits &limits) const;
+
+	/**
+	 * @return Average fraction of MeshletLimits::max_triangles used by the meshlets
+	 */
+	float get_triangle_fill(const MeshletLimits &limits) const;
+};
+
+/**
+ * @brief Triangle list to split into meshlets, the data is not copied
+ */
+struct MeshletSource
+{
+	const uint32_t *indices = nullptr;
+
+	size_t index_count = 0;
+
+	/// First three floats of every vertex are the position
+	const float *positions = nullptr;
+
+	size_t vertex_count = 0;
+
+	/// Distance in bytes between two vertices
+	size_t vertex_stride = sizeof(float) * 3;
+};
+
+/**
+ * @brief Splits a triangle list into meshlets
+ *
+ * Meshlets grow greedily from a seed triangle, preferring triangles that add no or few new
+ * vertices, then triangles that are close to the meshlet and face the same way. Once a meshlet
+ * is full, the next one is seeded with the closest remaining triangle, so consecutive meshlets
+ * stay spatially coherent.
+ */
+MeshletMesh build_meshlets(const MeshletSource &source, const MeshletLimits &limits = {});
+
+/**
+ * @brief Builds the meshlets of several triangle lists, distributing them over thread_count threads
+ */
+std::vector<MeshletMesh> build_meshlets(const std::vector<MeshletSource> &sources, const MeshletLimits &limits = {}, size_t thread_count = 1);
+}        // namespace vkb
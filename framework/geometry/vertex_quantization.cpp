@@ -0,0 +1,258 @@
+/* Copyright (c) 2025, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "geometry/vertex_quantization.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+namespace vkb
+{
+namespace
+{
+glm::vec3 read_vec3(const VertexStream &stream, size_t vertex)
+{
+	glm::vec3 value;
+	std::memcpy(&value.x, stream.data.data() + vertex * stream.stride, sizeof(float) * 3);
+	return value;
+}
+
+template <typename T>
+T to_snorm(float value)
+{
+	constexpr float max = static_cast<float>(std::numeric_limits<T>::max());
+	return static_cast<T>(std::round(std::clamp(value, -1.0f, 1.0f) * max));
+}
+
+template <typename T>
+void write_snorm4(uint8_t *destination, const float (&components)[4])
+{
+	T values[4];
+	for (size_t i = 0; i < 4; ++i)
+	{
+		values[i] = to_snorm<T>(components[i]);
+	}
+	std::memcpy(destination, values, sizeof(values));
+}
+}        // namespace
+
+glm::mat4 PositionQuantization::get_dequantization_matrix() const
+{
+	return glm::translate(offset) * glm::scale(scale);
+}
+
+PositionQuantization get_position_quantization(const VertexStream &positions, size_t vertex_count)
+{
+	assert(positions.data.size() >= vertex_count * positions.stride);
+
+	PositionQuantization quantization;
+	if (vertex_count == 0)
+	{
+		return quantization;
+	}
+
+	glm::vec3 min = read_vec3(positions, 0);
+	glm::vec3 max = min;
+	for (size_t i = 1; i < vertex_count; ++i)
+	{
+		glm::vec3 position = read_vec3(positions, i);
+		min                = glm::min(min, position);
+		max                = glm::max(max, position);
+	}
+
+	quantization.offset = min;
+	quantization.scale  = max - min;
+
+	// Flat axes quantize to 0 with any scale. Giving them the largest extent keeps the directions divided by
+	// the scale finite and, as the quantization error of a direction grows with the anisotropy of the scale, accurate
+	float largest_extent = std::max({quantization.scale.x, quantization.scale.y, quantization.scale.z});
+	for (int axis = 0; axis < 3; ++axis)
+	{
+		if (!(quantization.scale[axis] > std::numeric_limits<float>::epsilon() * std::max(1.0f, std::abs(min[axis]))))
+		{
+			quantization.scale[axis] = largest_extent > 0.0f ? largest_extent : 1.0f;
+		}
+	}
+
+	return quantization;
+}
+
+std::vector<uint8_t> quantize_positions(const VertexStream &positions, size_t vertex_count, const PositionQuantization &quantization)
+{
+	assert(positions.data.size() >= vertex_count * positions.stride);
+
+	std::vector<uint8_t> result(vertex_count * sizeof(uint16_t) * 4);
+	for (size_t i = 0; i < vertex_count; ++i)
+	{
+		glm::vec3 normalized = (read_vec3(positions, i) - quantization.offset) / quantization.scale;
+
+		uint16_t values[4] = {};
+		for (int axis = 0; axis < 3; ++axis)
+		{
+			values[axis] = static_cast<uint16_t>(std::round(std::clamp(normalized[axis], 0.0f, 1.0f) * 65535.0f));
+		}
+		std::memcpy(result.data() + i * sizeof(values), values, sizeof(values));
+	}
+
+	return result;
+}
+
+std::vector<uint8_t> quantize_directions(const VertexStream &directions, size_t vertex_count, uint32_t component_count, const glm::vec3 &position_scale, bool compact)
+{
+	assert(component_count == 3 || component_count == 4);
+	assert(directions.data.size() >= vertex_count * directions.stride);
+
+	const size_t         vertex_size = compact ? sizeof(int8_t) * 4 : sizeof(int16_t) * 4;
+	std::vector<uint8_t> result(vertex_size * vertex_count);
+
+	for (size_t i = 0; i < vertex_count; ++i)
+	{
+		glm::vec3 direction = read_vec3(directions, i) / position_scale;
+
+		float length = glm::length(direction);
+		if (length > 0.0f)
+		{
+			direction /= length;
+		}
+
+		float components[4] = {direction.x, direction.y, direction.z, 0.0f};
+		if (component_count == 4)
+		{
+			// Bitangent sign, exactly representable in both formats
+			std::memcpy(&components[3], directions.data.data() + i * directions.stride + sizeof(float) * 3, sizeof(float));
+			components[3] = components[3] < 0.0f ? -1.0f : 1.0f;
+		}
+
+		if (compact)
+		{
+			write_snorm4<int8_t>(result.data() + i * vertex_size, components);
+		}
+		else
+		{
+			write_snorm4<int16_t>(result.data() + i * vertex_size, components);
+		}
+	}
+
+	return result;
+}
+
+std::vector<uint8_t> quantize_texcoords(const VertexStream &texcoords, size_t vertex_count)
+{
+	assert(texcoords.data.size() >= vertex_count * texcoords.stride);
+
+	std::vector<uint8_t> result(vertex_count * sizeof(uint16_t) * 2);
+	for (size_t i = 0; i < vertex_count; ++i)
+	{
+		float texcoord[2];
+		std::memcpy(texcoord, texcoords.data.data() + i * texcoords.stride, sizeof(texcoord));
+
+		uint16_t values[2] = {float_to_half(texcoord[0]), float_to_half(texcoord[1])};
+		std::memcpy(result.data() + i * sizeof(values), values, sizeof(values));
+	}
+
+	return result;
+}
+
+uint16_t float_to_half(float value)
+{
+	uint32_t bits;
+	std::memcpy(&bits, &value, sizeof(bits));
+
+	uint16_t sign     = static_cast<uint16_t>((bits >> 16) & 0x8000u);
+	uint32_t exponent = (bits >> 23) & 0xffu;
+	uint32_t mantissa = bits & 0x7fffffu;
+
+	if (exponent == 0xffu)
+	{
+		// Keep NaNs quiet and non-zero
+		return sign | 0x7c00u | (mantissa ? 0x200u : 0u);
+	}
+
+	int32_t half_exponent = static_cast<int32_t>(exponent) - 127 + 15;
+	if (half_exponent >= 0x1f)
+	{
+		return sign | 0x7c00u;
+	}
+
+	if (half_exponent <= 0)
+	{
+		// Subnormal half, or zero if even the implicit bit is shifted out
+		if (half_exponent < -10)
+		{
+			return sign;
+		}
+		mantissa |= 0x800000u;
+		uint32_t shift   = static_cast<uint32_t>(14 - half_exponent);
+		uint32_t half    = mantissa >> shift;
+		uint32_t rest    = mantissa & ((1u << shift) - 1);
+		uint32_t halfway = 1u << (shift - 1);
+		if (rest > halfway || (rest == halfway && (half & 1u)))
+		{
+			++half;
+		}
+		return static_cast<uint16_t>(sign | half);
+	}
+
+	uint32_t half = (static_cast<uint32_t>(half_exponent) << 10) | (mantissa >> 13);
+	uint32_t rest = mantissa & 0x1fffu;
+	if (rest > 0x1000u || (rest == 0x1000u && (half & 1u)))
+	{
+		// A carry into the exponent is correct, up to rounding to infinity
+		++half;
+	}
+	return static_cast<uint16_t>(sign | half);
+}
+
+float half_to_float(uint16_t value)
+{
+	uint32_t sign     = static_cast<uint32_t>(value & 0x8000u) << 16;
+	uint32_t exponent = (value >> 10) & 0x1fu;
+	uint32_t mantissa = value & 0x3ffu;
+
+	uint32_t bits;
+	if (exponent == 0x1fu)
+	{
+		bits = sign | 0x7f800000u | (mantissa << 13);
+	}
+	else if (exponent != 0)
+	{
+		bits = sign | ((exponent - 15 + 127) << 23) | (mantissa << 13);
+	}
+	else if (mantissa == 0)
+	{
+		bits = sign;
+	}
+	else
+	{
+		// Normalize the subnormal half
+		exponent = 127 - 15 + 1;
+		while (!(mantissa & 0x400u))
+		{
+			mantissa <<= 1;
+			--exponent;
+		}
+		bits = sign | (exponent << 23) | ((mantissa & 0x3ffu) << 13);
+	}
+
+	float result;
+	std::memcpy(&result, &bits, sizeof(result));
+	return result;
+}
+}        // namespace vkb
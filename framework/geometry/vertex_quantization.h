@@ -0,0 +1,93 @@
+/* Copyright (c) 2025, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "common/glm_common.h"
+#include "geometry/mesh_optimizer.h"
+
+namespace vkb
+{
+struct VertexQuantizationOptions
+{
+	/// Positions become R16G16B16A16_UNORM relative to the bounding box of the submesh
+	bool quantize_positions = true;
+
+	/// Normals and tangents become R16G16B16A16_SNORM
+	bool quantize_directions = true;
+
+	/// Stores normals and tangents as R8G8B8A8_SNORM instead, at the cost of visible banding on smooth surfaces
+	bool compact_directions = false;
+
+	/// Float texture coordinates become R16G16_SFLOAT
+	bool quantize_texcoords = true;
+};
+
+/**
+ * @brief Maps quantized positions in [0, 1] back to object space, position = offset + scale * quantized
+ */
+struct PositionQuantization
+{
+	glm::vec3 offset{0.0f};
+
+	glm::vec3 scale{1.0f};
+
+	/**
+	 * @brief Matrix to prepend to the model matrix, so that shaders reading float positions need no changes
+	 */
+	glm::mat4 get_dequantization_matrix() const;
+};
+
+/**
+ * @brief Computes the quantization range from the bounding box of the first three floats of every vertex
+ */
+PositionQuantization get_position_quantization(const VertexStream &positions, size_t vertex_count);
+
+/**
+ * @return Four 16-bit unsigned normalized components per vertex, the fourth is unused
+ */
+std::vector<uint8_t> quantize_positions(const VertexStream &positions, size_t vertex_count, const PositionQuantization &quantization);
+
+/**
+ * @brief Quantizes normals (three floats) or tangents (four floats, the fourth is the bitangent sign)
+ *
+ * Shaders transform directions with the upper 3x3 of the model matrix. With the dequantization matrix
+ * prepended that includes the position scale, so the directions are divided by it here and renormalized,
+ * which keeps their transformed direction. Their transformed length changes, shaders normalize them anyway.
+ *
+ * @param position_scale PositionQuantization::scale of the submesh, or 1 if the positions are not quantized
+ * @param compact Whether to use 8-bit instead of 16-bit signed normalized components
+ * @return Four signed normalized components per vertex
+ */
+std::vector<uint8_t> quantize_directions(const VertexStream &directions, size_t vertex_count, uint32_t component_count, const glm::vec3 &position_scale, bool compact);
+
+/**
+ * @return Two half floats per vertex
+ */
+std::vector<uint8_t> quantize_texcoords(const VertexStream &texcoords, size_t vertex_count);
+
+/**
+ * @brief Converts to IEEE 754 binary16 with round to nearest even, out of range values become infinity
+ */
+uint16_t float_to_half(float value);
+
+float half_to_float(uint16_t value);
+}        // namespace vkb
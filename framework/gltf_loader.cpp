@@ -19,6 +19,7 @@
 #define TINYGLTF_IMPLEMENTATION
 #include "gltf_loader.h"
 
+#include <algorithm>
 #include <limits>
 #include <queue>
 
@@ -35,7 +36,9 @@
 #include "core/device.h"
 #include "core/image.h"
 #include "core/util/logging.hpp"
+#include "filesystem/filesystem.hpp"
 #include "filesystem/legacy.h"
+#include "geometry/meshlet_builder.h"
 #include "scene_graph/components/camera.h"
 #include "scene_graph/components/image.h"
 #include "scene_graph/components/image/astc.h"
@@ -50,6 +53,7 @@
 #include "scene_graph/node.h"
 #include "scene_graph/scene.h"
 #include "scene_graph/scripts/animation.h"
+#include "upload_service.h"
 
 #include <ctpl_stl.h>
 
@@ -285,120 +289,408 @@ inline std::vector<uint8_t> convert_underlying_data_stride(const std::vector<uin
 	return result;
 }
 
-inline void upload_image_to_gpu(vkb::core::CommandBufferC &command_buffer, vkb::core::BufferC &staging_buffer, sg::Image &image)
+inline void prepare_meshlets(std::vector<Meshlet> &meshlets, std::vector<MeshletBounds> &bounds, std::vector<AlignedVertex> const &vertex_data, std::vector<unsigned char> &index_data)
 {
-	// Clean up the image data, as they are copied in the staging buffer
-	image.clear_data();
+	// 32 triangles, because for each triangle we draw a line in a mesh shader sample, 32 triangles/lines per meshlet = 64 vertices on output
+	MeshletLimits limits;
+	limits.max_vertices  = 64;
+	limits.max_triangles = 32;
+
+	MeshletSource source;
+	// index_data is unsigned char type, casting to uint32_t* will give proper value
+	source.indices       = reinterpret_cast<const uint32_t *>(index_data.data());
+	source.index_count   = index_data.size() / sizeof(uint32_t);
+	source.positions     = reinterpret_cast<const float *>(vertex_data.data());
+	source.vertex_count  = vertex_data.size();
+	source.vertex_stride = sizeof(AlignedVertex);
+
+	MeshletMesh mesh = build_meshlets(source, limits);
+
+	// The mesh shaders read global vertex indices, so resolve the local ones
+	meshlets.resize(mesh.meshlets.size());
+	for (size_t i = 0; i < mesh.meshlets.size(); ++i)
+	{
+		const MeshletRange &range   = mesh.meshlets[i];
+		Meshlet            &meshlet = meshlets[i];
 
+		meshlet.vertex_count = range.vertex_count;
+		meshlet.index_count  = range.triangle_count * 3;
+		std::copy_n(mesh.vertices.begin() + range.vertex_offset, range.vertex_count, meshlet.vertices);
+		for (uint32_t j = 0; j < meshlet.index_count; ++j)
+		{
+			meshlet.indices[j] = meshlet.vertices[mesh.triangles[range.triangle_offset + j]];
+		}
+	}
+
+	bounds = std::move(mesh.bounds);
+}
+
+struct OptimizedPrimitive
+{
+	PrimitiveData data;
+
+	MeshOptimizerReport report;
+};
+
+/**
+ * @brief Replaces a float vertex attribute by its quantized form, if the options cover it
+ * @param position_quantization Range of the positions, nullptr if they are not quantized
+ * @return Whether the attribute was quantized
+ */
+bool quantize_attribute(const std::string               &name,
+                        const tinygltf::Accessor        &accessor,
+                        const VertexQuantizationOptions &options,
+                        const PositionQuantization      *position_quantization,
+                        VertexStream                    &stream,
+                        sg::VertexAttribute             &attribute)
+{
+	if (accessor.componentType != TINYGLTF_COMPONENT_TYPE_FLOAT || stream.stride == 0)
 	{
-		ImageMemoryBarrier memory_barrier{};
-		memory_barrier.old_layout      = VK_IMAGE_LAYOUT_UNDEFINED;
-		memory_barrier.new_layout      = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
-		memory_barrier.src_access_mask = 0;
-		memory_barrier.dst_access_mask = VK_ACCESS_TRANSFER_WRITE_BIT;
-		memory_barrier.src_stage_mask  = VK_PIPELINE_STAGE_HOST_BIT;
-		memory_barrier.dst_stage_mask  = VK_PIPELINE_STAGE_TRANSFER_BIT;
+		return false;
+	}
+
+	size_t vertex_count = stream.data.size() / stream.stride;
 
-		command_buffer.image_memory_barrier(image.get_vk_image_view(), memory_barrier);
+	if (name == "position" && position_quantization)
+	{
+		stream.data      = quantize_positions(stream, vertex_count, *position_quantization);
+		attribute.format = VK_FORMAT_R16G16B16A16_UNORM;
+		attribute.stride = sizeof(uint16_t) * 4;
 	}
+	else if (options.quantize_directions && ((name == "normal" && accessor.type == TINYGLTF_TYPE_VEC3) || (name == "tangent" && accessor.type == TINYGLTF_TYPE_VEC4)))
+	{
+		glm::vec3 position_scale  = position_quantization ? position_quantization->scale : glm::vec3{1.0f};
+		uint32_t  component_count = accessor.type == TINYGLTF_TYPE_VEC4 ? 4 : 3;
 
-	// Create a buffer image copy for every mip level
-	auto &mipmaps = image.get_mipmaps();
+		stream.data      = quantize_directions(stream, vertex_count, component_count, position_scale, options.compact_directions);
+		attribute.format = options.compact_directions ? VK_FORMAT_R8G8B8A8_SNORM : VK_FORMAT_R16G16B16A16_SNORM;
+		attribute.stride = options.compact_directions ? sizeof(int8_t) * 4 : sizeof(int16_t) * 4;
+	}
+	else if (options.quantize_texcoords && name.rfind("texcoord_", 0) == 0 && accessor.type == TINYGLTF_TYPE_VEC2)
+	{
+		stream.data      = quantize_texcoords(stream, vertex_count);
+		attribute.format = VK_FORMAT_R16G16_SFLOAT;
+		attribute.stride = sizeof(uint16_t) * 2;
+	}
+	else
+	{
+		return false;
+	}
 
-	std::vector<VkBufferImageCopy> buffer_copy_regions(mipmaps.size());
+	stream.stride = attribute.stride;
+	return true;
+}
 
-	for (size_t i = 0; i < mipmaps.size(); ++i)
+/**
+ * @brief Parses a glTF or GLB file from its memory mapping, instead of letting tinygltf read it into a vector first
+ * @return False if the file could not be read or parsed, with the reason in err
+ */
+bool load_model_from_file(tinygltf::TinyGLTF &loader, tinygltf::Model &model, std::string &err, std::string &warn, const std::string &file_name)
+{
+	PROFILE_SCOPE("Parse GLTF File");
+
+	vkb::filesystem::MappedFilePtr file;
+	try
 	{
-		auto &mipmap      = mipmaps[i];
-		auto &copy_region = buffer_copy_regions[i];
+		file = vkb::filesystem::get()->map_file(file_name);
+	}
+	catch (const std::exception &e)
+	{
+		err = e.what();
+		return false;
+	}
 
-		copy_region.bufferOffset     = mipmap.offset;
-		copy_region.imageSubresource = image.get_vk_image_view().get_subresource_layers();
-		// Update miplevel
-		copy_region.imageSubresource.mipLevel = mipmap.level;
-		copy_region.imageExtent               = mipmap.extent;
+	// External buffers and images are resolved relative to the file
+	auto base_dir = std::filesystem::path(file_name).parent_path().string();
+
+	if (get_extension(file_name) == "glb")
+	{
+		return loader.LoadBinaryFromMemory(&model, &err, &warn, file->data(), static_cast<unsigned int>(file->size()), base_dir);
 	}
 
-	command_buffer.copy_buffer_to_image(staging_buffer, image.get_vk_image(), buffer_copy_regions);
+	return loader.LoadASCIIFromString(&model, &err, &warn, reinterpret_cast<const char *>(file->data()), static_cast<unsigned int>(file->size()), base_dir);
+}
+}        // namespace
 
+bool read_primitive_data(const tinygltf::Model &model, const tinygltf::Primitive &primitive, PrimitiveData &data)
+{
+	if (primitive.indices < 0 || (primitive.mode != -1 && primitive.mode != TINYGLTF_MODE_TRIANGLES) || !primitive.targets.empty() ||
+	    primitive.attributes.find("POSITION") == primitive.attributes.end())
 	{
-		ImageMemoryBarrier memory_barrier{};
-		memory_barrier.old_layout      = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
-		memory_barrier.new_layout      = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
-		memory_barrier.src_access_mask = VK_ACCESS_TRANSFER_WRITE_BIT;
-		memory_barrier.dst_access_mask = VK_ACCESS_SHADER_READ_BIT;
-		memory_barrier.src_stage_mask  = VK_PIPELINE_STAGE_TRANSFER_BIT;
-		memory_barrier.dst_stage_mask  = VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT;
+		return false;
+	}
 
-		command_buffer.image_memory_barrier(image.get_vk_image_view(), memory_barrier);
+	// Overdraw optimization reads the positions as three floats
+	auto &position_accessor = model.accessors[primitive.attributes.at("POSITION")];
+	if (position_accessor.componentType != TINYGLTF_COMPONENT_TYPE_FLOAT || position_accessor.type != TINYGLTF_TYPE_VEC3)
+	{
+		return false;
 	}
+
+	data.attribute_names.clear();
+	data.streams.clear();
+
+	for (auto &attribute : primitive.attributes)
+	{
+		std::string attrib_name = attribute.first;
+		std::transform(attrib_name.begin(), attrib_name.end(), attrib_name.begin(), ::tolower);
+
+		data.attribute_names.push_back(attrib_name);
+		data.streams.push_back({get_attribute_data(&model, attribute.second), get_attribute_stride(&model, attribute.second)});
+	}
+
+	auto  &accessor   = model.accessors[primitive.indices];
+	auto   index_data = get_attribute_data(&model, primitive.indices);
+	size_t stride     = get_attribute_stride(&model, primitive.indices);
+
+	data.indices.resize(accessor.count);
+	for (size_t i = 0; i < accessor.count; ++i)
+	{
+		const uint8_t *index = index_data.data() + i * stride;
+		switch (accessor.componentType)
+		{
+			case TINYGLTF_COMPONENT_TYPE_UNSIGNED_BYTE:
+				data.indices[i] = *index;
+				break;
+			case TINYGLTF_COMPONENT_TYPE_UNSIGNED_SHORT:
+				data.indices[i] = *reinterpret_cast<const uint16_t *>(index);
+				break;
+			case TINYGLTF_COMPONENT_TYPE_UNSIGNED_INT:
+				data.indices[i] = *reinterpret_cast<const uint32_t *>(index);
+				break;
+			default:
+				return false;
+		}
+
+		if (data.indices[i] >= position_accessor.count)
+		{
+			return false;
+		}
+	}
+
+	return data.indices.size() % 3 == 0;
+}
+
+VkFormat get_accessor_format(const tinygltf::Model &model, uint32_t accessor_index)
+{
+	return get_attribute_format(&model, accessor_index);
 }
 
-inline void prepare_meshlets(std::vector<Meshlet> &meshlets, std::unique_ptr<vkb::sg::SubMesh> &submesh, std::vector<unsigned char> &index_data)
+VkSamplerCreateInfo get_sampler_create_info(const tinygltf::Sampler &gltf_sampler)
 {
-	Meshlet meshlet;
-	meshlet.vertex_count = 0;
-	meshlet.index_count  = 0;
+	VkSamplerCreateInfo sampler_info{VK_STRUCTURE_TYPE_SAMPLER_CREATE_INFO};
 
-	std::set<uint32_t> vertices;                  // set for unique vertices
-	uint32_t           triangle_check = 0;        // each meshlet needs to contain full primitives
+	sampler_info.magFilter    = find_mag_filter(gltf_sampler.magFilter);
+	sampler_info.minFilter    = find_min_filter(gltf_sampler.minFilter);
+	sampler_info.mipmapMode   = find_mipmap_mode(gltf_sampler.minFilter);
+	sampler_info.addressModeU = find_wrap_mode(gltf_sampler.wrapS);
+	sampler_info.addressModeV = find_wrap_mode(gltf_sampler.wrapT);
+	sampler_info.borderColor  = VK_BORDER_COLOR_FLOAT_OPAQUE_WHITE;
+	sampler_info.maxLod       = std::numeric_limits<float>::max();
 
-	for (uint32_t i = 0; i < submesh->vertex_indices; i++)
+	return sampler_info;
+}
+
+bool texture_needs_srgb_colorspace(const std::string &name)
+{
+	// The gltf spec states that the base and emissive textures MUST be encoded with the sRGB
+	// transfer function. All other texture types are linear.
+	if (name == "baseColorTexture" || name == "emissiveTexture")
 	{
-		// index_data is unsigned char type, casting to uint32_t* will give proper value
-		meshlet.indices[meshlet.index_count] = *(reinterpret_cast<uint32_t *>(index_data.data()) + i);
+		return true;
+	}
 
-		if (vertices.insert(meshlet.indices[meshlet.index_count]).second)
+	// metallicRoughnessTexture, normalTexture & occlusionTexture must be linear
+	assert(name == "metallicRoughnessTexture" || name == "normalTexture" || name == "occlusionTexture");
+	return false;
+}
+
+void read_material_factors(const tinygltf::Material &gltf_material, sg::PBRMaterial &material)
+{
+	// Initialize base color to 1.0f as per glTF spec
+	material.base_color_factor = glm::vec4(1.0f);
+
+	for (auto &gltf_value : gltf_material.values)
+	{
+		if (gltf_value.first == "baseColorFactor")
+		{
+			const auto &color_factor   = gltf_value.second.ColorFactor();
+			material.base_color_factor = glm::vec4(color_factor[0], color_factor[1], color_factor[2], color_factor[3]);
+		}
+		else if (gltf_value.first == "metallicFactor")
 		{
-			++meshlet.vertex_count;
+			material.metallic_factor = static_cast<float>(gltf_value.second.Factor());
 		}
+		else if (gltf_value.first == "roughnessFactor")
+		{
+			material.roughness_factor = static_cast<float>(gltf_value.second.Factor());
+		}
+	}
 
-		meshlet.index_count++;
-		triangle_check = triangle_check < 3 ? ++triangle_check : 1;
+	for (auto &gltf_value : gltf_material.additionalValues)
+	{
+		if (gltf_value.first == "emissiveFactor")
+		{
+			const auto &emissive_factor = gltf_value.second.number_array;
 
-		// 96 because for each traingle we draw a line in a mesh shader sample, 32 triangles/lines per meshlet = 64 vertices on output
-		if (meshlet.vertex_count == 64 || meshlet.index_count == 96 || i == submesh->vertex_indices - 1)
+			material.emissive = glm::vec3(emissive_factor[0], emissive_factor[1], emissive_factor[2]);
+		}
+		else if (gltf_value.first == "alphaMode")
 		{
-			if (i == submesh->vertex_indices - 1)
+			if (gltf_value.second.string_value == "BLEND")
 			{
-				assert(triangle_check == 3);
+				material.alpha_mode = vkb::sg::AlphaMode::Blend;
 			}
-
-			uint32_t counter = 0;
-			for (auto v : vertices)
+			else if (gltf_value.second.string_value == "OPAQUE")
 			{
-				meshlet.vertices[counter++] = v;
+				material.alpha_mode = vkb::sg::AlphaMode::Opaque;
 			}
-			if (triangle_check != 3)
+			else if (gltf_value.second.string_value == "MASK")
 			{
-				meshlet.index_count -= triangle_check;
-				i -= triangle_check;
-				triangle_check = 0;
+				material.alpha_mode = vkb::sg::AlphaMode::Mask;
 			}
-
-			meshlets.push_back(meshlet);
-			meshlet.vertex_count = 0;
-			meshlet.index_count  = 0;
-			vertices.clear();
+		}
+		else if (gltf_value.first == "alphaCutoff")
+		{
+			material.alpha_cutoff = static_cast<float>(gltf_value.second.number_value);
+		}
+		else if (gltf_value.first == "doubleSided")
+		{
+			material.double_sided = gltf_value.second.bool_value;
 		}
 	}
 }
 
-static inline bool texture_needs_srgb_colorspace(const std::string &name)
+std::vector<std::unique_ptr<sg::Light>> read_khr_lights_punctual(const tinygltf::Model &model)
 {
-	// The gltf spec states that the base and emissive textures MUST be encoded with the sRGB
-	// transfer function. All other texture types are linear.
-	if (name == "baseColorTexture" || name == "emissiveTexture")
+	if (model.extensions.find(KHR_LIGHTS_PUNCTUAL_EXTENSION) == model.extensions.end() || !model.extensions.at(KHR_LIGHTS_PUNCTUAL_EXTENSION).Has("lights"))
 	{
-		return true;
+		return {};
 	}
+	auto &khr_lights = model.extensions.at(KHR_LIGHTS_PUNCTUAL_EXTENSION).Get("lights");
 
-	// metallicRoughnessTexture, normalTexture & occlusionTexture must be linear
-	assert(name == "metallicRoughnessTexture" || name == "normalTexture" || name == "occlusionTexture");
-	return false;
+	std::vector<std::unique_ptr<sg::Light>> light_components(khr_lights.ArrayLen());
+
+	for (size_t light_index = 0; light_index < khr_lights.ArrayLen(); ++light_index)
+	{
+		auto &khr_light = khr_lights.Get(static_cast<int>(light_index));
+
+		// Spec states a light has to have a type to be valid
+		if (!khr_light.Has("type"))
+		{
+			LOGE("KHR_lights_punctual extension: light {} doesn't have a type!", light_index);
+			throw std::runtime_error("Couldn't load glTF file, KHR_lights_punctual extension is invalid");
+		}
+
+		auto light = std::make_unique<sg::Light>(khr_light.Get("name").Get<std::string>());
+
+		sg::LightType       type;
+		sg::LightProperties properties;
+
+		// Get type
+		auto &gltf_light_type = khr_light.Get("type").Get<std::string>();
+		if (gltf_light_type == "point")
+		{
+			type = sg::LightType::Point;
+		}
+		else if (gltf_light_type == "spot")
+		{
+			type = sg::LightType::Spot;
+		}
+		else if (gltf_light_type == "directional")
+		{
+			type = sg::LightType::Directional;
+		}
+		else
+		{
+			LOGE("KHR_lights_punctual extension: light type '{}' is invalid", gltf_light_type);
+			throw std::runtime_error("Couldn't load glTF file, KHR_lights_punctual extension is invalid");
+		}
+
+		// Get properties
+		if (khr_light.Has("color"))
+		{
+			properties.color = glm::vec3(
+			    static_cast<float>(khr_light.Get("color").Get(0).Get<double>()),
+			    static_cast<float>(khr_light.Get("color").Get(1).Get<double>()),
+			    static_cast<float>(khr_light.Get("color").Get(2).Get<double>()));
+		}
+
+		if (khr_light.Has("intensity"))
+		{
+			properties.intensity = static_cast<float>(khr_light.Get("intensity").Get<double>());
+		}
+
+		if (type != sg::LightType::Directional)
+		{
+			properties.range = static_cast<float>(khr_light.Get("range").Get<double>());
+			if (type != sg::LightType::Point)
+			{
+				if (!khr_light.Has("spot"))
+				{
+					LOGE("KHR_lights_punctual extension: spot light doesn't have a 'spot' property set", gltf_light_type);
+					throw std::runtime_error("Couldn't load glTF file, KHR_lights_punctual extension is invalid");
+				}
+
+				properties.inner_cone_angle = static_cast<float>(khr_light.Get("spot").Get("innerConeAngle").Get<double>());
+
+				if (khr_light.Get("spot").Has("outerConeAngle"))
+				{
+					properties.outer_cone_angle = static_cast<float>(khr_light.Get("spot").Get("outerConeAngle").Get<double>());
+				}
+				else
+				{
+					// Spec states default value is PI/4
+					properties.outer_cone_angle = glm::pi<float>() / 4.0f;
+				}
+			}
+		}
+		else if (type == sg::LightType::Directional || type == sg::LightType::Spot)
+		{
+			// The spec states that the light will inherit the transform of the node.
+			// The light's direction is defined as the 3-vector (0.0, 0.0, -1.0) and
+			// the rotation of the node orients the light accordingly.
+			properties.direction = glm::vec3(0.0f, 0.0f, -1.0f);
+		}
+
+		light->set_light_type(type);
+		light->set_properties(properties);
+
+		light_components[light_index] = std::move(light);
+	}
+
+	return light_components;
 }
 
-}        // namespace
+void upload_image_to_gpu(UploadService &upload_service, sg::Image &image)
+{
+	// Create a buffer image copy for every mip level
+	auto &mipmaps = image.get_mipmaps();
+
+	std::vector<VkBufferImageCopy> buffer_copy_regions(mipmaps.size());
+
+	for (size_t i = 0; i < mipmaps.size(); ++i)
+	{
+		auto &mipmap      = mipmaps[i];
+		auto &copy_region = buffer_copy_regions[i];
+
+		copy_region.bufferOffset     = mipmap.offset;
+		copy_region.imageSubresource = image.get_vk_image_view().get_subresource_layers();
+		// Update miplevel
+		copy_region.imageSubresource.mipLevel = mipmap.level;
+		copy_region.imageExtent               = mipmap.extent;
+	}
+
+	upload_service.upload_image(image.get_vk_image().get_handle(),
+	                            image.get_format(),
+	                            image.get_vk_image_view().get_subresource_range(),
+	                            image.get_data().data(),
+	                            image.get_data().size(),
+	                            buffer_copy_regions);
+
+	// Clean up the image data, as they are copied in the staging ring
+	image.clear_data();
+}
 
 std::unordered_map<std::string, bool> GLTFLoader::supported_extensions = {
     {KHR_LIGHTS_PUNCTUAL_EXTENSION, false}};
@@ -408,6 +700,16 @@ GLTFLoader::GLTFLoader(Device &device) :
 {
 }
 
+void GLTFLoader::enable_mesh_optimization(const MeshOptimizerOptions &options)
+{
+	mesh_optimizer_options = options;
+}
+
+void GLTFLoader::enable_vertex_quantization(const VertexQuantizationOptions &options)
+{
+	vertex_quantization_options = options;
+}
+
 std::unique_ptr<sg::Scene> GLTFLoader::read_scene_from_file(const std::string &file_name, int scene_index, VkBufferUsageFlags additional_buffer_usage_flags)
 {
 	PROFILE_SCOPE("Load GLTF Scene");
@@ -419,7 +721,7 @@ std::unique_ptr<sg::Scene> GLTFLoader::read_scene_from_file(const std::string &f
 
 	std::string gltf_file = vkb::fs::path::get(vkb::fs::path::Type::Assets) + file_name;
 
-	bool importResult = gltf_loader.LoadASCIIFromFile(&model, &err, &warn, gltf_file.c_str());
+	bool importResult = load_model_from_file(gltf_loader, model, err, warn, gltf_file);
 
 	if (!importResult)
 	{
@@ -462,7 +764,7 @@ std::unique_ptr<sg::SubMesh> GLTFLoader::read_model_from_file(const std::string
 
 	std::string gltf_file = vkb::fs::path::get(vkb::fs::path::Type::Assets) + file_name;
 
-	bool importResult = gltf_loader.LoadASCIIFromFile(&model, &err, &warn, gltf_file.c_str());
+	bool importResult = load_model_from_file(gltf_loader, model, err, warn, gltf_file);
 
 	if (!importResult)
 	{
@@ -499,6 +801,12 @@ sg::Scene GLTFLoader::load_scene(int scene_index, VkBufferUsageFlags additional_
 {
 	PROFILE_SCOPE("Process Scene");
 
+	// Images and staging buffers set their own category
+	vkb::allocated::MemoryCategoryScope memory_category{vkb::allocated::MemoryCategory::SceneGeometry};
+
+	// Lets sg::MemoryDefragmenter copy the vertex and index buffers to another place
+	additional_buffer_usage_flags |= VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT;
+
 	auto scene = sg::Scene();
 
 	scene.set_name("gltf_scene");
@@ -550,6 +858,17 @@ sg::Scene GLTFLoader::load_scene(int scene_index, VkBufferUsageFlags additional_
 	Timer timer;
 	timer.start();
 
+	// Read all the image files up front, so that decoding the first images overlaps with reading the next ones
+	std::vector<std::string> image_files;
+	for (auto &gltf_image : model.images)
+	{
+		if (gltf_image.image.empty() && !gltf_image.uri.empty())
+		{
+			image_files.push_back(model_path + "/" + gltf_image.uri);
+		}
+	}
+	fs::prefetch_assets(image_files);
+
 	// Load images
 	auto thread_count = std::thread::hardware_concurrency();
 	thread_count      = thread_count == 0 ? 1 : thread_count;
@@ -574,54 +893,26 @@ sg::Scene GLTFLoader::load_scene(int scene_index, VkBufferUsageFlags additional_
 
 	std::vector<std::unique_ptr<sg::Image>> image_components;
 
-	// Upload images to GPU. We do this in batches of 64MB of data to avoid needing
-	// double the amount of memory (all the images and all the corresponding buffers).
-	// This helps keep memory footprint lower which is helpful on smaller devices.
-	size_t image_index = 0;
-	while (image_index < image_count)
+	// Upload images to GPU through the staging ring of the device, as they complete loading. The ring bounds the memory
+	// used for staging, and images are freed once they are copied into it.
 	{
-		std::vector<vkb::core::BufferC> transient_buffers;
+		PROFILE_SCOPE("Upload Images");
 
-		auto command_buffer = device.request_command_buffer();
+		auto &upload_service = device.get_upload_service();
 
-		command_buffer->begin(VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT, 0);
-
-		size_t batch_size = 0;
-
-		// Deal with 64MB of image data at a time to keep memory footprint low
-		while (image_index < image_count && batch_size < 64 * 1024 * 1024)
+		for (size_t image_index = 0; image_index < image_count; image_index++)
 		{
-			// Wait for this image to complete loading, then stage for upload
 			image_components.push_back(image_component_futures[image_index].get());
 
-			auto &image = image_components[image_index];
-
-			core::Buffer stage_buffer = vkb::core::BufferC::create_staging_buffer(device, image->get_data());
-
-			batch_size += image->get_data().size();
-
-			upload_image_to_gpu(*command_buffer, stage_buffer, *image);
-
-			transient_buffers.push_back(std::move(stage_buffer));
-
-			image_index++;
+			upload_image_to_gpu(upload_service, *image_components[image_index]);
 		}
 
-		command_buffer->end();
-
-		auto &queue = device.get_queue_by_flags(VK_QUEUE_GRAPHICS_BIT, 0);
-
-		queue.submit(*command_buffer, device.request_fence());
-
-		device.get_fence_pool().wait();
-		device.get_fence_pool().reset();
-		device.get_command_pool().reset_pool();
-		device.wait_idle();
-
-		// Remove the staging buffers for the batch we just processed
-		transient_buffers.clear();
+		upload_service.flush();
 	}
 
+	// Prefetched files that no image mapped are not kept until the next load
+	fs::drop_prefetched_assets(image_files);
+
 	scene.set_components(std::move(image_components));
 
 	auto elapsed_time = timer.stop();
@@ -729,13 +1020,84 @@ sg::Scene GLTFLoader::load_scene(int scene_index, VkBufferUsageFlags additional_
 
 	auto default_material = create_default_material();
 
+	// Optimize the primitives on the thread pool, the buffers are created in order below
+	std::vector<std::vector<std::future<std::unique_ptr<OptimizedPrimitive>>>> optimized_primitive_futures(model.meshes.size());
+	if (mesh_optimizer_options)
+	{
+		timer.start();
+
+		for (size_t mesh_index = 0; mesh_index < model.meshes.size(); ++mesh_index)
+		{
+			for (size_t primitive_index = 0; primitive_index < model.meshes[mesh_index].primitives.size(); ++primitive_index)
+			{
+				optimized_primitive_futures[mesh_index].push_back(thread_pool.push(
+				    [this, mesh_index, primitive_index](size_t) -> std::unique_ptr<OptimizedPrimitive> {
+					    auto  optimized = std::make_unique<OptimizedPrimitive>();
+					    auto &data      = optimized->data;
+					    if (!read_primitive_data(model, model.meshes[mesh_index].primitives[primitive_index], data))
+					    {
+						    return nullptr;
+					    }
+
+					    MeshOptimizerOptions options = *mesh_optimizer_options;
+					    options.position_stream      = std::find(data.attribute_names.begin(), data.attribute_names.end(), "position") - data.attribute_names.begin();
+
+					    auto &report = optimized->report;
+					    report       = optimize_mesh(data.indices, data.streams, options);
+
+					    LOGD("Optimized '{}' mesh, primitive #{}: ACMR {:.3f} -> {:.3f}, ATVR {:.3f} -> {:.3f}, {} -> {} vertices",
+					         model.meshes[mesh_index].name, primitive_index, report.before.acmr, report.after.acmr,
+					         report.before.atvr, report.after.atvr, report.vertex_count_before, report.vertex_count_after);
+
+					    return optimized;
+				    }));
+			}
+		}
+	}
+
+	// Fall back to floats for the attributes whose quantized format can not be fetched by the device
+	std::optional<VertexQuantizationOptions> quantization_options = vertex_quantization_options;
+	if (quantization_options)
+	{
+		auto is_vertex_format_supported = [this](VkFormat format) {
+			return (device.get_gpu().get_format_properties(format).bufferFeatures & VK_FORMAT_FEATURE_VERTEX_BUFFER_BIT) != 0;
+		};
+
+		if (quantization_options->quantize_positions && !is_vertex_format_supported(VK_FORMAT_R16G16B16A16_UNORM))
+		{
+			LOGW("Vertex quantization: R16G16B16A16_UNORM vertex buffers are not supported, positions are kept as floats");
+			quantization_options->quantize_positions = false;
+		}
+		VkFormat direction_format = quantization_options->compact_directions ? VK_FORMAT_R8G8B8A8_SNORM : VK_FORMAT_R16G16B16A16_SNORM;
+		if (quantization_options->quantize_directions && !is_vertex_format_supported(direction_format))
+		{
+			LOGW("Vertex quantization: {} vertex buffers are not supported, normals and tangents are kept as floats", vkb::to_string(direction_format));
+			quantization_options->quantize_directions = false;
+		}
+		if (quantization_options->quantize_texcoords && !is_vertex_format_supported(VK_FORMAT_R16G16_SFLOAT))
+		{
+			LOGW("Vertex quantization: R16G16_SFLOAT vertex buffers are not supported, texture coordinates are kept as floats");
+			quantization_options->quantize_texcoords = false;
+		}
+	}
+
 	// Load meshes
 	auto materials = scene.get_components<sg::PBRMaterial>();
 
-	for (auto &gltf_mesh : model.meshes)
+	// Totals over all optimized primitives, for the ACMR and ATVR of the whole scene
+	MeshOptimizerReport optimization_totals;
+	size_t              optimized_primitive_count = 0;
+	size_t              triangle_count            = 0;
+
+	size_t vertex_bytes_before_quantization = 0;
+	size_t vertex_bytes_after_quantization  = 0;
+
+	for (size_t mesh_index = 0; mesh_index < model.meshes.size(); ++mesh_index)
 	{
 		PROFILE_SCOPE("Processing Mesh");
 
+		auto &gltf_mesh = model.meshes[mesh_index];
+
 		auto mesh = parse_mesh(gltf_mesh);
 
 		for (size_t i_primitive = 0; i_primitive < gltf_mesh.primitives.size(); i_primitive++)
@@ -745,33 +1107,79 @@ sg::Scene GLTFLoader::load_scene(int scene_index, VkBufferUsageFlags additional_
 			auto submesh_name = fmt::format("'{}' mesh, primitive #{}", gltf_mesh.name, i_primitive);
 			auto submesh      = std::make_unique<sg::SubMesh>(std::move(submesh_name));
 
+			std::unique_ptr<OptimizedPrimitive> optimized;
+			if (mesh_optimizer_options)
+			{
+				optimized = optimized_primitive_futures[mesh_index][i_primitive].get();
+			}
+			PrimitiveData *optimized_data = optimized ? &optimized->data : nullptr;
+
+			// Read all attributes first, quantized normals and tangents depend on the range of the positions
+			std::vector<VertexStream> vertex_streams;
+			size_t                    attribute_index = 0;
+			for (auto &attribute : gltf_primitive.attributes)
+			{
+				if (optimized_data)
+				{
+					vertex_streams.push_back(std::move(optimized_data->streams[attribute_index]));
+				}
+				else
+				{
+					vertex_streams.push_back({get_attribute_data(&model, attribute.second), get_attribute_stride(&model, attribute.second)});
+				}
+				++attribute_index;
+			}
+
+			std::optional<PositionQuantization> position_quantization;
+			if (quantization_options && quantization_options->quantize_positions)
+			{
+				auto position_it = gltf_primitive.attributes.find("POSITION");
+				if (position_it != gltf_primitive.attributes.end() && model.accessors[position_it->second].componentType == TINYGLTF_COMPONENT_TYPE_FLOAT &&
+				    model.accessors[position_it->second].type == TINYGLTF_TYPE_VEC3)
+				{
+					auto &positions       = vertex_streams[std::distance(gltf_primitive.attributes.begin(), position_it)];
+					position_quantization = get_position_quantization(positions, positions.data.size() / positions.stride);
+					submesh->set_position_quantization(*position_quantization);
+				}
+			}
+
+			attribute_index = 0;
 			for (auto &attribute : gltf_primitive.attributes)
 			{
 				std::string attrib_name = attribute.first;
 				std::transform(attrib_name.begin(), attrib_name.end(), attrib_name.begin(), ::tolower);
 
-				auto vertex_data = get_attribute_data(&model, attribute.second);
+				auto &vertex_stream = vertex_streams[attribute_index++];
 
 				if (attrib_name == "position")
 				{
 					assert(attribute.second < model.accessors.size());
-					submesh->vertices_count = to_u32(model.accessors[attribute.second].count);
+					submesh->vertices_count = optimized_data ? to_u32(vertex_stream.data.size() / vertex_stream.stride) :
+					                                           to_u32(model.accessors[attribute.second].count);
+				}
+
+				sg::VertexAttribute attrib;
+				attrib.format = get_attribute_format(&model, attribute.second);
+				attrib.stride = to_u32(get_attribute_stride(&model, attribute.second));
+
+				if (quantization_options)
+				{
+					vertex_bytes_before_quantization += vertex_stream.data.size();
+					quantize_attribute(attrib_name, model.accessors[attribute.second], *quantization_options,
+					                   position_quantization ? &*position_quantization : nullptr, vertex_stream, attrib);
+					vertex_bytes_after_quantization += vertex_stream.data.size();
 				}
 
 				vkb::core::BufferC buffer{device,
-				                          vertex_data.size(),
+				                          vertex_stream.data.size(),
 				                          VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | additional_buffer_usage_flags,
 				                          VMA_MEMORY_USAGE_CPU_TO_GPU};
-				buffer.update(vertex_data);
+				buffer.update(vertex_stream.data);
 				buffer.set_debug_name(fmt::format("'{}' mesh, primitive #{}: '{}' vertex buffer",
 				                                  gltf_mesh.name, i_primitive, attrib_name));
 
 				submesh->vertex_buffers.insert(std::make_pair(attrib_name, std::move(buffer)));
 
-				sg::VertexAttribute attrib;
-				attrib.format = get_attribute_format(&model, attribute.second);
-				attrib.stride = to_u32(get_attribute_stride(&model, attribute.second));
-
 				submesh->set_attribute(attrib_name, attrib);
 			}
 
@@ -781,7 +1189,35 @@ sg::Scene GLTFLoader::load_scene(int scene_index, VkBufferUsageFlags additional_
 
 				auto format = get_attribute_format(&model, gltf_primitive.indices);
 
-				auto index_data = get_attribute_data(&model, gltf_primitive.indices);
+				std::vector<uint8_t> index_data;
+
+				if (!optimized_data)
+				{
+					index_data = get_attribute_data(&model, gltf_primitive.indices);
+				}
+				else
+				{
+					// Keep the original index width, welding and the fetch remap only reduce the vertex count
+					auto &indices = optimized_data->indices;
+					if (format == VK_FORMAT_R32_UINT)
+					{
+						index_data.assign(reinterpret_cast<const uint8_t *>(indices.data()), reinterpret_cast<const uint8_t *>(indices.data() + indices.size()));
+					}
+					else
+					{
+						std::vector<uint16_t> narrow_indices(indices.begin(), indices.end());
+						index_data.assign(reinterpret_cast<const uint8_t *>(narrow_indices.data()), reinterpret_cast<const uint8_t *>(narrow_indices.data() + narrow_indices.size()));
+						format = VK_FORMAT_R16_UINT;
+					}
+
+					auto &report = optimized->report;
+					optimization_totals.before.vertices_transformed += report.before.vertices_transformed;
+					optimization_totals.after.vertices_transformed += report.after.vertices_transformed;
+					optimization_totals.vertex_count_before += report.vertex_count_before;
+					optimization_totals.vertex_count_after += report.vertex_count_after;
+					triangle_count += indices.size() / 3;
+					++optimized_primitive_count;
+				}
 
 				switch (format)
 				{
@@ -833,6 +1269,28 @@ sg::Scene GLTFLoader::load_scene(int scene_index, VkBufferUsageFlags additional_
 		scene.add_component(std::move(mesh));
 	}
 
+	if (mesh_optimizer_options && triangle_count > 0)
+	{
+		auto &totals = optimization_totals;
+		LOGI("Optimized {} primitives in {} seconds: ACMR {:.3f} -> {:.3f}, ATVR {:.3f} -> {:.3f}, {} -> {} vertices",
+		     optimized_primitive_count,
+		     vkb::to_string(timer.stop()),
+		     static_cast<float>(totals.before.vertices_transformed) / triangle_count,
+		     static_cast<float>(totals.after.vertices_transformed) / triangle_count,
+		     static_cast<float>(totals.before.vertices_transformed) / totals.vertex_count_before,
+		     static_cast<float>(totals.after.vertices_transformed) / totals.vertex_count_after,
+		     totals.vertex_count_before,
+		     totals.vertex_count_after);
+	}
+
+	if (quantization_options && vertex_bytes_before_quantization > 0)
+	{
+		LOGI("Quantized vertex attributes: {} -> {} KiB ({:.1f}%)",
+		     vertex_bytes_before_quantization / 1024,
+		     vertex_bytes_after_quantization / 1024,
+		     100.0 * vertex_bytes_after_quantization / vertex_bytes_before_quantization);
+	}
+
 	device.get_fence_pool().wait();
 	device.get_fence_pool().reset();
 	device.get_command_pool().reset_pool();
@@ -1103,15 +1561,11 @@ std::unique_ptr<sg::SubMesh> GLTFLoader::load_model(uint32_t index, bool storage
 {
 	PROFILE_SCOPE("Process Model");
 
-	auto submesh = std::make_unique<sg::SubMesh>();
-
-	std::vector<vkb::core::BufferC> transient_buffers;
-
-	auto &queue = device.get_queue_by_flags(VK_QUEUE_GRAPHICS_BIT, 0);
+	vkb::allocated::MemoryCategoryScope memory_category{vkb::allocated::MemoryCategory::SceneGeometry};
 
-	auto command_buffer = device.request_command_buffer();
+	auto submesh = std::make_unique<sg::SubMesh>();
 
-	command_buffer->begin(VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT);
+	auto &upload_service = device.get_upload_service();
 
 	assert(index < model.meshes.size());
 	auto &gltf_mesh = model.meshes[index];
@@ -1138,6 +1592,11 @@ std::unique_ptr<sg::SubMesh> GLTFLoader::load_model(uint32_t index, bool storage
 
 	submesh->vertices_count = static_cast<uint32_t>(vertex_count);
 
+	for (size_t v = 0; v < vertex_count; v++)
+	{
+		submesh->bounding_radius = std::max(submesh->bounding_radius, glm::length(glm::make_vec3(&pos[v * 3])));
+	}
+
 	if (gltf_primitive.attributes.find("NORMAL") != gltf_primitive.attributes.end())
 	{
 		accessor    = model.accessors[gltf_primitive.attributes.find("NORMAL")->second];
@@ -1188,19 +1647,15 @@ std::unique_ptr<sg::SubMesh> GLTFLoader::load_model(uint32_t index, bool storage
 			aligned_vertex_data.push_back(vert);
 		}
 
-		vkb::core::BufferC stage_buffer = vkb::core::BufferC::create_staging_buffer(device, aligned_vertex_data);
-
 		vkb::core::BufferC buffer{device,
 		                          aligned_vertex_data.size() * sizeof(AlignedVertex),
 		                          VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
 		                          VMA_MEMORY_USAGE_GPU_ONLY};
 
-		command_buffer->copy_buffer(stage_buffer, buffer, aligned_vertex_data.size() * sizeof(AlignedVertex));
+		upload_service.upload_buffer(buffer.get_handle(), aligned_vertex_data.data(), aligned_vertex_data.size() * sizeof(AlignedVertex));
 
 		auto pair = std::make_pair("vertex_buffer", std::move(buffer));
 		submesh->vertex_buffers.insert(std::move(pair));
-
-		transient_buffers.push_back(std::move(stage_buffer));
 	}
 	else
 	{
@@ -1231,19 +1686,15 @@ std::unique_ptr<sg::SubMesh> GLTFLoader::load_model(uint32_t index, bool storage
 			vertex_data.push_back(vert);
 		}
 
-		vkb::core::BufferC stage_buffer = vkb::core::BufferC::create_staging_buffer(device, vertex_data);
-
 		vkb::core::BufferC buffer{device,
 		                          vertex_data.size() * sizeof(Vertex),
 		                          VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_VERTEX_BUFFER_BIT,
 		                          VMA_MEMORY_USAGE_GPU_ONLY};
 
-		command_buffer->copy_buffer(stage_buffer, buffer, vertex_data.size() * sizeof(Vertex));
+		upload_service.upload_buffer(buffer.get_handle(), vertex_data.data(), vertex_data.size() * sizeof(Vertex));
 
 		auto pair = std::make_pair("vertex_buffer", std::move(buffer));
 		submesh->vertex_buffers.insert(std::move(pair));
-
-		transient_buffers.push_back(std::move(stage_buffer));
 	}
 
 	if (gltf_primitive.indices >= 0)
@@ -1282,45 +1733,42 @@ std::unique_ptr<sg::SubMesh> GLTFLoader::load_model(uint32_t index, bool storage
 		if (storage_buffer)
 		{
 			// prepare meshlets
-			std::vector<Meshlet> meshlets;
-			prepare_meshlets(meshlets, submesh, index_data);
+			std::vector<Meshlet>       meshlets;
+			std::vector<MeshletBounds> meshlet_bounds;
+			prepare_meshlets(meshlets, meshlet_bounds, aligned_vertex_data, index_data);
 
 			// vertex_indices and index_buffer are used for meshlets now
 			submesh->vertex_indices = static_cast<uint32_t>(meshlets.size());
 
-			vkb::core::BufferC stage_buffer = vkb::core::BufferC::create_staging_buffer(device, meshlets);
-
 			submesh->index_buffer = std::make_unique<vkb::core::BufferC>(device,
 			                                                             meshlets.size() * sizeof(Meshlet),
 			                                                             VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
 			                                                             VMA_MEMORY_USAGE_GPU_ONLY);
 
-			command_buffer->copy_buffer(stage_buffer, *submesh->index_buffer, meshlets.size() * sizeof(Meshlet));
+			upload_service.upload_buffer(submesh->index_buffer->get_handle(), meshlets.data(), meshlets.size() * sizeof(Meshlet));
+
+			// Bounding spheres and normal cones for per meshlet culling, one MeshletBounds per meshlet
+			vkb::core::BufferC bounds_buffer{device,
+			                                 meshlet_bounds.size() * sizeof(MeshletBounds),
+			                                 VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
+			                                 VMA_MEMORY_USAGE_GPU_ONLY};
 
-			transient_buffers.push_back(std::move(stage_buffer));
+			upload_service.upload_buffer(bounds_buffer.get_handle(), meshlet_bounds.data(), meshlet_bounds.size() * sizeof(MeshletBounds));
+
+			submesh->vertex_buffers.insert(std::make_pair("meshlet_bounds", std::move(bounds_buffer)));
 		}
 		else
 		{
-			vkb::core::BufferC stage_buffer = vkb::core::BufferC::create_staging_buffer(device, index_data);
-
 			submesh->index_buffer = std::make_unique<vkb::core::BufferC>(device,
 			                                                             index_data.size(),
 			                                                             VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_INDEX_BUFFER_BIT,
 			                                                             VMA_MEMORY_USAGE_GPU_ONLY);
 
-			command_buffer->copy_buffer(stage_buffer, *submesh->index_buffer, index_data.size());
-
-			transient_buffers.push_back(std::move(stage_buffer));
+			upload_service.upload_buffer(submesh->index_buffer->get_handle(), index_data.data(), index_data.size());
 		}
 	}
 
-	command_buffer->end();
-
-	queue.submit(*command_buffer, device.request_fence());
-
-	device.get_fence_pool().wait();
-	device.get_fence_pool().reset();
-	device.get_command_pool().reset_pool();
+	upload_service.flush();
 
 	return std::move(submesh);
 }
@@ -1402,64 +1850,15 @@ std::unique_ptr<sg::PBRMaterial> GLTFLoader::parse_material(const tinygltf::Mate
 {
 	auto material = std::make_unique<sg::PBRMaterial>(gltf_material.name);
 
-	// Initialize base color to 1.0f as per glTF spec
-	material->base_color_factor = glm::vec4(1.0f);
-
-	for (auto &gltf_value : gltf_material.values)
-	{
-		if (gltf_value.first == "baseColorFactor")
-		{
-			const auto &color_factor    = gltf_value.second.ColorFactor();
-			material->base_color_factor = glm::vec4(color_factor[0], color_factor[1], color_factor[2], color_factor[3]);
-		}
-		else if (gltf_value.first == "metallicFactor")
-		{
-			material->metallic_factor = static_cast<float>(gltf_value.second.Factor());
-		}
-		else if (gltf_value.first == "roughnessFactor")
-		{
-			material->roughness_factor = static_cast<float>(gltf_value.second.Factor());
-		}
-	}
-
-	for (auto &gltf_value : gltf_material.additionalValues)
-	{
-		if (gltf_value.first == "emissiveFactor")
-		{
-			const auto &emissive_factor = gltf_value.second.number_array;
-
-			material->emissive = glm::vec3(emissive_factor[0], emissive_factor[1], emissive_factor[2]);
-		}
-		else if (gltf_value.first == "alphaMode")
-		{
-			if (gltf_value.second.string_value == "BLEND")
-			{
-				material->alpha_mode = vkb::sg::AlphaMode::Blend;
-			}
-			else if (gltf_value.second.string_value == "OPAQUE")
-			{
-				material->alpha_mode = vkb::sg::AlphaMode::Opaque;
-			}
-			else if (gltf_value.second.string_value == "MASK")
-			{
-				material->alpha_mode = vkb::sg::AlphaMode::Mask;
-			}
-		}
-		else if (gltf_value.first == "alphaCutoff")
-		{
-			material->alpha_cutoff = static_cast<float>(gltf_value.second.number_value);
-		}
-		else if (gltf_value.first == "doubleSided")
-		{
-			material->double_sided = gltf_value.second.bool_value;
-		}
-	}
+	read_material_factors(gltf_material, *material);
 
 	return material;
 }
 
 std::unique_ptr<sg::Image> GLTFLoader::parse_image(tinygltf::Image &gltf_image) const
 {
+	PROFILE_SCOPE("Load Image");
+
 	std::unique_ptr<sg::Image> image{nullptr};
 
 	if (!gltf_image.image.empty())
@@ -1501,23 +1900,7 @@ std::unique_ptr<sg::Sampler> GLTFLoader::parse_sampler(const tinygltf::Sampler &
 {
 	auto name = gltf_sampler.name;
 
-	VkFilter min_filter = find_min_filter(gltf_sampler.minFilter);
-	VkFilter mag_filter = find_mag_filter(gltf_sampler.magFilter);
-
-	VkSamplerMipmapMode mipmap_mode = find_mipmap_mode(gltf_sampler.minFilter);
-
-	VkSamplerAddressMode address_mode_u = find_wrap_mode(gltf_sampler.wrapS);
-	VkSamplerAddressMode address_mode_v = find_wrap_mode(gltf_sampler.wrapT);
-
-	VkSamplerCreateInfo sampler_info{VK_STRUCTURE_TYPE_SAMPLER_CREATE_INFO};
-
-	sampler_info.magFilter    = mag_filter;
-	sampler_info.minFilter    = min_filter;
-	sampler_info.mipmapMode   = mipmap_mode;
-	sampler_info.addressModeU = address_mode_u;
-	sampler_info.addressModeV = address_mode_v;
-	sampler_info.borderColor  = VK_BORDER_COLOR_FLOAT_OPAQUE_WHITE;
-	sampler_info.maxLod       = std::numeric_limits<float>::max();
+	VkSamplerCreateInfo sampler_info = get_sampler_create_info(gltf_sampler);
 
 	core::Sampler vk_sampler{device, sampler_info};
 	vk_sampler.set_debug_name(gltf_sampler.name);
@@ -1568,103 +1951,7 @@ std::vector<std::unique_ptr<sg::Light>> GLTFLoader::parse_khr_lights_punctual()
 {
 	if (is_extension_enabled(KHR_LIGHTS_PUNCTUAL_EXTENSION))
 	{
-		if (model.extensions.find(KHR_LIGHTS_PUNCTUAL_EXTENSION) == model.extensions.end() || !model.extensions.at(KHR_LIGHTS_PUNCTUAL_EXTENSION).Has("lights"))
-		{
-			return {};
-		}
-		auto &khr_lights = model.extensions.at(KHR_LIGHTS_PUNCTUAL_EXTENSION).Get("lights");
-
-		std::vector<std::unique_ptr<sg::Light>> light_components(khr_lights.ArrayLen());
-
-		for (size_t light_index = 0; light_index < khr_lights.ArrayLen(); ++light_index)
-		{
-			auto &khr_light = khr_lights.Get(static_cast<int>(light_index));
-
-			// Spec states a light has to have a type to be valid
-			if (!khr_light.Has("type"))
-			{
-				LOGE("KHR_lights_punctual extension: light {} doesn't have a type!", light_index);
-				throw std::runtime_error("Couldn't load glTF file, KHR_lights_punctual extension is invalid");
-			}
-
-			auto light = std::make_unique<sg::Light>(khr_light.Get("name").Get<std::string>());
-
-			sg::LightType       type;
-			sg::LightProperties properties;
-
-			// Get type
-			auto &gltf_light_type = khr_light.Get("type").Get<std::string>();
-			if (gltf_light_type == "point")
-			{
-				type = sg::LightType::Point;
-			}
-			else if (gltf_light_type == "spot")
-			{
-				type = sg::LightType::Spot;
-			}
-			else if (gltf_light_type == "directional")
-			{
-				type = sg::LightType::Directional;
-			}
-			else
-			{
-				LOGE("KHR_lights_punctual extension: light type '{}' is invalid", gltf_light_type);
-				throw std::runtime_error("Couldn't load glTF file, KHR_lights_punctual extension is invalid");
-			}
-
-			// Get properties
-			if (khr_light.Has("color"))
-			{
-				properties.color = glm::vec3(
-				    static_cast<float>(khr_light.Get("color").Get(0).Get<double>()),
-				    static_cast<float>(khr_light.Get("color").Get(1).Get<double>()),
-				    static_cast<float>(khr_light.Get("color").Get(2).Get<double>()));
-			}
-
-			if (khr_light.Has("intensity"))
-			{
-				properties.intensity = static_cast<float>(khr_light.Get("intensity").Get<double>());
-			}
-
-			if (type != sg::LightType::Directional)
-			{
-				properties.range = static_cast<float>(khr_light.Get("range").Get<double>());
-				if (type != sg::LightType::Point)
-				{
-					if (!khr_light.Has("spot"))
-					{
-						LOGE("KHR_lights_punctual extension: spot light doesn't have a 'spot' property set", gltf_light_type);
-						throw std::runtime_error("Couldn't load glTF file, KHR_lights_punctual extension is invalid");
-					}
-
-					properties.inner_cone_angle = static_cast<float>(khr_light.Get("spot").Get("innerConeAngle").Get<double>());
-
-					if (khr_light.Get("spot").Has("outerConeAngle"))
-					{
-						properties.outer_cone_angle = static_cast<float>(khr_light.Get("spot").Get("outerConeAngle").Get<double>());
-					}
-					else
-					{
-						// Spec states default value is PI/4
-						properties.outer_cone_angle = glm::pi<float>() / 4.0f;
-					}
-				}
-			}
-			else if (type == sg::LightType::Directional || type == sg::LightType::Spot)
-			{
-				// The spec states that the light will inherit the transform of the node.
-				// The light's direction is defined as the 3-vector (0.0, 0.0, -1.0) and
-				// the rotation of the node orients the light accordingly.
-				properties.direction = glm::vec3(0.0f, 0.0f, -1.0f);
-			}
-
-			light->set_light_type(type);
-			light->set_properties(properties);
-
-			light_components[light_index] = std::move(light);
-		}
-
-		return light_components;
+		return read_khr_lights_punctual(model);
 	}
 	else
 	{
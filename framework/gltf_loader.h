@@ -20,12 +20,16 @@
 
 #include <memory>
 #include <mutex>
+#include <optional>
 
 #define TINYGLTF_NO_STB_IMAGE
 #define TINYGLTF_NO_STB_IMAGE_WRITE
 #define TINYGLTF_NO_EXTERNAL_IMAGE
 #include <tiny_gltf.h>
 
+#include "common/vk_common.h"
+#include "geometry/mesh_optimizer.h"
+#include "geometry/vertex_quantization.h"
 #include "timer.h"
 
 #include "vulkan/vulkan.h"
@@ -35,6 +39,7 @@
 namespace vkb
 {
 class Device;
+class UploadService;
 
 namespace sg
 {
@@ -65,6 +70,57 @@ struct TypeCast
 	}
 };
 
+/**
+ * @brief Vertex streams and indices of a glTF primitive, widened to 32-bit indices
+ */
+struct PrimitiveData
+{
+	/// Lower case attribute names, in the order of tinygltf::Primitive::attributes
+	std::vector<std::string> attribute_names;
+
+	std::vector<VertexStream> streams;
+
+	std::vector<uint32_t> indices;
+};
+
+/**
+ * @brief Reads the attributes and indices of an indexed triangle list primitive
+ * @return False if the primitive is not an indexed triangle list, has morph targets, has positions
+ *         that are not three floats or has indices past the last vertex
+ */
+bool read_primitive_data(const tinygltf::Model &model, const tinygltf::Primitive &primitive, PrimitiveData &data);
+
+/**
+ * @return Vulkan format of the elements of a glTF accessor
+ */
+VkFormat get_accessor_format(const tinygltf::Model &model, uint32_t accessor_index);
+
+/**
+ * @return Filters and address modes of a glTF sampler
+ */
+VkSamplerCreateInfo get_sampler_create_info(const tinygltf::Sampler &gltf_sampler);
+
+/**
+ * @return Whether a glTF material texture holds color encoded with the sRGB transfer function
+ */
+bool texture_needs_srgb_colorspace(const std::string &name);
+
+/**
+ * @brief Sets the factors, alpha mode and sidedness of a material, textures are left to the caller
+ */
+void read_material_factors(const tinygltf::Material &gltf_material, sg::PBRMaterial &material);
+
+/**
+ * @return Lights of the KHR_lights_punctual extension, in the order nodes reference them
+ */
+std::vector<std::unique_ptr<sg::Light>> read_khr_lights_punctual(const tinygltf::Model &model);
+
+/**
+ * @brief Uploads all mip levels of an image and transitions it for sampling, in the open batch of the upload service
+ *        The CPU copy of the image data is released
+ */
+void upload_image_to_gpu(UploadService &upload_service, sg::Image &image);
+
 /// Read a gltf file and return a scene object. Converts the gltf objects
 /// to our internal scene implementation. Mesh data is copied to vulkan buffers and
 /// images are loaded from the folder of gltf file to vulkan images.
@@ -77,9 +133,24 @@ class GLTFLoader
 
 	std::unique_ptr<sg::Scene> read_scene_from_file(const std::string &file_name, int scene_index = -1, VkBufferUsageFlags additional_buffer_usage_flags = 0);
 
+	/**
+	 * @brief Optimizes the indexed triangle lists of the scenes loaded afterwards for the vertex cache, overdraw and vertex fetch
+	 *        The ACMR and ATVR before and after the optimization are logged
+	 */
+	void enable_mesh_optimization(const MeshOptimizerOptions &options = {});
+
+	/**
+	 * @brief Stores the float vertex attributes of the scenes loaded afterwards in narrower formats
+	 *        Positions are dequantized by prepending sg::SubMesh::get_position_quantization to the model matrix,
+	 *        which GeometrySubpass does. Other consumers of the vertex buffers must handle the formats themselves
+	 */
+	void enable_vertex_quantization(const VertexQuantizationOptions &options = {});
+
 	/**
 	 * @brief Loads the first model from a GLTF file for use in simpler samples
 	 *        makes use of the Vertex struct in vulkan_example_base.h
+	 *        With storage_buffer set, the index buffer holds Meshlet structs and the "meshlet_bounds"
+	 *        buffer the MeshletBounds of every meshlet
 	 */
 	std::unique_ptr<sg::SubMesh> read_model_from_file(const std::string &file_name, uint32_t index, bool storage_buffer = false, VkBufferUsageFlags additional_buffer_usage_flags = 0);
 
@@ -134,6 +205,12 @@ class GLTFLoader
 	static std::unordered_map<std::string, bool> supported_extensions;
 
   private:
+	/// Set with enable_mesh_optimization
+	std::optional<MeshOptimizerOptions> mesh_optimizer_options;
+
+	/// Set with enable_vertex_quantization
+	std::optional<VertexQuantizationOptions> vertex_quantization_options;
+
 	sg::Scene load_scene(int scene_index = -1, VkBufferUsageFlags additional_buffer_usage_flags = 0);
 
 	std::unique_ptr<sg::SubMesh> load_model(uint32_t index, bool storage_buffer = false, VkBufferUsageFlags additional_buffer_usage_flags = 0);
@@ -100,6 +100,8 @@ Gui::Gui(VulkanSampleC &sample_, const Window &window, const Stats *stats, const
     explicit_update{explicit_update},
     stats_view(stats)
 {
+	allocated::MemoryCategoryScope memory_category{allocated::MemoryCategory::Gui};
+
 	ImGui::CreateContext();
 
 	ImGuiStyle &style = ImGui::GetStyle();
@@ -388,6 +390,8 @@ void Gui::update(const float delta_time)
 
 bool Gui::update_buffers()
 {
+	allocated::MemoryCategoryScope memory_category{allocated::MemoryCategory::Gui};
+
 	ImDrawData *draw_data = ImGui::GetDrawData();
 	bool        updated   = false;
 
@@ -974,6 +978,11 @@ void Gui::show_stats(const Stats &stats)
 			ImGui::Text("%s", graph_label.str().c_str());
 		}
 	}
+
+	for (const auto &counter : stats.get_registered_counters())
+	{
+		ImGui::Text(counter.is_gauge ? "%s: %.1f" : "%s: %.1f/s", counter.name, counter.value);
+	}
 }
 
 void Gui::show_options_window(std::function<void()> body, const uint32_t lines)
@@ -27,7 +27,8 @@
 
 namespace vkb
 {
-HeightMap::HeightMap(const std::string &file_name, const uint32_t patchsize)
+HeightMap::HeightMap(const std::string &file_name, const uint32_t patchsize) :
+    patch_size{patchsize}
 {
 	std::string file_path = fs::path::get(fs::path::Assets, file_name);
 
@@ -41,26 +42,49 @@ HeightMap::HeightMap(const std::string &file_name, const uint32_t patchsize)
 	ktx_uint8_t *ktx_image = ktxTexture_GetData(ktx_texture);
 
 	dim  = ktx_texture->baseWidth;
-	data = new uint16_t[dim * dim];
+	data.resize(dim * dim);
 
-	memcpy(data, ktx_image, ktx_size);
+	memcpy(data.data(), ktx_image, std::min<size_t>(ktx_size, data.size() * sizeof(uint16_t)));
 
 	this->scale = dim / patchsize;
 
 	ktxTexture_Destroy(ktx_texture);
 }
 
-HeightMap::~HeightMap()
+float HeightMap::get_height(const uint32_t x, const uint32_t y)
 {
-	delete[] data;
+	return sample(static_cast<int32_t>(x), static_cast<int32_t>(y));
 }
 
-float HeightMap::get_height(const uint32_t x, const uint32_t y)
+float HeightMap::sample(int32_t x, int32_t y) const
 {
 	glm::ivec2 rpos = glm::ivec2(x, y) * glm::ivec2(scale);
 	rpos.x          = std::max(0, std::min(rpos.x, static_cast<int>(dim) - 1));
 	rpos.y          = std::max(0, std::min(rpos.y, static_cast<int>(dim) - 1));
 	rpos /= glm::ivec2(scale);
-	return *(data + (rpos.x + rpos.y * dim) * scale) / 65535.0f;
+	return data[(rpos.x + rpos.y * dim) * scale] / 65535.0f;
+}
+
+std::vector<glm::vec3> HeightMap::generate_normals(const SobelNormalParams &params, size_t thread_count) const
+{
+	// Gather the heights once, including a one sample border, instead of sampling 9 times per normal
+	const uint32_t     stride = patch_size + 2;
+	std::vector<float> heights(static_cast<size_t>(stride) * stride);
+	for (uint32_t y = 0; y < stride; ++y)
+	{
+		for (uint32_t x = 0; x < stride; ++x)
+		{
+			heights[x + y * stride] = sample(static_cast<int32_t>(x) - 1, static_cast<int32_t>(y) - 1);
+		}
+	}
+
+	std::vector<glm::vec3> normals;
+	compute_sobel_normals(heights, patch_size, patch_size, normals, params, thread_count);
+	return normals;
+}
+
+uint32_t HeightMap::get_dimension() const
+{
+	return dim;
 }
 }        // namespace vkb
@@ -19,6 +19,9 @@
 
 #include <ktx.h>
 #include <string>
+#include <vector>
+
+#include "terrain/sobel_normals.h"
 
 namespace vkb
 {
@@ -35,8 +38,6 @@ class HeightMap
 	 */
 	HeightMap(const std::string &filename, const uint32_t patchsize);
 
-	~HeightMap();
-
 	/**
 	 * @brief Retrieves a value from the heightmap at a specific coordinates
 	 * @param x The x coordinate
@@ -45,11 +46,26 @@ class HeightMap
 	 */
 	float get_height(const uint32_t x, const uint32_t y);
 
+	/**
+	 * @brief Computes the normals of a patch_size x patch_size grid with a Sobel filter
+	 *        Samples outside of the heightmap are clamped to its edges
+	 * @param params Parameters of the Sobel filter
+	 * @param thread_count Number of threads, 0 selects the hardware concurrency
+	 * @returns Row-major normals, indexed by x + y * patch_size
+	 */
+	std::vector<glm::vec3> generate_normals(const SobelNormalParams &params = {}, size_t thread_count = 0) const;
+
+	uint32_t get_dimension() const;
+
   private:
-	uint16_t *data;
+	float sample(int32_t x, int32_t y) const;
+
+	std::vector<uint16_t> data;
 
 	uint32_t dim;
 
 	uint32_t scale;
+
+	uint32_t patch_size;
 };
 }        // namespace vkb
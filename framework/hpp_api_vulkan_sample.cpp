@@ -18,6 +18,7 @@
 
 #include "hpp_api_vulkan_sample.h"
 #include "core/hpp_queue.h"
+#include "upload_service.h"
 
 // Instantiate the default dispatcher
 VULKAN_HPP_DEFAULT_DISPATCH_LOADER_DYNAMIC_STORAGE
@@ -878,12 +879,6 @@ HPPTexture HPPApiVulkanSample::load_texture(const std::string &file, vkb::scene_
 	texture.image = vkb::scene_graph::components::HPPImage::load(file, file, content_type);
 	texture.image->create_vk_image(get_device());
 
-	const auto &queue = get_device().get_queue_by_flags(vk::QueueFlagBits::eGraphics, 0);
-
-	vk::CommandBuffer command_buffer = get_device().create_command_buffer(vk::CommandBufferLevel::ePrimary, true);
-
-	vkb::core::BufferCpp stage_buffer = vkb::core::BufferCpp::create_staging_buffer(get_device(), texture.image->get_data());
-
 	// Setup buffer copy regions for each mip level
 	std::vector<vk::BufferImageCopy> bufferCopyRegions;
 
@@ -906,23 +901,16 @@ HPPTexture HPPApiVulkanSample::load_texture(const std::string &file, vkb::scene_
 
 	vk::ImageSubresourceRange subresource_range{vk::ImageAspectFlagBits::eColor, 0, vkb::to_u32(mipmaps.size()), 0, 1};
 
-	// Image barrier for optimal image (target)
-	// Optimal image will be used as destination for the copy
-	vkb::common::image_layout_transition(
-	    command_buffer, texture.image->get_vk_image().get_handle(), vk::ImageLayout::eUndefined, vk::ImageLayout::eTransferDstOptimal, subresource_range);
-
-	// Copy mip levels from staging buffer
-	command_buffer.copyBufferToImage(
-	    stage_buffer.get_handle(), texture.image->get_vk_image().get_handle(), vk::ImageLayout::eTransferDstOptimal, bufferCopyRegions);
-
-	// Change texture image layout to shader read after all mip levels have been copied
-	vkb::common::image_layout_transition(command_buffer,
-	                                     texture.image->get_vk_image().get_handle(),
-	                                     vk::ImageLayout::eTransferDstOptimal,
-	                                     vk::ImageLayout::eShaderReadOnlyOptimal,
-	                                     subresource_range);
-
-	get_device().flush_command_buffer(command_buffer, queue.get_handle());
+	// Copy mip levels through the staging ring and transition them to shader read, the copies are submitted without
+	// waiting for them, work submitted to the graphics queue afterwards sees the texture
+	auto &upload_service = get_device().get_upload_service();
+	upload_service.upload_image(static_cast<VkImage>(texture.image->get_vk_image().get_handle()),
+	                            static_cast<VkFormat>(texture.image->get_format()),
+	                            static_cast<VkImageSubresourceRange const &>(subresource_range),
+	                            texture.image->get_data().data(),
+	                            texture.image->get_data().size(),
+	                            reinterpret_cast<std::vector<VkBufferImageCopy> const &>(bufferCopyRegions));
+	upload_service.flush();
 
 	texture.sampler = create_default_sampler(address_mode, mipmaps.size(), texture.image->get_format());
 
@@ -936,12 +924,6 @@ HPPTexture HPPApiVulkanSample::load_texture_array(const std::string &file, vkb::
 	texture.image = vkb::scene_graph::components::HPPImage::load(file, file, content_type);
 	texture.image->create_vk_image(get_device(), vk::ImageViewType::e2DArray);
 
-	const auto &queue = get_device().get_queue_by_flags(vk::QueueFlagBits::eGraphics, 0);
-
-	vk::CommandBuffer command_buffer = get_device().create_command_buffer(vk::CommandBufferLevel::ePrimary, true);
-
-	vkb::core::BufferCpp stage_buffer = vkb::core::BufferCpp::create_staging_buffer(get_device(), texture.image->get_data());
-
 	// Setup buffer copy regions for each mip level
 	std::vector<vk::BufferImageCopy> buffer_copy_regions;
 
@@ -970,23 +952,16 @@ HPPTexture HPPApiVulkanSample::load_texture_array(const std::string &file, vkb::
 
 	vk::ImageSubresourceRange subresource_range{vk::ImageAspectFlagBits::eColor, 0, vkb::to_u32(mipmaps.size()), 0, layers};
 
-	// Image barrier for optimal image (target)
-	// Optimal image will be used as destination for the copy
-	vkb::common::image_layout_transition(
-	    command_buffer, texture.image->get_vk_image().get_handle(), vk::ImageLayout::eUndefined, vk::ImageLayout::eTransferDstOptimal, subresource_range);
-
-	// Copy mip levels from staging buffer
-	command_buffer.copyBufferToImage(
-	    stage_buffer.get_handle(), texture.image->get_vk_image().get_handle(), vk::ImageLayout::eTransferDstOptimal, buffer_copy_regions);
-
-	// Change texture image layout to shader read after all mip levels have been copied
-	vkb::common::image_layout_transition(command_buffer,
-	                                     texture.image->get_vk_image().get_handle(),
-	                                     vk::ImageLayout::eTransferDstOptimal,
-	                                     vk::ImageLayout::eShaderReadOnlyOptimal,
-	                                     subresource_range);
-
-	get_device().flush_command_buffer(command_buffer, queue.get_handle());
+	// Copy mip levels through the staging ring and transition them to shader read, the copies are submitted without
+	// waiting for them, work submitted to the graphics queue afterwards sees the texture
+	auto &upload_service = get_device().get_upload_service();
+	upload_service.upload_image(static_cast<VkImage>(texture.image->get_vk_image().get_handle()),
+	                            static_cast<VkFormat>(texture.image->get_format()),
+	                            static_cast<VkImageSubresourceRange const &>(subresource_range),
+	                            texture.image->get_data().data(),
+	                            texture.image->get_data().size(),
+	                            reinterpret_cast<std::vector<VkBufferImageCopy> const &>(buffer_copy_regions));
+	upload_service.flush();
 
 	texture.sampler = create_default_sampler(address_mode, mipmaps.size(), texture.image->get_format());
 
@@ -1000,12 +975,6 @@ HPPTexture HPPApiVulkanSample::load_texture_cubemap(const std::string &file, vkb
 	texture.image = vkb::scene_graph::components::HPPImage::load(file, file, content_type);
 	texture.image->create_vk_image(get_device(), vk::ImageViewType::eCube, vk::ImageCreateFlagBits::eCubeCompatible);
 
-	const auto &queue = get_device().get_queue_by_flags(vk::QueueFlagBits::eGraphics, 0);
-
-	vk::CommandBuffer command_buffer = get_device().create_command_buffer(vk::CommandBufferLevel::ePrimary, true);
-
-	vkb::core::BufferCpp stage_buffer = vkb::core::BufferCpp::create_staging_buffer(get_device(), texture.image->get_data());
-
 	// Setup buffer copy regions for each mip level
 	std::vector<vk::BufferImageCopy> buffer_copy_regions;
 
@@ -1034,23 +1003,16 @@ HPPTexture HPPApiVulkanSample::load_texture_cubemap(const std::string &file, vkb
 
 	vk::ImageSubresourceRange subresource_range{vk::ImageAspectFlagBits::eColor, 0, vkb::to_u32(mipmaps.size()), 0, layers};
 
-	// Image barrier for optimal image (target)
-	// Optimal image will be used as destination for the copy
-	vkb::common::image_layout_transition(
-	    command_buffer, texture.image->get_vk_image().get_handle(), vk::ImageLayout::eUndefined, vk::ImageLayout::eTransferDstOptimal, subresource_range);
-
-	// Copy mip levels from staging buffer
-	command_buffer.copyBufferToImage(
-	    stage_buffer.get_handle(), texture.image->get_vk_image().get_handle(), vk::ImageLayout::eTransferDstOptimal, buffer_copy_regions);
-
-	// Change texture image layout to shader read after all mip levels have been copied
-	vkb::common::image_layout_transition(command_buffer,
-	                                     texture.image->get_vk_image().get_handle(),
-	                                     vk::ImageLayout::eTransferDstOptimal,
-	                                     vk::ImageLayout::eShaderReadOnlyOptimal,
-	                                     subresource_range);
-
-	get_device().flush_command_buffer(command_buffer, queue.get_handle());
+	// Copy mip levels through the staging ring and transition them to shader read, the copies are submitted without
+	// waiting for them, work submitted to the graphics queue afterwards sees the texture
+	auto &upload_service = get_device().get_upload_service();
+	upload_service.upload_image(static_cast<VkImage>(texture.image->get_vk_image().get_handle()),
+	                            static_cast<VkFormat>(texture.image->get_format()),
+	                            static_cast<VkImageSubresourceRange const &>(subresource_range),
+	                            texture.image->get_data().data(),
+	                            texture.image->get_data().size(),
+	                            reinterpret_cast<std::vector<VkBufferImageCopy> const &>(buffer_copy_regions));
+	upload_service.flush();
 
 	texture.sampler = create_default_sampler(vk::SamplerAddressMode::eClampToEdge, mipmaps.size(), texture.image->get_format());
 
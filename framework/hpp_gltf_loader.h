@@ -44,6 +44,16 @@ class HPPGLTFLoader : private vkb::GLTFLoader
 		    vkb::GLTFLoader::read_model_from_file(file_name, index, storage_buffer, static_cast<VkBufferUsageFlags>(additional_buffer_usage_flags)).release()));
 	}
 
+	void enable_mesh_optimization(const MeshOptimizerOptions &options = {})
+	{
+		vkb::GLTFLoader::enable_mesh_optimization(options);
+	}
+
+	void enable_vertex_quantization(const VertexQuantizationOptions &options = {})
+	{
+		vkb::GLTFLoader::enable_vertex_quantization(options);
+	}
+
 	std::unique_ptr<vkb::scene_graph::HPPScene> read_scene_from_file(const std::string &file_name, int scene_index = -1)
 	{
 		return std::unique_ptr<vkb::scene_graph::HPPScene>(reinterpret_cast<vkb::scene_graph::HPPScene *>(vkb::GLTFLoader::read_scene_from_file(file_name, scene_index).release()));
@@ -134,6 +134,7 @@ HPPGui::HPPGui(VulkanSampleCpp &sample_, const vkb::Window &window, const vkb::s
 	    vkb::core::HPPImageBuilder(to_u32(tex_width), to_u32(tex_height))
 	        .with_format(vk::Format::eR8G8B8A8Unorm)
 	        .with_usage(vk::ImageUsageFlagBits::eSampled | vk::ImageUsageFlagBits::eTransferDst)
+	        .with_memory_category(vkb::allocated::MemoryCategory::Gui)
 	        .with_debug_name("GUI font image")
 	        .build_unique(device);
 
@@ -236,6 +237,7 @@ HPPGui::HPPGui(VulkanSampleCpp &sample_, const vkb::Window &window, const vkb::s
 		    vkb::core::BufferBuilderCpp(1)
 		        .with_usage(vk::BufferUsageFlagBits::eVertexBuffer)
 		        .with_vma_usage(VMA_MEMORY_USAGE_GPU_TO_CPU)
+		        .with_memory_category(vkb::allocated::MemoryCategory::Gui)
 		        .with_debug_name("GUI vertex buffer")
 		        .build_unique(device);
 
@@ -243,6 +245,7 @@ HPPGui::HPPGui(VulkanSampleCpp &sample_, const vkb::Window &window, const vkb::s
 		    vkb::core::BufferBuilderCpp(1)
 		        .with_usage(vk::BufferUsageFlagBits::eIndexBuffer)
 		        .with_vma_usage(VMA_MEMORY_USAGE_GPU_TO_CPU)
+		        .with_memory_category(vkb::allocated::MemoryCategory::Gui)
 		        .with_debug_name("GUI index buffer")
 		        .build_unique(device);
 	}
@@ -362,6 +365,8 @@ void HPPGui::update(const float delta_time)
 
 bool HPPGui::update_buffers()
 {
+	vkb::allocated::MemoryCategoryScope memory_category{vkb::allocated::MemoryCategory::Gui};
+
 	ImDrawData *draw_data = ImGui::GetDrawData();
 	bool        updated   = false;
 
@@ -913,6 +918,11 @@ void HPPGui::show_stats(const vkb::stats::HPPStats &stats)
 			ImGui::Text("%s", graph_label.str().c_str());
 		}
 	}
+
+	for (const auto &counter : stats.get_registered_counters())
+	{
+		ImGui::Text(counter.is_gauge ? "%s: %.1f" : "%s: %.1f/s", counter.name, counter.value);
+	}
 }
 
 void HPPGui::show_options_window(std::function<void()> body, const uint32_t lines) const
@@ -0,0 +1,45 @@
+/* Copyright (c) 2025, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <scene_package_loader.h>
+
+#include <core/hpp_device.h>
+#include <scene_graph/hpp_scene.h>
+
+namespace vkb
+{
+/**
+ * @brief facade class around vkb::ScenePackageLoader, providing a vulkan.hpp-based interface
+ *
+ * See vkb::ScenePackageLoader for documentation
+ */
+class HPPScenePackageLoader : private vkb::ScenePackageLoader
+{
+  public:
+	HPPScenePackageLoader(vkb::core::HPPDevice &device) :
+	    ScenePackageLoader(reinterpret_cast<vkb::Device &>(device))
+	{}
+
+	std::unique_ptr<vkb::scene_graph::HPPScene> read_scene_from_file(const std::string &file_name, vk::BufferUsageFlags additional_buffer_usage_flags = {})
+	{
+		return std::unique_ptr<vkb::scene_graph::HPPScene>(reinterpret_cast<vkb::scene_graph::HPPScene *>(
+		    vkb::ScenePackageLoader::read_scene_from_file(file_name, static_cast<VkBufferUsageFlags>(additional_buffer_usage_flags)).release()));
+	}
+};
+}        // namespace vkb
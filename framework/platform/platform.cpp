@@ -31,6 +31,7 @@
 #include <spdlog/sinks/stdout_color_sinks.h>
 
 #include "core/util/logging.hpp"
+#include "core/util/profiling.hpp"
 #include "force_close/force_close.h"
 #include "platform/plugins/plugin.h"
 #include "vulkan_sample.h"
@@ -260,6 +261,8 @@ ExitCode Platform::main_loop()
 
 void Platform::update()
 {
+	PROFILE_SCOPE("Frame");
+
 	auto delta_time = static_cast<float>(timer.tick<Timer::Seconds>());
 
 	if (focused || always_render)
@@ -17,6 +17,9 @@
  */
 
 #include "rendering/hpp_render_context.h"
+
+#include <core/util/profiling.hpp>
+
 #include "buffer_pool.h"
 #include "core/command_buffer.h"
 #include "core/hpp_physical_device.h"
@@ -259,6 +262,8 @@ void HPPRenderContext::submit(vkb::core::CommandBufferCpp &command_buffer)
 
 void HPPRenderContext::submit(const std::vector<vkb::core::CommandBufferCpp *> &command_buffers)
 {
+	PROFILE_SCOPE("Submit frame");
+
 	assert(frame_active && "HPPRenderContext is inactive, cannot submit command buffer. Please call begin()");
 
 	vk::Semaphore render_semaphore;
@@ -278,6 +283,8 @@ void HPPRenderContext::submit(const std::vector<vkb::core::CommandBufferCpp *> &
 
 void HPPRenderContext::begin_frame()
 {
+	PROFILE_SCOPE("Begin frame");
+
 	// Only handle surface changes if a swapchain exists
 	if (swapchain)
 	{
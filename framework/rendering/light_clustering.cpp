@@ -0,0 +1,478 @@
+/* Copyright (c) 2025, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "rendering/light_clustering.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <thread>
+
+#include "common/parallel.h"
+#include "common/utils.h"
+#include "core/command_buffer.h"
+#include "scene_graph/components/light.h"
+#include "scene_graph/components/perspective_camera.h"
+#include "scene_graph/components/transform.h"
+#include "scene_graph/node.h"
+
+namespace vkb
+{
+namespace rendering
+{
+namespace
+{
+// Point lights without a range fade out where their attenuated contribution drops below this value, as in
+// get_point_light_range (shaders/includes/glsl/lighting.h)
+constexpr float light_influence_threshold = 1.0f / 256.0f;
+
+// Distance scale applied in apply_point_light (shaders/includes/glsl/lighting.h)
+constexpr float point_light_distance_scale = 0.005f;
+
+float get_light_radius(const Light &light)
+{
+	auto type = static_cast<sg::LightType>(static_cast<int>(light.position.w));
+
+	if (light.direction.w > 0.0f)
+	{
+		return light.direction.w;
+	}
+
+	if (type == sg::LightType::Point)
+	{
+		float max_component = std::max({light.color.r, light.color.g, light.color.b}) * light.color.w;
+		return std::sqrt(std::max(max_component, 0.0f) / light_influence_threshold) / point_light_distance_scale;
+	}
+
+	// Spot lights do not attenuate with distance, without a range they can reach every cluster
+	return std::numeric_limits<float>::infinity();
+}
+
+float distance_squared_to_box(const glm::vec3 &point, const glm::vec3 &box_min, const glm::vec3 &box_max)
+{
+	glm::vec3 closest = glm::clamp(point, box_min, box_max);
+	glm::vec3 delta   = point - closest;
+	return glm::dot(delta, delta);
+}
+}        // namespace
+
+LightClustering::LightClustering(const glm::uvec3 &grid_size, uint32_t max_lights_per_cluster, size_t thread_count) :
+    grid_size{grid_size},
+    max_lights_per_cluster{max_lights_per_cluster},
+    thread_count{thread_count}
+{
+	assert(grid_size.x > 0 && grid_size.y > 0 && grid_size.z > 0 && "Cluster grid cannot be empty");
+
+	if (this->thread_count == 0)
+	{
+		this->thread_count = std::max(1u, std::thread::hardware_concurrency());
+	}
+
+	// No point in having more jobs than depth slices
+	this->thread_count = std::min<size_t>(this->thread_count, grid_size.z);
+
+	job_ranges.resize(this->thread_count);
+	job_indices.resize(this->thread_count);
+}
+
+LightClustering::~LightClustering() = default;
+
+void LightClustering::build(const std::vector<sg::Light *> &scene_lights, sg::PerspectiveCamera &camera, const VkExtent2D &extent)
+{
+	std::vector<Light> converted_lights;
+	converted_lights.reserve(scene_lights.size());
+
+	// Directional lights go first, they are applied to every fragment
+	uint32_t directional_light_count = 0;
+	for (bool directional : {true, false})
+	{
+		for (auto *scene_light : scene_lights)
+		{
+			if ((scene_light->get_light_type() == sg::LightType::Directional) != directional)
+			{
+				continue;
+			}
+
+			const auto &properties = scene_light->get_properties();
+			auto       &transform  = scene_light->get_node()->get_transform();
+
+			converted_lights.push_back({{transform.get_translation(), static_cast<float>(scene_light->get_light_type())},
+			                            {properties.color, properties.intensity},
+			                            {transform.get_rotation() * properties.direction, properties.range},
+			                            {properties.inner_cone_angle, properties.outer_cone_angle}});
+
+			directional_light_count += directional ? 1 : 0;
+		}
+	}
+
+	build(std::move(converted_lights),
+	      directional_light_count,
+	      camera.get_view(),
+	      vulkan_style_projection(camera.get_projection()),
+	      camera.get_near_plane(),
+	      camera.get_far_plane(),
+	      extent);
+}
+
+void LightClustering::build(std::vector<Light> &&lights_,
+                            uint32_t            directional_light_count,
+                            const glm::mat4    &view,
+                            const glm::mat4    &projection,
+                            float               near_plane,
+                            float               far_plane,
+                            const VkExtent2D   &extent)
+{
+	assert(near_plane > 0.0f && far_plane > near_plane && "Clustering requires a perspective camera with positive depth range");
+	assert(directional_light_count <= lights_.size());
+
+	lights = std::move(lights_);
+
+	update_cluster_bounds(projection, near_plane, far_plane);
+
+	float log_depth_ratio = std::log(far_plane / near_plane);
+
+	uniform.view         = view;
+	uniform.grid_size    = glm::uvec4(grid_size, directional_light_count);
+	uniform.screen_scale = glm::vec4(static_cast<float>(grid_size.x) / extent.width, static_cast<float>(grid_size.y) / extent.height, 0.0f, 0.0f);
+	uniform.depth_params = glm::vec4(grid_size.z / log_depth_ratio,
+	                                 -static_cast<float>(grid_size.z) * std::log(near_plane) / log_depth_ratio,
+	                                 near_plane,
+	                                 far_plane);
+
+	// Compute the cluster range each light overlaps, the directional lights are skipped
+	light_bounds.resize(lights.size());
+
+	size_t bounded_count = lights.size() - directional_light_count;
+	size_t chunk_size    = (bounded_count + thread_count - 1) / thread_count;
+
+	parallel_for(thread_count, thread_count, 1, [&](size_t first_job, size_t last_job) {
+		for (size_t job = first_job; job < last_job; ++job)
+		{
+			size_t begin = std::min(lights.size(), directional_light_count + job * chunk_size);
+			size_t end   = std::min(lights.size(), begin + chunk_size);
+			for (size_t i = begin; i < end; ++i)
+			{
+				light_bounds[i] = compute_light_bounds(lights[i], view, projection);
+			}
+		}
+	});
+
+	for (uint32_t i = 0; i < directional_light_count; ++i)
+	{
+		light_bounds[i].visible = false;
+	}
+
+	// Each job owns a contiguous range of depth slices
+	uint32_t slices_per_job = to_u32((grid_size.z + thread_count - 1) / thread_count);
+
+	std::vector<uint32_t> job_overflow(thread_count, 0);
+
+	parallel_for(thread_count, thread_count, 1, [&](size_t first_job, size_t last_job) {
+		for (size_t job = first_job; job < last_job; ++job)
+		{
+			uint32_t first_slice = std::min(grid_size.z, to_u32(job) * slices_per_job);
+			uint32_t last_slice  = std::min(grid_size.z, first_slice + slices_per_job);
+			job_overflow[job]    = bin_slices(first_slice, last_slice, job_ranges[job], job_indices[job]);
+		}
+	});
+
+	// Stitch the per job results together, offsets are relative to the job's index list
+	uint32_t cluster_count = grid_size.x * grid_size.y * grid_size.z;
+	cluster_ranges.resize(cluster_count);
+	light_indices.clear();
+	overflow_count = 0;
+
+	uint32_t slice_cluster_count = grid_size.x * grid_size.y;
+	for (size_t job = 0; job < thread_count; ++job)
+	{
+		uint32_t first_slice = std::min(grid_size.z, to_u32(job) * slices_per_job);
+		uint32_t base_offset = to_u32(light_indices.size());
+
+		for (size_t i = 0; i < job_ranges[job].size(); ++i)
+		{
+			auto range = job_ranges[job][i];
+			range.offset += base_offset;
+			cluster_ranges[first_slice * slice_cluster_count + i] = range;
+		}
+
+		light_indices.insert(light_indices.end(), job_indices[job].begin(), job_indices[job].end());
+		overflow_count += job_overflow[job];
+	}
+}
+
+void LightClustering::update_cluster_bounds(const glm::mat4 &projection, float near_plane, float far_plane)
+{
+	glm::vec2 depth_range{near_plane, far_plane};
+	if (!cluster_bounds.empty() && projection == cached_projection && depth_range == cached_depth_range)
+	{
+		return;
+	}
+
+	cached_projection  = projection;
+	cached_depth_range = depth_range;
+
+	cluster_bounds.resize(grid_size.x * grid_size.y * grid_size.z);
+
+	// Unprojects a NDC position at the given view depth, assuming a perspective projection with w = -z
+	auto unproject = [&projection](float ndc_x, float ndc_y, float depth) {
+		return glm::vec3{depth * (ndc_x + projection[2][0]) / projection[0][0],
+		                 depth * (ndc_y + projection[2][1]) / projection[1][1],
+		                 -depth};
+	};
+
+	float depth_ratio = far_plane / near_plane;
+
+	for (uint32_t z = 0; z < grid_size.z; ++z)
+	{
+		float slice_near = near_plane * std::pow(depth_ratio, static_cast<float>(z) / grid_size.z);
+		float slice_far  = near_plane * std::pow(depth_ratio, static_cast<float>(z + 1) / grid_size.z);
+
+		for (uint32_t y = 0; y < grid_size.y; ++y)
+		{
+			float ndc_y0 = 2.0f * y / grid_size.y - 1.0f;
+			float ndc_y1 = 2.0f * (y + 1) / grid_size.y - 1.0f;
+
+			for (uint32_t x = 0; x < grid_size.x; ++x)
+			{
+				float ndc_x0 = 2.0f * x / grid_size.x - 1.0f;
+				float ndc_x1 = 2.0f * (x + 1) / grid_size.x - 1.0f;
+
+				ClusterBounds bounds{glm::vec3{std::numeric_limits<float>::max()}, glm::vec3{std::numeric_limits<float>::lowest()}};
+
+				for (float depth : {slice_near, slice_far})
+				{
+					for (const auto &corner : {unproject(ndc_x0, ndc_y0, depth), unproject(ndc_x1, ndc_y0, depth),
+					                     unproject(ndc_x0, ndc_y1, depth), unproject(ndc_x1, ndc_y1, depth)})
+					{
+						bounds.min = glm::min(bounds.min, corner);
+						bounds.max = glm::max(bounds.max, corner);
+					}
+				}
+
+				cluster_bounds[(z * grid_size.y + y) * grid_size.x + x] = bounds;
+			}
+		}
+	}
+}
+
+LightClustering::LightBounds LightClustering::compute_light_bounds(const Light &light, const glm::mat4 &view, const glm::mat4 &projection) const
+{
+	LightBounds bounds{};
+	bounds.view_center = glm::vec3(view * glm::vec4(glm::vec3(light.position), 1.0f));
+	bounds.radius      = get_light_radius(light);
+
+	float near_plane = cached_depth_range.x;
+	float far_plane  = cached_depth_range.y;
+
+	float center_depth = -bounds.view_center.z;
+	float min_depth    = center_depth - bounds.radius;
+	float max_depth    = center_depth + bounds.radius;
+
+	bounds.visible = max_depth >= near_plane && min_depth <= far_plane;
+	if (!bounds.visible)
+	{
+		return bounds;
+	}
+
+	auto depth_to_slice = [&](float depth) {
+		depth = glm::clamp(depth, near_plane, far_plane);
+		float slice = std::log(depth) * uniform.depth_params.x + uniform.depth_params.y;
+		return std::min(grid_size.z - 1, static_cast<uint32_t>(std::max(slice, 0.0f)));
+	};
+
+	bounds.min_cluster = {0, 0, depth_to_slice(min_depth)};
+	bounds.max_cluster = {grid_size.x - 1, grid_size.y - 1, depth_to_slice(max_depth)};
+
+	// A sphere crossing the near plane can cover the whole screen, keep the full x and y range
+	if (std::isinf(bounds.radius) || min_depth <= near_plane)
+	{
+		return bounds;
+	}
+
+	// Project the corners of the view space bounding box of the sphere
+	glm::vec2 ndc_min{std::numeric_limits<float>::max()};
+	glm::vec2 ndc_max{std::numeric_limits<float>::lowest()};
+	for (uint32_t corner = 0; corner < 8; ++corner)
+	{
+		glm::vec3 offset{(corner & 1) ? bounds.radius : -bounds.radius,
+		                 (corner & 2) ? bounds.radius : -bounds.radius,
+		                 (corner & 4) ? bounds.radius : -bounds.radius};
+
+		glm::vec4 clip = projection * glm::vec4(bounds.view_center + offset, 1.0f);
+		glm::vec2 ndc  = glm::vec2(clip) / clip.w;
+
+		ndc_min = glm::min(ndc_min, ndc);
+		ndc_max = glm::max(ndc_max, ndc);
+	}
+
+	if (ndc_max.x < -1.0f || ndc_min.x > 1.0f || ndc_max.y < -1.0f || ndc_min.y > 1.0f)
+	{
+		bounds.visible = false;
+		return bounds;
+	}
+
+	auto ndc_to_cluster = [](float ndc, uint32_t size) {
+		float cluster = (ndc * 0.5f + 0.5f) * size;
+		return std::min(size - 1, static_cast<uint32_t>(std::max(cluster, 0.0f)));
+	};
+
+	bounds.min_cluster.x = ndc_to_cluster(ndc_min.x, grid_size.x);
+	bounds.min_cluster.y = ndc_to_cluster(ndc_min.y, grid_size.y);
+	bounds.max_cluster.x = ndc_to_cluster(ndc_max.x, grid_size.x);
+	bounds.max_cluster.y = ndc_to_cluster(ndc_max.y, grid_size.y);
+
+	return bounds;
+}
+
+uint32_t LightClustering::bin_slices(uint32_t first_slice, uint32_t last_slice, std::vector<ClusterRange> &ranges, std::vector<uint32_t> &indices) const
+{
+	uint32_t slice_cluster_count = grid_size.x * grid_size.y;
+	uint32_t first_cluster       = first_slice * slice_cluster_count;
+
+	ranges.assign((last_slice - first_slice) * slice_cluster_count, ClusterRange{0, 0});
+
+	// Visits every cluster of this job's slices that a light actually touches
+	auto for_each_cluster = [&](const LightBounds &light, auto &&func) {
+		if (light.max_cluster.z < first_slice || light.min_cluster.z >= last_slice)
+		{
+			return;
+		}
+
+		uint32_t z_begin = std::max(first_slice, light.min_cluster.z);
+		uint32_t z_end   = std::min(last_slice - 1, light.max_cluster.z);
+		for (uint32_t z = z_begin; z <= z_end; ++z)
+		{
+			for (uint32_t y = light.min_cluster.y; y <= light.max_cluster.y; ++y)
+			{
+				for (uint32_t x = light.min_cluster.x; x <= light.max_cluster.x; ++x)
+				{
+					uint32_t    cluster_index = (z * grid_size.y + y) * grid_size.x + x;
+					const auto &cluster       = cluster_bounds[cluster_index];
+					if (std::isinf(light.radius) ||
+					    distance_squared_to_box(light.view_center, cluster.min, cluster.max) <= light.radius * light.radius)
+					{
+						func(ranges[cluster_index - first_cluster]);
+					}
+				}
+			}
+		}
+	};
+
+	// Count the lights of every cluster, so that each cluster gets a contiguous range
+	uint32_t overflow = 0;
+	for (const auto &light : light_bounds)
+	{
+		if (light.visible)
+		{
+			for_each_cluster(light, [&](ClusterRange &range) {
+				if (range.count < max_lights_per_cluster)
+				{
+					++range.count;
+				}
+				else
+				{
+					++overflow;
+				}
+			});
+		}
+	}
+
+	uint32_t offset = 0;
+	for (auto &range : ranges)
+	{
+		range.offset = offset;
+		offset += range.count;
+		range.count = 0;
+	}
+
+	// Fill the ranges, lights are visited in order so every cluster lists its lights in ascending order
+	indices.resize(offset);
+	for (uint32_t light_index = 0; light_index < light_bounds.size(); ++light_index)
+	{
+		const auto &light = light_bounds[light_index];
+		if (light.visible)
+		{
+			for_each_cluster(light, [&](ClusterRange &range) {
+				if (range.count < max_lights_per_cluster)
+				{
+					indices[range.offset + range.count++] = light_index;
+				}
+			});
+		}
+	}
+
+	return overflow;
+}
+
+void LightClustering::upload(vkb::rendering::RenderFrameC &render_frame, size_t thread_index)
+{
+	uniform_buffer = render_frame.allocate_buffer(VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT, sizeof(LightClusterUniform), thread_index);
+	uniform_buffer.update(uniform);
+
+	// Storage buffers cannot be empty, always allocate at least one element
+	auto upload_storage = [&](vkb::BufferAllocationC &allocation, const void *data, size_t size, size_t element_size) {
+		allocation = render_frame.allocate_buffer(VK_BUFFER_USAGE_STORAGE_BUFFER_BIT, std::max(size, element_size), thread_index);
+		if (size > 0)
+		{
+			allocation.get_buffer().update(data, size, to_u32(allocation.get_offset()));
+		}
+	};
+
+	upload_storage(light_buffer, lights.data(), lights.size() * sizeof(Light), sizeof(Light));
+	upload_storage(cluster_buffer, cluster_ranges.data(), cluster_ranges.size() * sizeof(ClusterRange), sizeof(ClusterRange));
+	upload_storage(index_buffer, light_indices.data(), light_indices.size() * sizeof(uint32_t), sizeof(uint32_t));
+}
+
+void LightClustering::bind(vkb::core::CommandBufferC &command_buffer, uint32_t set, uint32_t first_binding)
+{
+	command_buffer.bind_buffer(uniform_buffer.get_buffer(), uniform_buffer.get_offset(), uniform_buffer.get_size(), set, first_binding, 0);
+	command_buffer.bind_buffer(light_buffer.get_buffer(), light_buffer.get_offset(), light_buffer.get_size(), set, first_binding + 1, 0);
+	command_buffer.bind_buffer(cluster_buffer.get_buffer(), cluster_buffer.get_offset(), cluster_buffer.get_size(), set, first_binding + 2, 0);
+	command_buffer.bind_buffer(index_buffer.get_buffer(), index_buffer.get_offset(), index_buffer.get_size(), set, first_binding + 3, 0);
+}
+
+const std::vector<LightClustering::ClusterRange> &LightClustering::get_cluster_ranges() const
+{
+	return cluster_ranges;
+}
+
+const glm::uvec3 &LightClustering::get_grid_size() const
+{
+	return grid_size;
+}
+
+const std::vector<uint32_t> &LightClustering::get_light_indices() const
+{
+	return light_indices;
+}
+
+const std::vector<Light> &LightClustering::get_lights() const
+{
+	return lights;
+}
+
+const LightClusterUniform &LightClustering::get_uniform() const
+{
+	return uniform;
+}
+
+uint32_t LightClustering::get_overflow_count() const
+{
+	return overflow_count;
+}
+}        // namespace rendering
+}        // namespace vkb
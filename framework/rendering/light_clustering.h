@@ -0,0 +1,213 @@
+/* Copyright (c) 2025, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "buffer_pool.h"
+#include "common/glm_common.h"
+#include "rendering/subpass.h"
+
+namespace vkb
+{
+namespace core
+{
+template <vkb::BindingType bindingType>
+class CommandBuffer;
+using CommandBufferC = CommandBuffer<vkb::BindingType::C>;
+}        // namespace core
+
+namespace sg
+{
+class Light;
+class PerspectiveCamera;
+}        // namespace sg
+
+namespace rendering
+{
+/**
+ * @brief Uniform data the clustered lighting shaders need to find the cluster of a fragment
+ *        Mirrors the ClusterInfo block in shaders/includes/glsl/clustered_lighting.h
+ */
+struct alignas(16) LightClusterUniform
+{
+	glm::mat4 view;
+
+	// xyz: number of clusters along each axis, w: number of directional lights at the start of the light buffer
+	glm::uvec4 grid_size;
+
+	// xy: clusters per pixel along x and y
+	glm::vec4 screen_scale;
+
+	// x: slice scale, y: slice bias, z: near plane, w: far plane
+	glm::vec4 depth_params;
+};
+
+/**
+ * @brief Bins the lights of a scene into a 3D froxel grid aligned with the camera frustum
+ *
+ * The grid is divided uniformly in screen space and exponentially in view depth. Each cluster
+ * stores an (offset, count) pair into a compact list of light indices, which lets the shaders only
+ * evaluate the lights that can reach the fragment. Directional lights are not binned, they are
+ * stored at the start of the light buffer and applied to every fragment.
+ *
+ * Binning runs on the shared worker threads of vkb::parallel_for, each job owning a contiguous range of
+ * depth slices, so the output is identical regardless of the number of threads.
+ */
+class LightClustering
+{
+  public:
+	/**
+	 * @brief Range of a single cluster within the light index list
+	 */
+	struct ClusterRange
+	{
+		uint32_t offset;
+		uint32_t count;
+	};
+
+	/**
+	 * @param grid_size Number of clusters along the x, y and depth axes
+	 * @param max_lights_per_cluster Upper bound of lights evaluated by a single fragment
+	 * @param thread_count Number of jobs binning is split into, 0 selects the hardware concurrency
+	 */
+	LightClustering(const glm::uvec3 &grid_size = {16, 9, 24}, uint32_t max_lights_per_cluster = 128, size_t thread_count = 0);
+
+	LightClustering(const LightClustering &)            = delete;
+	LightClustering(LightClustering &&)                 = delete;
+	~LightClustering();
+	LightClustering &operator=(const LightClustering &) = delete;
+	LightClustering &operator=(LightClustering &&)      = delete;
+
+	/**
+	 * @brief Converts the scene lights and bins them into the cluster grid
+	 * @param scene_lights All of the light components from the scene graph
+	 * @param camera Camera the grid is aligned with
+	 * @param extent Size of the render target in pixels
+	 */
+	void build(const std::vector<sg::Light *> &scene_lights, sg::PerspectiveCamera &camera, const VkExtent2D &extent);
+
+	/**
+	 * @brief Bins already converted lights into the cluster grid
+	 * @param lights All lights, directional lights are expected to be at the start of the list
+	 * @param directional_light_count Number of directional lights at the start of lights
+	 * @param view View matrix of the camera
+	 * @param projection Vulkan style projection matrix of the camera
+	 * @param near_plane Distance to the near plane of the camera
+	 * @param far_plane Distance to the far plane of the camera
+	 * @param extent Size of the render target in pixels
+	 */
+	void build(std::vector<Light> &&lights,
+	           uint32_t            directional_light_count,
+	           const glm::mat4    &view,
+	           const glm::mat4    &projection,
+	           float               near_plane,
+	           float               far_plane,
+	           const VkExtent2D   &extent);
+
+	/**
+	 * @brief Copies the result of the last build to buffers allocated from the render frame
+	 * @param render_frame Frame to allocate the transient buffers from
+	 * @param thread_index Index of the buffer pool to be used by the current thread
+	 */
+	void upload(vkb::rendering::RenderFrameC &render_frame, size_t thread_index = 0);
+
+	/**
+	 * @brief Binds the uploaded buffers to four consecutive bindings
+	 *        (cluster uniform, lights, cluster ranges, light indices)
+	 */
+	void bind(vkb::core::CommandBufferC &command_buffer, uint32_t set, uint32_t first_binding);
+
+	const std::vector<ClusterRange> &get_cluster_ranges() const;
+
+	const glm::uvec3 &get_grid_size() const;
+
+	const std::vector<uint32_t> &get_light_indices() const;
+
+	const std::vector<Light> &get_lights() const;
+
+	const LightClusterUniform &get_uniform() const;
+
+	/**
+	 * @return The number of lights that did not fit in a cluster during the last build
+	 */
+	uint32_t get_overflow_count() const;
+
+  private:
+	struct LightBounds
+	{
+		glm::vec3  view_center;
+		float      radius;
+		glm::uvec3 min_cluster;
+		glm::uvec3 max_cluster;
+		bool       visible;
+	};
+
+	struct ClusterBounds
+	{
+		glm::vec3 min;
+		glm::vec3 max;
+	};
+
+	void update_cluster_bounds(const glm::mat4 &projection, float near_plane, float far_plane);
+
+	LightBounds compute_light_bounds(const Light &light, const glm::mat4 &view, const glm::mat4 &projection) const;
+
+	uint32_t bin_slices(uint32_t first_slice, uint32_t last_slice, std::vector<ClusterRange> &ranges, std::vector<uint32_t> &indices) const;
+
+	glm::uvec3 grid_size;
+
+	uint32_t max_lights_per_cluster;
+
+	size_t thread_count;
+
+	/// View space bounds of every cluster, rebuilt only when the projection changes
+	std::vector<ClusterBounds> cluster_bounds;
+
+	glm::mat4 cached_projection{0.0f};
+
+	glm::vec2 cached_depth_range{0.0f};
+
+	std::vector<Light> lights;
+
+	std::vector<LightBounds> light_bounds;
+
+	std::vector<ClusterRange> cluster_ranges;
+
+	std::vector<uint32_t> light_indices;
+
+	/// Per job scratch, kept between builds to avoid reallocations
+	std::vector<std::vector<ClusterRange>> job_ranges;
+
+	std::vector<std::vector<uint32_t>> job_indices;
+
+	uint32_t overflow_count{0};
+
+	LightClusterUniform uniform{};
+
+	vkb::BufferAllocationC uniform_buffer;
+
+	vkb::BufferAllocationC light_buffer;
+
+	vkb::BufferAllocationC cluster_buffer;
+
+	vkb::BufferAllocationC index_buffer;
+};
+}        // namespace rendering
+}        // namespace vkb
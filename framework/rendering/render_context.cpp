@@ -17,6 +17,8 @@
 
 #include "render_context.h"
 
+#include <core/util/profiling.hpp>
+
 #include "platform/window.h"
 
 namespace vkb
@@ -288,6 +290,8 @@ void RenderContext::submit(std::shared_ptr<vkb::core::CommandBufferC> command_bu
 
 void RenderContext::submit(const std::vector<std::shared_ptr<vkb::core::CommandBufferC>> &command_buffers)
 {
+	PROFILE_SCOPE("Submit frame");
+
 	assert(frame_active && "RenderContext is inactive, cannot submit command buffer. Please call begin()");
 
 	VkSemaphore render_semaphore = VK_NULL_HANDLE;
@@ -307,6 +311,8 @@ void RenderContext::submit(const std::vector<std::shared_ptr<vkb::core::CommandB
 
 void RenderContext::begin_frame()
 {
+	PROFILE_SCOPE("Begin frame");
+
 	// Only handle surface changes if a swapchain exists
 	if (swapchain)
 	{
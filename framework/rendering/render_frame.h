@@ -17,6 +17,11 @@
 
 #pragma once
 
+#include <algorithm>
+#include <chrono>
+
+#include <core/util/counters.hpp>
+
 #include "buffer_pool.h"
 #include "common/hpp_resource_caching.h"
 #include "core/command_pool.h"
@@ -101,6 +106,16 @@ class RenderFrame
 	vkb::core::CommandPool<bindingType> &get_command_pool(
 	    QueueType const &queue, vkb::CommandBufferResetMode reset_mode = vkb::CommandBufferResetMode::ResetPool, size_t thread_index = 0);
 
+	/**
+	 * @return The time all threads spent in request_descriptor_set since the frame was last reset
+	 */
+	std::chrono::duration<double> get_descriptor_request_time() const;
+
+	/**
+	 * @return The number of calls to request_descriptor_set since the frame was last reset
+	 */
+	uint32_t get_descriptor_request_count() const;
+
 	DeviceType              &get_device();
 	FencePoolType           &get_fence_pool();
 	FencePoolType const     &get_fence_pool() const;
@@ -139,6 +154,12 @@ class RenderFrame
 	void update_render_target(std::unique_ptr<RenderTargetType> &&render_target);
 
   private:
+	/**
+	 * @brief Maps the buffer usages supporting transient allocations to an index into the per thread rings
+	 * @return The index of the ring, or -1 if the usage is not supported
+	 */
+	static int32_t get_transient_usage_index(vk::BufferUsageFlags usage);
+
 	vkb::BufferAllocationCpp   allocate_buffer_impl(vk::BufferUsageFlags usage, vk::DeviceSize size, size_t thread_index);
 	vkb::core::CommandPoolCpp &get_command_pool_impl(vkb::core::HPPQueue const &queue, vkb::CommandBufferResetMode reset_mode, size_t thread_index);
 
@@ -159,10 +180,13 @@ class RenderFrame
 
   private:
 	vkb::core::HPPDevice                                                                             &device;
-	std::map<vk::BufferUsageFlags, std::vector<std::pair<vkb::BufferPoolCpp, vkb::BufferBlockCpp *>>> buffer_pools;
-	std::map<uint32_t, std::vector<vkb::core::CommandPoolCpp>>                                        command_pools;           // Commands pools per queue family index
-	std::vector<std::unordered_map<std::size_t, vkb::core::HPPDescriptorPool>>                        descriptor_pools;        // Descriptor pools per thread
-	std::vector<std::unordered_map<std::size_t, vkb::core::HPPDescriptorSet>>                         descriptor_sets;         // Descriptor sets per thread
+	std::map<vk::BufferUsageFlags, std::vector<std::pair<vkb::BufferPoolCpp, vkb::BufferBlockCpp *>>> buffer_pools;                     // Used by BufferAllocationStrategy::OneAllocationPerBuffer
+	std::vector<std::vector<vkb::TransientBufferRingCpp>>                                             transient_rings;                  // Rings per thread, indexed by get_transient_usage_index
+	std::map<uint32_t, std::vector<vkb::core::CommandPoolCpp>>                                        command_pools;                    // Commands pools per queue family index
+	std::vector<std::unordered_map<std::size_t, vkb::core::HPPDescriptorPool>>                        descriptor_pools;                 // Descriptor pools per thread
+	std::vector<std::unordered_map<std::size_t, vkb::core::HPPDescriptorSet>>                         descriptor_sets;                  // Descriptor sets per thread
+	std::vector<std::chrono::steady_clock::duration>                                                  descriptor_request_times;         // Time spent in request_descriptor_set per thread
+	std::vector<uint32_t>                                                                             descriptor_request_counts;        // Calls to request_descriptor_set per thread
 	vkb::HPPFencePool                                                                                 fence_pool;
 	vkb::HPPSemaphorePool                                                                             semaphore_pool;
 	std::unique_ptr<vkb::rendering::HPPRenderTarget>                                                  swapchain_render_target;
@@ -176,7 +200,7 @@ using RenderFrameCpp = RenderFrame<vkb::BindingType::Cpp>;
 
 template <vkb::BindingType bindingType>
 inline RenderFrame<bindingType>::RenderFrame(DeviceType &device_, std::unique_ptr<RenderTargetType> &&render_target, size_t thread_count) :
-    device(reinterpret_cast<vkb::core::HPPDevice &>(device_)), fence_pool{device}, semaphore_pool{device}, thread_count{thread_count}, descriptor_pools(thread_count), descriptor_sets(thread_count)
+    device(reinterpret_cast<vkb::core::HPPDevice &>(device_)), fence_pool{device}, semaphore_pool{device}, thread_count{thread_count}, descriptor_pools(thread_count), descriptor_sets(thread_count), descriptor_request_times(thread_count), descriptor_request_counts(thread_count)
 {
 	static constexpr uint32_t BUFFER_POOL_BLOCK_SIZE = 256;        // Block size of a buffer pool in kilobytes
 
@@ -188,6 +212,23 @@ inline RenderFrame<bindingType>::RenderFrame(DeviceType &device_, std::unique_pt
 	    {vk::BufferUsageFlagBits::eIndexBuffer, 1}};
 
 	update_render_target(std::move(render_target));
+
+	static const std::array<vk::BufferUsageFlags, 4> transient_usages = {vk::BufferUsageFlagBits::eUniformBuffer,
+	                                                                     vk::BufferUsageFlagBits::eStorageBuffer,
+	                                                                     vk::BufferUsageFlagBits::eVertexBuffer,
+	                                                                     vk::BufferUsageFlagBits::eIndexBuffer};
+
+	transient_rings.resize(thread_count);
+	for (auto &thread_rings : transient_rings)
+	{
+		thread_rings.reserve(transient_usages.size());
+		for (auto usage : transient_usages)
+		{
+			assert(get_transient_usage_index(usage) == static_cast<int32_t>(thread_rings.size()));
+			thread_rings.emplace_back(device, BUFFER_POOL_BLOCK_SIZE * 1024 * supported_usage_map.at(usage), usage);
+		}
+	}
+
 	for (auto &usage_it : supported_usage_map)
 	{
 		auto [buffer_pools_it, inserted] = buffer_pools.emplace(usage_it.first, std::vector<std::pair<vkb::BufferPoolCpp, vkb::BufferBlockCpp *>>{});
@@ -221,9 +262,41 @@ inline BufferAllocation<bindingType> RenderFrame<bindingType>::allocate_buffer(B
 	}
 }
 
+template <vkb::BindingType bindingType>
+inline int32_t RenderFrame<bindingType>::get_transient_usage_index(vk::BufferUsageFlags usage)
+{
+	switch (static_cast<VkBufferUsageFlags>(usage))
+	{
+		case VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT:
+			return 0;
+		case VK_BUFFER_USAGE_STORAGE_BUFFER_BIT:
+			return 1;
+		case VK_BUFFER_USAGE_VERTEX_BUFFER_BIT:
+			return 2;
+		case VK_BUFFER_USAGE_INDEX_BUFFER_BIT:
+			return 3;
+		default:
+			return -1;
+	}
+}
+
 template <vkb::BindingType bindingType>
 inline vkb::BufferAllocationCpp RenderFrame<bindingType>::allocate_buffer_impl(vk::BufferUsageFlags usage, vk::DeviceSize size, size_t thread_index)
 {
+	if (buffer_allocation_strategy == BufferAllocationStrategy::MultipleAllocationsPerBuffer)
+	{
+		// Fast path: bump allocate from the ring of this thread, no lookups or locks involved
+		int32_t usage_index = get_transient_usage_index(usage);
+		if (usage_index < 0)
+		{
+			LOGE("No buffer pool for buffer usage {} ", vk::to_string(usage));
+			return vkb::BufferAllocationCpp{};
+		}
+
+		assert(thread_index < transient_rings.size());
+		return transient_rings[thread_index][usage_index].allocate(size);
+	}
+
 	// Find a pool for this usage
 	auto buffer_pool_it = buffer_pools.find(usage);
 	if (buffer_pool_it == buffer_pools.end())
@@ -236,14 +309,8 @@ inline vkb::BufferAllocationCpp RenderFrame<bindingType>::allocate_buffer_impl(v
 	auto &buffer_pool  = buffer_pool_it->second[thread_index].first;
 	auto &buffer_block = buffer_pool_it->second[thread_index].second;
 
-	bool want_minimal_block = (buffer_allocation_strategy == BufferAllocationStrategy::OneAllocationPerBuffer);
-
-	if (want_minimal_block || !buffer_block || !buffer_block->can_allocate(size))
-	{
-		// If we are creating a buffer for each allocation of there is no block associated with the pool or the current block is too small
-		// for this allocation, request a new buffer block
-		buffer_block = &buffer_pool.request_buffer_block(size, want_minimal_block);
-	}
+	// A buffer is created for each allocation, so always request a new minimal buffer block
+	buffer_block = &buffer_pool.request_buffer_block(size, true);
 
 	return buffer_block->allocate(to_u32(size));
 }
@@ -371,6 +438,28 @@ inline typename RenderFrame<bindingType>::FencePoolType const &RenderFrame<bindi
 	}
 }
 
+template <vkb::BindingType bindingType>
+inline std::chrono::duration<double> RenderFrame<bindingType>::get_descriptor_request_time() const
+{
+	std::chrono::steady_clock::duration total{0};
+	for (auto time : descriptor_request_times)
+	{
+		total += time;
+	}
+	return total;
+}
+
+template <vkb::BindingType bindingType>
+inline uint32_t RenderFrame<bindingType>::get_descriptor_request_count() const
+{
+	uint32_t total = 0;
+	for (auto count : descriptor_request_counts)
+	{
+		total += count;
+	}
+	return total;
+}
+
 template <vkb::BindingType bindingType>
 inline typename RenderFrame<bindingType>::RenderTargetType &RenderFrame<bindingType>::get_render_target()
 {
@@ -433,18 +522,29 @@ inline typename RenderFrame<bindingType>::DescriptorSetType RenderFrame<bindingT
 	assert(thread_index < thread_count && "Thread index is out of bounds");
 	assert(thread_index < descriptor_pools.size());
 
+	auto start = std::chrono::steady_clock::now();
+
+	vk::DescriptorSet descriptor_set;
 	if constexpr (bindingType == vkb::BindingType::Cpp)
 	{
-		return request_descriptor_set_impl(descriptor_set_layout, buffer_infos, image_infos, update_after_bind, thread_index);
+		descriptor_set = request_descriptor_set_impl(descriptor_set_layout, buffer_infos, image_infos, update_after_bind, thread_index);
 	}
 	else
 	{
-		return static_cast<VkDescriptorSet>(request_descriptor_set_impl(reinterpret_cast<vkb::core::HPPDescriptorSetLayout const &>(descriptor_set_layout),
-		                                                                reinterpret_cast<BindingMap<vk::DescriptorBufferInfo> const &>(buffer_infos),
-		                                                                reinterpret_cast<BindingMap<vk::DescriptorImageInfo> const &>(image_infos),
-		                                                                update_after_bind,
-		                                                                thread_index));
+		descriptor_set = request_descriptor_set_impl(reinterpret_cast<vkb::core::HPPDescriptorSetLayout const &>(descriptor_set_layout),
+		                                             reinterpret_cast<BindingMap<vk::DescriptorBufferInfo> const &>(buffer_infos),
+		                                             reinterpret_cast<BindingMap<vk::DescriptorImageInfo> const &>(image_infos),
+		                                             update_after_bind,
+		                                             thread_index);
 	}
+
+	descriptor_request_times[thread_index] += std::chrono::steady_clock::now() - start;
+	++descriptor_request_counts[thread_index];
+
+	static const vkb::Counter descriptor_requests{"Descriptor set requests"};
+	descriptor_requests.add();
+
+	return static_cast<DescriptorSetType>(descriptor_set);
 }
 
 template <vkb::BindingType bindingType>
@@ -515,12 +615,27 @@ inline void RenderFrame<bindingType>::reset()
 		}
 	}
 
+	// The fences above guarantee that the GPU finished reading the transient allocations of this frame
+	bool transient_buffers_destroyed = false;
+	for (auto &thread_rings : transient_rings)
+	{
+		for (auto &ring : thread_rings)
+		{
+			transient_buffers_destroyed |= ring.reset();
+		}
+	}
+
 	semaphore_pool.reset();
 
-	if (descriptor_management_strategy == DescriptorManagementStrategy::CreateDirectly)
+	if (descriptor_management_strategy == DescriptorManagementStrategy::CreateDirectly || transient_buffers_destroyed)
 	{
+		// Resets whole descriptor pools instead of freeing the sets of the previous use of this frame one by one.
+		// Cached sets are keyed on buffer handles, which the driver may reuse once a grown ring destroyed its buffers.
 		clear_descriptors();
 	}
+
+	std::ranges::fill(descriptor_request_times, std::chrono::steady_clock::duration{0});
+	std::ranges::fill(descriptor_request_counts, 0);
 }
 
 template <vkb::BindingType bindingType>
@@ -0,0 +1,764 @@
+/* Copyright (c) 2025, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "render_graph.h"
+
+#include <algorithm>
+
+#include "common/error.h"
+#include "core/command_buffer.h"
+#include "core/device.h"
+#include "core/image.h"
+#include "core/image_view.h"
+#include "core/memory_category.h"
+#include "core/util/logging.hpp"
+
+namespace vkb
+{
+namespace rendering
+{
+namespace
+{
+// Alignment used for the estimated sizes, the common alignment of optimally tiled images
+constexpr VkDeviceSize estimated_image_alignment = 64 * 1024;
+
+VkImageAspectFlags get_aspect_mask(VkFormat format)
+{
+	if (is_depth_stencil_format(format))
+	{
+		return VK_IMAGE_ASPECT_DEPTH_BIT | VK_IMAGE_ASPECT_STENCIL_BIT;
+	}
+	if (is_depth_format(format))
+	{
+		return VK_IMAGE_ASPECT_DEPTH_BIT;
+	}
+	return VK_IMAGE_ASPECT_COLOR_BIT;
+}
+
+VkMemoryRequirements estimate_memory_requirements(const RenderGraphImageDesc &desc, VkImageUsageFlags /*usage*/)
+{
+	VkDeviceSize size = 0;
+	for (uint32_t mip = 0; mip < desc.mip_levels; ++mip)
+	{
+		VkDeviceSize width  = std::max(desc.extent.width >> mip, 1u);
+		VkDeviceSize height = std::max(desc.extent.height >> mip, 1u);
+		VkDeviceSize depth  = std::max(desc.extent.depth >> mip, 1u);
+		size += width * height * depth * get_bits_per_pixel(desc.format) / 8;
+	}
+	size *= static_cast<VkDeviceSize>(desc.sample_count) * desc.array_layers;
+
+	VkMemoryRequirements memory_requirements{};
+	memory_requirements.size           = (size + estimated_image_alignment - 1) / estimated_image_alignment * estimated_image_alignment;
+	memory_requirements.alignment      = estimated_image_alignment;
+	memory_requirements.memoryTypeBits = ~0u;
+	return memory_requirements;
+}
+
+// Accesses that make memory available, the only ones that matter as the source of a barrier
+constexpr VkAccessFlags write_access_mask = VK_ACCESS_SHADER_WRITE_BIT | VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT |
+                                            VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT | VK_ACCESS_TRANSFER_WRITE_BIT |
+                                            VK_ACCESS_HOST_WRITE_BIT | VK_ACCESS_MEMORY_WRITE_BIT;
+
+/**
+ * @brief Tracks the last accesses of an image while walking the passes
+ */
+struct ImageState
+{
+	VkImageLayout layout = VK_IMAGE_LAYOUT_UNDEFINED;
+
+	/// Stage and access of the last write, or layout transition, not yet waited for by every later access
+	VkPipelineStageFlags write_stages = 0;
+
+	VkAccessFlags write_access = 0;
+
+	/// Stages that read the image since the last write
+	VkPipelineStageFlags read_stages = 0;
+
+	/// Stages and accesses the last write was made visible to
+	VkPipelineStageFlags visible_stages = 0;
+
+	VkAccessFlags visible_access = 0;
+};
+
+/**
+ * @brief Updates the state of an image for a new access, returning whether a barrier is needed before it
+ */
+bool transition(ImageState &state, const RenderGraphAccess &access, RenderGraphBarrier &barrier)
+{
+	barrier.old_layout      = state.layout;
+	barrier.new_layout      = access.layout;
+	barrier.dst_stage_mask  = access.stage_mask;
+	barrier.dst_access_mask = access.access_mask;
+
+	bool layout_changes = state.layout != access.layout;
+
+	if (access.is_write)
+	{
+		// Writes wait for the previous write and for the reads since then (write-after-read)
+		if (!layout_changes && state.write_stages == 0 && state.read_stages == 0)
+		{
+			state.write_stages   = access.stage_mask;
+			state.write_access   = access.access_mask & write_access_mask;
+			state.visible_stages = 0;
+			state.visible_access = 0;
+			return false;
+		}
+
+		barrier.src_stage_mask  = state.write_stages | state.read_stages;
+		barrier.src_access_mask = state.write_access;
+
+		state.layout         = access.layout;
+		state.write_stages   = access.stage_mask;
+		state.write_access   = access.access_mask & write_access_mask;
+		state.read_stages    = 0;
+		state.visible_stages = 0;
+		state.visible_access = 0;
+		return true;
+	}
+
+	if (layout_changes)
+	{
+		// The transition is a write without access, later reads in the same layout wait for it from other stages only
+		barrier.src_stage_mask  = state.write_stages | state.read_stages;
+		barrier.src_access_mask = state.write_access;
+
+		state.layout         = access.layout;
+		state.write_stages   = access.stage_mask;
+		state.write_access   = 0;
+		state.read_stages    = access.stage_mask;
+		state.visible_stages = access.stage_mask;
+		state.visible_access = access.access_mask;
+		return true;
+	}
+
+	state.read_stages |= access.stage_mask;
+
+	bool is_visible = (state.visible_stages & access.stage_mask) == access.stage_mask &&
+	                  (state.visible_access & access.access_mask) == access.access_mask;
+	if (state.write_stages == 0 || is_visible)
+	{
+		return false;
+	}
+
+	barrier.src_stage_mask  = state.write_stages;
+	barrier.src_access_mask = state.write_access;
+
+	state.visible_stages |= access.stage_mask;
+	state.visible_access |= access.access_mask;
+	return true;
+}
+}        // namespace
+
+RenderGraphAccess get_render_graph_access(RenderGraphUsage usage)
+{
+	switch (usage)
+	{
+		case RenderGraphUsage::ColorAttachment:
+			return {VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL,
+			        VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT,
+			        VK_ACCESS_COLOR_ATTACHMENT_READ_BIT | VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT,
+			        VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT,
+			        true};
+		case RenderGraphUsage::DepthStencilAttachment:
+			return {VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL,
+			        VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT,
+			        VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_READ_BIT | VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT,
+			        VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT,
+			        true};
+		case RenderGraphUsage::DepthStencilReadOnly:
+			return {VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL,
+			        VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT,
+			        VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_READ_BIT,
+			        VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT,
+			        false};
+		case RenderGraphUsage::InputAttachment:
+			return {VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+			        VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT,
+			        VK_ACCESS_INPUT_ATTACHMENT_READ_BIT,
+			        VK_IMAGE_USAGE_INPUT_ATTACHMENT_BIT,
+			        false};
+		case RenderGraphUsage::FragmentSampled:
+			return {VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+			        VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT,
+			        VK_ACCESS_SHADER_READ_BIT,
+			        VK_IMAGE_USAGE_SAMPLED_BIT,
+			        false};
+		case RenderGraphUsage::ComputeSampled:
+			return {VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+			        VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+			        VK_ACCESS_SHADER_READ_BIT,
+			        VK_IMAGE_USAGE_SAMPLED_BIT,
+			        false};
+		case RenderGraphUsage::ComputeStorageRead:
+			return {VK_IMAGE_LAYOUT_GENERAL,
+			        VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+			        VK_ACCESS_SHADER_READ_BIT,
+			        VK_IMAGE_USAGE_STORAGE_BIT,
+			        false};
+		case RenderGraphUsage::ComputeStorageWrite:
+			return {VK_IMAGE_LAYOUT_GENERAL,
+			        VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+			        VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT,
+			        VK_IMAGE_USAGE_STORAGE_BIT,
+			        true};
+		case RenderGraphUsage::TransferSrc:
+			return {VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+			        VK_PIPELINE_STAGE_TRANSFER_BIT,
+			        VK_ACCESS_TRANSFER_READ_BIT,
+			        VK_IMAGE_USAGE_TRANSFER_SRC_BIT,
+			        false};
+		case RenderGraphUsage::TransferDst:
+			return {VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+			        VK_PIPELINE_STAGE_TRANSFER_BIT,
+			        VK_ACCESS_TRANSFER_WRITE_BIT,
+			        VK_IMAGE_USAGE_TRANSFER_DST_BIT,
+			        true};
+		case RenderGraphUsage::Present:
+			return {VK_IMAGE_LAYOUT_PRESENT_SRC_KHR,
+			        VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT,
+			        0,
+			        0,
+			        false};
+		default:
+			throw std::runtime_error("Unknown render graph usage");
+	}
+}
+
+RenderGraph::RenderGraph() = default;
+
+RenderGraph::~RenderGraph()
+{
+	release();
+}
+
+uint32_t RenderGraph::add_transient_image(const std::string &name, const RenderGraphImageDesc &desc)
+{
+	Image image;
+	image.name = name;
+	image.desc = desc;
+	images.push_back(std::move(image));
+
+	compiled = false;
+	return static_cast<uint32_t>(images.size() - 1);
+}
+
+uint32_t RenderGraph::import_image(const std::string &name, const RenderGraphImageDesc &desc, const RenderGraphAccess &initial_access, RenderGraphUsage final_usage)
+{
+	Image image;
+	image.name           = name;
+	image.desc           = desc;
+	image.is_imported    = true;
+	image.initial_access = initial_access;
+	image.final_usage    = final_usage;
+	images.push_back(std::move(image));
+
+	compiled = false;
+	return static_cast<uint32_t>(images.size() - 1);
+}
+
+void RenderGraph::set_imported_image(uint32_t image, vkb::core::ImageView &image_view)
+{
+	if (image >= images.size() || !images[image].is_imported)
+	{
+		throw std::runtime_error("Render graph image is not imported");
+	}
+	images[image].imported_view = &image_view;
+}
+
+void RenderGraph::add_pass(const std::string &name, std::vector<ImageUse> &&uses, RecordFunc &&record)
+{
+	for (auto it = uses.begin(); it != uses.end(); ++it)
+	{
+		if (it->image >= images.size())
+		{
+			throw std::runtime_error("Render graph pass " + name + " uses an unknown image");
+		}
+		for (auto other = uses.begin(); other != it; ++other)
+		{
+			if (other->image == it->image && get_render_graph_access(other->usage).layout != get_render_graph_access(it->usage).layout)
+			{
+				throw std::runtime_error("Render graph pass " + name + " uses image " + images[it->image].name + " in two layouts");
+			}
+		}
+	}
+
+	passes.push_back({name, std::move(uses), std::move(record)});
+	compiled = false;
+}
+
+const RenderGraphStatistics &RenderGraph::compile(const MemoryRequirementsFunc &get_memory_requirements)
+{
+	if (device)
+	{
+		throw std::runtime_error("Render graph can not be compiled again after allocation");
+	}
+
+	compute_lifetimes();
+	compile_with_requirements([this, &get_memory_requirements](uint32_t image) {
+		return get_memory_requirements ? get_memory_requirements(images[image].desc, images[image].usage) :
+		                                 estimate_memory_requirements(images[image].desc, images[image].usage);
+	});
+	return statistics;
+}
+
+void RenderGraph::compute_lifetimes()
+{
+	for (auto &image : images)
+	{
+		image.usage        = 0;
+		image.first_pass   = SIZE_MAX;
+		image.last_pass    = 0;
+		image.memory_block = -1;
+	}
+
+	for (size_t pass_index = 0; pass_index < passes.size(); ++pass_index)
+	{
+		for (auto &use : passes[pass_index].uses)
+		{
+			auto &image = images[use.image];
+			image.usage |= get_render_graph_access(use.usage).image_usage;
+			image.first_pass = std::min(image.first_pass, pass_index);
+			image.last_pass  = std::max(image.last_pass, pass_index);
+		}
+	}
+}
+
+void RenderGraph::compile_with_requirements(const std::function<VkMemoryRequirements(uint32_t image)> &get_memory_requirements)
+{
+	statistics = {};
+
+	for (uint32_t i = 0; i < images.size(); ++i)
+	{
+		auto &image = images[i];
+		if (image.is_imported || image.first_pass == SIZE_MAX)
+		{
+			continue;
+		}
+
+		image.memory_requirements = get_memory_requirements(i);
+
+		statistics.transient_image_count++;
+		statistics.transient_memory_size += image.memory_requirements.size;
+	}
+
+	assign_memory_blocks();
+	compute_barriers();
+
+	compiled = true;
+}
+
+void RenderGraph::assign_memory_blocks()
+{
+	memory_blocks.clear();
+
+	std::vector<uint32_t> order;
+	for (uint32_t i = 0; i < images.size(); ++i)
+	{
+		if (!images[i].is_imported && images[i].first_pass != SIZE_MAX)
+		{
+			order.push_back(i);
+		}
+	}
+
+	// Placing the largest images first keeps the smaller ones from growing the blocks
+	std::stable_sort(order.begin(), order.end(), [this](uint32_t a, uint32_t b) {
+		return images[a].memory_requirements.size > images[b].memory_requirements.size;
+	});
+
+	for (auto index : order)
+	{
+		auto &image = images[index];
+
+		for (size_t block_index = 0; block_index < memory_blocks.size() && image.memory_block < 0; ++block_index)
+		{
+			auto &block = memory_blocks[block_index];
+
+			if ((block.memory_requirements.memoryTypeBits & image.memory_requirements.memoryTypeBits) == 0)
+			{
+				continue;
+			}
+
+			bool overlaps = std::any_of(block.images.begin(), block.images.end(), [this, &image](uint32_t other) {
+				return images[other].first_pass <= image.last_pass && image.first_pass <= images[other].last_pass;
+			});
+			if (overlaps)
+			{
+				continue;
+			}
+
+			block.memory_requirements.size = std::max(block.memory_requirements.size, image.memory_requirements.size);
+			block.memory_requirements.alignment      = std::max(block.memory_requirements.alignment, image.memory_requirements.alignment);
+			block.memory_requirements.memoryTypeBits &= image.memory_requirements.memoryTypeBits;
+			block.images.push_back(index);
+			image.memory_block = static_cast<int32_t>(block_index);
+		}
+
+		if (image.memory_block < 0)
+		{
+			MemoryBlock block;
+			block.memory_requirements = image.memory_requirements;
+			block.images.push_back(index);
+			memory_blocks.push_back(std::move(block));
+			image.memory_block = static_cast<int32_t>(memory_blocks.size() - 1);
+		}
+	}
+
+	// Images of a block run one after the other
+	for (auto &block : memory_blocks)
+	{
+		std::sort(block.images.begin(), block.images.end(), [this](uint32_t a, uint32_t b) {
+			return images[a].first_pass < images[b].first_pass;
+		});
+		statistics.aliased_memory_size += block.memory_requirements.size;
+	}
+	statistics.memory_block_count = memory_blocks.size();
+}
+
+void RenderGraph::compute_barriers()
+{
+	barriers.assign(passes.size() + 1, {});
+
+	std::vector<ImageState> states(images.size());
+	for (size_t i = 0; i < images.size(); ++i)
+	{
+		if (images[i].is_imported)
+		{
+			auto &access           = images[i].initial_access;
+			states[i].layout       = access.layout;
+			states[i].write_stages = access.is_write ? access.stage_mask : 0;
+			states[i].write_access = access.is_write ? access.access_mask & write_access_mask : 0;
+			states[i].read_stages  = access.is_write ? 0 : access.stage_mask;
+		}
+	}
+
+	// An aliased image takes over the memory once the previous image of its block is last used
+	std::vector<int32_t> next_in_block(images.size(), -1);
+	for (auto &block : memory_blocks)
+	{
+		for (size_t i = 1; i < block.images.size(); ++i)
+		{
+			next_in_block[block.images[i - 1]] = static_cast<int32_t>(block.images[i]);
+		}
+	}
+
+	for (size_t pass_index = 0; pass_index < passes.size(); ++pass_index)
+	{
+		auto &pass = passes[pass_index];
+
+		// Uses of an image within a pass, for example as input attachment and sampled, share one access
+		std::vector<std::pair<uint32_t, RenderGraphAccess>> accesses;
+		for (auto &use : pass.uses)
+		{
+			auto access   = get_render_graph_access(use.usage);
+			auto existing = std::find_if(accesses.begin(), accesses.end(), [&use](const auto &other) { return other.first == use.image; });
+			if (existing == accesses.end())
+			{
+				accesses.emplace_back(use.image, access);
+				continue;
+			}
+			existing->second.stage_mask |= access.stage_mask;
+			existing->second.access_mask |= access.access_mask;
+			existing->second.is_write = existing->second.is_write || access.is_write;
+		}
+
+		for (auto &[image, access] : accesses)
+		{
+			RenderGraphBarrier barrier{};
+			barrier.image = image;
+
+			if (transition(states[image], access, barrier))
+			{
+				barriers[pass_index].push_back(barrier);
+			}
+		}
+
+		for (auto &[image, access] : accesses)
+		{
+			if (images[image].last_pass == pass_index && next_in_block[image] >= 0)
+			{
+				auto &state       = states[image];
+				auto &next        = states[next_in_block[image]];
+				next.write_stages = state.write_stages | state.read_stages;
+				next.write_access = state.write_access;
+			}
+		}
+	}
+
+	auto &final_barriers = barriers.back();
+	for (uint32_t i = 0; i < images.size(); ++i)
+	{
+		if (!images[i].is_imported)
+		{
+			continue;
+		}
+
+		RenderGraphBarrier barrier{};
+		barrier.image = i;
+
+		auto access = get_render_graph_access(images[i].final_usage);
+		if (transition(states[i], access, barrier))
+		{
+			final_barriers.push_back(barrier);
+		}
+	}
+
+	for (auto &pass_barriers : barriers)
+	{
+		for (auto &barrier : pass_barriers)
+		{
+			if (barrier.src_stage_mask == 0)
+			{
+				barrier.src_stage_mask = VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT;
+			}
+		}
+
+		statistics.image_barrier_count += pass_barriers.size();
+		statistics.unbatched_pipeline_barrier_count += pass_barriers.size();
+		statistics.pipeline_barrier_count += pass_barriers.empty() ? 0 : 1;
+	}
+}
+
+void RenderGraph::allocate(vkb::Device &device_)
+{
+	release();
+	compute_lifetimes();
+
+	VkDevice device_handle = device_.get_handle();
+
+	// Images are created first, as the aliasing needs their real memory requirements
+	std::vector<VkMemoryRequirements> memory_requirements(images.size());
+	for (size_t i = 0; i < images.size(); ++i)
+	{
+		auto &image = images[i];
+		if (image.is_imported || image.first_pass == SIZE_MAX)
+		{
+			continue;
+		}
+
+		VkImageCreateInfo create_info{VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO};
+		create_info.imageType     = image.desc.extent.depth > 1 ? VK_IMAGE_TYPE_3D : VK_IMAGE_TYPE_2D;
+		create_info.format        = image.desc.format;
+		create_info.extent        = image.desc.extent;
+		create_info.mipLevels     = image.desc.mip_levels;
+		create_info.arrayLayers   = image.desc.array_layers;
+		create_info.samples       = image.desc.sample_count;
+		create_info.tiling        = VK_IMAGE_TILING_OPTIMAL;
+		create_info.usage         = image.usage;
+		create_info.sharingMode   = VK_SHARING_MODE_EXCLUSIVE;
+		create_info.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+
+		VK_CHECK(vkCreateImage(device_handle, &create_info, nullptr, &image.handle));
+		vkGetImageMemoryRequirements(device_handle, image.handle, &memory_requirements[i]);
+	}
+	device = &device_;
+
+	compile_with_requirements([&memory_requirements](uint32_t image) { return memory_requirements[image]; });
+
+	for (auto &block : memory_blocks)
+	{
+		VmaAllocationCreateInfo allocation_create_info{};
+		allocation_create_info.requiredFlags  = VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT;
+		allocation_create_info.memoryTypeBits = block.memory_requirements.memoryTypeBits;
+		vkb::allocated::set_memory_category(allocation_create_info, vkb::allocated::MemoryCategory::RenderTargets);
+
+		VmaAllocationInfo allocation_info{};
+		VK_CHECK(vmaAllocateMemory(vkb::allocated::get_memory_allocator(), &block.memory_requirements, &allocation_create_info, &block.allocation, &allocation_info));
+		vkb::allocated::track_allocation(block.allocation, allocation_info);
+
+		for (auto index : block.images)
+		{
+			auto &image = images[index];
+
+			VK_CHECK(vmaBindImageMemory(vkb::allocated::get_memory_allocator(), block.allocation, image.handle));
+
+			// The graph owns the handle and the memory, the wrapper only provides views
+			image.image      = std::make_unique<vkb::core::Image>(device_, image.handle, image.desc.extent, image.desc.format, image.usage, image.desc.sample_count);
+			// The wrapper only knows a single mip and layer, so the view is given the ones of the image
+			VkImageViewType view_type = VK_IMAGE_VIEW_TYPE_2D;
+			if (image.desc.extent.depth > 1)
+			{
+				view_type = VK_IMAGE_VIEW_TYPE_3D;
+			}
+			else if (image.desc.array_layers > 1)
+			{
+				view_type = VK_IMAGE_VIEW_TYPE_2D_ARRAY;
+			}
+			image.image_view = std::make_unique<vkb::core::ImageView>(*image.image, view_type, VK_FORMAT_UNDEFINED, 0, 0, image.desc.mip_levels, image.desc.array_layers);
+		}
+	}
+}
+
+void RenderGraph::execute(vkb::core::CommandBufferC &command_buffer)
+{
+	if (!device || !compiled)
+	{
+		throw std::runtime_error("Render graph must be allocated after its last change before execution");
+	}
+
+	auto record_barriers = [this, &command_buffer](const std::vector<RenderGraphBarrier> &pass_barriers) {
+		if (pass_barriers.empty())
+		{
+			return;
+		}
+
+		VkPipelineStageFlags src_stage_mask = 0;
+		VkPipelineStageFlags dst_stage_mask = 0;
+
+		std::vector<VkImageMemoryBarrier> image_memory_barriers;
+		image_memory_barriers.reserve(pass_barriers.size());
+
+		for (auto &barrier : pass_barriers)
+		{
+			auto &image = images[barrier.image];
+
+			VkImageMemoryBarrier image_memory_barrier{VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER};
+			image_memory_barrier.srcAccessMask       = barrier.src_access_mask;
+			image_memory_barrier.dstAccessMask       = barrier.dst_access_mask;
+			image_memory_barrier.oldLayout           = barrier.old_layout;
+			image_memory_barrier.newLayout           = barrier.new_layout;
+			image_memory_barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+			image_memory_barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+			image_memory_barrier.image               = get_image_view(barrier.image).get_image().get_handle();
+			image_memory_barrier.subresourceRange    = {get_aspect_mask(image.desc.format), 0, VK_REMAINING_MIP_LEVELS, 0, VK_REMAINING_ARRAY_LAYERS};
+			image_memory_barriers.push_back(image_memory_barrier);
+
+			src_stage_mask |= barrier.src_stage_mask;
+			dst_stage_mask |= barrier.dst_stage_mask;
+		}
+
+		vkCmdPipelineBarrier(command_buffer.get_handle(),
+		                     src_stage_mask,
+		                     dst_stage_mask,
+		                     0,
+		                     0,
+		                     nullptr,
+		                     0,
+		                     nullptr,
+		                     static_cast<uint32_t>(image_memory_barriers.size()),
+		                     image_memory_barriers.data());
+	};
+
+	for (size_t pass_index = 0; pass_index < passes.size(); ++pass_index)
+	{
+		record_barriers(barriers[pass_index]);
+
+		if (passes[pass_index].record)
+		{
+			passes[pass_index].record(command_buffer, *this);
+		}
+	}
+
+	record_barriers(barriers.back());
+}
+
+vkb::core::ImageView &RenderGraph::get_image_view(uint32_t image)
+{
+	auto &graph_image = images.at(image);
+
+	auto *image_view = graph_image.is_imported ? graph_image.imported_view : graph_image.image_view.get();
+	if (!image_view)
+	{
+		throw std::runtime_error("Render graph image " + graph_image.name + " has no image view");
+	}
+	return *image_view;
+}
+
+const RenderGraphStatistics &RenderGraph::get_statistics() const
+{
+	return statistics;
+}
+
+const std::vector<RenderGraphBarrier> &RenderGraph::get_barriers(size_t pass_index) const
+{
+	return barriers.at(pass_index);
+}
+
+int32_t RenderGraph::get_memory_block(uint32_t image) const
+{
+	return images.at(image).memory_block;
+}
+
+void RenderGraph::log_summary() const
+{
+	for (size_t pass_index = 0; pass_index <= passes.size() && pass_index < barriers.size(); ++pass_index)
+	{
+		LOGI("{}: {} barriers", pass_index < passes.size() ? passes[pass_index].name : "Final", barriers[pass_index].size());
+
+		for (auto &barrier : barriers[pass_index])
+		{
+			LOGI("    {} {} -> {}",
+			     images[barrier.image].name,
+			     vk::to_string(static_cast<vk::ImageLayout>(barrier.old_layout)),
+			     vk::to_string(static_cast<vk::ImageLayout>(barrier.new_layout)));
+		}
+	}
+
+	for (size_t block_index = 0; block_index < memory_blocks.size(); ++block_index)
+	{
+		std::string names;
+		for (auto index : memory_blocks[block_index].images)
+		{
+			names += (names.empty() ? "" : ", ") + images[index].name;
+		}
+		LOGI("Memory block {}: {} KiB, {}", block_index, memory_blocks[block_index].memory_requirements.size / 1024, names);
+	}
+
+	LOGI("Image barriers: {}, vkCmdPipelineBarrier calls: {} (unbatched {})",
+	     statistics.image_barrier_count,
+	     statistics.pipeline_barrier_count,
+	     statistics.unbatched_pipeline_barrier_count);
+	LOGI("Transient images: {}, memory: {} KiB aliased into {} KiB ({} blocks)",
+	     statistics.transient_image_count,
+	     statistics.transient_memory_size / 1024,
+	     statistics.aliased_memory_size / 1024,
+	     statistics.memory_block_count);
+}
+
+void RenderGraph::release()
+{
+	if (!device)
+	{
+		return;
+	}
+
+	VkDevice device_handle = device->get_handle();
+
+	for (auto &image : images)
+	{
+		image.image_view.reset();
+		image.image.reset();
+		if (image.handle != VK_NULL_HANDLE)
+		{
+			vkDestroyImage(device_handle, image.handle, nullptr);
+			image.handle = VK_NULL_HANDLE;
+		}
+	}
+
+	for (auto &block : memory_blocks)
+	{
+		if (block.allocation != VK_NULL_HANDLE)
+		{
+			vkb::allocated::untrack_allocation(block.allocation);
+			vmaFreeMemory(vkb::allocated::get_memory_allocator(), block.allocation);
+			block.allocation = VK_NULL_HANDLE;
+		}
+	}
+
+	device = nullptr;
+}
+}        // namespace rendering
+}        // namespace vkb
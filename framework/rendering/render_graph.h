@@ -0,0 +1,314 @@
+/* Copyright (c) 2025, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "common/vk_common.h"
+
+namespace vkb
+{
+class Device;
+
+namespace core
+{
+template <vkb::BindingType bindingType>
+class CommandBuffer;
+using CommandBufferC = CommandBuffer<vkb::BindingType::C>;
+
+class Image;
+class ImageView;
+}        // namespace core
+
+namespace rendering
+{
+/**
+ * @brief How a pass of a RenderGraph uses an image, which determines its layout, stages and accesses
+ */
+enum class RenderGraphUsage
+{
+	ColorAttachment,
+	DepthStencilAttachment,
+	DepthStencilReadOnly,
+	InputAttachment,
+	FragmentSampled,
+	ComputeSampled,
+	ComputeStorageRead,
+	ComputeStorageWrite,
+	TransferSrc,
+	TransferDst,
+	Present
+};
+
+/**
+ * @brief Synchronization scope of an image usage
+ */
+struct RenderGraphAccess
+{
+	VkImageLayout layout;
+
+	VkPipelineStageFlags stage_mask;
+
+	VkAccessFlags access_mask;
+
+	/// Image usage flag the image needs to be created with, 0 for none
+	VkImageUsageFlags image_usage;
+
+	bool is_write;
+};
+
+RenderGraphAccess get_render_graph_access(RenderGraphUsage usage);
+
+struct RenderGraphImageDesc
+{
+	VkFormat format{VK_FORMAT_UNDEFINED};
+
+	VkExtent3D extent{0, 0, 1};
+
+	VkSampleCountFlagBits sample_count{VK_SAMPLE_COUNT_1_BIT};
+
+	uint32_t mip_levels{1};
+
+	uint32_t array_layers{1};
+};
+
+/**
+ * @brief Image memory barrier computed by the graph, between the previous and the next use of an image
+ */
+struct RenderGraphBarrier
+{
+	uint32_t image;
+
+	VkImageLayout old_layout;
+
+	VkImageLayout new_layout;
+
+	VkPipelineStageFlags src_stage_mask;
+
+	VkPipelineStageFlags dst_stage_mask;
+
+	VkAccessFlags src_access_mask;
+
+	VkAccessFlags dst_access_mask;
+};
+
+struct RenderGraphStatistics
+{
+	/// Image memory barriers after redundant ones were dropped
+	size_t image_barrier_count = 0;
+
+	/// vkCmdPipelineBarrier calls with the barriers of each pass batched
+	size_t pipeline_barrier_count = 0;
+
+	/// vkCmdPipelineBarrier calls if every barrier was recorded on its own, as vkb::image_layout_transition does
+	size_t unbatched_pipeline_barrier_count = 0;
+
+	size_t transient_image_count = 0;
+
+	/// Memory blocks the transient images were aliased into
+	size_t memory_block_count = 0;
+
+	VkDeviceSize transient_memory_size = 0;
+
+	VkDeviceSize aliased_memory_size = 0;
+};
+
+/**
+ * @brief Orders passes declared with the images they read and write, and derives their synchronization and memory
+ *
+ * Passes run in the order they are added. Compiling the graph
+ *   - computes, for every pass, the image barriers needed before it, merged into a single vkCmdPipelineBarrier.
+ *     Reads of an image that is already visible to the stage reading it need no barrier.
+ *   - assigns the transient images to memory blocks, so that images whose lifetimes (first to last pass using
+ *     them) do not overlap share memory. The first use of an aliased image waits for the last use of the
+ *     previous image in the same block, and discards the contents with an UNDEFINED old layout.
+ *
+ * Compiling only needs the memory requirements of the images, so it can run and be inspected without a device.
+ * allocate() creates the images and their memory on a device, execute() records the barriers and the passes.
+ *
+ * The passes record their own work, a pass using a vkb::RenderPipeline or a PostProcessingPipeline records it with
+ * image views from get_image_view(). Render passes begun by a pass should use the graph layouts as their initial
+ * and final layouts, so that they do not add transitions of their own.
+ */
+class RenderGraph
+{
+  public:
+	using RecordFunc = std::function<void(vkb::core::CommandBufferC &command_buffer, RenderGraph &graph)>;
+
+	/**
+	 * @brief Returns the memory requirements of an image, size estimated from the format when compiling without a device
+	 */
+	using MemoryRequirementsFunc = std::function<VkMemoryRequirements(const RenderGraphImageDesc &desc, VkImageUsageFlags usage)>;
+
+	struct ImageUse
+	{
+		uint32_t image;
+
+		RenderGraphUsage usage;
+	};
+
+	RenderGraph();
+
+	RenderGraph(const RenderGraph &)            = delete;
+	RenderGraph(RenderGraph &&)                 = delete;
+	~RenderGraph();
+	RenderGraph &operator=(const RenderGraph &) = delete;
+	RenderGraph &operator=(RenderGraph &&)      = delete;
+
+	/**
+	 * @brief Adds an image that only lives during the graph, its memory may be shared with other transient images
+	 * @return Handle of the image
+	 */
+	uint32_t add_transient_image(const std::string &name, const RenderGraphImageDesc &desc);
+
+	/**
+	 * @brief Adds an image owned outside of the graph, such as a swapchain image
+	 * @param initial_access Layout and last access of the image before the graph, which the first barrier waits for.
+	 *        A swapchain image uses an UNDEFINED layout at the stage waiting for the acquire semaphore.
+	 * @param final_usage How the image is used after the graph, the graph ends with a barrier to it
+	 * @return Handle of the image
+	 */
+	uint32_t import_image(const std::string &name, const RenderGraphImageDesc &desc, const RenderGraphAccess &initial_access, RenderGraphUsage final_usage);
+
+	/**
+	 * @brief Sets the view of an imported image, needed before execute()
+	 */
+	void set_imported_image(uint32_t image, vkb::core::ImageView &image_view);
+
+	/**
+	 * @brief Adds a pass after the previously added ones
+	 * @throws std::runtime_error if the pass uses an image twice in different layouts
+	 */
+	void add_pass(const std::string &name, std::vector<ImageUse> &&uses, RecordFunc &&record);
+
+	/**
+	 * @brief Computes the barriers and the memory aliasing, see RenderGraph
+	 * @param get_memory_requirements Memory requirements of the transient images, estimated when empty
+	 */
+	const RenderGraphStatistics &compile(const MemoryRequirementsFunc &get_memory_requirements = {});
+
+	/**
+	 * @brief Compiles the graph with the real memory requirements, and creates the transient images in aliased memory
+	 */
+	void allocate(vkb::Device &device);
+
+	/**
+	 * @brief Records the passes with their barriers, ending with the barriers to the final usage of imported images
+	 */
+	void execute(vkb::core::CommandBufferC &command_buffer);
+
+	vkb::core::ImageView &get_image_view(uint32_t image);
+
+	const RenderGraphStatistics &get_statistics() const;
+
+	/**
+	 * @return Barriers recorded before a pass, or after the last one for pass_index equal to the pass count
+	 */
+	const std::vector<RenderGraphBarrier> &get_barriers(size_t pass_index) const;
+
+	/**
+	 * @return Index of the memory block of a transient image, -1 for imported images
+	 */
+	int32_t get_memory_block(uint32_t image) const;
+
+	/**
+	 * @brief Logs the barriers and memory blocks of the compiled graph
+	 */
+	void log_summary() const;
+
+  private:
+	struct Image
+	{
+		std::string name;
+
+		RenderGraphImageDesc desc;
+
+		bool is_imported = false;
+
+		RenderGraphAccess initial_access{};
+
+		RenderGraphUsage final_usage = RenderGraphUsage::ColorAttachment;
+
+		/// Union of the usage flags of all passes using the image
+		VkImageUsageFlags usage = 0;
+
+		size_t first_pass = SIZE_MAX;
+
+		size_t last_pass = 0;
+
+		VkMemoryRequirements memory_requirements{};
+
+		int32_t memory_block = -1;
+
+		VkImage handle = VK_NULL_HANDLE;
+
+		std::unique_ptr<vkb::core::Image> image;
+
+		std::unique_ptr<vkb::core::ImageView> image_view;
+
+		vkb::core::ImageView *imported_view = nullptr;
+	};
+
+	struct Pass
+	{
+		std::string name;
+
+		std::vector<ImageUse> uses;
+
+		RecordFunc record;
+	};
+
+	struct MemoryBlock
+	{
+		VkMemoryRequirements memory_requirements{};
+
+		std::vector<uint32_t> images;
+
+		VmaAllocation allocation = VK_NULL_HANDLE;
+	};
+
+	void compute_lifetimes();
+
+	void compile_with_requirements(const std::function<VkMemoryRequirements(uint32_t image)> &get_memory_requirements);
+
+	void assign_memory_blocks();
+
+	void compute_barriers();
+
+	void release();
+
+	vkb::Device *device = nullptr;
+
+	std::vector<Image> images;
+
+	std::vector<Pass> passes;
+
+	std::vector<MemoryBlock> memory_blocks;
+
+	/// Barriers before each pass, and the final barriers of the imported images last
+	std::vector<std::vector<RenderGraphBarrier>> barriers;
+
+	RenderGraphStatistics statistics;
+
+	bool compiled = false;
+};
+}        // namespace rendering
+}        // namespace vkb
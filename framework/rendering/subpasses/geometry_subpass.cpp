@@ -18,6 +18,7 @@
 #include "rendering/subpasses/geometry_subpass.h"
 #include "common/utils.h"
 #include "common/vk_common.h"
+#include "geometry/frustum.h"
 #include "rendering/render_context.h"
 #include "scene_graph/components/camera.h"
 #include "scene_graph/components/image.h"
@@ -27,6 +28,7 @@
 #include "scene_graph/components/texture.h"
 #include "scene_graph/node.h"
 #include "scene_graph/scene.h"
+#include "scene_graph/texture_residency.h"
 
 namespace vkb
 {
@@ -57,6 +59,12 @@ void GeometrySubpass::get_sorted_nodes(std::multimap<float, std::pair<sg::Node *
 {
 	auto camera_transform = camera.get_node()->get_transform().get_world_matrix();
 
+	Frustum frustum;
+	if (texture_residency)
+	{
+		frustum.update(camera.get_projection() * camera.get_view());
+	}
+
 	for (auto &mesh : meshes)
 	{
 		for (auto &node : mesh->get_nodes())
@@ -70,8 +78,20 @@ void GeometrySubpass::get_sorted_nodes(std::multimap<float, std::pair<sg::Node *
 
 			float distance = glm::length(glm::vec3(camera_transform[3]) - world_bounds.get_center());
 
+			// Only the textures of meshes in view count as used, the others may lose their top levels
+			bool in_view = texture_residency &&
+			               frustum.check_sphere(world_bounds.get_center(), glm::length(world_bounds.get_max() - world_bounds.get_min()) * 0.5f);
+
 			for (auto &sub_mesh : mesh->get_submeshes())
 			{
+				if (in_view)
+				{
+					for (auto &texture : sub_mesh->get_material()->textures)
+					{
+						texture_residency->mark_used(*texture.second->get_image());
+					}
+				}
+
 				if (sub_mesh->get_material()->alpha_mode == sg::AlphaMode::Blend)
 				{
 					transparent_nodes.emplace(distance, std::make_pair(node, sub_mesh));
@@ -90,6 +110,9 @@ void GeometrySubpass::draw(vkb::core::CommandBufferC &command_buffer)
 	std::multimap<float, std::pair<sg::Node *, sg::SubMesh *>> opaque_nodes;
 	std::multimap<float, std::pair<sg::Node *, sg::SubMesh *>> transparent_nodes;
 
+	auto residencies  = scene.get_components<sg::TextureResidency>();
+	texture_residency = residencies.empty() ? nullptr : residencies.front();
+
 	get_sorted_nodes(opaque_nodes, transparent_nodes);
 
 	// Draw opaque objects in front-to-back order
@@ -98,7 +121,7 @@ void GeometrySubpass::draw(vkb::core::CommandBufferC &command_buffer)
 
 		for (auto node_it = opaque_nodes.begin(); node_it != opaque_nodes.end(); node_it++)
 		{
-			update_uniform(command_buffer, *node_it->second.first, thread_index);
+			update_submesh_uniform(command_buffer, *node_it->second.first, *node_it->second.second, thread_index);
 
 			// Invert the front face if the mesh was flipped
 			const auto &scale      = node_it->second.first->get_transform().get_scale();
@@ -132,14 +155,30 @@ void GeometrySubpass::draw(vkb::core::CommandBufferC &command_buffer)
 
 		for (auto node_it = transparent_nodes.rbegin(); node_it != transparent_nodes.rend(); node_it++)
 		{
-			update_uniform(command_buffer, *node_it->second.first, thread_index);
+			update_submesh_uniform(command_buffer, *node_it->second.first, *node_it->second.second, thread_index);
 
 			draw_submesh(command_buffer, *node_it->second.second);
 		}
 	}
 }
 
-void GeometrySubpass::update_uniform(vkb::core::CommandBufferC &command_buffer, sg::Node &node, size_t thread_index)
+void GeometrySubpass::update_uniform(vkb::core::CommandBufferC &command_buffer, sg::Node &node, const glm::mat4 &model, size_t thread_index)
+{
+	bind_global_uniform(command_buffer, model, thread_index);
+}
+
+void GeometrySubpass::update_submesh_uniform(vkb::core::CommandBufferC &command_buffer, sg::Node &node, const sg::SubMesh &sub_mesh, size_t thread_index)
+{
+	glm::mat4 model = node.get_transform().get_world_matrix();
+	if (auto quantization = sub_mesh.get_position_quantization())
+	{
+		model = model * quantization->get_dequantization_matrix();
+	}
+
+	update_uniform(command_buffer, node, model, thread_index);
+}
+
+void GeometrySubpass::bind_global_uniform(vkb::core::CommandBufferC &command_buffer, const glm::mat4 &model, size_t thread_index)
 {
 	GlobalUniform global_uniform;
 
@@ -147,11 +186,9 @@ void GeometrySubpass::update_uniform(vkb::core::CommandBufferC &command_buffer,
 
 	auto &render_frame = get_render_context().get_active_frame();
 
-	auto &transform = node.get_transform();
-
 	auto allocation = render_frame.allocate_buffer(VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT, sizeof(GlobalUniform), thread_index);
 
-	global_uniform.model = transform.get_world_matrix();
+	global_uniform.model = model;
 
 	global_uniform.camera_position = glm::vec3(glm::inverse(camera.get_view())[3]);
 
@@ -39,6 +39,7 @@ class Node;
 class Mesh;
 class SubMesh;
 class Camera;
+class TextureResidency;
 }        // namespace sg
 
 /**
@@ -96,7 +97,18 @@ class GeometrySubpass : public vkb::rendering::SubpassC
 	void set_thread_index(uint32_t index);
 
   protected:
-	virtual void update_uniform(vkb::core::CommandBufferC &command_buffer, sg::Node &node, size_t thread_index);
+	/**
+	 * @brief Updates the uniforms of a node before drawing one of its submeshes
+	 * @param model The world matrix of the node, followed by the dequantization of the submesh positions if they are quantized
+	 */
+	virtual void update_uniform(vkb::core::CommandBufferC &command_buffer, sg::Node &node, const glm::mat4 &model, size_t thread_index);
+
+	/**
+	 * @brief Calls update_uniform with the model matrix of a submesh, which dequantizes its positions if they are quantized
+	 */
+	void update_submesh_uniform(vkb::core::CommandBufferC &command_buffer, sg::Node &node, const sg::SubMesh &sub_mesh, size_t thread_index);
+
+	void bind_global_uniform(vkb::core::CommandBufferC &command_buffer, const glm::mat4 &model, size_t thread_index);
 
 	void draw_submesh(vkb::core::CommandBufferC &command_buffer, sg::SubMesh &sub_mesh, VkFrontFace front_face = VK_FRONT_FACE_COUNTER_CLOCKWISE);
 
@@ -122,6 +134,9 @@ class GeometrySubpass : public vkb::rendering::SubpassC
 
 	sg::Scene &scene;
 
+	// Texture residency of the scene if it has one, which is told about the textures of the meshes in view
+	sg::TextureResidency *texture_residency{nullptr};
+
 	uint32_t thread_index{0};
 
 	vkb::RasterizationState base_rasterization_state{};
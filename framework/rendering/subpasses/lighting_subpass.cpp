@@ -20,6 +20,7 @@
 #include "buffer_pool.h"
 #include "rendering/render_context.h"
 #include "scene_graph/components/camera.h"
+#include "scene_graph/components/perspective_camera.h"
 #include "scene_graph/scene.h"
 
 namespace vkb
@@ -41,8 +42,20 @@ void LightingSubpass::prepare()
 
 void LightingSubpass::draw(vkb::core::CommandBufferC &command_buffer)
 {
-	allocate_lights<DeferredLights>(scene.get_components<sg::Light>(), MAX_DEFERRED_LIGHT_COUNT);
-	command_buffer.bind_lighting(get_lighting_state(), 0, 4);
+	if (light_clustering)
+	{
+		auto &render_frame = get_render_context().get_active_frame();
+		light_clustering->build(scene.get_components<sg::Light>(),
+		                        dynamic_cast<sg::PerspectiveCamera &>(camera),
+		                        render_frame.get_render_target().get_extent());
+		light_clustering->upload(render_frame, thread_index);
+		light_clustering->bind(command_buffer, 0, 4);
+	}
+	else
+	{
+		allocate_lights<DeferredLights>(scene.get_components<sg::Light>(), MAX_DEFERRED_LIGHT_COUNT);
+		command_buffer.bind_lighting(get_lighting_state(), 0, 4);
+	}
 
 	// Get shaders from cache
 	auto &resource_cache     = command_buffer.get_device().get_resource_cache();
@@ -91,11 +104,26 @@ void LightingSubpass::draw(vkb::core::CommandBufferC &command_buffer)
 
 	// Allocate a buffer using the buffer pool from the active frame to store uniform values and bind it
 	auto &render_frame = get_render_context().get_active_frame();
-	auto  allocation   = render_frame.allocate_buffer(VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT, sizeof(LightUniform));
+	auto  allocation   = render_frame.allocate_buffer(VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT, sizeof(LightUniform), thread_index);
 	allocation.update(light_uniform);
 	command_buffer.bind_buffer(allocation.get_buffer(), allocation.get_offset(), allocation.get_size(), 0, 3, 0);
 
 	// Draw full screen triangle triangle
 	command_buffer.draw(3, 1, 0, 0);
 }
+
+void LightingSubpass::set_light_clustering(std::unique_ptr<vkb::rendering::LightClustering> &&light_clustering_)
+{
+	if (light_clustering_ && !dynamic_cast<sg::PerspectiveCamera *>(&camera))
+	{
+		throw std::runtime_error("Light clustering requires a perspective camera");
+	}
+
+	light_clustering = std::move(light_clustering_);
+}
+
+void LightingSubpass::set_thread_index(uint32_t index)
+{
+	thread_index = index;
+}
 }        // namespace vkb
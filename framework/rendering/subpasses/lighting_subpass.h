@@ -18,6 +18,7 @@
 #pragma once
 
 #include "buffer_pool.h"
+#include "rendering/light_clustering.h"
 #include "rendering/subpass.h"
 
 #include "common/glm_common.h"
@@ -71,12 +72,28 @@ class LightingSubpass : public vkb::rendering::SubpassC
 
 	void draw(vkb::core::CommandBufferC &command_buffer) override;
 
+	/**
+	 * @brief Replaces the fixed light arrays with clustered light assignment, which lifts the MAX_DEFERRED_LIGHT_COUNT limit
+	 *        The fragment shader needs to use the resources declared in clustered_lighting.h, see clustered_lighting/lighting.frag
+	 * @param light_clustering The light binning to use, requires the subpass camera to be a perspective camera
+	 */
+	void set_light_clustering(std::unique_ptr<vkb::rendering::LightClustering> &&light_clustering);
+
+	/**
+	 * @brief Thread index to use for allocating resources
+	 */
+	void set_thread_index(uint32_t index);
+
   private:
 	sg::Camera &camera;
 
+	std::unique_ptr<vkb::rendering::LightClustering> light_clustering;
+
 	sg::Scene &scene;
 
 	ShaderVariant lighting_variant;
+
+	uint32_t thread_index{0};
 };
 
 }        // namespace vkb
@@ -109,61 +109,78 @@ void ResourceCache::clear_pipelines()
 
 void ResourceCache::update_descriptor_sets(const std::vector<core::ImageView> &old_views, const std::vector<core::ImageView> &new_views)
 {
-	// Find descriptor sets referring to the old image view
+	std::unordered_map<VkImageView, VkImageView> views;
+	for (size_t i = 0; i < old_views.size(); ++i)
+	{
+		views.emplace(old_views[i].get_handle(), new_views[i].get_handle());
+	}
+
+	update_descriptor_sets({}, views);
+}
+
+void ResourceCache::update_descriptor_sets(const std::unordered_map<VkBuffer, VkBuffer> &buffers, const std::unordered_map<VkImageView, VkImageView> &views)
+{
+	// Find descriptor sets referring to the old buffers and image views
 	std::vector<VkWriteDescriptorSet> set_updates;
 	std::set<size_t>                  matches;
 
-	for (size_t i = 0; i < old_views.size(); ++i)
+	for (auto &kd_pair : state.descriptor_sets)
 	{
-		auto &old_view = old_views[i];
-		auto &new_view = new_views[i];
+		auto &key            = kd_pair.first;
+		auto &descriptor_set = kd_pair.second;
+
+		auto add_write = [&](uint32_t binding, uint32_t array_element, const VkDescriptorBufferInfo *buffer_info, const VkDescriptorImageInfo *image_info) {
+			// Save key to remove old descriptor set
+			matches.insert(key);
+
+			// Save struct for writing the update later
+			if (auto binding_info = descriptor_set.get_layout().get_layout_binding(binding))
+			{
+				VkWriteDescriptorSet write_descriptor_set{VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET};
+				write_descriptor_set.dstBinding      = binding;
+				write_descriptor_set.descriptorType  = binding_info->descriptorType;
+				write_descriptor_set.pBufferInfo     = buffer_info;
+				write_descriptor_set.pImageInfo      = image_info;
+				write_descriptor_set.dstSet          = descriptor_set.get_handle();
+				write_descriptor_set.dstArrayElement = array_element;
+				write_descriptor_set.descriptorCount = 1;
+
+				set_updates.push_back(write_descriptor_set);
+			}
+			else
+			{
+				LOGE("Shader layout set does not use binding at #{}", binding);
+			}
+		};
 
-		for (auto &kd_pair : state.descriptor_sets)
+		for (auto &ba_pair : descriptor_set.get_buffer_infos())
 		{
-			auto &key            = kd_pair.first;
-			auto &descriptor_set = kd_pair.second;
+			for (auto &ai_pair : ba_pair.second)
+			{
+				auto &buffer_info = ai_pair.second;
 
-			auto &image_infos = descriptor_set.get_image_infos();
+				auto it = buffers.find(buffer_info.buffer);
+				if (it != buffers.end())
+				{
+					// Update buffer info with new buffer
+					buffer_info.buffer = it->second;
+					add_write(ba_pair.first, ai_pair.first, &buffer_info, nullptr);
+				}
+			}
+		}
 
-			for (auto &ba_pair : image_infos)
+		for (auto &ba_pair : descriptor_set.get_image_infos())
+		{
+			for (auto &ai_pair : ba_pair.second)
 			{
-				auto &binding = ba_pair.first;
-				auto &array   = ba_pair.second;
+				auto &image_info = ai_pair.second;
 
-				for (auto &ai_pair : array)
+				auto it = views.find(image_info.imageView);
+				if (it != views.end())
 				{
-					auto &array_element = ai_pair.first;
-					auto &image_info    = ai_pair.second;
-
-					if (image_info.imageView == old_view.get_handle())
-					{
-						// Save key to remove old descriptor set
-						matches.insert(key);
-
-						// Update image info with new view
-						image_info.imageView = new_view.get_handle();
-
-						// Save struct for writing the update later
-						{
-							VkWriteDescriptorSet write_descriptor_set{VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET};
-
-							if (auto binding_info = descriptor_set.get_layout().get_layout_binding(binding))
-							{
-								write_descriptor_set.dstBinding      = binding;
-								write_descriptor_set.descriptorType  = binding_info->descriptorType;
-								write_descriptor_set.pImageInfo      = &image_info;
-								write_descriptor_set.dstSet          = descriptor_set.get_handle();
-								write_descriptor_set.dstArrayElement = array_element;
-								write_descriptor_set.descriptorCount = 1;
-
-								set_updates.push_back(write_descriptor_set);
-							}
-							else
-							{
-								LOGE("Shader layout set does not use image binding at #{}", binding);
-							}
-						}
-					}
+					// Update image info with new view
+					image_info.imageView = it->second;
+					add_write(ba_pair.first, ai_pair.first, nullptr, &image_info);
 				}
 			}
 		}
@@ -125,6 +125,11 @@ class ResourceCache
 	/// @param new_views New image views to be referred
 	void update_descriptor_sets(const std::vector<core::ImageView> &old_views, const std::vector<core::ImageView> &new_views);
 
+	/// @brief Update those descriptor sets referring to old buffers or image views
+	/// @param buffers New buffer for each old buffer referred by descriptor sets
+	/// @param views New image view for each old image view referred by descriptor sets
+	void update_descriptor_sets(const std::unordered_map<VkBuffer, VkBuffer> &buffers, const std::unordered_map<VkImageView, VkImageView> &views);
+
 	void clear_framebuffers();
 
 	void clear();
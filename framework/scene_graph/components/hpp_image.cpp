@@ -18,6 +18,7 @@
 #include "hpp_image.h"
 
 #include "common/hpp_utils.h"
+#include "filesystem/filesystem.hpp"
 #include "filesystem/legacy.h"
 #include "scene_graph/components/image/astc.h"
 #include "scene_graph/components/image/ktx.h"
@@ -49,7 +50,8 @@ std::unique_ptr<vkb::scene_graph::components::HPPImage> HPPImage::load(const std
 {
 	std::unique_ptr<vkb::scene_graph::components::HPPImage> image{nullptr};
 
-	auto data = fs::read_asset(uri);
+	// The decoders read the file from its mapping, without copying it first
+	auto file = fs::map_asset(uri);
 
 	// Get extension
 	auto extension = get_extension(uri);
@@ -58,17 +60,17 @@ std::unique_ptr<vkb::scene_graph::components::HPPImage> HPPImage::load(const std
 	if (extension == "png" || extension == "jpg")
 	{
 		image = std::unique_ptr<vkb::scene_graph::components::HPPImage>(reinterpret_cast<vkb::scene_graph::components::HPPImage *>(
-		    std::make_unique<vkb::sg::Stb>(name, data, static_cast<vkb::sg::Image::ContentType>(content_type)).release()));
+		    std::make_unique<vkb::sg::Stb>(name, file->data(), file->size(), static_cast<vkb::sg::Image::ContentType>(content_type)).release()));
 	}
 	else if (extension == "astc")
 	{
 		image = std::unique_ptr<vkb::scene_graph::components::HPPImage>(
-		    reinterpret_cast<vkb::scene_graph::components::HPPImage *>(std::make_unique<vkb::sg::Astc>(name, data).release()));
+		    reinterpret_cast<vkb::scene_graph::components::HPPImage *>(std::make_unique<vkb::sg::Astc>(name, file->data(), file->size()).release()));
 	}
 	else if ((extension == "ktx") || (extension == "ktx2"))
 	{
 		image = std::unique_ptr<vkb::scene_graph::components::HPPImage>(reinterpret_cast<vkb::scene_graph::components::HPPImage *>(
-		    std::make_unique<vkb::sg::Ktx>(name, data, static_cast<vkb::sg::Image::ContentType>(content_type)).release()));
+		    std::make_unique<vkb::sg::Ktx>(name, file->data(), file->size(), static_cast<vkb::sg::Image::ContentType>(content_type)).release()));
 	}
 
 	return image;
@@ -202,6 +204,8 @@ void HPPImage::create_vk_image(vkb::core::HPPDevice &device, vk::ImageViewType i
 {
 	assert(!vk_image && !vk_image_view && "Vulkan HPPImage already constructed");
 
+	vkb::allocated::MemoryCategoryScope memory_category{vkb::allocated::MemoryCategory::Textures};
+
 	vk_image = std::make_unique<vkb::core::HPPImage>(device,
 	                                                 get_extent(),
 	                                                 format,
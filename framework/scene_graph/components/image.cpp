@@ -25,6 +25,7 @@
 #include <stb_image_resize.h>
 
 #include "common/utils.h"
+#include "filesystem/filesystem.hpp"
 #include "filesystem/legacy.h"
 #include "scene_graph/components/image/astc.h"
 #include "scene_graph/components/image/ktx.h"
@@ -200,10 +201,13 @@ void Image::create_vk_image(Device &device, VkImageViewType image_view_type, VkI
 {
 	assert(!vk_image && !vk_image_view && "Vulkan image already constructed");
 
+	allocated::MemoryCategoryScope memory_category{allocated::MemoryCategory::Textures};
+
+	// Transfer source for sg::TextureResidency, which copies the levels it keeps to a smaller image
 	vk_image = std::make_unique<core::Image>(device,
 	                                         get_extent(),
 	                                         format,
-	                                         VK_IMAGE_USAGE_SAMPLED_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT,
+	                                         VK_IMAGE_USAGE_SAMPLED_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT,
 	                                         VMA_MEMORY_USAGE_GPU_ONLY,
 	                                         VK_SAMPLE_COUNT_1_BIT,
 	                                         to_u32(mipmaps.size()),
@@ -222,12 +226,25 @@ const core::Image &Image::get_vk_image() const
 	return *vk_image;
 }
 
+core::Image &Image::get_vk_image()
+{
+	assert(vk_image && "Vulkan image was not created");
+	return *vk_image;
+}
+
 const core::ImageView &Image::get_vk_image_view() const
 {
 	assert(vk_image_view && "Vulkan image view was not created");
 	return *vk_image_view;
 }
 
+void Image::swap_vk_image(std::unique_ptr<core::Image> &image, std::unique_ptr<core::ImageView> &image_view)
+{
+	assert(image && image_view && "Vulkan image and view must both be given");
+	std::swap(vk_image, image);
+	std::swap(vk_image_view, image_view);
+}
+
 Mipmap &Image::get_mipmap(const size_t index)
 {
 	assert(index < mipmaps.size());
@@ -361,26 +378,27 @@ std::unique_ptr<Image> Image::load(const std::string &name, const std::string &u
 {
 	std::unique_ptr<Image> image{nullptr};
 
-	auto data = fs::read_asset(uri);
+	// The decoders read the file from its mapping, without copying it first
+	auto file = fs::map_asset(uri);
 
 	// Get extension
 	auto extension = get_extension(uri);
 
 	if (extension == "png" || extension == "jpg")
 	{
-		image = std::make_unique<Stb>(name, data, content_type);
+		image = std::make_unique<Stb>(name, file->data(), file->size(), content_type);
 	}
 	else if (extension == "astc")
 	{
-		image = std::make_unique<Astc>(name, data);
+		image = std::make_unique<Astc>(name, file->data(), file->size());
 	}
 	else if (extension == "ktx")
 	{
-		image = std::make_unique<Ktx>(name, data, content_type);
+		image = std::make_unique<Ktx>(name, file->data(), file->size(), content_type);
 	}
 	else if (extension == "ktx2")
 	{
-		image = std::make_unique<Ktx>(name, data, content_type);
+		image = std::make_unique<Ktx>(name, file->data(), file->size(), content_type);
 	}
 
 	return image;
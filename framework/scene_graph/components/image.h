@@ -98,8 +98,20 @@ class Image : public Component
 
 	const core::Image &get_vk_image() const;
 
+	/**
+	 * @brief Access to rebind the Vulkan image, such as after its memory was moved
+	 */
+	core::Image &get_vk_image();
+
 	const core::ImageView &get_vk_image_view() const;
 
+	/**
+	 * @brief Exchanges the Vulkan image and its view with the given ones, such as a copy holding fewer mip levels
+	 *
+	 * The previous image and view are returned in the arguments, they must be kept until the GPU no longer uses them.
+	 */
+	void swap_vk_image(std::unique_ptr<core::Image> &image, std::unique_ptr<core::ImageView> &image_view);
+
 	void coerce_format_to_srgb();
 
   protected:
@@ -47,6 +47,14 @@ class Astc : public Image
 	 */
 	Astc(const std::string &name, const std::vector<uint8_t> &data);
 
+	/**
+	 * @brief Decodes ASTC data with an ASTC header held in memory that is not owned by a vector, such as a mapped file
+	 * @param name Name of the component
+	 * @param data ASTC data with header
+	 * @param size Size of the data in bytes
+	 */
+	Astc(const std::string &name, const uint8_t *data, size_t size);
+
 	virtual ~Astc() = default;
 
   private:
@@ -28,6 +28,11 @@ class Ktx : public Image
   public:
 	Ktx(const std::string &name, const std::vector<uint8_t> &data, ContentType content_type);
 
+	/**
+	 * @brief Loads a KTX or KTX2 file held in memory that is not owned by a vector, such as a section of a scene package
+	 */
+	Ktx(const std::string &name, const uint8_t *data, size_t size, ContentType content_type);
+
 	virtual ~Ktx() = default;
 };
 
@@ -71,5 +71,15 @@ ShaderVariant &SubMesh::get_mut_shader_variant()
 {
 	return shader_variant;
 }
+
+void SubMesh::set_position_quantization(const PositionQuantization &quantization)
+{
+	position_quantization = quantization;
+}
+
+const PositionQuantization *SubMesh::get_position_quantization() const
+{
+	return position_quantization ? &*position_quantization : nullptr;
+}
 }        // namespace sg
 }        // namespace vkb
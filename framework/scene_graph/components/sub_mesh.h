@@ -18,6 +18,7 @@
 #pragma once
 
 #include <memory>
+#include <optional>
 #include <string>
 #include <typeinfo>
 #include <unordered_map>
@@ -26,6 +27,7 @@
 #include "common/vk_common.h"
 #include "core/buffer.h"
 #include "core/shader_module.h"
+#include "geometry/vertex_quantization.h"
 #include "scene_graph/component.h"
 
 namespace vkb
@@ -60,6 +62,9 @@ class SubMesh : public Component
 
 	std::uint32_t vertex_indices = 0;
 
+	/// Radius of the sphere around the origin of the model that encloses the vertex positions, set by GLTFLoader::load_model
+	float bounding_radius = 0.0f;
+
 	std::unordered_map<std::string, vkb::core::BufferC> vertex_buffers;
 
 	std::unique_ptr<vkb::core::BufferC> index_buffer;
@@ -76,12 +81,21 @@ class SubMesh : public Component
 
 	ShaderVariant &get_mut_shader_variant();
 
+	void set_position_quantization(const PositionQuantization &quantization);
+
+	/**
+	 * @return Parameters to reconstruct the positions, nullptr if they are stored as floats
+	 */
+	const PositionQuantization *get_position_quantization() const;
+
   private:
 	std::unordered_map<std::string, VertexAttribute> vertex_attributes;
 
 	const Material *material{nullptr};
 
 	ShaderVariant shader_variant;
+
+	std::optional<PositionQuantization> position_quantization;
 };
 }        // namespace sg
 }        // namespace vkb
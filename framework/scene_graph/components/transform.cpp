@@ -21,6 +21,7 @@
 #include <glm/gtx/matrix_decompose.hpp>
 
 #include "scene_graph/node.h"
+#include "scene_graph/scene_snapshot.h"
 
 namespace vkb
 {
@@ -64,16 +65,31 @@ void Transform::set_scale(const glm::vec3 &new_scale)
 
 const glm::vec3 &Transform::get_translation() const
 {
+	if (auto captured = SceneSnapshot::find(*this))
+	{
+		return captured->translation;
+	}
+
 	return translation;
 }
 
 const glm::quat &Transform::get_rotation() const
 {
+	if (auto captured = SceneSnapshot::find(*this))
+	{
+		return captured->rotation;
+	}
+
 	return rotation;
 }
 
 const glm::vec3 &Transform::get_scale() const
 {
+	if (auto captured = SceneSnapshot::find(*this))
+	{
+		return captured->scale;
+	}
+
 	return scale;
 }
 
@@ -95,6 +111,11 @@ glm::mat4 Transform::get_matrix() const
 
 glm::mat4 Transform::get_world_matrix()
 {
+	if (auto captured = SceneSnapshot::find(*this))
+	{
+		return captured->world_matrix;
+	}
+
 	update_world_transform();
 
 	return world_matrix;
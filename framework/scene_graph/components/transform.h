@@ -72,6 +72,8 @@ class Transform : public Component
 	void invalidate_world_matrix();
 
   private:
+	friend class SceneSnapshot;
+
 	Node &node;
 
 	glm::vec3 translation = glm::vec3(0.0, 0.0, 0.0);
@@ -84,6 +86,9 @@ class Transform : public Component
 
 	bool update_world_matrix = false;
 
+	/// Position of the transform in the last SceneSnapshot captured
+	uint32_t snapshot_index = ~0u;
+
 	void update_world_transform();
 };
 
@@ -55,6 +55,15 @@ class HPPScene : private vkb::sg::Scene
 		}
 	}
 
+	template <class T>
+	const std::vector<T *> &get_cached_components() const
+	{
+		static_assert(std::is_same<T, vkb::sg::Animation>::value || std::is_same<T, vkb::sg::Camera>::value || std::is_same<T, vkb::sg::Script>::value ||
+		                  std::is_same<T, vkb::sg::SubMesh>::value || std::is_same<T, vkb::sg::Texture>::value,
+		              "Please add a type-check here!");
+		return vkb::sg::Scene::get_cached_components<T>();
+	}
+
 	template <class T>
 	bool has_component() const
 	{
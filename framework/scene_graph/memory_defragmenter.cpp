@@ -0,0 +1,539 @@
+/* Copyright (c) 2025, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "scene_graph/memory_defragmenter.h"
+
+#include <algorithm>
+
+#include <core/util/counters.hpp>
+#include <core/util/profiling.hpp>
+
+#include "core/device.h"
+#include "core/image.h"
+#include "core/image_view.h"
+#include "rendering/render_context.h"
+#include "resource_cache.h"
+#include "scene_graph/components/image.h"
+#include "scene_graph/components/sub_mesh.h"
+#include "scene_graph/scene.h"
+
+namespace vkb
+{
+namespace sg
+{
+namespace
+{
+VkImageMemoryBarrier image_barrier(VkImage image, VkImageLayout old_layout, VkImageLayout new_layout, VkAccessFlags src_access, VkAccessFlags dst_access, const VkImageCreateInfo &create_info)
+{
+	VkImageMemoryBarrier barrier{VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER};
+	barrier.srcAccessMask       = src_access;
+	barrier.dstAccessMask       = dst_access;
+	barrier.oldLayout           = old_layout;
+	barrier.newLayout           = new_layout;
+	barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+	barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+	barrier.image               = image;
+	barrier.subresourceRange    = {VK_IMAGE_ASPECT_COLOR_BIT, 0, create_info.mipLevels, 0, create_info.arrayLayers};
+	return barrier;
+}
+
+VkDeviceSize get_unused_bytes(const VmaTotalStatistics &statistics)
+{
+	auto &total = statistics.total.statistics;
+	return total.blockBytes - std::min(total.blockBytes, total.allocationBytes);
+}
+}        // namespace
+
+MemoryDefragmenter::MemoryDefragmenter(Device &device, Scene &scene, const Settings &settings) :
+    Component{"Memory defragmenter"},
+    device{device},
+    scene{scene},
+    settings{settings}
+{
+	VkCommandPoolCreateInfo command_pool_info{VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO};
+	command_pool_info.flags            = VK_COMMAND_POOL_CREATE_TRANSIENT_BIT | VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT;
+	command_pool_info.queueFamilyIndex = device.get_suitable_graphics_queue().get_family_index();
+	VK_CHECK(vkCreateCommandPool(device.get_handle(), &command_pool_info, nullptr, &command_pool));
+
+	VkCommandBufferAllocateInfo allocate_info{VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO};
+	allocate_info.commandPool        = command_pool;
+	allocate_info.level              = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+	allocate_info.commandBufferCount = 1;
+	VK_CHECK(vkAllocateCommandBuffers(device.get_handle(), &allocate_info, &command_buffer));
+
+	VkFenceCreateInfo fence_info{VK_STRUCTURE_TYPE_FENCE_CREATE_INFO};
+	VK_CHECK(vkCreateFence(device.get_handle(), &fence_info, nullptr, &fence));
+}
+
+MemoryDefragmenter::~MemoryDefragmenter()
+{
+	finish();
+
+	vkDestroyFence(device.get_handle(), fence, nullptr);
+
+	// Destroys the command buffer too
+	vkDestroyCommandPool(device.get_handle(), command_pool, nullptr);
+}
+
+std::type_index MemoryDefragmenter::get_type()
+{
+	return typeid(MemoryDefragmenter);
+}
+
+void MemoryDefragmenter::update(RenderContext &render_context)
+{
+	PROFILE_SCOPE("Update memory defragmentation");
+
+	uint64_t current_frame = ++frame;
+	uint64_t frame_count   = render_context.get_render_frames().size();
+
+	if (pass_in_flight)
+	{
+		VkResult result = vkGetFenceStatus(device.get_handle(), fence);
+		if (result != VK_NOT_READY)
+		{
+			VK_CHECK(result);
+
+			// Frames begun before this one may still use the old handles
+			complete_pass(current_frame + frame_count);
+		}
+	}
+
+	if (!retired_handles.empty())
+	{
+		// The active frame was just begun, so the GPU no longer uses its descriptor sets, which may refer to the old
+		// handles. Once every frame has cleared its sets, the old handles are destroyed.
+		render_context.get_active_frame().clear_descriptors();
+
+		std::erase_if(retired_handles, [this, current_frame](RetiredHandles &retired) {
+			if (retired.destroy_frame > current_frame)
+			{
+				return false;
+			}
+			destroy(retired);
+			return true;
+		});
+	}
+
+	if (!context && current_frame % std::max(settings.check_interval, 1u) == 0 && is_fragmented())
+	{
+		VmaDefragmentationInfo defragmentation_info{};
+		defragmentation_info.flags                 = VMA_DEFRAGMENTATION_FLAG_ALGORITHM_BALANCED_BIT;
+		defragmentation_info.maxBytesPerPass       = settings.max_bytes_per_pass;
+		defragmentation_info.maxAllocationsPerPass = settings.max_allocations_per_pass;
+		VK_CHECK(vmaBeginDefragmentation(allocated::get_memory_allocator(), &defragmentation_info, &context));
+
+		LOGI("Memory defragmentation began");
+	}
+
+	if (context && !pass_in_flight)
+	{
+		begin_pass();
+	}
+}
+
+void MemoryDefragmenter::finish()
+{
+	if (pass_in_flight)
+	{
+		VK_CHECK(vkWaitForFences(device.get_handle(), 1, &fence, VK_TRUE, UINT64_MAX));
+		complete_pass(0);
+	}
+
+	if (context)
+	{
+		end_defragmentation();
+	}
+
+	// The device is idle, no frame uses the old handles anymore
+	for (auto &retired : retired_handles)
+	{
+		destroy(retired);
+	}
+	retired_handles.clear();
+}
+
+bool MemoryDefragmenter::is_defragmenting() const
+{
+	return context != VK_NULL_HANDLE;
+}
+
+const MemoryDefragmenter::Settings &MemoryDefragmenter::get_settings() const
+{
+	return settings;
+}
+
+bool MemoryDefragmenter::is_fragmented()
+{
+	VmaTotalStatistics statistics;
+	vmaCalculateStatistics(allocated::get_memory_allocator(), &statistics);
+
+	VkDeviceSize block_bytes = statistics.total.statistics.blockBytes;
+	VkDeviceSize unused      = get_unused_bytes(statistics);
+
+	// The space left by the last defragmentation is held by allocations that cannot move, only new gaps are worth it
+	VkDeviceSize new_unused = unused - std::min(unused, unused_bytes);
+
+	return new_unused >= settings.min_unused_bytes &&
+	       static_cast<double>(unused) >= settings.min_unused_fraction * static_cast<double>(block_bytes);
+}
+
+std::unordered_map<VmaAllocation, MemoryDefragmenter::Target> MemoryDefragmenter::get_targets() const
+{
+	std::unordered_map<VmaAllocation, Target> targets;
+
+	// Textures are assumed to be sampled only, in VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL
+	constexpr VkImageUsageFlags image_transfer_usage = VK_IMAGE_USAGE_TRANSFER_SRC_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT;
+	for (auto *image : scene.get_cached_components<Image>())
+	{
+		auto &vk_image    = image->get_vk_image();
+		auto &create_info = vk_image.get_create_info();
+		if (vk_image.is_movable() &&
+		    (create_info.usage & image_transfer_usage) == image_transfer_usage &&
+		    create_info.sharingMode == VK_SHARING_MODE_EXCLUSIVE &&
+		    create_info.samples == VK_SAMPLE_COUNT_1_BIT &&
+		    !is_depth_format(create_info.format))
+		{
+			targets.emplace(vk_image.get_allocation(), Target{nullptr, &vk_image});
+		}
+	}
+
+	constexpr VkBufferUsageFlags buffer_transfer_usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT;
+
+	auto add_buffer = [&targets](core::BufferC &buffer) {
+		// Device addresses may be stored in other buffers or shaders, which a move cannot update
+		if (buffer.is_movable() &&
+		    (buffer.get_usage() & buffer_transfer_usage) == buffer_transfer_usage &&
+		    !(buffer.get_usage() & VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT))
+		{
+			targets.emplace(buffer.get_allocation(), Target{&buffer, nullptr});
+		}
+	};
+
+	for (auto *sub_mesh : scene.get_cached_components<SubMesh>())
+	{
+		for (auto &vertex_buffer : sub_mesh->vertex_buffers)
+		{
+			add_buffer(vertex_buffer.second);
+		}
+		if (sub_mesh->index_buffer)
+		{
+			add_buffer(*sub_mesh->index_buffer);
+		}
+	}
+
+	return targets;
+}
+
+void MemoryDefragmenter::begin_pass()
+{
+	PROFILE_SCOPE("Record memory defragmentation pass");
+
+	static const vkb::Counter moved_bytes{"Defragmentation bytes moved", PlotType::Memory};
+	static const vkb::Counter moves{"Defragmentation moves"};
+
+	auto &allocator = allocated::get_memory_allocator();
+
+	VkResult result = vmaBeginDefragmentationPass(allocator, context, &pass);
+	if (result == VK_SUCCESS)
+	{
+		// Nothing left to move
+		end_defragmentation();
+		return;
+	}
+	if (result != VK_INCOMPLETE)
+	{
+		VK_CHECK(result);
+	}
+
+	auto targets = get_targets();
+
+	// The buffers and images in the new places, created before recording so that all barriers are batched
+	struct Copy
+	{
+		Target target;
+
+		VkBuffer new_buffer{VK_NULL_HANDLE};
+
+		VkImage new_image{VK_NULL_HANDLE};
+	};
+	std::vector<Copy> copies;
+
+	std::vector<VkImageMemoryBarrier> barriers;
+	for (uint32_t index = 0; index < pass.moveCount; ++index)
+	{
+		auto &move = pass.pMoves[index];
+
+		auto it = targets.find(move.srcAllocation);
+		if (it == targets.end())
+		{
+			// Not a resource of the scene, whose users cannot be told about the move
+			move.operation = VMA_DEFRAGMENTATION_MOVE_OPERATION_IGNORE;
+			continue;
+		}
+
+		Copy copy{it->second};
+		if (copy.target.buffer)
+		{
+			copy.new_buffer = move_buffer(*copy.target.buffer, move.dstTmpAllocation);
+		}
+		else
+		{
+			auto &image    = *copy.target.image;
+			copy.new_image = move_image(image, move.dstTmpAllocation);
+
+			barriers.push_back(image_barrier(image.get_handle(),
+			                                 VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+			                                 0, VK_ACCESS_TRANSFER_READ_BIT,
+			                                 image.get_create_info()));
+			barriers.push_back(image_barrier(copy.new_image,
+			                                 VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+			                                 0, VK_ACCESS_TRANSFER_WRITE_BIT,
+			                                 image.get_create_info()));
+		}
+
+		VmaAllocationInfo allocation_info;
+		vmaGetAllocationInfo(allocator, move.srcAllocation, &allocation_info);
+		moved_bytes.add(static_cast<double>(allocation_info.size));
+		moves.add();
+
+		copies.push_back(copy);
+	}
+
+	if (copies.empty())
+	{
+		// Every move was ignored, the pass ends without copies
+		result = vmaEndDefragmentationPass(allocator, context, &pass);
+		if (result == VK_SUCCESS)
+		{
+			end_defragmentation();
+		}
+		else if (result != VK_INCOMPLETE)
+		{
+			VK_CHECK(result);
+		}
+		return;
+	}
+
+	VkCommandBufferBeginInfo begin_info{VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO};
+	begin_info.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+	VK_CHECK(vkBeginCommandBuffer(command_buffer, &begin_info));
+
+	// Frames submitted before may still read the resources
+	vkCmdPipelineBarrier(command_buffer, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, 0,
+	                     0, nullptr, 0, nullptr, to_u32(barriers.size()), barriers.data());
+	barriers.clear();
+
+	for (auto &copy : copies)
+	{
+		if (copy.target.buffer)
+		{
+			VkBufferCopy buffer_copy{0, 0, copy.target.buffer->get_size()};
+			vkCmdCopyBuffer(command_buffer, copy.target.buffer->get_handle(), copy.new_buffer, 1, &buffer_copy);
+			continue;
+		}
+
+		auto &image       = *copy.target.image;
+		auto &create_info = image.get_create_info();
+
+		std::vector<VkImageCopy> image_copies;
+		for (uint32_t level = 0; level < create_info.mipLevels; ++level)
+		{
+			VkImageCopy image_copy{};
+			image_copy.srcSubresource = {VK_IMAGE_ASPECT_COLOR_BIT, level, 0, create_info.arrayLayers};
+			image_copy.dstSubresource = image_copy.srcSubresource;
+			image_copy.extent         = {std::max(1u, create_info.extent.width >> level),
+			                             std::max(1u, create_info.extent.height >> level),
+			                             std::max(1u, create_info.extent.depth >> level)};
+			image_copies.push_back(image_copy);
+		}
+		vkCmdCopyImage(command_buffer,
+		               image.get_handle(), VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+		               copy.new_image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+		               to_u32(image_copies.size()), image_copies.data());
+
+		barriers.push_back(image_barrier(copy.new_image,
+		                                 VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+		                                 VK_ACCESS_TRANSFER_WRITE_BIT, VK_ACCESS_SHADER_READ_BIT,
+		                                 create_info));
+	}
+
+	VkMemoryBarrier buffer_barrier{VK_STRUCTURE_TYPE_MEMORY_BARRIER};
+	buffer_barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+	buffer_barrier.dstAccessMask = VK_ACCESS_VERTEX_ATTRIBUTE_READ_BIT | VK_ACCESS_INDEX_READ_BIT | VK_ACCESS_SHADER_READ_BIT;
+
+	// Frames submitted after read the resources in the new places
+	vkCmdPipelineBarrier(command_buffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, 0,
+	                     1, &buffer_barrier, 0, nullptr, to_u32(barriers.size()), barriers.data());
+
+	VK_CHECK(vkEndCommandBuffer(command_buffer));
+
+	// Swap the handles only now, the old ones were the copy sources
+	for (auto &copy : copies)
+	{
+		if (copy.target.buffer)
+		{
+			auto &buffer = *copy.target.buffer;
+			buffer_moves.emplace(buffer.get_handle(), copy.new_buffer);
+			moved_buffers.push_back(&buffer);
+
+			buffer.set_handle(copy.new_buffer);
+			buffer.set_debug_name(buffer.get_debug_name());
+			continue;
+		}
+
+		auto &image = *copy.target.image;
+		old_images.push_back(image.get_handle());
+
+		image.set_handle(copy.new_image);
+		image.set_debug_name(image.get_debug_name());
+
+		for (auto *view : image.get_views())
+		{
+			VkImageViewCreateInfo view_info{VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO};
+			view_info.image            = copy.new_image;
+			view_info.viewType         = view->get_view_type();
+			view_info.format           = view->get_format();
+			view_info.subresourceRange = view->get_subresource_range();
+
+			VkImageView new_view;
+			VK_CHECK(vkCreateImageView(device.get_handle(), &view_info, nullptr, &new_view));
+			image_view_moves.emplace(view->get_handle(), new_view);
+
+			view->set_handle(new_view);
+			view->set_debug_name(view->get_debug_name());
+		}
+	}
+
+	VkSubmitInfo submit_info{VK_STRUCTURE_TYPE_SUBMIT_INFO};
+	submit_info.commandBufferCount = 1;
+	submit_info.pCommandBuffers    = &command_buffer;
+	VK_CHECK(device.get_suitable_graphics_queue().submit({submit_info}, fence));
+
+	pass_in_flight = true;
+}
+
+VkBuffer MemoryDefragmenter::move_buffer(core::BufferC &buffer, VmaAllocation allocation)
+{
+	// The buffers of a scene are only used by the graphics queue, they are not shared
+	VkBufferCreateInfo create_info{VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO};
+	create_info.size        = buffer.get_size();
+	create_info.usage       = buffer.get_usage();
+	create_info.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+
+	VkBuffer new_buffer;
+	VK_CHECK(vkCreateBuffer(device.get_handle(), &create_info, nullptr, &new_buffer));
+	VK_CHECK(vmaBindBufferMemory(allocated::get_memory_allocator(), allocation, new_buffer));
+
+	return new_buffer;
+}
+
+VkImage MemoryDefragmenter::move_image(core::Image &image, VmaAllocation allocation)
+{
+	// The queue family indices of the create info are not kept, but the images that move are not shared
+	VkImageCreateInfo create_info     = image.get_create_info();
+	create_info.pNext                 = nullptr;
+	create_info.sharingMode           = VK_SHARING_MODE_EXCLUSIVE;
+	create_info.queueFamilyIndexCount = 0;
+	create_info.pQueueFamilyIndices   = nullptr;
+	create_info.initialLayout         = VK_IMAGE_LAYOUT_UNDEFINED;
+
+	VkImage new_image;
+	VK_CHECK(vkCreateImage(device.get_handle(), &create_info, nullptr, &new_image));
+	VK_CHECK(vmaBindImageMemory(allocated::get_memory_allocator(), allocation, new_image));
+
+	return new_image;
+}
+
+void MemoryDefragmenter::complete_pass(uint64_t destroy_frame)
+{
+	VK_CHECK(vkResetFences(device.get_handle(), 1, &fence));
+	pass_in_flight = false;
+
+	// The copies are complete, the allocations take the places of the new handles and the old places are freed
+	VkResult result = vmaEndDefragmentationPass(allocated::get_memory_allocator(), context, &pass);
+	if (result != VK_SUCCESS && result != VK_INCOMPLETE)
+	{
+		VK_CHECK(result);
+	}
+
+	for (auto *buffer : moved_buffers)
+	{
+		buffer->update_mapped_data();
+	}
+
+	device.get_resource_cache().update_descriptor_sets(buffer_moves, image_view_moves);
+
+	RetiredHandles retired{{}, std::move(old_images), {}, destroy_frame};
+	for (auto &buffer_move : buffer_moves)
+	{
+		retired.buffers.push_back(buffer_move.first);
+	}
+	for (auto &image_view_move : image_view_moves)
+	{
+		retired.image_views.push_back(image_view_move.first);
+	}
+	retired_handles.push_back(std::move(retired));
+
+	moved_buffers.clear();
+	buffer_moves.clear();
+	image_view_moves.clear();
+	old_images.clear();
+
+	if (result == VK_SUCCESS)
+	{
+		end_defragmentation();
+	}
+}
+
+void MemoryDefragmenter::end_defragmentation()
+{
+	static const vkb::Counter freed_bytes{"Defragmentation bytes freed", PlotType::Memory};
+
+	auto &allocator = allocated::get_memory_allocator();
+
+	VmaDefragmentationStats stats{};
+	vmaEndDefragmentation(allocator, context, &stats);
+	context = VK_NULL_HANDLE;
+
+	freed_bytes.add(static_cast<double>(stats.bytesFreed));
+
+	VmaTotalStatistics statistics;
+	vmaCalculateStatistics(allocator, &statistics);
+	unused_bytes = get_unused_bytes(statistics);
+
+	LOGI("Memory defragmentation moved {} allocations ({} bytes) and freed {} memory blocks ({} bytes)",
+	     stats.allocationsMoved, stats.bytesMoved, stats.deviceMemoryBlocksFreed, stats.bytesFreed);
+}
+
+void MemoryDefragmenter::destroy(RetiredHandles &handles)
+{
+	for (auto image_view : handles.image_views)
+	{
+		vkDestroyImageView(device.get_handle(), image_view, nullptr);
+	}
+	for (auto image : handles.images)
+	{
+		vkDestroyImage(device.get_handle(), image, nullptr);
+	}
+	for (auto buffer : handles.buffers)
+	{
+		vkDestroyBuffer(device.get_handle(), buffer, nullptr);
+	}
+}
+}        // namespace sg
+}        // namespace vkb
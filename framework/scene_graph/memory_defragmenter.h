@@ -0,0 +1,179 @@
+/* Copyright (c) 2025, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <unordered_map>
+#include <vector>
+
+#include "common/vk_common.h"
+#include "core/buffer.h"
+#include "scene_graph/component.h"
+
+namespace vkb
+{
+class Device;
+class RenderContext;
+
+namespace core
+{
+class Image;
+class ImageView;
+}        // namespace core
+
+namespace sg
+{
+class Scene;
+
+/**
+ * @brief Compacts the device memory of a scene a little every frame, by moving its vertex buffers, index buffers and
+ *        textures with VMA defragmentation
+ *
+ * update() runs once per frame, after the active frame has been begun and before it is recorded. Every few frames it
+ * checks how much of the memory blocks of VMA is unused, and when that is too much, it begins a defragmentation. Each
+ * pass of the defragmentation moves a bounded number of bytes: a buffer or image is created in the new place, its
+ * contents are copied on the graphics queue before the frame is submitted, and the handle of the core::Buffer or
+ * core::Image is swapped for the new one, along with the views of the images. Allocations that do not belong to the
+ * scene are not moved, nor are buffers with device addresses.
+ *
+ * A pass ends once its copies complete, which frees the old memory. The old handles are destroyed once every frame
+ * has been begun again, and the descriptor sets cached by the frames are cleared in between, as they may refer to
+ * them. The descriptor sets of the resource cache are updated to the new handles.
+ *
+ * Samples that record command buffers once, holding on to the handles, must not use it. finish() must be called
+ * before the resources of the scene are destroyed.
+ */
+class MemoryDefragmenter : public Component
+{
+  public:
+	struct Settings
+	{
+		/// Bytes moved by a pass at most, which bounds the copies of a frame
+		VkDeviceSize max_bytes_per_pass = 16 * 1024 * 1024;
+
+		/// Allocations moved by a pass at most
+		uint32_t max_allocations_per_pass = 64;
+
+		/// Frames between two checks of the fragmentation
+		uint32_t check_interval = 60;
+
+		/// Fraction of the bytes of the memory blocks that must be unused to begin a defragmentation
+		float min_unused_fraction = 0.25f;
+
+		/// Bytes of the memory blocks that must be unused to begin a defragmentation
+		VkDeviceSize min_unused_bytes = 16 * 1024 * 1024;
+	};
+
+	MemoryDefragmenter(Device &device, Scene &scene, const Settings &settings = {});
+
+	virtual ~MemoryDefragmenter();
+
+	virtual std::type_index get_type() override;
+
+	/**
+	 * @brief Completes the pass of previous frames, and records the next pass or begins a defragmentation
+	 */
+	void update(RenderContext &render_context);
+
+	/**
+	 * @brief Waits for the pass in flight and ends the defragmentation, once the device is idle
+	 */
+	void finish();
+
+	bool is_defragmenting() const;
+
+	const Settings &get_settings() const;
+
+  private:
+	/**
+	 * @brief A buffer or image of the scene that can be moved
+	 */
+	struct Target
+	{
+		core::BufferC *buffer{nullptr};
+
+		core::Image *image{nullptr};
+	};
+
+	/**
+	 * @brief The handles a pass replaced, destroyed once no frame can use them
+	 */
+	struct RetiredHandles
+	{
+		std::vector<VkBuffer> buffers;
+
+		std::vector<VkImage> images;
+
+		std::vector<VkImageView> image_views;
+
+		uint64_t destroy_frame;
+	};
+
+	bool is_fragmented();
+
+	std::unordered_map<VmaAllocation, Target> get_targets() const;
+
+	void begin_pass();
+
+	VkBuffer move_buffer(core::BufferC &buffer, VmaAllocation allocation);
+
+	VkImage move_image(core::Image &image, VmaAllocation allocation);
+
+	void complete_pass(uint64_t destroy_frame);
+
+	void end_defragmentation();
+
+	void destroy(RetiredHandles &handles);
+
+	Device &device;
+
+	Scene &scene;
+
+	Settings settings;
+
+	uint64_t frame{0};
+
+	VmaDefragmentationContext context{VK_NULL_HANDLE};
+
+	VmaDefragmentationPassMoveInfo pass{};
+
+	// Whether the copies of the pass were submitted and the pass has yet to end
+	bool pass_in_flight{false};
+
+	VkCommandPool command_pool{VK_NULL_HANDLE};
+
+	VkCommandBuffer command_buffer{VK_NULL_HANDLE};
+
+	VkFence fence{VK_NULL_HANDLE};
+
+	// Buffers of the pass, whose mapped data moves with them
+	std::vector<core::BufferC *> moved_buffers;
+
+	// New handle of each handle replaced by the pass
+	std::unordered_map<VkBuffer, VkBuffer> buffer_moves;
+
+	std::unordered_map<VkImageView, VkImageView> image_view_moves;
+
+	std::vector<VkImage> old_images;
+
+	std::vector<RetiredHandles> retired_handles;
+
+	// Unused bytes of the memory blocks when the last defragmentation ended, which must grow to begin another one
+	VkDeviceSize unused_bytes{0};
+};
+}        // namespace sg
+}        // namespace vkb
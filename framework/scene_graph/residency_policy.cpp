@@ -0,0 +1,292 @@
+/* Copyright (c) 2025, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "scene_graph/residency_policy.h"
+
+#include <algorithm>
+#include <cassert>
+#include <numeric>
+
+namespace vkb
+{
+namespace sg
+{
+ResidencyPolicy::ResidencyPolicy() :
+    ResidencyPolicy{Settings{}}
+{
+}
+
+ResidencyPolicy::ResidencyPolicy(const Settings &settings) :
+    settings{settings}
+{
+}
+
+const ResidencyPolicy::Settings &ResidencyPolicy::get_settings() const
+{
+	return settings;
+}
+
+void ResidencyPolicy::set_settings(const Settings &new_settings)
+{
+	settings = new_settings;
+}
+
+uint32_t ResidencyPolicy::add_texture(std::vector<uint64_t> &&level_sizes)
+{
+	assert(!level_sizes.empty() && "A texture has at least one level");
+
+	uint32_t index;
+	if (free_textures.empty())
+	{
+		index = static_cast<uint32_t>(textures.size());
+		textures.emplace_back();
+	}
+	else
+	{
+		index = free_textures.back();
+		free_textures.pop_back();
+	}
+
+	auto &texture       = textures[index];
+	texture.level_sizes = std::move(level_sizes);
+	texture.first_level = 0;
+	texture.pinned      = false;
+	texture.alive       = true;
+
+	// A new texture counts as used, so that it is not dropped before it had a chance to be drawn
+	texture.last_used_frame.store(current_frame, std::memory_order_relaxed);
+
+	return index;
+}
+
+void ResidencyPolicy::remove_texture(uint32_t index)
+{
+	assert(index < textures.size() && textures[index].alive);
+
+	auto &texture = textures[index];
+	texture.level_sizes.clear();
+	texture.alive = false;
+
+	free_textures.push_back(index);
+}
+
+void ResidencyPolicy::mark_used(uint32_t index, uint64_t frame)
+{
+	assert(index < textures.size());
+	textures[index].last_used_frame.store(frame, std::memory_order_relaxed);
+}
+
+void ResidencyPolicy::set_pinned(uint32_t index, bool pinned)
+{
+	assert(index < textures.size());
+	textures[index].pinned = pinned;
+}
+
+std::vector<ResidencyPolicy::Change> ResidencyPolicy::update(uint64_t frame, const Budget &budget)
+{
+	current_frame = frame;
+
+	std::vector<Change> changes;
+
+	auto target = static_cast<uint64_t>(static_cast<double>(budget.budget) * settings.budget_fraction);
+	if (budget.usage > target)
+	{
+		evict(frame, budget.usage - target, changes);
+		return changes;
+	}
+
+	auto restore_target = static_cast<uint64_t>(static_cast<double>(target) * (1.0 - settings.restore_margin));
+
+	// The dropped levels of the textures in use, cold textures make room for them
+	auto     candidates = get_restore_candidates(frame);
+	uint64_t demand     = 0;
+	for (uint32_t index : candidates)
+	{
+		auto &sizes = textures[index].level_sizes;
+		demand += std::accumulate(sizes.begin(), sizes.begin() + textures[index].first_level, uint64_t{0});
+	}
+
+	if (demand > 0 && budget.usage + demand > restore_target)
+	{
+		evict(frame, budget.usage + demand - restore_target, changes);
+	}
+
+	if (budget.usage < restore_target)
+	{
+		restore(candidates, restore_target - budget.usage, changes);
+	}
+
+	return changes;
+}
+
+uint32_t ResidencyPolicy::get_first_level(uint32_t index) const
+{
+	assert(index < textures.size());
+	return textures[index].first_level;
+}
+
+uint32_t ResidencyPolicy::get_level_count(uint32_t index) const
+{
+	assert(index < textures.size());
+	return static_cast<uint32_t>(textures[index].level_sizes.size());
+}
+
+uint64_t ResidencyPolicy::get_last_used_frame(uint32_t index) const
+{
+	assert(index < textures.size());
+	return textures[index].last_used_frame.load(std::memory_order_relaxed);
+}
+
+uint64_t ResidencyPolicy::get_resident_size(uint32_t index) const
+{
+	assert(index < textures.size());
+	auto &sizes = textures[index].level_sizes;
+	return std::accumulate(sizes.begin() + std::min<size_t>(textures[index].first_level, sizes.size()), sizes.end(), uint64_t{0});
+}
+
+uint64_t ResidencyPolicy::get_resident_size() const
+{
+	uint64_t size = 0;
+	for (uint32_t index = 0; index < textures.size(); ++index)
+	{
+		if (textures[index].alive)
+		{
+			size += get_resident_size(index);
+		}
+	}
+	return size;
+}
+
+uint64_t ResidencyPolicy::get_evicted_size() const
+{
+	uint64_t size = 0;
+	for (auto &texture : textures)
+	{
+		if (texture.alive)
+		{
+			size += std::accumulate(texture.level_sizes.begin(), texture.level_sizes.begin() + texture.first_level, uint64_t{0});
+		}
+	}
+	return size;
+}
+
+uint32_t ResidencyPolicy::get_texture_count() const
+{
+	return static_cast<uint32_t>(textures.size() - free_textures.size());
+}
+
+bool ResidencyPolicy::is_candidate(const Texture &texture) const
+{
+	return texture.alive && !texture.pinned;
+}
+
+void ResidencyPolicy::evict(uint64_t frame, uint64_t excess, std::vector<Change> &changes)
+{
+	std::vector<uint32_t> candidates;
+	for (uint32_t index = 0; index < textures.size(); ++index)
+	{
+		auto    &texture   = textures[index];
+		uint64_t last_used = texture.last_used_frame.load(std::memory_order_relaxed);
+		// Textures used by the previous frame are never dropped, they may be getting their levels back
+		if (is_candidate(texture) &&
+		    last_used + std::max(settings.cold_frames, 2u) <= frame &&
+		    texture.first_level + settings.min_resident_levels < texture.level_sizes.size())
+		{
+			candidates.push_back(index);
+		}
+	}
+
+	// Least recently used first, and the largest first among textures last used by the same frame
+	std::ranges::sort(candidates, [this](uint32_t a, uint32_t b) {
+		uint64_t last_used_a = textures[a].last_used_frame.load(std::memory_order_relaxed);
+		uint64_t last_used_b = textures[b].last_used_frame.load(std::memory_order_relaxed);
+		if (last_used_a != last_used_b)
+		{
+			return last_used_a < last_used_b;
+		}
+		return get_resident_size(a) > get_resident_size(b);
+	});
+
+	for (uint32_t index : candidates)
+	{
+		if (excess == 0 || changes.size() >= settings.max_changes_per_update)
+		{
+			break;
+		}
+
+		auto    &texture              = textures[index];
+		uint32_t previous_first_level = texture.first_level;
+
+		// The top level holds most of the size of a texture, so levels are dropped one at a time
+		while (excess > 0 && texture.first_level + settings.min_resident_levels < texture.level_sizes.size())
+		{
+			excess -= std::min(excess, texture.level_sizes[texture.first_level]);
+			++texture.first_level;
+		}
+
+		changes.push_back({index, texture.first_level, previous_first_level});
+	}
+}
+
+std::vector<uint32_t> ResidencyPolicy::get_restore_candidates(uint64_t frame) const
+{
+	std::vector<uint32_t> candidates;
+	for (uint32_t index = 0; index < textures.size(); ++index)
+	{
+		auto &texture = textures[index];
+		if (is_candidate(texture) &&
+		    texture.first_level > 0 &&
+		    texture.last_used_frame.load(std::memory_order_relaxed) + 1 >= frame)
+		{
+			candidates.push_back(index);
+		}
+	}
+
+	// Textures missing the most levels first, they are the most visibly blurred
+	std::ranges::sort(candidates, [this](uint32_t a, uint32_t b) {
+		return textures[a].first_level > textures[b].first_level;
+	});
+
+	return candidates;
+}
+
+void ResidencyPolicy::restore(const std::vector<uint32_t> &candidates, uint64_t headroom, std::vector<Change> &changes)
+{
+	for (uint32_t index : candidates)
+	{
+		if (changes.size() >= settings.max_changes_per_update)
+		{
+			break;
+		}
+
+		auto    &texture              = textures[index];
+		uint32_t previous_first_level = texture.first_level;
+
+		while (texture.first_level > 0 && texture.level_sizes[texture.first_level - 1] <= headroom)
+		{
+			headroom -= texture.level_sizes[texture.first_level - 1];
+			--texture.first_level;
+		}
+
+		if (texture.first_level != previous_first_level)
+		{
+			changes.push_back({index, texture.first_level, previous_first_level});
+		}
+	}
+}
+}        // namespace sg
+}        // namespace vkb
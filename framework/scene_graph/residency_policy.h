@@ -0,0 +1,174 @@
+/* Copyright (c) 2025, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <vector>
+
+namespace vkb
+{
+namespace sg
+{
+/**
+ * @brief Decides which mip levels of which textures stay resident, so that the heap usage stays under a budget
+ *
+ * The policy only does bookkeeping, it does not touch Vulkan: textures are described by the size of their levels, and
+ * the heap budget and usage are passed to each update. This lets a simulated heap drive it.
+ *
+ * When the usage is over the target, the top levels of the textures that have not been used for a while are dropped,
+ * least recently used first. Textures used by the last frame get their dropped levels back while the usage is under
+ * the target minus a margin, and the levels they miss count as usage when picking the levels to drop, so that cold
+ * textures make room for them.
+ */
+class ResidencyPolicy
+{
+  public:
+	struct Settings
+	{
+		/// Fraction of the heap budget the heap usage is kept under
+		float budget_fraction = 0.8f;
+
+		/// Fraction of the target left free when levels are brought back, so that textures do not bounce
+		float restore_margin = 0.05f;
+
+		/// Frames a texture must go unused before its levels are dropped
+		uint32_t cold_frames = 120;
+
+		/// Levels a texture always keeps, the smallest ones
+		uint32_t min_resident_levels = 1;
+
+		/// Textures changed by an update at most, which bounds the copies of a frame
+		uint32_t max_changes_per_update = 8;
+	};
+
+	/**
+	 * @brief Budget and usage of the heap the textures are allocated from, in bytes
+	 */
+	struct Budget
+	{
+		uint64_t budget;
+
+		uint64_t usage;
+	};
+
+	/**
+	 * @brief A texture whose resident levels change, first_level is its new most detailed resident level
+	 */
+	struct Change
+	{
+		uint32_t texture;
+
+		uint32_t first_level;
+
+		uint32_t previous_first_level;
+	};
+
+	ResidencyPolicy();
+
+	explicit ResidencyPolicy(const Settings &settings);
+
+	const Settings &get_settings() const;
+
+	void set_settings(const Settings &settings);
+
+	/**
+	 * @brief Starts tracking a fully resident texture
+	 * @param level_sizes Size of each level in bytes, the most detailed first
+	 * @return Index of the texture
+	 */
+	uint32_t add_texture(std::vector<uint64_t> &&level_sizes);
+
+	void remove_texture(uint32_t texture);
+
+	/**
+	 * @brief Records that a texture is used by the given frame
+	 *
+	 * Can be called from several threads at once, but not at the same time as the other functions.
+	 */
+	void mark_used(uint32_t texture, uint64_t frame);
+
+	/**
+	 * @brief Keeps the policy from changing a texture, such as while a previous change is applied
+	 */
+	void set_pinned(uint32_t texture, bool pinned);
+
+	/**
+	 * @brief Picks the textures whose levels are dropped or brought back, and updates their resident levels
+	 * @param frame Index of the frame, which increases by one every update
+	 * @param budget Budget and usage of the heap, the usage being expected to follow the changes of the previous updates
+	 */
+	std::vector<Change> update(uint64_t frame, const Budget &budget);
+
+	uint32_t get_first_level(uint32_t texture) const;
+
+	uint32_t get_level_count(uint32_t texture) const;
+
+	uint64_t get_last_used_frame(uint32_t texture) const;
+
+	uint64_t get_resident_size(uint32_t texture) const;
+
+	/**
+	 * @return The size of the resident levels of all textures
+	 */
+	uint64_t get_resident_size() const;
+
+	/**
+	 * @return The size of the dropped levels of all textures
+	 */
+	uint64_t get_evicted_size() const;
+
+	uint32_t get_texture_count() const;
+
+  private:
+	struct Texture
+	{
+		std::vector<uint64_t> level_sizes;
+
+		uint32_t first_level{0};
+
+		std::atomic<uint64_t> last_used_frame{0};
+
+		bool pinned{false};
+
+		bool alive{false};
+	};
+
+	bool is_candidate(const Texture &texture) const;
+
+	void evict(uint64_t frame, uint64_t excess, std::vector<Change> &changes);
+
+	/**
+	 * @return The textures used by the previous frame that miss levels, in the order they get them back
+	 */
+	std::vector<uint32_t> get_restore_candidates(uint64_t frame) const;
+
+	void restore(const std::vector<uint32_t> &candidates, uint64_t headroom, std::vector<Change> &changes);
+
+	Settings settings;
+
+	// A deque does not move its elements when it grows, the atomics of the textures stay in place
+	std::deque<Texture> textures;
+
+	std::vector<uint32_t> free_textures;
+
+	uint64_t current_frame{0};
+};
+}        // namespace sg
+}        // namespace vkb
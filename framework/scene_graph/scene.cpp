@@ -60,6 +60,7 @@ void Scene::add_child(Node &child)
 std::unique_ptr<Component> Scene::get_model(uint32_t index)
 {
 	auto meshes = std::move(components.at(typeid(SubMesh)));
+	clear_component_cache(typeid(SubMesh));
 
 	assert(index < meshes.size());
 	return std::move(meshes[index]);
@@ -71,6 +72,7 @@ void Scene::add_component(std::unique_ptr<Component> &&component, Node &node)
 
 	if (component)
 	{
+		clear_component_cache(component->get_type());
 		components[component->get_type()].push_back(std::move(component));
 	}
 }
@@ -79,12 +81,14 @@ void Scene::add_component(std::unique_ptr<Component> &&component)
 {
 	if (component)
 	{
+		clear_component_cache(component->get_type());
 		components[component->get_type()].push_back(std::move(component));
 	}
 }
 
 void Scene::set_components(const std::type_index &type_info, std::vector<std::unique_ptr<Component>> &&new_components)
 {
+	clear_component_cache(type_info);
 	components[type_info] = std::move(new_components);
 }
 
@@ -135,5 +139,11 @@ Node &Scene::get_root_node()
 {
 	return *root;
 }
+
+void Scene::clear_component_cache(const std::type_index &type_info)
+{
+	std::lock_guard<std::mutex> lock{component_caches_mutex};
+	component_caches.erase(type_info);
+}
 }        // namespace sg
 }        // namespace vkb
\ No newline at end of file
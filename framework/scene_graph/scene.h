@@ -19,6 +19,7 @@
 
 #include <algorithm>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <typeindex>
 #include <unordered_map>
@@ -111,6 +112,28 @@ class Scene
 		return result;
 	}
 
+	/**
+	 * @return Cached list of pointers to components casted to the given template type
+	 *
+	 * Unlike get_components, the list is only built again after components of that type are added or set,
+	 * which suits iterating over the components every frame. The list stays valid until then.
+	 * The list is built on first use, which may happen on any thread, but it must not be used while components
+	 * of that type are added or set.
+	 */
+	template <class T>
+	const std::vector<T *> &get_cached_components() const
+	{
+		std::lock_guard<std::mutex> lock{component_caches_mutex};
+
+		auto it = component_caches.find(typeid(T));
+		if (it == component_caches.end())
+		{
+			it = component_caches.emplace(typeid(T), std::make_shared<std::vector<T *>>(get_components<T>())).first;
+		}
+
+		return *std::static_pointer_cast<std::vector<T *>>(it->second);
+	}
+
 	/**
 	 * @return List of components for the given type
 	 */
@@ -131,6 +154,8 @@ class Scene
 	Node &get_root_node();
 
   private:
+	void clear_component_cache(const std::type_index &type_info);
+
 	std::string name;
 
 	/// List of all the nodes
@@ -139,6 +164,12 @@ class Scene
 	Node *root{nullptr};
 
 	std::unordered_map<std::type_index, std::vector<std::unique_ptr<Component>>> components;
+
+	/// Lists returned by get_cached_components, with their element type erased
+	mutable std::unordered_map<std::type_index, std::shared_ptr<void>> component_caches;
+
+	/// Guards component_caches, which the scene update worker and the main thread may both fill
+	mutable std::mutex component_caches_mutex;
 };
 }        // namespace sg
 }        // namespace vkb
\ No newline at end of file
@@ -0,0 +1,96 @@
+/* Copyright (c) 2025, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "scene_snapshot.h"
+
+#include <queue>
+
+#include "components/transform.h"
+#include "node.h"
+#include "scene.h"
+
+namespace vkb
+{
+namespace sg
+{
+namespace
+{
+thread_local bool is_live_thread = false;
+}        // namespace
+
+std::atomic<const SceneSnapshot *> SceneSnapshot::published{nullptr};
+
+SceneSnapshot::LiveScope::LiveScope() :
+    previous{is_live_thread}
+{
+	is_live_thread = true;
+}
+
+SceneSnapshot::LiveScope::~LiveScope()
+{
+	is_live_thread = previous;
+}
+
+void SceneSnapshot::capture(Scene &scene)
+{
+	LiveScope live;
+
+	transforms.clear();
+
+	std::queue<Node *> traverse_nodes;
+	traverse_nodes.push(&scene.get_root_node());
+
+	while (!traverse_nodes.empty())
+	{
+		auto node = traverse_nodes.front();
+		traverse_nodes.pop();
+
+		auto &transform          = node->get_transform();
+		transform.snapshot_index = static_cast<uint32_t>(transforms.size());
+		transforms.push_back({&transform, transform.get_translation(), transform.get_rotation(), transform.get_scale(), transform.get_world_matrix()});
+
+		for (auto child_node : node->get_children())
+		{
+			traverse_nodes.push(child_node);
+		}
+	}
+}
+
+void SceneSnapshot::publish(const SceneSnapshot *snapshot)
+{
+	published.store(snapshot, std::memory_order_release);
+}
+
+const SceneSnapshot::TransformState *SceneSnapshot::find_published(const Transform &transform)
+{
+	auto snapshot = published.load(std::memory_order_acquire);
+	if (!snapshot || is_live_thread)
+	{
+		return nullptr;
+	}
+
+	// Transforms added after the capture are read live
+	auto index = transform.snapshot_index;
+	if (index < snapshot->transforms.size() && snapshot->transforms[index].transform == &transform)
+	{
+		return &snapshot->transforms[index];
+	}
+
+	return nullptr;
+}
+}        // namespace sg
+}        // namespace vkb
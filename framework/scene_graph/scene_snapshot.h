@@ -0,0 +1,107 @@
+/* Copyright (c) 2025, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <vector>
+
+#include "common/glm_common.h"
+
+namespace vkb
+{
+namespace sg
+{
+class Scene;
+class Transform;
+
+/**
+ * @brief Copy of the transforms of a scene, read by rendering while the scene is updated for the next frame
+ *
+ * Once published, every sg::Transform of the captured scene returns its captured values, except on threads
+ * holding a LiveScope. This lets the scripts and animations of frame N+1 run on a worker, in a LiveScope,
+ * while frame N is recorded, on any number of threads, from the snapshot.
+ */
+class SceneSnapshot
+{
+  public:
+	struct TransformState
+	{
+		const Transform *transform;
+
+		glm::vec3 translation;
+
+		glm::quat rotation;
+
+		glm::vec3 scale;
+
+		glm::mat4 world_matrix;
+	};
+
+	/**
+	 * @brief Marks the current thread as updating the scene, its transforms are read and written live
+	 */
+	class LiveScope
+	{
+	  public:
+		LiveScope();
+
+		~LiveScope();
+
+		LiveScope(const LiveScope &)            = delete;
+		LiveScope &operator=(const LiveScope &) = delete;
+
+	  private:
+		bool previous;
+	};
+
+	/**
+	 * @brief Copies the transforms of all the nodes of the scene
+	 */
+	void capture(Scene &scene);
+
+	/**
+	 * @brief Makes transforms return the values of a snapshot, or their own values again for nullptr
+	 *
+	 * The snapshot must outlive its publication and must not be captured again while it is published.
+	 */
+	static void publish(const SceneSnapshot *snapshot);
+
+	/**
+	 * @return The captured state of a transform, nullptr if the transform should be read live
+	 *
+	 * Inline as every sg::Transform getter calls it: unless a snapshot is published, it costs a single load.
+	 */
+	static const TransformState *find(const Transform &transform)
+	{
+		if (!published.load(std::memory_order_relaxed))
+		{
+			return nullptr;
+		}
+
+		return find_published(transform);
+	}
+
+  private:
+	static const TransformState *find_published(const Transform &transform);
+
+	std::vector<TransformState> transforms;
+
+	static std::atomic<const SceneSnapshot *> published;
+};
+}        // namespace sg
+}        // namespace vkb
@@ -0,0 +1,602 @@
+/* Copyright (c) 2025, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "scene_graph/texture_residency.h"
+
+#include <algorithm>
+#include <cstring>
+#include <numeric>
+
+#include <core/util/counters.hpp>
+#include <core/util/profiling.hpp>
+
+#include "common/strings.h"
+#include "core/device.h"
+#include "core/image.h"
+#include "core/image_view.h"
+#include "rendering/render_context.h"
+#include "scene_graph/components/image.h"
+#include "scene_graph/scene.h"
+
+namespace vkb
+{
+namespace sg
+{
+namespace
+{
+/**
+ * @brief Size in bytes and extent in texels of the blocks of a format, a size of 0 if the layout of the format is unknown
+ */
+struct FormatBlock
+{
+	uint32_t size;
+	uint32_t width;
+	uint32_t height;
+};
+
+FormatBlock get_format_block(VkFormat format)
+{
+	if (format >= VK_FORMAT_BC1_RGB_UNORM_BLOCK && format <= VK_FORMAT_BC7_SRGB_BLOCK)
+	{
+		// BC1 and BC4 blocks take 8 bytes, the others 16
+		bool is_half_size = format <= VK_FORMAT_BC1_RGBA_SRGB_BLOCK || format == VK_FORMAT_BC4_UNORM_BLOCK || format == VK_FORMAT_BC4_SNORM_BLOCK;
+		return {is_half_size ? 8u : 16u, 4, 4};
+	}
+
+	if (format >= VK_FORMAT_ETC2_R8G8B8_UNORM_BLOCK && format <= VK_FORMAT_EAC_R11G11_SNORM_BLOCK)
+	{
+		// ETC2 with an alpha channel and two channel EAC blocks take 16 bytes, the others 8
+		bool is_full_size = format == VK_FORMAT_ETC2_R8G8B8A8_UNORM_BLOCK || format == VK_FORMAT_ETC2_R8G8B8A8_SRGB_BLOCK ||
+		                    format == VK_FORMAT_EAC_R11G11_UNORM_BLOCK || format == VK_FORMAT_EAC_R11G11_SNORM_BLOCK;
+		return {is_full_size ? 16u : 8u, 4, 4};
+	}
+
+	if (format >= VK_FORMAT_ASTC_4x4_UNORM_BLOCK && format <= VK_FORMAT_ASTC_12x12_SRGB_BLOCK)
+	{
+		// The ASTC formats come in UNORM and SRGB pairs, in this order of block extents
+		static const uint32_t extents[][2] = {{4, 4}, {5, 4}, {5, 5}, {6, 5}, {6, 6}, {8, 5}, {8, 6}, {8, 8}, {10, 5}, {10, 6}, {10, 8}, {10, 10}, {12, 10}, {12, 12}};
+
+		auto &extent = extents[(format - VK_FORMAT_ASTC_4x4_UNORM_BLOCK) / 2];
+		return {16, extent[0], extent[1]};
+	}
+
+	int32_t bits_per_pixel = get_bits_per_pixel(format);
+	if (bits_per_pixel > 0 && bits_per_pixel % 8 == 0 && !is_depth_format(format))
+	{
+		return {static_cast<uint32_t>(bits_per_pixel / 8), 1, 1};
+	}
+
+	return {0, 0, 0};
+}
+
+VkExtent3D get_level_extent(const Image &image, uint32_t level)
+{
+	const auto &extent = image.get_extent();
+	return {std::max(1u, extent.width >> level),
+	        std::max(1u, extent.height >> level),
+	        std::max(1u, std::max(1u, extent.depth) >> level)};
+}
+
+VkImageMemoryBarrier image_barrier(VkImage image, VkImageLayout old_layout, VkImageLayout new_layout, VkAccessFlags src_access, VkAccessFlags dst_access, uint32_t level_count, uint32_t layer_count)
+{
+	VkImageMemoryBarrier barrier{VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER};
+	barrier.srcAccessMask       = src_access;
+	barrier.dstAccessMask       = dst_access;
+	barrier.oldLayout           = old_layout;
+	barrier.newLayout           = new_layout;
+	barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+	barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+	barrier.image               = image;
+	barrier.subresourceRange    = {VK_IMAGE_ASPECT_COLOR_BIT, 0, level_count, 0, layer_count};
+	return barrier;
+}
+
+VkDeviceSize align(VkDeviceSize offset, VkDeviceSize alignment)
+{
+	return (offset + alignment - 1) / alignment * alignment;
+}
+}        // namespace
+
+TextureResidency::TextureResidency(Device &device, const ResidencyPolicy::Settings &settings) :
+    Component{"Texture residency"},
+    device{device},
+    policy{settings}
+{
+	// Textures live in the largest device local heap
+	const VkPhysicalDeviceMemoryProperties *memory_properties = nullptr;
+	vmaGetMemoryProperties(allocated::get_memory_allocator(), &memory_properties);
+
+	VkDeviceSize heap_size = 0;
+	for (uint32_t index = 0; index < memory_properties->memoryHeapCount; ++index)
+	{
+		auto &heap = memory_properties->memoryHeaps[index];
+		if ((heap.flags & VK_MEMORY_HEAP_DEVICE_LOCAL_BIT) && heap.size > heap_size)
+		{
+			heap_index = index;
+			heap_size  = heap.size;
+		}
+	}
+
+	VkCommandPoolCreateInfo command_pool_info{VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO};
+	command_pool_info.flags            = VK_COMMAND_POOL_CREATE_TRANSIENT_BIT | VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT;
+	command_pool_info.queueFamilyIndex = device.get_suitable_graphics_queue().get_family_index();
+	VK_CHECK(vkCreateCommandPool(device.get_handle(), &command_pool_info, nullptr, &command_pool));
+}
+
+TextureResidency::~TextureResidency()
+{
+	for (auto &batch : batches)
+	{
+		vkWaitForFences(device.get_handle(), 1, &batch.fence, VK_TRUE, UINT64_MAX);
+		free_fences.push_back(batch.fence);
+	}
+	batches.clear();
+
+	for (auto fence : free_fences)
+	{
+		vkDestroyFence(device.get_handle(), fence, nullptr);
+	}
+
+	// Destroys the command buffers too
+	vkDestroyCommandPool(device.get_handle(), command_pool, nullptr);
+}
+
+std::type_index TextureResidency::get_type()
+{
+	return typeid(TextureResidency);
+}
+
+bool TextureResidency::add_image(Image &image, VkImageViewType view_type, VkImageCreateFlags flags)
+{
+	if (image_indices.contains(&image))
+	{
+		return true;
+	}
+
+	FormatBlock block = get_format_block(image.get_format());
+	if (block.size == 0)
+	{
+		LOGW("Texture residency does not manage image {}, the layout of format {} is unknown", image.get_name(), to_string(image.get_format()));
+		return false;
+	}
+
+	uint32_t level_count = to_u32(image.get_mipmaps().size());
+
+	ManagedImage managed{&image, 0, view_type, flags, {}, std::lcm<VkDeviceSize>(16, block.size), {}};
+
+	std::vector<uint64_t> level_sizes;
+	for (uint32_t level = 0; level < level_count; ++level)
+	{
+		VkExtent3D extent = get_level_extent(image, level);
+
+		VkDeviceSize size = VkDeviceSize{(extent.width + block.width - 1) / block.width} *
+		                    ((extent.height + block.height - 1) / block.height) *
+		                    extent.depth * block.size * image.get_layers();
+
+		managed.level_sizes.push_back(size);
+		level_sizes.push_back(size);
+	}
+	managed.evicted_levels.resize(level_count);
+
+	// Images are never removed, so the textures of the policy are numbered like the managed images
+	managed.texture = policy.add_texture(std::move(level_sizes));
+	assert(managed.texture == managed_images.size());
+
+	image_indices.emplace(&image, to_u32(managed_images.size()));
+	managed_images.push_back(std::move(managed));
+
+	return true;
+}
+
+void TextureResidency::add_scene(Scene &scene)
+{
+	for (auto *image : scene.get_components<Image>())
+	{
+		if (image->get_layers() == 1 && image->get_mipmaps().size() > 1)
+		{
+			add_image(*image);
+		}
+	}
+
+	LOGI("Texture residency manages {} images", policy.get_texture_count());
+}
+
+void TextureResidency::mark_used(const Image &image)
+{
+	auto it = image_indices.find(&image);
+	if (it != image_indices.end())
+	{
+		policy.mark_used(managed_images[it->second].texture, frame.load(std::memory_order_relaxed));
+	}
+}
+
+void TextureResidency::update(RenderContext &render_context)
+{
+	PROFILE_SCOPE("Update texture residency");
+
+	uint64_t current_frame = frame.fetch_add(1, std::memory_order_relaxed) + 1;
+
+	complete_batches(render_context.get_render_frames().size());
+
+	if (!retired_images.empty())
+	{
+		// The active frame was just begun, so the GPU no longer uses its descriptor sets, which may refer to the views
+		// of the retired images. Once every frame has cleared its sets, the retired images are destroyed.
+		render_context.get_active_frame().clear_descriptors();
+
+		std::erase_if(retired_images, [this, current_frame](RetiredImage &retired) {
+			if (retired.destroy_frame > current_frame)
+			{
+				return false;
+			}
+			pending_release_size -= std::min(pending_release_size, retired.image->get_image_required_size());
+			return true;
+		});
+	}
+
+	auto changes = policy.update(current_frame, get_budget());
+	if (!changes.empty())
+	{
+		record_changes(changes);
+	}
+
+	static const vkb::Counter resident_size{"Resident texture bytes", PlotType::Memory};
+	static const vkb::Counter evicted_size{"Evicted texture bytes", PlotType::Memory};
+	resident_size.set(static_cast<double>(policy.get_resident_size()));
+	evicted_size.set(static_cast<double>(policy.get_evicted_size()));
+}
+
+ResidencyPolicy &TextureResidency::get_policy()
+{
+	return policy;
+}
+
+void TextureResidency::complete_batches(uint64_t frame_count)
+{
+	uint64_t current_frame = frame.load(std::memory_order_relaxed);
+
+	while (!batches.empty())
+	{
+		auto &batch = batches.front();
+
+		VkResult result = vkGetFenceStatus(device.get_handle(), batch.fence);
+		if (result == VK_NOT_READY)
+		{
+			break;
+		}
+		VK_CHECK(result);
+
+		if (batch.readback_buffer)
+		{
+			batch.readback_buffer->invalidate();
+			const uint8_t *data = batch.readback_buffer->get_data();
+
+			for (auto &readback : batch.readbacks)
+			{
+				auto &managed = managed_images[readback.managed_image];
+				for (uint32_t level = readback.first_level; level < readback.end_level; ++level)
+				{
+					const uint8_t *level_data = data + readback.offsets[level - readback.first_level];
+					managed.evicted_levels[level].assign(level_data, level_data + managed.level_sizes[level]);
+				}
+			}
+		}
+
+		for (uint32_t index : batch.managed_images)
+		{
+			policy.set_pinned(managed_images[index].texture, false);
+		}
+
+		// Frames begun before this one may still use the replaced images
+		for (size_t index = 0; index < batch.old_images.size(); ++index)
+		{
+			retired_images.push_back({std::move(batch.old_images[index]), std::move(batch.old_image_views[index]), current_frame + frame_count});
+		}
+
+		VK_CHECK(vkResetFences(device.get_handle(), 1, &batch.fence));
+		free_fences.push_back(batch.fence);
+		free_command_buffers.push_back(batch.command_buffer);
+
+		batches.pop_front();
+	}
+}
+
+ResidencyPolicy::Budget TextureResidency::get_budget() const
+{
+	VmaBudget budgets[VK_MAX_MEMORY_HEAPS];
+	vmaGetHeapBudgets(allocated::get_memory_allocator(), budgets);
+
+	auto &heap_budget = budgets[heap_index];
+
+	// The replaced images are destroyed a few frames later, the policy must not drop levels again for their memory
+	uint64_t usage = heap_budget.usage - std::min<uint64_t>(heap_budget.usage, pending_release_size);
+
+	return {heap_budget.budget, usage};
+}
+
+void TextureResidency::record_changes(const std::vector<ResidencyPolicy::Change> &changes)
+{
+	PROFILE_SCOPE("Record texture residency changes");
+
+	static const vkb::Counter level_changes{"Texture level changes"};
+	static const vkb::Counter evicted_bytes{"Texture bytes evicted", PlotType::Memory};
+	static const vkb::Counter restored_bytes{"Texture bytes restored", PlotType::Memory};
+
+	Batch batch;
+
+	// Lay out the dropped levels in the readback buffer and the levels brought back in the staging buffer
+	VkDeviceSize readback_size = 0;
+	VkDeviceSize staging_size  = 0;
+
+	std::vector<std::vector<VkDeviceSize>> staging_offsets(changes.size());
+
+	for (size_t index = 0; index < changes.size(); ++index)
+	{
+		auto &change  = changes[index];
+		auto &managed = managed_images[change.texture];
+
+		if (change.first_level > change.previous_first_level)
+		{
+			Batch::Readback readback{change.texture, change.previous_first_level, change.first_level, {}};
+			for (uint32_t level = change.previous_first_level; level < change.first_level; ++level)
+			{
+				readback_size = align(readback_size, managed.alignment);
+				readback.offsets.push_back(readback_size);
+				readback_size += managed.level_sizes[level];
+			}
+			batch.readbacks.push_back(std::move(readback));
+		}
+		else
+		{
+			for (uint32_t level = change.first_level; level < change.previous_first_level; ++level)
+			{
+				staging_size = align(staging_size, managed.alignment);
+				staging_offsets[index].push_back(staging_size);
+				staging_size += managed.level_sizes[level];
+			}
+		}
+	}
+
+	if (readback_size > 0)
+	{
+		batch.readback_buffer = vkb::core::BufferBuilderC(readback_size)
+		                            .with_vma_flags(VMA_ALLOCATION_CREATE_MAPPED_BIT | VMA_ALLOCATION_CREATE_HOST_ACCESS_RANDOM_BIT)
+		                            .with_usage(VK_BUFFER_USAGE_TRANSFER_DST_BIT)
+		                            .with_memory_category(allocated::MemoryCategory::Staging)
+		                            .with_debug_name("Texture residency readback")
+		                            .build_unique(device);
+	}
+
+	if (staging_size > 0)
+	{
+		batch.staging_buffer = vkb::core::BufferBuilderC(staging_size)
+		                           .with_vma_flags(VMA_ALLOCATION_CREATE_MAPPED_BIT | VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT)
+		                           .with_usage(VK_BUFFER_USAGE_TRANSFER_SRC_BIT)
+		                           .with_memory_category(allocated::MemoryCategory::Staging)
+		                           .with_debug_name("Texture residency staging")
+		                           .build_unique(device);
+
+		uint8_t *data = batch.staging_buffer->map();
+		for (size_t index = 0; index < changes.size(); ++index)
+		{
+			auto &change  = changes[index];
+			auto &managed = managed_images[change.texture];
+
+			for (uint32_t level = change.first_level; level < change.previous_first_level; ++level)
+			{
+				auto &level_data = managed.evicted_levels[level];
+				assert(level_data.size() == managed.level_sizes[level] && "Levels are brought back after their readback completed");
+
+				std::memcpy(data + staging_offsets[index][level - change.first_level], level_data.data(), level_data.size());
+
+				level_data.clear();
+				level_data.shrink_to_fit();
+			}
+		}
+		batch.staging_buffer->flush();
+	}
+
+	if (free_command_buffers.empty())
+	{
+		VkCommandBufferAllocateInfo allocate_info{VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO};
+		allocate_info.commandPool        = command_pool;
+		allocate_info.level              = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+		allocate_info.commandBufferCount = 1;
+		VK_CHECK(vkAllocateCommandBuffers(device.get_handle(), &allocate_info, &batch.command_buffer));
+	}
+	else
+	{
+		batch.command_buffer = free_command_buffers.back();
+		free_command_buffers.pop_back();
+	}
+
+	if (free_fences.empty())
+	{
+		VkFenceCreateInfo fence_info{VK_STRUCTURE_TYPE_FENCE_CREATE_INFO};
+		VK_CHECK(vkCreateFence(device.get_handle(), &fence_info, nullptr, &batch.fence));
+	}
+	else
+	{
+		batch.fence = free_fences.back();
+		free_fences.pop_back();
+	}
+
+	VkCommandBufferBeginInfo begin_info{VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO};
+	begin_info.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+	VK_CHECK(vkBeginCommandBuffer(batch.command_buffer, &begin_info));
+
+	// Copies of the images with their new levels, created before recording so that all barriers are batched
+	std::vector<std::unique_ptr<core::Image>> new_images;
+
+	allocated::MemoryCategoryScope memory_category{allocated::MemoryCategory::Textures};
+
+	std::vector<VkImageMemoryBarrier> barriers;
+	for (auto &change : changes)
+	{
+		auto    &image       = *managed_images[change.texture].image;
+		uint32_t level_count = to_u32(image.get_mipmaps().size());
+
+		auto new_image = std::make_unique<core::Image>(device,
+		                                               get_level_extent(image, change.first_level),
+		                                               image.get_format(),
+		                                               VK_IMAGE_USAGE_SAMPLED_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT,
+		                                               VMA_MEMORY_USAGE_GPU_ONLY,
+		                                               VK_SAMPLE_COUNT_1_BIT,
+		                                               level_count - change.first_level,
+		                                               image.get_layers(),
+		                                               VK_IMAGE_TILING_OPTIMAL,
+		                                               managed_images[change.texture].flags);
+		new_image->set_debug_name(image.get_name());
+
+		barriers.push_back(image_barrier(image.get_vk_image().get_handle(),
+		                                 VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+		                                 0, VK_ACCESS_TRANSFER_READ_BIT,
+		                                 level_count - change.previous_first_level, image.get_layers()));
+		barriers.push_back(image_barrier(new_image->get_handle(),
+		                                 VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+		                                 0, VK_ACCESS_TRANSFER_WRITE_BIT,
+		                                 level_count - change.first_level, image.get_layers()));
+
+		new_images.push_back(std::move(new_image));
+	}
+
+	// Frames submitted before may still sample the images
+	vkCmdPipelineBarrier(batch.command_buffer, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, 0,
+	                     0, nullptr, 0, nullptr, to_u32(barriers.size()), barriers.data());
+	barriers.clear();
+
+	size_t readback_index = 0;
+	for (size_t index = 0; index < changes.size(); ++index)
+	{
+		auto    &change      = changes[index];
+		auto    &managed     = managed_images[change.texture];
+		auto    &image       = *managed.image;
+		uint32_t level_count = to_u32(image.get_mipmaps().size());
+		uint32_t layers      = image.get_layers();
+		VkImage  old_handle  = image.get_vk_image().get_handle();
+		VkImage  new_handle  = new_images[index]->get_handle();
+
+		// Levels kept by both images
+		std::vector<VkImageCopy> image_copies;
+		for (uint32_t level = std::max(change.first_level, change.previous_first_level); level < level_count; ++level)
+		{
+			VkImageCopy copy{};
+			copy.srcSubresource = {VK_IMAGE_ASPECT_COLOR_BIT, level - change.previous_first_level, 0, layers};
+			copy.dstSubresource = {VK_IMAGE_ASPECT_COLOR_BIT, level - change.first_level, 0, layers};
+			copy.extent         = get_level_extent(image, level);
+			image_copies.push_back(copy);
+		}
+		vkCmdCopyImage(batch.command_buffer,
+		               old_handle, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+		               new_handle, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+		               to_u32(image_copies.size()), image_copies.data());
+
+		std::vector<VkBufferImageCopy> buffer_copies;
+		if (change.first_level > change.previous_first_level)
+		{
+			// Dropped levels are read back
+			auto        &readback = batch.readbacks[readback_index++];
+			VkDeviceSize size     = 0;
+			for (uint32_t level = change.previous_first_level; level < change.first_level; ++level)
+			{
+				VkBufferImageCopy copy{};
+				copy.bufferOffset     = readback.offsets[level - change.previous_first_level];
+				copy.imageSubresource = {VK_IMAGE_ASPECT_COLOR_BIT, level - change.previous_first_level, 0, layers};
+				copy.imageExtent      = get_level_extent(image, level);
+				buffer_copies.push_back(copy);
+				size += managed.level_sizes[level];
+			}
+			vkCmdCopyImageToBuffer(batch.command_buffer,
+			                       old_handle, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+			                       batch.readback_buffer->get_handle(),
+			                       to_u32(buffer_copies.size()), buffer_copies.data());
+
+			evicted_bytes.add(static_cast<double>(size));
+		}
+		else
+		{
+			// Levels brought back are uploaded from the staging buffer
+			VkDeviceSize size = 0;
+			for (uint32_t level = change.first_level; level < change.previous_first_level; ++level)
+			{
+				VkBufferImageCopy copy{};
+				copy.bufferOffset     = staging_offsets[index][level - change.first_level];
+				copy.imageSubresource = {VK_IMAGE_ASPECT_COLOR_BIT, level - change.first_level, 0, layers};
+				copy.imageExtent      = get_level_extent(image, level);
+				buffer_copies.push_back(copy);
+				size += managed.level_sizes[level];
+			}
+			vkCmdCopyBufferToImage(batch.command_buffer,
+			                       batch.staging_buffer->get_handle(),
+			                       new_handle, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+			                       to_u32(buffer_copies.size()), buffer_copies.data());
+
+			restored_bytes.add(static_cast<double>(size));
+		}
+
+		barriers.push_back(image_barrier(new_handle,
+		                                 VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+		                                 VK_ACCESS_TRANSFER_WRITE_BIT, VK_ACCESS_SHADER_READ_BIT,
+		                                 level_count - change.first_level, layers));
+
+		level_changes.add();
+	}
+
+	VkMemoryBarrier readback_barrier{VK_STRUCTURE_TYPE_MEMORY_BARRIER};
+	readback_barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+	readback_barrier.dstAccessMask = VK_ACCESS_HOST_READ_BIT;
+
+	// Frames submitted after sample the new images
+	vkCmdPipelineBarrier(batch.command_buffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, 0,
+	                     0, nullptr, 0, nullptr, to_u32(barriers.size()), barriers.data());
+	if (batch.readback_buffer)
+	{
+		vkCmdPipelineBarrier(batch.command_buffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_HOST_BIT, 0,
+		                     1, &readback_barrier, 0, nullptr, 0, nullptr);
+	}
+
+	VK_CHECK(vkEndCommandBuffer(batch.command_buffer));
+
+	// Swap the images only now, the old ones were the copy sources
+	for (size_t index = 0; index < changes.size(); ++index)
+	{
+		auto &change  = changes[index];
+		auto &managed = managed_images[change.texture];
+
+		auto new_view = std::make_unique<core::ImageView>(*new_images[index], managed.view_type);
+		new_view->set_debug_name("View on " + managed.image->get_name());
+
+		managed.image->swap_vk_image(new_images[index], new_view);
+		pending_release_size += new_images[index]->get_image_required_size();
+
+		batch.old_images.push_back(std::move(new_images[index]));
+		batch.old_image_views.push_back(std::move(new_view));
+
+		// Not changed again until the copies and the readback complete
+		policy.set_pinned(change.texture, true);
+		batch.managed_images.push_back(change.texture);
+	}
+
+	VkSubmitInfo submit_info{VK_STRUCTURE_TYPE_SUBMIT_INFO};
+	submit_info.commandBufferCount = 1;
+	submit_info.pCommandBuffers    = &batch.command_buffer;
+	VK_CHECK(device.get_suitable_graphics_queue().submit({submit_info}, batch.fence));
+
+	batches.push_back(std::move(batch));
+}
+}        // namespace sg
+}        // namespace vkb
@@ -0,0 +1,195 @@
+/* Copyright (c) 2025, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <deque>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include "common/vk_common.h"
+#include "core/buffer.h"
+#include "scene_graph/component.h"
+#include "scene_graph/residency_policy.h"
+
+namespace vkb
+{
+class Device;
+class RenderContext;
+
+namespace core
+{
+class Image;
+class ImageView;
+}        // namespace core
+
+namespace sg
+{
+class Image;
+class Scene;
+
+/**
+ * @brief Keeps the textures of a scene under a fraction of the heap budget, by dropping the top mip levels of the
+ *        textures that are not drawn and bringing them back once they are drawn again
+ *
+ * Subpasses report the images they bind with mark_used(), and update() runs once per frame, after the active frame has
+ * been begun and before it is recorded. A ResidencyPolicy picks the levels to drop or bring back from the budget and
+ * usage of the device local heap, as reported by VMA.
+ *
+ * An image whose resident levels change is replaced by a copy holding the new levels, made on the graphics queue
+ * before the frame is submitted. Dropped levels are read back to host memory, and uploaded again when they are brought
+ * back. The replaced image is destroyed once every frame has been begun again, and the descriptor sets cached by the
+ * frames are cleared in between, as they may refer to its view.
+ *
+ * Add it to the scene it manages, which makes the subpasses drawing the scene report to it.
+ */
+class TextureResidency : public Component
+{
+  public:
+	TextureResidency(Device &device, const ResidencyPolicy::Settings &settings = {});
+
+	virtual ~TextureResidency();
+
+	virtual std::type_index get_type() override;
+
+	/**
+	 * @brief Manages the levels of an image, which must have been uploaded to its Vulkan image
+	 * @param image The image, its Vulkan image must be in VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL
+	 * @param view_type The type of the views created on the copies of the image
+	 * @param flags The create flags of the copies of the image
+	 * @return Whether the image is managed, images in a format whose level sizes are unknown are not
+	 */
+	bool add_image(Image &image, VkImageViewType view_type = VK_IMAGE_VIEW_TYPE_2D, VkImageCreateFlags flags = 0);
+
+	/**
+	 * @brief Manages the images of a scene that have a Vulkan image, single layer images with more than one level
+	 */
+	void add_scene(Scene &scene);
+
+	/**
+	 * @brief Records that an image is used by the frame being recorded, can be called from any recording thread
+	 */
+	void mark_used(const Image &image);
+
+	/**
+	 * @brief Completes the changes of previous frames, and records the changes picked for this frame
+	 */
+	void update(RenderContext &render_context);
+
+	ResidencyPolicy &get_policy();
+
+  private:
+	struct ManagedImage
+	{
+		Image *image;
+
+		uint32_t texture;
+
+		VkImageViewType view_type;
+
+		VkImageCreateFlags flags;
+
+		// Size of a level and its alignment in a staging buffer
+		std::vector<VkDeviceSize> level_sizes;
+
+		VkDeviceSize alignment;
+
+		// Dropped levels, by level index, empty for resident levels
+		std::vector<std::vector<uint8_t>> evicted_levels;
+	};
+
+	/**
+	 * @brief The copies of a frame, and the resources they use
+	 */
+	struct Batch
+	{
+		VkCommandBuffer command_buffer{VK_NULL_HANDLE};
+
+		VkFence fence{VK_NULL_HANDLE};
+
+		struct Readback
+		{
+			uint32_t managed_image;
+
+			uint32_t first_level;
+
+			uint32_t end_level;
+
+			std::vector<VkDeviceSize> offsets;
+		};
+
+		std::vector<Readback> readbacks;
+
+		std::unique_ptr<vkb::core::BufferC> readback_buffer;
+
+		std::unique_ptr<vkb::core::BufferC> staging_buffer;
+
+		std::vector<uint32_t> managed_images;
+
+		std::vector<std::unique_ptr<core::Image>> old_images;
+
+		std::vector<std::unique_ptr<core::ImageView>> old_image_views;
+	};
+
+	/**
+	 * @brief An image replaced by a copy, destroyed once no frame can use it
+	 */
+	struct RetiredImage
+	{
+		std::unique_ptr<core::Image> image;
+
+		std::unique_ptr<core::ImageView> image_view;
+
+		uint64_t destroy_frame;
+	};
+
+	void complete_batches(uint64_t frame_count);
+
+	ResidencyPolicy::Budget get_budget() const;
+
+	void record_changes(const std::vector<ResidencyPolicy::Change> &changes);
+
+	Device &device;
+
+	ResidencyPolicy policy;
+
+	std::vector<ManagedImage> managed_images;
+
+	std::unordered_map<const Image *, uint32_t> image_indices;
+
+	std::atomic<uint64_t> frame{0};
+
+	uint32_t heap_index{0};
+
+	VkCommandPool command_pool{VK_NULL_HANDLE};
+
+	std::vector<VkCommandBuffer> free_command_buffers;
+
+	std::vector<VkFence> free_fences;
+
+	// Submitted batches, oldest first
+	std::deque<Batch> batches;
+
+	std::vector<RetiredImage> retired_images;
+
+	// Memory of the images that were replaced but not destroyed yet, which the heap usage does not count for long
+	VkDeviceSize pending_release_size{0};
+};
+}        // namespace sg
+}        // namespace vkb
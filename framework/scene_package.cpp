@@ -0,0 +1,85 @@
+/* Copyright (c) 2025, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "scene_package.h"
+
+#include <stdexcept>
+#include <string>
+
+namespace vkb
+{
+ScenePackage::ScenePackage(const uint8_t *data, size_t size) :
+    data{data},
+    size{size}
+{
+	if (size < sizeof(PackageHeader) || reinterpret_cast<uintptr_t>(data) % alignof(PackageHeader) != 0)
+	{
+		throw std::runtime_error("Scene package is truncated or misaligned");
+	}
+
+	auto &header = get_header();
+	if (header.magic != PACKAGE_MAGIC)
+	{
+		throw std::runtime_error("Not a scene package");
+	}
+	if (header.version != PACKAGE_VERSION)
+	{
+		throw std::runtime_error("Scene package version " + std::to_string(header.version) + " is not supported, expected " +
+		                         std::to_string(PACKAGE_VERSION) + ". Bake the scene again");
+	}
+
+	check_table(header.nodes, sizeof(PackageNode), "nodes");
+	check_table(header.meshes, sizeof(PackageMesh), "meshes");
+	check_table(header.submeshes, sizeof(PackageSubMesh), "submeshes");
+	check_table(header.attributes, sizeof(PackageAttribute), "attributes");
+	check_table(header.materials, sizeof(PackageMaterial), "materials");
+	check_table(header.material_textures, sizeof(PackageMaterialTexture), "material textures");
+	check_table(header.textures, sizeof(PackageTexture), "textures");
+	check_table(header.samplers, sizeof(PackageSampler), "samplers");
+	check_table(header.images, sizeof(PackageImage), "images");
+	check_table(header.cameras, sizeof(PackageCamera), "cameras");
+	check_table(header.lights, sizeof(PackageLight), "lights");
+}
+
+const PackageHeader &ScenePackage::get_header() const
+{
+	return *reinterpret_cast<const PackageHeader *>(data);
+}
+
+std::string_view ScenePackage::get_string(const PackageRange &range) const
+{
+	auto blob = get_blob(range);
+	return {reinterpret_cast<const char *>(blob.data()), blob.size()};
+}
+
+std::span<const uint8_t> ScenePackage::get_blob(const PackageRange &range) const
+{
+	if (range.offset > size || range.size > size - range.offset)
+	{
+		throw std::runtime_error("Scene package range is out of bounds");
+	}
+	return {data + range.offset, static_cast<size_t>(range.size)};
+}
+
+void ScenePackage::check_table(const PackageTable &table, size_t element_size, const char *table_name) const
+{
+	if (table.offset % PACKAGE_ALIGNMENT != 0 || table.offset > size || table.count > (size - table.offset) / element_size)
+	{
+		throw std::runtime_error(std::string("Scene package table of ") + table_name + " is out of bounds");
+	}
+}
+}        // namespace vkb
@@ -0,0 +1,312 @@
+/* Copyright (c) 2025, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <span>
+#include <string_view>
+#include <type_traits>
+
+namespace vkb
+{
+/**
+ * @brief Layout of a baked scene package, see ScenePackageBaker and ScenePackageLoader
+ *
+ * A package is a header followed by flat tables of plain structs, a string pool and the blobs holding
+ * vertex, index and KTX2 texture data. Tables reference each other by index and strings or blobs
+ * by absolute byte range, so the file can be used in place after a single read or mapping.
+ * Tables and blobs start at PACKAGE_ALIGNMENT. All values are little-endian.
+ */
+constexpr uint32_t PACKAGE_MAGIC = 0x504b4256;        // "VBKP"
+
+/// Increase whenever the layout of any struct below changes, packages of other versions are rejected
+constexpr uint32_t PACKAGE_VERSION = 1;
+
+constexpr uint64_t PACKAGE_ALIGNMENT = 16;
+
+constexpr int32_t PACKAGE_INVALID_INDEX = -1;
+
+/**
+ * @brief Byte range within the package
+ */
+struct PackageRange
+{
+	uint64_t offset;
+
+	uint64_t size;
+};
+
+/**
+ * @brief Element range of a table within the package
+ */
+struct PackageTable
+{
+	uint64_t offset;
+
+	uint64_t count;
+};
+
+struct PackageHeader
+{
+	uint32_t magic;
+
+	uint32_t version;
+
+	/// Name of the glTF scene the package was baked from
+	PackageRange name;
+
+	PackageTable nodes;
+
+	PackageTable meshes;
+
+	PackageTable submeshes;
+
+	PackageTable attributes;
+
+	PackageTable materials;
+
+	PackageTable material_textures;
+
+	PackageTable textures;
+
+	PackageTable samplers;
+
+	PackageTable images;
+
+	PackageTable cameras;
+
+	PackageTable lights;
+};
+
+/**
+ * @brief Scene node, parents are stored before their children
+ */
+struct PackageNode
+{
+	PackageRange name;
+
+	/// Index of the parent node, PACKAGE_INVALID_INDEX for children of the scene root
+	int32_t parent;
+
+	int32_t mesh;
+
+	int32_t camera;
+
+	int32_t light;
+
+	float translation[3];
+
+	/// Quaternion as x, y, z, w
+	float rotation[4];
+
+	float scale[3];
+
+	uint32_t padding;
+};
+
+struct PackageMesh
+{
+	PackageRange name;
+
+	uint32_t first_submesh;
+
+	uint32_t submesh_count;
+};
+
+struct PackageSubMesh
+{
+	PackageRange name;
+
+	uint32_t first_attribute;
+
+	uint32_t attribute_count;
+
+	/// PACKAGE_INVALID_INDEX selects the default material
+	int32_t material;
+
+	uint32_t vertex_count;
+
+	/// 0 for non-indexed submeshes
+	uint32_t index_count;
+
+	/// VkIndexType
+	uint32_t index_type;
+
+	PackageRange indices;
+};
+
+/**
+ * @brief Vertex buffer of a submesh, tightly packed in the format the shaders read
+ */
+struct PackageAttribute
+{
+	/// Lower case glTF attribute name, as used for sg::SubMesh::vertex_buffers
+	PackageRange name;
+
+	/// VkFormat
+	uint32_t format;
+
+	uint32_t stride;
+
+	PackageRange data;
+};
+
+struct PackageMaterial
+{
+	PackageRange name;
+
+	float base_color_factor[4];
+
+	float emissive[3];
+
+	float metallic_factor;
+
+	float roughness_factor;
+
+	float alpha_cutoff;
+
+	/// sg::AlphaMode
+	uint32_t alpha_mode;
+
+	uint32_t double_sided;
+
+	uint32_t first_texture;
+
+	uint32_t texture_count;
+};
+
+/**
+ * @brief Binding of a texture to a material, keyed by the snake case glTF name such as base_color_texture
+ */
+struct PackageMaterialTexture
+{
+	PackageRange name;
+
+	uint32_t texture;
+
+	uint32_t padding;
+};
+
+struct PackageTexture
+{
+	PackageRange name;
+
+	uint32_t image;
+
+	/// PACKAGE_INVALID_INDEX selects the default sampler
+	int32_t sampler;
+};
+
+struct PackageSampler
+{
+	PackageRange name;
+
+	/// VkFilter
+	uint32_t mag_filter;
+
+	/// VkFilter
+	uint32_t min_filter;
+
+	/// VkSamplerMipmapMode
+	uint32_t mipmap_mode;
+
+	/// VkSamplerAddressMode
+	uint32_t address_mode_u;
+
+	/// VkSamplerAddressMode
+	uint32_t address_mode_v;
+
+	uint32_t padding;
+};
+
+/**
+ * @brief Texture image stored as a KTX2 file with its full mip chain, already in its final (sRGB or linear) format
+ */
+struct PackageImage
+{
+	PackageRange name;
+
+	PackageRange ktx2;
+};
+
+struct PackageCamera
+{
+	PackageRange name;
+
+	float aspect_ratio;
+
+	float field_of_view;
+
+	float near_plane;
+
+	float far_plane;
+};
+
+struct PackageLight
+{
+	PackageRange name;
+
+	/// sg::LightType
+	uint32_t type;
+
+	float color[3];
+
+	float intensity;
+
+	float range;
+
+	float inner_cone_angle;
+
+	float outer_cone_angle;
+};
+
+/**
+ * @brief Read-only view of a scene package held in memory
+ *
+ * The constructor validates the header and that every table lies within the data. String and blob
+ * ranges are checked when they are accessed. The data must outlive the view.
+ */
+class ScenePackage
+{
+  public:
+	/**
+	 * @throws std::runtime_error if the data is not a package of PACKAGE_VERSION
+	 */
+	ScenePackage(const uint8_t *data, size_t size);
+
+	const PackageHeader &get_header() const;
+
+	std::string_view get_string(const PackageRange &range) const;
+
+	std::span<const uint8_t> get_blob(const PackageRange &range) const;
+
+	template <typename T>
+	std::span<const T> get_table(const PackageTable &table) const
+	{
+		static_assert(std::is_trivially_copyable_v<T>, "Package tables hold plain structs");
+		return {reinterpret_cast<const T *>(data + table.offset), static_cast<size_t>(table.count)};
+	}
+
+  private:
+	void check_table(const PackageTable &table, size_t element_size, const char *table_name) const;
+
+	const uint8_t *data;
+
+	size_t size;
+};
+}        // namespace vkb
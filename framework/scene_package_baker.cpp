@@ -0,0 +1,770 @@
+/* Copyright (c) 2025, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "scene_package_baker.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <numeric>
+#include <queue>
+#include <thread>
+
+#include "common/glm_common.h"
+#include <glm/gtc/type_ptr.hpp>
+#include <glm/gtx/matrix_decompose.hpp>
+
+#include <ctpl_stl.h>
+#include <dfdutils/dfd.h>
+
+#include "common/strings.h"
+#include "common/utils.h"
+#include "core/util/logging.hpp"
+#include "scene_graph/components/image.h"
+#include "scene_graph/components/light.h"
+#include "scene_graph/components/pbr_material.h"
+
+namespace vkb
+{
+namespace
+{
+uint64_t align_up(uint64_t value, uint64_t alignment)
+{
+	return (value + alignment - 1) / alignment * alignment;
+}
+
+/**
+ * @brief Appends the strings, blobs and tables of a package behind its header
+ */
+class PackageWriter
+{
+  public:
+	PackageWriter() :
+	    data(align_up(sizeof(PackageHeader), PACKAGE_ALIGNMENT))
+	{
+	}
+
+	PackageRange add_string(const std::string &string)
+	{
+		PackageRange range{data.size(), string.size()};
+		data.insert(data.end(), string.begin(), string.end());
+		return range;
+	}
+
+	PackageRange add_blob(const uint8_t *blob, size_t size)
+	{
+		data.resize(align_up(data.size(), PACKAGE_ALIGNMENT));
+
+		PackageRange range{data.size(), size};
+		data.insert(data.end(), blob, blob + size);
+		return range;
+	}
+
+	PackageRange add_blob(const std::vector<uint8_t> &blob)
+	{
+		return add_blob(blob.data(), blob.size());
+	}
+
+	template <typename T>
+	PackageTable add_table(const std::vector<T> &table)
+	{
+		auto range = add_blob(reinterpret_cast<const uint8_t *>(table.data()), table.size() * sizeof(T));
+		return {range.offset, table.size()};
+	}
+
+	std::vector<uint8_t> finish(const PackageHeader &header)
+	{
+		std::memcpy(data.data(), &header, sizeof(header));
+		return std::move(data);
+	}
+
+  private:
+	std::vector<uint8_t> data;
+};
+
+/**
+ * @brief Attributes and indices of a primitive, laid out as they are uploaded
+ */
+struct BakedPrimitive
+{
+	std::vector<std::string> attribute_names;
+
+	std::vector<VkFormat> attribute_formats;
+
+	std::vector<VertexStream> streams;
+
+	std::vector<uint8_t> indices;
+
+	uint32_t vertex_count = 0;
+
+	uint32_t index_count = 0;
+
+	VkIndexType index_type = VK_INDEX_TYPE_UINT16;
+};
+
+/**
+ * @brief Copies the elements of an accessor without the padding of interleaved buffer views
+ */
+VertexStream read_packed_stream(const tinygltf::Model &model, int accessor_index)
+{
+	if (accessor_index < 0 || accessor_index >= static_cast<int>(model.accessors.size()))
+	{
+		throw std::runtime_error("glTF accessor #" + std::to_string(accessor_index) + " does not exist");
+	}
+
+	auto  &accessor     = model.accessors[accessor_index];
+	size_t element_size = tinygltf::GetComponentSizeInBytes(accessor.componentType) * tinygltf::GetNumComponentsInType(accessor.type);
+
+	VertexStream stream{std::vector<uint8_t>(accessor.count * element_size), element_size};
+
+	// Accessors without a buffer view are initialized with zeros
+	if (accessor.bufferView < 0)
+	{
+		return stream;
+	}
+
+	auto  &buffer_view = model.bufferViews[accessor.bufferView];
+	auto  &buffer      = model.buffers[buffer_view.buffer];
+	size_t stride      = accessor.ByteStride(buffer_view);
+	size_t start       = buffer_view.byteOffset + accessor.byteOffset;
+
+	if (accessor.count > 0 && start + (accessor.count - 1) * stride + element_size > buffer.data.size())
+	{
+		throw std::runtime_error("glTF accessor #" + std::to_string(accessor_index) + " is out of the bounds of its buffer");
+	}
+
+	for (size_t i = 0; i < accessor.count; ++i)
+	{
+		std::memcpy(stream.data.data() + i * element_size, buffer.data.data() + start + i * stride, element_size);
+	}
+
+	return stream;
+}
+
+BakedPrimitive bake_primitive(const tinygltf::Model &model, const tinygltf::Primitive &primitive, const ScenePackageBakeOptions &options)
+{
+	BakedPrimitive baked;
+
+	for (auto &attribute : primitive.attributes)
+	{
+		std::string attrib_name = attribute.first;
+		std::transform(attrib_name.begin(), attrib_name.end(), attrib_name.begin(), ::tolower);
+
+		baked.attribute_names.push_back(attrib_name);
+		baked.attribute_formats.push_back(get_accessor_format(model, attribute.second));
+		baked.streams.push_back(read_packed_stream(model, attribute.second));
+	}
+
+	auto position_it = std::ranges::find(baked.attribute_names, "position");
+	if (position_it == baked.attribute_names.end())
+	{
+		throw std::runtime_error("glTF primitive has no positions");
+	}
+	size_t position_stream = std::distance(baked.attribute_names.begin(), position_it);
+
+	baked.vertex_count = to_u32(model.accessors[primitive.attributes.at("POSITION")].count);
+
+	if (primitive.indices < 0)
+	{
+		return baked;
+	}
+
+	auto index_stream = read_packed_stream(model, primitive.indices);
+
+	std::vector<uint32_t> indices(index_stream.data.size() / index_stream.stride);
+	for (size_t i = 0; i < indices.size(); ++i)
+	{
+		const uint8_t *index = index_stream.data.data() + i * index_stream.stride;
+		switch (index_stream.stride)
+		{
+			case sizeof(uint8_t):
+				indices[i] = *index;
+				break;
+			case sizeof(uint16_t):
+				indices[i] = *reinterpret_cast<const uint16_t *>(index);
+				break;
+			case sizeof(uint32_t):
+				indices[i] = *reinterpret_cast<const uint32_t *>(index);
+				break;
+			default:
+				throw std::runtime_error("glTF primitive has invalid index type");
+		}
+	}
+
+	bool is_triangle_list = (primitive.mode == -1 || primitive.mode == TINYGLTF_MODE_TRIANGLES) && primitive.targets.empty() && indices.size() % 3 == 0;
+	if (options.optimize_meshes && is_triangle_list && baked.attribute_formats[position_stream] == VK_FORMAT_R32G32B32_SFLOAT)
+	{
+		MeshOptimizerOptions mesh_optimizer_options = options.mesh_optimizer_options;
+		mesh_optimizer_options.position_stream      = position_stream;
+
+		optimize_mesh(indices, baked.streams, mesh_optimizer_options);
+
+		auto &positions    = baked.streams[position_stream];
+		baked.vertex_count = to_u32(positions.data.size() / positions.stride);
+	}
+
+	baked.index_count = to_u32(indices.size());
+
+	uint32_t max_index = indices.empty() ? 0 : *std::ranges::max_element(indices);
+	if (max_index <= std::numeric_limits<uint16_t>::max())
+	{
+		std::vector<uint16_t> narrow_indices(indices.begin(), indices.end());
+		baked.indices.assign(reinterpret_cast<const uint8_t *>(narrow_indices.data()), reinterpret_cast<const uint8_t *>(narrow_indices.data() + narrow_indices.size()));
+		baked.index_type = VK_INDEX_TYPE_UINT16;
+	}
+	else
+	{
+		baked.indices.assign(reinterpret_cast<const uint8_t *>(indices.data()), reinterpret_cast<const uint8_t *>(indices.data() + indices.size()));
+		baked.index_type = VK_INDEX_TYPE_UINT32;
+	}
+
+	return baked;
+}
+
+std::vector<uint8_t> bake_image(const tinygltf::Image &gltf_image, const std::string &model_path, bool is_color, const ScenePackageBakeOptions &options)
+{
+	std::unique_ptr<sg::Image> image;
+
+	if (!gltf_image.image.empty())
+	{
+		// Image embedded in gltf file
+		auto mipmap = sg::Mipmap{
+		    /* .level = */ 0,
+		    /* .offset = */ 0,
+		    /* .extent = */ {/* .width = */ static_cast<uint32_t>(gltf_image.width),
+		                     /* .height = */ static_cast<uint32_t>(gltf_image.height),
+		                     /* .depth = */ 1u}};
+		std::vector<uint8_t>    data{gltf_image.image};
+		std::vector<sg::Mipmap> mipmaps{mipmap};
+		image = std::make_unique<sg::Image>(gltf_image.name, std::move(data), std::move(mipmaps));
+	}
+	else
+	{
+		image = sg::Image::load(gltf_image.name, model_path + "/" + gltf_image.uri, sg::Image::Unknown);
+		if (!image)
+		{
+			throw std::runtime_error("Image format of '" + gltf_image.uri + "' is not supported");
+		}
+	}
+
+	// Store the format the GLTFLoader would end up with after loading the materials
+	if (is_color)
+	{
+		image->coerce_format_to_srgb();
+	}
+
+	auto &extent      = image->get_extent();
+	bool  is_rgba8    = image->get_format() == VK_FORMAT_R8G8B8A8_UNORM || image->get_format() == VK_FORMAT_R8G8B8A8_SRGB;
+	bool  is_mippable = image->get_mipmaps().size() == 1 && (extent.width > 1 || extent.height > 1);
+	if (options.generate_mipmaps && is_rgba8 && is_mippable)
+	{
+		image->generate_mipmaps();
+	}
+
+	return write_ktx2(*image);
+}
+
+PackageSampler bake_sampler(const tinygltf::Sampler &gltf_sampler, PackageWriter &writer)
+{
+	VkSamplerCreateInfo sampler_info = get_sampler_create_info(gltf_sampler);
+
+	PackageSampler sampler{};
+	sampler.name           = writer.add_string(gltf_sampler.name);
+	sampler.mag_filter     = sampler_info.magFilter;
+	sampler.min_filter     = sampler_info.minFilter;
+	sampler.mipmap_mode    = sampler_info.mipmapMode;
+	sampler.address_mode_u = sampler_info.addressModeU;
+	sampler.address_mode_v = sampler_info.addressModeV;
+	return sampler;
+}
+
+PackageMaterial bake_material(const tinygltf::Material &gltf_material, size_t texture_count, PackageWriter &writer, std::vector<PackageMaterialTexture> &material_textures)
+{
+	sg::PBRMaterial pbr_material{gltf_material.name};
+	read_material_factors(gltf_material, pbr_material);
+
+	PackageMaterial material{};
+	material.name = writer.add_string(gltf_material.name);
+	std::memcpy(material.base_color_factor, glm::value_ptr(pbr_material.base_color_factor), sizeof(material.base_color_factor));
+	std::memcpy(material.emissive, glm::value_ptr(pbr_material.emissive), sizeof(material.emissive));
+	material.metallic_factor  = pbr_material.metallic_factor;
+	material.roughness_factor = pbr_material.roughness_factor;
+	material.alpha_cutoff     = pbr_material.alpha_cutoff;
+	material.alpha_mode       = static_cast<uint32_t>(pbr_material.alpha_mode);
+	material.double_sided     = pbr_material.double_sided;
+	material.first_texture    = to_u32(material_textures.size());
+
+	auto add_textures = [&](const tinygltf::ParameterMap &values) {
+		for (auto &gltf_value : values)
+		{
+			if (gltf_value.first.find("Texture") == std::string::npos)
+			{
+				continue;
+			}
+
+			int texture_index = gltf_value.second.TextureIndex();
+			if (texture_index < 0 || static_cast<size_t>(texture_index) >= texture_count)
+			{
+				throw std::runtime_error("glTF material '" + gltf_material.name + "' references missing texture #" + std::to_string(texture_index));
+			}
+
+			PackageMaterialTexture material_texture{};
+			material_texture.name    = writer.add_string(to_snake_case(gltf_value.first));
+			material_texture.texture = to_u32(texture_index);
+			material_textures.push_back(material_texture);
+		}
+	};
+	add_textures(gltf_material.values);
+	add_textures(gltf_material.additionalValues);
+
+	material.texture_count = to_u32(material_textures.size()) - material.first_texture;
+
+	return material;
+}
+
+void bake_node_transform(const tinygltf::Node &gltf_node, PackageNode &node)
+{
+	glm::vec3 translation{0.0f};
+	glm::quat rotation{1.0f, 0.0f, 0.0f, 0.0f};
+	glm::vec3 scale{1.0f};
+
+	if (!gltf_node.translation.empty())
+	{
+		std::transform(gltf_node.translation.begin(), gltf_node.translation.end(), glm::value_ptr(translation), TypeCast<double, float>{});
+	}
+
+	if (!gltf_node.rotation.empty())
+	{
+		std::transform(gltf_node.rotation.begin(), gltf_node.rotation.end(), glm::value_ptr(rotation), TypeCast<double, float>{});
+	}
+
+	if (!gltf_node.scale.empty())
+	{
+		std::transform(gltf_node.scale.begin(), gltf_node.scale.end(), glm::value_ptr(scale), TypeCast<double, float>{});
+	}
+
+	if (!gltf_node.matrix.empty())
+	{
+		glm::mat4 matrix;
+
+		std::transform(gltf_node.matrix.begin(), gltf_node.matrix.end(), glm::value_ptr(matrix), TypeCast<double, float>{});
+
+		glm::vec3 skew;
+		glm::vec4 perspective;
+		glm::decompose(matrix, scale, rotation, translation, skew, perspective);
+	}
+
+	std::memcpy(node.translation, glm::value_ptr(translation), sizeof(node.translation));
+	node.rotation[0] = rotation.x;
+	node.rotation[1] = rotation.y;
+	node.rotation[2] = rotation.z;
+	node.rotation[3] = rotation.w;
+	std::memcpy(node.scale, glm::value_ptr(scale), sizeof(node.scale));
+}
+
+/**
+ * @brief Level index entry of a KTX2 file
+ */
+struct Ktx2Level
+{
+	uint64_t byte_offset;
+
+	uint64_t byte_length;
+
+	uint64_t uncompressed_byte_length;
+};
+
+/**
+ * @brief Identifier, header and index of a KTX2 file
+ */
+struct Ktx2Header
+{
+	uint8_t identifier[12];
+
+	uint32_t vk_format;
+
+	uint32_t type_size;
+
+	uint32_t pixel_width;
+
+	uint32_t pixel_height;
+
+	uint32_t pixel_depth;
+
+	uint32_t layer_count;
+
+	uint32_t face_count;
+
+	uint32_t level_count;
+
+	uint32_t supercompression_scheme;
+
+	uint32_t dfd_byte_offset;
+
+	uint32_t dfd_byte_length;
+
+	uint32_t kvd_byte_offset;
+
+	uint32_t kvd_byte_length;
+
+	uint64_t sgd_byte_offset;
+
+	uint64_t sgd_byte_length;
+};
+
+static_assert(sizeof(Ktx2Header) == 80, "KTX2 level index starts at byte 80");
+}        // namespace
+
+std::vector<uint8_t> write_ktx2(const sg::Image &image)
+{
+	auto &extent  = image.get_extent();
+	auto &mipmaps = image.get_mipmaps();
+	auto &data    = image.get_data();
+
+	if (image.get_layers() != 1 || extent.depth > 1)
+	{
+		throw std::runtime_error("Only 2D images can be stored as KTX2: " + image.get_name());
+	}
+
+	// The data format descriptor is allocated with malloc
+	std::unique_ptr<uint32_t, decltype(&std::free)> dfd{vk2dfd(image.get_format()), &std::free};
+	if (!dfd)
+	{
+		throw std::runtime_error("KTX2 can not describe the format " + to_string(image.get_format()) + " of " + image.get_name());
+	}
+
+	// The first word of the descriptor is its size, the basic descriptor block follows
+	const uint32_t *bdb          = dfd.get() + 1;
+	uint32_t        block_width  = KHR_DFDVAL(bdb, TEXELBLOCKDIMENSION0) + 1;
+	uint32_t        block_height = KHR_DFDVAL(bdb, TEXELBLOCKDIMENSION1) + 1;
+	uint32_t        block_size   = KHR_DFDVAL(bdb, BYTESPLANE0);
+	uint32_t        bit_length   = KHR_DFDSVAL(bdb, 0, BITLENGTH) + 1;
+
+	// typeSize is 1 for block compressed formats, and the size of a component or of a whole packed texel otherwise
+	bool     is_block_compressed = block_width > 1 || block_height > 1;
+	uint32_t type_size           = is_block_compressed ? 1 : (bit_length % 8 == 0 ? bit_length / 8 : block_size);
+
+	// Levels start at the least common multiple of the block size and 4, which libktx relies on to read them in one go
+	uint64_t level_alignment = std::lcm<uint64_t>(block_size, 4);
+
+	Ktx2Header header{{0xAB, 'K', 'T', 'X', ' ', '2', '0', 0xBB, '\r', '\n', 0x1A, '\n'}};
+	header.vk_format       = image.get_format();
+	header.type_size       = type_size;
+	header.pixel_width     = extent.width;
+	header.pixel_height    = extent.height;
+	header.face_count      = 1;
+	header.level_count     = to_u32(mipmaps.size());
+	header.dfd_byte_offset = to_u32(sizeof(Ktx2Header) + sizeof(Ktx2Level) * mipmaps.size());
+	header.dfd_byte_length = dfd.get()[0];
+
+	std::vector<Ktx2Level> levels(mipmaps.size());
+
+	// Levels are stored from the smallest to the largest
+	uint64_t offset = header.dfd_byte_offset + header.dfd_byte_length;
+	for (size_t i = mipmaps.size(); i-- > 0;)
+	{
+		auto &mipmap = mipmaps[i];
+		if (mipmap.level != i)
+		{
+			throw std::runtime_error("Mip levels of " + image.get_name() + " are out of order");
+		}
+
+		uint64_t blocks_x = (mipmap.extent.width + block_width - 1) / block_width;
+		uint64_t blocks_y = (mipmap.extent.height + block_height - 1) / block_height;
+		uint64_t size     = blocks_x * blocks_y * block_size;
+		if (mipmap.offset + size > data.size())
+		{
+			throw std::runtime_error("Mip level " + std::to_string(i) + " of " + image.get_name() + " is truncated");
+		}
+
+		offset                             = align_up(offset, level_alignment);
+		levels[i].byte_offset              = offset;
+		levels[i].byte_length              = size;
+		levels[i].uncompressed_byte_length = size;
+		offset += size;
+	}
+
+	std::vector<uint8_t> file(offset);
+	std::memcpy(file.data(), &header, sizeof(header));
+	std::memcpy(file.data() + sizeof(header), levels.data(), sizeof(Ktx2Level) * levels.size());
+	std::memcpy(file.data() + header.dfd_byte_offset, dfd.get(), header.dfd_byte_length);
+	for (size_t i = 0; i < mipmaps.size(); ++i)
+	{
+		std::memcpy(file.data() + levels[i].byte_offset, data.data() + mipmaps[i].offset, levels[i].byte_length);
+	}
+
+	return file;
+}
+
+std::vector<uint8_t> bake_scene_package(const tinygltf::Model &model, const std::string &model_path, int scene_index, const ScenePackageBakeOptions &options)
+{
+	const tinygltf::Scene *gltf_scene{nullptr};
+
+	if (scene_index >= 0 && scene_index < static_cast<int>(model.scenes.size()))
+	{
+		gltf_scene = &model.scenes[scene_index];
+	}
+	else if (model.defaultScene >= 0 && model.defaultScene < static_cast<int>(model.scenes.size()))
+	{
+		gltf_scene = &model.scenes[model.defaultScene];
+	}
+	else if (model.scenes.size() > 0)
+	{
+		gltf_scene = &model.scenes[0];
+	}
+
+	if (!gltf_scene)
+	{
+		throw std::runtime_error("Couldn't determine which scene to bake!");
+	}
+
+	// Images used as base color or emissive textures are stored as sRGB
+	std::vector<bool> is_color_image(model.images.size(), false);
+	for (auto &gltf_material : model.materials)
+	{
+		for (auto *values : {&gltf_material.values, &gltf_material.additionalValues})
+		{
+			for (auto &gltf_value : *values)
+			{
+				int texture_index = gltf_value.second.TextureIndex();
+				if (gltf_value.first.find("Texture") != std::string::npos && texture_index >= 0 && texture_index < static_cast<int>(model.textures.size()) &&
+				    texture_needs_srgb_colorspace(gltf_value.first))
+				{
+					int source = model.textures[texture_index].source;
+					if (source >= 0 && source < static_cast<int>(model.images.size()))
+					{
+						is_color_image[source] = true;
+					}
+				}
+			}
+		}
+	}
+
+	auto thread_count = options.thread_count > 0 ? options.thread_count : std::thread::hardware_concurrency();
+	thread_count      = thread_count == 0 ? 1 : thread_count;
+	ctpl::thread_pool thread_pool(static_cast<int>(thread_count));
+
+	std::vector<std::future<std::vector<uint8_t>>> image_futures;
+	for (size_t image_index = 0; image_index < model.images.size(); ++image_index)
+	{
+		image_futures.push_back(thread_pool.push(
+		    [&, image_index](size_t) {
+			    return bake_image(model.images[image_index], model_path, is_color_image[image_index], options);
+		    }));
+	}
+
+	std::vector<std::vector<std::future<BakedPrimitive>>> primitive_futures(model.meshes.size());
+	for (size_t mesh_index = 0; mesh_index < model.meshes.size(); ++mesh_index)
+	{
+		for (auto &gltf_primitive : model.meshes[mesh_index].primitives)
+		{
+			primitive_futures[mesh_index].push_back(thread_pool.push(
+			    [&](size_t) {
+				    return bake_primitive(model, gltf_primitive, options);
+			    }));
+		}
+	}
+
+	PackageWriter writer;
+	PackageHeader header{};
+	header.magic   = PACKAGE_MAGIC;
+	header.version = PACKAGE_VERSION;
+	header.name    = writer.add_string(gltf_scene->name);
+
+	// Images, in the order of the glTF images
+	std::vector<PackageImage> images;
+	for (size_t image_index = 0; image_index < model.images.size(); ++image_index)
+	{
+		PackageImage image{};
+		image.name = writer.add_string(model.images[image_index].name);
+		image.ktx2 = writer.add_blob(image_futures[image_index].get());
+		images.push_back(image);
+	}
+
+	std::vector<PackageSampler> samplers;
+	for (auto &gltf_sampler : model.samplers)
+	{
+		samplers.push_back(bake_sampler(gltf_sampler, writer));
+	}
+
+	std::vector<PackageTexture> textures;
+	for (auto &gltf_texture : model.textures)
+	{
+		if (gltf_texture.source < 0 || gltf_texture.source >= static_cast<int>(images.size()))
+		{
+			throw std::runtime_error("glTF texture '" + gltf_texture.name + "' has no image");
+		}
+
+		PackageTexture texture{};
+		texture.name    = writer.add_string(gltf_texture.name);
+		texture.image   = to_u32(gltf_texture.source);
+		texture.sampler = gltf_texture.sampler >= 0 && gltf_texture.sampler < static_cast<int>(samplers.size()) ? gltf_texture.sampler : PACKAGE_INVALID_INDEX;
+		textures.push_back(texture);
+	}
+
+	std::vector<PackageMaterial>        materials;
+	std::vector<PackageMaterialTexture> material_textures;
+	for (auto &gltf_material : model.materials)
+	{
+		materials.push_back(bake_material(gltf_material, textures.size(), writer, material_textures));
+	}
+
+	std::vector<PackageMesh>      meshes;
+	std::vector<PackageSubMesh>   submeshes;
+	std::vector<PackageAttribute> attributes;
+	for (size_t mesh_index = 0; mesh_index < model.meshes.size(); ++mesh_index)
+	{
+		auto &gltf_mesh = model.meshes[mesh_index];
+
+		PackageMesh mesh{};
+		mesh.name          = writer.add_string(gltf_mesh.name);
+		mesh.first_submesh = to_u32(submeshes.size());
+		mesh.submesh_count = to_u32(gltf_mesh.primitives.size());
+		meshes.push_back(mesh);
+
+		for (size_t i_primitive = 0; i_primitive < gltf_mesh.primitives.size(); ++i_primitive)
+		{
+			auto &gltf_primitive = gltf_mesh.primitives[i_primitive];
+			auto  baked          = primitive_futures[mesh_index][i_primitive].get();
+
+			PackageSubMesh submesh{};
+			submesh.name            = writer.add_string(fmt::format("'{}' mesh, primitive #{}", gltf_mesh.name, i_primitive));
+			submesh.first_attribute = to_u32(attributes.size());
+			submesh.attribute_count = to_u32(baked.streams.size());
+			submesh.material        = gltf_primitive.material < static_cast<int>(materials.size()) ? gltf_primitive.material : PACKAGE_INVALID_INDEX;
+			submesh.vertex_count    = baked.vertex_count;
+			submesh.index_count     = baked.index_count;
+			submesh.index_type      = baked.index_type;
+			submesh.indices         = writer.add_blob(baked.indices);
+
+			for (size_t attribute_index = 0; attribute_index < baked.streams.size(); ++attribute_index)
+			{
+				PackageAttribute attribute{};
+				attribute.name   = writer.add_string(baked.attribute_names[attribute_index]);
+				attribute.format = baked.attribute_formats[attribute_index];
+				attribute.stride = to_u32(baked.streams[attribute_index].stride);
+				attribute.data   = writer.add_blob(baked.streams[attribute_index].data);
+				attributes.push_back(attribute);
+			}
+
+			submeshes.push_back(submesh);
+		}
+	}
+
+	// Only perspective cameras are supported, like in the GLTFLoader
+	std::vector<PackageCamera> cameras;
+	std::vector<int32_t>       camera_indices(model.cameras.size(), PACKAGE_INVALID_INDEX);
+	for (size_t camera_index = 0; camera_index < model.cameras.size(); ++camera_index)
+	{
+		auto &gltf_camera = model.cameras[camera_index];
+		if (gltf_camera.type != "perspective")
+		{
+			LOGW("Camera type not supported");
+			continue;
+		}
+
+		PackageCamera camera{};
+		camera.name          = writer.add_string(gltf_camera.name);
+		camera.aspect_ratio  = static_cast<float>(gltf_camera.perspective.aspectRatio);
+		camera.field_of_view = static_cast<float>(gltf_camera.perspective.yfov);
+		camera.near_plane    = static_cast<float>(gltf_camera.perspective.znear);
+		camera.far_plane     = static_cast<float>(gltf_camera.perspective.zfar);
+
+		camera_indices[camera_index] = static_cast<int32_t>(cameras.size());
+		cameras.push_back(camera);
+	}
+
+	std::vector<PackageLight> lights;
+	for (auto &light_component : read_khr_lights_punctual(model))
+	{
+		auto &properties = light_component->get_properties();
+
+		PackageLight light{};
+		light.name = writer.add_string(light_component->get_name());
+		light.type = light_component->get_light_type();
+		std::memcpy(light.color, glm::value_ptr(properties.color), sizeof(light.color));
+		light.intensity        = properties.intensity;
+		light.range            = properties.range;
+		light.inner_cone_angle = properties.inner_cone_angle;
+		light.outer_cone_angle = properties.outer_cone_angle;
+		lights.push_back(light);
+	}
+
+	// Flatten the node hierarchy breadth first, so that parents are stored before their children
+	std::vector<PackageNode>            nodes;
+	std::queue<std::pair<int32_t, int>> traverse_nodes;
+	std::vector<bool>                   visited(model.nodes.size(), false);
+
+	for (auto node_index : gltf_scene->nodes)
+	{
+		traverse_nodes.push({PACKAGE_INVALID_INDEX, node_index});
+	}
+
+	while (!traverse_nodes.empty())
+	{
+		auto [parent, node_index] = traverse_nodes.front();
+		traverse_nodes.pop();
+
+		if (node_index < 0 || node_index >= static_cast<int>(model.nodes.size()) || visited[node_index])
+		{
+			continue;
+		}
+		visited[node_index] = true;
+
+		auto &gltf_node = model.nodes[node_index];
+
+		PackageNode node{};
+		node.name   = writer.add_string(gltf_node.name);
+		node.parent = parent;
+		node.mesh   = gltf_node.mesh >= 0 && gltf_node.mesh < static_cast<int>(meshes.size()) ? gltf_node.mesh : PACKAGE_INVALID_INDEX;
+		node.camera = gltf_node.camera >= 0 && gltf_node.camera < static_cast<int>(camera_indices.size()) ? camera_indices[gltf_node.camera] : PACKAGE_INVALID_INDEX;
+		node.light  = PACKAGE_INVALID_INDEX;
+
+		auto extension = gltf_node.extensions.find(KHR_LIGHTS_PUNCTUAL_EXTENSION);
+		if (extension != gltf_node.extensions.end() && extension->second.Has("light"))
+		{
+			int light_index = extension->second.Get("light").Get<int>();
+			node.light      = light_index >= 0 && light_index < static_cast<int>(lights.size()) ? light_index : PACKAGE_INVALID_INDEX;
+		}
+
+		bake_node_transform(gltf_node, node);
+
+		int32_t package_index = static_cast<int32_t>(nodes.size());
+		nodes.push_back(node);
+
+		for (auto child_node_index : gltf_node.children)
+		{
+			traverse_nodes.push({package_index, child_node_index});
+		}
+	}
+
+	header.nodes             = writer.add_table(nodes);
+	header.meshes            = writer.add_table(meshes);
+	header.submeshes         = writer.add_table(submeshes);
+	header.attributes        = writer.add_table(attributes);
+	header.materials         = writer.add_table(materials);
+	header.material_textures = writer.add_table(material_textures);
+	header.textures          = writer.add_table(textures);
+	header.samplers          = writer.add_table(samplers);
+	header.images            = writer.add_table(images);
+	header.cameras           = writer.add_table(cameras);
+	header.lights            = writer.add_table(lights);
+
+	return writer.finish(header);
+}
+}        // namespace vkb
@@ -0,0 +1,69 @@
+/* Copyright (c) 2025, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "gltf_loader.h"
+#include "scene_package.h"
+
+namespace vkb
+{
+namespace sg
+{
+class Image;
+}
+
+struct ScenePackageBakeOptions
+{
+	/// Runs the mesh optimizer on indexed triangle lists before their buffers are laid out
+	bool optimize_meshes = false;
+
+	MeshOptimizerOptions mesh_optimizer_options;
+
+	/// Generates the missing mip chain of uncompressed RGBA8 images
+	bool generate_mipmaps = true;
+
+	/// Threads decoding images and optimizing meshes, 0 uses all hardware threads
+	size_t thread_count = 0;
+};
+
+/**
+ * @brief Converts a glTF scene into a scene package, see ScenePackage
+ *
+ * Work the GLTFLoader does on every load is done once here: attributes are compacted to tightly packed
+ * vertex buffers, indices narrowed to 16 bits where possible, images decoded, mipmapped and stored in
+ * their final color space, and the node hierarchy of the scene flattened parents first. Animations are
+ * not part of the package.
+ *
+ * @param model glTF model, with its buffers loaded
+ * @param model_path Asset relative directory the image URIs of the model are relative to
+ * @param scene_index Scene to bake, -1 for the default scene of the model
+ * @return Contents of the package file
+ * @throws std::runtime_error if the model references missing data or an image can not be stored
+ */
+std::vector<uint8_t> bake_scene_package(const tinygltf::Model &model, const std::string &model_path, int scene_index = -1, const ScenePackageBakeOptions &options = {});
+
+/**
+ * @brief Writes the image with all of its mip levels as a KTX2 file without supercompression
+ * @throws std::runtime_error for array, cube and 3D images or formats KTX2 can not describe
+ */
+std::vector<uint8_t> write_ktx2(const sg::Image &image);
+}        // namespace vkb
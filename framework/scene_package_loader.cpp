@@ -0,0 +1,503 @@
+/* Copyright (c) 2025, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "scene_package_loader.h"
+
+#include <limits>
+#include <thread>
+
+#include "common/glm_common.h"
+#include <glm/gtc/type_ptr.hpp>
+
+#include <core/util/profiling.hpp>
+
+#include "common/utils.h"
+#include "core/device.h"
+#include "core/util/logging.hpp"
+#include "filesystem/filesystem.hpp"
+#include "filesystem/legacy.h"
+#include "gltf_loader.h"
+#include "scene_graph/components/camera.h"
+#include "scene_graph/components/image.h"
+#include "scene_graph/components/image/astc.h"
+#include "scene_graph/components/image/ktx.h"
+#include "scene_graph/components/light.h"
+#include "scene_graph/components/mesh.h"
+#include "scene_graph/components/pbr_material.h"
+#include "scene_graph/components/perspective_camera.h"
+#include "scene_graph/components/sampler.h"
+#include "scene_graph/components/sub_mesh.h"
+#include "scene_graph/components/texture.h"
+#include "scene_graph/components/transform.h"
+#include "scene_graph/node.h"
+#include "scene_graph/scene.h"
+#include "timer.h"
+#include "upload_service.h"
+
+#include <ctpl_stl.h>
+
+namespace vkb
+{
+namespace
+{
+/**
+ * @brief Returns the element of a package table, or nullptr for PACKAGE_INVALID_INDEX
+ * @throws std::runtime_error if the index is out of range
+ */
+template <typename T>
+T *get_element(const std::vector<T *> &elements, int64_t index, const char *table_name)
+{
+	if (index == PACKAGE_INVALID_INDEX)
+	{
+		return nullptr;
+	}
+	if (index < 0 || index >= static_cast<int64_t>(elements.size()))
+	{
+		throw std::runtime_error(std::string("Scene package references missing ") + table_name + " #" + std::to_string(index));
+	}
+	return elements[index];
+}
+}        // namespace
+
+ScenePackageLoader::ScenePackageLoader(Device &device) :
+    device{device}
+{
+}
+
+std::unique_ptr<sg::Scene> ScenePackageLoader::read_scene_from_file(const std::string &file_name, VkBufferUsageFlags additional_buffer_usage_flags)
+{
+	PROFILE_SCOPE("Load Scene Package");
+
+	// The package is read in place from its mapping, its sections are only copied into the GPU buffers
+	vkb::filesystem::MappedFilePtr file;
+	try
+	{
+		file = fs::map_asset(file_name);
+	}
+	catch (const std::exception &e)
+	{
+		LOGE("Failed to read scene package {}: {}", file_name, e.what());
+		return nullptr;
+	}
+
+	ScenePackage package{file->data(), file->size()};
+
+	return std::make_unique<sg::Scene>(load_scene(package, additional_buffer_usage_flags));
+}
+
+sg::Scene ScenePackageLoader::load_scene(const ScenePackage &package, VkBufferUsageFlags additional_buffer_usage_flags)
+{
+	PROFILE_SCOPE("Process Scene Package");
+
+	vkb::allocated::MemoryCategoryScope memory_category{vkb::allocated::MemoryCategory::SceneGeometry};
+
+	// Lets sg::MemoryDefragmenter copy the vertex and index buffers to another place
+	additional_buffer_usage_flags |= VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT;
+
+	auto &header = package.get_header();
+
+	auto scene = sg::Scene();
+
+	scene.set_name("gltf_scene");
+
+	// Load lights
+	std::vector<std::unique_ptr<sg::Light>> light_components;
+	for (auto &package_light : package.get_table<PackageLight>(header.lights))
+	{
+		auto light = std::make_unique<sg::Light>(std::string(package.get_string(package_light.name)));
+
+		sg::LightProperties properties;
+		properties.color            = glm::make_vec3(package_light.color);
+		properties.intensity        = package_light.intensity;
+		properties.range            = package_light.range;
+		properties.inner_cone_angle = package_light.inner_cone_angle;
+		properties.outer_cone_angle = package_light.outer_cone_angle;
+
+		light->set_light_type(static_cast<sg::LightType>(package_light.type));
+		light->set_properties(properties);
+
+		light_components.push_back(std::move(light));
+	}
+
+	scene.set_components(std::move(light_components));
+
+	// Load samplers
+	std::vector<std::unique_ptr<sg::Sampler>> sampler_components;
+	for (auto &package_sampler : package.get_table<PackageSampler>(header.samplers))
+	{
+		VkSamplerCreateInfo sampler_info{VK_STRUCTURE_TYPE_SAMPLER_CREATE_INFO};
+
+		sampler_info.magFilter    = static_cast<VkFilter>(package_sampler.mag_filter);
+		sampler_info.minFilter    = static_cast<VkFilter>(package_sampler.min_filter);
+		sampler_info.mipmapMode   = static_cast<VkSamplerMipmapMode>(package_sampler.mipmap_mode);
+		sampler_info.addressModeU = static_cast<VkSamplerAddressMode>(package_sampler.address_mode_u);
+		sampler_info.addressModeV = static_cast<VkSamplerAddressMode>(package_sampler.address_mode_v);
+		sampler_info.borderColor  = VK_BORDER_COLOR_FLOAT_OPAQUE_WHITE;
+		sampler_info.maxLod       = std::numeric_limits<float>::max();
+
+		std::string name{package.get_string(package_sampler.name)};
+
+		core::Sampler vk_sampler{device, sampler_info};
+		vk_sampler.set_debug_name(name);
+
+		sampler_components.push_back(std::make_unique<sg::Sampler>(name, std::move(vk_sampler)));
+	}
+
+	scene.set_components(std::move(sampler_components));
+
+	Timer timer;
+	timer.start();
+
+	// Load images, the KTX2 blobs already hold the final format and all mip levels
+	auto thread_count = std::thread::hardware_concurrency();
+	thread_count      = thread_count == 0 ? 1 : thread_count;
+	ctpl::thread_pool thread_pool(thread_count);
+
+	auto package_images = package.get_table<PackageImage>(header.images);
+	auto image_count    = to_u32(package_images.size());
+
+	std::vector<std::future<std::unique_ptr<sg::Image>>> image_component_futures;
+	for (size_t image_index = 0; image_index < image_count; image_index++)
+	{
+		auto fut = thread_pool.push(
+		    [this, &package, &package_images, image_index](size_t) {
+			    auto &package_image = package_images[image_index];
+			    auto  ktx2          = package.get_blob(package_image.ktx2);
+
+			    std::unique_ptr<sg::Image> image = std::make_unique<sg::Ktx>(std::string(package.get_string(package_image.name)), ktx2.data(), ktx2.size(), sg::Image::Unknown);
+
+			    // Check whether the format is supported by the GPU
+			    if (sg::is_astc(image->get_format()))
+			    {
+				    if (!device.is_image_format_supported(image->get_format()))
+				    {
+					    LOGW("ASTC not supported: decoding {}", image->get_name());
+					    image = std::make_unique<sg::Astc>(*image);
+					    image->generate_mipmaps();
+				    }
+			    }
+
+			    image->create_vk_image(device);
+
+			    return image;
+		    });
+
+		image_component_futures.push_back(std::move(fut));
+	}
+
+	std::vector<std::unique_ptr<sg::Image>> image_components;
+
+	// Upload images to GPU through the staging ring of the device, as the GLTFLoader does
+	{
+		PROFILE_SCOPE("Upload Images");
+
+		auto &upload_service = device.get_upload_service();
+
+		for (size_t image_index = 0; image_index < image_count; image_index++)
+		{
+			image_components.push_back(image_component_futures[image_index].get());
+
+			upload_image_to_gpu(upload_service, *image_components[image_index]);
+		}
+
+		upload_service.flush();
+	}
+
+	scene.set_components(std::move(image_components));
+
+	LOGI("Time spent loading images: {} seconds across {} threads.", vkb::to_string(timer.stop()), thread_count);
+
+	// Load textures
+	auto images   = scene.get_components<sg::Image>();
+	auto samplers = scene.get_components<sg::Sampler>();
+
+	auto create_default_sampler = [this](int filter) {
+		tinygltf::Sampler gltf_sampler;
+
+		gltf_sampler.minFilter = filter;
+		gltf_sampler.magFilter = filter;
+
+		gltf_sampler.wrapS = TINYGLTF_TEXTURE_WRAP_REPEAT;
+		gltf_sampler.wrapT = TINYGLTF_TEXTURE_WRAP_REPEAT;
+
+		return std::make_unique<sg::Sampler>(gltf_sampler.name, core::Sampler{device, get_sampler_create_info(gltf_sampler)});
+	};
+	auto default_sampler_linear  = create_default_sampler(TINYGLTF_TEXTURE_FILTER_LINEAR);
+	auto default_sampler_nearest = create_default_sampler(TINYGLTF_TEXTURE_FILTER_NEAREST);
+	bool used_nearest_sampler    = false;
+
+	std::vector<std::unique_ptr<sg::Texture>> texture_components;
+	for (auto &package_texture : package.get_table<PackageTexture>(header.textures))
+	{
+		auto texture = std::make_unique<sg::Texture>(std::string(package.get_string(package_texture.name)));
+
+		auto image = get_element(images, package_texture.image, "image");
+		if (!image)
+		{
+			throw std::runtime_error("Scene package texture has no image");
+		}
+		texture->set_image(*image);
+
+		if (auto sampler = get_element(samplers, package_texture.sampler, "sampler"))
+		{
+			texture->set_sampler(*sampler);
+		}
+		else
+		{
+			const VkFormatProperties fmtProps = device.get_gpu().get_format_properties(image->get_format());
+
+			if (fmtProps.optimalTilingFeatures & VK_FORMAT_FEATURE_SAMPLED_IMAGE_FILTER_LINEAR_BIT)
+			{
+				texture->set_sampler(*default_sampler_linear);
+			}
+			else
+			{
+				texture->set_sampler(*default_sampler_nearest);
+				used_nearest_sampler = true;
+			}
+		}
+
+		texture_components.push_back(std::move(texture));
+	}
+
+	scene.set_components(std::move(texture_components));
+
+	scene.add_component(std::move(default_sampler_linear));
+	if (used_nearest_sampler)
+	{
+		scene.add_component(std::move(default_sampler_nearest));
+	}
+
+	// Load materials
+	std::vector<sg::Texture *> textures;
+	if (scene.has_component<sg::Texture>())
+	{
+		textures = scene.get_components<sg::Texture>();
+	}
+
+	auto material_textures = package.get_table<PackageMaterialTexture>(header.material_textures);
+
+	std::vector<std::unique_ptr<sg::PBRMaterial>> material_components;
+	for (auto &package_material : package.get_table<PackageMaterial>(header.materials))
+	{
+		auto material = std::make_unique<sg::PBRMaterial>(std::string(package.get_string(package_material.name)));
+
+		material->base_color_factor = glm::make_vec4(package_material.base_color_factor);
+		material->emissive          = glm::make_vec3(package_material.emissive);
+		material->metallic_factor   = package_material.metallic_factor;
+		material->roughness_factor  = package_material.roughness_factor;
+		material->alpha_cutoff      = package_material.alpha_cutoff;
+		material->alpha_mode        = static_cast<sg::AlphaMode>(package_material.alpha_mode);
+		material->double_sided      = package_material.double_sided != 0;
+
+		if (package_material.first_texture > material_textures.size() || package_material.texture_count > material_textures.size() - package_material.first_texture)
+		{
+			throw std::runtime_error("Scene package material textures are out of bounds");
+		}
+
+		for (auto &material_texture : material_textures.subspan(package_material.first_texture, package_material.texture_count))
+		{
+			material->textures[std::string(package.get_string(material_texture.name))] = get_element(textures, material_texture.texture, "texture");
+		}
+
+		material_components.push_back(std::move(material));
+	}
+
+	scene.set_components(std::move(material_components));
+
+	auto default_material               = std::make_unique<sg::PBRMaterial>("");
+	default_material->base_color_factor = glm::vec4(1.0f);
+
+	// Load meshes
+	auto materials = scene.get_components<sg::PBRMaterial>();
+
+	auto package_submeshes  = package.get_table<PackageSubMesh>(header.submeshes);
+	auto package_attributes = package.get_table<PackageAttribute>(header.attributes);
+
+	for (auto &package_mesh : package.get_table<PackageMesh>(header.meshes))
+	{
+		PROFILE_SCOPE("Processing Mesh");
+
+		auto mesh = std::make_unique<sg::Mesh>(std::string(package.get_string(package_mesh.name)));
+
+		if (package_mesh.first_submesh > package_submeshes.size() || package_mesh.submesh_count > package_submeshes.size() - package_mesh.first_submesh)
+		{
+			throw std::runtime_error("Scene package submeshes are out of bounds");
+		}
+
+		for (auto &package_submesh : package_submeshes.subspan(package_mesh.first_submesh, package_mesh.submesh_count))
+		{
+			std::string submesh_name{package.get_string(package_submesh.name)};
+
+			auto submesh = std::make_unique<sg::SubMesh>(submesh_name);
+
+			submesh->vertices_count = package_submesh.vertex_count;
+
+			if (package_submesh.first_attribute > package_attributes.size() || package_submesh.attribute_count > package_attributes.size() - package_submesh.first_attribute)
+			{
+				throw std::runtime_error("Scene package attributes are out of bounds");
+			}
+
+			for (auto &package_attribute : package_attributes.subspan(package_submesh.first_attribute, package_submesh.attribute_count))
+			{
+				std::string attrib_name{package.get_string(package_attribute.name)};
+				auto        attribute_data = package.get_blob(package_attribute.data);
+
+				sg::VertexAttribute attrib;
+				attrib.format = static_cast<VkFormat>(package_attribute.format);
+				attrib.stride = package_attribute.stride;
+
+				vkb::core::BufferC buffer{device,
+				                          attribute_data.size(),
+				                          VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | additional_buffer_usage_flags,
+				                          VMA_MEMORY_USAGE_CPU_TO_GPU};
+				buffer.update(attribute_data.data(), attribute_data.size());
+				buffer.set_debug_name(fmt::format("{}: '{}' vertex buffer", submesh_name, attrib_name));
+
+				submesh->vertex_buffers.insert(std::make_pair(attrib_name, std::move(buffer)));
+
+				submesh->set_attribute(attrib_name, attrib);
+			}
+
+			if (package_submesh.index_count > 0)
+			{
+				auto index_data = package.get_blob(package_submesh.indices);
+
+				submesh->vertex_indices = package_submesh.index_count;
+				submesh->index_type     = static_cast<VkIndexType>(package_submesh.index_type);
+
+				submesh->index_buffer = std::make_unique<vkb::core::BufferC>(device,
+				                                                             index_data.size(),
+				                                                             VK_BUFFER_USAGE_INDEX_BUFFER_BIT | additional_buffer_usage_flags,
+				                                                             VMA_MEMORY_USAGE_GPU_TO_CPU);
+				submesh->index_buffer->set_debug_name(fmt::format("{}: index buffer", submesh_name));
+
+				submesh->index_buffer->update(index_data.data(), index_data.size());
+			}
+
+			if (auto material = get_element(materials, package_submesh.material, "material"))
+			{
+				submesh->set_material(*material);
+			}
+			else
+			{
+				submesh->set_material(*default_material);
+			}
+
+			mesh->add_submesh(*submesh);
+
+			scene.add_component(std::move(submesh));
+		}
+
+		scene.add_component(std::move(mesh));
+	}
+
+	scene.add_component(std::move(default_material));
+
+	// Load cameras
+	for (auto &package_camera : package.get_table<PackageCamera>(header.cameras))
+	{
+		auto camera = std::make_unique<sg::PerspectiveCamera>(std::string(package.get_string(package_camera.name)));
+
+		camera->set_aspect_ratio(package_camera.aspect_ratio);
+		camera->set_field_of_view(package_camera.field_of_view);
+		camera->set_near_plane(package_camera.near_plane);
+		camera->set_far_plane(package_camera.far_plane);
+
+		scene.add_component(std::move(camera));
+	}
+
+	// Load nodes, parents are stored before their children
+	auto meshes  = scene.get_components<sg::Mesh>();
+	auto cameras = scene.get_components<sg::Camera>();
+	auto lights  = scene.get_components<sg::Light>();
+
+	auto root_node = std::make_unique<sg::Node>(0, std::string(package.get_string(header.name)));
+
+	std::vector<std::unique_ptr<sg::Node>> nodes;
+
+	for (auto &package_node : package.get_table<PackageNode>(header.nodes))
+	{
+		auto node = std::make_unique<sg::Node>(nodes.size(), std::string(package.get_string(package_node.name)));
+
+		auto &transform = node->get_component<sg::Transform>();
+		transform.set_translation(glm::make_vec3(package_node.translation));
+		transform.set_rotation(glm::quat(package_node.rotation[3], package_node.rotation[0], package_node.rotation[1], package_node.rotation[2]));
+		transform.set_scale(glm::make_vec3(package_node.scale));
+
+		if (auto mesh = get_element(meshes, package_node.mesh, "mesh"))
+		{
+			node->set_component(*mesh);
+
+			mesh->add_node(*node);
+		}
+
+		if (auto camera = get_element(cameras, package_node.camera, "camera"))
+		{
+			node->set_component(*camera);
+
+			camera->set_node(*node);
+		}
+
+		if (auto light = get_element(lights, package_node.light, "light"))
+		{
+			node->set_component(*light);
+
+			light->set_node(*node);
+		}
+
+		if (package_node.parent != PACKAGE_INVALID_INDEX && (package_node.parent < 0 || package_node.parent >= static_cast<int32_t>(nodes.size())))
+		{
+			throw std::runtime_error("Scene package node is stored before its parent");
+		}
+
+		auto &parent = package_node.parent == PACKAGE_INVALID_INDEX ? *root_node : *nodes[package_node.parent];
+		node->set_parent(parent);
+		parent.add_child(*node);
+
+		nodes.push_back(std::move(node));
+	}
+
+	scene.set_root_node(*root_node);
+	nodes.push_back(std::move(root_node));
+
+	scene.set_nodes(std::move(nodes));
+
+	// Create node for the default camera
+	auto camera_node = std::make_unique<sg::Node>(-1, "default_camera");
+
+	auto default_camera = std::make_unique<sg::PerspectiveCamera>("default_camera");
+	default_camera->set_aspect_ratio(1.77f);
+	default_camera->set_field_of_view(1.0f);
+	default_camera->set_near_plane(0.1f);
+	default_camera->set_far_plane(1000.0f);
+	default_camera->set_node(*camera_node);
+	camera_node->set_component(*default_camera);
+	scene.add_component(std::move(default_camera));
+
+	scene.get_root_node().add_child(*camera_node);
+	scene.add_node(std::move(camera_node));
+
+	if (!scene.has_component<vkb::sg::Light>())
+	{
+		// Add a default light if none are present
+		vkb::add_directional_light(scene, glm::quat({glm::radians(-90.0f), 0.0f, glm::radians(30.0f)}));
+	}
+
+	return scene;
+}
+}        // namespace vkb
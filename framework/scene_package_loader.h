@@ -0,0 +1,61 @@
+/* Copyright (c) 2025, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <memory>
+#include <string>
+
+#include "common/vk_common.h"
+#include "scene_package.h"
+
+namespace vkb
+{
+class Device;
+
+namespace sg
+{
+class Scene;
+}
+
+/**
+ * @brief Creates a scene from a package written by bake_scene_package
+ *
+ * The scene matches the one the GLTFLoader creates from the source glTF file, without its animations.
+ * Nothing is decoded or converted: vertex and index blobs are copied straight into their buffers and
+ * the KTX2 images into staging buffers.
+ */
+class ScenePackageLoader
+{
+  public:
+	ScenePackageLoader(Device &device);
+
+	virtual ~ScenePackageLoader() = default;
+
+	/**
+	 * @param file_name Path of the package, relative to the assets directory
+	 * @return The scene, or nullptr if the file can not be read
+	 * @throws std::runtime_error if the file is not a valid package
+	 */
+	std::unique_ptr<sg::Scene> read_scene_from_file(const std::string &file_name, VkBufferUsageFlags additional_buffer_usage_flags = 0);
+
+	sg::Scene load_scene(const ScenePackage &package, VkBufferUsageFlags additional_buffer_usage_flags = 0);
+
+  private:
+	Device &device;
+};
+}        // namespace vkb
@@ -0,0 +1,502 @@
+/* Copyright (c) 2025, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "simulation/nbody_simulation.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <random>
+#include <thread>
+
+#include "common/parallel.h"
+
+#if defined(__x86_64__) || defined(_M_X64)
+#	include <immintrin.h>
+#	if defined(_MSC_VER)
+#		include <intrin.h>
+#		define VKB_NBODY_TARGET_AVX2
+#	else
+#		define VKB_NBODY_TARGET_AVX2 __attribute__((target("avx2,fma")))
+#	endif
+#	define VKB_NBODY_AVX2
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#	include <arm_neon.h>
+#	define VKB_NBODY_NEON
+#endif
+
+namespace vkb
+{
+namespace
+{
+// Scale of the time step, TIME_FACTOR in the compute shaders
+constexpr float time_factor = 0.05f;
+
+// Octree nodes are not subdivided further than this, so that coincident particles end up in a leaf
+constexpr uint32_t max_octree_depth = 24;
+
+// Particles below this count are not worth distributing across threads
+constexpr size_t min_particles_per_job = 64;
+
+// Interaction of a particle at the origin with a particle at offset d, before the gravity scale
+// The force falls off with (r^2 + soften)^0.75 as POWER in particle_calculate.comp, computed with square roots as in the SIMD kernels
+inline glm::vec3 interaction(glm::vec3 d, float mass, float soften)
+{
+	float r2 = glm::dot(d, d) + soften;
+	float r  = std::sqrt(r2);
+	return d * (mass / (r * std::sqrt(r)));
+}
+
+glm::vec3 accumulate_scalar(const float *x, const float *y, const float *z, const float *mass, size_t begin, size_t end, glm::vec3 position, float soften)
+{
+	glm::vec3 acceleration{0.0f};
+	for (size_t j = begin; j < end; ++j)
+	{
+		acceleration += interaction(glm::vec3(x[j], y[j], z[j]) - position, mass[j], soften);
+	}
+	return acceleration;
+}
+
+#if defined(VKB_NBODY_AVX2)
+bool cpu_supports_avx2()
+{
+#	if defined(_MSC_VER)
+	int info[4];
+	__cpuid(info, 0);
+	if (info[0] < 7)
+	{
+		return false;
+	}
+
+	// AVX and FMA, with the AVX state saved by the OS
+	__cpuid(info, 1);
+	const int avx_fma_osxsave = (1 << 12) | (1 << 27) | (1 << 28);
+	if ((info[2] & avx_fma_osxsave) != avx_fma_osxsave || (_xgetbv(0) & 6) != 6)
+	{
+		return false;
+	}
+
+	__cpuidex(info, 7, 0);
+	return (info[1] & (1 << 5)) != 0;
+#	else
+	return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+#	endif
+}
+
+VKB_NBODY_TARGET_AVX2 inline float horizontal_sum(__m256 v)
+{
+	__m128 sum = _mm_add_ps(_mm256_castps256_ps128(v), _mm256_extractf128_ps(v, 1));
+	sum        = _mm_add_ps(sum, _mm_movehl_ps(sum, sum));
+	sum        = _mm_add_ss(sum, _mm_movehdup_ps(sum));
+	return _mm_cvtss_f32(sum);
+}
+
+VKB_NBODY_TARGET_AVX2 glm::vec3 accumulate_avx2(const float *x, const float *y, const float *z, const float *mass, size_t begin, size_t end, glm::vec3 position, float soften)
+{
+	const __m256 px = _mm256_set1_ps(position.x);
+	const __m256 py = _mm256_set1_ps(position.y);
+	const __m256 pz = _mm256_set1_ps(position.z);
+	const __m256 s  = _mm256_set1_ps(soften);
+
+	__m256 ax = _mm256_setzero_ps();
+	__m256 ay = _mm256_setzero_ps();
+	__m256 az = _mm256_setzero_ps();
+
+	size_t j = begin;
+	for (; j + 8 <= end; j += 8)
+	{
+		__m256 dx = _mm256_sub_ps(_mm256_loadu_ps(x + j), px);
+		__m256 dy = _mm256_sub_ps(_mm256_loadu_ps(y + j), py);
+		__m256 dz = _mm256_sub_ps(_mm256_loadu_ps(z + j), pz);
+
+		__m256 r2 = _mm256_fmadd_ps(dx, dx, _mm256_fmadd_ps(dy, dy, _mm256_fmadd_ps(dz, dz, s)));
+		__m256 r  = _mm256_sqrt_ps(r2);
+		__m256 f  = _mm256_div_ps(_mm256_loadu_ps(mass + j), _mm256_mul_ps(r, _mm256_sqrt_ps(r)));
+
+		ax = _mm256_fmadd_ps(dx, f, ax);
+		ay = _mm256_fmadd_ps(dy, f, ay);
+		az = _mm256_fmadd_ps(dz, f, az);
+	}
+
+	glm::vec3 acceleration{horizontal_sum(ax), horizontal_sum(ay), horizontal_sum(az)};
+	return acceleration + accumulate_scalar(x, y, z, mass, j, end, position, soften);
+}
+#elif defined(VKB_NBODY_NEON)
+glm::vec3 accumulate_neon(const float *x, const float *y, const float *z, const float *mass, size_t begin, size_t end, glm::vec3 position, float soften)
+{
+	const float32x4_t px = vdupq_n_f32(position.x);
+	const float32x4_t py = vdupq_n_f32(position.y);
+	const float32x4_t pz = vdupq_n_f32(position.z);
+	const float32x4_t s  = vdupq_n_f32(soften);
+
+	float32x4_t ax = vdupq_n_f32(0.0f);
+	float32x4_t ay = vdupq_n_f32(0.0f);
+	float32x4_t az = vdupq_n_f32(0.0f);
+
+	size_t j = begin;
+	for (; j + 4 <= end; j += 4)
+	{
+		float32x4_t dx = vsubq_f32(vld1q_f32(x + j), px);
+		float32x4_t dy = vsubq_f32(vld1q_f32(y + j), py);
+		float32x4_t dz = vsubq_f32(vld1q_f32(z + j), pz);
+
+		float32x4_t r2 = vfmaq_f32(vfmaq_f32(vfmaq_f32(s, dz, dz), dy, dy), dx, dx);
+		float32x4_t r  = vsqrtq_f32(r2);
+		float32x4_t f  = vdivq_f32(vld1q_f32(mass + j), vmulq_f32(r, vsqrtq_f32(r)));
+
+		ax = vfmaq_f32(ax, dx, f);
+		ay = vfmaq_f32(ay, dy, f);
+		az = vfmaq_f32(az, dz, f);
+	}
+
+	glm::vec3 acceleration{vaddvq_f32(ax), vaddvq_f32(ay), vaddvq_f32(az)};
+	return acceleration + accumulate_scalar(x, y, z, mass, j, end, position, soften);
+}
+#endif
+}        // namespace
+
+NBodySimulation::NBodySimulation(const NBodyParams &params, size_t thread_count, bool use_simd) :
+    params{params},
+    thread_count{thread_count == 0 ? std::max(1u, std::thread::hardware_concurrency()) : thread_count},
+    accumulate{accumulate_scalar},
+    kernel_name{"scalar"}
+{
+#if defined(VKB_NBODY_AVX2)
+	if (use_simd && cpu_supports_avx2())
+	{
+		accumulate  = accumulate_avx2;
+		kernel_name = "AVX2";
+	}
+#elif defined(VKB_NBODY_NEON)
+	if (use_simd)
+	{
+		accumulate  = accumulate_neon;
+		kernel_name = "NEON";
+	}
+#endif
+}
+
+NBodySimulation::~NBodySimulation() = default;
+
+std::vector<NBodyParticle> NBodySimulation::create_particles(const std::vector<glm::vec3> &attractors, uint32_t particles_per_attractor, uint32_t seed)
+{
+	std::vector<NBodyParticle> particles(attractors.size() * particles_per_attractor);
+
+	std::default_random_engine      rnd_engine(seed);
+	std::normal_distribution<float> rnd_distribution(0.0f, 1.0f);
+
+	for (uint32_t i = 0; i < static_cast<uint32_t>(attractors.size()); i++)
+	{
+		for (uint32_t j = 0; j < particles_per_attractor; j++)
+		{
+			NBodyParticle &particle = particles[i * particles_per_attractor + j];
+
+			// First particle in group as heavy center of gravity
+			if (j == 0)
+			{
+				particle.pos = glm::vec4(attractors[i] * 1.5f, 90000.0f);
+				particle.vel = glm::vec4(glm::vec4(0.0f));
+			}
+			else
+			{
+				// Position
+				glm::vec3 position(attractors[i] + glm::vec3(rnd_distribution(rnd_engine), rnd_distribution(rnd_engine), rnd_distribution(rnd_engine)) * 0.75f);
+				float     len = glm::length(glm::normalize(position - attractors[i]));
+				position.y *= 2.0f - (len * len);
+
+				// Velocity
+				glm::vec3 angular  = glm::vec3(0.5f, 1.5f, 0.5f) * (((i % 2) == 0) ? 1.0f : -1.0f);
+				glm::vec3 velocity = glm::cross((position - attractors[i]), angular) + glm::vec3(rnd_distribution(rnd_engine), rnd_distribution(rnd_engine), rnd_distribution(rnd_engine) * 0.025f);
+
+				float mass   = (rnd_distribution(rnd_engine) * 0.5f + 0.5f) * 75.0f;
+				particle.pos = glm::vec4(position, mass);
+				particle.vel = glm::vec4(velocity, 0.0f);
+			}
+
+			// Color gradient offset
+			particle.vel.w = static_cast<float>(i) * 1.0f / static_cast<uint32_t>(attractors.size());
+		}
+	}
+
+	return particles;
+}
+
+void NBodySimulation::compute_accelerations(std::span<const NBodyParticle> particles, NBodyMethod method, std::vector<glm::vec3> &accelerations)
+{
+	accelerations.resize(particles.size());
+
+	if (method == NBodyMethod::BruteForce)
+	{
+		load_bodies(particles, nullptr);
+
+		// The padding particles are massless, so every particle sums over whole SIMD registers
+		parallel_for(particles.size(), thread_count, min_particles_per_job, [&](size_t begin, size_t end) {
+			for (size_t i = begin; i < end; ++i)
+			{
+				glm::vec3 position(particles[i].pos);
+				accelerations[i] = params.gravity * accumulate(x.data(), y.data(), z.data(), mass.data(), 0, x.size(), position, params.soften);
+			}
+		});
+	}
+	else
+	{
+		build_octree(particles);
+		load_bodies(particles, order.data());
+
+		// The tree is traversed once per leaf, the particles of the leaf then share the resulting interactions
+		parallel_for(leaves.size(), thread_count, min_particles_per_job, [&](size_t begin, size_t end) {
+			InteractionList list;
+			for (size_t l = begin; l < end; ++l)
+			{
+				barnes_hut_leaf(nodes[leaves[l]], list, accelerations);
+			}
+		});
+	}
+}
+
+void NBodySimulation::step(std::span<NBodyParticle> particles, float delta_time, NBodyMethod method)
+{
+	compute_accelerations(particles, method, step_accelerations);
+
+	float scaled_time = delta_time * time_factor;
+
+	parallel_for(particles.size(), thread_count, min_particles_per_job, [&](size_t begin, size_t end) {
+		for (size_t i = begin; i < end; ++i)
+		{
+			auto &particle = particles[i];
+
+			particle.vel += glm::vec4(scaled_time * step_accelerations[i], 0.0f);
+
+			// Gradient texture position
+			particle.vel.w += 0.1f * scaled_time;
+			if (particle.vel.w > 1.0f)
+			{
+				particle.vel.w -= 1.0f;
+			}
+
+			// particle_integrate.comp integrates all four components, w included
+			particle.pos += scaled_time * particle.vel;
+		}
+	});
+}
+
+const char *NBodySimulation::get_kernel_name() const
+{
+	return kernel_name;
+}
+
+const NBodyParams &NBodySimulation::get_params() const
+{
+	return params;
+}
+
+void NBodySimulation::load_bodies(std::span<const NBodyParticle> particles, const uint32_t *order)
+{
+	size_t padded_count = (particles.size() + 7) & ~size_t{7};
+
+	x.assign(padded_count, 0.0f);
+	y.assign(padded_count, 0.0f);
+	z.assign(padded_count, 0.0f);
+	mass.assign(padded_count, 0.0f);
+
+	for (size_t k = 0; k < particles.size(); ++k)
+	{
+		auto &pos = particles[order ? order[k] : k].pos;
+		x[k]      = pos.x;
+		y[k]      = pos.y;
+		z[k]      = pos.z;
+		mass[k]   = pos.w;
+	}
+}
+
+void NBodySimulation::build_octree(std::span<const NBodyParticle> particles)
+{
+	order.resize(particles.size());
+	order_scratch.resize(particles.size());
+	std::iota(order.begin(), order.end(), 0u);
+
+	nodes.clear();
+	leaves.clear();
+	if (particles.empty())
+	{
+		return;
+	}
+
+	glm::vec3 min_bounds{std::numeric_limits<float>::max()};
+	glm::vec3 max_bounds{std::numeric_limits<float>::lowest()};
+	for (auto &particle : particles)
+	{
+		min_bounds = glm::min(min_bounds, glm::vec3(particle.pos));
+		max_bounds = glm::max(max_bounds, glm::vec3(particle.pos));
+	}
+
+	// Slightly larger than the bounds, so that no particle lies on the upper faces
+	glm::vec3 extent    = max_bounds - min_bounds;
+	float     half_size = 0.5f * std::max({extent.x, extent.y, extent.z}) * 1.001f + 1e-3f;
+
+	// The octree sorts the particles as it subdivides, with their positions loaded in the original order
+	load_bodies(particles, nullptr);
+
+	nodes.emplace_back();
+	build_node(0, 0, static_cast<uint32_t>(particles.size()), 0.5f * (min_bounds + max_bounds), half_size, 0);
+}
+
+void NBodySimulation::build_node(uint32_t node_index, uint32_t first, uint32_t count, glm::vec3 center, float half_size, uint32_t depth)
+{
+	OctreeNode node{};
+	node.center         = center;
+	node.half_size      = half_size;
+	node.first_particle = first;
+	node.particle_count = count;
+
+	if (count <= params.leaf_size || depth >= max_octree_depth)
+	{
+		glm::vec3 weighted_position{0.0f};
+		float     total_mass = 0.0f;
+		for (uint32_t k = first; k < first + count; ++k)
+		{
+			uint32_t i = order[k];
+			weighted_position += glm::vec3(x[i], y[i], z[i]) * mass[i];
+			total_mass += mass[i];
+		}
+
+		node.center_of_mass = glm::vec4(total_mass > 0.0f ? weighted_position / total_mass : center, total_mass);
+		nodes[node_index]   = node;
+		leaves.push_back(node_index);
+		return;
+	}
+
+	// Counting sort of the range by octant, which keeps the order of the particles within an octant
+	auto octant_of = [&](uint32_t i) {
+		return (x[i] >= center.x ? 1u : 0u) | (y[i] >= center.y ? 2u : 0u) | (z[i] >= center.z ? 4u : 0u);
+	};
+
+	std::array<uint32_t, 9> offsets{};
+	for (uint32_t k = first; k < first + count; ++k)
+	{
+		++offsets[octant_of(order[k]) + 1];
+	}
+	std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+
+	auto cursor = offsets;
+	for (uint32_t k = first; k < first + count; ++k)
+	{
+		uint32_t i                                    = order[k];
+		order_scratch[first + cursor[octant_of(i)]++] = i;
+	}
+	std::copy(order_scratch.begin() + first, order_scratch.begin() + first + count, order.begin() + first);
+
+	// Children are allocated together so that they are consecutive, then built depth first
+	node.first_child = static_cast<uint32_t>(nodes.size());
+	for (uint32_t octant = 0; octant < 8; ++octant)
+	{
+		if (offsets[octant + 1] > offsets[octant])
+		{
+			++node.child_count;
+		}
+	}
+	nodes.resize(nodes.size() + node.child_count);
+
+	glm::vec3 weighted_position{0.0f};
+	float     total_mass  = 0.0f;
+	uint32_t  child_index = node.first_child;
+	float     child_half  = 0.5f * half_size;
+	for (uint32_t octant = 0; octant < 8; ++octant)
+	{
+		uint32_t child_count = offsets[octant + 1] - offsets[octant];
+		if (child_count == 0)
+		{
+			continue;
+		}
+
+		glm::vec3 child_center = center + child_half * glm::vec3((octant & 1) ? 1.0f : -1.0f, (octant & 2) ? 1.0f : -1.0f, (octant & 4) ? 1.0f : -1.0f);
+		build_node(child_index, first + offsets[octant], child_count, child_center, child_half, depth + 1);
+
+		auto &child_mass = nodes[child_index].center_of_mass;
+		weighted_position += glm::vec3(child_mass) * child_mass.w;
+		total_mass += child_mass.w;
+		++child_index;
+	}
+
+	node.center_of_mass = glm::vec4(total_mass > 0.0f ? weighted_position / total_mass : center, total_mass);
+	nodes[node_index]   = node;
+}
+
+void NBodySimulation::barnes_hut_leaf(const OctreeNode &leaf, InteractionList &list, std::vector<glm::vec3> &accelerations) const
+{
+	list.x.clear();
+	list.y.clear();
+	list.z.clear();
+	list.mass.clear();
+
+	auto append = [&list](float px, float py, float pz, float m) {
+		list.x.push_back(px);
+		list.y.push_back(py);
+		list.z.push_back(pz);
+		list.mass.push_back(m);
+	};
+
+	// Deep enough for every node of the tree to be pushed with its siblings
+	std::array<uint32_t, max_octree_depth * 8 + 1> stack;
+	size_t                                         stack_size = 0;
+	stack[stack_size++]                                       = 0;
+
+	const float theta2 = params.theta * params.theta;
+
+	// A node is approximated for the whole leaf when it is far enough from the closest point of the leaf
+	while (stack_size > 0)
+	{
+		const OctreeNode &node = nodes[stack[--stack_size]];
+
+		if (node.child_count == 0)
+		{
+			for (uint32_t k = node.first_particle; k < node.first_particle + node.particle_count; ++k)
+			{
+				append(x[k], y[k], z[k], mass[k]);
+			}
+			continue;
+		}
+
+		glm::vec3 offset = glm::max(glm::abs(glm::vec3(node.center_of_mass) - leaf.center) - glm::vec3(leaf.half_size), glm::vec3(0.0f));
+		float     size   = 2.0f * node.half_size;
+		if (size * size < theta2 * glm::dot(offset, offset))
+		{
+			append(node.center_of_mass.x, node.center_of_mass.y, node.center_of_mass.z, node.center_of_mass.w);
+			continue;
+		}
+
+		for (uint32_t child = node.first_child + node.child_count; child > node.first_child; --child)
+		{
+			stack[stack_size++] = child - 1;
+		}
+	}
+
+	// Massless padding, so that every particle sums over whole SIMD registers
+	while (list.x.size() % 8 != 0)
+	{
+		append(0.0f, 0.0f, 0.0f, 0.0f);
+	}
+
+	for (uint32_t k = leaf.first_particle; k < leaf.first_particle + leaf.particle_count; ++k)
+	{
+		glm::vec3 position(x[k], y[k], z[k]);
+		accelerations[order[k]] = params.gravity * accumulate(list.x.data(), list.y.data(), list.z.data(), list.mass.data(), 0, list.x.size(), position, params.soften);
+	}
+}
+}        // namespace vkb
@@ -0,0 +1,173 @@
+/* Copyright (c) 2025, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <span>
+#include <vector>
+
+#include "common/glm_common.h"
+
+namespace vkb
+{
+/**
+ * @brief A particle of the N-body simulation, with the layout of the particle storage buffer of the compute_nbody sample
+ */
+struct NBodyParticle
+{
+	glm::vec4 pos;        // xyz = position, w = mass
+	glm::vec4 vel;        // xyz = velocity, w = gradient texture position
+};
+
+/**
+ * @brief How the accelerations of the particles are computed
+ */
+enum class NBodyMethod
+{
+	BruteForce,        // Every pair of particles, O(n^2)
+	BarnesHut,         // Distant groups of particles approximated by their center of mass, O(n log n)
+};
+
+/**
+ * @brief Parameters of the simulation, the defaults match the specialization constants of particle_calculate.comp
+ */
+struct NBodyParams
+{
+	float gravity{0.002f};
+
+	float soften{0.05f};
+
+	/// Barnes-Hut opening angle, a node is approximated when its size is below theta times its distance
+	float theta{0.7f};
+
+	/// Barnes-Hut nodes with at most this many particles are not subdivided
+	uint32_t leaf_size{32};
+};
+
+/**
+ * @brief Simulates the particles of the compute_nbody sample on the CPU
+ *
+ * A step computes the same acceleration and integration as the particle_calculate and particle_integrate compute shaders,
+ * either exactly over every pair of particles or approximated with a Barnes-Hut octree. The pairwise interactions use
+ * 8-wide AVX2 where the CPU supports it, 4-wide NEON on AArch64, and scalar code otherwise, with the particles split
+ * across worker threads.
+ *
+ * Each particle is only written by one thread and sums its interactions in a fixed order, so results do not depend on the
+ * number of threads: the same initial particles and time steps always give the same particles.
+ */
+class NBodySimulation
+{
+  public:
+	/**
+	 * @param params Simulation parameters
+	 * @param thread_count Threads of the shared worker pool to use at most, 0 uses all of them
+	 * @param use_simd Use the SIMD kernel if the CPU supports one, the scalar kernel otherwise
+	 */
+	explicit NBodySimulation(const NBodyParams &params = {}, size_t thread_count = 0, bool use_simd = true);
+
+	~NBodySimulation();
+
+	NBodySimulation(const NBodySimulation &)            = delete;
+	NBodySimulation &operator=(const NBodySimulation &) = delete;
+
+	/**
+	 * @brief Creates the initial particles of the compute_nbody sample, a heavy particle at the center of each attractor surrounded by a rotating cloud
+	 * @param seed Seed of the random distribution, the same seed always gives the same particles
+	 */
+	static std::vector<NBodyParticle> create_particles(const std::vector<glm::vec3> &attractors, uint32_t particles_per_attractor, uint32_t seed);
+
+	/**
+	 * @brief Computes the acceleration of every particle
+	 */
+	void compute_accelerations(std::span<const NBodyParticle> particles, NBodyMethod method, std::vector<glm::vec3> &accelerations);
+
+	/**
+	 * @brief Advances the particles by one time step in place, they may be in a mapped buffer
+	 */
+	void step(std::span<NBodyParticle> particles, float delta_time, NBodyMethod method);
+
+	/**
+	 * @return The name of the kernel used for pairwise interactions: AVX2, NEON or scalar
+	 */
+	const char *get_kernel_name() const;
+
+	const NBodyParams &get_params() const;
+
+  private:
+	struct OctreeNode
+	{
+		glm::vec4 center_of_mass;        // xyz = center of mass, w = total mass
+		glm::vec3 center;
+		float     half_size;
+		uint32_t  first_child;           // Children are consecutive, 0 for leaves
+		uint32_t  child_count;
+		uint32_t  first_particle;        // Range of the sorted particles in the node
+		uint32_t  particle_count;
+	};
+
+	/**
+	 * @brief Copies the particles to the structure of arrays the kernels read, in the given order, padded to a multiple of 8 massless particles
+	 */
+	void load_bodies(std::span<const NBodyParticle> particles, const uint32_t *order);
+
+	void build_octree(std::span<const NBodyParticle> particles);
+
+	void build_node(uint32_t node_index, uint32_t first, uint32_t count, glm::vec3 center, float half_size, uint32_t depth);
+
+	/**
+	 * @brief Positions and masses of the particles and approximated nodes a leaf interacts with
+	 */
+	struct InteractionList
+	{
+		std::vector<float> x;
+		std::vector<float> y;
+		std::vector<float> z;
+		std::vector<float> mass;
+	};
+
+	/**
+	 * @brief Computes the accelerations of the particles of a leaf with the SIMD kernel, over one interaction list for the whole leaf
+	 */
+	void barnes_hut_leaf(const OctreeNode &leaf, InteractionList &list, std::vector<glm::vec3> &accelerations) const;
+
+	using AccumulateFunction = glm::vec3 (*)(const float *x, const float *y, const float *z, const float *mass, size_t begin, size_t end, glm::vec3 position, float soften);
+
+	NBodyParams params;
+
+	/// Threads of the shared worker pool the steps are spread over
+	size_t thread_count;
+
+	AccumulateFunction accumulate;
+
+	const char *kernel_name;
+
+	// Positions and masses as a structure of arrays
+	std::vector<float> x;
+	std::vector<float> y;
+	std::vector<float> z;
+	std::vector<float> mass;
+
+	std::vector<glm::vec3> step_accelerations;
+
+	// Particle indices sorted so that the particles of each octree node are consecutive
+	std::vector<uint32_t> order;
+	std::vector<uint32_t> order_scratch;
+
+	std::vector<OctreeNode> nodes;
+	std::vector<uint32_t>   leaves;
+};
+}        // namespace vkb
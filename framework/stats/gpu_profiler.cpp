@@ -0,0 +1,341 @@
+/* Copyright (c) 2025, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "stats/gpu_profiler.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cassert>
+
+#include <fmt/format.h>
+
+#if defined(_WIN32)
+#	include <windows.h>
+#endif
+
+#include "core/command_buffer.h"
+#include "core/device.h"
+#include "core/query_pool.h"
+#include "core/util/logging.hpp"
+#include "filesystem/filesystem.hpp"
+
+namespace vkb
+{
+namespace
+{
+std::atomic<GpuProfiler *> active_profiler{nullptr};
+
+// Frames kept for get_history and trace export
+constexpr size_t max_history = 240;
+
+constexpr auto calibration_interval = std::chrono::seconds(1);
+
+// The first two queries of a frame time the whole command buffer
+constexpr uint32_t frame_begin_query = 0;
+constexpr uint32_t frame_end_query   = 1;
+
+// The time domain of the host clock std::chrono::steady_clock reads on this platform
+VkTimeDomainEXT get_steady_clock_time_domain()
+{
+#if defined(_WIN32)
+	return VK_TIME_DOMAIN_QUERY_PERFORMANCE_COUNTER_EXT;
+#elif defined(__linux__) || defined(__ANDROID__)
+	return VK_TIME_DOMAIN_CLOCK_MONOTONIC_EXT;
+#else
+	return VK_TIME_DOMAIN_DEVICE_EXT;
+#endif
+}
+
+int64_t host_timestamp_to_steady_ns(uint64_t timestamp)
+{
+#if defined(_WIN32)
+	LARGE_INTEGER frequency;
+	QueryPerformanceFrequency(&frequency);
+	return static_cast<int64_t>(static_cast<double>(timestamp) * 1e9 / static_cast<double>(frequency.QuadPart));
+#else
+	return static_cast<int64_t>(timestamp);
+#endif
+}
+}        // namespace
+
+GpuProfiler::GpuProfiler(Device &device, uint32_t frame_count, uint32_t max_regions, uint32_t max_depth) :
+    device{device},
+    queries_per_frame{2 + 2 * max_regions},
+    max_depth{max_depth},
+    timestamp_period{device.get_gpu().get_properties().limits.timestampPeriod},
+    timestamp_valid_bits{device.get_queue_by_flags(VK_QUEUE_GRAPHICS_BIT, 0).get_properties().timestampValidBits},
+    frames(frame_count)
+{
+	if (timestamp_valid_bits == 0)
+	{
+		throw std::runtime_error("The graphics queue does not support timestamps");
+	}
+
+	VkQueryPoolCreateInfo query_pool_create_info{VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO};
+	query_pool_create_info.queryType  = VK_QUERY_TYPE_TIMESTAMP;
+	query_pool_create_info.queryCount = frame_count * queries_per_frame;
+
+	query_pool = std::make_unique<QueryPool>(device, query_pool_create_info);
+
+	// Calibrate against the host clock steady_clock reads, if the device can
+	if (device.is_enabled(VK_EXT_CALIBRATED_TIMESTAMPS_EXTENSION_NAME) && get_steady_clock_time_domain() != VK_TIME_DOMAIN_DEVICE_EXT)
+	{
+		uint32_t domain_count = 0;
+		vkGetPhysicalDeviceCalibrateableTimeDomainsEXT(device.get_gpu().get_handle(), &domain_count, nullptr);
+		std::vector<VkTimeDomainEXT> domains(domain_count);
+		vkGetPhysicalDeviceCalibrateableTimeDomainsEXT(device.get_gpu().get_handle(), &domain_count, domains.data());
+
+		bool has_device = std::ranges::find(domains, VK_TIME_DOMAIN_DEVICE_EXT) != domains.end();
+		bool has_host   = std::ranges::find(domains, get_steady_clock_time_domain()) != domains.end();
+		if (has_device && has_host)
+		{
+			host_time_domain = get_steady_clock_time_domain();
+			calibrate();
+		}
+	}
+
+	LOGI("GPU profiler: {} frames, {} regions per frame, {} timestamps", frame_count, max_regions, has_calibration ? "calibrated" : "uncalibrated");
+}
+
+GpuProfiler::~GpuProfiler()
+{
+	GpuProfiler *self = this;
+	active_profiler.compare_exchange_strong(self, nullptr);
+}
+
+bool GpuProfiler::is_supported(const Device &device)
+{
+	return device.get_queue_by_flags(VK_QUEUE_GRAPHICS_BIT, 0).get_properties().timestampValidBits != 0;
+}
+
+void GpuProfiler::set_active(GpuProfiler *profiler)
+{
+	active_profiler = profiler;
+}
+
+GpuProfiler *GpuProfiler::get_active()
+{
+	return active_profiler.load(std::memory_order_relaxed);
+}
+
+void GpuProfiler::begin_frame(vkb::core::CommandBufferC &command_buffer, uint32_t frame_index)
+{
+	assert(frame_index < frames.size());
+
+	current_frame       = &frames[frame_index];
+	current_first_query = frame_index * queries_per_frame;
+
+	// The render context waited for the fence of this frame, so the previous results are available
+	if (current_frame->pending)
+	{
+		read_results(*current_frame, current_first_query);
+	}
+
+	if (host_time_domain != VK_TIME_DOMAIN_DEVICE_EXT && std::chrono::steady_clock::now() - last_calibration > calibration_interval)
+	{
+		calibrate();
+	}
+
+	current_frame->frame_number = frame_number++;
+	current_frame->pending      = true;
+	current_frame->query_count  = 2;
+	current_frame->recorded     = std::chrono::steady_clock::now();
+	current_frame->regions.clear();
+
+	current_command_buffer = command_buffer.get_handle();
+	open_regions.clear();
+
+	command_buffer.reset_query_pool(*query_pool, current_first_query, queries_per_frame);
+	command_buffer.write_timestamp(VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, *query_pool, current_first_query + frame_begin_query);
+}
+
+void GpuProfiler::end_frame(vkb::core::CommandBufferC &command_buffer)
+{
+	if (!current_frame)
+	{
+		return;
+	}
+
+	// Regions left open end with the frame
+	while (!open_regions.empty())
+	{
+		end_region(current_command_buffer, open_regions.back());
+	}
+
+	command_buffer.write_timestamp(VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, *query_pool, current_first_query + frame_end_query);
+
+	current_frame          = nullptr;
+	current_command_buffer = VK_NULL_HANDLE;
+}
+
+uint32_t GpuProfiler::begin_region(VkCommandBuffer command_buffer, const char *name)
+{
+	// Only regions in the frame's command buffer are timed, secondary command buffers may be recorded on other threads
+	if (!current_frame || command_buffer != current_command_buffer)
+	{
+		return ~0u;
+	}
+
+	// Regions nested in a region that is not timed are not timed either, as the depth and the budget only grow
+	if (open_regions.size() >= max_depth || current_frame->query_count + 2 > queries_per_frame)
+	{
+		return ~0u;
+	}
+
+	uint32_t region = static_cast<uint32_t>(current_frame->regions.size());
+	uint32_t parent = open_regions.empty() ? ~0u : open_regions.back();
+	current_frame->regions.push_back({name, static_cast<uint32_t>(open_regions.size()), parent, current_frame->query_count});
+	current_frame->query_count += 2;
+	open_regions.push_back(region);
+
+	vkCmdWriteTimestamp(command_buffer, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, query_pool->get_handle(), current_first_query + current_frame->regions[region].begin_query);
+
+	return region;
+}
+
+void GpuProfiler::end_region(VkCommandBuffer command_buffer, uint32_t region)
+{
+	if (region == ~0u || !current_frame || command_buffer != current_command_buffer)
+	{
+		return;
+	}
+
+	assert(!open_regions.empty() && open_regions.back() == region && "GPU profiler regions must be nested");
+	open_regions.pop_back();
+
+	vkCmdWriteTimestamp(command_buffer, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, query_pool->get_handle(), current_first_query + current_frame->regions[region].begin_query + 1);
+}
+
+void GpuProfiler::read_results(FrameQueries &frame, uint32_t first_query)
+{
+	frame.pending = false;
+
+	// Each result is followed by its availability, so that missing timestamps do not make the read wait
+	std::vector<uint64_t> results(frame.query_count * 2);
+
+	VkResult result = query_pool->get_results(first_query, frame.query_count,
+	                                          results.size() * sizeof(uint64_t), results.data(), 2 * sizeof(uint64_t),
+	                                          VK_QUERY_RESULT_64_BIT | VK_QUERY_RESULT_WITH_AVAILABILITY_BIT);
+	if (result != VK_SUCCESS && result != VK_NOT_READY)
+	{
+		return;
+	}
+
+	auto timestamp = [&results](uint32_t query) { return results[query * 2]; };
+	auto available = [&results](uint32_t query) { return results[query * 2 + 1] != 0; };
+
+	if (!available(frame_begin_query) || !available(frame_end_query))
+	{
+		return;
+	}
+
+	double to_ms      = timestamp_period * 1e-6;
+	auto   frame_time = timestamp(frame_begin_query);
+
+	GpuProfileFrame profile;
+	profile.frame_number = frame.frame_number;
+	profile.gpu_ms       = ticks_between(frame_time, timestamp(frame_end_query)) * to_ms;
+	profile.calibrated   = has_calibration;
+	if (has_calibration)
+	{
+		profile.begin_us = (calibration_ns + ticks_between(calibration_ticks, frame_time) * static_cast<double>(timestamp_period)) * 1e-3;
+	}
+	else
+	{
+		profile.begin_us = std::chrono::duration<double, std::micro>(frame.recorded.time_since_epoch()).count();
+	}
+
+	profile.regions.reserve(frame.regions.size());
+	for (auto &region : frame.regions)
+	{
+		double begin_ms    = 0.0;
+		double duration_ms = 0.0;
+		if (available(region.begin_query) && available(region.begin_query + 1))
+		{
+			begin_ms    = ticks_between(frame_time, timestamp(region.begin_query)) * to_ms;
+			duration_ms = ticks_between(timestamp(region.begin_query), timestamp(region.begin_query + 1)) * to_ms;
+		}
+		profile.regions.push_back({region.name, region.depth, region.parent, begin_ms, duration_ms});
+	}
+
+	history.push_back(std::move(profile));
+	if (history.size() > max_history)
+	{
+		history.pop_front();
+	}
+}
+
+void GpuProfiler::calibrate()
+{
+	last_calibration = std::chrono::steady_clock::now();
+
+	std::array<VkCalibratedTimestampInfoEXT, 2> infos{};
+	infos[0].sType      = VK_STRUCTURE_TYPE_CALIBRATED_TIMESTAMP_INFO_EXT;
+	infos[0].timeDomain = VK_TIME_DOMAIN_DEVICE_EXT;
+	infos[1].sType      = VK_STRUCTURE_TYPE_CALIBRATED_TIMESTAMP_INFO_EXT;
+	infos[1].timeDomain = host_time_domain;
+
+	std::array<uint64_t, 2> timestamps{};
+	uint64_t                max_deviation = 0;
+	if (vkGetCalibratedTimestampsEXT(device.get_handle(), static_cast<uint32_t>(infos.size()), infos.data(), timestamps.data(), &max_deviation) != VK_SUCCESS)
+	{
+		return;
+	}
+
+	has_calibration   = true;
+	calibration_ticks = timestamps[0];
+	calibration_ns    = host_timestamp_to_steady_ns(timestamps[1]);
+}
+
+int64_t GpuProfiler::ticks_between(uint64_t a, uint64_t b) const
+{
+	// Sign extend the difference from the valid bits, so that timestamps before a give negative values
+	uint32_t unused_bits = 64 - timestamp_valid_bits;
+	return static_cast<int64_t>((b - a) << unused_bits) >> unused_bits;
+}
+
+const GpuProfileFrame *GpuProfiler::get_latest_frame() const
+{
+	return history.empty() ? nullptr : &history.back();
+}
+
+const std::deque<GpuProfileFrame> &GpuProfiler::get_history() const
+{
+	return history;
+}
+
+tracing::TraceTrack GpuProfiler::get_trace_track() const
+{
+	tracing::TraceTrack track{"GPU", "Graphics queue", "gpu", 2, 0};
+	for (auto &frame : history)
+	{
+		track.slices.push_back({fmt::format("Frame {}", frame.frame_number), "", frame.begin_us, frame.gpu_ms * 1e3});
+		for (auto &region : frame.regions)
+		{
+			track.slices.push_back({region.name, "", frame.begin_us + region.begin_ms * 1e3, region.duration_ms * 1e3});
+		}
+	}
+	return track;
+}
+
+void GpuProfiler::write_chrome_trace(const std::string &path) const
+{
+	vkb::filesystem::get()->write_file(path, tracing::to_chrome_json({get_trace_track()}));
+	LOGI("Wrote {} GPU frames to {}", history.size(), path);
+}
+}        // namespace vkb
@@ -0,0 +1,224 @@
+/* Copyright (c) 2025, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <chrono>
+#include <deque>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "common/vk_common.h"
+#include "core/util/tracing.hpp"
+
+namespace vkb
+{
+class Device;
+class QueryPool;
+
+namespace core
+{
+template <vkb::BindingType bindingType>
+class CommandBuffer;
+using CommandBufferC = CommandBuffer<vkb::BindingType::C>;
+}        // namespace core
+
+/**
+ * @brief The GPU time of a debug label region
+ */
+struct GpuProfileRegion
+{
+	std::string name;
+
+	/// 0 for regions not nested in another region
+	uint32_t depth;
+
+	/// Index of the enclosing region, or ~0u
+	uint32_t parent;
+
+	/// Start of the region, relative to the start of the frame
+	double begin_ms;
+
+	double duration_ms;
+};
+
+/**
+ * @brief The GPU times of the regions of one frame
+ */
+struct GpuProfileFrame
+{
+	uint64_t frame_number = 0;
+
+	double gpu_ms = 0.0;
+
+	/// Start of the frame on the std::chrono::steady_clock timeline, in microseconds
+	double begin_us = 0.0;
+
+	/// Whether begin_us comes from calibrated timestamps, otherwise it is the time the frame was recorded
+	bool calibrated = false;
+
+	/// Regions in the order they begin
+	std::vector<GpuProfileRegion> regions;
+};
+
+/**
+ * @brief Times the GPU execution of a frame's command buffer and of the ScopedDebugLabel regions recorded in it
+ *
+ * Timestamps are written into a query pool with one range per frame in flight. The results of a frame are read when its
+ * range is reused, after the render context waited for the frame's fence, so reading never waits for the GPU.
+ *
+ * With VK_EXT_calibrated_timestamps the GPU timestamps are placed on the std::chrono::steady_clock timeline, so that
+ * GPU regions line up with CPU events in a trace.
+ */
+class GpuProfiler
+{
+  public:
+	/**
+	 * @param device The device, must support timestamps on its graphics queue
+	 * @param frame_count Number of frames in flight
+	 * @param max_regions Regions timed per frame, regions past that are not timed
+	 * @param max_depth Regions nested deeper are not timed, to leave out regions such as one per draw
+	 */
+	GpuProfiler(Device &device, uint32_t frame_count, uint32_t max_regions = 256, uint32_t max_depth = 4);
+
+	~GpuProfiler();
+
+	GpuProfiler(const GpuProfiler &)            = delete;
+	GpuProfiler &operator=(const GpuProfiler &) = delete;
+
+	/**
+	 * @return Whether the graphics queue of the device supports timestamps
+	 */
+	static bool is_supported(const Device &device);
+
+	/**
+	 * @brief Sets the profiler that times ScopedDebugLabel regions, nullptr to stop timing them
+	 */
+	static void set_active(GpuProfiler *profiler);
+
+	static GpuProfiler *get_active();
+
+	/**
+	 * @brief Reads the results of the previous use of the frame's queries, and starts timing the command buffer
+	 * @param command_buffer The frame's command buffer, in the recording state outside of a render pass
+	 * @param frame_index Index of the frame in flight
+	 */
+	void begin_frame(vkb::core::CommandBufferC &command_buffer, uint32_t frame_index);
+
+	/**
+	 * @brief Stops timing the frame's command buffer, before it is ended
+	 */
+	void end_frame(vkb::core::CommandBufferC &command_buffer);
+
+	/**
+	 * @brief Writes the timestamp starting a region, if the command buffer is the frame's
+	 * @return Identifier of the region to pass to end_region, ~0u if the region is not timed
+	 */
+	uint32_t begin_region(VkCommandBuffer command_buffer, const char *name);
+
+	void end_region(VkCommandBuffer command_buffer, uint32_t region);
+
+	/**
+	 * @return The latest frame with results, nullptr before the first one is read
+	 */
+	const GpuProfileFrame *get_latest_frame() const;
+
+	/**
+	 * @return The latest frames with results, oldest first
+	 */
+	const std::deque<GpuProfileFrame> &get_history() const;
+
+	/**
+	 * @return The frames of the history as a trace track, to merge with the CPU tracks of vkb::tracing::capture
+	 */
+	tracing::TraceTrack get_trace_track() const;
+
+	/**
+	 * @brief Writes the frames of the history to a Chrome trace JSON file, which Perfetto and chrome://tracing open
+	 */
+	void write_chrome_trace(const std::string &path) const;
+
+  private:
+	struct RegionQueries
+	{
+		std::string name;
+		uint32_t    depth;
+		uint32_t    parent;
+		uint32_t    begin_query;
+	};
+
+	struct FrameQueries
+	{
+		uint64_t frame_number = 0;
+
+		bool pending = false;
+
+		uint32_t query_count = 0;
+
+		std::vector<RegionQueries> regions;
+
+		std::chrono::steady_clock::time_point recorded;
+	};
+
+	void read_results(FrameQueries &frame, uint32_t first_query);
+
+	void calibrate();
+
+	/**
+	 * @return Ticks from a to b, for timestamps with timestamp_valid_bits valid bits
+	 */
+	int64_t ticks_between(uint64_t a, uint64_t b) const;
+
+	Device &device;
+
+	std::unique_ptr<QueryPool> query_pool;
+
+	uint32_t queries_per_frame;
+
+	uint32_t max_depth;
+
+	float timestamp_period;
+
+	uint32_t timestamp_valid_bits;
+
+	std::vector<FrameQueries> frames;
+
+	FrameQueries *current_frame = nullptr;
+
+	uint32_t current_first_query = 0;
+
+	VkCommandBuffer current_command_buffer = VK_NULL_HANDLE;
+
+	// Indices of the timed regions that have begun but not ended
+	std::vector<uint32_t> open_regions;
+
+	uint64_t frame_number = 0;
+
+	VkTimeDomainEXT host_time_domain = VK_TIME_DOMAIN_DEVICE_EXT;
+
+	bool has_calibration = false;
+
+	// A GPU timestamp and the steady clock time in nanoseconds at which it was taken
+	uint64_t calibration_ticks = 0;
+	int64_t  calibration_ns    = 0;
+
+	std::chrono::steady_clock::time_point last_calibration;
+
+	std::deque<GpuProfileFrame> history;
+};
+}        // namespace vkb
@@ -0,0 +1,90 @@
+/* Copyright (c) 2025, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "gpu_profiler_stats_provider.h"
+
+#include "common/helpers.h"
+#include "core/command_buffer.h"
+#include "rendering/render_context.h"
+#include "stats/gpu_profiler.h"
+
+namespace vkb
+{
+GpuProfilerStatsProvider::GpuProfilerStatsProvider(std::set<StatIndex> &requested_stats, RenderContext &render_context) :
+    render_context{render_context}
+{
+	if (requested_stats.count(StatIndex::gpu_time) == 0 || !GpuProfiler::is_supported(render_context.get_device()))
+	{
+		return;
+	}
+
+	profiler = std::make_unique<GpuProfiler>(render_context.get_device(), to_u32(render_context.get_render_frames().size()));
+	GpuProfiler::set_active(profiler.get());
+
+	requested_stats.erase(StatIndex::gpu_time);
+}
+
+GpuProfilerStatsProvider::~GpuProfilerStatsProvider()
+{
+	if (GpuProfiler::get_active() == profiler.get())
+	{
+		GpuProfiler::set_active(nullptr);
+	}
+}
+
+bool GpuProfilerStatsProvider::is_available(StatIndex index) const
+{
+	return profiler && index == StatIndex::gpu_time;
+}
+
+StatsProvider::Counters GpuProfilerStatsProvider::sample(float /*delta_time*/)
+{
+	Counters res;
+
+	// Results arrive a few frames late, once the queries of a frame are reused, so only report frames not sampled yet
+	const GpuProfileFrame *frame = profiler ? profiler->get_latest_frame() : nullptr;
+	if (frame && frame->frame_number + 1 > sampled_frames)
+	{
+		sampled_frames = frame->frame_number + 1;
+
+		res[StatIndex::gpu_time].result = frame->gpu_ms / 1000.0;
+	}
+
+	return res;
+}
+
+void GpuProfilerStatsProvider::begin_sampling(vkb::core::CommandBufferC &cb)
+{
+	if (profiler)
+	{
+		profiler->begin_frame(cb, render_context.get_active_frame_index());
+	}
+}
+
+void GpuProfilerStatsProvider::end_sampling(vkb::core::CommandBufferC &cb)
+{
+	if (profiler)
+	{
+		profiler->end_frame(cb);
+	}
+}
+
+GpuProfiler *GpuProfilerStatsProvider::get_profiler() const
+{
+	return profiler.get();
+}
+}        // namespace vkb
@@ -0,0 +1,74 @@
+/* Copyright (c) 2025, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "stats_provider.h"
+#include <memory>
+#include <set>
+
+namespace vkb
+{
+class GpuProfiler;
+class RenderContext;
+
+/**
+ * @brief Provides the GPU time of each frame, measured by a GpuProfiler that also times the ScopedDebugLabel regions
+ */
+class GpuProfilerStatsProvider : public StatsProvider
+{
+  public:
+	/**
+	 * @brief Constructs a GpuProfilerStatsProvider
+	 * @param requested_stats Set of stats to be collected. Supported stats will be removed from the set.
+	 * @param render_context The render context of the frames to time
+	 */
+	GpuProfilerStatsProvider(std::set<StatIndex> &requested_stats, RenderContext &render_context);
+
+	~GpuProfilerStatsProvider() override;
+
+	/**
+	 * @brief Checks if this provider can supply the given enabled stat
+	 * @param index The stat index
+	 * @return True if the stat is available, false otherwise
+	 */
+	bool is_available(StatIndex index) const override;
+
+	/**
+	 * @brief Retrieve a new sample set
+	 * @param delta_time Time since last sample
+	 */
+	Counters sample(float delta_time) override;
+
+	void begin_sampling(vkb::core::CommandBufferC &cb) override;
+
+	void end_sampling(vkb::core::CommandBufferC &cb) override;
+
+	/**
+	 * @return The profiler, nullptr if GPU times are not requested or not supported
+	 */
+	GpuProfiler *get_profiler() const;
+
+  private:
+	RenderContext &render_context;
+
+	std::unique_ptr<GpuProfiler> profiler;
+
+	// Frame number of the last sampled frame, so that a frame is only sampled once
+	uint64_t sampled_frames = 0;
+};
+}        // namespace vkb
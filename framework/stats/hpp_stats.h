@@ -35,10 +35,12 @@ class HPPStats : private vkb::Stats
   public:
 	using vkb::Stats::get_data;
 	using vkb::Stats::get_graph_data;
+	using vkb::Stats::get_registered_counters;
 	using vkb::Stats::get_requested_stats;
 	using vkb::Stats::is_available;
 	using vkb::Stats::request_stats;
 	using vkb::Stats::resize;
+	using vkb::Stats::show_registered_counters;
 	using vkb::Stats::update;
 
 	explicit HPPStats(vkb::rendering::HPPRenderContext &render_context, size_t buffer_size = 16) :
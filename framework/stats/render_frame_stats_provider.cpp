@@ -0,0 +1,51 @@
+/* Copyright (c) 2025, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "render_frame_stats_provider.h"
+
+#include "common/helpers.h"
+#include "rendering/render_context.h"
+
+namespace vkb
+{
+RenderFrameStatsProvider::RenderFrameStatsProvider(std::set<StatIndex> &requested_stats, RenderContext &render_context) :
+    render_context{render_context}
+{
+	requested_stats.erase(StatIndex::descriptor_request_time);
+}
+
+bool RenderFrameStatsProvider::is_available(StatIndex index) const
+{
+	return index == StatIndex::descriptor_request_time;
+}
+
+StatsProvider::Counters RenderFrameStatsProvider::sample(float /*delta_time*/)
+{
+	Counters res;
+
+	// Stats are sampled once the next frame has begun and its timings were reset, so read the frame submitted before it
+	auto &frames = render_context.get_render_frames();
+	if (!frames.empty())
+	{
+		uint32_t previous_index = (render_context.get_active_frame_index() + to_u32(frames.size()) - 1) % to_u32(frames.size());
+
+		res[StatIndex::descriptor_request_time].result = frames[previous_index]->get_descriptor_request_time().count();
+	}
+
+	return res;
+}
+}        // namespace vkb
@@ -24,6 +24,8 @@
 
 #include "core/device.h"
 #include "frame_time_stats_provider.h"
+#include "gpu_profiler_stats_provider.h"
+#include "render_frame_stats_provider.h"
 #ifdef VK_USE_PLATFORM_ANDROID_KHR
 #	include "hwcpipe_stats_provider.h"
 #endif
@@ -71,6 +73,8 @@ void Stats::request_stats(const std::set<StatIndex> &wanted_stats,
 	// All supported stats will be removed from the given 'stats' set by the provider's constructor
 	// so subsequent providers only see requests for stats that aren't already supported.
 	providers.emplace_back(std::make_unique<FrameTimeStatsProvider>(stats));
+	providers.emplace_back(std::make_unique<RenderFrameStatsProvider>(stats, render_context));
+	providers.emplace_back(std::make_unique<GpuProfilerStatsProvider>(stats, render_context));
 #ifdef VK_USE_PLATFORM_ANDROID_KHR
 	providers.emplace_back(std::make_unique<HWCPipeStatsProvider>(stats));
 #endif
@@ -148,6 +152,13 @@ static void add_smoothed_value(std::vector<float> &values, float value, float al
 
 void Stats::update(float delta_time)
 {
+	PROFILE_SCOPE("Update stats");
+
+	if (show_counters)
+	{
+		sample_registered_counters(delta_time);
+	}
+
 	switch (sampling_config.mode)
 	{
 		case CounterSamplingMode::Polling:
@@ -231,8 +242,44 @@ void Stats::update(float delta_time)
 	profile_counters();
 }
 
+void Stats::show_registered_counters(bool show)
+{
+	show_counters = show;
+	registered_counters.clear();
+	previous_counters.clear();
+	counter_sample_time = 0.0f;
+}
+
+void Stats::sample_registered_counters(float delta_time)
+{
+	counter_sample_time += delta_time;
+	if (counter_sample_time < 0.5f && !registered_counters.empty())
+	{
+		return;
+	}
+
+	std::vector<CounterValue> values;
+	CounterRegistry::get().snapshot(values);
+
+	registered_counters = values;
+	for (size_t i = 0; i < values.size(); ++i)
+	{
+		// Counters registered since the previous sample have no rate yet
+		if (!values[i].is_gauge)
+		{
+			bool has_previous            = i < previous_counters.size() && counter_sample_time > 0.0f;
+			registered_counters[i].value = has_previous ? (values[i].value - previous_counters[i].value) / counter_sample_time : 0.0;
+		}
+	}
+
+	previous_counters   = std::move(values);
+	counter_sample_time = 0.0f;
+}
+
 void Stats::continuous_sampling_worker(std::future<void> should_terminate)
 {
+	vkb::tracing::set_thread_name("Stats worker");
+
 	worker_timer.tick();
 
 	for (auto &p : providers)
@@ -253,6 +300,8 @@ void Stats::continuous_sampling_worker(std::future<void> should_terminate)
 		}
 
 		// Sample counters
+		PROFILE_SCOPE("Sample counters");
+
 		StatsProvider::Counters sample;
 		for (auto &p : providers)
 		{
@@ -300,6 +349,10 @@ const char *to_string(StatIndex index)
 	{
 		case StatIndex::frame_times:
 			return "Frame Times (ms)";
+		case StatIndex::descriptor_request_time:
+			return "Descriptor Requests (ms)";
+		case StatIndex::gpu_time:
+			return "GPU Time (ms)";
 		case StatIndex::cpu_cycles:
 			return "CPU Cycles (M/s)";
 		case StatIndex::cpu_instructions:
@@ -427,6 +480,8 @@ void Stats::profile_counters() const
 	{
 		Plot<float, PlotType::Memory>::plot(labels[heap].c_str(), heap_budgets[heap].usage / (1024.0f * 1024.0f));
 	}
+
+	CounterRegistry::get().plot_to_tracy();
 #endif
 }
 
@@ -25,6 +25,8 @@
 #include <set>
 #include <vector>
 
+#include <core/util/counters.hpp>
+
 #include "stats_common.h"
 #include "stats_provider.h"
 #include "timer.h"
@@ -105,6 +107,19 @@ class Stats
 		return requested_stats;
 	}
 
+	/**
+	 * @brief Shows the counters of the vkb::CounterRegistry below the graphs of the stats overlay
+	 */
+	void show_registered_counters(bool show);
+
+	/**
+	 * @return The counters shown in the stats overlay, with the counters that are added to as rates per second
+	 */
+	const std::vector<CounterValue> &get_registered_counters() const
+	{
+		return registered_counters;
+	}
+
 	/**
 	 * @brief Update statistics, must be called after every frame
 	 * @param delta_time Time since last update
@@ -191,6 +206,16 @@ class Stats
 	/// A value which helps keep a steady pace of continuous samples output.
 	float fractional_pending_samples{0.0f};
 
+	/// Whether the counters of the registry are sampled for the overlay
+	bool show_counters{false};
+
+	/// Counters of the registry as shown in the overlay, and their values at the previous sample
+	std::vector<CounterValue> registered_counters;
+	std::vector<CounterValue> previous_counters;
+
+	/// Time since the counters were last sampled
+	float counter_sample_time{0.0f};
+
 	/// The worker thread function for continuous sampling;
 	/// it adds a new entry to continuous_samples at every interval
 	void continuous_sampling_worker(std::future<void> should_terminate);
@@ -200,6 +225,9 @@ class Stats
 
 	// Push counters to external profilers
 	void profile_counters() const;
+
+	/// Samples the counters of the registry for the overlay, a few times per second so that rates are readable
+	void sample_registered_counters(float delta_time);
 };
 
 }        // namespace vkb
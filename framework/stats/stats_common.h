@@ -33,6 +33,8 @@ namespace vkb
 enum class StatIndex
 {
 	frame_times,
+	descriptor_request_time,
+	gpu_time,
 	cpu_cycles,
 	cpu_instructions,
 	cpu_cache_miss_ratio,
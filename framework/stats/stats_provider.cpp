@@ -24,6 +24,8 @@ std::map<StatIndex, StatGraphData> StatsProvider::default_graph_map{
     // clang-format off
     // StatIndex                        Name shown in graph                            Format           Scale                         Fixed_max Max_value
     {StatIndex::frame_times,           {"Frame Times",                                 "{:3.1f} ms",    1000.0f}},
+    {StatIndex::descriptor_request_time, {"Descriptor Requests",                       "{:3.2f} ms",    1000.0f}},
+    {StatIndex::gpu_time,              {"GPU Time",                                    "{:3.1f} ms",    1000.0f}},
     {StatIndex::cpu_cycles,            {"CPU Cycles",                                  "{:4.1f} M/s",   static_cast<float>(1e-6)}},
     {StatIndex::cpu_instructions,      {"CPU Instructions",                            "{:4.1f} M/s",   static_cast<float>(1e-6)}},
     {StatIndex::cpu_cache_miss_ratio,  {"Cache Miss Ratio",                            "{:3.1f}%",      100.0f,                       true,     100.0f}},
@@ -0,0 +1,153 @@
+/* Copyright (c) 2025, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "terrain/clipmap.h"
+
+#include <cmath>
+
+#include "common/error.h"
+
+namespace vkb
+{
+Clipmap::Clipmap(uint32_t resolution, uint32_t level_count, float base_spacing) :
+    resolution{resolution}
+{
+	if (resolution < 4 || resolution % 4 != 0 || level_count == 0 || base_spacing <= 0.0f)
+	{
+		throw std::runtime_error("Clipmap resolution must be a non-zero multiple of 4 with at least one level");
+	}
+
+	const uint32_t vertices_per_side = resolution + 1;
+	vertices.reserve(vertices_per_side * vertices_per_side);
+	for (uint32_t y = 0; y < vertices_per_side; ++y)
+	{
+		for (uint32_t x = 0; x < vertices_per_side; ++x)
+		{
+			vertices.emplace_back(static_cast<float>(x), static_cast<float>(y));
+		}
+	}
+
+	// All levels but the finest one skip the cells covered by the finer level
+	const uint32_t full_index_count = resolution * resolution * 6;
+	const uint32_t hole_cell_count  = (resolution / 2) * (resolution / 2);
+	const uint32_t ring_index_count = full_index_count - hole_cell_count * 6;
+	uint32_t       first_index      = 0;
+
+	levels.resize(level_count);
+	for (uint32_t level = 0; level < level_count; ++level)
+	{
+		levels[level].level       = level;
+		levels[level].spacing     = base_spacing * static_cast<float>(1u << level);
+		levels[level].origin      = glm::vec2(0.0f);
+		levels[level].first_index = first_index;
+		levels[level].index_count = level == 0 ? full_index_count : ring_index_count;
+		first_index += levels[level].index_count;
+	}
+
+	indices.resize(first_index);
+	hole_offsets.resize(level_count, glm::ivec2(-1));
+}
+
+bool Clipmap::update(const glm::vec2 &camera_position)
+{
+	const int32_t quarter = static_cast<int32_t>(resolution / 4);
+
+	bool changed = false;
+
+	for (auto &level : levels)
+	{
+		// Snapping to twice the spacing keeps the finer level on even vertices of this one
+		glm::vec2 snap_cell = glm::floor(camera_position / (2.0f * level.spacing));
+		glm::vec2 cell      = glm::floor(camera_position / level.spacing);
+		level.origin        = (snap_cell * 2.0f - glm::vec2(static_cast<float>(resolution / 2))) * level.spacing;
+
+		if (level.level == 0)
+		{
+			continue;
+		}
+
+		// The finer level starts either n/4 or n/4 + 1 cells into this one, depending on the camera cell parity
+		glm::ivec2 hole_offset = glm::ivec2(cell - snap_cell * 2.0f) + glm::ivec2(quarter);
+
+		if (!initialized || hole_offset != hole_offsets[level.level])
+		{
+			build_level_indices(level.level, hole_offset);
+			hole_offsets[level.level] = hole_offset;
+			changed                   = true;
+		}
+	}
+
+	if (!initialized)
+	{
+		build_level_indices(0, glm::ivec2(-1));
+		initialized = true;
+		changed     = true;
+	}
+
+	return changed;
+}
+
+void Clipmap::build_level_indices(uint32_t level, const glm::ivec2 &hole_offset)
+{
+	const uint32_t      vertices_per_side = resolution + 1;
+	const glm::ivec2    hole_end          = hole_offset + glm::ivec2(static_cast<int32_t>(resolution / 2));
+	const ClipmapLevel &clipmap_level     = levels[level];
+
+	uint32_t *index = indices.data() + clipmap_level.first_index;
+	for (int32_t y = 0; y < static_cast<int32_t>(resolution); ++y)
+	{
+		for (int32_t x = 0; x < static_cast<int32_t>(resolution); ++x)
+		{
+			if (x >= hole_offset.x && x < hole_end.x && y >= hole_offset.y && y < hole_end.y)
+			{
+				continue;
+			}
+
+			uint32_t top_left = x + y * vertices_per_side;
+			index[0]          = top_left;
+			index[1]          = top_left + vertices_per_side;
+			index[2]          = top_left + 1;
+			index[3]          = top_left + 1;
+			index[4]          = top_left + vertices_per_side;
+			index[5]          = top_left + vertices_per_side + 1;
+			index += 6;
+		}
+	}
+
+	assert(index == indices.data() + clipmap_level.first_index + clipmap_level.index_count);
+}
+
+const std::vector<ClipmapLevel> &Clipmap::get_levels() const
+{
+	return levels;
+}
+
+const std::vector<glm::vec2> &Clipmap::get_vertices() const
+{
+	return vertices;
+}
+
+const std::vector<uint32_t> &Clipmap::get_indices() const
+{
+	return indices;
+}
+
+uint32_t Clipmap::get_resolution() const
+{
+	return resolution;
+}
+}        // namespace vkb
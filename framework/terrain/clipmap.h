@@ -0,0 +1,102 @@
+/* Copyright (c) 2025, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <vector>
+
+#include "common/glm_common.h"
+
+namespace vkb
+{
+/**
+ * @brief Placement of a single clipmap level and its range within the shared index list
+ */
+struct ClipmapLevel
+{
+	/// World space xz position of grid vertex (0, 0)
+	glm::vec2 origin;
+
+	/// World space distance between two neighbouring vertices
+	float spacing;
+
+	uint32_t level;
+
+	uint32_t first_index;
+
+	uint32_t index_count;
+};
+
+/**
+ * @brief Geometry clipmap made of nested square grids centered around the camera
+ *
+ * Every level uses the same (resolution + 1)^2 vertex grid, scaled by twice the spacing of the
+ * previous level. A level skips the cells covered by the next finer level, so the rings do not
+ * overlap. Level origins snap to twice their spacing, which keeps vertices fixed in world space
+ * while the camera moves and only requires new indices for the levels that moved.
+ *
+ * World space positions are origin + vertex * spacing, heights are expected to be sampled in the
+ * vertex shader.
+ */
+class Clipmap
+{
+  public:
+	/**
+	 * @param resolution Number of cells along each side of a level, must be a multiple of 4
+	 * @param level_count Number of levels
+	 * @param base_spacing Distance between vertices of the finest level
+	 */
+	Clipmap(uint32_t resolution = 64, uint32_t level_count = 6, float base_spacing = 1.0f);
+
+	/**
+	 * @brief Recenters the levels around the camera
+	 * @param camera_position World space xz position of the camera
+	 * @return True if the index list changed and needs to be uploaded again
+	 */
+	bool update(const glm::vec2 &camera_position);
+
+	const std::vector<ClipmapLevel> &get_levels() const;
+
+	/**
+	 * @return Grid vertex coordinates shared by all levels
+	 */
+	const std::vector<glm::vec2> &get_vertices() const;
+
+	/**
+	 * @return Triangle list indices of all levels
+	 */
+	const std::vector<uint32_t> &get_indices() const;
+
+	uint32_t get_resolution() const;
+
+  private:
+	void build_level_indices(uint32_t level, const glm::ivec2 &hole_offset);
+
+	uint32_t resolution;
+
+	std::vector<ClipmapLevel> levels;
+
+	/// Offset of the finer level footprint in cells of each level, used to detect which levels changed
+	std::vector<glm::ivec2> hole_offsets;
+
+	std::vector<glm::vec2> vertices;
+
+	std::vector<uint32_t> indices;
+
+	bool initialized{false};
+};
+}        // namespace vkb
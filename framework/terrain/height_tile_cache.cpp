@@ -0,0 +1,309 @@
+/* Copyright (c) 2025, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "terrain/height_tile_cache.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+
+#include <ctpl_stl.h>
+#include <ktx.h>
+
+#include "common/error.h"
+#include "core/util/logging.hpp"
+#include "filesystem/legacy.h"
+
+namespace vkb
+{
+namespace
+{
+void replace_all(std::string &str, const std::string &from, const std::string &to)
+{
+	for (size_t pos = str.find(from); pos != std::string::npos; pos = str.find(from, pos + to.size()))
+	{
+		str.replace(pos, from.size(), to);
+	}
+}
+
+int32_t floor_div(int32_t value, int32_t divisor)
+{
+	return (value >= 0 ? value : value - divisor + 1) / divisor;
+}
+}        // namespace
+
+HeightTileCache::HeightTileCache(uint32_t tile_size, size_t max_resident_tiles, TileLoader &&loader, size_t thread_count) :
+    tile_size{tile_size},
+    max_resident_tiles{max_resident_tiles},
+    max_pending_tiles{std::max<size_t>(1, thread_count) * 2},
+    loader{std::move(loader)},
+    thread_pool{std::make_unique<ctpl::thread_pool>(static_cast<int>(std::max<size_t>(1, thread_count)))}
+{
+	if (tile_size == 0 || max_resident_tiles == 0)
+	{
+		throw std::runtime_error("HeightTileCache needs a non-zero tile size and tile budget");
+	}
+}
+
+HeightTileCache::~HeightTileCache()
+{
+	wait_idle();
+}
+
+uint64_t HeightTileCache::make_key(int32_t tile_x, int32_t tile_y)
+{
+	return (static_cast<uint64_t>(static_cast<uint32_t>(tile_x)) << 32) | static_cast<uint32_t>(tile_y);
+}
+
+glm::ivec2 HeightTileCache::get_coords(uint64_t key)
+{
+	return {static_cast<int32_t>(static_cast<uint32_t>(key >> 32)), static_cast<int32_t>(static_cast<uint32_t>(key))};
+}
+
+bool HeightTileCache::update(const glm::vec2 &center, float radius)
+{
+	++update_count;
+
+	bool changed = collect_finished_tiles();
+
+	const float size = static_cast<float>(tile_size);
+	glm::ivec2  min_tile{static_cast<int32_t>(std::floor((center.x - radius) / size)), static_cast<int32_t>(std::floor((center.y - radius) / size))};
+	glm::ivec2  max_tile{static_cast<int32_t>(std::floor((center.x + radius) / size)), static_cast<int32_t>(std::floor((center.y + radius) / size))};
+
+	// Mark the resident tiles in range as used and gather the missing ones
+	std::vector<std::pair<float, glm::ivec2>> missing_tiles;
+	for (int32_t tile_y = min_tile.y; tile_y <= max_tile.y; ++tile_y)
+	{
+		for (int32_t tile_x = min_tile.x; tile_x <= max_tile.x; ++tile_x)
+		{
+			uint64_t key = make_key(tile_x, tile_y);
+
+			auto it = tiles.find(key);
+			if (it != tiles.end())
+			{
+				it->second.last_used = update_count;
+			}
+			else if (pending_tiles.find(key) == pending_tiles.end() && failed_tiles.find(key) == failed_tiles.end())
+			{
+				glm::vec2 tile_center = (glm::vec2(tile_x, tile_y) + 0.5f) * size;
+				missing_tiles.emplace_back(glm::distance(tile_center, center), glm::ivec2(tile_x, tile_y));
+			}
+		}
+	}
+
+	changed |= evict_tiles(min_tile, max_tile);
+
+	// Request the closest tiles first, without exceeding the number of loads in flight or the tile budget
+	std::sort(missing_tiles.begin(), missing_tiles.end(), [](const auto &a, const auto &b) { return a.first < b.first; });
+
+	for (const auto &missing_tile : missing_tiles)
+	{
+		if (pending_tiles.size() >= max_pending_tiles || tiles.size() + pending_tiles.size() >= max_resident_tiles)
+		{
+			break;
+		}
+
+		glm::ivec2 coords = missing_tile.second;
+		pending_tiles.emplace(make_key(coords.x, coords.y),
+		                      thread_pool->push([this, coords](size_t) { return loader(coords.x, coords.y); }));
+	}
+
+	return changed;
+}
+
+void HeightTileCache::wait_idle()
+{
+	for (auto &pending_tile : pending_tiles)
+	{
+		pending_tile.second.wait();
+	}
+	collect_finished_tiles();
+}
+
+bool HeightTileCache::collect_finished_tiles()
+{
+	bool changed = false;
+
+	for (auto it = pending_tiles.begin(); it != pending_tiles.end();)
+	{
+		if (it->second.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+		{
+			++it;
+			continue;
+		}
+
+		glm::ivec2 coords = get_coords(it->first);
+		try
+		{
+			std::vector<uint16_t> heights = it->second.get();
+			if (heights.size() != static_cast<size_t>(tile_size) * tile_size)
+			{
+				throw std::runtime_error("Tile has " + std::to_string(heights.size()) + " samples, expected " + std::to_string(tile_size * tile_size));
+			}
+
+			tiles[it->first] = Tile{std::move(heights), update_count};
+			changed          = true;
+		}
+		catch (const std::exception &e)
+		{
+			LOGE("Failed to load height tile ({}, {}): {}", coords.x, coords.y, e.what());
+			failed_tiles.insert(it->first);
+		}
+
+		it = pending_tiles.erase(it);
+	}
+
+	return changed;
+}
+
+bool HeightTileCache::evict_tiles(const glm::ivec2 &min_tile, const glm::ivec2 &max_tile)
+{
+	// Keep room for the loads in flight and one more request, so streaming can progress
+	size_t budget = max_resident_tiles > pending_tiles.size() + 1 ? max_resident_tiles - pending_tiles.size() - 1 : 0;
+	if (tiles.size() <= budget)
+	{
+		return false;
+	}
+
+	std::vector<std::pair<uint64_t, uint64_t>> candidates;
+	for (const auto &tile : tiles)
+	{
+		glm::ivec2 coords = get_coords(tile.first);
+		bool       in_range =
+		    coords.x >= min_tile.x && coords.x <= max_tile.x && coords.y >= min_tile.y && coords.y <= max_tile.y;
+		if (!in_range)
+		{
+			candidates.emplace_back(tile.second.last_used, tile.first);
+		}
+	}
+
+	size_t evict_count = std::min(candidates.size(), tiles.size() - budget);
+	std::partial_sort(candidates.begin(), candidates.begin() + evict_count, candidates.end());
+
+	for (size_t i = 0; i < evict_count; ++i)
+	{
+		tiles.erase(candidates[i].second);
+	}
+
+	return evict_count > 0;
+}
+
+bool HeightTileCache::is_resident(int32_t tile_x, int32_t tile_y) const
+{
+	return tiles.find(make_key(tile_x, tile_y)) != tiles.end();
+}
+
+bool HeightTileCache::get_height(int32_t x, int32_t y, float &height) const
+{
+	const int32_t size   = static_cast<int32_t>(tile_size);
+	int32_t       tile_x = floor_div(x, size);
+	int32_t       tile_y = floor_div(y, size);
+
+	auto it = tiles.find(make_key(tile_x, tile_y));
+	if (it == tiles.end())
+	{
+		return false;
+	}
+
+	uint32_t local_x = static_cast<uint32_t>(x - tile_x * size);
+	uint32_t local_y = static_cast<uint32_t>(y - tile_y * size);
+	height           = it->second.heights[local_x + local_y * tile_size] / 65535.0f;
+	return true;
+}
+
+void HeightTileCache::sample_region(int32_t x, int32_t y, uint32_t width, uint32_t depth, std::vector<float> &heights, float fallback) const
+{
+	heights.assign(static_cast<size_t>(width) * depth, fallback);
+
+	const int32_t size = static_cast<int32_t>(tile_size);
+
+	// Copy row spans tile by tile instead of looking up the tile of every sample
+	for (uint32_t row = 0; row < depth; ++row)
+	{
+		int32_t sample_y = y + static_cast<int32_t>(row);
+		int32_t tile_y   = floor_div(sample_y, size);
+		int32_t local_y  = sample_y - tile_y * size;
+
+		for (uint32_t column = 0; column < width;)
+		{
+			int32_t  sample_x = x + static_cast<int32_t>(column);
+			int32_t  tile_x   = floor_div(sample_x, size);
+			int32_t  local_x  = sample_x - tile_x * size;
+			uint32_t span     = std::min(width - column, static_cast<uint32_t>(size - local_x));
+
+			auto it = tiles.find(make_key(tile_x, tile_y));
+			if (it != tiles.end())
+			{
+				const uint16_t *source      = it->second.heights.data() + local_x + local_y * size;
+				float          *destination = heights.data() + column + static_cast<size_t>(row) * width;
+				for (uint32_t i = 0; i < span; ++i)
+				{
+					destination[i] = source[i] / 65535.0f;
+				}
+			}
+
+			column += span;
+		}
+	}
+}
+
+uint32_t HeightTileCache::get_tile_size() const
+{
+	return tile_size;
+}
+
+size_t HeightTileCache::get_resident_count() const
+{
+	return tiles.size();
+}
+
+size_t HeightTileCache::get_pending_count() const
+{
+	return pending_tiles.size();
+}
+
+size_t HeightTileCache::get_resident_bytes() const
+{
+	return tiles.size() * tile_size * tile_size * sizeof(uint16_t);
+}
+
+HeightTileCache::TileLoader HeightTileCache::create_ktx_tile_loader(const std::string &path_format)
+{
+	// Resolved up front, so the worker threads do not touch the file system helpers
+	std::string asset_path = fs::path::get(fs::path::Assets);
+
+	return [asset_path, path_format](int32_t tile_x, int32_t tile_y) {
+		std::string file_path = path_format;
+		replace_all(file_path, "{x}", std::to_string(tile_x));
+		replace_all(file_path, "{y}", std::to_string(tile_y));
+		file_path = asset_path + file_path;
+
+		ktxTexture *ktx_texture;
+		if (ktxTexture_CreateFromNamedFile(file_path.c_str(), KTX_TEXTURE_CREATE_LOAD_IMAGE_DATA_BIT, &ktx_texture) != KTX_SUCCESS)
+		{
+			throw std::runtime_error("Could not load " + file_path);
+		}
+
+		ktx_size_t            ktx_size = ktxTexture_GetImageSize(ktx_texture, 0);
+		std::vector<uint16_t> heights(ktx_texture->baseWidth * ktx_texture->baseHeight);
+		std::memcpy(heights.data(), ktxTexture_GetData(ktx_texture), std::min<size_t>(ktx_size, heights.size() * sizeof(uint16_t)));
+
+		ktxTexture_Destroy(ktx_texture);
+		return heights;
+	};
+}
+}        // namespace vkb
@@ -0,0 +1,148 @@
+/* Copyright (c) 2025, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <functional>
+#include <future>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "common/glm_common.h"
+
+namespace ctpl
+{
+class thread_pool;
+}
+
+namespace vkb
+{
+/**
+ * @brief Streams square tiles of a heightmap in and out of memory around a point of interest
+ *
+ * Tiles are addressed by integer tile coordinates and loaded on worker threads through a user
+ * provided loader, so a terrain can be far larger than what fits in memory. The cache keeps at most
+ * max_resident_tiles tiles, evicting the least recently used ones outside of the requested region.
+ *
+ * All member functions are expected to be called from the same thread, only the loader runs on the
+ * worker threads and must therefore be thread safe.
+ */
+class HeightTileCache
+{
+  public:
+	/**
+	 * @brief Returns the row-major tile_size x tile_size heights of a tile
+	 */
+	using TileLoader = std::function<std::vector<uint16_t>(int32_t tile_x, int32_t tile_y)>;
+
+	/**
+	 * @param tile_size Number of height samples along each side of a tile
+	 * @param max_resident_tiles Upper bound of tiles kept in memory, including the ones being loaded
+	 * @param loader Function loading a single tile
+	 * @param thread_count Number of loader threads
+	 */
+	HeightTileCache(uint32_t tile_size, size_t max_resident_tiles, TileLoader &&loader, size_t thread_count = 2);
+
+	HeightTileCache(const HeightTileCache &)            = delete;
+	HeightTileCache(HeightTileCache &&)                 = delete;
+	~HeightTileCache();
+	HeightTileCache &operator=(const HeightTileCache &) = delete;
+	HeightTileCache &operator=(HeightTileCache &&)      = delete;
+
+	/**
+	 * @brief Collects finished loads, requests the missing tiles closest to center and evicts unused tiles
+	 * @param center Point of interest in height samples
+	 * @param radius Radius around center in height samples that should be resident
+	 * @return True if a tile became resident or got evicted
+	 */
+	bool update(const glm::vec2 &center, float radius);
+
+	/**
+	 * @brief Blocks until all requested tiles finished loading
+	 */
+	void wait_idle();
+
+	bool is_resident(int32_t tile_x, int32_t tile_y) const;
+
+	/**
+	 * @brief Retrieves the normalized height of a sample
+	 * @param x The x coordinate in height samples
+	 * @param y The y coordinate in height samples
+	 * @param height Output height in the range [0, 1]
+	 * @return False if the tile containing the sample is not resident
+	 */
+	bool get_height(int32_t x, int32_t y, float &height) const;
+
+	/**
+	 * @brief Copies a rectangle of normalized heights, for instance to feed compute_sobel_normals
+	 *        Samples of tiles that are not resident are set to fallback
+	 */
+	void sample_region(int32_t x, int32_t y, uint32_t width, uint32_t depth, std::vector<float> &heights, float fallback = 0.0f) const;
+
+	uint32_t get_tile_size() const;
+
+	size_t get_resident_count() const;
+
+	size_t get_pending_count() const;
+
+	size_t get_resident_bytes() const;
+
+	/**
+	 * @brief Creates a loader reading one r16 ktx file per tile
+	 * @param path_format Path relative to the assets folder, where {x} and {y} get replaced by the tile coordinates
+	 */
+	static TileLoader create_ktx_tile_loader(const std::string &path_format);
+
+  private:
+	struct Tile
+	{
+		std::vector<uint16_t> heights;
+
+		uint64_t last_used{0};
+	};
+
+	static uint64_t make_key(int32_t tile_x, int32_t tile_y);
+
+	static glm::ivec2 get_coords(uint64_t key);
+
+	bool collect_finished_tiles();
+
+	bool evict_tiles(const glm::ivec2 &min_tile, const glm::ivec2 &max_tile);
+
+	uint32_t tile_size;
+
+	size_t max_resident_tiles;
+
+	size_t max_pending_tiles;
+
+	TileLoader loader;
+
+	std::unique_ptr<ctpl::thread_pool> thread_pool;
+
+	std::unordered_map<uint64_t, Tile> tiles;
+
+	std::unordered_map<uint64_t, std::future<std::vector<uint16_t>>> pending_tiles;
+
+	/// Tiles that failed to load are not requested again
+	std::unordered_set<uint64_t> failed_tiles;
+
+	uint64_t update_count{0};
+};
+}        // namespace vkb
@@ -0,0 +1,216 @@
+/* Copyright (c) 2025, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "terrain/sobel_normals.h"
+
+#include <algorithm>
+#include <cmath>
+#include <thread>
+
+#include "common/error.h"
+#include "common/parallel.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#	include <emmintrin.h>
+#	define VKB_SOBEL_SSE2
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#	include <arm_neon.h>
+#	define VKB_SOBEL_NEON
+#endif
+
+namespace vkb
+{
+namespace
+{
+// Rows below this count are not worth distributing across threads
+constexpr uint32_t min_rows_per_job = 32;
+
+#if defined(VKB_SOBEL_SSE2)
+using float4 = __m128;
+
+inline float4 load4(const float *p)
+{
+	return _mm_loadu_ps(p);
+}
+inline void store4(float *p, float4 v)
+{
+	_mm_storeu_ps(p, v);
+}
+inline float4 set4(float v)
+{
+	return _mm_set1_ps(v);
+}
+inline float4 add4(float4 a, float4 b)
+{
+	return _mm_add_ps(a, b);
+}
+inline float4 sub4(float4 a, float4 b)
+{
+	return _mm_sub_ps(a, b);
+}
+inline float4 mul4(float4 a, float4 b)
+{
+	return _mm_mul_ps(a, b);
+}
+inline float4 div4(float4 a, float4 b)
+{
+	return _mm_div_ps(a, b);
+}
+inline float4 max4(float4 a, float4 b)
+{
+	return _mm_max_ps(a, b);
+}
+inline float4 sqrt4(float4 a)
+{
+	return _mm_sqrt_ps(a);
+}
+#elif defined(VKB_SOBEL_NEON)
+using float4 = float32x4_t;
+
+inline float4 load4(const float *p)
+{
+	return vld1q_f32(p);
+}
+inline void store4(float *p, float4 v)
+{
+	vst1q_f32(p, v);
+}
+inline float4 set4(float v)
+{
+	return vdupq_n_f32(v);
+}
+inline float4 add4(float4 a, float4 b)
+{
+	return vaddq_f32(a, b);
+}
+inline float4 sub4(float4 a, float4 b)
+{
+	return vsubq_f32(a, b);
+}
+inline float4 mul4(float4 a, float4 b)
+{
+	return vmulq_f32(a, b);
+}
+inline float4 div4(float4 a, float4 b)
+{
+	return vdivq_f32(a, b);
+}
+inline float4 max4(float4 a, float4 b)
+{
+	return vmaxq_f32(a, b);
+}
+inline float4 sqrt4(float4 a)
+{
+	return vsqrtq_f32(a);
+}
+#endif
+
+/**
+ * @brief Filters one row of normals
+ * @param above Heights of the row above, starting at the left border sample
+ * @param center Heights of the current row, starting at the left border sample
+ * @param below Heights of the row below, starting at the left border sample
+ */
+void sobel_row(const float *above, const float *center, const float *below, uint32_t width, const SobelNormalParams &params, glm::vec3 *normals)
+{
+	uint32_t x = 0;
+
+#if defined(VKB_SOBEL_SSE2) || defined(VKB_SOBEL_NEON)
+	const float4 zero    = set4(0.0f);
+	const float4 one     = set4(1.0f);
+	const float4 two     = set4(2.0f);
+	const float4 bump    = set4(params.bump_strength);
+	const float4 scale_x = set4(params.scale.x);
+	const float4 scale_y = set4(params.scale.y);
+	const float4 scale_z = set4(params.scale.z);
+
+	for (; x + 4 <= width; x += 4)
+	{
+		float4 a = load4(above + x), b = load4(above + x + 1), c = load4(above + x + 2);
+		float4 d = load4(center + x), f = load4(center + x + 2);
+		float4 g = load4(below + x), h = load4(below + x + 1), i = load4(below + x + 2);
+
+		// Gx: a - c + 2 (d - f) + g - i
+		float4 nx = add4(add4(sub4(a, c), mul4(two, sub4(d, f))), sub4(g, i));
+		// Gy: a + 2 b + c - g - 2 h - i
+		float4 nz = sub4(add4(add4(a, mul4(two, b)), c), add4(add4(g, mul4(two, h)), i));
+		float4 ny = mul4(bump, sqrt4(max4(zero, sub4(sub4(one, mul4(nx, nx)), mul4(nz, nz)))));
+
+		nx = mul4(nx, scale_x);
+		ny = mul4(ny, scale_y);
+		nz = mul4(nz, scale_z);
+
+		float4 inv_length = div4(one, sqrt4(add4(add4(mul4(nx, nx), mul4(ny, ny)), mul4(nz, nz))));
+
+		alignas(16) float out_x[4], out_y[4], out_z[4];
+		store4(out_x, mul4(nx, inv_length));
+		store4(out_y, mul4(ny, inv_length));
+		store4(out_z, mul4(nz, inv_length));
+
+		for (uint32_t lane = 0; lane < 4; ++lane)
+		{
+			normals[x + lane] = glm::vec3(out_x[lane], out_y[lane], out_z[lane]);
+		}
+	}
+#endif
+
+	for (; x < width; ++x)
+	{
+		float a = above[x], b = above[x + 1], c = above[x + 2];
+		float d = center[x], f = center[x + 2];
+		float g = below[x], h = below[x + 1], i = below[x + 2];
+
+		glm::vec3 normal;
+		normal.x = a - c + 2.0f * (d - f) + g - i;
+		normal.z = a + 2.0f * b + c - g - 2.0f * h - i;
+		// Reconstruct the up component, clamped so steep slopes do not produce NaNs
+		normal.y = params.bump_strength * std::sqrt(std::max(0.0f, 1.0f - normal.x * normal.x - normal.z * normal.z));
+
+		normals[x] = glm::normalize(normal * params.scale);
+	}
+}
+}        // namespace
+
+void compute_sobel_normals(const std::vector<float> &heights,
+                           uint32_t                  width,
+                           uint32_t                  depth,
+                           std::vector<glm::vec3>   &normals,
+                           const SobelNormalParams  &params,
+                           size_t                    thread_count)
+{
+	const size_t stride = width + 2;
+	if (heights.size() < stride * (depth + 2))
+	{
+		throw std::runtime_error("Height grid is smaller than the requested normals plus border");
+	}
+
+	normals.resize(static_cast<size_t>(width) * depth);
+
+	if (thread_count == 0)
+	{
+		thread_count = std::max(1u, std::thread::hardware_concurrency());
+	}
+
+	parallel_for(depth, thread_count, min_rows_per_job, [&](size_t first_row, size_t last_row) {
+		for (size_t z = first_row; z < last_row; ++z)
+		{
+			const float *above = heights.data() + z * stride;
+			sobel_row(above, above + stride, above + 2 * stride, width, params, normals.data() + z * width);
+		}
+	});
+}
+}        // namespace vkb
@@ -0,0 +1,58 @@
+/* Copyright (c) 2025, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <vector>
+
+#include "common/glm_common.h"
+
+namespace vkb
+{
+/**
+ * @brief Parameters of the Sobel filter used to derive terrain normals from heights
+ */
+struct SobelNormalParams
+{
+	/// Scale of the reconstructed up component, lower values give stronger bumps
+	float bump_strength{0.25f};
+
+	/// Scale applied to the filtered normal before it gets normalized
+	glm::vec3 scale{2.0f, 1.0f, 2.0f};
+};
+
+/**
+ * @brief Computes terrain normals from a grid of heights with a 3x3 Sobel filter
+ *
+ * Rows are processed with 4-wide SIMD where available (SSE2 or AArch64 NEON) and
+ * split across the shared worker threads. The SIMD and scalar paths evaluate the
+ * same expressions but may round differently, so results agree to within a few ulps.
+ *
+ * @param heights Row-major heights of (width + 2) x (depth + 2) samples, including a one sample border on every side
+ * @param width Number of normals along x
+ * @param depth Number of normals along z
+ * @param normals Output, row-major width x depth normals
+ * @param params Filter parameters
+ * @param thread_count Number of threads, 0 selects the hardware concurrency
+ */
+void compute_sobel_normals(const std::vector<float> &heights,
+                           uint32_t                  width,
+                           uint32_t                  depth,
+                           std::vector<glm::vec3>   &normals,
+                           const SobelNormalParams  &params       = {},
+                           size_t                    thread_count = 0);
+}        // namespace vkb
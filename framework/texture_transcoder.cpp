@@ -0,0 +1,435 @@
+/* Copyright (c) 2025, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "texture_transcoder.h"
+
+#include <cstring>
+#include <future>
+#include <thread>
+
+#include <ctpl_stl.h>
+#include <fmt/format.h>
+
+VKBP_DISABLE_WARNINGS()
+#include <basisu_transcoder.h>
+VKBP_ENABLE_WARNINGS()
+
+#include "core/util/logging.hpp"
+#include "filesystem/filesystem.hpp"
+#include "filesystem/legacy.h"
+#include "timer.h"
+
+namespace vkb
+{
+namespace
+{
+// libktx defines its transcode formats with the values of the Basis Universal ones
+static_assert(KTX_TTF_ETC1_RGB == static_cast<int>(basist::transcoder_texture_format::cTFETC1_RGB));
+static_assert(KTX_TTF_BC7_RGBA == static_cast<int>(basist::transcoder_texture_format::cTFBC7_RGBA));
+static_assert(KTX_TTF_ASTC_4x4_RGBA == static_cast<int>(basist::transcoder_texture_format::cTFASTC_4x4_RGBA));
+static_assert(KTX_TTF_RGBA32 == static_cast<int>(basist::transcoder_texture_format::cTFRGBA32));
+
+constexpr char     cache_magic[8]  = {'V', 'K', 'B', 'T', 'C', 'C', 'H', '\0'};
+constexpr uint32_t cache_version   = 1;
+constexpr uint64_t image_alignment = 16;
+
+struct CacheHeader
+{
+	char     magic[8];
+	uint32_t version;
+	uint32_t target_format;
+	uint64_t source_hash;
+	uint64_t source_size;
+	uint32_t format;
+	uint32_t width;
+	uint32_t height;
+	uint32_t levels;
+	uint32_t layers;
+	uint32_t faces;
+	uint32_t image_count;
+	uint32_t padding;
+	uint64_t data_size;
+};
+
+uint64_t align_up(uint64_t value, uint64_t alignment)
+{
+	return (value + alignment - 1) / alignment * alignment;
+}
+
+// FNV-1a over 64-bit words, unlike std::hash it is the same in every run and on every platform
+uint64_t hash_contents(const uint8_t *data, size_t size)
+{
+	uint64_t hash = 14695981039346656037ull;
+	size_t   i    = 0;
+	for (; i + sizeof(uint64_t) <= size; i += sizeof(uint64_t))
+	{
+		uint64_t word;
+		std::memcpy(&word, data + i, sizeof(word));
+		hash = (hash ^ word) * 1099511628211ull;
+	}
+	for (; i < size; ++i)
+	{
+		hash = (hash ^ data[i]) * 1099511628211ull;
+	}
+	return hash;
+}
+
+filesystem::Path get_cache_path(uint64_t source_hash, ktx_transcode_fmt_e target_format)
+{
+	return filesystem::get()->temp_directory() / "vkb_transcode_cache" / fmt::format("{:016x}_{}.bin", source_hash, static_cast<int>(target_format));
+}
+
+bool read_cache(const filesystem::Path &path, uint64_t source_hash, uint64_t source_size, ktx_transcode_fmt_e target_format, TranscodedTexture &texture)
+{
+	auto fs = filesystem::get();
+	if (!fs->is_file(path))
+	{
+		return false;
+	}
+
+	auto file = fs->map_file(path);
+
+	CacheHeader header;
+	if (file->size() < sizeof(header))
+	{
+		return false;
+	}
+	std::memcpy(&header, file->data(), sizeof(header));
+
+	// Entries of other versions, and hash collisions, are transcoded again and overwritten
+	if (std::memcmp(header.magic, cache_magic, sizeof(cache_magic)) != 0 || header.version != cache_version ||
+	    header.target_format != static_cast<uint32_t>(target_format) || header.source_hash != source_hash || header.source_size != source_size)
+	{
+		return false;
+	}
+
+	// Truncated or corrupted entries are rejected before anything is sized from them, the sizes are compared
+	// against the size of the file so that they cannot overflow
+	uint64_t remaining_size = file->size() - sizeof(header);
+	if (header.image_count > remaining_size / sizeof(TranscodedImage))
+	{
+		return false;
+	}
+	uint64_t images_size = uint64_t{header.image_count} * sizeof(TranscodedImage);
+	if (header.data_size != remaining_size - images_size)
+	{
+		return false;
+	}
+
+	std::vector<TranscodedImage> images(header.image_count);
+	std::memcpy(images.data(), file->data() + sizeof(header), images_size);
+	for (auto &image : images)
+	{
+		if (image.offset > header.data_size || image.size > header.data_size - image.offset)
+		{
+			return false;
+		}
+	}
+
+	texture.format = static_cast<VkFormat>(header.format);
+	texture.width  = header.width;
+	texture.height = header.height;
+	texture.levels = header.levels;
+	texture.layers = header.layers;
+	texture.faces  = header.faces;
+	texture.images = std::move(images);
+	texture.data.assign(file->data() + sizeof(header) + images_size, file->data() + file->size());
+
+	return true;
+}
+
+void write_cache(const filesystem::Path &path, uint64_t source_hash, uint64_t source_size, ktx_transcode_fmt_e target_format, const TranscodedTexture &texture)
+{
+	CacheHeader header{};
+	std::memcpy(header.magic, cache_magic, sizeof(cache_magic));
+	header.version       = cache_version;
+	header.target_format = static_cast<uint32_t>(target_format);
+	header.source_hash   = source_hash;
+	header.source_size   = source_size;
+	header.format        = static_cast<uint32_t>(texture.format);
+	header.width         = texture.width;
+	header.height        = texture.height;
+	header.levels        = texture.levels;
+	header.layers        = texture.layers;
+	header.faces         = texture.faces;
+	header.image_count   = static_cast<uint32_t>(texture.images.size());
+	header.data_size     = texture.data.size();
+
+	auto images_size = texture.images.size() * sizeof(TranscodedImage);
+
+	std::vector<uint8_t> contents(sizeof(header) + images_size + texture.data.size());
+	std::memcpy(contents.data(), &header, sizeof(header));
+	std::memcpy(contents.data() + sizeof(header), texture.images.data(), images_size);
+	std::memcpy(contents.data() + sizeof(header) + images_size, texture.data.data(), texture.data.size());
+
+	try
+	{
+		filesystem::get()->write_file(path, contents);
+	}
+	catch (const std::exception &e)
+	{
+		// The cache only saves time, the texture is transcoded again next time
+		LOGW("Failed to write the transcode cache: {}", e.what());
+	}
+}
+}        // namespace
+
+TextureTranscoder::TextureTranscoder(uint32_t thread_count, bool use_cache) :
+    use_cache{use_cache}
+{
+	if (thread_count == 0)
+	{
+		thread_count = std::max(std::thread::hardware_concurrency(), 1u);
+	}
+	thread_pool = std::make_unique<ctpl::thread_pool>(static_cast<int>(thread_count));
+
+	basist::basisu_transcoder_init();
+}
+
+TextureTranscoder::~TextureTranscoder() = default;
+
+TranscodedTexture TextureTranscoder::transcode(const std::string &filename, ktx_transcode_fmt_e target_format)
+{
+	Timer timer;
+	timer.start();
+
+	auto file = fs::map_asset(filename);
+
+	uint64_t source_hash = hash_contents(file->data(), file->size());
+	auto     cache_path  = get_cache_path(source_hash, target_format);
+
+	TranscodedTexture texture;
+	if (use_cache && read_cache(cache_path, source_hash, file->size(), target_format, texture))
+	{
+		texture.from_cache = true;
+		texture.elapsed_ms = timer.stop<Timer::Milliseconds>();
+
+		std::lock_guard<std::mutex> lock(statistics_mutex);
+		statistics[target_format].cache_hits++;
+		return texture;
+	}
+
+	if (!transcode_images(file->data(), file->size(), target_format, texture))
+	{
+		transcode_with_libktx(file->data(), file->size(), target_format, texture);
+	}
+
+	texture.elapsed_ms = timer.stop<Timer::Milliseconds>();
+
+	uint64_t pixel_count = 0;
+	for (auto &image : texture.images)
+	{
+		pixel_count += uint64_t{image.width} * image.height;
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(statistics_mutex);
+
+		auto &format_statistics = statistics[target_format];
+		format_statistics.texture_count++;
+		format_statistics.pixel_count += pixel_count;
+		format_statistics.output_size += texture.data.size();
+		format_statistics.total_ms += texture.elapsed_ms;
+	}
+
+	LOGI("Transcoded {} to format {} in {:.2f} ms ({:.1f} Mpixels/s)", filename, static_cast<int>(target_format), texture.elapsed_ms, pixel_count / (texture.elapsed_ms * 1000.0));
+
+	if (use_cache)
+	{
+		write_cache(cache_path, source_hash, file->size(), target_format, texture);
+	}
+
+	return texture;
+}
+
+std::map<ktx_transcode_fmt_e, TranscodeStatistics> TextureTranscoder::get_statistics() const
+{
+	std::lock_guard<std::mutex> lock(statistics_mutex);
+	return statistics;
+}
+
+VkFormat TextureTranscoder::get_vk_format(ktx_transcode_fmt_e target_format, bool srgb)
+{
+	switch (target_format)
+	{
+		case KTX_TTF_ETC1_RGB:
+			// ETC1 is a subset of ETC2
+			return srgb ? VK_FORMAT_ETC2_R8G8B8_SRGB_BLOCK : VK_FORMAT_ETC2_R8G8B8_UNORM_BLOCK;
+		case KTX_TTF_ETC2_RGBA:
+			return srgb ? VK_FORMAT_ETC2_R8G8B8A8_SRGB_BLOCK : VK_FORMAT_ETC2_R8G8B8A8_UNORM_BLOCK;
+		case KTX_TTF_BC1_RGB:
+			return srgb ? VK_FORMAT_BC1_RGB_SRGB_BLOCK : VK_FORMAT_BC1_RGB_UNORM_BLOCK;
+		case KTX_TTF_BC3_RGBA:
+			return srgb ? VK_FORMAT_BC3_SRGB_BLOCK : VK_FORMAT_BC3_UNORM_BLOCK;
+		case KTX_TTF_BC4_R:
+			return VK_FORMAT_BC4_UNORM_BLOCK;
+		case KTX_TTF_BC5_RG:
+			return VK_FORMAT_BC5_UNORM_BLOCK;
+		case KTX_TTF_BC7_RGBA:
+			return srgb ? VK_FORMAT_BC7_SRGB_BLOCK : VK_FORMAT_BC7_UNORM_BLOCK;
+		case KTX_TTF_ASTC_4x4_RGBA:
+			return srgb ? VK_FORMAT_ASTC_4x4_SRGB_BLOCK : VK_FORMAT_ASTC_4x4_UNORM_BLOCK;
+		case KTX_TTF_ETC2_EAC_R11:
+			return VK_FORMAT_EAC_R11_UNORM_BLOCK;
+		case KTX_TTF_ETC2_EAC_RG11:
+			return VK_FORMAT_EAC_R11G11_UNORM_BLOCK;
+		case KTX_TTF_RGBA32:
+			return srgb ? VK_FORMAT_R8G8B8A8_SRGB : VK_FORMAT_R8G8B8A8_UNORM;
+		case KTX_TTF_RGB565:
+			return VK_FORMAT_R5G6B5_UNORM_PACK16;
+		case KTX_TTF_RGBA4444:
+			return VK_FORMAT_R4G4B4A4_UNORM_PACK16;
+		default:
+			return VK_FORMAT_UNDEFINED;
+	}
+}
+
+bool TextureTranscoder::transcode_images(const uint8_t *data, size_t size, ktx_transcode_fmt_e target_format, TranscodedTexture &texture)
+{
+#if BASISD_SUPPORT_KTX2
+	basist::ktx2_transcoder transcoder;
+	if (!transcoder.init(data, static_cast<uint32_t>(size)) || !transcoder.start_transcoding())
+	{
+		return false;
+	}
+
+	auto basis_format = static_cast<basist::transcoder_texture_format>(target_format);
+	bool srgb         = transcoder.get_dfd_transfer_func() == basist::KTX2_KHR_DF_TRANSFER_SRGB;
+
+	texture.format = get_vk_format(target_format, srgb);
+	if (texture.format == VK_FORMAT_UNDEFINED)
+	{
+		throw std::runtime_error(fmt::format("Transcoding to format {} is not supported", static_cast<int>(target_format)));
+	}
+
+	texture.width  = transcoder.get_width();
+	texture.height = transcoder.get_height();
+	texture.levels = transcoder.get_levels();
+	texture.layers = std::max(transcoder.get_layers(), 1u);
+	texture.faces  = transcoder.get_faces();
+
+	bool     uncompressed   = basist::basis_transcoder_format_is_uncompressed(basis_format);
+	uint32_t bytes_per_unit = basist::basis_get_bytes_per_block_or_pixel(basis_format);
+
+	// Lay out all the images first, so that they are transcoded straight to their place
+	std::vector<uint32_t> units;
+	uint64_t              data_size = 0;
+	for (uint32_t level = 0; level < texture.levels; ++level)
+	{
+		for (uint32_t layer = 0; layer < texture.layers; ++layer)
+		{
+			for (uint32_t face = 0; face < texture.faces; ++face)
+			{
+				basist::ktx2_image_level_info info;
+				if (!transcoder.get_image_level_info(info, level, layer, face))
+				{
+					throw std::runtime_error("Failed to get the description of a transcoded image");
+				}
+
+				uint32_t unit_count = uncompressed ? info.m_orig_width * info.m_orig_height : info.m_total_blocks;
+				units.push_back(unit_count);
+
+				data_size = align_up(data_size, image_alignment);
+				texture.images.push_back({level, layer, face, info.m_orig_width, info.m_orig_height, data_size, uint64_t{unit_count} * bytes_per_unit});
+				data_size += texture.images.back().size;
+			}
+		}
+	}
+	texture.data.resize(data_size);
+
+	// The images only share read-only state of the transcoder, each task has its own state
+	std::vector<std::future<bool>> results;
+	results.reserve(texture.images.size());
+	for (size_t i = 0; i < texture.images.size(); ++i)
+	{
+		results.push_back(thread_pool->push([&, i](size_t) {
+			auto                          &image = texture.images[i];
+			basist::ktx2_transcoder_state state;
+			return transcoder.transcode_image_level(image.level, image.layer, image.face, texture.data.data() + image.offset, units[i], basis_format, 0, 0, 0, -1, -1, &state);
+		}));
+	}
+
+	// All the tasks must complete before the transcoder goes out of scope
+	bool success = true;
+	for (auto &result : results)
+	{
+		success = result.get() && success;
+	}
+	if (!success)
+	{
+		throw std::runtime_error("Could not transcode the input texture to the selected target format.");
+	}
+
+	return true;
+#else
+	return false;
+#endif
+}
+
+void TextureTranscoder::transcode_with_libktx(const uint8_t *data, size_t size, ktx_transcode_fmt_e target_format, TranscodedTexture &texture)
+{
+	ktxTexture2   *ktx_texture;
+	KTX_error_code result = ktxTexture2_CreateFromMemory(data, size, KTX_TEXTURE_CREATE_LOAD_IMAGE_DATA_BIT, &ktx_texture);
+	if (result != KTX_SUCCESS)
+	{
+		throw std::runtime_error("Could not load the requested image file.");
+	}
+
+	std::unique_ptr<ktxTexture2, void (*)(ktxTexture2 *)> owner{ktx_texture, [](ktxTexture2 *t) { ktxTexture_Destroy(ktxTexture(t)); }};
+
+	if (!ktxTexture2_NeedsTranscoding(ktx_texture))
+	{
+		throw std::runtime_error("The texture is not supercompressed with Basis Universal.");
+	}
+
+	result = ktxTexture2_TranscodeBasis(ktx_texture, target_format, 0);
+	if (result != KTX_SUCCESS)
+	{
+		throw std::runtime_error("Could not transcode the input texture to the selected target format.");
+	}
+
+	texture.format = static_cast<VkFormat>(ktx_texture->vkFormat);
+	texture.width  = ktx_texture->baseWidth;
+	texture.height = ktx_texture->baseHeight;
+	texture.levels = ktx_texture->numLevels;
+	texture.layers = ktx_texture->numLayers;
+	texture.faces  = ktx_texture->numFaces;
+
+	uint64_t data_size = 0;
+	for (uint32_t level = 0; level < texture.levels; ++level)
+	{
+		auto image_size = ktxTexture_GetImageSize(ktxTexture(ktx_texture), level);
+		for (uint32_t layer = 0; layer < texture.layers; ++layer)
+		{
+			for (uint32_t face = 0; face < texture.faces; ++face)
+			{
+				data_size = align_up(data_size, image_alignment);
+				texture.images.push_back({level, layer, face, std::max(texture.width >> level, 1u), std::max(texture.height >> level, 1u), data_size, image_size});
+				data_size += image_size;
+			}
+		}
+	}
+
+	texture.data.resize(data_size);
+	for (auto &image : texture.images)
+	{
+		ktx_size_t offset;
+		ktxTexture_GetImageOffset(ktxTexture(ktx_texture), image.level, image.layer, image.face, &offset);
+		std::memcpy(texture.data.data() + image.offset, ktx_texture->pData + offset, image.size);
+	}
+}
+}        // namespace vkb
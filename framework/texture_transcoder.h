@@ -0,0 +1,152 @@
+/* Copyright (c) 2025, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <ktx.h>
+
+#include "common/vk_common.h"
+
+namespace ctpl
+{
+class thread_pool;
+}
+
+namespace vkb
+{
+/**
+ * @brief One image of a transcoded texture, at data offset in TranscodedTexture::data
+ */
+struct TranscodedImage
+{
+	uint32_t level;
+	uint32_t layer;
+	uint32_t face;
+	uint32_t width;
+	uint32_t height;
+	uint64_t offset;
+	uint64_t size;
+};
+
+/**
+ * @brief A texture transcoded to a format the GPU samples from, laid out to be copied to an image with one region per image
+ */
+struct TranscodedTexture
+{
+	VkFormat format = VK_FORMAT_UNDEFINED;
+	uint32_t width  = 0;
+	uint32_t height = 0;
+	uint32_t levels = 0;
+	uint32_t layers = 0;
+	uint32_t faces  = 0;
+
+	/// Ordered by level, then layer, then face, each image starts at a multiple of 16 bytes
+	std::vector<TranscodedImage> images;
+
+	std::vector<uint8_t> data;
+
+	/// Read from the transcode cache instead of transcoded
+	bool from_cache = false;
+
+	/// Time spent transcoding, or reading the cache
+	double elapsed_ms = 0.0;
+};
+
+/**
+ * @brief Transcode throughput to one target format
+ */
+struct TranscodeStatistics
+{
+	uint32_t texture_count = 0;
+	uint32_t cache_hits    = 0;
+	uint64_t pixel_count   = 0;
+	uint64_t output_size   = 0;
+	double   total_ms      = 0.0;
+
+	double get_megapixels_per_second() const
+	{
+		return total_ms > 0.0 ? pixel_count / (total_ms * 1000.0) : 0.0;
+	}
+};
+
+/**
+ * @brief Transcodes KTX2 textures supercompressed with Basis Universal to GPU formats, on worker threads
+ *
+ * The images of a texture, one per mip level, array layer and face, are transcoded in parallel. Textures
+ * the Basis Universal KTX2 transcoder cannot read directly, such as UASTC with Zstandard supercompression,
+ * are transcoded whole by libktx instead.
+ *
+ * Transcoded textures are kept in an on-disk cache in the temporary directory, keyed by a hash of the source
+ * file and the target format, so that running again only reads the transcoded texture back.
+ */
+class TextureTranscoder
+{
+  public:
+	/**
+	 * @param thread_count Worker threads, 0 uses all hardware threads
+	 * @param use_cache Read and write the on-disk cache
+	 */
+	explicit TextureTranscoder(uint32_t thread_count = 0, bool use_cache = true);
+
+	~TextureTranscoder();
+
+	TextureTranscoder(const TextureTranscoder &)            = delete;
+	TextureTranscoder &operator=(const TextureTranscoder &) = delete;
+
+	/**
+	 * @brief Transcodes a texture, blocking until all of its images are transcoded
+	 * @param filename The path to the KTX2 file (relative to the assets directory)
+	 * @param target_format Format to transcode to, must be one of the formats get_vk_format supports
+	 * @throws std::runtime_error if the file is not a Basis Universal texture, or cannot be transcoded
+	 */
+	TranscodedTexture transcode(const std::string &filename, ktx_transcode_fmt_e target_format);
+
+	/**
+	 * @return Statistics of all the textures transcoded so far, per target format
+	 */
+	std::map<ktx_transcode_fmt_e, TranscodeStatistics> get_statistics() const;
+
+	/**
+	 * @return The format of a texture transcoded to target_format, or VK_FORMAT_UNDEFINED if the format is not supported
+	 */
+	static VkFormat get_vk_format(ktx_transcode_fmt_e target_format, bool srgb);
+
+  private:
+	/**
+	 * @brief Transcodes the images of a texture in parallel
+	 * @return False if the Basis Universal KTX2 transcoder cannot read the texture
+	 */
+	bool transcode_images(const uint8_t *data, size_t size, ktx_transcode_fmt_e target_format, TranscodedTexture &texture);
+
+	void transcode_with_libktx(const uint8_t *data, size_t size, ktx_transcode_fmt_e target_format, TranscodedTexture &texture);
+
+	std::unique_ptr<ctpl::thread_pool> thread_pool;
+
+	bool use_cache;
+
+	mutable std::mutex statistics_mutex;
+
+	std::map<ktx_transcode_fmt_e, TranscodeStatistics> statistics;
+};
+}        // namespace vkb
@@ -0,0 +1,635 @@
+/* Copyright (c) 2025, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "upload_service.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <numeric>
+
+#include <core/util/counters.hpp>
+#include <core/util/profiling.hpp>
+
+#include "core/device.h"
+
+namespace vkb
+{
+namespace
+{
+VkDeviceSize align_up(VkDeviceSize value, VkDeviceSize alignment)
+{
+	return (value + alignment - 1) / alignment * alignment;
+}
+
+const Queue &get_transfer_queue(Device &device)
+{
+	const Queue &graphics_queue  = device.get_suitable_graphics_queue();
+	uint32_t     transfer_family = device.get_queue_family_index(VK_QUEUE_TRANSFER_BIT);
+
+	// Only a family without graphics and compute is worth the ownership transfers, as it maps to a copy engine
+	VkQueueFlags transfer_flags = device.get_gpu().get_queue_family_properties()[transfer_family].queueFlags;
+	if (transfer_family != graphics_queue.get_family_index() && !(transfer_flags & (VK_QUEUE_GRAPHICS_BIT | VK_QUEUE_COMPUTE_BIT)))
+	{
+		return device.get_queue(transfer_family, 0);
+	}
+
+	return graphics_queue;
+}
+}        // namespace
+
+UploadService::UploadService(Device &device, VkDeviceSize ring_size) :
+    device{device},
+    graphics_queue{device.get_suitable_graphics_queue()},
+    transfer_queue{get_transfer_queue(device)},
+    ring_size{ring_size}
+{
+	if (uses_transfer_queue())
+	{
+		LOGI("Uploading through the transfer queue of family {}", transfer_queue.get_family_index());
+	}
+
+	completion_thread = std::thread(&UploadService::completion_worker, this);
+}
+
+UploadService::~UploadService()
+{
+	{
+		std::lock_guard<std::mutex> lock{mutex};
+		if (failure == VK_SUCCESS)
+		{
+			flush_locked();
+		}
+		stopping = true;
+	}
+	submitted_condition.notify_all();
+
+	// The worker returns once all submitted batches have completed or failed
+	completion_thread.join();
+
+	recycle_completed_batches();
+
+	// The fences and semaphores of failed batches are only destroyed with the service, without being reset
+	for (auto &batch : failed_batches)
+	{
+		free_fences.push_back(batch.fence);
+		if (batch.transfer_semaphore != VK_NULL_HANDLE)
+		{
+			free_semaphores.push_back(batch.transfer_semaphore);
+		}
+	}
+
+	for (VkFence fence : free_fences)
+	{
+		vkDestroyFence(device.get_handle(), fence, nullptr);
+	}
+	for (VkSemaphore semaphore : free_semaphores)
+	{
+		vkDestroySemaphore(device.get_handle(), semaphore, nullptr);
+	}
+
+	// Destroying the pools frees their command buffers
+	if (transfer_command_pool != VK_NULL_HANDLE)
+	{
+		vkDestroyCommandPool(device.get_handle(), transfer_command_pool, nullptr);
+	}
+	if (graphics_command_pool != VK_NULL_HANDLE)
+	{
+		vkDestroyCommandPool(device.get_handle(), graphics_command_pool, nullptr);
+	}
+
+	ring.reset();
+}
+
+std::shared_future<void> UploadService::upload_buffer(VkBuffer buffer, const void *data, VkDeviceSize size, VkDeviceSize offset)
+{
+	std::unique_lock<std::mutex> lock{mutex};
+
+	StagingAllocation staging = stage(lock, data, size, 16);
+
+	Batch &batch = get_open_batch();
+	if (staging.dedicated_buffer)
+	{
+		batch.dedicated_buffers.push_back(std::move(staging.dedicated_buffer));
+	}
+
+	VkBufferCopy copy_region{staging.offset, offset, size};
+	vkCmdCopyBuffer(batch.transfer_command_buffer, staging.buffer, buffer, 1, &copy_region);
+
+	if (uses_transfer_queue())
+	{
+		VkBufferMemoryBarrier barrier{VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER};
+		barrier.srcAccessMask       = VK_ACCESS_TRANSFER_WRITE_BIT;
+		barrier.srcQueueFamilyIndex = transfer_queue.get_family_index();
+		barrier.dstQueueFamilyIndex = graphics_queue.get_family_index();
+		barrier.buffer              = buffer;
+		barrier.offset              = offset;
+		barrier.size                = size;
+		batch.buffer_barriers.push_back(barrier);
+	}
+
+	batch.has_buffer_copies = true;
+	batch.byte_count += size;
+
+	return batch.future;
+}
+
+std::shared_future<void> UploadService::upload_image(VkImage                               image,
+                                                     VkFormat                              format,
+                                                     const VkImageSubresourceRange        &subresource_range,
+                                                     const void                           *data,
+                                                     VkDeviceSize                          size,
+                                                     const std::vector<VkBufferImageCopy> &regions,
+                                                     VkImageLayout                         final_layout)
+{
+	// Buffer offsets of image copies must be multiples of 4 and of the texel size
+	int32_t      bits_per_pixel = get_bits_per_pixel(format);
+	VkDeviceSize alignment      = bits_per_pixel > 0 ? std::lcm<VkDeviceSize>(16, std::max<VkDeviceSize>(bits_per_pixel / 8, 1)) : 16;
+
+	std::unique_lock<std::mutex> lock{mutex};
+
+	StagingAllocation staging = stage(lock, data, size, alignment);
+
+	Batch &batch = get_open_batch();
+	if (staging.dedicated_buffer)
+	{
+		batch.dedicated_buffers.push_back(std::move(staging.dedicated_buffer));
+	}
+
+	VkImageMemoryBarrier barrier{VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER};
+	barrier.dstAccessMask       = VK_ACCESS_TRANSFER_WRITE_BIT;
+	barrier.oldLayout           = VK_IMAGE_LAYOUT_UNDEFINED;
+	barrier.newLayout           = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+	barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+	barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+	barrier.image               = image;
+	barrier.subresourceRange    = subresource_range;
+	vkCmdPipelineBarrier(batch.transfer_command_buffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 0, nullptr, 0, nullptr, 1, &barrier);
+
+	std::vector<VkBufferImageCopy> staging_regions = regions;
+	for (auto &region : staging_regions)
+	{
+		region.bufferOffset += staging.offset;
+	}
+	vkCmdCopyBufferToImage(batch.transfer_command_buffer, staging.buffer, image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, to_u32(staging_regions.size()), staging_regions.data());
+
+	// Transitioned to the final layout after all copies of the batch
+	barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+	barrier.dstAccessMask = VK_ACCESS_MEMORY_READ_BIT;
+	barrier.oldLayout     = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+	barrier.newLayout     = final_layout;
+	if (uses_transfer_queue())
+	{
+		barrier.dstAccessMask       = 0;
+		barrier.srcQueueFamilyIndex = transfer_queue.get_family_index();
+		barrier.dstQueueFamilyIndex = graphics_queue.get_family_index();
+	}
+	batch.image_barriers.push_back(barrier);
+
+	batch.byte_count += size;
+
+	return batch.future;
+}
+
+uint64_t UploadService::flush()
+{
+	std::lock_guard<std::mutex> lock{mutex};
+	return flush_locked();
+}
+
+void UploadService::wait(uint64_t value)
+{
+	std::unique_lock<std::mutex> lock{mutex};
+	wait_locked(lock, value);
+}
+
+void UploadService::wait_idle()
+{
+	std::unique_lock<std::mutex> lock{mutex};
+	wait_locked(lock, flush_locked());
+}
+
+uint64_t UploadService::get_completed_value() const
+{
+	std::lock_guard<std::mutex> lock{mutex};
+	return completed_value;
+}
+
+bool UploadService::uses_transfer_queue() const
+{
+	return &transfer_queue != &graphics_queue;
+}
+
+void UploadService::prepare()
+{
+	if (ring)
+	{
+		return;
+	}
+
+	ring = vkb::core::BufferBuilderC(ring_size)
+	           .with_vma_flags(VMA_ALLOCATION_CREATE_MAPPED_BIT | VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT)
+	           .with_usage(VK_BUFFER_USAGE_TRANSFER_SRC_BIT)
+	           .with_memory_category(vkb::allocated::MemoryCategory::Staging)
+	           .with_debug_name("Upload ring")
+	           .build_unique(device);
+	ring_data = ring->map();
+
+	VkCommandPoolCreateInfo command_pool_info{VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO};
+	command_pool_info.flags            = VK_COMMAND_POOL_CREATE_TRANSIENT_BIT | VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT;
+	command_pool_info.queueFamilyIndex = transfer_queue.get_family_index();
+	VK_CHECK(vkCreateCommandPool(device.get_handle(), &command_pool_info, nullptr, &transfer_command_pool));
+
+	if (uses_transfer_queue())
+	{
+		command_pool_info.queueFamilyIndex = graphics_queue.get_family_index();
+		VK_CHECK(vkCreateCommandPool(device.get_handle(), &command_pool_info, nullptr, &graphics_command_pool));
+	}
+}
+
+UploadService::StagingAllocation UploadService::stage(std::unique_lock<std::mutex> &lock, const void *data, VkDeviceSize size, VkDeviceSize alignment)
+{
+	static const vkb::Counter uploaded_bytes{"Uploaded bytes", PlotType::Memory};
+	uploaded_bytes.add(static_cast<double>(size));
+
+	check_failure_locked();
+
+	prepare();
+
+	StagingAllocation allocation;
+
+	if (size > ring_size)
+	{
+		allocation.dedicated_buffer = std::make_unique<vkb::core::BufferC>(vkb::core::BufferC::create_staging_buffer(device, size, data));
+		allocation.buffer           = allocation.dedicated_buffer->get_handle();
+		return allocation;
+	}
+
+	VkDeviceSize position = 0;
+
+	auto reserve = [&]() {
+		if (ring_tail == ring_head)
+		{
+			// Nothing is in use, start again from the beginning of the ring
+			ring_head = align_up(ring_head, ring_size);
+			ring_tail = ring_head;
+		}
+
+		VkDeviceSize ring_start = ring_head - ring_head % ring_size;
+		VkDeviceSize offset     = align_up(ring_head % ring_size, alignment);
+		if (offset + size > ring_size)
+		{
+			// Skip the end of the ring, which is too small for the data
+			ring_start += ring_size;
+			offset = 0;
+		}
+
+		position = ring_start + offset;
+		return position + size - ring_tail <= ring_size;
+	};
+
+	if (!reserve())
+	{
+		PROFILE_SCOPE("Upload stall");
+
+		static const vkb::Counter stall_count{"Upload stalls"};
+		static const vkb::Counter stall_time{"Upload stall time (ms)"};
+
+		auto start = std::chrono::steady_clock::now();
+		do
+		{
+			if (in_flight_batches.empty())
+			{
+				// The open batch holds the ring
+				flush_locked();
+			}
+			else
+			{
+				completed_condition.wait(lock);
+				check_failure_locked();
+			}
+		} while (!reserve());
+
+		stall_count.add();
+		stall_time.add(std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count());
+	}
+
+	ring_head = position + size;
+
+	allocation.buffer = ring->get_handle();
+	allocation.offset = position % ring_size;
+
+	std::memcpy(ring_data + allocation.offset, data, static_cast<size_t>(size));
+	ring->flush(allocation.offset, size);
+
+	return allocation;
+}
+
+UploadService::Batch &UploadService::get_open_batch()
+{
+	if (open_batch)
+	{
+		return *open_batch;
+	}
+
+	recycle_completed_batches();
+
+	open_batch        = std::make_unique<Batch>();
+	open_batch->value = next_value++;
+
+	open_batch->future = open_batch->promise.get_future().share();
+
+	auto request_command_buffer = [this](VkCommandPool command_pool, std::vector<VkCommandBuffer> &free_command_buffers) {
+		VkCommandBuffer command_buffer = VK_NULL_HANDLE;
+		if (free_command_buffers.empty())
+		{
+			VkCommandBufferAllocateInfo allocate_info{VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO};
+			allocate_info.commandPool        = command_pool;
+			allocate_info.level              = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+			allocate_info.commandBufferCount = 1;
+			VK_CHECK(vkAllocateCommandBuffers(device.get_handle(), &allocate_info, &command_buffer));
+		}
+		else
+		{
+			command_buffer = free_command_buffers.back();
+			free_command_buffers.pop_back();
+		}
+		return command_buffer;
+	};
+
+	open_batch->transfer_command_buffer = request_command_buffer(transfer_command_pool, free_transfer_command_buffers);
+
+	if (uses_transfer_queue())
+	{
+		open_batch->acquire_command_buffer = request_command_buffer(graphics_command_pool, free_graphics_command_buffers);
+
+		if (free_semaphores.empty())
+		{
+			VkSemaphoreCreateInfo semaphore_info{VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO};
+			VK_CHECK(vkCreateSemaphore(device.get_handle(), &semaphore_info, nullptr, &open_batch->transfer_semaphore));
+		}
+		else
+		{
+			open_batch->transfer_semaphore = free_semaphores.back();
+			free_semaphores.pop_back();
+		}
+	}
+
+	if (free_fences.empty())
+	{
+		VkFenceCreateInfo fence_info{VK_STRUCTURE_TYPE_FENCE_CREATE_INFO};
+		VK_CHECK(vkCreateFence(device.get_handle(), &fence_info, nullptr, &open_batch->fence));
+	}
+	else
+	{
+		open_batch->fence = free_fences.back();
+		free_fences.pop_back();
+	}
+
+	VkCommandBufferBeginInfo begin_info{VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO};
+	begin_info.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+	VK_CHECK(vkBeginCommandBuffer(open_batch->transfer_command_buffer, &begin_info));
+
+	return *open_batch;
+}
+
+uint64_t UploadService::flush_locked()
+{
+	if (!open_batch)
+	{
+		return next_value - 1;
+	}
+
+	check_failure_locked();
+
+	PROFILE_SCOPE("Flush uploads");
+
+	static const vkb::Counter batch_count{"Upload batches"};
+	batch_count.add();
+
+	Batch batch = std::move(*open_batch);
+	open_batch.reset();
+
+	batch.ring_end = ring_head;
+
+	VkSubmitInfo submit_info{VK_STRUCTURE_TYPE_SUBMIT_INFO};
+	submit_info.commandBufferCount = 1;
+	submit_info.pCommandBuffers    = &batch.transfer_command_buffer;
+
+	if (uses_transfer_queue())
+	{
+		// Release the destinations to the graphics queue, which acquires them with the same barriers
+		vkCmdPipelineBarrier(batch.transfer_command_buffer,
+		                     VK_PIPELINE_STAGE_TRANSFER_BIT,
+		                     VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT,
+		                     0,
+		                     0,
+		                     nullptr,
+		                     to_u32(batch.buffer_barriers.size()),
+		                     batch.buffer_barriers.data(),
+		                     to_u32(batch.image_barriers.size()),
+		                     batch.image_barriers.data());
+		VK_CHECK(vkEndCommandBuffer(batch.transfer_command_buffer));
+
+		for (auto &barrier : batch.buffer_barriers)
+		{
+			barrier.srcAccessMask = 0;
+			barrier.dstAccessMask = VK_ACCESS_MEMORY_READ_BIT;
+		}
+		for (auto &barrier : batch.image_barriers)
+		{
+			barrier.srcAccessMask = 0;
+			barrier.dstAccessMask = VK_ACCESS_MEMORY_READ_BIT;
+		}
+
+		VkCommandBufferBeginInfo begin_info{VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO};
+		begin_info.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+		VK_CHECK(vkBeginCommandBuffer(batch.acquire_command_buffer, &begin_info));
+		vkCmdPipelineBarrier(batch.acquire_command_buffer,
+		                     VK_PIPELINE_STAGE_ALL_COMMANDS_BIT,
+		                     VK_PIPELINE_STAGE_ALL_COMMANDS_BIT,
+		                     0,
+		                     0,
+		                     nullptr,
+		                     to_u32(batch.buffer_barriers.size()),
+		                     batch.buffer_barriers.data(),
+		                     to_u32(batch.image_barriers.size()),
+		                     batch.image_barriers.data());
+		VK_CHECK(vkEndCommandBuffer(batch.acquire_command_buffer));
+
+		submit_info.signalSemaphoreCount = 1;
+		submit_info.pSignalSemaphores    = &batch.transfer_semaphore;
+		VK_CHECK(transfer_queue.submit({submit_info}, VK_NULL_HANDLE));
+
+		VkPipelineStageFlags wait_stage = VK_PIPELINE_STAGE_ALL_COMMANDS_BIT;
+
+		VkSubmitInfo acquire_submit_info{VK_STRUCTURE_TYPE_SUBMIT_INFO};
+		acquire_submit_info.waitSemaphoreCount = 1;
+		acquire_submit_info.pWaitSemaphores    = &batch.transfer_semaphore;
+		acquire_submit_info.pWaitDstStageMask  = &wait_stage;
+		acquire_submit_info.commandBufferCount = 1;
+		acquire_submit_info.pCommandBuffers    = &batch.acquire_command_buffer;
+		VK_CHECK(graphics_queue.submit({acquire_submit_info}, batch.fence));
+	}
+	else
+	{
+		// Make the copies visible to the work submitted after them
+		VkMemoryBarrier memory_barrier{VK_STRUCTURE_TYPE_MEMORY_BARRIER};
+		memory_barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+		memory_barrier.dstAccessMask = VK_ACCESS_MEMORY_READ_BIT;
+
+		vkCmdPipelineBarrier(batch.transfer_command_buffer,
+		                     VK_PIPELINE_STAGE_TRANSFER_BIT,
+		                     VK_PIPELINE_STAGE_ALL_COMMANDS_BIT,
+		                     0,
+		                     batch.has_buffer_copies ? 1 : 0,
+		                     &memory_barrier,
+		                     0,
+		                     nullptr,
+		                     to_u32(batch.image_barriers.size()),
+		                     batch.image_barriers.data());
+		VK_CHECK(vkEndCommandBuffer(batch.transfer_command_buffer));
+
+		VK_CHECK(transfer_queue.submit({submit_info}, batch.fence));
+	}
+
+	uint64_t value = batch.value;
+
+	in_flight_batches.push_back(std::move(batch));
+	submitted_condition.notify_one();
+
+	return value;
+}
+
+void UploadService::wait_locked(std::unique_lock<std::mutex> &lock, uint64_t value)
+{
+	if (open_batch && value >= open_batch->value)
+	{
+		flush_locked();
+	}
+
+	// Values that were never assigned complete with the last batch
+	value = std::min(value, next_value - 1);
+
+	completed_condition.wait(lock, [this, value]() { return completed_value >= value || failure != VK_SUCCESS; });
+	if (completed_value < value)
+	{
+		check_failure_locked();
+	}
+}
+
+void UploadService::check_failure_locked() const
+{
+	if (failure != VK_SUCCESS)
+	{
+		throw VulkanException{failure, "Upload service failed"};
+	}
+}
+
+void UploadService::recycle_completed_batches()
+{
+	for (auto &batch : completed_batches)
+	{
+		free_transfer_command_buffers.push_back(batch.transfer_command_buffer);
+		if (batch.acquire_command_buffer != VK_NULL_HANDLE)
+		{
+			free_graphics_command_buffers.push_back(batch.acquire_command_buffer);
+		}
+		if (batch.transfer_semaphore != VK_NULL_HANDLE)
+		{
+			free_semaphores.push_back(batch.transfer_semaphore);
+		}
+
+		VK_CHECK(vkResetFences(device.get_handle(), 1, &batch.fence));
+		free_fences.push_back(batch.fence);
+	}
+
+	// Destroys the dedicated staging buffers
+	completed_batches.clear();
+}
+
+void UploadService::completion_worker()
+{
+	vkb::tracing::set_thread_name("Upload completion");
+
+	std::unique_lock<std::mutex> lock{mutex};
+	while (true)
+	{
+		submitted_condition.wait(lock, [this]() { return stopping || !in_flight_batches.empty(); });
+		if (in_flight_batches.empty())
+		{
+			return;
+		}
+
+		// The batch stays in front until this thread pops it, so its fence is not recycled while waiting
+		VkFence  fence = in_flight_batches.front().fence;
+		uint64_t value = in_flight_batches.front().value;
+
+		lock.unlock();
+		VkResult result = vkWaitForFences(device.get_handle(), 1, &fence, VK_TRUE, DEFAULT_FENCE_TIMEOUT);
+		while (result == VK_TIMEOUT)
+		{
+			// Large uploads on a busy GPU may take longer than the timeout, which is not an error
+			LOGW("Upload batch {} has not completed yet, waiting again", value);
+			result = vkWaitForFences(device.get_handle(), 1, &fence, VK_TRUE, DEFAULT_FENCE_TIMEOUT);
+		}
+		lock.lock();
+
+		if (result != VK_SUCCESS)
+		{
+			LOGE("Failed to wait for the upload batch {}: {}", value, to_string(result));
+
+			// The GPU may still use the resources of the batches after an error, so they are kept until the service is
+			// destroyed instead of being recycled, and the ring is not released. Every later upload, flush and wait throws.
+			failure = result;
+
+			std::vector<std::promise<void>> promises;
+			for (auto &batch : in_flight_batches)
+			{
+				promises.push_back(std::move(batch.promise));
+				failed_batches.push_back(std::move(batch));
+			}
+			in_flight_batches.clear();
+
+			lock.unlock();
+			for (auto &promise : promises)
+			{
+				promise.set_exception(std::make_exception_ptr(VulkanException{result, "Upload failed"}));
+			}
+			lock.lock();
+
+			completed_condition.notify_all();
+			return;
+		}
+
+		Batch batch = std::move(in_flight_batches.front());
+		in_flight_batches.pop_front();
+
+		ring_tail       = batch.ring_end;
+		completed_value = value;
+
+		std::promise<void> promise = std::move(batch.promise);
+		completed_batches.push_back(std::move(batch));
+
+		lock.unlock();
+		promise.set_value();
+		lock.lock();
+
+		completed_condition.notify_all();
+	}
+}
+}        // namespace vkb
@@ -0,0 +1,250 @@
+/* Copyright (c) 2025, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "common/vk_common.h"
+#include "core/buffer.h"
+
+namespace vkb
+{
+class Device;
+class Queue;
+
+/**
+ * @brief Uploads data to buffers and images through a persistently mapped staging ring
+ *
+ * Uploads copy their data into the ring and record their copy commands into the open batch, which is submitted by
+ * flush(). Batches are submitted to a dedicated transfer queue when the device has one, and the ownership of their
+ * destinations is then transferred to the graphics queue by a second submission that waits for the copies, so that
+ * work submitted to the graphics queue after flush() sees the uploaded data without the CPU waiting.
+ *
+ * Batches are identified by increasing timeline values. A thread waits for the fence of each submitted batch in order,
+ * then completes the value, the futures of its uploads, and releases its space in the ring. When the ring is full,
+ * uploads flush the open batch and wait for the oldest batches to complete; these stalls are counted, with the bytes
+ * uploaded, in the "Upload stalls", "Upload stall time (ms)" and "Uploaded bytes" counters. Uploads larger than the
+ * ring are staged in a buffer of their own.
+ *
+ * If waiting for a batch fails, for example when the device is lost, the futures of the batches in flight are failed,
+ * and uploads, flushes and waits throw a VulkanException from then on.
+ *
+ * All methods may be called from any thread. Uploads and flush() may submit to the transfer and graphics queues, so
+ * they must not run while another thread submits to the graphics queue. Destinations must have the exclusive sharing
+ * mode, and must not be in use by the GPU when an upload is recorded.
+ */
+class UploadService
+{
+  public:
+	static constexpr VkDeviceSize default_ring_size = 32 * 1024 * 1024;
+
+	UploadService(Device &device, VkDeviceSize ring_size = default_ring_size);
+
+	UploadService(const UploadService &) = delete;
+
+	UploadService(UploadService &&) = delete;
+
+	~UploadService();
+
+	UploadService &operator=(const UploadService &) = delete;
+
+	UploadService &operator=(UploadService &&) = delete;
+
+	/**
+	 * @brief Uploads data to a buffer
+	 * @param buffer The buffer to copy to, created with VK_BUFFER_USAGE_TRANSFER_DST_BIT
+	 * @param data The data to upload, copied before the function returns
+	 * @param size The size of the data in bytes
+	 * @param offset The offset to copy to in the buffer
+	 * @return A future that becomes ready when the copy has completed on the GPU, once the batch has been flushed
+	 */
+	std::shared_future<void> upload_buffer(VkBuffer buffer, const void *data, VkDeviceSize size, VkDeviceSize offset = 0);
+
+	/**
+	 * @brief Uploads data to the subresources of an image, and transitions them to a layout for their use
+	 * @param image The image to copy to, created with VK_IMAGE_USAGE_TRANSFER_DST_BIT, its previous content is discarded
+	 * @param format The format of the image, which the staging offset is aligned for
+	 * @param subresource_range The subresources transitioned to final_layout
+	 * @param data The data to upload, copied before the function returns
+	 * @param size The size of the data in bytes
+	 * @param regions The copies to record, with buffer offsets relative to data
+	 * @param final_layout The layout of the subresources after the upload
+	 * @return A future that becomes ready when the copy has completed on the GPU, once the batch has been flushed
+	 */
+	std::shared_future<void> upload_image(VkImage                               image,
+	                                      VkFormat                              format,
+	                                      const VkImageSubresourceRange        &subresource_range,
+	                                      const void                           *data,
+	                                      VkDeviceSize                          size,
+	                                      const std::vector<VkBufferImageCopy> &regions,
+	                                      VkImageLayout                         final_layout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+
+	/**
+	 * @brief Submits the uploads recorded since the last flush
+	 * @return The timeline value of the submitted batch, or of the last submitted batch if there was nothing to submit
+	 */
+	uint64_t flush();
+
+	/**
+	 * @brief Waits until the batch with a timeline value has completed, flushing it if it is still open
+	 */
+	void wait(uint64_t value);
+
+	/**
+	 * @brief Flushes the open batch and waits until all batches have completed
+	 */
+	void wait_idle();
+
+	/**
+	 * @return The timeline value of the last batch that has completed, 0 if none has
+	 */
+	uint64_t get_completed_value() const;
+
+	/**
+	 * @return Whether a dedicated transfer queue is used for the copies
+	 */
+	bool uses_transfer_queue() const;
+
+  private:
+	struct Batch
+	{
+		uint64_t value = 0;
+
+		VkCommandBuffer transfer_command_buffer = VK_NULL_HANDLE;
+
+		// Acquires the destinations on the graphics queue, when copies are submitted to the transfer queue
+		VkCommandBuffer acquire_command_buffer = VK_NULL_HANDLE;
+
+		VkSemaphore transfer_semaphore = VK_NULL_HANDLE;
+
+		// Signaled by the last submission of the batch
+		VkFence fence = VK_NULL_HANDLE;
+
+		// Position of the ring after the staging data of the batch
+		VkDeviceSize ring_end = 0;
+
+		// Staging buffers of uploads larger than the ring
+		std::vector<std::unique_ptr<vkb::core::BufferC>> dedicated_buffers;
+
+		// Recorded after the copies, as releases to the graphics queue when copies are submitted to the transfer queue
+		std::vector<VkBufferMemoryBarrier> buffer_barriers;
+		std::vector<VkImageMemoryBarrier>  image_barriers;
+
+		bool has_buffer_copies = false;
+
+		VkDeviceSize byte_count = 0;
+
+		std::promise<void>       promise;
+		std::shared_future<void> future;
+	};
+
+	struct StagingAllocation
+	{
+		VkBuffer buffer = VK_NULL_HANDLE;
+
+		VkDeviceSize offset = 0;
+
+		// Set for uploads larger than the ring
+		std::unique_ptr<vkb::core::BufferC> dedicated_buffer;
+	};
+
+	/**
+	 * @brief Creates the ring and the command pools on first use
+	 */
+	void prepare();
+
+	/**
+	 * @brief Reserves staging memory and copies data into it, flushing the open batch and waiting if the ring is full
+	 */
+	StagingAllocation stage(std::unique_lock<std::mutex> &lock, const void *data, VkDeviceSize size, VkDeviceSize alignment);
+
+	/**
+	 * @brief Begins a batch if there is no open batch, must be called after stage() which may flush it
+	 */
+	Batch &get_open_batch();
+
+	uint64_t flush_locked();
+
+	void wait_locked(std::unique_lock<std::mutex> &lock, uint64_t value);
+
+	/**
+	 * @brief Returns the command buffers, fences and semaphores of completed batches to their pools
+	 */
+	void recycle_completed_batches();
+
+	/**
+	 * @brief Throws if waiting for a batch failed, as the GPU may still use the ring and the batches in flight
+	 */
+	void check_failure_locked() const;
+
+	void completion_worker();
+
+	Device &device;
+
+	const Queue &graphics_queue;
+
+	const Queue &transfer_queue;
+
+	VkDeviceSize ring_size;
+
+	std::unique_ptr<vkb::core::BufferC> ring;
+
+	uint8_t *ring_data = nullptr;
+
+	// Positions in the ring only increase, the offset in the buffer is the position modulo the ring size
+	VkDeviceSize ring_head = 0;
+	VkDeviceSize ring_tail = 0;
+
+	VkCommandPool transfer_command_pool = VK_NULL_HANDLE;
+	VkCommandPool graphics_command_pool = VK_NULL_HANDLE;
+
+	std::vector<VkCommandBuffer> free_transfer_command_buffers;
+	std::vector<VkCommandBuffer> free_graphics_command_buffers;
+	std::vector<VkFence>         free_fences;
+	std::vector<VkSemaphore>     free_semaphores;
+
+	mutable std::mutex mutex;
+
+	std::condition_variable submitted_condition;
+	std::condition_variable completed_condition;
+
+	std::unique_ptr<Batch> open_batch;
+
+	std::deque<Batch> in_flight_batches;
+	std::deque<Batch> completed_batches;
+
+	// Batches in flight when waiting for a batch failed, kept until the service is destroyed
+	std::deque<Batch> failed_batches;
+
+	uint64_t next_value      = 1;
+	uint64_t completed_value = 0;
+
+	bool stopping = false;
+
+	// The error of the wait that failed, after which the service no longer uploads
+	VkResult failure = VK_SUCCESS;
+
+	std::thread completion_thread;
+};
+}        // namespace vkb
@@ -18,6 +18,11 @@
 
 #pragma once
 
+#include <future>
+
+#include <core/util/profiling.hpp>
+#include <ctpl_stl.h>
+
 #include "common/hpp_utils.h"
 #include "core/debug.h"
 #include "hpp_gltf_loader.h"
@@ -25,6 +30,9 @@
 #include "platform/application.h"
 #include "platform/window.h"
 #include "rendering/hpp_render_pipeline.h"
+#include "scene_graph/memory_defragmenter.h"
+#include "scene_graph/scene_snapshot.h"
+#include "scene_graph/texture_residency.h"
 #include "stats/hpp_stats.h"
 
 #if defined(PLATFORM__MACOS)
@@ -72,7 +80,8 @@ namespace vkb
  * A series of steps are performed, some of which can be customized (it will be
  * highlighted when that's the case):
  *
- * - calling sg::Script::update() for all sg::Script (s)
+ * - calling sg::Script::update() for all sg::Script (s), on a worker thread for the next frame
+ *   if the scene update is pipelined (see VulkanSample::set_pipelined_scene_update)
  * - beginning a frame in RenderContext (does the necessary waiting on fences and
  *   acquires an core::Image)
  * - requesting a CommandBuffer
@@ -150,9 +159,25 @@ class VulkanSample : public vkb::Application
 	using SurfaceType        = typename std::conditional<bindingType == BindingType::Cpp, vk::SurfaceKHR, VkSurfaceKHR>::type;
 
 	Configuration           &get_configuration();
+	DeviceType              &get_device();
+	DeviceType const        &get_device() const;
 	RenderContextType       &get_render_context();
 	RenderContextType const &get_render_context() const;
+	SceneType               &get_scene();
+	bool                     has_device() const;
 	bool                     has_render_context() const;
+	bool                     has_scene();
+
+	/**
+	 * @brief Runs the scene update of the next frame on a worker thread while the current frame is recorded
+	 *
+	 * Rendering reads the transforms from a sg::SceneSnapshot taken before the update starts, so the CPU frame
+	 * time tends towards the longest of the scene update and the recording instead of their sum. The scene is
+	 * updated with the delta time of the frame starting the update, and is shown one frame later.
+	 * Only samples updating the scene through VulkanSample::update are affected, and they must only change the
+	 * scene from scripts and animations. Enabled with the --pipeline-scene-update option.
+	 */
+	void set_pipelined_scene_update(bool enable);
 
 	/// <summary>
 	/// PROTECTED VIRTUAL INTERFACE
@@ -264,24 +289,19 @@ class VulkanSample : public vkb::Application
 	 */
 	void create_render_context(const std::vector<SurfaceFormatType> &surface_priority_list);
 
-	DeviceType                           &get_device();
-	DeviceType const                     &get_device() const;
 	GuiType                              &get_gui();
 	GuiType const                        &get_gui() const;
 	InstanceType                         &get_instance();
 	InstanceType const                   &get_instance() const;
 	RenderPipelineType                   &get_render_pipeline();
 	RenderPipelineType const             &get_render_pipeline() const;
-	SceneType                            &get_scene();
 	StatsType                            &get_stats();
 	SurfaceType                           get_surface() const;
 	std::vector<SurfaceFormatType>       &get_surface_priority_list();
 	std::vector<SurfaceFormatType> const &get_surface_priority_list() const;
-	bool                                  has_device() const;
 	bool                                  has_instance() const;
 	bool                                  has_gui() const;
 	bool                                  has_render_pipeline() const;
-	bool                                  has_scene();
 
 	/**
 	 * @brief Loads the scene
@@ -295,6 +315,11 @@ class VulkanSample : public vkb::Application
 	 */
 	bool prepare(const ApplicationOptions &options) override;
 
+	/**
+	 * @brief Waits for the scene update running on the worker thread, if any
+	 */
+	void wait_for_scene_update();
+
 	/**
 	 * @brief Set the Vulkan API version to request at instance creation time
 	 */
@@ -412,6 +437,18 @@ class VulkanSample : public vkb::Application
 
 	std::unique_ptr<vkb::stats::HPPStats> stats;
 
+	/**
+	 * @brief Worker running the scene update of the next frame, only created if the scene update is pipelined
+	 */
+	std::unique_ptr<ctpl::thread_pool> scene_update_thread;
+
+	std::future<void> scene_update;
+
+	/**
+	 * @brief Transforms of the scene read by the frame being recorded while the scene update runs
+	 */
+	vkb::sg::SceneSnapshot scene_snapshot;
+
 	static constexpr float STATS_VIEW_RESET_TIME{10.0f};        // 10 seconds
 
 	/**
@@ -460,6 +497,21 @@ inline VulkanSample<bindingType>::~VulkanSample()
 		device->get_handle().waitIdle();
 	}
 
+	wait_for_scene_update();
+	vkb::sg::SceneSnapshot::publish(nullptr);
+
+	if constexpr (bindingType == BindingType::C)
+	{
+		// The defragmentation must end before the resources it moves are destroyed
+		if (scene)
+		{
+			for (auto *memory_defragmenter : scene->get_components<sg::MemoryDefragmenter>())
+			{
+				memory_defragmenter->finish();
+			}
+		}
+	}
+
 	scene.reset();
 	stats.reset();
 	gui.reset();
@@ -680,6 +732,8 @@ inline void VulkanSample<bindingType>::finish()
 {
 	Parent::finish();
 
+	wait_for_scene_update();
+
 	if (device)
 	{
 		device->get_handle().waitIdle();
@@ -981,7 +1035,10 @@ inline void VulkanSample<bindingType>::input_event(const InputEvent &input_event
 	{
 		if (scene && scene->has_component<sg::Script>())
 		{
-			auto scripts = scene->get_components<sg::Script>();
+			// Scripts are not thread safe, the event waits for them to finish updating
+			wait_for_scene_update();
+
+			auto &scripts = scene->get_cached_components<sg::Script>();
 
 			for (auto script : scripts)
 			{
@@ -1006,6 +1063,13 @@ inline void VulkanSample<bindingType>::load_scene(const std::string &path)
 {
 	vkb::HPPGLTFLoader loader(*device);
 
+	// The pending update and the snapshot belong to the previous scene, the next frame updates the new one
+	if (scene_update.valid())
+	{
+		scene_update.get();
+	}
+	vkb::sg::SceneSnapshot::publish(nullptr);
+
 	scene = loader.read_scene_from_file(path);
 
 	if (!scene)
@@ -1015,6 +1079,35 @@ inline void VulkanSample<bindingType>::load_scene(const std::string &path)
 	}
 }
 
+template <vkb::BindingType bindingType>
+inline void VulkanSample<bindingType>::set_pipelined_scene_update(bool enable)
+{
+	if (enable && !scene_update_thread)
+	{
+		scene_update_thread = std::make_unique<ctpl::thread_pool>(1);
+		scene_update_thread->push([](size_t) { vkb::tracing::set_thread_name("Scene update"); });
+	}
+	else if (!enable && scene_update_thread)
+	{
+		// The next frame updates the scene again after the pending update, a single extra step
+		if (scene_update.valid())
+		{
+			scene_update.get();
+		}
+		vkb::sg::SceneSnapshot::publish(nullptr);
+		scene_update_thread.reset();
+	}
+}
+
+template <vkb::BindingType bindingType>
+inline void VulkanSample<bindingType>::wait_for_scene_update()
+{
+	if (scene_update.valid())
+	{
+		scene_update.wait();
+	}
+}
+
 template <vkb::BindingType bindingType>
 inline bool VulkanSample<bindingType>::prepare(const ApplicationOptions &options)
 {
@@ -1118,6 +1211,9 @@ inline bool VulkanSample<bindingType>::prepare(const ApplicationOptions &options
 	add_device_extension(VK_KHR_PORTABILITY_SUBSET_EXTENSION_NAME, /*optional=*/true);
 #endif
 
+	// Lets the GPU profiler place its timestamps on the CPU timeline
+	add_device_extension(VK_EXT_CALIBRATED_TIMESTAMPS_EXTENSION_NAME, /*optional=*/true);
+
 #ifdef VKB_VULKAN_DEBUG
 	if (!debug_utils)
 	{
@@ -1236,7 +1332,9 @@ inline bool VulkanSample<bindingType>::resize(uint32_t width, uint32_t height)
 
 	if (scene && scene->has_component<sg::Script>())
 	{
-		auto scripts = scene->get_components<sg::Script>();
+		wait_for_scene_update();
+
+		auto &scripts = scene->get_cached_components<sg::Script>();
 
 		for (auto script : scripts)
 		{
@@ -1316,30 +1414,85 @@ inline void VulkanSample<bindingType>::update(float delta_time)
 {
 	vkb::Application::update(delta_time);
 
-	update_scene(delta_time);
+	if (scene && scene_update_thread)
+	{
+		// The update started by the previous frame brought the scene to this frame
+		if (scene_update.valid())
+		{
+			PROFILE_SCOPE("Wait for scene update");
+			scene_update.get();
+		}
+		else
+		{
+			update_scene(delta_time);
+		}
 
-	update_gui(delta_time);
+		{
+			PROFILE_SCOPE("Capture scene snapshot");
+			vkb::sg::SceneSnapshot::publish(nullptr);
+			scene_snapshot.capture(reinterpret_cast<vkb::sg::Scene &>(*scene));
+			vkb::sg::SceneSnapshot::publish(&scene_snapshot);
+		}
 
-	auto command_buffer = render_context->begin();
+		scene_update = scene_update_thread->push([this, delta_time](size_t) {
+			PROFILE_SCOPE("Update scene");
+			vkb::sg::SceneSnapshot::LiveScope live;
+			update_scene(delta_time);
+		});
+	}
+	else
+	{
+		PROFILE_SCOPE("Update scene");
+		update_scene(delta_time);
+	}
 
-	// Collect the performance data for the sample graphs
-	update_stats(delta_time);
+	{
+		PROFILE_SCOPE("Update GUI");
+		update_gui(delta_time);
+	}
 
-	command_buffer->begin(vk::CommandBufferUsageFlagBits::eOneTimeSubmit);
-	stats->begin_sampling(*command_buffer);
+	auto command_buffer = render_context->begin();
 
-	if constexpr (bindingType == BindingType::Cpp)
+	if constexpr (bindingType == BindingType::C)
 	{
-		draw(*command_buffer, render_context->get_active_frame().get_render_target());
+		// Once the frame has begun, so that it samples the textures with the levels picked for it
+		if (scene)
+		{
+			// Before the texture residency, so that a pass ends before the images it moves are retired
+			for (auto *memory_defragmenter : scene->get_components<sg::MemoryDefragmenter>())
+			{
+				memory_defragmenter->update(*render_context);
+			}
+
+			for (auto *texture_residency : scene->get_components<sg::TextureResidency>())
+			{
+				texture_residency->update(*render_context);
+			}
+		}
 	}
-	else
+
+	// Collect the performance data for the sample graphs
+	update_stats(delta_time);
+
 	{
-		draw(reinterpret_cast<vkb::core::CommandBufferC &>(*command_buffer),
-		     reinterpret_cast<vkb::RenderTarget &>(render_context->get_active_frame().get_render_target()));
-	}
+		PROFILE_SCOPE("Record commands");
+
+		command_buffer->begin(vk::CommandBufferUsageFlagBits::eOneTimeSubmit);
+		stats->begin_sampling(*command_buffer);
+
+		if constexpr (bindingType == BindingType::Cpp)
+		{
+			draw(*command_buffer, render_context->get_active_frame().get_render_target());
+		}
+		else
+		{
+			draw(reinterpret_cast<vkb::core::CommandBufferC &>(*command_buffer),
+			     reinterpret_cast<vkb::RenderTarget &>(render_context->get_active_frame().get_render_target()));
+		}
 
-	stats->end_sampling(*command_buffer);
-	command_buffer->end();
+		stats->end_sampling(*command_buffer);
+		command_buffer->end();
+	}
 
 	render_context->submit(*command_buffer);
 }
@@ -1403,7 +1556,7 @@ inline void VulkanSample<bindingType>::update_scene(float delta_time)
 		// Update scripts
 		if (scene->has_component<sg::Script>())
 		{
-			auto scripts = scene->get_components<sg::Script>();
+			auto &scripts = scene->get_cached_components<sg::Script>();
 
 			for (auto script : scripts)
 			{
@@ -1414,7 +1567,7 @@ inline void VulkanSample<bindingType>::update_scene(float delta_time)
 		// Update animations
 		if (scene->has_component<sg::Animation>())
 		{
-			auto animations = scene->get_components<sg::Animation>();
+			auto &animations = scene->get_cached_components<sg::Animation>();
 
 			for (auto animation : animations)
 			{
@@ -46,6 +46,9 @@ ComputeNBody::~ComputeNBody()
 		vkDestroyDescriptorSetLayout(get_device().get_handle(), graphics.descriptor_set_layout, nullptr);
 		vkDestroySemaphore(get_device().get_handle(), graphics.semaphore, nullptr);
 
+		// CPU simulation
+		cpu.particle_buffer.reset();
+
 		// Compute
 		compute.storage_buffer.reset();
 		compute.uniform_buffer.reset();
@@ -100,8 +103,8 @@ void ComputeNBody::build_command_buffers()
 
 		VK_CHECK(vkBeginCommandBuffer(draw_cmd_buffers[i], &command_buffer_begin_info));
 
-		// Acquire
-		if (graphics.queue_family_index != compute.queue_family_index)
+		// Acquire, the storage buffer is not used while the CPU simulates the particles
+		if (!cpu.enabled && graphics.queue_family_index != compute.queue_family_index)
 		{
 			VkBufferMemoryBarrier buffer_barrier =
 			    {
@@ -134,13 +137,13 @@ void ComputeNBody::build_command_buffers()
 		vkCmdBindPipeline(draw_cmd_buffers[i], VK_PIPELINE_BIND_POINT_GRAPHICS, graphics.pipeline);
 		vkCmdBindDescriptorSets(draw_cmd_buffers[i], VK_PIPELINE_BIND_POINT_GRAPHICS, graphics.pipeline_layout, 0, 1, &graphics.descriptor_set, 0, NULL);
 		VkDeviceSize offsets[1] = {0};
-		vkCmdBindVertexBuffers(draw_cmd_buffers[i], 0, 1, compute.storage_buffer->get(), offsets);
+		vkCmdBindVertexBuffers(draw_cmd_buffers[i], 0, 1, cpu.enabled ? cpu.particle_buffer->get() : compute.storage_buffer->get(), offsets);
 		vkCmdDraw(draw_cmd_buffers[i], num_particles, 1, 0, 0);
 		draw_ui(draw_cmd_buffers[i]);
 		vkCmdEndRenderPass(draw_cmd_buffers[i]);
 
 		// Release barrier
-		if (graphics.queue_family_index != compute.queue_family_index)
+		if (!cpu.enabled && graphics.queue_family_index != compute.queue_family_index)
 		{
 			VkBufferMemoryBarrier buffer_barrier =
 			    {
@@ -277,44 +280,11 @@ void ComputeNBody::prepare_storage_buffers()
 
 	num_particles = static_cast<uint32_t>(attractors.size()) * PARTICLES_PER_ATTRACTOR;
 
-	// Initial particle positions
-	std::vector<Particle> particle_buffer(num_particles);
+	// Initial particle positions, the same on every run when the simulation speed is locked
+	std::vector<Particle> particle_buffer =
+	    vkb::NBodySimulation::create_particles(attractors, PARTICLES_PER_ATTRACTOR, lock_simulation_speed ? 0 : static_cast<unsigned>(time(nullptr)));
 
-	std::default_random_engine      rnd_engine(lock_simulation_speed ? 0 : static_cast<unsigned>(time(nullptr)));
-	std::normal_distribution<float> rnd_distribution(0.0f, 1.0f);
-
-	for (uint32_t i = 0; i < static_cast<uint32_t>(attractors.size()); i++)
-	{
-		for (uint32_t j = 0; j < PARTICLES_PER_ATTRACTOR; j++)
-		{
-			Particle &particle = particle_buffer[i * PARTICLES_PER_ATTRACTOR + j];
-
-			// First particle in group as heavy center of gravity
-			if (j == 0)
-			{
-				particle.pos = glm::vec4(attractors[i] * 1.5f, 90000.0f);
-				particle.vel = glm::vec4(glm::vec4(0.0f));
-			}
-			else
-			{
-				// Position
-				glm::vec3 position(attractors[i] + glm::vec3(rnd_distribution(rnd_engine), rnd_distribution(rnd_engine), rnd_distribution(rnd_engine)) * 0.75f);
-				float     len = glm::length(glm::normalize(position - attractors[i]));
-				position.y *= 2.0f - (len * len);
-
-				// Velocity
-				glm::vec3 angular  = glm::vec3(0.5f, 1.5f, 0.5f) * (((i % 2) == 0) ? 1.0f : -1.0f);
-				glm::vec3 velocity = glm::cross((position - attractors[i]), angular) + glm::vec3(rnd_distribution(rnd_engine), rnd_distribution(rnd_engine), rnd_distribution(rnd_engine) * 0.025f);
-
-				float mass   = (rnd_distribution(rnd_engine) * 0.5f + 0.5f) * 75.0f;
-				particle.pos = glm::vec4(position, mass);
-				particle.vel = glm::vec4(velocity, 0.0f);
-			}
-
-			// Color gradient offset
-			particle.vel.w = static_cast<float>(i) * 1.0f / static_cast<uint32_t>(attractors.size());
-		}
-	}
+	prepare_cpu_simulation(particle_buffer);
 
 	compute.ubo.particle_count = num_particles;
 
@@ -362,6 +332,37 @@ void ComputeNBody::prepare_storage_buffers()
 	get_device().flush_command_buffer(copy_command, queue, true);
 }
 
+void ComputeNBody::prepare_cpu_simulation(const std::vector<Particle> &particles)
+{
+	cpu.simulation = std::make_unique<vkb::NBodySimulation>();
+
+	// Persistently mapped, the simulation steps the particles in place
+	cpu.particle_buffer = std::make_unique<vkb::core::BufferC>(get_device(),
+	                                                           particles.size() * sizeof(Particle),
+	                                                           VK_BUFFER_USAGE_VERTEX_BUFFER_BIT,
+	                                                           VMA_MEMORY_USAGE_CPU_TO_GPU,
+	                                                           VMA_ALLOCATION_CREATE_MAPPED_BIT);
+	cpu.particle_buffer->update(particles);
+}
+
+void ComputeNBody::update_cpu_simulation(float delta_time)
+{
+	if (paused)
+	{
+		return;
+	}
+
+	// The previous frame has finished rendering, as submit_frame waits for the queue to be idle
+	auto particles = std::span<Particle>(reinterpret_cast<Particle *>(cpu.particle_buffer->map()), num_particles);
+
+	vkb::Timer timer;
+	timer.start();
+	cpu.simulation->step(particles, delta_time, static_cast<vkb::NBodyMethod>(cpu.method));
+	cpu.step_ms = static_cast<float>(timer.stop<vkb::Timer::Milliseconds>());
+
+	cpu.particle_buffer->flush();
+}
+
 void ComputeNBody::setup_descriptor_pool()
 {
 	std::vector<VkDescriptorPoolSize> pool_sizes =
@@ -797,6 +798,22 @@ void ComputeNBody::draw()
 {
 	ApiVulkanSample::prepare_frame();
 
+	if (cpu.enabled)
+	{
+		// Nothing to synchronize with the compute queue, the particles were written by the host before the submission
+		submit_info.commandBufferCount   = 1;
+		submit_info.pCommandBuffers      = &draw_cmd_buffers[current_buffer];
+		submit_info.waitSemaphoreCount   = 1;
+		submit_info.pWaitSemaphores      = &semaphores.acquired_image_ready;
+		submit_info.pWaitDstStageMask    = &submit_pipeline_stages;
+		submit_info.signalSemaphoreCount = 1;
+		submit_info.pSignalSemaphores    = &semaphores.render_complete;
+		VK_CHECK(vkQueueSubmit(queue, 1, &submit_info, VK_NULL_HANDLE));
+
+		ApiVulkanSample::submit_frame();
+		return;
+	}
+
 	VkPipelineStageFlags graphics_wait_stage_masks[]  = {VK_PIPELINE_STAGE_VERTEX_INPUT_BIT, VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT};
 	VkSemaphore          graphics_wait_semaphores[]   = {compute.semaphore, semaphores.acquired_image_ready};
 	VkSemaphore          graphics_signal_semaphores[] = {graphics.semaphore, semaphores.render_complete};
@@ -859,6 +876,10 @@ void ComputeNBody::render(float delta_time)
 		return;
 	}
 	draw();
+	if (cpu.enabled)
+	{
+		update_cpu_simulation(delta_time);
+	}
 	update_compute_uniform_buffers(delta_time);
 	if (camera.updated)
 	{
@@ -873,6 +894,22 @@ bool ComputeNBody::resize(const uint32_t width, const uint32_t height)
 	return true;
 }
 
+void ComputeNBody::on_update_ui_overlay(vkb::Drawer &drawer)
+{
+	if (drawer.header("Settings"))
+	{
+		if (drawer.checkbox("Simulate on CPU", &cpu.enabled))
+		{
+			rebuild_command_buffers();
+		}
+		if (cpu.enabled)
+		{
+			drawer.combo_box("Method", &cpu.method, {"Brute force", "Barnes-Hut"});
+			drawer.text("%s kernel: %.2f ms per step", cpu.simulation->get_kernel_name(), cpu.step_ms);
+		}
+	}
+}
+
 std::unique_ptr<vkb::Application> create_compute_nbody()
 {
 	return std::make_unique<ComputeNBody>();
@@ -22,6 +22,7 @@
 #pragma once
 
 #include "api_vulkan_sample.h"
+#include "simulation/nbody_simulation.h"
 
 #if defined(__ANDROID__)
 // Lower particle count on Android for performance reasons
@@ -87,12 +88,18 @@ class ComputeNBody : public ApiVulkanSample
 		} ubo;
 	} compute;
 
-	// SSBO particle declaration
-	struct Particle
+	// Resources for simulating the particles on the CPU instead, when the device cannot run the compute shaders or when selected in the UI
+	struct
 	{
-		glm::vec4 pos;        // xyz = position, w = mass
-		glm::vec4 vel;        // xyz = velocity, w = gradient texture position
-	};
+		std::unique_ptr<vkb::NBodySimulation> simulation;
+		std::unique_ptr<vkb::core::BufferC>   particle_buffer;        // Host visible vertex buffer the simulation writes to directly
+		bool                                  enabled = false;
+		int32_t                               method  = static_cast<int32_t>(vkb::NBodyMethod::BarnesHut);
+		float                                 step_ms = 0.0f;
+	} cpu;
+
+	// SSBO particle declaration, shared with the CPU simulation
+	using Particle = vkb::NBodyParticle;
 
 	ComputeNBody();
 	~ComputeNBody();
@@ -101,6 +108,8 @@ class ComputeNBody : public ApiVulkanSample
 	void         build_command_buffers() override;
 	void         build_compute_command_buffer();
 	void         prepare_storage_buffers();
+	void         prepare_cpu_simulation(const std::vector<Particle> &particles);
+	void         update_cpu_simulation(float delta_time);
 	void         setup_descriptor_pool();
 	void         setup_descriptor_set_layout();
 	void         setup_descriptor_set();
@@ -114,6 +123,7 @@ class ComputeNBody : public ApiVulkanSample
 	bool         prepare(const vkb::ApplicationOptions &options) override;
 	virtual void render(float delta_time) override;
 	virtual bool resize(const uint32_t width, const uint32_t height) override;
+	virtual void on_update_ui_overlay(vkb::Drawer &drawer) override;
 };
 
 std::unique_ptr<vkb::Application> create_compute_nbody();
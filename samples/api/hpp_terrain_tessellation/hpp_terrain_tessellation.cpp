@@ -371,32 +371,10 @@ void HPPTerrainTessellation::generate_terrain()
 
 	// Calculate normals from height map using a sobel filter
 	vkb::HeightMap height_map("textures/terrain_heightmap_r16.ktx", patch_size);
-	for (auto x = 0; x < patch_size; x++)
+	std::vector<glm::vec3> normals = height_map.generate_normals();
+	for (uint32_t i = 0; i < vertex_count; i++)
 	{
-		for (auto y = 0; y < patch_size; y++)
-		{
-			// Get height samples centered around current position
-			float heights[3][3];
-			for (auto hx = -1; hx <= 1; hx++)
-			{
-				for (auto hy = -1; hy <= 1; hy++)
-				{
-					heights[hx + 1][hy + 1] = height_map.get_height(x + hx, y + hy);
-				}
-			}
-
-			// Calculate the normal
-			glm::vec3 normal;
-			// Gx sobel filter
-			normal.x = heights[0][0] - heights[2][0] + 2.0f * heights[0][1] - 2.0f * heights[2][1] + heights[0][2] - heights[2][2];
-			// Gy sobel filter
-			normal.z = heights[0][0] + 2.0f * heights[1][0] + heights[2][0] - heights[0][2] - 2.0f * heights[1][2] - heights[2][2];
-			// Calculate missing up component of the normal using the filtered x and y axis
-			// The first value controls the bump strength
-			normal.y = 0.25f * sqrt(1.0f - normal.x * normal.x - normal.z * normal.z);
-
-			vertices[x + y * patch_size].normal = glm::normalize(normal * glm::vec3(2.0f, 1.0f, 2.0f));
-		}
+		vertices[i].normal = normals[i];
 	}
 
 	// Indices
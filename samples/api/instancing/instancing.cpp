@@ -23,6 +23,20 @@
 
 #include "benchmark_mode/benchmark_mode.h"
 
+namespace
+{
+// Instance counts selectable in the UI, the first one is the default
+const std::vector<uint32_t> instance_counts = {INSTANCE_COUNT, 65536, 262144, 1048576};
+
+// Rotation of the rocks around the planet, gRotMat in instancing.vert
+glm::mat4 rotation_around_planet(float angle)
+{
+	float s = sin(angle);
+	float c = cos(angle);
+	return glm::mat4(glm::vec4(c, 0.0f, s, 0.0f), glm::vec4(0.0f, 1.0f, 0.0f, 0.0f), glm::vec4(-s, 0.0f, c, 0.0f), glm::vec4(0.0f, 0.0f, 0.0f, 1.0f));
+}
+}        // namespace
+
 Instancing::Instancing()
 {
 	title = "Instanced mesh rendering";
@@ -64,6 +78,12 @@ void Instancing::request_gpu_features(vkb::PhysicalDevice &gpu)
 	{
 		requested_features.textureCompressionETC2 = VK_TRUE;
 	}
+	// The draws of the visible grid cells are written to an indirect buffer, each starting at the first instance of its cells
+	if (gpu.get_features().multiDrawIndirect && gpu.get_features().drawIndirectFirstInstance)
+	{
+		requested_features.multiDrawIndirect         = VK_TRUE;
+		requested_features.drawIndirectFirstInstance = VK_TRUE;
+	}
 };
 
 void Instancing::build_command_buffers()
@@ -122,8 +142,8 @@ void Instancing::build_command_buffers()
 		// Binding point 1 : Instance data buffer
 		vkCmdBindVertexBuffers(draw_cmd_buffers[i], 1, 1, &instance_buffer.buffer->get_handle(), offsets);
 		vkCmdBindIndexBuffer(draw_cmd_buffers[i], rock_index_buffer->get_handle(), 0, VK_INDEX_TYPE_UINT32);
-		// Render instances
-		vkCmdDrawIndexed(draw_cmd_buffers[i], models.rock->vertex_indices, INSTANCE_COUNT, 0, 0, 0);
+		// Render the instances of the visible grid cells
+		vkCmdDrawIndexedIndirect(draw_cmd_buffers[i], indirect_draws.buffer->get_handle(), 0, indirect_draws.max_draw_count, sizeof(VkDrawIndexedIndirectCommand));
 
 		draw_ui(draw_cmd_buffers[i]);
 
@@ -361,39 +381,32 @@ void Instancing::prepare_pipelines()
 
 void Instancing::prepare_instance_data()
 {
-	std::vector<InstanceData> instance_data;
-	instance_data.resize(INSTANCE_COUNT);
-
-	std::default_random_engine              rnd_generator(lock_simulation_speed ? 0 : static_cast<unsigned>(time(nullptr)));
-	std::uniform_real_distribution<float>   uniform_dist(0.0, 1.0);
-	std::uniform_int_distribution<uint32_t> rnd_texture_index(0, textures.rocks.image->get_vk_image().get_array_layer_count());
-
-	// Distribute rocks randomly on two different rings
-	for (auto i = 0; i < INSTANCE_COUNT / 2; i++)
-	{
-		glm::vec2 ring0{7.0f, 11.0f};
-		glm::vec2 ring1{14.0f, 18.0f};
-
-		float rho, theta;
-
-		// Inner ring
-		rho                       = sqrt((pow(ring0[1], 2.0f) - pow(ring0[0], 2.0f)) * uniform_dist(rnd_generator) + pow(ring0[0], 2.0f));
-		theta                     = 2.0f * glm::pi<float>() * uniform_dist(rnd_generator);
-		instance_data[i].pos      = glm::vec3(rho * cos(theta), uniform_dist(rnd_generator) * 0.5f - 0.25f, rho * sin(theta));
-		instance_data[i].rot      = glm::vec3(glm::pi<float>() * uniform_dist(rnd_generator), glm::pi<float>() * uniform_dist(rnd_generator), glm::pi<float>() * uniform_dist(rnd_generator));
-		instance_data[i].scale    = 1.5f + uniform_dist(rnd_generator) - uniform_dist(rnd_generator);
-		instance_data[i].texIndex = rnd_texture_index(rnd_generator);
-		instance_data[i].scale *= 0.75f;
-
-		// Outer ring
-		rho                                                                 = sqrt((pow(ring1[1], 2.0f) - pow(ring1[0], 2.0f)) * uniform_dist(rnd_generator) + pow(ring1[0], 2.0f));
-		theta                                                               = 2.0f * glm::pi<float>() * uniform_dist(rnd_generator);
-		instance_data[static_cast<size_t>(i + INSTANCE_COUNT / 2)].pos      = glm::vec3(rho * cos(theta), uniform_dist(rnd_generator) * 0.5f - 0.25f, rho * sin(theta));
-		instance_data[static_cast<size_t>(i + INSTANCE_COUNT / 2)].rot      = glm::vec3(glm::pi<float>() * uniform_dist(rnd_generator), glm::pi<float>() * uniform_dist(rnd_generator), glm::pi<float>() * uniform_dist(rnd_generator));
-		instance_data[static_cast<size_t>(i + INSTANCE_COUNT / 2)].scale    = 1.5f + uniform_dist(rnd_generator) - uniform_dist(rnd_generator);
-		instance_data[static_cast<size_t>(i + INSTANCE_COUNT / 2)].texIndex = rnd_texture_index(rnd_generator);
-		instance_data[static_cast<size_t>(i + INSTANCE_COUNT / 2)].scale *= 0.75f;
-	}
+	uint32_t texture_layers = textures.rocks.image->get_vk_image().get_array_layer_count();
+	uint32_t seed           = lock_simulation_speed ? 0 : static_cast<uint32_t>(time(nullptr));
+
+	// The rocks are rotated around the origin of the model and scaled per instance
+	float rock_radius = models.rock->bounding_radius;
+
+	// Each rock only depends on the random numbers of its index, so the rocks are generated on worker threads
+	// The grid then sorts them by cell, so that the rocks of each cell are consecutive in the instance buffer
+	vkb::Timer timer;
+	timer.start();
+	std::vector<InstanceData> instance_data = instance_grid.generate<InstanceData>(instance_count, seed, [texture_layers, rock_radius](uint32_t index, vkb::CounterRandom &random, InstanceData &instance) {
+		// Distribute rocks randomly on two different rings
+		glm::vec2 ring = index % 2 == 0 ? glm::vec2(7.0f, 11.0f) : glm::vec2(14.0f, 18.0f);
+
+		float rho         = sqrt((pow(ring[1], 2.0f) - pow(ring[0], 2.0f)) * random.next_float() + pow(ring[0], 2.0f));
+		float theta       = 2.0f * glm::pi<float>() * random.next_float();
+		instance.pos      = glm::vec3(rho * cos(theta), random.next_float() * 0.5f - 0.25f, rho * sin(theta));
+		instance.rot      = glm::vec3(glm::pi<float>() * random.next_float(), glm::pi<float>() * random.next_float(), glm::pi<float>() * random.next_float());
+		instance.scale    = 1.5f + random.next_float() - random.next_float();
+		instance.texIndex = random.next_uint(texture_layers);
+		instance.scale *= 0.75f;
+
+		// The vertex shader rotates each rock around the planet by rot.y and then by glob_speed, the grid is built before the rotation by glob_speed
+		return glm::vec4(glm::vec3(rotation_around_planet(instance.rot.y) * glm::vec4(instance.pos, 1.0f)), rock_radius * instance.scale);
+	});
+	generate_ms = timer.stop<vkb::Timer::Milliseconds>();
 
 	instance_buffer.size = instance_data.size() * sizeof(InstanceData);
 
@@ -425,6 +438,43 @@ void Instancing::prepare_instance_data()
 	instance_buffer.descriptor.offset = 0;
 }
 
+void Instancing::prepare_indirect_draws()
+{
+	// Without multi draw indirect, a single draw of all instances is written instead
+	indirect_draws.max_draw_count = indirect_draws.supported ? std::max(1u, instance_grid.get_max_draw_count()) : 1;
+	indirect_draws.buffer         = std::make_unique<vkb::core::BufferC>(get_device(),
+	                                                                     indirect_draws.max_draw_count * sizeof(VkDrawIndexedIndirectCommand),
+	                                                                     VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT,
+	                                                                     VMA_MEMORY_USAGE_CPU_TO_GPU,
+	                                                                     VMA_ALLOCATION_CREATE_MAPPED_BIT);
+	update_indirect_draws();
+}
+
+void Instancing::update_indirect_draws()
+{
+	auto    *commands    = reinterpret_cast<VkDrawIndexedIndirectCommand *>(indirect_draws.buffer->map());
+	uint32_t index_count = models.rock->vertex_indices;
+
+	if (indirect_draws.supported && indirect_draws.culling)
+	{
+		// Cull in the space the grid was built in, before the rotation of the rocks around the planet by glob_speed
+		vkb::Timer timer;
+		timer.start();
+		indirect_draws.frustum.update(ubo_vs.projection * ubo_vs.view * rotation_around_planet(ubo_vs.glob_speed));
+		indirect_draws.result  = instance_grid.cull(indirect_draws.frustum, index_count, commands);
+		indirect_draws.cull_ms = timer.stop<vkb::Timer::Milliseconds>();
+	}
+	else
+	{
+		commands[0]           = {index_count, instance_count, 0, 0, 0};
+		indirect_draws.result = {1, static_cast<uint32_t>(instance_grid.get_cells().size()), instance_count};
+	}
+
+	// The command buffers always issue the maximum number of draws, the ones past the visible cells draw nothing
+	std::fill(commands + indirect_draws.result.draw_count, commands + indirect_draws.max_draw_count, VkDrawIndexedIndirectCommand{});
+	indirect_draws.buffer->flush();
+}
+
 void Instancing::prepare_uniform_buffers()
 {
 	uniform_buffers.scene = std::make_unique<vkb::core::BufferC>(get_device(),
@@ -476,9 +526,13 @@ bool Instancing::prepare(const vkb::ApplicationOptions &options)
 	camera.set_rotation(glm::vec3(-17.2f, -4.7f, 0.0f));
 	camera.set_translation(glm::vec3(5.5f, -1.85f, -18.5f));
 
+	VkPhysicalDeviceFeatures features = get_device().get_gpu().get_requested_features();
+	indirect_draws.supported          = features.multiDrawIndirect && features.drawIndirectFirstInstance;
+
 	load_assets();
 	prepare_instance_data();
 	prepare_uniform_buffers();
+	prepare_indirect_draws();
 	setup_descriptor_set_layout();
 	prepare_pipelines();
 	setup_descriptor_pool();
@@ -494,6 +548,11 @@ void Instancing::render(float delta_time)
 	{
 		return;
 	}
+	// The uniform buffer holds the matrices of ubo_vs until after the frame is drawn
+	if (indirect_draws.supported && indirect_draws.culling)
+	{
+		update_indirect_draws();
+	}
 	draw();
 	if (!paused || camera.updated)
 	{
@@ -503,9 +562,41 @@ void Instancing::render(float delta_time)
 
 void Instancing::on_update_ui_overlay(vkb::Drawer &drawer)
 {
+	if (drawer.header("Settings"))
+	{
+		std::vector<std::string> instance_count_names;
+		for (auto count : instance_counts)
+		{
+			instance_count_names.push_back(std::to_string(count));
+		}
+		if (drawer.combo_box("Instances", &instance_count_index, instance_count_names))
+		{
+			instance_count = instance_counts[instance_count_index];
+			get_device().wait_idle();
+			prepare_instance_data();
+			prepare_indirect_draws();
+			rebuild_command_buffers();
+		}
+		if (indirect_draws.supported && drawer.checkbox("Cull grid cells", &indirect_draws.culling))
+		{
+			update_indirect_draws();
+		}
+	}
 	if (drawer.header("Statistics"))
 	{
-		drawer.text("Instances: %d", INSTANCE_COUNT);
+		glm::uvec3 resolution = instance_grid.get_resolution();
+		drawer.text("Instances: %d", instance_count);
+		drawer.text("Generated in %.2f ms", generate_ms);
+		drawer.text("Grid: %dx%dx%d, %d cells", resolution.x, resolution.y, resolution.z, static_cast<int>(instance_grid.get_cells().size()));
+		if (indirect_draws.supported)
+		{
+			drawer.text("Visible: %d instances in %d cells", indirect_draws.result.visible_instances, indirect_draws.result.visible_cells);
+			drawer.text("Draws: %d, culled in %.3f ms", indirect_draws.result.draw_count, indirect_draws.cull_ms);
+		}
+		else
+		{
+			drawer.text("Culling requires multiDrawIndirect and drawIndirectFirstInstance");
+		}
 	}
 }
 
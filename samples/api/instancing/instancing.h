@@ -22,6 +22,8 @@
 #pragma once
 
 #include "api_vulkan_sample.h"
+#include "geometry/frustum.h"
+#include "geometry/instance_grid.h"
 
 #if defined(__ANDROID__)
 #	define INSTANCE_COUNT 4096
@@ -60,6 +62,24 @@ class Instancing : public ApiVulkanSample
 		VkDescriptorBufferInfo              descriptor;
 	} instance_buffer;
 
+	// Generates the instances on worker threads and culls them per grid cell
+	vkb::InstanceGrid instance_grid;
+	uint32_t          instance_count       = INSTANCE_COUNT;
+	int32_t           instance_count_index = 0;
+	double            generate_ms          = 0.0;
+
+	// Draws of the visible cells, written by the CPU every frame
+	struct IndirectDraws
+	{
+		std::unique_ptr<vkb::core::BufferC> buffer;
+		uint32_t                            max_draw_count = 0;
+		bool                                supported      = false;
+		bool                                culling        = true;
+		vkb::Frustum                        frustum;
+		vkb::InstanceCullResult             result;
+		double                              cull_ms = 0.0;
+	} indirect_draws;
+
 	struct UBOVS
 	{
 		glm::mat4 projection;
@@ -99,6 +119,8 @@ class Instancing : public ApiVulkanSample
 	void         setup_descriptor_set();
 	void         prepare_pipelines();
 	void         prepare_instance_data();
+	void         prepare_indirect_draws();
+	void         update_indirect_draws();
 	void         prepare_uniform_buffers();
 	void         update_uniform_buffer(float delta_time);
 	void         draw();
@@ -22,6 +22,7 @@
 #include "terrain_tessellation.h"
 
 #include "heightmap.h"
+#include "upload_service.h"
 
 TerrainTessellation::TerrainTessellation()
 {
@@ -282,32 +283,10 @@ void TerrainTessellation::generate_terrain()
 
 	// Calculate normals from height map using a sobel filter
 	vkb::HeightMap heightmap("textures/terrain_heightmap_r16.ktx", patch_size);
-	for (auto x = 0; x < patch_size; x++)
+	std::vector<glm::vec3> normals = heightmap.generate_normals();
+	for (uint32_t i = 0; i < vertex_count; i++)
 	{
-		for (auto y = 0; y < patch_size; y++)
-		{
-			// Get height samples centered around current position
-			float heights[3][3];
-			for (auto hx = -1; hx <= 1; hx++)
-			{
-				for (auto hy = -1; hy <= 1; hy++)
-				{
-					heights[hx + 1][hy + 1] = heightmap.get_height(x + hx, y + hy);
-				}
-			}
-
-			// Calculate the normal
-			glm::vec3 normal;
-			// Gx sobel filter
-			normal.x = heights[0][0] - heights[2][0] + 2.0f * heights[0][1] - 2.0f * heights[2][1] + heights[0][2] - heights[2][2];
-			// Gy sobel filter
-			normal.z = heights[0][0] + 2.0f * heights[1][0] + heights[2][0] - heights[0][2] - 2.0f * heights[1][2] - heights[2][2];
-			// Calculate missing up component of the normal using the filtered x and y axis
-			// The first value controls the bump strength
-			normal.y = 0.25f * sqrt(1.0f - normal.x * normal.x - normal.z * normal.z);
-
-			vertices[x + y * patch_size].normal = glm::normalize(normal * glm::vec3(2.0f, 1.0f, 2.0f));
-		}
+		vertices[i].normal = normals[i];
 	}
 
 	// Indices
@@ -330,11 +309,6 @@ void TerrainTessellation::generate_terrain()
 	uint32_t vertex_buffer_size = vertex_count * sizeof(Vertex);
 	uint32_t index_buffer_size  = index_count * sizeof(uint32_t);
 
-	// Create staging buffers
-
-	vkb::core::BufferC vertex_staging = vkb::core::BufferC::create_staging_buffer(get_device(), vertices);
-	vkb::core::BufferC index_staging  = vkb::core::BufferC::create_staging_buffer(get_device(), indices);
-
 	terrain.vertices = std::make_unique<vkb::core::BufferC>(get_device(),
 	                                                        vertex_buffer_size,
 	                                                        VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
@@ -345,28 +319,11 @@ void TerrainTessellation::generate_terrain()
 	                                                       VK_BUFFER_USAGE_INDEX_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
 	                                                       VMA_MEMORY_USAGE_GPU_ONLY);
 
-	// Copy from staging buffers
-	VkCommandBuffer copy_command = get_device().create_command_buffer(VK_COMMAND_BUFFER_LEVEL_PRIMARY, true);
-
-	VkBufferCopy copy_region = {};
-
-	copy_region.size = vertex_buffer_size;
-	vkCmdCopyBuffer(
-	    copy_command,
-	    vertex_staging.get_handle(),
-	    terrain.vertices->get_handle(),
-	    1,
-	    &copy_region);
-
-	copy_region.size = index_buffer_size;
-	vkCmdCopyBuffer(
-	    copy_command,
-	    index_staging.get_handle(),
-	    terrain.indices->get_handle(),
-	    1,
-	    &copy_region);
-
-	get_device().flush_command_buffer(copy_command, queue, true);
+	// Stage both buffers through the upload ring, they are copied in a single batch
+	auto &upload_service = get_device().get_upload_service();
+	upload_service.upload_buffer(terrain.vertices->get_handle(), vertices.data(), vertex_buffer_size);
+	upload_service.upload_buffer(terrain.indices->get_handle(), indices.data(), index_buffer_size);
+	upload_service.flush();
 }
 
 void TerrainTessellation::setup_descriptor_pool()
@@ -17,6 +17,7 @@
  */
 
 #include "ray_queries.h"
+#include "core/acceleration_structure_builder.h"
 #include "filesystem/legacy.h"
 #include "gltf_loader.h"
 
@@ -234,7 +235,10 @@ void RayQueries::create_top_level_acceleration_structure()
 	// Top Level AS with single instance
 	top_level_acceleration_structure = std::make_unique<vkb::core::AccelerationStructure>(get_device(), VK_ACCELERATION_STRUCTURE_TYPE_TOP_LEVEL_KHR);
 	top_level_acceleration_structure->add_instance_geometry(instances_buffer, 1);
-	top_level_acceleration_structure->build(queue);
+
+	vkb::core::AccelerationStructureBuilder builder{get_device()};
+	builder.add_build(*top_level_acceleration_structure);
+	builder.build(queue);
 }
 
 void RayQueries::create_bottom_level_acceleration_structure()
@@ -279,7 +283,11 @@ void RayQueries::create_bottom_level_acceleration_structure()
 		                                                           get_buffer_device_address(vertex_buffer->get_handle()),
 		                                                           get_buffer_device_address(index_buffer->get_handle()));
 	}
-	bottom_level_acceleration_structure->build(queue, VK_BUILD_ACCELERATION_STRUCTURE_PREFER_FAST_TRACE_BIT_KHR, VK_BUILD_ACCELERATION_STRUCTURE_MODE_BUILD_KHR);
+
+	// The structure is compacted once built, so the top level instance is written after this build
+	vkb::core::AccelerationStructureBuilder builder{get_device()};
+	builder.add_build(*bottom_level_acceleration_structure);
+	builder.build(queue);
 }
 
 void RayQueries::load_node(vkb::sg::Node &node)
@@ -842,7 +842,8 @@ void ShaderObject::generate_terrain()
 	std::vector<Vertex> vertices(vertex_count);
 
 	// Calculate normals from height map using a sobel filter
-	vkb::HeightMap heightmap("textures/terrain_heightmap_r16.ktx", terrain_resolution);
+	vkb::HeightMap         heightmap("textures/terrain_heightmap_r16.ktx", terrain_resolution);
+	std::vector<glm::vec3> normals = heightmap.generate_normals();
 
 	// Indices
 	const uint32_t        index_count = vertex_count * 6;
@@ -860,28 +861,7 @@ void ShaderObject::generate_terrain()
 			vertices[index].uv      = glm::vec2(static_cast<float>(x) / terrain_resolution, static_cast<float>(y) / terrain_resolution) * uv_scale;
 			vertices[index].joint0  = glm::vec4(0);
 			vertices[index].weight0 = glm::vec4(0);
-
-			// Get height samples centered around current position
-			float heights[3][3];
-			for (auto hx = -1; hx <= 1; hx++)
-			{
-				for (auto hy = -1; hy <= 1; hy++)
-				{
-					heights[hx + 1][hy + 1] = heightmap.get_height(x + hx, y + hy);
-				}
-			}
-
-			// Calculate the normal
-			glm::vec3 normal;
-			// Gx sobel filter
-			normal.x = heights[0][0] - heights[2][0] + 2.0f * heights[0][1] - 2.0f * heights[2][1] + heights[0][2] - heights[2][2];
-			// Gy sobel filter
-			normal.z = heights[0][0] + 2.0f * heights[1][0] + heights[2][0] - heights[0][2] - 2.0f * heights[1][2] - heights[2][2];
-			// Calculate missing up component of the normal using the filtered x and y axis
-			// The first value controls the bump strength
-			normal.y = 0.25f * sqrt(1.0f - normal.x * normal.x - normal.z * normal.z);
-
-			vertices[index].normal = glm::normalize(normal * glm::vec3(2.0f, 1.0f, 2.0f));
+			vertices[index].normal  = normals[index];
 
 			// Generate two triangles that form a quad using counter clockwise winding
 			if (x < terrain_resolution - 1 && y < terrain_resolution - 1)
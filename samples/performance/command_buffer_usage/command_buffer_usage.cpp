@@ -273,7 +273,7 @@ void CommandBufferUsage::ForwardSubpassSecondary::record_draw(vkb::core::Command
 	assert(mesh_end <= nodes.size());
 	for (uint32_t i = mesh_start; i < mesh_end; i++)
 	{
-		update_uniform(command_buffer, *nodes[i].first, thread_index);
+		update_submesh_uniform(command_buffer, *nodes[i].first, *nodes[i].second, thread_index);
 
 		draw_submesh(command_buffer, *nodes[i].second);
 	}
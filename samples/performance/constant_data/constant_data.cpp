@@ -36,6 +36,7 @@
 #include "scene_graph/components/material.h"
 #include "scene_graph/components/mesh.h"
 #include "scene_graph/components/pbr_material.h"
+#include "scene_graph/components/sub_mesh.h"
 #include "scene_graph/components/texture.h"
 #include "scene_graph/components/transform.h"
 #include "scene_graph/node.h"
@@ -45,15 +46,13 @@
 namespace
 {
 /**
- * @brief Helper function to fill the contents of the MVPUniform struct with the transform of the node and the camera view-projection matrix.
+ * @brief Helper function to fill the contents of the MVPUniform struct with the model matrix of a submesh and the camera view-projection matrix.
  */
-inline MVPUniform fill_mvp(vkb::sg::Node &node, vkb::sg::Camera &camera)
+inline MVPUniform fill_mvp(const glm::mat4 &model, vkb::sg::Camera &camera)
 {
 	MVPUniform mvp;
 
-	auto &transform = node.get_transform();
-
-	mvp.model = transform.get_world_matrix();
+	mvp.model = model;
 
 	mvp.camera_view_proj = vkb::rendering::vulkan_style_projection(camera.get_projection()) * camera.get_view();
 
@@ -305,9 +304,10 @@ void ConstantData::ConstantDataSubpass::prepare()
 
 void ConstantData::PushConstantSubpass::update_uniform(vkb::core::CommandBufferC &command_buffer,
                                                        vkb::sg::Node             &node,
+                                                       const glm::mat4           &model,
                                                        size_t                     thread_index)
 {
-	mvp_uniform = fill_mvp(node, camera);
+	mvp_uniform = fill_mvp(model, camera);
 }
 
 vkb::PipelineLayout &ConstantData::PushConstantSubpass::prepare_pipeline_layout(vkb::core::CommandBufferC              &command_buffer,
@@ -342,17 +342,16 @@ void ConstantData::PushConstantSubpass::prepare_push_constants(vkb::core::Comman
 
 void ConstantData::DescriptorSetSubpass::update_uniform(vkb::core::CommandBufferC &command_buffer,
                                                         vkb::sg::Node             &node,
+                                                        const glm::mat4           &model,
                                                         size_t                     thread_index)
 {
 	MVPUniform mvp;
 
 	auto &render_frame = get_render_context().get_active_frame();
 
-	auto &transform = node.get_transform();
-
 	auto allocation = render_frame.allocate_buffer(VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT, sizeof(MVPUniform), thread_index);
 
-	mvp = fill_mvp(node, camera);
+	mvp = fill_mvp(model, camera);
 
 	// Ensure the container doesn't hold more bytes than are needed
 	auto data = vkb::to_bytes(mvp);
@@ -411,7 +410,13 @@ void ConstantData::BufferArraySubpass::draw(vkb::core::CommandBufferC &command_b
 		{
 			for (auto &submesh : mesh->get_submeshes())
 			{
-				uniforms.push_back(fill_mvp(*node, camera));
+				// Quantized positions are dequantized by the model matrix, like GeometrySubpass::update_submesh_uniform does
+				glm::mat4 model = node->get_transform().get_world_matrix();
+				if (auto quantization = submesh->get_position_quantization())
+				{
+					model = model * quantization->get_dequantization_matrix();
+				}
+				uniforms.push_back(fill_mvp(model, camera));
 			}
 		}
 	}
@@ -442,6 +447,7 @@ void ConstantData::BufferArraySubpass::draw(vkb::core::CommandBufferC &command_b
 
 void ConstantData::BufferArraySubpass::update_uniform(vkb::core::CommandBufferC &command_buffer,
                                                       vkb::sg::Node             &node,
+                                                      const glm::mat4           &model,
                                                       size_t                     thread_index)
 {
 	/**
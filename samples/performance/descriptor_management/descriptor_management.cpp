@@ -59,6 +59,7 @@ bool DescriptorManagement::prepare(const vkb::ApplicationOptions &options)
 
 	// Add a GUI with the stats you want to monitor
 	get_stats().request_stats({vkb::StatIndex::frame_times});
+	get_stats().show_registered_counters(true);
 	create_gui(*window, &get_stats());
 
 	return true;
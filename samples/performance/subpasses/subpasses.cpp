@@ -20,11 +20,11 @@
 #include "common/vk_common.h"
 
 #include "gui.h"
+#include "rendering/light_clustering.h"
 #include "rendering/pipeline_state.h"
 #include "rendering/render_context.h"
 #include "rendering/render_pipeline.h"
 #include "rendering/subpasses/geometry_subpass.h"
-#include "rendering/subpasses/lighting_subpass.h"
 #include "scene_graph/node.h"
 
 Subpasses::Subpasses()
@@ -35,21 +35,31 @@ Subpasses::Subpasses()
 	config.insert<vkb::IntSetting>(0, configs[Config::RenderTechnique].value, 0);
 	config.insert<vkb::IntSetting>(0, configs[Config::TransientAttachments].value, 0);
 	config.insert<vkb::IntSetting>(0, configs[Config::GBufferSize].value, 0);
+	config.insert<vkb::IntSetting>(0, configs[Config::LightClustering].value, 0);
 
 	// Use two render passes
 	config.insert<vkb::IntSetting>(1, configs[Config::RenderTechnique].value, 1);
 	config.insert<vkb::IntSetting>(1, configs[Config::TransientAttachments].value, 0);
 	config.insert<vkb::IntSetting>(1, configs[Config::GBufferSize].value, 0);
+	config.insert<vkb::IntSetting>(1, configs[Config::LightClustering].value, 0);
 
 	// Disable transient attachments
 	config.insert<vkb::IntSetting>(2, configs[Config::RenderTechnique].value, 0);
 	config.insert<vkb::IntSetting>(2, configs[Config::TransientAttachments].value, 1);
 	config.insert<vkb::IntSetting>(2, configs[Config::GBufferSize].value, 0);
+	config.insert<vkb::IntSetting>(2, configs[Config::LightClustering].value, 0);
 
 	// Increase G-buffer size
 	config.insert<vkb::IntSetting>(3, configs[Config::RenderTechnique].value, 0);
 	config.insert<vkb::IntSetting>(3, configs[Config::TransientAttachments].value, 0);
 	config.insert<vkb::IntSetting>(3, configs[Config::GBufferSize].value, 1);
+	config.insert<vkb::IntSetting>(3, configs[Config::LightClustering].value, 0);
+
+	// Only shade the lights of the cluster of each pixel
+	config.insert<vkb::IntSetting>(4, configs[Config::RenderTechnique].value, 0);
+	config.insert<vkb::IntSetting>(4, configs[Config::TransientAttachments].value, 0);
+	config.insert<vkb::IntSetting>(4, configs[Config::GBufferSize].value, 0);
+	config.insert<vkb::IntSetting>(4, configs[Config::LightClustering].value, 1);
 }
 
 std::unique_ptr<vkb::RenderTarget> Subpasses::create_render_target(vkb::core::Image &&swapchain_image)
@@ -157,6 +167,7 @@ bool Subpasses::prepare(const vkb::ApplicationOptions &options)
 
 	// Enable stats
 	get_stats().request_stats({vkb::StatIndex::frame_times,
+	                           vkb::StatIndex::gpu_time,
 	                           vkb::StatIndex::gpu_fragment_jobs,
 	                           vkb::StatIndex::gpu_tiles,
 	                           vkb::StatIndex::gpu_ext_read_bytes,
@@ -183,6 +194,22 @@ void Subpasses::update(float delta_time)
 		}
 	}
 
+	// Check whether the user switched light clustering, which uses another lighting shader
+	if (configs[Config::LightClustering].value != last_light_clustering)
+	{
+		LOGI("Changing light clustering");
+		last_light_clustering = configs[Config::LightClustering].value;
+
+		// Reset frames, their synchronization objects and their command buffers
+		for (auto &frame : get_render_context().get_render_frames())
+		{
+			frame->reset();
+		}
+
+		render_pipeline          = create_one_renderpass_two_subpasses();
+		lighting_render_pipeline = create_lighting_renderpass();
+	}
+
 	// Check whether the user switched the attachment or the G-buffer option
 	if (configs[Config::TransientAttachments].value != last_transient_attachment ||
 	    configs[Config::GBufferSize].value != last_g_buffer_size)
@@ -292,9 +319,7 @@ std::unique_ptr<vkb::RenderPipeline> Subpasses::create_one_renderpass_two_subpas
 	scene_subpass->set_output_attachments({1, 2, 3});
 
 	// Lighting subpass
-	auto lighting_vs      = vkb::ShaderSource{"deferred/lighting.vert.spv"};
-	auto lighting_fs      = vkb::ShaderSource{"deferred/lighting.frag.spv"};
-	auto lighting_subpass = std::make_unique<vkb::LightingSubpass>(get_render_context(), std::move(lighting_vs), std::move(lighting_fs), *camera, get_scene());
+	auto lighting_subpass = create_lighting_subpass();
 
 	// Inputs are depth, albedo, and normal from the geometry subpass
 	lighting_subpass->set_input_attachments({1, 2, 3});
@@ -339,9 +364,7 @@ std::unique_ptr<vkb::RenderPipeline> Subpasses::create_geometry_renderpass()
 std::unique_ptr<vkb::RenderPipeline> Subpasses::create_lighting_renderpass()
 {
 	// Lighting subpass
-	auto lighting_vs      = vkb::ShaderSource{"deferred/lighting.vert.spv"};
-	auto lighting_fs      = vkb::ShaderSource{"deferred/lighting.frag.spv"};
-	auto lighting_subpass = std::make_unique<vkb::LightingSubpass>(get_render_context(), std::move(lighting_vs), std::move(lighting_fs), *camera, get_scene());
+	auto lighting_subpass = create_lighting_subpass();
 
 	// Inputs are depth, albedo, and normal from the geometry subpass
 	lighting_subpass->set_input_attachments({1, 2, 3});
@@ -358,6 +381,22 @@ std::unique_ptr<vkb::RenderPipeline> Subpasses::create_lighting_renderpass()
 	return lighting_render_pipeline;
 }
 
+std::unique_ptr<vkb::LightingSubpass> Subpasses::create_lighting_subpass()
+{
+	bool light_clustering = configs[Config::LightClustering].value == 1;
+
+	auto lighting_vs      = vkb::ShaderSource{"deferred/lighting.vert.spv"};
+	auto lighting_fs      = vkb::ShaderSource{light_clustering ? "clustered_lighting/lighting.frag.spv" : "deferred/lighting.frag.spv"};
+	auto lighting_subpass = std::make_unique<vkb::LightingSubpass>(get_render_context(), std::move(lighting_vs), std::move(lighting_fs), *camera, get_scene());
+
+	if (light_clustering)
+	{
+		lighting_subpass->set_light_clustering(std::make_unique<vkb::rendering::LightClustering>());
+	}
+
+	return lighting_subpass;
+}
+
 void draw_pipeline(vkb::core::CommandBufferC &command_buffer,
                    vkb::RenderTarget         &render_target,
                    vkb::RenderPipeline       &render_pipeline,
@@ -18,6 +18,7 @@
 #pragma once
 
 #include "rendering/render_pipeline.h"
+#include "rendering/subpasses/lighting_subpass.h"
 #include "scene_graph/components/perspective_camera.h"
 #include "vulkan_sample.h"
 
@@ -65,6 +66,11 @@ class Subpasses : public vkb::VulkanSampleC
 	 */
 	std::unique_ptr<vkb::RenderPipeline> create_lighting_renderpass();
 
+	/**
+	 * @return A lighting subpass, which only shades the lights of the cluster of each pixel when light clustering is enabled
+	 */
+	std::unique_ptr<vkb::LightingSubpass> create_lighting_subpass();
+
 	/**
 	 * @brief Draws using the good pipeline: one render pass with two subpasses
 	 */
@@ -101,7 +107,8 @@ class Subpasses : public vkb::VulkanSampleC
 		{
 			RenderTechnique,
 			TransientAttachments,
-			GBufferSize
+			GBufferSize,
+			LightClustering
 		} type;
 
 		/// Used as label by the GUI
@@ -117,6 +124,7 @@ class Subpasses : public vkb::VulkanSampleC
 	uint16_t last_render_technique{0};
 	uint16_t last_transient_attachment{0};
 	uint16_t last_g_buffer_size{0};
+	uint16_t last_light_clustering{0};
 
 	VkFormat          albedo_format{VK_FORMAT_R8G8B8A8_UNORM};
 	VkFormat          normal_format{VK_FORMAT_A2B10G10R10_UNORM_PACK32};
@@ -134,6 +142,10 @@ class Subpasses : public vkb::VulkanSampleC
 	    {/* config      = */ Config::GBufferSize,
 	     /* description = */ "G-Buffer size",
 	     /* options     = */ {"128-bit", "More"},
+	     /* value       = */ 0},
+	    {/* config      = */ Config::LightClustering,
+	     /* description = */ "Light clustering",
+	     /* options     = */ {"Disabled", "Enabled"},
 	     /* value       = */ 0}};
 };
 
@@ -118,42 +118,23 @@ void TextureCompressionBasisu::transcode_texture(const std::string &input_file,
 		destroy_texture(texture);
 	}
 
-	std::string file_name = vkb::fs::path::get(vkb::fs::path::Assets, "textures/basisu/" + input_file);
+	// The transcoder transcodes the mip levels in parallel, or reads them back from its cache if this texture was transcoded to this format before
+	vkb::TranscodedTexture transcoded = transcoder->transcode("textures/basisu/" + input_file, target_format);
+	last_transcode_time               = static_cast<float>(transcoded.elapsed_ms);
+	last_transcode_cached             = transcoded.from_cache;
 
-	// We are working with KTX2.0 files, so we need to use the ktxTexture2 class
-	ktxTexture2 *ktx_texture;
-	// Load the KTX2.0 file into memory. This is agnostic to the KTX version, so we cast the ktxTexture2 down to ktxTexture
-	KTX_error_code result = ktxTexture_CreateFromNamedFile(file_name.c_str(), KTX_TEXTURE_CREATE_LOAD_IMAGE_DATA_BIT, reinterpret_cast<ktxTexture **>(&ktx_texture));
-	if (result != KTX_SUCCESS)
-	{
-		throw std::runtime_error("Could not load the requested image file.");
-	}
-
-	// Check if the texture needs transcoding. This is the case, if the format stored in the KTX file is a non-native compression format
-	// This is the case for all textures used in this sample, as they are compressed using Basis Universal, which has to be transcoded to a native GPU format
-	if (ktxTexture2_NeedsTranscoding(ktx_texture))
-	{
-		auto tStart         = std::chrono::high_resolution_clock::now();
-		result              = ktxTexture2_TranscodeBasis(ktx_texture, target_format, 0);
-		last_transcode_time = std::chrono::duration<float, std::milli>(std::chrono::high_resolution_clock::now() - tStart).count();
-		if (result != KTX_SUCCESS)
-		{
-			throw std::runtime_error("Could not transcode the input texture to the selected target format.");
-		}
-	}
+	texture.width      = transcoded.width;
+	texture.height     = transcoded.height;
+	texture.mip_levels = transcoded.levels;
 
-	texture.width      = ktx_texture->baseWidth;
-	texture.height     = ktx_texture->baseHeight;
-	texture.mip_levels = ktx_texture->numLevels;
-
-	// Once transcoded, we can read the native Vulkan format from the ktx texture object and upload the transcoded GPU native data via staging
-	VkFormat format = static_cast<VkFormat>(ktx_texture->vkFormat);
+	// Once transcoded, we can read the native Vulkan format from the transcoded texture and upload the transcoded GPU native data via staging
+	VkFormat format = transcoded.format;
 
 	VkBuffer       staging_buffer;
 	VkDeviceMemory staging_memory;
 
 	VkBufferCreateInfo buffer_create_info = vkb::initializers::buffer_create_info();
-	buffer_create_info.size               = ktx_texture->dataSize;
+	buffer_create_info.size               = transcoded.data.size();
 	// This buffer is used as a transfer source for the buffer copy
 	buffer_create_info.usage       = VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
 	buffer_create_info.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
@@ -170,23 +151,25 @@ void TextureCompressionBasisu::transcode_texture(const std::string &input_file,
 	// Copy texture data into host local staging buffer
 	uint8_t *data;
 	VK_CHECK(vkMapMemory(get_device().get_handle(), staging_memory, 0, memory_requirements.size, 0, (void **) &data));
-	memcpy(data, ktx_texture->pData, ktx_texture->dataSize);
+	memcpy(data, transcoded.data.data(), transcoded.data.size());
 	vkUnmapMemory(get_device().get_handle(), staging_memory);
-	// Setup buffer copy regions for each mip level
+	// Setup buffer copy regions for each mip level, the sample only uses the first layer and face
 	std::vector<VkBufferImageCopy> buffer_copy_regions;
-	for (uint32_t mip_level = 0; mip_level < texture.mip_levels; mip_level++)
+	for (auto &image : transcoded.images)
 	{
-		ktx_size_t        offset;
-		KTX_error_code    result                           = ktxTexture_GetImageOffset((ktxTexture *) ktx_texture, mip_level, 0, 0, &offset);
+		if (image.layer != 0 || image.face != 0)
+		{
+			continue;
+		}
 		VkBufferImageCopy buffer_copy_region               = {};
 		buffer_copy_region.imageSubresource.aspectMask     = VK_IMAGE_ASPECT_COLOR_BIT;
-		buffer_copy_region.imageSubresource.mipLevel       = mip_level;
+		buffer_copy_region.imageSubresource.mipLevel       = image.level;
 		buffer_copy_region.imageSubresource.baseArrayLayer = 0;
 		buffer_copy_region.imageSubresource.layerCount     = 1;
-		buffer_copy_region.imageExtent.width               = ktx_texture->baseWidth >> mip_level;
-		buffer_copy_region.imageExtent.height              = ktx_texture->baseHeight >> mip_level;
+		buffer_copy_region.imageExtent.width               = image.width;
+		buffer_copy_region.imageExtent.height              = image.height;
 		buffer_copy_region.imageExtent.depth               = 1;
-		buffer_copy_region.bufferOffset                    = offset;
+		buffer_copy_region.bufferOffset                    = image.offset;
 		buffer_copy_regions.push_back(buffer_copy_region);
 	}
 
@@ -601,6 +584,7 @@ bool TextureCompressionBasisu::prepare(const vkb::ApplicationOptions &options)
 		return false;
 	}
 	get_available_target_formats();
+	transcoder = std::make_unique<vkb::TextureTranscoder>();
 	texture_file_names = {"kodim23_UASTC.ktx2",
 	                      "kodim23_ETC1S.ktx2",
 	                      "kodim20_UASTC.ktx2",
@@ -653,7 +637,28 @@ void TextureCompressionBasisu::on_update_ui_overlay(vkb::Drawer &drawer)
 			transcode_texture(texture_file_names[selected_input_texture], available_target_formats[selected_transcode_target_format]);
 			update_image_descriptor();
 		}
-		drawer.text("Transcoded in %.2f ms", last_transcode_time);
+		drawer.text(last_transcode_cached ? "Read from the cache in %.2f ms" : "Transcoded in %.2f ms", last_transcode_time);
+	}
+	if (drawer.header("Transcode throughput"))
+	{
+		// Every format is listed, formats without transcoded textures have no throughput to show yet
+		auto statistics = transcoder->get_statistics();
+		for (size_t index = 0; index < available_target_formats.size(); ++index)
+		{
+			auto it = statistics.find(available_target_formats[index]);
+			if (it == statistics.end() || it->second.texture_count == 0)
+			{
+				drawer.text("%s: no textures yet (%u cached)",
+				            available_target_formats_names[index].c_str(),
+				            it == statistics.end() ? 0u : it->second.cache_hits);
+				continue;
+			}
+			drawer.text("%s: %.1f Mpixels/s (%u transcoded, %u cached)",
+			            available_target_formats_names[index].c_str(),
+			            it->second.get_megapixels_per_second(),
+			            it->second.texture_count,
+			            it->second.cache_hits);
+		}
 	}
 }
 
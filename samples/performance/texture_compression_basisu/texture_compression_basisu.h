@@ -25,6 +25,7 @@
 #include <vector>
 
 #include "api_vulkan_sample.h"
+#include "texture_transcoder.h"
 
 class TextureCompressionBasisu : public ApiVulkanSample
 {
@@ -72,7 +73,11 @@ class TextureCompressionBasisu : public ApiVulkanSample
 	int32_t                          selected_input_texture = 0;
 	std::vector<std::string>         texture_file_names;
 
+	// Transcodes on worker threads, and keeps the transcoded textures in an on-disk cache
+	std::unique_ptr<vkb::TextureTranscoder> transcoder;
+
 	float last_transcode_time;
+	bool  last_transcode_cached = false;
 
 	TextureCompressionBasisu();
 	~TextureCompressionBasisu();
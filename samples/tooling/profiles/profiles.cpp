@@ -118,6 +118,7 @@ std::unique_ptr<vkb::Device> Profiles::create_device(vkb::PhysicalDevice &gpu)
 	device->prepare_memory_allocator();
 	device->create_internal_command_pool();
 	device->create_internal_fence_pool();
+	device->create_internal_upload_service();
 
 	return device;
 }
@@ -0,0 +1,79 @@
+/* Copyright (c) 2025, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// Resources written by vkb::rendering::LightClustering, bound to set 0, bindings 4 to 7
+
+#include "lighting.h"
+
+layout(set = 0, binding = 4) uniform ClusterInfo
+{
+	mat4  view;
+	uvec4 grid_size;           // xyz: number of clusters along each axis, w: number of directional lights
+	vec4  screen_scale;        // xy: clusters per pixel
+	vec4  depth_params;        // x: slice scale, y: slice bias, z: near plane, w: far plane
+}
+cluster_info;
+
+layout(set = 0, binding = 5, std430) readonly buffer Lights
+{
+	Light lights[];
+};
+
+layout(set = 0, binding = 6, std430) readonly buffer ClusterRanges
+{
+	uvec2 cluster_ranges[];        // x: offset into light_indices, y: light count
+};
+
+layout(set = 0, binding = 7, std430) readonly buffer LightIndices
+{
+	uint light_indices[];
+};
+
+uint get_cluster_index(vec2 frag_coord, vec3 world_pos)
+{
+	float depth = -(cluster_info.view * vec4(world_pos, 1.0)).z;
+	uint  slice = uint(max(log(max(depth, cluster_info.depth_params.z)) * cluster_info.depth_params.x + cluster_info.depth_params.y, 0.0));
+	uvec3 cluster = min(uvec3(uvec2(frag_coord * cluster_info.screen_scale.xy), slice), cluster_info.grid_size.xyz - 1U);
+	return (cluster.z * cluster_info.grid_size.y + cluster.y) * cluster_info.grid_size.x + cluster.x;
+}
+
+vec3 apply_clustered_lights(vec2 frag_coord, vec3 world_pos, vec3 normal)
+{
+	vec3 L = vec3(0.0);
+
+	for (uint i = 0U; i < cluster_info.grid_size.w; ++i)
+	{
+		L += apply_directional_light(lights[i], normal);
+	}
+
+	uvec2 range = cluster_ranges[get_cluster_index(frag_coord, world_pos)];
+	for (uint i = 0U; i < range.y; ++i)
+	{
+		Light light = lights[light_indices[range.x + i]];
+		// position.w holds the light type, 1 being vkb::sg::LightType::Point
+		if (uint(light.position.w) == 1U)
+		{
+			L += apply_point_light(light, world_pos, normal);
+		}
+		else
+		{
+			L += apply_spot_light(light, world_pos, normal);
+		}
+	}
+
+	return L;
+}
@@ -31,11 +31,32 @@ vec3 apply_directional_light(Light light, vec3 normal)
 	return ndotl * light.color.w * light.color.rgb;
 }
 
+// Distance at which a point light stops contributing: its range if it has one, otherwise where its attenuated
+// contribution drops below 1/256. vkb::rendering::LightClustering bins the lights with the same radius.
+float get_point_light_range(Light light)
+{
+	if (light.direction.w > 0.0)
+	{
+		return light.direction.w;
+	}
+	float max_component = max(max(light.color.r, light.color.g), light.color.b) * light.color.w;
+	return sqrt(max(max_component, 0.0) * 256.0) / 0.005;
+}
+
+// Fades a light out smoothly to zero at its range
+float get_range_falloff(float dist, float range)
+{
+	float ratio  = dist / range;
+	float window = clamp(1.0 - ratio * ratio * ratio * ratio, 0.0, 1.0);
+	return window * window;
+}
+
 vec3 apply_point_light(Light light, vec3 pos, vec3 normal)
 {
 	vec3  world_to_light = light.position.xyz - pos;
+	float range_falloff  = get_range_falloff(length(world_to_light), get_point_light_range(light));
 	float dist           = length(world_to_light) * 0.005;
-	float atten          = 1.0 / (dist * dist);
+	float atten          = range_falloff / (dist * dist);
 	world_to_light       = normalize(world_to_light);
 	float ndotl          = clamp(dot(normal, world_to_light), 0.0, 1.0);
 	return ndotl * light.color.w * atten * light.color.rgb;
@@ -48,5 +69,7 @@ vec3 apply_spot_light(Light light, vec3 pos, vec3 normal)
 	float inner_cone_angle = light.info.x;
 	float outer_cone_angle = light.info.y;
 	float intensity        = (theta - outer_cone_angle) / (inner_cone_angle - outer_cone_angle);
-	return smoothstep(0.0, 1.0, intensity) * light.color.w * light.color.rgb;
+	// Spot lights do not attenuate with distance, they only fade out at their range if they have one
+	float range_falloff = light.direction.w > 0.0 ? get_range_falloff(length(pos - light.position.xyz), light.direction.w) : 1.0;
+	return smoothstep(0.0, 1.0, intensity) * range_falloff * light.color.w * light.color.rgb;
 }
\ No newline at end of file